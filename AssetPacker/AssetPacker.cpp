@@ -0,0 +1,98 @@
+// AssetPacker.cpp : Packs loose asset files into a single archive for 'GLUF::AssetArchive'
+//
+// Usage:
+//      AssetPacker <archive> [-C <base directory>] <asset>... [@<list file>]...
+//
+//      Each asset is stored under the name it is given on the command line (or in the list file, one per line),
+//      and read from '<base directory>/<name>'.  '-C' applies to the assets after it.
+//
+
+#define GLUF_DEBUG
+#define SUPPRESS_RADIAN_ERROR
+#define SUPPRESS_UTF8_ERROR
+#include "../ObjGLUF/ObjGLUF.h"
+#include <stdlib.h>
+#include <fstream>
+#include <iostream>
+
+using namespace GLUF;
+
+void MyErrorMethod(const std::string& message, const char* func, const char* file, unsigned int line)
+{
+    std::cerr << "(" << func << " | " << line << "): " << message << std::endl;
+}
+
+void PrintUsage()
+{
+    std::cerr << "Usage: AssetPacker <archive> [-C <base directory>] <asset>... [@<list file>]..." << std::endl;
+}
+
+void AddAsset(AssetPathList& assets, const std::string& baseDir, const std::string& name)
+{
+    std::string path = baseDir.empty() ? name : baseDir + "/" + name;
+    assets[name] = path;
+}
+
+int main(int argc, char** argv)
+{
+    RegisterErrorMethod(MyErrorMethod);
+
+    if (argc < 3)
+    {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    std::string archivePath = argv[1];
+    std::string baseDir;
+    AssetPathList assets;
+
+    for (int i = 2; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "-C")
+        {
+            if (++i >= argc)
+            {
+                PrintUsage();
+                return EXIT_FAILURE;
+            }
+            baseDir = argv[i];
+        }
+        else if (!arg.empty() && arg[0] == '@')
+        {
+            std::ifstream listFile(arg.substr(1));
+            if (!listFile)
+            {
+                std::cerr << "Failed to open list file \"" << arg.substr(1) << "\"" << std::endl;
+                return EXIT_FAILURE;
+            }
+
+            std::string line;
+            while (std::getline(listFile, line))
+            {
+                if (!line.empty() && line.back() == '\r')
+                    line.pop_back();
+                if (!line.empty())
+                    AddAsset(assets, baseDir, line);
+            }
+        }
+        else
+        {
+            AddAsset(assets, baseDir, arg);
+        }
+    }
+
+    try
+    {
+        WriteAssetArchive(archivePath, assets);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to write \"" << archivePath << "\": " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Packed " << assets.size() << " assets into \"" << archivePath << "\"" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,1660 @@
+// Bench.cpp : Repeatable micro and scenario benchmarks for ObjGLUF
+//
+// Usage:
+//      bench [--out <file>] [--filter <substring>] [--repetitions <n>] [--min-time <seconds>] [--assets <directory>] [--shader-cache <directory>] [--gl | --record] [--list]
+//
+//      Micro benchmarks only use the CPU-side halves of the library and run without a display.  Scenario
+//      benchmarks go all the way through OpenGL, and only run with '--gl', which creates an offscreen context
+//      with 'InitHeadless' (they are reported as skipped otherwise, or if no context could be created).
+//      With '--record', scenario benchmarks run on the recording OpenGL backend instead, and also report the
+//      calls and bytes one iteration sends to OpenGL; timings then measure only the library's CPU side.
+//      Benchmarks which need files from '--assets' (default "TestProject") are skipped if the files are missing.
+//      'scenario/create_program_cached' keeps program binaries in the existing directory '--shader-cache', and is
+//      skipped without it.
+//
+//      Results are written as JSON to '--out', or stdout; progress goes to stderr.
+//
+
+#define USING_ASSIMP
+#define GLUF_DEBUG
+#define SUPPRESS_RADIAN_ERROR
+#define SUPPRESS_UTF8_ERROR
+#include "../ObjGLUF/GLUFGui.h"
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+using namespace GLUF;
+
+
+/*
+======================================================================================================================================================================================================
+Benchmark Harness
+
+*/
+
+//results are added here so the optimizer cannot throw away the work being measured
+volatile std::size_t g_Sink = 0;
+
+/*
+Benchmark
+
+    Data Members:
+        'mName': unique name, "<area>/<case>"
+        'mScenario': goes through OpenGL, needs '--gl'
+        'mRequiredAssets': files under '--assets' which must exist
+        'mSetup': run once before timing; returns false (and sets the reason) to skip the benchmark
+        'mRun': runs the measured work the given number of times
+        'mTeardown': optional, run once after a successful setup, even if the run failed, to release what setup created
+        'mBytesPerIteration', 'mItemsPerIteration': optional throughput counters, set during setup
+
+*/
+struct Benchmark
+{
+    std::string mName;
+    bool mScenario = false;
+    std::vector<std::string> mRequiredAssets;
+    std::function<bool(std::string& skipReason)> mSetup;
+    std::function<void(uint64_t iterations)> mRun;
+    std::function<void()> mTeardown;
+    std::shared_ptr<uint64_t> mBytesPerIteration = std::make_shared<uint64_t>(0);
+    std::shared_ptr<uint64_t> mItemsPerIteration = std::make_shared<uint64_t>(0);
+};
+
+struct BenchmarkResult
+{
+    std::string mName;
+    bool mScenario = false;
+    bool mSkipped = false;
+    std::string mSkipReason;
+    uint64_t mIterations = 0;
+    std::vector<double> mSamples;//nanoseconds per iteration, one per repetition
+    uint64_t mBytesPerIteration = 0;
+    uint64_t mItemsPerIteration = 0;
+    bool mHasGLCalls = false;
+    RecordingStats mGLCalls;//for one iteration, with '--record'
+    GLStateCacheStats mStateSkips;//for the same iteration
+};
+
+struct BenchConfig
+{
+    std::string mOutPath;
+    std::string mFilter;
+    std::string mAssetDir = "TestProject";
+    std::string mShaderCacheDir;
+    unsigned int mRepetitions = 10;
+    double mMinTime = 0.05;
+    bool mUseGL = false;
+    bool mRecord = false;
+    bool mList = false;
+};
+
+BenchConfig g_Config;
+bool g_HaveContext = false;
+
+//--------------------------------------------------------------------------------------
+std::string AssetPath(const std::string& name)
+{
+    return g_Config.mAssetDir + "/" + name;
+}
+
+//--------------------------------------------------------------------------------------
+bool AssetExists(const std::string& name)
+{
+    std::ifstream file(AssetPath(name), std::ios::binary);
+    return file.good();
+}
+
+//--------------------------------------------------------------------------------------
+double TimeRun(const Benchmark& bench, uint64_t iterations)
+{
+    auto start = std::chrono::steady_clock::now();
+    bench.mRun(iterations);
+    if (bench.mScenario)
+        glFinish();//include the GPU work, not just the submission
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double>(end - start).count();
+}
+
+//--------------------------------------------------------------------------------------
+BenchmarkResult RunBenchmark(const Benchmark& bench)
+{
+    BenchmarkResult result;
+    result.mName = bench.mName;
+    result.mScenario = bench.mScenario;
+
+    if (bench.mScenario && !g_HaveContext)
+    {
+        result.mSkipped = true;
+        result.mSkipReason = (g_Config.mUseGL || g_Config.mRecord) ? "no OpenGL context" : "scenario benchmarks need --gl or --record";
+        return result;
+    }
+
+    for (const auto& it : bench.mRequiredAssets)
+    {
+        if (!AssetExists(it))
+        {
+            result.mSkipped = true;
+            result.mSkipReason = "missing asset \"" + AssetPath(it) + "\"";
+            return result;
+        }
+    }
+
+    bool setUp = false;
+    try
+    {
+        if (bench.mSetup && !bench.mSetup(result.mSkipReason))
+        {
+            result.mSkipped = true;
+            return result;
+        }
+        setUp = true;
+
+        //warm up, and find how many iterations fill the minimum time
+        uint64_t iterations = 1;
+        double elapsed = TimeRun(bench, iterations);
+        while (elapsed < g_Config.mMinTime && iterations < (1ULL << 40))
+        {
+            double scale = elapsed > 0.0 ? 1.4 * g_Config.mMinTime / elapsed : 10.0;
+            iterations = std::max<uint64_t>(iterations + 1, (uint64_t)(iterations * std::min(scale, 10.0)));
+            elapsed = TimeRun(bench, iterations);
+        }
+
+        result.mIterations = iterations;
+        for (unsigned int i = 0; i < g_Config.mRepetitions; ++i)
+            result.mSamples.push_back(TimeRun(bench, iterations) * 1e9 / (double)iterations);
+
+        if (bench.mScenario && IsRecordingBackendInstalled())
+        {
+            ClearRecordedGLCalls();
+            GLSTATE.ResetStats();
+            bench.mRun(1);
+            result.mGLCalls = GetRecordingStats();
+            result.mStateSkips = GLSTATE.GetStats();
+            result.mHasGLCalls = true;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        result.mSkipped = true;
+        result.mSkipReason = std::string("failed: ") + e.what();
+        result.mSamples.clear();
+    }
+
+    if (setUp && bench.mTeardown)
+        bench.mTeardown();
+
+    if (result.mSkipped)
+        return result;
+
+    result.mBytesPerIteration = *bench.mBytesPerIteration;
+    result.mItemsPerIteration = *bench.mItemsPerIteration;
+    return result;
+}
+
+
+/*
+======================================================================================================================================================================================================
+JSON Output
+
+*/
+
+//--------------------------------------------------------------------------------------
+std::string JsonString(const std::string& str)
+{
+    std::string ret = "\"";
+    for (char c : str)
+    {
+        if (c == '"' || c == '\\')
+        {
+            ret += '\\';
+            ret += c;
+        }
+        else if ((unsigned char)c < 0x20)
+        {
+            ret += ' ';
+        }
+        else
+        {
+            ret += c;
+        }
+    }
+    return ret + "\"";
+}
+
+//--------------------------------------------------------------------------------------
+void WriteResults(std::ostream& stream, const std::vector<BenchmarkResult>& results)
+{
+    std::time_t now = std::time(nullptr);
+    char timeStr[32] = {};
+    std::strftime(timeStr, sizeof(timeStr), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    stream.precision(6);
+    stream << std::fixed;
+
+    stream << "{\n";
+    stream << "  \"format\": \"objgluf-bench\",\n";
+    stream << "  \"version\": 1,\n";
+    stream << "  \"timestamp\": " << JsonString(timeStr) << ",\n";
+#ifdef NDEBUG
+    stream << "  \"build\": \"release\",\n";
+#else
+    stream << "  \"build\": \"debug\",\n";
+#endif
+    stream << "  \"config\": { \"repetitions\": " << g_Config.mRepetitions << ", \"min_time\": " << g_Config.mMinTime
+        << ", \"backend\": " << (!g_HaveContext ? "\"none\"" : (g_Config.mRecord ? "\"recording\"" : "\"gl\"")) << " },\n";
+
+    if (g_HaveContext)
+    {
+        stream << "  \"gl_renderer\": " << JsonString((const char*)glGetString(GL_RENDERER)) << ",\n";
+        stream << "  \"gl_version\": " << JsonString((const char*)glGetString(GL_VERSION)) << ",\n";
+    }
+
+    stream << "  \"benchmarks\": [";
+    bool first = true;
+    for (const auto& it : results)
+    {
+        stream << (first ? "\n" : ",\n");
+        first = false;
+
+        stream << "    { \"name\": " << JsonString(it.mName) << ", \"kind\": " << (it.mScenario ? "\"scenario\"" : "\"micro\"");
+        if (it.mSkipped)
+        {
+            stream << ", \"skipped\": true, \"reason\": " << JsonString(it.mSkipReason) << " }";
+            continue;
+        }
+
+        std::vector<double> sorted = it.mSamples;
+        std::sort(sorted.begin(), sorted.end());
+
+        double mean = 0.0;
+        for (double s : sorted)
+            mean += s;
+        mean /= sorted.size();
+
+        double variance = 0.0;
+        for (double s : sorted)
+            variance += (s - mean) * (s - mean);
+        double stddev = sorted.size() > 1 ? std::sqrt(variance / (sorted.size() - 1)) : 0.0;
+
+        double median = (sorted.size() % 2 == 1) ? sorted[sorted.size() / 2] :
+            0.5 * (sorted[sorted.size() / 2 - 1] + sorted[sorted.size() / 2]);
+
+        stream << ", \"iterations\": " << it.mIterations << ", \"repetitions\": " << sorted.size()
+            << ", \"ns_per_iter\": { \"min\": " << sorted.front() << ", \"median\": " << median << ", \"mean\": " << mean
+            << ", \"max\": " << sorted.back() << ", \"stddev\": " << stddev << " }";
+
+        if (it.mBytesPerIteration != 0)
+            stream << ", \"bytes_per_iter\": " << it.mBytesPerIteration << ", \"mb_per_sec\": " << (it.mBytesPerIteration / (1024.0 * 1024.0)) / (median * 1e-9);
+        if (it.mItemsPerIteration != 0)
+            stream << ", \"items_per_iter\": " << it.mItemsPerIteration << ", \"ns_per_item\": " << median / it.mItemsPerIteration;
+        if (it.mHasGLCalls)
+        {
+            const auto& calls = it.mGLCalls.mCalls;
+            stream << ", \"gl_calls_per_iter\": { \"commands\": " << it.mGLCalls.mCommandCount << ", \"draws\": " << calls.mDrawCalls
+                << ", \"buffer_uploads\": " << calls.mBufferUploads << ", \"buffer_upload_bytes\": " << calls.mBufferUploadBytes
+                << ", \"texture_uploads\": " << calls.mTextureUploads << ", \"texture_upload_bytes\": " << calls.mTextureUploadBytes
+                << ", \"program_binds\": " << calls.mProgramBinds << ", \"texture_binds\": " << calls.mTextureBinds << " }";
+
+            const auto& skips = it.mStateSkips;
+            stream << ", \"state_skips_per_iter\": { \"total\": " << skips.GetTotalSkipped() << ", \"programs\": " << skips.mProgramBindsSkipped
+                << ", \"vertex_arrays\": " << skips.mVertexArrayBindsSkipped << ", \"buffers\": " << skips.mBufferBindsSkipped
+                << ", \"textures\": " << skips.mTextureBindsSkipped << ", \"samplers\": " << skips.mSamplerBindsSkipped
+                << ", \"state\": " << skips.mStateSkipped << " }";
+        }
+
+        stream << " }";
+    }
+    stream << "\n  ]\n}\n";
+}
+
+
+/*
+======================================================================================================================================================================================================
+Test Data
+
+*/
+
+/*
+MakeDDS
+
+    Builds a DDS file in memory with a full mip chain; the pixel data is zeroed, since only the layout matters
+        to the parser.  'fourCC' of nullptr is uncompressed RGBA, and "DX10" writes the extended header with 'dxgiFormat',
+        'arraySize' and, if 'cubemap', six faces per array element
+
+*/
+//--------------------------------------------------------------------------------------
+std::vector<char> MakeDDS(unsigned int width, unsigned int height, const char* fourCC, unsigned int dxgiFormat = 0, unsigned int arraySize = 1, bool cubemap = false)
+{
+    unsigned int mipCount = 1;
+    for (unsigned int w = width, h = height; w > 1 || h > 1; w = std::max(w / 2, 1u), h = std::max(h / 2, 1u))
+        ++mipCount;
+
+    bool dx10 = fourCC && std::string(fourCC) == "DX10";
+    unsigned int blockSize = 16;
+    if (fourCC && (std::string(fourCC) == "DXT1" || std::string(fourCC) == "ATI1" || dxgiFormat == 71 || dxgiFormat == 80))
+        blockSize = 8;
+
+    std::size_t dataSize = 0;
+    for (unsigned int level = 0, w = width, h = height; level < mipCount; ++level, w = std::max(w / 2, 1u), h = std::max(h / 2, 1u))
+    {
+        if (fourCC)
+            dataSize += ((w + 3) / 4) * ((h + 3) / 4) * blockSize;
+        else
+            dataSize += w * h * 4;
+    }
+
+    if (dx10)
+        dataSize *= arraySize * (cubemap ? 6 : 1);
+
+    std::size_t headerSize = dx10 ? 148 : 128;
+    std::vector<char> ret(headerSize + dataSize, 0);
+    std::memcpy(ret.data(), "DDS ", 4);
+
+    auto writeUint = [&ret](std::size_t offset, unsigned int value)
+    {
+        std::memcpy(ret.data() + offset, &value, 4);
+    };
+    writeUint(4, 124);//header size
+    writeUint(12, height);
+    writeUint(16, width);
+    writeUint(28, mipCount);
+    writeUint(76, 32);//pixel format size
+    if (fourCC)
+    {
+        writeUint(80, 0x4);//DDPF_FOURCC
+        std::memcpy(ret.data() + 84, fourCC, 4);
+    }
+    else
+    {
+        writeUint(80, 0x41);//DDPF_RGB | DDPF_ALPHAPIXELS
+        writeUint(88, 32);
+        writeUint(92, 0x000000ff);
+        writeUint(96, 0x0000ff00);
+        writeUint(100, 0x00ff0000);
+        writeUint(104, 0xff000000);
+    }
+
+    if (dx10)
+    {
+        writeUint(128, dxgiFormat);
+        writeUint(132, 3);//2D
+        writeUint(136, cubemap ? 0x4 : 0);//DDS_RESOURCE_MISC_TEXTURECUBE
+        writeUint(140, arraySize);
+    }
+
+    return ret;
+}
+
+/*
+MakeGridObj
+
+    Builds a Wavefront OBJ of a 'cells' x 'cells' grid of quads with texture coordinates
+
+*/
+//--------------------------------------------------------------------------------------
+std::string MakeGridObj(unsigned int cells)
+{
+    std::stringstream ss;
+    for (unsigned int y = 0; y <= cells; ++y)
+    {
+        for (unsigned int x = 0; x <= cells; ++x)
+        {
+            float fx = (float)x / cells, fy = (float)y / cells;
+            ss << "v " << fx << " " << std::sin(fx * 6.0f) * std::cos(fy * 6.0f) << " " << fy << "\n";
+            ss << "vt " << fx << " " << fy << "\n";
+        }
+    }
+
+    for (unsigned int y = 0; y < cells; ++y)
+    {
+        for (unsigned int x = 0; x < cells; ++x)
+        {
+            unsigned int i = y * (cells + 1) + x + 1;//obj indices start at 1
+            unsigned int j = i + cells + 1;
+            ss << "f " << i << "/" << i << " " << i + 1 << "/" << i + 1 << " " << j + 1 << "/" << j + 1 << " " << j << "/" << j << "\n";
+        }
+    }
+
+    return ss.str();
+}
+
+/*
+BenchVertex
+
+    A position and texture coordinate, the same layout as the GUI's text vertices
+
+*/
+struct BenchVertex : public VertexStruct
+{
+    glm::vec3 mPos;
+    glm::vec2 mTexCoords;
+
+    BenchVertex(){}
+    BenchVertex(const glm::vec3& pos, const glm::vec2& texCoords) :
+        mPos(pos), mTexCoords(texCoords)
+    {}
+
+    virtual char* get_data() const override
+    {
+        char* ret = new char[size()];
+
+        memcpy(ret, &mPos[0], 12);
+        memcpy(ret + 12, &mTexCoords[0], 8);
+
+        return ret;
+    }
+
+    virtual size_t size() const override
+    {
+        return 20;
+    }
+
+    virtual size_t n_elem_size(size_t element) override
+    {
+        return element == 0 ? 12 : (element == 1 ? 8 : 0);
+    }
+
+    virtual void buffer_element(void* data, size_t element) override
+    {
+        if (element == 0)
+            mPos = static_cast<glm::vec3*>(data)[0];
+        else if (element == 1)
+            mTexCoords = static_cast<glm::vec2*>(data)[0];
+    }
+};
+
+//--------------------------------------------------------------------------------------
+GLVector<BenchVertex> MakeVertices(std::size_t count)
+{
+    GLVector<BenchVertex> ret;
+    ret.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+        ret.push_back(BenchVertex(glm::vec3((float)i, (float)i * 0.5f, 1.0f), glm::vec2((float)i / count, 0.5f)));
+    return ret;
+}
+
+//--------------------------------------------------------------------------------------
+VertexAttribMap MeshInputs()
+{
+    VertexAttribMap inputs;
+    inputs.insert({ GLUF_VERTEX_ATTRIB_POSITION, g_attribPOS });
+    inputs.insert({ GLUF_VERTEX_ATTRIB_NORMAL, g_attribNORM });
+    inputs.insert({ GLUF_VERTEX_ATTRIB_UV0, g_attribUV0 });
+    return inputs;
+}
+
+const char* g_BenchVertexShader =
+    "#version 330 core\n"
+    "layout(location = 9) in vec3 _Position;\n"
+    "layout(location = 0) in vec2 _UV;\n"
+    "uniform mat4 _MVP;\n"
+    "out vec2 uvCoord;\n"
+    "void main()\n"
+    "{\n"
+    "    uvCoord = _UV;\n"
+    "    gl_Position = _MVP * vec4(_Position, 1.0);\n"
+    "}\n";
+
+const char* g_BenchFragmentShader =
+    "#version 330 core\n"
+    "in vec2 uvCoord;\n"
+    "uniform sampler2D _Texture;\n"
+    "uniform vec4 _Tint;\n"
+    "out vec4 color;\n"
+    "void main()\n"
+    "{\n"
+    "    color = texture(_Texture, uvCoord) * _Tint;\n"
+    "}\n";
+
+//the same transform as 'g_BenchVertexShader', from a uniform block
+const char* g_BenchBlockVertexShader =
+    "#version 330 core\n"
+    "layout(location = 9) in vec3 _Position;\n"
+    "layout(location = 0) in vec2 _UV;\n"
+    "layout(std140) uniform Object\n"
+    "{\n"
+    "    mat4 _MVP;\n"
+    "    vec4 _Tint;\n"
+    "};\n"
+    "out vec2 uvCoord;\n"
+    "void main()\n"
+    "{\n"
+    "    uvCoord = _UV;\n"
+    "    gl_Position = _MVP * vec4(_Position, 1.0);\n"
+    "}\n";
+
+//eight point lights, for uploading a uniform array
+const char* g_BenchLightsFragmentShader =
+    "#version 330 core\n"
+    "in vec2 uvCoord;\n"
+    "uniform vec3 _LightPositions[8];\n"
+    "out vec4 color;\n"
+    "void main()\n"
+    "{\n"
+    "    vec3 sum = vec3(0.0);\n"
+    "    for (int i = 0; i < 8; ++i)\n"
+    "        sum += _LightPositions[i];\n"
+    "    color = vec4(sum, 1.0);\n"
+    "}\n";
+
+struct BenchObjectBlock
+{
+    GLUF_STD140(glm::mat4, mMVP);
+    GLUF_STD140(glm::vec4, mTint);
+};
+
+const wchar_t* g_ShortText = L"Frame Stats: 60 fps";
+const wchar_t* g_ParagraphText =
+    L"The quick brown fox jumps over the lazy dog.\n"
+    L"Pack my box with five dozen liquor jugs.\n"
+    L"Sphinx of black quartz, judge my vow!\n"
+    L"0123456789 ~!@#$%^&*()_+-=[]{};':\",./<>?\n"
+    L"How vexingly quick daft zebras jump; the five boxing wizards jump quickly.";
+
+
+/*
+======================================================================================================================================================================================================
+Benchmarks
+
+*/
+
+//--------------------------------------------------------------------------------------
+void AddDDSBenchmarks(std::vector<Benchmark>& benches)
+{
+    struct DDSCase { const char* mName; unsigned int mSize; const char* mFourCC; };
+    const DDSCase cases[] = {
+        { "dds/parse_dxt1_2048", 2048, "DXT1" },
+        { "dds/parse_dxt5_1024", 1024, "DXT5" },
+        { "dds/parse_rgba_512", 512, nullptr },
+        { "dds/parse_bc7_1024", 1024, "DX10" }
+    };
+
+    for (const auto& it : cases)
+    {
+        Benchmark bench;
+        bench.mName = it.mName;
+
+        auto data = std::make_shared<std::vector<char>>(MakeDDS(it.mSize, it.mSize, it.mFourCC, 98));
+        auto items = bench.mItemsPerIteration;
+        bench.mSetup = [data, items](std::string&)
+        {
+            *items = ParseDDS(*data).mMipLevels.size();
+            return true;
+        };
+        bench.mRun = [data](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; ++i)
+                g_Sink += ParseDDS(*data).mMipLevels.size();
+        };
+        benches.push_back(bench);
+    }
+
+    //the software fallback for contexts without the format.  The blocks are noise, because all zero BC7 blocks are the
+    //  reserved mode, which decodes to nothing
+    struct DecodeCase { const char* mName; const char* mFourCC; unsigned int mDXGIFormat; };
+    const DecodeCase decodeCases[] = {
+        { "dds/decompress_dxt1_1024", "DXT1", 0 },
+        { "dds/decompress_bc7_1024", "DX10", 98 }
+    };
+
+    for (const auto& it : decodeCases)
+    {
+        Benchmark bench;
+        bench.mName = it.mName;
+
+        auto data = std::make_shared<std::vector<char>>(MakeDDS(1024, 1024, it.mFourCC, it.mDXGIFormat));
+        std::mt19937 noise(1234);//fixed seed, so the blocks are repeatable
+        for (std::size_t i = it.mDXGIFormat ? 148 : 128; i < data->size(); ++i)
+            (*data)[i] = static_cast<char>(noise());
+
+        auto image = std::make_shared<DDSImage>();
+        auto decoded = std::make_shared<std::vector<char>>();
+        *bench.mBytesPerIteration = data->size();
+        bench.mSetup = [data, image](std::string& skipReason)
+        {
+            try
+            {
+                *image = ParseDDS(*data);
+            }
+            catch (const std::exception& e)
+            {
+                skipReason = std::string("ParseDDS failed: ") + e.what();
+                return false;
+            }
+            return true;
+        };
+        bench.mRun = [data, image, decoded](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; ++i)
+                g_Sink += DecompressDDS(*image, *data, *decoded).mMipLevels.size();
+        };
+        benches.push_back(bench);
+    }
+
+    //a real file from disk, mapped like 'LoadTextureFromFile' does
+    Benchmark bench;
+    bench.mName = "dds/parse_file_glufcontrols";
+    bench.mRequiredAssets = { "glufcontrols.dds" };
+    auto file = std::make_shared<MappedFilePtr>();
+    auto bytes = bench.mBytesPerIteration;
+    bench.mSetup = [file, bytes](std::string&)
+    {
+        *file = MapFile(AssetPath("glufcontrols.dds"));
+        *bytes = (*file)->size();
+        return true;
+    };
+    bench.mRun = [file](uint64_t iterations)
+    {
+        for (uint64_t i = 0; i < iterations; ++i)
+            g_Sink += ParseDDS(**file).mMipLevels.size();
+    };
+    benches.push_back(bench);
+}
+
+//--------------------------------------------------------------------------------------
+void AddFontBenchmarks(std::vector<Benchmark>& benches)
+{
+    const FontSize sizes[] = { 15, 48 };
+    for (FontSize size : sizes)
+    {
+        Benchmark bench;
+        bench.mName = "font/rasterize_atlas_" + std::to_string(size) + "pt";
+        bench.mRequiredAssets = { "Arial.ttf" };
+
+        auto font = std::make_shared<FontPtr>();
+        auto items = bench.mItemsPerIteration;
+        bench.mSetup = [font, size, items](std::string& skipReason)
+        {
+            if (!InitFontLibrary())
+            {
+                skipReason = "FreeType failed to initialize";
+                return false;
+            }
+            LoadFontHeadless(*font, MapFile(AssetPath("Arial.ttf")), size);
+            *items = 0xFFF - 32;//glyphs in the atlas
+            return true;
+        };
+        bench.mRun = [font](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; ++i)
+                RasterizeFont(*font);
+        };
+        benches.push_back(bench);
+    }
+}
+
+//--------------------------------------------------------------------------------------
+void AddTextBenchmarks(std::vector<Benchmark>& benches)
+{
+    struct TextCase { const char* mName; const wchar_t* mText; Bitfield mFlags; };
+    const TextCase cases[] = {
+        { "text/layout_short", g_ShortText, GT_LEFT | GT_TOP },
+        { "text/layout_paragraph", g_ParagraphText, GT_LEFT | GT_TOP },
+        { "text/layout_paragraph_centered", g_ParagraphText, GT_CENTER | GT_VCENTER }
+    };
+
+    for (const auto& it : cases)
+    {
+        Benchmark bench;
+        bench.mName = it.mName;
+        bench.mRequiredAssets = { "Arial.ttf" };
+
+        auto node = std::make_shared<FontNode>();
+        std::wstring text = it.mText;
+        Bitfield flags = it.mFlags;
+        auto items = bench.mItemsPerIteration;
+        bench.mSetup = [node, text, items](std::string& skipReason)
+        {
+            if (!InitFontLibrary())
+            {
+                skipReason = "FreeType failed to initialize";
+                return false;
+            }
+            LoadFontHeadless(node->mFontType, MapFile(AssetPath("Arial.ttf")), 15);
+            node->mWeight = FONT_WEIGHT_NORMAL;
+            node->mLeading = 20;
+            *items = text.size();
+            return true;
+        };
+        bench.mRun = [node, text, flags](uint64_t iterations)
+        {
+            Rect rect = { 0, 600, 800, 0 };
+            for (uint64_t i = 0; i < iterations; ++i)
+                g_Sink += LayoutText(node, text, rect, flags, false);
+        };
+        benches.push_back(bench);
+    }
+}
+
+//--------------------------------------------------------------------------------------
+void AddVertexBenchmarks(std::vector<Benchmark>& benches)
+{
+    const std::size_t packCounts[] = { 1024, 65536 };
+    for (std::size_t count : packCounts)
+    {
+        Benchmark bench;
+        bench.mName = "glvector/gl_data_" + std::to_string(count);
+
+        auto vertices = std::make_shared<GLVector<BenchVertex>>(MakeVertices(count));
+        *bench.mBytesPerIteration = count * 20;
+        *bench.mItemsPerIteration = count;
+        bench.mRun = [vertices](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; ++i)
+                g_Sink += reinterpret_cast<std::size_t>(vertices->gl_data());
+        };
+        benches.push_back(bench);
+    }
+
+    /*
+    ChunkSubData cases:
+        sorted: one contiguous run
+        strided: every other vertex, so every vertex is its own chunk
+        shuffled: contiguous runs of 8, in random order, so the sort does real work
+    */
+    struct ChunkCase { const char* mName; std::size_t mCount; unsigned int mStride; bool mShuffle; };
+    const ChunkCase cases[] = {
+        { "vertex_aos/chunk_sorted_4096", 4096, 1, false },
+        { "vertex_aos/chunk_strided_4096", 4096, 2, false },
+        { "vertex_aos/chunk_shuffled_1024", 1024, 1, true }
+    };
+
+    for (const auto& it : cases)
+    {
+        Benchmark bench;
+        bench.mName = it.mName;
+
+        auto vertices = std::make_shared<GLVector<BenchVertex>>(MakeVertices(it.mCount));
+        auto locations = std::make_shared<std::vector<GLuint>>();
+        for (std::size_t i = 0; i < it.mCount; ++i)
+            locations->push_back(static_cast<GLuint>(i * it.mStride));
+
+        if (it.mShuffle)
+        {
+            std::vector<std::size_t> runs;
+            for (std::size_t i = 0; i < it.mCount / 8; ++i)
+                runs.push_back(i);
+            std::shuffle(runs.begin(), runs.end(), std::mt19937(1234));//fixed seed, so runs are repeatable
+
+            std::vector<GLuint> shuffled;
+            for (std::size_t run : runs)
+                for (std::size_t i = 0; i < 8; ++i)
+                    shuffled.push_back((*locations)[run * 8 + i]);
+            *locations = shuffled;
+        }
+
+        bool isSorted = !it.mShuffle;
+        *bench.mItemsPerIteration = it.mCount;
+        bench.mRun = [vertices, locations, isSorted](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; ++i)
+            {
+                //'BufferSubData' takes both by value too
+                GLVector<BenchVertex> data = *vertices;
+                std::vector<GLuint> vertexLocations = *locations;
+
+                std::vector<GLVector<BenchVertex>> chunkedData;
+                std::vector<GLuint> chunkOffsets;
+                VertexArrayAoS::ChunkSubData(data, vertexLocations, isSorted, chunkedData, chunkOffsets);
+
+                g_Sink += chunkedData.size();
+            }
+        };
+        benches.push_back(bench);
+    }
+}
+
+//--------------------------------------------------------------------------------------
+void AddAssimpBenchmarks(std::vector<Benchmark>& benches)
+{
+    const unsigned int gridSizes[] = { 16, 128 };
+    for (unsigned int cells : gridSizes)
+    {
+        Benchmark bench;
+        bench.mName = "assimp/convert_grid_" + std::to_string(cells);
+
+        auto importer = std::make_shared<Assimp::Importer>();
+        auto scene = std::make_shared<const aiScene*>(nullptr);
+        auto items = bench.mItemsPerIteration;
+        bench.mSetup = [importer, scene, cells, items](std::string& skipReason)
+        {
+            std::string obj = MakeGridObj(cells);
+            *scene = LoadSceneFromMemory(*importer, MemorySpan(obj), aiProcess_Triangulate | aiProcess_GenNormals | aiProcess_JoinIdenticalVertices, "obj");
+            if (*scene == nullptr || (*scene)->mNumMeshes == 0)
+            {
+                skipReason = "assimp failed to import the grid";
+                return false;
+            }
+            *items = (*scene)->mMeshes[0]->mNumVertices;
+            return true;
+        };
+        bench.mRun = [scene](uint64_t iterations)
+        {
+            VertexAttribMap inputs = MeshInputs();
+            for (uint64_t i = 0; i < iterations; ++i)
+                g_Sink += ConvertMeshFromScene(*scene, inputs, 0).mVertexData.size();
+        };
+        benches.push_back(bench);
+    }
+
+    //import and convert a real model, i.e. the CPU side of loading a mesh
+    Benchmark bench;
+    bench.mName = "assimp/import_convert_suzanne";
+    bench.mRequiredAssets = { "suzanne.obj.model" };
+    auto data = std::make_shared<MappedFilePtr>();
+    auto bytes = bench.mBytesPerIteration;
+    bench.mSetup = [data, bytes](std::string&)
+    {
+        *data = MapFile(AssetPath("suzanne.obj.model"));
+        *bytes = (*data)->size();
+        return true;
+    };
+    bench.mRun = [data](uint64_t iterations)
+    {
+        VertexAttribMap inputs = MeshInputs();
+        for (uint64_t i = 0; i < iterations; ++i)
+        {
+            Assimp::Importer importer;
+            const aiScene* scene = LoadSceneFromMemory(importer, **data, aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_JoinIdenticalVertices, "obj");
+            if (scene == nullptr)
+                throw std::runtime_error("assimp failed to import suzanne.obj.model");
+            g_Sink += ConvertMeshFromScene(scene, inputs, 0).mVertexData.size();
+        }
+    };
+    benches.push_back(bench);
+}
+
+//--------------------------------------------------------------------------------------
+void AddScenarioBenchmarks(std::vector<Benchmark>& benches)
+{
+    {
+        Benchmark bench;
+        bench.mName = "scenario/load_texture_dds";
+        bench.mScenario = true;
+        bench.mRequiredAssets = { "glufcontrols.dds" };
+        auto file = std::make_shared<MappedFilePtr>();
+        auto bytes = bench.mBytesPerIteration;
+        bench.mSetup = [file, bytes](std::string&)
+        {
+            *file = MapFile(AssetPath("glufcontrols.dds"));
+            *bytes = (*file)->size();
+            return true;
+        };
+        bench.mRun = [file](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; ++i)
+            {
+                GLuint texture = LoadTextureFromMemory(**file, TFF_DDS);
+                GLSTATE.DeleteTextures(1, &texture);
+            }
+        };
+        benches.push_back(bench);
+    }
+
+    {
+        //the same 1024x1024 color texture uncompressed and as BC7, for the upload size difference
+        struct UploadCase { const char* mName; const char* mFourCC; unsigned int mDXGIFormat; };
+        const UploadCase cases[] = {
+            { "scenario/load_texture_dds_rgba_1024", nullptr, 0 },
+            { "scenario/load_texture_dds_bc7_1024", "DX10", 98 }
+        };
+
+        for (const auto& it : cases)
+        {
+            Benchmark bench;
+            bench.mName = it.mName;
+            bench.mScenario = true;
+            auto data = std::make_shared<std::vector<char>>(MakeDDS(1024, 1024, it.mFourCC, it.mDXGIFormat));
+            *bench.mBytesPerIteration = data->size();
+            bench.mRun = [data](uint64_t iterations)
+            {
+                for (uint64_t i = 0; i < iterations; ++i)
+                {
+                    GLuint texture = LoadTextureFromMemory(*data, TFF_DDS);
+                    GLSTATE.DeleteTextures(1, &texture);
+                }
+            };
+            benches.push_back(bench);
+        }
+    }
+
+    {
+        //plain 'TFF_DDS' loads through the resource cache, which has to take the array or cubemap target from the file
+        struct CacheCase { const char* mName; const char* mFile; unsigned int mArraySize; bool mCubemap; GLenum mTarget; };
+        const CacheCase cases[] = {
+            { "scenario/cache_texture_dds_bc7_array_256", "bench_cache_array.dds", 8, false, GL_TEXTURE_2D_ARRAY },
+            { "scenario/cache_texture_dds_bc7_cubemap_256", "bench_cache_cubemap.dds", 1, true, GL_TEXTURE_CUBE_MAP }
+        };
+
+        for (const auto& it : cases)
+        {
+            Benchmark bench;
+            bench.mName = it.mName;
+            bench.mScenario = true;
+            std::string path = it.mFile;
+            GLenum target = it.mTarget;
+            unsigned int arraySize = it.mArraySize;
+            bool cubemap = it.mCubemap;
+            auto bytes = bench.mBytesPerIteration;
+            bench.mSetup = [path, target, arraySize, cubemap, bytes](std::string&)
+            {
+                std::vector<char> data = MakeDDS(256, 256, "DX10", 98, arraySize, cubemap);
+                std::ofstream(path, std::ios::binary | std::ios::trunc).write(data.data(), data.size());
+                *bytes = data.size();
+
+                //formats the context can not sample are decoded first, which only makes the texture bigger
+                auto texture = RESOURCECACHE.GetTexture(path, TFF_DDS);
+                bool correct = texture->GetTarget() == target && texture->GetMemorySize() >= data.size() - 148;
+                RESOURCECACHE.Remove(path);
+                if (!correct)
+                {
+                    std::remove(path.c_str());
+                    throw std::runtime_error("the resource cache recorded the wrong target or size for " + path);
+                }
+                return true;
+            };
+            bench.mRun = [path](uint64_t iterations)
+            {
+                for (uint64_t i = 0; i < iterations; ++i)
+                {
+                    g_Sink += RESOURCECACHE.GetTexture(path, TFF_DDS)->GetMemorySize();
+                    RESOURCECACHE.Remove(path);
+                }
+            };
+            bench.mTeardown = [path]()
+            {
+                std::remove(path.c_str());
+            };
+            benches.push_back(bench);
+        }
+    }
+
+    {
+        //one frame of streaming the BC7 texture above, to compare against loading it all in one frame
+        Benchmark bench;
+        bench.mName = "scenario/stream_texture_dds_bc7_1024_frame";
+        bench.mScenario = true;
+        auto data = std::make_shared<std::vector<char>>(MakeDDS(1024, 1024, "DX10", 98));
+        auto image = std::make_shared<DDSImage>();
+        auto texture = std::make_shared<std::future<GLuint>>();
+        bench.mSetup = [data, image](std::string& skipReason)
+        {
+            try
+            {
+                *image = ParseDDS(*data);
+            }
+            catch (const std::exception& e)
+            {
+                skipReason = std::string("ParseDDS failed: ") + e.what();
+                return false;
+            }
+
+            if (!TEXTURESTREAMER.IsInitialized())
+                TEXTURESTREAMER.Init(4, 1024 * 1024, 1024 * 1024);
+            return true;
+        };
+        bench.mRun = [data, image, texture](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; ++i)
+            {
+                //keep one texture streaming at all times
+                if (!texture->valid() || FutureReady(*texture))
+                {
+                    if (texture->valid())
+                    {
+                        GLuint id = texture->get();
+                        GLSTATE.DeleteTextures(1, &id);
+                    }
+                    *texture = TEXTURESTREAMER.StreamDDS(image, *data, data);
+                }
+                ASYNCLOADER.ProcessUploads(0.0);
+            }
+        };
+        benches.push_back(bench);
+    }
+
+    {
+        Benchmark bench;
+        bench.mName = "scenario/load_font_15pt";
+        bench.mScenario = true;
+        bench.mRequiredAssets = { "Arial.ttf" };
+        auto file = std::make_shared<MappedFilePtr>();
+        bench.mSetup = [file](std::string& skipReason)
+        {
+            if (!InitFontLibrary())
+            {
+                skipReason = "FreeType failed to initialize";
+                return false;
+            }
+            *file = MapFile(AssetPath("Arial.ttf"));
+            return true;
+        };
+        bench.mRun = [file](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; ++i)
+            {
+                //face creation, rasterization, and upload, i.e. a full 'Font::Refresh'
+                FontPtr font;
+                LoadFont(font, *file, 15);
+            }
+        };
+        benches.push_back(bench);
+    }
+
+    {
+        Benchmark bench;
+        bench.mName = "scenario/create_program";
+        bench.mScenario = true;
+        bench.mRun = [](uint64_t iterations)
+        {
+            ShaderSourceList sources;
+            sources.insert({ SH_VERTEX_SHADER, g_BenchVertexShader });
+            sources.insert({ SH_FRAGMENT_SHADER, g_BenchFragmentShader });
+
+            for (uint64_t i = 0; i < iterations; ++i)
+            {
+                ProgramPtr program;
+                SHADERMANAGER.CreateProgram(program, sources);
+                g_Sink += SHADERMANAGER.GetShaderVariableLocation(program, GLT_UNIFORM, "_MVP");
+            }
+        };
+        benches.push_back(bench);
+    }
+
+    {
+        //the same four uniforms set by name and by handle, to show the lookup cost
+        auto program = std::make_shared<ProgramPtr>();
+        auto makeProgram = [program](std::string& skipReason)
+        {
+            ShaderSourceList sources;
+            sources.insert({ SH_VERTEX_SHADER, g_BenchVertexShader });
+            sources.insert({ SH_FRAGMENT_SHADER, g_BenchFragmentShader });
+            SHADERMANAGER.CreateProgram(*program, sources);
+            SHADERMANAGER.UseProgram(*program);
+            return true;
+        };
+
+        Benchmark byName;
+        byName.mName = "scenario/set_uniforms_by_name";
+        byName.mScenario = true;
+        byName.mSetup = makeProgram;
+        *byName.mItemsPerIteration = 4;
+        byName.mRun = [program](uint64_t iterations)
+        {
+            glm::mat4 mvp(1.0f);
+            glm::vec4 tint(1.0f);
+            for (uint64_t i = 0; i < iterations; ++i)
+            {
+                SHADERMANAGER.GLUniformMatrix4f(*program, "_MVP", mvp);
+                SHADERMANAGER.GLUniform4f(*program, "_Tint", tint);
+                SHADERMANAGER.GLUniform1i(*program, "_Texture", 0);
+                SHADERMANAGER.GLUniformMatrix4f(*program, "_MVP", mvp);
+            }
+        };
+        benches.push_back(byName);
+
+        Benchmark byHandle;
+        byHandle.mName = "scenario/set_uniforms_by_handle";
+        byHandle.mScenario = true;
+        byHandle.mSetup = makeProgram;
+        *byHandle.mItemsPerIteration = 4;
+        byHandle.mRun = [program](uint64_t iterations)
+        {
+            UniformHandle mvpHandle = SHADERMANAGER.GetUniformHandle(*program, HashStringFNV1a("_MVP"));
+            UniformHandle tintHandle = SHADERMANAGER.GetUniformHandle(*program, HashStringFNV1a("_Tint"));
+            UniformHandle textureHandle = SHADERMANAGER.GetUniformHandle(*program, HashStringFNV1a("_Texture"));
+
+            glm::mat4 mvp(1.0f);
+            glm::vec4 tint(1.0f);
+            for (uint64_t i = 0; i < iterations; ++i)
+            {
+                SHADERMANAGER.GLUniformMatrix4f(mvpHandle, mvp);
+                SHADERMANAGER.GLUniform4f(tintHandle, tint);
+                SHADERMANAGER.GLUniform1i(textureHandle, 0);
+                SHADERMANAGER.GLUniformMatrix4f(mvpHandle, mvp);
+            }
+        };
+        benches.push_back(byHandle);
+
+        //what the GUI does for every text draw: bind the program and set the same ortho, sampler, and color again
+        Benchmark redundant;
+        redundant.mName = "scenario/redundant_text_uniforms";
+        redundant.mScenario = true;
+        redundant.mSetup = makeProgram;
+        *redundant.mItemsPerIteration = 3;
+        redundant.mRun = [program](uint64_t iterations)
+        {
+            GLuint mvpLoc = SHADERMANAGER.GetShaderVariableLocation(*program, GLT_UNIFORM, "_MVP");
+            GLuint tintLoc = SHADERMANAGER.GetShaderVariableLocation(*program, GLT_UNIFORM, "_Tint");
+            GLuint textureLoc = SHADERMANAGER.GetShaderVariableLocation(*program, GLT_UNIFORM, "_Texture");
+
+            glm::mat4 ortho = glm::ortho(-640.0f, 640.0f, -360.0f, 360.0f);
+            glm::vec4 color(1.0f);
+            for (uint64_t i = 0; i < iterations; ++i)
+            {
+                SHADERMANAGER.UseProgram(*program);
+                SHADERMANAGER.GLUniformMatrix4f(mvpLoc, ortho);
+                SHADERMANAGER.GLUniform1i(textureLoc, 0);
+                SHADERMANAGER.GLUniform4f(tintLoc, color);
+            }
+        };
+        benches.push_back(redundant);
+
+        //a frame of 64 objects, each with its own transform set as a plain uniform
+        Benchmark perObject;
+        perObject.mName = "scenario/per_object_uniforms_64";
+        perObject.mScenario = true;
+        perObject.mSetup = makeProgram;
+        *perObject.mItemsPerIteration = 64;
+        auto frame = std::make_shared<float>(0.0f);
+        perObject.mRun = [program, frame](uint64_t iterations)
+        {
+            GLuint mvpLoc = SHADERMANAGER.GetShaderVariableLocation(*program, GLT_UNIFORM, "_MVP");
+            GLuint tintLoc = SHADERMANAGER.GetShaderVariableLocation(*program, GLT_UNIFORM, "_Tint");
+
+            glm::vec4 tint(1.0f);
+            for (uint64_t i = 0; i < iterations; ++i)
+            {
+                //every frame moves, so none of the uploads are redundant
+                *frame += 1.0f;
+
+                SHADERMANAGER.UseProgram(*program);
+                for (int j = 0; j < 64; ++j)
+                {
+                    SHADERMANAGER.GLUniformMatrix4f(mvpLoc, glm::translate(glm::mat4(1.0f), glm::vec3((float)j, *frame, 0.0f)));
+                    SHADERMANAGER.GLUniform4f(tintLoc, tint);
+                }
+            }
+        };
+        benches.push_back(perObject);
+    }
+
+    {
+        //the same frame with every object's transform streamed through one uniform buffer
+        auto program = std::make_shared<ProgramPtr>();
+        auto block = std::make_shared<UniformBlock>("Object", 0);
+        auto stream = std::make_shared<UniformStreamBuffer>();
+        auto frame = std::make_shared<float>(0.0f);
+
+        Benchmark bench;
+        bench.mName = "scenario/uniform_block_stream_64";
+        bench.mScenario = true;
+        *bench.mItemsPerIteration = 64;
+        bench.mSetup = [program, block, stream](std::string& skipReason)
+        {
+            try
+            {
+                ShaderSourceList sources;
+                sources.insert({ SH_VERTEX_SHADER, g_BenchBlockVertexShader });
+                sources.insert({ SH_FRAGMENT_SHADER, g_BenchFragmentShader });
+                SHADERMANAGER.CreateProgram(*program, sources);
+                block->Attach(*program);
+                stream->Init(64 * 256);
+            }
+            catch (const std::exception&)
+            {
+                skipReason = "uniform buffers are not supported";
+                return false;
+            }
+            return true;
+        };
+        bench.mRun = [program, block, stream, frame](uint64_t iterations)
+        {
+            std::vector<UniformStreamAllocation> allocations(64);
+
+            BenchObjectBlock data;
+            data.mTint = glm::vec4(1.0f);
+            for (uint64_t i = 0; i < iterations; ++i)
+            {
+                *frame += 1.0f;
+
+                SHADERMANAGER.UseProgram(*program);
+
+                //write the whole frame first, so without persistent mapping it is still one upload
+                for (int j = 0; j < 64; ++j)
+                {
+                    data.mMVP = glm::translate(glm::mat4(1.0f), glm::vec3((float)j, *frame, 0.0f));
+                    allocations[j] = block->Write(*stream, data);
+                }
+                for (const auto& it : allocations)
+                    block->Bind(*stream, it);
+
+                stream->EndFrame();
+            }
+        };
+        benches.push_back(bench);
+    }
+
+    {
+        //eight lights that all move every frame, set one element at a time and as one array upload
+        auto program = std::make_shared<ProgramPtr>();
+        auto frame = std::make_shared<float>(0.0f);
+        auto makeProgram = [program](std::string& skipReason)
+        {
+            ShaderSourceList sources;
+            sources.insert({ SH_VERTEX_SHADER, g_BenchVertexShader });
+            sources.insert({ SH_FRAGMENT_SHADER, g_BenchLightsFragmentShader });
+            SHADERMANAGER.CreateProgram(*program, sources);
+            SHADERMANAGER.UseProgram(*program);
+            return true;
+        };
+
+        Benchmark byElement;
+        byElement.mName = "scenario/set_light_elements_8";
+        byElement.mScenario = true;
+        byElement.mSetup = makeProgram;
+        *byElement.mItemsPerIteration = 8;
+        byElement.mRun = [program, frame](uint64_t iterations)
+        {
+            //only "name[0]" is reflected, and the other elements follow it
+            GLuint first = SHADERMANAGER.GetShaderVariableLocation(*program, GLT_UNIFORM, "_LightPositions[0]");
+
+            for (uint64_t i = 0; i < iterations; ++i)
+            {
+                *frame += 1.0f;
+                for (GLuint j = 0; j < 8; ++j)
+                    SHADERMANAGER.GLUniform3f(first + j, glm::vec3((float)j, *frame, 0.0f));
+            }
+        };
+        benches.push_back(byElement);
+
+        Benchmark byArray;
+        byArray.mName = "scenario/set_light_array_8";
+        byArray.mScenario = true;
+        byArray.mSetup = makeProgram;
+        *byArray.mItemsPerIteration = 8;
+        byArray.mRun = [program, frame](uint64_t iterations)
+        {
+            UniformHandle lights = SHADERMANAGER.GetUniformHandle(*program, HashStringFNV1a("_LightPositions[0]"));
+
+            glm::vec3 positions[8];
+            for (uint64_t i = 0; i < iterations; ++i)
+            {
+                *frame += 1.0f;
+                for (int j = 0; j < 8; ++j)
+                    positions[j] = glm::vec3((float)j, *frame, 0.0f);
+                SHADERMANAGER.GLUniform3fv(lights, positions, 8);
+            }
+        };
+        benches.push_back(byArray);
+    }
+
+    {
+        Benchmark bench;
+        bench.mName = "scenario/submit_programs_8";
+        bench.mScenario = true;
+        *bench.mItemsPerIteration = 8;
+        bench.mRun = [](uint64_t iterations)
+        {
+            ShaderSourceList sources;
+            sources.insert({ SH_VERTEX_SHADER, g_BenchVertexShader });
+            sources.insert({ SH_FRAGMENT_SHADER, g_BenchFragmentShader });
+
+            //submit the whole batch before resolving any of it, so the driver can compile them side by side
+            std::vector<PendingProgramPtr> pending(8);
+            for (uint64_t i = 0; i < iterations; ++i)
+            {
+                for (auto& it : pending)
+                    SHADERMANAGER.SubmitProgram(it, sources);
+
+                for (auto& it : pending)
+                {
+                    ProgramPtr program;
+                    SHADERMANAGER.ResolveProgram(program, it);
+                    g_Sink += SHADERMANAGER.GetShaderVariableLocation(program, GLT_UNIFORM, "_MVP");
+                }
+            }
+        };
+        benches.push_back(bench);
+    }
+
+    {
+        Benchmark bench;
+        bench.mName = "scenario/create_program_cached";
+        bench.mScenario = true;
+        auto sources = std::make_shared<ShaderSourceList>();
+        sources->insert({ SH_VERTEX_SHADER, g_BenchVertexShader });
+        sources->insert({ SH_FRAGMENT_SHADER, g_BenchFragmentShader });
+        bench.mSetup = [sources](std::string& skipReason)
+        {
+            if (g_Config.mShaderCacheDir.empty())
+            {
+                skipReason = "no --shader-cache directory";
+                return false;
+            }
+
+            //warm the cache, so every timed iteration is a hit
+            SHADERMANAGER.SetProgramBinaryCache(g_Config.mShaderCacheDir);
+            ProgramPtr program;
+            SHADERMANAGER.CreateProgram(program, *sources);
+            ProgramBinaryCacheStats stats = SHADERMANAGER.GetProgramBinaryCacheStats();
+            SHADERMANAGER.SetProgramBinaryCache("");
+
+            bool cached = stats.mStored + stats.mHits > 0;
+            if (!cached)
+                skipReason = "program binaries are not supported, or the cache directory is not writable";
+            return cached;
+        };
+        bench.mRun = [sources](uint64_t iterations)
+        {
+            //only this benchmark uses the cache
+            SHADERMANAGER.SetProgramBinaryCache(g_Config.mShaderCacheDir);
+            for (uint64_t i = 0; i < iterations; ++i)
+            {
+                ProgramPtr program;
+                SHADERMANAGER.CreateProgram(program, *sources);
+                g_Sink += SHADERMANAGER.GetShaderVariableLocation(program, GLT_UNIFORM, "_MVP");
+            }
+            SHADERMANAGER.SetProgramBinaryCache("");
+        };
+        benches.push_back(bench);
+    }
+
+    {
+        //8 materials, which only ever ask for 2 permutations of the same shader
+        auto defines = std::make_shared<std::vector<ShaderDefineList>>();
+        for (int i = 0; i < 8; ++i)
+            defines->push_back(i % 2 == 0 ? ShaderDefineList{ { "USE_TINT", "" } } : ShaderDefineList{ { "USE_FOG", "" } });
+
+        Benchmark perMaterial;
+        perMaterial.mName = "scenario/material_programs_8";
+        perMaterial.mScenario = true;
+        *perMaterial.mItemsPerIteration = 8;
+        perMaterial.mRun = [defines](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; ++i)
+            {
+                for (const auto& it : *defines)
+                {
+                    //each material preprocesses and compiles its own copy
+                    ShaderSourceList sources;
+                    sources.insert({ SH_VERTEX_SHADER, SHADERMANAGER.PreprocessShader(g_BenchVertexShader, it) });
+                    sources.insert({ SH_FRAGMENT_SHADER, SHADERMANAGER.PreprocessShader(g_BenchFragmentShader, it) });
+
+                    ProgramPtr program;
+                    SHADERMANAGER.CreateProgram(program, sources);
+                    g_Sink += SHADERMANAGER.GetShaderVariableLocation(program, GLT_UNIFORM, "_MVP");
+                }
+            }
+        };
+        benches.push_back(perMaterial);
+
+        Benchmark variants;
+        variants.mName = "scenario/material_program_variants_8";
+        variants.mScenario = true;
+        *variants.mItemsPerIteration = 8;
+        variants.mRun = [defines](uint64_t iterations)
+        {
+            ShaderSourceList sources;
+            sources.insert({ SH_VERTEX_SHADER, g_BenchVertexShader });
+            sources.insert({ SH_FRAGMENT_SHADER, g_BenchFragmentShader });
+
+            for (uint64_t i = 0; i < iterations; ++i)
+            {
+                //start cold every iteration, so each one compiles both permutations once
+                SHADERMANAGER.FlushProgramVariants();
+                for (const auto& it : *defines)
+                {
+                    ProgramPtr program;
+                    SHADERMANAGER.CreateProgramVariant(program, sources, it);
+                    g_Sink += SHADERMANAGER.GetShaderVariableLocation(program, GLT_UNIFORM, "_MVP");
+                }
+            }
+            SHADERMANAGER.FlushProgramVariants();
+        };
+        benches.push_back(variants);
+    }
+
+    {
+        Benchmark bench;
+        bench.mName = "scenario/load_vertex_array_grid_128";
+        bench.mScenario = true;
+        auto importer = std::make_shared<Assimp::Importer>();
+        auto scene = std::make_shared<const aiScene*>(nullptr);
+        bench.mSetup = [importer, scene](std::string& skipReason)
+        {
+            std::string obj = MakeGridObj(128);
+            *scene = LoadSceneFromMemory(*importer, MemorySpan(obj), aiProcess_Triangulate | aiProcess_GenNormals | aiProcess_JoinIdenticalVertices, "obj");
+            if (*scene == nullptr || (*scene)->mNumMeshes == 0)
+            {
+                skipReason = "assimp failed to import the grid";
+                return false;
+            }
+            return true;
+        };
+        bench.mRun = [scene](uint64_t iterations)
+        {
+            VertexAttribMap inputs = MeshInputs();
+            for (uint64_t i = 0; i < iterations; ++i)
+                g_Sink += LoadVertexArrayFromScene(*scene, inputs, 0) ? 1 : 0;
+        };
+        benches.push_back(bench);
+    }
+
+    {
+        Benchmark bench;
+        bench.mName = "scenario/buffer_sub_data_strided_1024";
+        bench.mScenario = true;
+        auto vertexArray = std::make_shared<std::shared_ptr<VertexArray>>();
+        auto vertices = std::make_shared<GLVector<BenchVertex>>(MakeVertices(1024));
+        auto locations = std::make_shared<std::vector<GLuint>>();
+        for (GLuint i = 0; i < 1024; ++i)
+            locations->push_back(i * 2);
+
+        bench.mSetup = [vertexArray](std::string&)
+        {
+            *vertexArray = std::make_shared<VertexArray>(GL_TRIANGLES, GL_DYNAMIC_DRAW, false);
+            (*vertexArray)->AddVertexAttrib(g_attribPOS, 0);
+            (*vertexArray)->AddVertexAttrib(g_attribUV0, 12);
+            (*vertexArray)->BufferData(MakeVertices(2048));
+            return true;
+        };
+        bench.mRun = [vertexArray, vertices, locations](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; ++i)
+                (*vertexArray)->BufferSubData(*vertices, *locations, true);
+        };
+        benches.push_back(bench);
+    }
+
+    {
+        //16 objects sharing a program, a texture, and depth state, each set again before its draw like most scene code does
+        auto program = std::make_shared<ProgramPtr>();
+        auto vertexArrays = std::make_shared<std::vector<std::shared_ptr<VertexArray>>>();
+        auto texture = std::make_shared<GLuint>(0);
+
+        Benchmark bench;
+        bench.mName = "scenario/draw_shared_state_16";
+        bench.mScenario = true;
+        *bench.mItemsPerIteration = 16;
+        bench.mSetup = [program, vertexArrays, texture](std::string&)
+        {
+            ShaderSourceList sources;
+            sources.insert({ SH_VERTEX_SHADER, g_BenchVertexShader });
+            sources.insert({ SH_FRAGMENT_SHADER, g_BenchFragmentShader });
+            SHADERMANAGER.CreateProgram(*program, sources);
+
+            vertexArrays->clear();
+            for (int i = 0; i < 16; ++i)
+            {
+                auto vertexArray = std::make_shared<VertexArray>(GL_TRIANGLES, GL_STATIC_DRAW, false);
+                vertexArray->AddVertexAttrib(g_attribPOS, 0);
+                vertexArray->AddVertexAttrib(g_attribUV0, 12);
+                vertexArray->BufferData(MakeVertices(96));
+                vertexArrays->push_back(vertexArray);
+            }
+
+            glGenTextures(1, texture.get());
+            return true;
+        };
+        bench.mTeardown = [texture]()
+        {
+            GLSTATE.DeleteTextures(1, texture.get());
+            *texture = 0;
+        };
+        bench.mRun = [program, vertexArrays, texture](uint64_t iterations)
+        {
+            for (uint64_t i = 0; i < iterations; ++i)
+            {
+                for (auto& it : *vertexArrays)
+                {
+                    SHADERMANAGER.UseProgram(*program);
+                    GLSTATE.BindTexture(0, GL_TEXTURE_2D, *texture);
+                    GLSTATE.Enable(GL_DEPTH_TEST);
+                    GLSTATE.DepthFunc(GL_LEQUAL);
+                    it->Draw();
+                }
+            }
+        };
+        benches.push_back(bench);
+    }
+}
+
+
+/*
+======================================================================================================================================================================================================
+Main
+
+*/
+
+//--------------------------------------------------------------------------------------
+void MyErrorMethod(const std::string& message, const char* func, const char* file, unsigned int line)
+{
+    std::cerr << "(" << func << " | " << line << "): " << message << std::endl;
+}
+
+//--------------------------------------------------------------------------------------
+void PrintUsage()
+{
+    std::cerr << "Usage: bench [--out <file>] [--filter <substring>] [--repetitions <n>] [--min-time <seconds>] [--assets <directory>] [--shader-cache <directory>] [--gl | --record] [--list]" << std::endl;
+}
+
+//--------------------------------------------------------------------------------------
+bool ParseArgs(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--out" && hasValue)
+            g_Config.mOutPath = argv[++i];
+        else if (arg == "--filter" && hasValue)
+            g_Config.mFilter = argv[++i];
+        else if (arg == "--repetitions" && hasValue)
+            g_Config.mRepetitions = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--min-time" && hasValue)
+            g_Config.mMinTime = std::max(0.0, std::atof(argv[++i]));
+        else if (arg == "--assets" && hasValue)
+            g_Config.mAssetDir = argv[++i];
+        else if (arg == "--shader-cache" && hasValue)
+            g_Config.mShaderCacheDir = argv[++i];
+        else if (arg == "--gl")
+            g_Config.mUseGL = true;
+        else if (arg == "--record")
+            g_Config.mRecord = true;
+        else if (arg == "--list")
+            g_Config.mList = true;
+        else
+            return false;
+    }
+    return !(g_Config.mUseGL && g_Config.mRecord);
+}
+
+//--------------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    RegisterErrorMethod(MyErrorMethod);
+
+    if (!ParseArgs(argc, argv))
+    {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    std::vector<Benchmark> benches;
+    AddDDSBenchmarks(benches);
+    AddFontBenchmarks(benches);
+    AddTextBenchmarks(benches);
+    AddVertexBenchmarks(benches);
+    AddAssimpBenchmarks(benches);
+    AddScenarioBenchmarks(benches);
+
+    if (g_Config.mList)
+    {
+        for (const auto& it : benches)
+            std::cout << it.mName << (it.mScenario ? " (scenario)" : "") << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    if (g_Config.mRecord)
+    {
+        g_HaveContext = InstallRecordingBackend(43, false);
+        if (!g_HaveContext)
+            std::cerr << "Failed to install the recording backend; scenario benchmarks will be skipped" << std::endl;
+    }
+    else if (g_Config.mUseGL)
+    {
+        g_HaveContext = InitHeadless(256, 256) != nullptr;
+        if (!g_HaveContext)
+            std::cerr << "Failed to create an OpenGL context; scenario benchmarks will be skipped" << std::endl;
+    }
+
+    std::vector<BenchmarkResult> results;
+    for (const auto& it : benches)
+    {
+        if (!g_Config.mFilter.empty() && it.mName.find(g_Config.mFilter) == std::string::npos)
+            continue;
+
+        std::cerr << it.mName << "... " << std::flush;
+        results.push_back(RunBenchmark(it));
+
+        const auto& result = results.back();
+        if (result.mSkipped)
+            std::cerr << "skipped (" << result.mSkipReason << ")" << std::endl;
+        else
+            std::cerr << *std::min_element(result.mSamples.begin(), result.mSamples.end()) << " ns/iter" << std::endl;
+    }
+
+    //benchmarks hold OpenGL objects and fonts, so release them before the context and FreeType
+    benches.clear();
+
+    if (g_Config.mOutPath.empty())
+    {
+        WriteResults(std::cout, results);
+    }
+    else
+    {
+        std::ofstream outFile(g_Config.mOutPath, std::ios::out | std::ios::trunc);
+        if (!outFile)
+        {
+            std::cerr << "Failed to open \"" << g_Config.mOutPath << "\"" << std::endl;
+            return EXIT_FAILURE;
+        }
+        WriteResults(outFile, results);
+    }
+
+    //streaming scenarios leave textures and staging buffers behind
+    if (g_HaveContext)
+    {
+        ASYNCLOADER.Shutdown();
+        TEXTURESTREAMER.Destroy();
+    }
+
+    //the recording backend stays installed; the shader manager's logs still hold programs until exit
+    if (g_HaveContext && !g_Config.mRecord)
+    {
+        ReleaseHeadless();
+        glfwTerminate();
+    }
+
+    return EXIT_SUCCESS;
+}
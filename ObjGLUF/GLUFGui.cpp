@@ -281,6 +281,9 @@ Initialization and Globals
 
 
 FT_Library g_FtLib;
+bool g_FtLibInitialized = false;
+std::mutex g_FtLibMutex;//FT_New_Face and FT_Done_Face are not thread-safe on a shared library
+GLint g_MaxTextureSize = 1024;
 
 unsigned short g_WndWidth = 0;
 unsigned short g_WndHeight = 0;
@@ -493,13 +496,11 @@ bool InitGui(GLFWwindow* pInitializedGLFWWindow, CallbackFuncPtr callback, GLuin
 
     g_TextVertexArray->BufferIndices(indices);*/
 
-    //initialize the freetype library.
-    FT_Error err = FT_Init_FreeType(&g_FtLib);
-    if (err)
-    {
-        GLUF_ERROR("Failed to Initialize the Freetype Library!");
+    //get maximum texture size once, so fonts can be rasterized without OpenGL
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &g_MaxTextureSize);
+
+    if (!InitFontLibrary())
         return false;
-    }
 
     //load the texture for the controls
     g_pControlTexturePtr = controltex;
@@ -521,10 +522,44 @@ CallbackFuncPtr ChangeCallbackFunc(CallbackFuncPtr newCallback)
     return tmp;
 }
 
+//--------------------------------------------------------------------------------------
+bool InitFontLibrary()
+{
+    _TSAFE_SCOPE(g_FtLibMutex);
+    if (g_FtLibInitialized)
+        return true;
+
+    //initialize the freetype library.
+    FT_Error err = FT_Init_FreeType(&g_FtLib);
+    if (err)
+    {
+        GLUF_ERROR("Failed to Initialize the Freetype Library!");
+        return false;
+    }
+
+    g_FtLibInitialized = true;
+    return true;
+}
+
 //--------------------------------------------------------------------------------------
 void Terminate()
 {
-    FT_Done_FreeType(g_FtLib);
+    //workers may still be rasterizing fonts
+    ASYNCLOADER.Shutdown();
+
+    //release cached textures and buffers while the context is still alive
+    TEXTURESTREAMER.Destroy();
+    RESOURCECACHE.Clear();
+    ReleaseGpuTimers();
+
+    {
+        _TSAFE_SCOPE(g_FtLibMutex);
+        if (g_FtLibInitialized)
+            FT_Done_FreeType(g_FtLib);
+        g_FtLibInitialized = false;
+    }
+
+    ReleaseHeadless();
 }
 
 
@@ -576,10 +611,22 @@ Font
         'mCharacterOffset': the offset within the charset to start creating the texture, default to 32, because that is where ascii characters start
         'mCharacterEnd': the end of the writable characters
         'mTexLineBreakIndices': the character codes which caused line breaks within the texture
+        'mAtlasPixels': the rasterized atlas waiting to be uploaded; empty once it is in 'mTexId'
+        'mFontMemory': a copy of the font data, when not loaded from a mapped file
+        'mFontFile': the mapped font file (or archive), when loaded from one
 */
 class Font
 {    
     std::vector<uint32_t> mTexLineBreakIndices;
+
+    std::vector<unsigned char> mAtlasPixels;
+
+    //FreeType reads from the font data for the life of the face, so it must be kept alive here
+    std::vector<char> mFontMemory;
+    MappedFilePtr mFontFile;
+
+    void InitFace(const MemorySpan& data, FontSize fontHeight);
+    void InitTexture();
 public:
 
     FT_Face mFtFont;
@@ -650,16 +697,37 @@ public:
     Init
     
         Note:
-            Creates a font from a set of data
+            Creates a font from a set of data; a 'std::vector' is copied, 'file' is referenced directly
 
         Parameters:
-            'data': the data to be created from
+            'data': the data to be created from; if 'file' is given, this must point into it (i.e. an archive entry)
+            'file': a mapped font file to be created from
             'fontHeight': the height of the font to load
             
         Throws:
             'LoadFontException': if loading failed
     */
     void Init(const std::vector<char>& data, FontSize fontHeight);
+    void Init(const MappedFilePtr& file, FontSize fontHeight);
+    void Init(const MappedFilePtr& file, const MemorySpan& data, FontSize fontHeight);
+
+    /*
+    InitAsync
+
+        Note:
+            The first half of 'Init(file)'; creates the face and rasterizes the atlas without calling OpenGL, so it
+                can run on a worker thread.  'FinishInitAsync' must then be called on the context thread
+
+        Parameters:
+            'file': a mapped font file to be created from
+            'data': the font data within 'file'
+            'fontHeight': the height of the font to load
+
+        Throws:
+            'LoadFontException': if loading failed
+    */
+    void InitAsync(const MappedFilePtr& file, const MemorySpan& data, FontSize fontHeight);
+    void FinishInitAsync();
 
     /*
     Refresh
@@ -673,6 +741,28 @@ public:
     */
     void Refresh() noexcept;
 
+    /*
+    Rasterize
+
+        Note:
+            Lays out and renders every glyph into 'mAtlasPixels'; does not call OpenGL
+
+        Throws:
+            no-throw guarantee
+    */
+    void Rasterize() noexcept;
+
+    /*
+    UploadAtlas
+
+        Note:
+            Uploads 'mAtlasPixels' to 'mTexId' in one call, then releases them
+
+        Throws:
+            no-throw guarantee
+    */
+    void UploadAtlas() noexcept;
+
     /*
     GetChar*Rect
 
@@ -698,9 +788,19 @@ FontSize GetFontHeight(FontPtr font)
 
 void Font::Refresh() noexcept
 {
+    GLUF_PROFILE_ZONE("Font::Refresh");
+
+    Rasterize();
+    UploadAtlas();
+}
+
+void Font::Rasterize() noexcept
+{
+    GLUF_PROFILE_ZONE("Font::Rasterize");
 
     //reset variables
     mAtlasSize = { 0, 0 };
+    mTexLineBreakIndices.clear();
 
 
     //int mult = (g_WndHeight >= g_WndWidth) ? g_WndWidth : g_WndHeight;
@@ -714,9 +814,8 @@ void Font::Refresh() noexcept
 
     FT_GlyphSlot g = mFtFont->glyph;
 
-    //get maximum texture size, so we don't get opengl complaining
-    GLint maxTexSize = 1024;
-    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTexSize);
+    //maximum texture size is cached at init, so we don't get opengl complaining
+    glm::uint32 maxTexSize = static_cast<glm::uint32>(g_MaxTextureSize);
 
     //add one line of character texture to start
     uint32_t lineHeightWithSpacing = static_cast<uint32_t>((4.f / 3.f) * static_cast<float>(mHeight));
@@ -760,33 +859,8 @@ void Font::Refresh() noexcept
     //resize after getting the texture size, so if characters were omitted due to insufficient texture size, the atlas is of appropriate size
     mCharAtlas.resize(mCharacterEnd - mCharacterOffset);
 
-    //generate textures
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, mTexId);
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
-    // Fonts should be rendered at native resolution so no need for texture filtering
-    //float fLargest = 0.0f;
-    //glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &fLargest);
-    //    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, fLargest);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-    // Stop chararcters from bleeding over edges
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-
-    GLfloat transparent[] = { 0.0f, 0.0f, 0.0f, 0.0f };
-    glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, transparent);//any overflow will be transparent
-
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, mAtlasSize.x, mAtlasSize.y, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, 0);
-
-    //load texture data
-
-    //the data for the glyph padding
-    std::vector<char> paddingData;
-    paddingData.resize(GLYPH_PADDING * lineHeightWithSpacing, 0);
+    //the atlas starts out transparent, which also takes care of the padding between glyphs
+    mAtlasPixels.assign(static_cast<std::size_t>(mAtlasSize.x) * mAtlasSize.y, 0);
 
     int x = 0;
     int y = 0;
@@ -826,12 +900,20 @@ void Font::Refresh() noexcept
             continue;
         }
 
-        glTexSubImage2D(GL_TEXTURE_2D, 0, x + (lineIndex * GLYPH_PADDING), y, g->bitmap.width, g->bitmap.rows, GL_LUMINANCE, GL_UNSIGNED_BYTE, g->bitmap.buffer);
-
-        //this adds padding to keep the characters looking clean
-        glTexSubImage2D(GL_TEXTURE_2D, 0, x + (lineIndex * GLYPH_PADDING) + g->bitmap.width, y, GLYPH_PADDING, mAtlasSize.y, GL_LUMINANCE, GL_UNSIGNED_BYTE, paddingData.data());
+        //copy the glyph into the atlas, clipping anything that would fall outside of it
+        unsigned int dstX = x + (lineIndex * GLYPH_PADDING);
+        unsigned int pitch = static_cast<unsigned int>(std::abs(g->bitmap.pitch));
+        if (dstX < mAtlasSize.x && static_cast<unsigned int>(y) < mAtlasSize.y)
+        {
+            unsigned int copyWidth = glm::min(static_cast<unsigned int>(g->bitmap.width), mAtlasSize.x - dstX);
+            unsigned int copyRows = glm::min(static_cast<unsigned int>(g->bitmap.rows), mAtlasSize.y - y);
+            for (unsigned int row = 0; row < copyRows; ++row)
+            {
+                std::memcpy(&mAtlasPixels[(static_cast<std::size_t>(y) + row) * mAtlasSize.x + dstX], g->bitmap.buffer + row * pitch, copyWidth);
+            }
+        }
 
-        mCharAtlas[p].mTexXOffset = static_cast<float>(x + (lineIndex * GLYPH_PADDING)) / static_cast<float>(mAtlasSize.x);
+        mCharAtlas[p].mTexXOffset = static_cast<float>(dstX) / static_cast<float>(mAtlasSize.x);
         mCharAtlas[p].mTexYOffset = (static_cast<float>(y)+0.5f) / static_cast<float>(mAtlasSize.y);
 
         x += g->bitmap.width;
@@ -852,21 +934,96 @@ void Font::Refresh() noexcept
     g = 0;
 }
 
+void Font::UploadAtlas() noexcept
+{
+    GLUF_PROFILE_ZONE("Font::UploadAtlas");
+
+    //generate textures
+    GLSTATE.BindTexture(0, GL_TEXTURE_2D, mTexId);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    // Fonts should be rendered at native resolution so no need for texture filtering
+    //float fLargest = 0.0f;
+    //glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &fLargest);
+    //    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, fLargest);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    // Stop chararcters from bleeding over edges
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+
+    GLfloat transparent[] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, transparent);//any overflow will be transparent
+
+    //the whole atlas goes up at once, instead of a sub image per glyph
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, mAtlasSize.x, mAtlasSize.y, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, mAtlasPixels.empty() ? nullptr : mAtlasPixels.data());
+
+    mAtlasPixels.clear();
+    mAtlasPixels.shrink_to_fit();
+}
+
 void Font::Init(const std::vector<char>& data, FontSize fontHeight)
+{
+    //the caller's buffer may not outlive this font
+    mFontMemory = data;
+    mFontFile = nullptr;
+
+    InitFace(mFontMemory, fontHeight);
+    InitTexture();
+    Refresh();
+}
+
+void Font::Init(const MappedFilePtr& file, FontSize fontHeight)
+{
+    if (!file)
+        throw LoadFontException();
+
+    Init(file, file->GetView(), fontHeight);
+}
+
+void Font::Init(const MappedFilePtr& file, const MemorySpan& data, FontSize fontHeight)
+{
+    InitAsync(file, data, fontHeight);
+    FinishInitAsync();
+}
+
+void Font::InitAsync(const MappedFilePtr& file, const MemorySpan& data, FontSize fontHeight)
+{
+    if (!file)
+        throw LoadFontException();
+
+    mFontMemory.clear();
+    mFontFile = file;
+
+    InitFace(data, fontHeight);
+    Rasterize();
+}
+
+void Font::FinishInitAsync()
+{
+    InitTexture();
+    UploadAtlas();
+}
+
+void Font::InitFace(const MemorySpan& data, FontSize fontHeight)
 {
     mHeight = fontHeight;
 
+    _TSAFE_SCOPE(g_FtLibMutex);
     if (FT_New_Memory_Face(g_FtLib, (const FT_Byte*)data.data(), (FT_Long)data.size(), 0, &mFtFont))
         throw LoadFontException();
+}
 
+void Font::InitTexture()
+{
     glGenTextures(1, &mTexId);
 
     if (mTexId == 0)
     {
         throw LoadFontException();
     }
-
-    Refresh();
 }
 
 Rect Font::GetCharRect(wchar_t ch)
@@ -973,6 +1130,87 @@ void LoadFont(FontPtr& font, const std::vector<char>& rawData, FontSize fontHeig
     font->Init(rawData, fontHeight);
 }
 
+void LoadFont(FontPtr& font, const MappedFilePtr& file, FontSize fontHeight)
+{
+    font = std::make_shared<Font>();
+
+    font->Init(file, fontHeight);
+}
+
+void LoadFont(FontPtr& font, const AssetArchive& archive, const std::string& assetName, FontSize fontHeight)
+{
+    MemorySpan data;
+    if (!archive.TryGetAsset(assetName, data))
+    {
+        GLUF_ERROR_LONG("(LoadFont): \"" << assetName << "\" is not in the archive");
+        throw LoadFontException();
+    }
+
+    font = std::make_shared<Font>();
+
+    //the font holds the archive's mapping, so the span stays valid
+    font->Init(archive.GetFile(), data, fontHeight);
+}
+
+void LoadFontFromFile(FontPtr& font, const std::string& filePath, FontSize fontHeight)
+{
+    MappedFilePtr file;
+    try
+    {
+        file = MapFile(filePath);
+    }
+    catch (const std::ios_base::failure& e)
+    {
+        GLUF_ERROR_LONG("(LoadFontFromFile): " << e.what());
+        throw LoadFontException();
+    }
+
+    LoadFont(font, file, fontHeight);
+}
+
+void LoadFontHeadless(FontPtr& font, const MappedFilePtr& file, FontSize fontHeight)
+{
+    if (!file)
+        throw LoadFontException();
+
+    font = std::make_shared<Font>();
+
+    //the same as the worker half of an async load; the atlas is just never uploaded
+    font->InitAsync(file, file->GetView(), fontHeight);
+}
+
+void RasterizeFont(const FontPtr& font)
+{
+    font->Rasterize();
+}
+
+std::future<FontPtr> LoadFontFromFileAsync(const std::string& filePath, FontSize fontHeight)
+{
+    return ASYNCLOADER.LoadAsync<FontPtr>([filePath, fontHeight]() -> std::function<FontPtr()>
+    {
+        MappedFilePtr file;
+        try
+        {
+            file = MapFile(filePath);
+        }
+        catch (const std::ios_base::failure& e)
+        {
+            GLUF_ERROR_LONG("(LoadFontFromFileAsync): " << e.what());
+            throw LoadFontException();
+        }
+
+        //FreeType rasterization happens here on the worker
+        auto font = std::make_shared<Font>();
+        font->InitAsync(file, file->GetView(), fontHeight);
+
+        return [font]()
+        {
+            font->FinishInitAsync();
+            return font;
+        };
+    });
+}
+
 
 
 /*
@@ -1248,6 +1486,9 @@ void Dialog::Refresh() noexcept
 //--------------------------------------------------------------------------------------
 void Dialog::OnRender(float elapsedTime) noexcept
 {
+    GLUF_PROFILE_ZONE("Dialog::OnRender");
+    GLUF_GPU_PASS("Dialog::OnRender");
+
     // If this assert triggers, you need to call DialogResourceManager::On*Device() from inside
     // the application's device callbacks.  See the SDK samples for an example of how to do this.
     //assert(m_pManager->GetD3D11Device() &&
@@ -1266,13 +1507,16 @@ void Dialog::OnRender(float elapsedTime) noexcept
         (mMinimized && !mCaptionEnabled))
         return;
 
+    //the application may have changed state with raw OpenGL calls since the last frame, which the cache cannot see
+    GLSTATE.Invalidate();
+
     // Enable depth test
-    glDisable(GL_DEPTH_TEST);
-    glDisable(GL_CULL_FACE);
-    glDisable(GL_DEPTH_CLAMP);
+    GLSTATE.Disable(GL_DEPTH_TEST);
+    GLSTATE.Disable(GL_CULL_FACE);
+    GLSTATE.Disable(GL_DEPTH_CLAMP);
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLSTATE.Enable(GL_BLEND);
+    GLSTATE.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     mDialogManager->BeginSprites();
 
@@ -1342,8 +1586,8 @@ void Dialog::OnRender(float elapsedTime) noexcept
     }*/
     //m_pManager->RestoreD3D11State(pd3dDeviceContext);
 
-    glDisable(GL_BLEND);
-    glEnable(GL_DEPTH_CLAMP);//set this back because it is the default
+    GLSTATE.Disable(GL_BLEND);
+    GLSTATE.Enable(GL_DEPTH_CLAMP);//set this back because it is the default
 }
 
 
@@ -2299,6 +2543,8 @@ void Dialog::DrawRect(const Rect& rect, const Color& color, bool transform)
 
 void Dialog::DrawSprite(const Element& element, const Rect& rect, float depth, bool textured)
 {
+    GLUF_PROFILE_ZONE("Dialog::DrawSprite");
+
     // No need to draw fully transparent layers
     if (element.mTextureColor.GetCurrent().a == 0)
         return;
@@ -2602,9 +2848,7 @@ void Dialog::InitDefaultElements()
         if (g_ArialDefault == nullptr)
         {
 
-            std::vector<char> rawData;
-            LoadFileIntoMemory("Arial.ttf", rawData);
-            LoadFont(g_ArialDefault, rawData, 15L);
+            LoadFontFromFile(g_ArialDefault, "Arial.ttf", 15L);
         }
 
         fontIndex = mDialogManager->AddFont(g_ArialDefault, 20, FONT_WEIGHT_NORMAL);
@@ -3101,9 +3345,8 @@ void DialogResourceManager::EndSprites(const Element* element, bool textured)
 
         TextureNodePtr pTexture = GetTextureNode(element->mTextureIndex);
 
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, pTexture->mTextureElement);
-        glUniform1i(g_UIShaderLocations.sampler, 0);
+        GLSTATE.BindTexture(0, GL_TEXTURE_2D, pTexture->mTextureElement);
+        SHADERMANAGER.GLUniform1i(g_UIShaderLocations.sampler, 0);
     }
     else
     {
@@ -7121,8 +7364,7 @@ void EditBox::RenderText(float elapsedTime) noexcept
     SHADERMANAGER.GLUniformMatrix4f(g_TextShaderLocations.ortho, Text::g_TextOrtho);
 
     //second, the sampler
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, mDialog.GetFont(element.mFontIndex)->mFontType->mTexId);
+    GLSTATE.BindTexture(0, GL_TEXTURE_2D, mDialog.GetFont(element.mFontIndex)->mFontType->mTexId);
     SHADERMANAGER.GLUniform1i(g_TextShaderLocations.sampler, 0);
 
 
@@ -7130,8 +7372,8 @@ void EditBox::RenderText(float elapsedTime) noexcept
     SHADERMANAGER.GLUniform4f(g_TextShaderLocations.color, ColorToFloat(element.mFontColor.GetCurrent()));
 
     //make sure to enable this with text
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLSTATE.Enable(GL_BLEND);
+    GLSTATE.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     if (mSelStart == -2 || mSelStart == mCaretPos)
     {
@@ -7730,11 +7972,10 @@ void BeginText(const glm::mat4& orthoMatrix)
 }
 
 //--------------------------------------------------------------------------------------
-void DrawText(const FontNodePtr& font, const std::wstring& text, const Rect& rect, const Color& color, Bitfield textFlags, bool hardRect)
+bool BuildTextVertices(const FontNodePtr& font, const std::wstring& text, const Rect& rect, Bitfield textFlags, bool hardRect, GLVector<TextVertexStruct>& textVertices, std::vector<glm::u32vec3>& indices)
 {
-
     if ((long)font->mFontType->mHeight > RectHeight(rect) && hardRect)
-        return;//no sense rendering if it is too big
+        return false;//no sense rendering if it is too big
 
     //rcScreen = ScreenToClipspace(rcScreen);
 
@@ -7783,8 +8024,8 @@ void DrawText(const FontNodePtr& font, const std::wstring& text, const Rect& rec
     //get the number of vertices
     GLsizei textBuffLen = text.size() * 4;
 
-    auto textVertices = TextVertexStruct::MakeMany(textBuffLen);
-    std::vector<glm::u32vec3> indices;
+    textVertices = TextVertexStruct::MakeMany(textBuffLen);
+    indices.clear();
     indices.resize(text.size() * 2);
 
     float z = _NEAR_BUTTON_DEPTH;
@@ -7888,6 +8129,20 @@ void DrawText(const FontNodePtr& font, const std::wstring& text, const Rect& rec
 
         ++i;
     }
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------
+void DrawText(const FontNodePtr& font, const std::wstring& text, const Rect& rect, const Color& color, Bitfield textFlags, bool hardRect)
+{
+    GLUF_PROFILE_ZONE("Text::DrawText");
+
+    GLVector<TextVertexStruct> textVertices;
+    std::vector<glm::u32vec3> indices;
+    if (!BuildTextVertices(font, text, rect, textFlags, hardRect, textVertices, indices))
+        return;
+
     //glEnd();
 
     //g_TextColor = ColorToFloat(color);
@@ -7913,8 +8168,7 @@ void EndText(const FontPtr& font, const VertexArrayPtr& data, const Color& textC
     SHADERMANAGER.GLUniformMatrix4f(g_TextShaderLocations.ortho, projMatrix);
 
     //second, the sampler
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, font->mTexId);
+    GLSTATE.BindTexture(0, GL_TEXTURE_2D, font->mTexId);
     SHADERMANAGER.GLUniform1i(g_TextShaderLocations.sampler, 0);
 
 
@@ -7922,8 +8176,8 @@ void EndText(const FontPtr& font, const VertexArrayPtr& data, const Color& textC
     SHADERMANAGER.GLUniform4f(g_TextShaderLocations.color, ColorToFloat(textColor));
 
     //make sure to enable this with text
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLSTATE.Enable(GL_BLEND);
+    GLSTATE.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     data->Draw();
 
@@ -7932,6 +8186,20 @@ void EndText(const FontPtr& font, const VertexArrayPtr& data, const Color& textC
 }
 
 
+//--------------------------------------------------------------------------------------
+std::size_t LayoutText(const FontNodePtr& font, const std::wstring& text, const Rect& rect, Bitfield textFlags, bool hardRect)
+{
+    GLUF_PROFILE_ZONE("LayoutText");
+
+    GLVector<TextVertexStruct> textVertices;
+    std::vector<glm::u32vec3> indices;
+    if (!Text::BuildTextVertices(font, text, rect, textFlags, hardRect, textVertices, indices))
+        return 0;
+
+    return textVertices.size();
+}
+
+
 //TextHelper
 TextHelper::TextHelper(DialogResourceManagerPtr& manager) :
     mManager(manager), mColor(0, 0, 0, 255), mPoint(0L, 0L), 
@@ -7940,12 +8208,15 @@ TextHelper::TextHelper(DialogResourceManagerPtr& manager) :
 
 void TextHelper::Begin(FontIndex drmFont, FontSize leading, FontSize size)
 {
-    glDisable(GL_DEPTH_TEST);
-    glDisable(GL_CULL_FACE);
-    glDisable(GL_DEPTH_CLAMP);
+    //see 'Dialog::OnRender'
+    GLSTATE.Invalidate();
+
+    GLSTATE.Disable(GL_DEPTH_TEST);
+    GLSTATE.Disable(GL_CULL_FACE);
+    GLSTATE.Disable(GL_DEPTH_CLAMP);
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLSTATE.Enable(GL_BLEND);
+    GLSTATE.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     mManager->GetFontNode(drmFont);
 
@@ -7977,7 +8248,7 @@ void TextHelper::DrawTextLineBase(const Rect& rc, Bitfield flags, const std::wst
 
 void TextHelper::End() noexcept
 {
-    glDisable(GL_BLEND);
-    glEnable(GL_DEPTH_CLAMP);//set this back because it is the default
+    GLSTATE.Disable(GL_BLEND);
+    GLSTATE.Enable(GL_DEPTH_CLAMP);//set this back because it is the default
 }
 }
@@ -312,6 +312,19 @@ InitGui --Main Setup Function
 */
 OBJGLUF_API bool InitGui(GLFWwindow* initializedWindow, CallbackFuncPtr callbackFunc, GLuint controltex);
 
+/*
+InitFontLibrary
+
+    Note:
+        Initializes FreeType; 'InitGui' calls this, but it can also be called on its own to load and lay out fonts
+            without a window or OpenGL context, i.e. in tools and benchmarks.  Calling it again does nothing
+
+    Returns:
+        false if FreeType failed to initialize
+
+*/
+OBJGLUF_API bool InitFontLibrary();
+
 //swaps callback functions, returns old
 OBJGLUF_API CallbackFuncPtr ChangeCallbackFunc(CallbackFuncPtr newCallback);
 
@@ -348,18 +361,70 @@ public:
 };
 
 /*
-LoadFont
+LoadFont*
 
     Parameters:
         'font': an uninitialized font
-        'rawData': the raw data to load font from
+        'rawData': the raw data to load font from; this is copied into the font
+        'file': a mapped font file; the font keeps the mapping alive instead of copying it
+        'archive': an open asset archive; the font keeps the archive's mapping alive
+        'assetName': name of the font within 'archive'
+        'filePath': path of a font file to map
         'fontHeight': how tall should the font be in points?
 
     Throws:
-        'LoadFontException': if font loading failed
+        'LoadFontException': if font loading failed, 'filePath' could not be opened, or 'assetName' is not in 'archive'
 
 */
 OBJGLUF_API void LoadFont(FontPtr& font, const std::vector<char>& rawData, FontSize fontHeight);
+OBJGLUF_API void LoadFont(FontPtr& font, const MappedFilePtr& file, FontSize fontHeight);
+OBJGLUF_API void LoadFont(FontPtr& font, const AssetArchive& archive, const std::string& assetName, FontSize fontHeight);
+OBJGLUF_API void LoadFontFromFile(FontPtr& font, const std::string& filePath, FontSize fontHeight);
+
+/*
+LoadFontFromFileAsync
+
+    Parameters:
+        'filePath': path of a font file to map
+        'fontHeight': how tall should the font be in points?
+
+    Returns:
+        a future for the font; the face is created and rasterized on an 'AsyncLoader' worker, and the atlas is
+            uploaded during 'ASYNCLOADER.ProcessUploads'
+
+    Throws:
+        through the future: 'LoadFontException': if font loading failed, or 'filePath' could not be opened
+
+*/
+OBJGLUF_API std::future<FontPtr> LoadFontFromFileAsync(const std::string& filePath, FontSize fontHeight);
+
+/*
+LoadFontHeadless
+
+    Parameters:
+        'font': an uninitialized font
+        'file': a mapped font file; the font keeps the mapping alive
+        'fontHeight': how tall should the font be in points?
+
+    Throws:
+        'LoadFontException': if font loading failed
+
+    Note:
+        Creates the face and rasterizes the atlas without calling OpenGL; the font can be measured and laid out, but
+            not drawn.  Only needs 'InitFontLibrary'
+
+*/
+OBJGLUF_API void LoadFontHeadless(FontPtr& font, const MappedFilePtr& file, FontSize fontHeight);
+
+/*
+RasterizeFont
+
+    Note:
+        Rebuilds the glyph atlas of 'font' in CPU memory without uploading it; the part of a font refresh which does
+            not call OpenGL
+
+*/
+OBJGLUF_API void RasterizeFont(const FontPtr& font);
 
 OBJGLUF_API FontSize GetFontHeight(const FontPtr& font);
 
@@ -1080,6 +1145,8 @@ public:
 
         Note:
             Call this every frame
+            This calls 'GLSTATE.Invalidate' first, so state the application set with raw OpenGL calls is not mistaken
+                for what the previous frame's GUI left behind
 
         Parameters:
             'elapsedTime': the time since the previous call to 'OnRender()'
@@ -1232,6 +1299,26 @@ struct FontNode
     FontPtr mFontType;
 };
 
+/*
+LayoutText
+
+    Parameters:
+        'font': the font to lay out with
+        'text': the text to lay out
+        'rect': the rect to lay the text out in, in screen space
+        'textFlags': 'GT_*' alignment flags
+        'hardRect': should the text be bound completely to the rect
+
+    Returns:
+        the number of vertices generated, or 0 if the text does not fit
+
+    Note:
+        Generates the vertices for 'text' exactly like drawing it does, without drawing it; for measuring text layout
+            cost, and works with fonts loaded by 'LoadFontHeadless'
+
+*/
+OBJGLUF_API std::size_t LayoutText(const FontNodePtr& font, const std::wstring& text, const Rect& rect, Bitfield textFlags, bool hardRect = false);
+
 
 
 
@@ -3255,6 +3342,7 @@ public:
 
         Note:
             Call this before calling any text drawing calls
+            This calls 'GLSTATE.Invalidate' first, the same as 'Dialog::OnRender'
 
         Parameters:
             'drmFont': the index of the font to use
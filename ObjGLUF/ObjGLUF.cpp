@@ -22,8 +22,31 @@ for more details.
 #include "ObjGLUF.h"
 #include <fstream>
 #include <sstream>
+#include <iomanip>
+#include <set>
+#include <limits>
 #include <GLFW/glfw3.h>
 
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+//SSE2 is part of every x64 target; AVX2 is only used if the CPU reports it at runtime
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GLUF_SSE2
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
 
 /*
 
@@ -32,6 +55,13 @@ Internal Macros
 */
 #define RETHROW throw
 
+//lets a function use AVX2 instructions without the whole file being compiled for AVX2
+#if defined(GLUF_SSE2) && !defined(_MSC_VER)
+#define GLUF_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define GLUF_TARGET_AVX2
+#endif
+
 namespace GLUF
 {
 
@@ -59,6 +89,10 @@ class GLExtensions
     //--------------------------------------------------------------------------------------
     void Init(const std::vector<std::string>& extensions)
     {
+        //the context may have been swapped (see 'InstallRecordingBackend')
+        mExtensionList.clear();
+        mBufferedExtensionList.clear();
+
         for (auto it : extensions)
         {
             mExtensionList.insert({ it, true });
@@ -67,7 +101,7 @@ class GLExtensions
         mCachedExtensionVector = extensions;
     }
 
-    friend bool InitOpenGLExtensions();
+    friend bool InitContextInfo();
 public:
 
     //--------------------------------------------------------------------------------------
@@ -145,6 +179,7 @@ Global Instances
 ErrorMethod g_ErrorMethod;
 //BufferManager g_BufferManager;
 ShaderManager g_ShaderManager;
+GLStateCache g_GLStateCache;
 
 
 /*
@@ -190,6 +225,12 @@ GLuint gGLVersionMajor = 0;
 GLuint gGLVersionMinor = 0;
 GLuint gGLVersion2Digit = 0;
 
+//block compression families the context can sample from; see 'IsCompressedFormatSupported'
+bool gSupportsS3TC = false;
+bool gSupportsS3TCsRGB = false;
+bool gSupportsRGTC = false;
+bool gSupportsBPTC = false;
+
 //--------------------------------------------------------------------------------------
 GLuint GetGLVersionMajor()
 {
@@ -265,15 +306,9 @@ bool Init()
 }
 
 //--------------------------------------------------------------------------------------
-bool InitOpenGLExtensions()
+//reads the version and extensions from whatever the glad entry points currently point to
+bool InitContextInfo()
 {
-    int err = gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
-    if (err == 0)
-    {
-        GLUF_ERROR("Failed to initialize OpenGL Extensions using GLAD");
-        return false;
-    }
-
     //get the list of extensions
     const char* extensions = (const char*)glGetString(GL_EXTENSIONS);
     gExtensions.Init(SplitStr(extensions, ' '));
@@ -288,6 +323,9 @@ bool InitOpenGLExtensions()
     gGLVersionMinor = std::stoi(vsVec[1]);
     gGLVersion2Digit = gGLVersionMajor * 10 + gGLVersionMinor;
 
+    //nothing is known about a fresh context
+    GLSTATE.Invalidate();
+
     //if the version is less than 2.1, do not allow to continue
     if ((gGLVersionMajor == 2 && gGLVersionMinor < 1) || gGLVersionMajor < 2)
     {
@@ -295,6 +333,12 @@ bool InitOpenGLExtensions()
         return false;
     }
 
+    //decided once here, because textures are decoded on worker threads, and the extension lookups are not thread safe
+    gSupportsS3TC = gExtensions.HasExtension("GL_EXT_texture_compression_s3tc");
+    gSupportsS3TCsRGB = gSupportsS3TC && (gExtensions.HasExtension("GL_EXT_texture_sRGB") || gExtensions.HasExtension("GL_EXT_texture_compression_s3tc_srgb"));
+    gSupportsRGTC = gGLVersion2Digit >= 30 || gExtensions.HasExtension("GL_ARB_texture_compression_rgtc") || gExtensions.HasExtension("GL_EXT_texture_compression_rgtc");
+    gSupportsBPTC = gGLVersion2Digit >= 42 || gExtensions.HasExtension("GL_ARB_texture_compression_bptc");
+
     g_stdAttrib.insert(VertexAttribPair(GLUF_VERTEX_ATTRIB_POSITION, g_attribPOS));
     g_stdAttrib.insert(VertexAttribPair(GLUF_VERTEX_ATTRIB_NORMAL, g_attribNORM));
     g_stdAttrib.insert(VertexAttribPair(GLUF_VERTEX_ATTRIB_UV0, g_attribPOS));
@@ -321,6 +365,19 @@ bool InitOpenGLExtensions()
     return true;
 }
 
+//--------------------------------------------------------------------------------------
+bool InitOpenGLExtensions()
+{
+    int err = gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
+    if (err == 0)
+    {
+        GLUF_ERROR("Failed to initialize OpenGL Extensions using GLAD");
+        return false;
+    }
+
+    return InitContextInfo();
+}
+
 
 //--------------------------------------------------------------------------------------
 const std::vector<std::string>& GetGLExtensions()
@@ -328,6 +385,188 @@ const std::vector<std::string>& GetGLExtensions()
     return gExtensions;
 }
 
+namespace Headless
+{
+    GLFWwindow* g_Window = nullptr;
+    GLuint g_Framebuffer = 0;
+    GLuint g_ColorBuffer = 0;
+    GLuint g_DepthBuffer = 0;
+    GLuint g_Width = 0;
+    GLuint g_Height = 0;
+
+    //--------------------------------------------------------------------------------------
+    void DeleteFramebuffer()
+    {
+        if (g_Framebuffer != 0)
+        {
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            glDeleteFramebuffers(1, &g_Framebuffer);
+            glDeleteRenderbuffers(1, &g_ColorBuffer);
+            glDeleteRenderbuffers(1, &g_DepthBuffer);
+        }
+        g_Framebuffer = g_ColorBuffer = g_DepthBuffer = 0;
+    }
+
+    //--------------------------------------------------------------------------------------
+    bool CreateFramebuffer(GLuint width, GLuint height)
+    {
+        glGenRenderbuffers(1, &g_ColorBuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, g_ColorBuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+        glGenRenderbuffers(1, &g_DepthBuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, g_DepthBuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+        glGenFramebuffers(1, &g_Framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, g_Framebuffer);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, g_ColorBuffer);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, g_DepthBuffer);
+
+        GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        if (status != GL_FRAMEBUFFER_COMPLETE)
+        {
+            std::stringstream ss;
+            ss << "InitHeadless: Offscreen framebuffer incomplete (0x" << std::hex << status << ")";
+            GLUF_ERROR(ss.str());
+
+            DeleteFramebuffer();
+            return false;
+        }
+
+        return true;
+    }
+}
+
+//--------------------------------------------------------------------------------------
+GLFWwindow* InitHeadless(GLuint width, GLuint height, bool preferEGL)
+{
+    using namespace Headless;
+
+    if (g_Window)
+    {
+        GLUF_ERROR("InitHeadless: Headless context already exists");
+        return nullptr;
+    }
+
+    if (width == 0 || height == 0)
+    {
+        GLUF_ERROR("InitHeadless: Framebuffer size must not be zero");
+        return nullptr;
+    }
+
+    if (!Init())
+        return nullptr;
+
+    //GLFW has no way to read hints back, so the two set here are reset to GLFW's defaults afterwards, not to what the
+    //  caller had; the header documents this
+    glfwWindowHint(GLFW_VISIBLE, GL_FALSE);
+
+    //if EGL is not available, GLFW reports why before we fall back to the native API
+    GLFWwindow* window = nullptr;
+    if (preferEGL)
+    {
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+        window = glfwCreateWindow((int)width, (int)height, "ObjGLUF Headless", nullptr, nullptr);
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_NATIVE_CONTEXT_API);
+    }
+
+    if (!window)
+        window = glfwCreateWindow((int)width, (int)height, "ObjGLUF Headless", nullptr, nullptr);
+
+    glfwWindowHint(GLFW_VISIBLE, GL_TRUE);
+
+    if (!window)
+    {
+        GLUF_ERROR("InitHeadless: Failed to create an offscreen context");
+        return nullptr;
+    }
+
+    glfwMakeContextCurrent(window);
+    if (!InitOpenGLExtensions())
+    {
+        glfwMakeContextCurrent(nullptr);
+        glfwDestroyWindow(window);
+        return nullptr;
+    }
+
+    g_Window = window;
+    g_Width = width;
+    g_Height = height;
+
+    if (gGLVersion2Digit >= 30 || gExtensions.HasExtension("GL_ARB_framebuffer_object"))
+    {
+        if (!CreateFramebuffer(width, height))
+            GLUF_ERROR("InitHeadless: Falling back to the hidden window's framebuffer");
+    }
+    else
+    {
+        GLUF_ERROR("InitHeadless: Framebuffer objects not supported; using the hidden window's framebuffer");
+    }
+
+    GLSTATE.Viewport(0, 0, (GLsizei)width, (GLsizei)height);
+
+    return window;
+}
+
+//--------------------------------------------------------------------------------------
+bool IsHeadless()
+{
+    return Headless::g_Window != nullptr;
+}
+
+//--------------------------------------------------------------------------------------
+GLuint GetDefaultFramebuffer()
+{
+    return Headless::g_Framebuffer;
+}
+
+//--------------------------------------------------------------------------------------
+void ReadHeadlessPixels(std::vector<unsigned char>& rgba, GLuint& width, GLuint& height)
+{
+    if (Headless::g_Window)
+    {
+        width = Headless::g_Width;
+        height = Headless::g_Height;
+    }
+    else
+    {
+        int w = 0, h = 0;
+        if (glfwGetCurrentContext())
+            glfwGetFramebufferSize(glfwGetCurrentContext(), &w, &h);
+
+        width = (GLuint)w;
+        height = (GLuint)h;
+    }
+
+    rgba.resize((std::size_t)width * height * 4);
+    if (rgba.empty())
+        return;
+
+    if (Headless::g_Framebuffer != 0)
+        glBindFramebuffer(GL_FRAMEBUFFER, Headless::g_Framebuffer);
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, (GLsizei)width, (GLsizei)height, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+}
+
+//--------------------------------------------------------------------------------------
+void ReleaseHeadless()
+{
+    using namespace Headless;
+
+    if (!g_Window)
+        return;
+
+    glfwMakeContextCurrent(g_Window);
+    DeleteFramebuffer();
+
+    glfwMakeContextCurrent(nullptr);
+    glfwDestroyWindow(g_Window);
+    g_Window = nullptr;
+}
+
 //void Terminate()
 //{
 //
@@ -343,6 +582,7 @@ Statistics
 namespace FrameStats
 {
     StatsData g_StatsData;
+    unsigned long long g_PrevStateSkips = 0LL;//'GLSTATE' total at the end of the previous frame
 }
 
 //--------------------------------------------------------------------------------------
@@ -353,6 +593,29 @@ void Stats_func()
     ++g_StatsData.mFrameCount;
 
     double thisFrame = GetTime();
+
+    //record this frame; the very first call has nothing to measure against
+    if (g_StatsData.mLastFrameTime != 0.0)
+    {
+        double frameTime = thisFrame - g_StatsData.mLastFrameTime;
+
+        unsigned long long index = g_StatsData.mFrameTimeCount.load(std::memory_order_relaxed);
+        g_StatsData.mFrameTimes[index & (GLUF_FRAME_HISTORY_SIZE - 1)].store((float)frameTime, std::memory_order_relaxed);
+        g_StatsData.mFrameTimeCount.store(index + 1, std::memory_order_release);
+
+        if (frameTime > g_StatsData.mHitchThreshold)
+            g_StatsData.mHitchCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    g_StatsData.mLastFrameTime = thisFrame;
+
+    ResolveGpuTimers();
+    ResolveGLCallCounters();
+
+    //the state cache stats may have been reset since last frame
+    unsigned long long stateSkips = GLSTATE.GetStats().GetTotalSkipped();
+    g_StatsData.mGLStateSkips = stateSkips >= g_PrevStateSkips ? stateSkips - g_PrevStateSkips : stateSkips;
+    g_PrevStateSkips = stateSkips;
+
     if (thisFrame - g_StatsData.mPreviousFrame < g_StatsData.mUpdateInterval)
         return;//don't update statistics
 
@@ -362,4204 +625,14313 @@ void Stats_func()
 
     g_StatsData.mFrameCount = 0;//reset the frame count
 
-    std::wstringstream wss;
-    //for now, only use whole FPS's
-    wss << (unsigned int)g_StatsData.mCurrFPS << " fps";
-
-    //update device statistics
-    //TODO:
-
     g_StatsData.mPreviousFrame = thisFrame;
 }
 
 //--------------------------------------------------------------------------------------
-const std::wstring& GetFrameStatsString()
+FrameTimeSummary SampleFrameTimes()
 {
-    return FrameStats::g_StatsData.mFormattedStatsData;
-}
+    using namespace FrameStats;
 
-//--------------------------------------------------------------------------------------
-std::wstring g_DeviceStatusCache = L"WIP";
-const std::wstring& GetDeviceStatus()
-{
-    return g_DeviceStatusCache;
-}
+    FrameTimeSummary ret;
+    ret.mHitchCount = g_StatsData.mHitchCount.load(std::memory_order_relaxed);
 
-//--------------------------------------------------------------------------------------
-const StatsData& GetFrameStats()
-{
-    return FrameStats::g_StatsData;
-}
+    unsigned long long count = g_StatsData.mFrameTimeCount.load(std::memory_order_acquire);
+    unsigned int sampleCount = (unsigned int)std::min<unsigned long long>(count, GLUF_FRAME_HISTORY_SIZE);
+    if (sampleCount == 0)
+        return ret;
 
-/*
-======================================================================================================================================================================================================
-IO and Stream Utilities
+    float samples[GLUF_FRAME_HISTORY_SIZE];
+    for (unsigned int i = 0; i < sampleCount; ++i)
+        samples[i] = g_StatsData.mFrameTimes[(count - 1 - i) & (GLUF_FRAME_HISTORY_SIZE - 1)].load(std::memory_order_relaxed);
 
-*/
+    float* begin = samples;
+    float* end = samples + sampleCount;
 
-//--------------------------------------------------------------------------------------
-void LoadFileIntoMemory(const std::string& path, std::string& textMemory)
-{
-    //try to open file
-    std::ifstream inFile;
-    inFile.exceptions(std::ios_base::failbit | std::ifstream::badbit);
-    try
-    {
-        inFile.open(path, std::ios_base::in);
-    }
-    catch (std::ios_base::failure e)
+    ret.mSampleCount = sampleCount;
+
+    double sum = 0.0;
+    ret.mMin = *begin;
+    ret.mMax = *begin;
+    for (float* it = begin; it != end; ++it)
     {
-        GLUF_ERROR_LONG("Failed to Open File: " << e.what());
-        RETHROW;
+        sum += *it;
+        ret.mMin = std::min(ret.mMin, *it);
+        ret.mMax = std::max(ret.mMax, *it);
     }
+    ret.mAverage = (float)(sum / sampleCount);
 
-    //delete anything already in here
-    textMemory.clear();
+    //nearest-rank percentiles; each partition only has to look past the previous one
+    auto percentile = [&](float* from, double p) -> float*
+    {
+        unsigned int rank = (unsigned int)std::ceil(p * sampleCount);
+        float* nth = begin + (rank == 0 ? 0 : rank - 1);
+        std::nth_element(from, nth, end);
+        return nth;
+    };
 
-    //get file length
-    inFile.seekg(0, std::ios::end);
-    unsigned int rawSize = static_cast<unsigned int>(inFile.tellg());
-    inFile.seekg(0, std::ios::beg);
+    float* p50 = percentile(begin, 0.50);
+    ret.mP50 = *p50;
+    float* p95 = percentile(p50, 0.95);
+    ret.mP95 = *p95;
+    ret.mP99 = *percentile(p95, 0.99);
 
-    //resize the vector
-    textMemory.reserve(rawSize);//is this line needed?
-    textMemory.resize(rawSize);
+    return ret;
+}
 
-    //try reading the memory
-    try
-    {
-        inFile.read(&textMemory[0], rawSize);
-        inFile.close();
-    }
-    catch (std::ios_base::failure e)
-    {
-        if (inFile.is_open())
-            inFile.close();
-        GLUF_ERROR_LONG("Failed to load file into memory:" << e.what());
-        RETHROW;
-    }
+//--------------------------------------------------------------------------------------
+void SetHitchThreshold(double seconds)
+{
+    FrameStats::g_StatsData.mHitchThreshold = seconds;
 }
 
 //--------------------------------------------------------------------------------------
-void LoadFileIntoMemory(const std::string& path, std::vector<char>& binMemory)
+const std::wstring& GetFrameStatsString()
 {
-    //try to open file
-    std::ifstream inFile;
-    inFile.exceptions(std::ios_base::failbit | std::ifstream::badbit);
-    try
-    {
-        inFile.open(path, std::ios::binary | std::ios_base::in);
-    }
-    catch (std::ios_base::failure e)
-    {
-        GLUF_ERROR_LONG("Failed to Open File: " << e.what());
-        RETHROW;
-    }
+    using namespace FrameStats;
 
-    // TODO: we don't need to delete it if we're going to resize it below
-    //delete anything already in here
-    binMemory.clear();
+    FrameTimeSummary summary = SampleFrameTimes();
 
-    //get file length
-    inFile.seekg(0, std::ios::end);
-    unsigned int rawSize = static_cast<unsigned int>(inFile.tellg());
-    inFile.seekg(0, std::ios::beg);
+    std::wstringstream wss;
+    //for now, only use whole FPS's
+    wss << (unsigned int)g_StatsData.mCurrFPS << L" fps";
 
-    //resize the vector
-    binMemory.reserve(rawSize);//is this line needed?
-    binMemory.resize(rawSize);
+    if (summary.mSampleCount != 0)
+    {
+        wss << std::fixed << std::setprecision(1)
+            << L", p50: " << summary.mP50 * 1000.0f << L" ms"
+            << L", p95: " << summary.mP95 * 1000.0f << L" ms"
+            << L", p99: " << summary.mP99 * 1000.0f << L" ms"
+            << L", max: " << summary.mMax * 1000.0f << L" ms"
+            << L", hitches: " << summary.mHitchCount;
+    }
 
-    //try reading the memory
-    try
+    if (IsGLCallCountingEnabled())
     {
-        inFile.read(&binMemory[0], rawSize);
-        inFile.close();
+        const auto& calls = g_StatsData.mGLCalls;
+        wss << std::fixed << std::setprecision(1)
+            << L"\nDraws: " << calls.mDrawCalls
+            << L", Buffer Uploads: " << calls.mBufferUploads << L" (" << calls.mBufferUploadBytes / 1024.0 << L" KB)"
+            << L", Texture Uploads: " << calls.mTextureUploads << L" (" << calls.mTextureUploadBytes / 1024.0 << L" KB)"
+            << L", Program Binds: " << calls.mProgramBinds
+            << L", Texture Binds: " << calls.mTextureBinds
+            << L", Skipped State Changes: " << g_StatsData.mGLStateSkips;
     }
-    catch (std::ios_base::failure e)
+
+    if (!g_StatsData.mGpuPassTimes.empty())
     {
-        if (inFile.is_open())
-            inFile.close();
-        GLUF_ERROR_LONG("Failed to load file into memory:" << e.what());
-        RETHROW;
+        wss << std::fixed << std::setprecision(2) << L"\nGPU:";
+        for (auto& it : g_StatsData.mGpuPassTimes)
+            wss << L" " << std::wstring(it.first.begin(), it.first.end()) << L": " << it.second << L" ms";
     }
+
+    g_StatsData.mFormattedStatsData = wss.str();
+    return g_StatsData.mFormattedStatsData;
 }
 
 //--------------------------------------------------------------------------------------
-void LoadBinaryArrayIntoString(char* rawMemory, std::size_t size, std::string& outString)
+std::wstring g_DeviceStatusCache;
+const std::wstring& GetDeviceStatus()
 {
-    if (rawMemory == nullptr)
-    {
-        GLUF_ERROR("Cannot Load Null Ptr Into String!");
-        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("Cannot Load Null Ptr Into String!"));
-    }
-    
-    //for automatic deletion if exception thrown
-    auto streamBuf = std::make_shared<MemStreamBuf>(rawMemory, size);
-   
-    std::istream indata(streamBuf.get());
-    indata.exceptions(std::ifstream::badbit);
-    char ch = ' ';
+    const double toMB = 1.0 / (1024.0 * 1024.0);
 
-    try
-    {
-        while (indata.get(ch))
-            outString += ch;
-    }
-    catch (std::ios_base::failure e)
-    {
-        outString.clear();
-        GLUF_ERROR_LONG("Failed to load binary array into string: " << e.what());
-        RETHROW;
-    }
-}
+    std::wstringstream wss;
+    wss << std::fixed << std::setprecision(1)
+        << L"Textures: " << RESOURCECACHE.GetTextureMemory() * toMB << L" MB, "
+        << L"Buffers: " << RESOURCECACHE.GetBufferMemory() * toMB << L" MB, "
+        << L"Budget: " << RESOURCECACHE.GetBudget() * toMB << L" MB, "
+        << L"Cached: " << RESOURCECACHE.GetEntryCount();
 
+    g_DeviceStatusCache = wss.str();
+    return g_DeviceStatusCache;
+}
 
 //--------------------------------------------------------------------------------------
-void LoadBinaryArrayIntoString(const std::vector<char>& rawMemory, std::string& outString)
+const StatsData& GetFrameStats()
 {
-    //const cast is OK to use here, because we know 'rawMemory' will not be modified
-    LoadBinaryArrayIntoString(const_cast<char*>(&rawMemory[0]), rawMemory.size(), outString);
+    return FrameStats::g_StatsData;
 }
 
-
 /*
 ======================================================================================================================================================================================================
-Misc.  Classes
-
+Profiling
 
 */
 
-glm::mat4 MatrixStack::mIdentity = glm::mat4();
-
-//--------------------------------------------------------------------------------------
-void MatrixStack::Push(const glm::mat4& matrix)
+namespace Profiling
 {
-    if (mStack.size() != 0)
+    std::atomic<bool> g_Capturing{ false };
+    const std::chrono::steady_clock::time_point g_Epoch = std::chrono::steady_clock::now();
+
+    std::mutex g_BuffersMutex;
+    std::vector<std::shared_ptr<ProfileThreadBuffer>> g_Buffers;
+    unsigned int g_NextThreadId = 0;
+
+    thread_local std::shared_ptr<ProfileThreadBuffer> t_Buffer;
+
+    //--------------------------------------------------------------------------------------
+    ProfileThreadBuffer& GetThreadBuffer()
     {
-        //if there are already things on the stack, instead of multiplying through EVERY TIME TOP IS CALLED, make it more efficient 
-        //so the top is ALWAYS a concatenation
-        glm::mat4 transformed = matrix * Top();
+        if (!t_Buffer)
+        {
+            auto buffer = std::make_shared<ProfileThreadBuffer>();
 
-        mStack.push(transformed);
+            std::lock_guard<std::mutex> lock(g_BuffersMutex);
+            buffer->mThreadId = g_NextThreadId++;
+            buffer->mThreadName = "Thread " + std::to_string(buffer->mThreadId);
+            g_Buffers.push_back(buffer);
+
+            t_Buffer = buffer;
+        }
+        return *t_Buffer;
     }
-    else
+
+    //--------------------------------------------------------------------------------------
+    void WriteJsonString(std::ostream& stream, const char* str)
     {
-        mStack.push(matrix);
+        stream << '"';
+        for (; *str != '\0'; ++str)
+        {
+            char c = *str;
+            if (c == '"' || c == '\\')
+                stream << '\\' << c;
+            else if ((unsigned char)c < 0x20)
+                stream << ' ';
+            else
+                stream << c;
+        }
+        stream << '"';
     }
 }
 
 //--------------------------------------------------------------------------------------
-void MatrixStack::Pop(void)
+uint64_t GetProfileTimestamp()
 {
-    mStack.pop();
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - Profiling::g_Epoch).count();
 }
 
 //--------------------------------------------------------------------------------------
-const glm::mat4& MatrixStack::Top(void) const
+void BeginProfileCapture()
 {
-    //if it is empty, then we want to return the identity
-    if (mStack.size() == 0)
-        return mIdentity;
+    ClearProfileEvents();
+    Profiling::g_Capturing.store(true, std::memory_order_release);
+}
 
-    return mStack.top();
+//--------------------------------------------------------------------------------------
+void EndProfileCapture()
+{
+    Profiling::g_Capturing.store(false, std::memory_order_release);
 }
 
 //--------------------------------------------------------------------------------------
-size_t MatrixStack::Size(void) const
+bool IsProfileCapturing()
 {
-    return mStack.size();
+    return Profiling::g_Capturing.load(std::memory_order_acquire);
 }
 
 //--------------------------------------------------------------------------------------
-bool MatrixStack::Empty(void) const
+void SetProfileThreadName(const std::string& name)
 {
-    return mStack.empty();
+    auto& buffer = Profiling::GetThreadBuffer();
+
+    std::lock_guard<std::mutex> lock(buffer.mBufferMutex);
+    buffer.mThreadName = name;
 }
 
+//--------------------------------------------------------------------------------------
+void ClearProfileEvents()
+{
+    std::lock_guard<std::mutex> lock(Profiling::g_BuffersMutex);
+    for (auto& it : Profiling::g_Buffers)
+    {
+        std::lock_guard<std::mutex> bufferLock(it->mBufferMutex);
+        it->mEvents.clear();
+        it->mDroppedEvents = 0;
+    }
+}
 
-/*
-======================================================================================================================================================================================================
-OpenGL Basic Data Structures and Operators
+//--------------------------------------------------------------------------------------
+void WriteChromeTrace(std::ostream& stream)
+{
+    std::lock_guard<std::mutex> lock(Profiling::g_BuffersMutex);
 
-*/
+    stream << "{\"traceEvents\":[";
+
+    bool first = true;
+    for (auto& it : Profiling::g_Buffers)
+    {
+        std::lock_guard<std::mutex> bufferLock(it->mBufferMutex);
+
+        //thread name metadata
+        stream << (first ? "\n" : ",\n");
+        first = false;
+        stream << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":0,\"tid\":" << it->mThreadId << ",\"args\":{\"name\":";
+        Profiling::WriteJsonString(stream, it->mThreadName.c_str());
+        stream << "}}";
+
+        for (auto& event : it->mEvents)
+        {
+            stream << ",\n{\"ph\":\"X\",\"name\":";
+            Profiling::WriteJsonString(stream, event.mName);
+            stream << ",\"cat\":\"GLUF\",\"pid\":0,\"tid\":" << it->mThreadId
+                << ",\"ts\":" << event.mStart << ",\"dur\":" << event.mDuration << "}";
+        }
+
+        if (it->mDroppedEvents != 0)
+            GLUF_ERROR_LONG("Profiler: " << it->mThreadName << " dropped " << it->mDroppedEvents << " events");
+    }
+
+    stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
 
 //--------------------------------------------------------------------------------------
-bool PtInRect(const Rect& rect, const Point& pt)
+void WriteChromeTrace(const std::string& filePath)
 {
-    //for the first comparison, it is impossible for both statements to be false, 
-    //because if the y is greater than the top, it is automatically greater than the bottom, and vise versa
-    return    (pt.y >= rect.bottom && pt.y <= rect.top) &&
-        (pt.x <= rect.right && pt.x >= rect.left);
+    std::ofstream outFile(filePath, std::ios::out | std::ios::trunc);
+    if (!outFile)
+        GLUF_CRITICAL_EXCEPTION(std::ios_base::failure("Failed to Open Trace File: \"" + filePath + "\""));
+
+    WriteChromeTrace(outFile);
+}
+
+namespace GpuTiming
+{
+    struct GpuPassQuery
+    {
+        const char* mName;
+        GLuint mBeginQuery;
+        GLuint mEndQuery;
+    };
+
+    struct GpuTimerFrame
+    {
+        std::vector<GpuPassQuery> mPasses;
+    };
+
+    GpuTimerFrame g_Frames[GLUF_GPU_TIMER_FRAMES];
+    unsigned int g_CurrentFrame = 0;
+    unsigned int g_FrameSerial = 1;//changes whenever the current frame's passes are discarded, so old handles miss
+    std::vector<GLuint> g_FreeQueries;
+    bool g_Enabled = false;
+    bool g_TimeDraws = false;
+
+    //a handle is the frame's serial above the pass's index plus one, so 0 is never a valid handle
+    GpuPassHandle MakeHandle(std::size_t index)
+    {
+        return (static_cast<GpuPassHandle>(g_FrameSerial) << 32) | (static_cast<GpuPassHandle>(index) + 1);
+    }
+
+    //--------------------------------------------------------------------------------------
+    GLuint AllocQuery()
+    {
+        if (g_FreeQueries.empty())
+        {
+            GLuint query = 0;
+            glGenQueries(1, &query);
+            return query;
+        }
+
+        GLuint query = g_FreeQueries.back();
+        g_FreeQueries.pop_back();
+        return query;
+    }
+
+    //--------------------------------------------------------------------------------------
+    void RecycleFrame(GpuTimerFrame& frame)
+    {
+        for (auto& it : frame.mPasses)
+        {
+            g_FreeQueries.push_back(it.mBeginQuery);
+            if (it.mEndQuery != 0)
+                g_FreeQueries.push_back(it.mEndQuery);
+        }
+        frame.mPasses.clear();
+    }
+
+    //--------------------------------------------------------------------------------------
+    bool FrameResultsAvailable(const GpuTimerFrame& frame)
+    {
+        for (auto& it : frame.mPasses)
+        {
+            if (it.mEndQuery == 0)
+                continue;
+
+            GLuint available = GL_FALSE;
+            glGetQueryObjectuiv(it.mEndQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (available == GL_FALSE)
+                return false;
+        }
+        return true;
+    }
 }
 
 //--------------------------------------------------------------------------------------
-void SetRectEmpty(Rect& rect)
+void SetGpuTimingEnabled(bool enabled, bool timeDraws)
 {
-    rect.top = rect.bottom = rect.left = rect.right = 0;
+    GpuTiming::g_Enabled = enabled;
+    GpuTiming::g_TimeDraws = enabled && timeDraws;
 }
 
 //--------------------------------------------------------------------------------------
-void SetRect(Rect& rect, long left, long top, long right, long bottom)
+bool IsGpuTimingEnabled()
 {
-    rect.top = top;
-    rect.bottom = bottom;
-    rect.left = left;
-    rect.right = right;
+    return GpuTiming::g_Enabled;
 }
 
 //--------------------------------------------------------------------------------------
-void SetRect(Rectf& rect, float left, float top, float right, float bottom)
+bool IsGpuDrawTimingEnabled()
 {
-    rect.top = top;
-    rect.bottom = bottom;
-    rect.left = left;
-    rect.right = right;
+    return GpuTiming::g_TimeDraws;
 }
 
 //--------------------------------------------------------------------------------------
-void OffsetRect(Rect& rect, long x, long y)
+bool IsGpuTimingSupported()
 {
-    rect.top += y;
-    rect.bottom += y;
-    rect.left += x;
-    rect.right += x;
+    return gGLVersion2Digit >= 33 || gExtensions.HasExtension("GL_ARB_timer_query");
 }
 
 //--------------------------------------------------------------------------------------
-void RepositionRect(Rect& rect, long newX, long newY)
+GpuPassHandle BeginGpuPass(const char* name)
 {
-    long deltaX = newX - rect.left;
-    long deltaY = newY - rect.bottom;
+    using namespace GpuTiming;
 
-    rect.left = newX; 
-    rect.right += deltaX;
-    rect.bottom = newY;
-    rect.top += deltaY;
+    if (!g_Enabled || !IsGpuTimingSupported())
+        return 0;
+
+    auto& frame = g_Frames[g_CurrentFrame];
+
+    GpuPassQuery pass{ name, AllocQuery(), 0 };
+    glQueryCounter(pass.mBeginQuery, GL_TIMESTAMP);
+
+    frame.mPasses.push_back(pass);
+    return MakeHandle(frame.mPasses.size() - 1);
 }
 
 //--------------------------------------------------------------------------------------
-long RectHeight(const Rect& rect)
+void EndGpuPass(GpuPassHandle handle)
 {
-    return rect.top - rect.bottom;
+    using namespace GpuTiming;
+
+    //the frame ended while this pass was open, so its begin query has been recycled
+    if (handle == 0 || static_cast<unsigned int>(handle >> 32) != g_FrameSerial)
+        return;
+
+    auto& passes = g_Frames[g_CurrentFrame].mPasses;
+    std::size_t index = static_cast<std::size_t>(handle & 0xffffffff) - 1;
+    if (index >= passes.size() || passes[index].mEndQuery != 0)
+        return;
+
+    passes[index].mEndQuery = AllocQuery();
+    glQueryCounter(passes[index].mEndQuery, GL_TIMESTAMP);
 }
 
 //--------------------------------------------------------------------------------------
-long RectWidth(const Rect& rect)
+void ResolveGpuTimers()
 {
-    return rect.right - rect.left;
-}
+    using namespace GpuTiming;
+
+    //passes still open across the frame boundary are discarded
+    ++g_FrameSerial;
+
+    g_CurrentFrame = (g_CurrentFrame + 1) % GLUF_GPU_TIMER_FRAMES;
+    auto& frame = g_Frames[g_CurrentFrame];
+    if (frame.mPasses.empty())
+        return;
+
+    if (FrameResultsAvailable(frame))
+    {
+        std::map<std::string, float> passTimes;
+        for (auto& it : frame.mPasses)
+        {
+            if (it.mEndQuery == 0)
+                continue;
+
+            GLuint64 begin = 0, end = 0;
+            glGetQueryObjectui64v(it.mBeginQuery, GL_QUERY_RESULT, &begin);
+            glGetQueryObjectui64v(it.mEndQuery, GL_QUERY_RESULT, &end);
+
+            passTimes[it.mName] += (float)((double)(end - begin) / 1000000.0);
+        }
+        FrameStats::g_StatsData.mGpuPassTimes = std::move(passTimes);
+    }
+    else
+    {
+        ++FrameStats::g_StatsData.mGpuDroppedFrames;
+    }
 
+    RecycleFrame(frame);
+}
 
 //--------------------------------------------------------------------------------------
-void InflateRect(Rect& rect, long dx, long dy)
+void ReleaseGpuTimers()
 {
-    long dx2 = dx / 2;
-    long dy2 = dy / 2;
-    rect.left -= dx2;
-    rect.right += dx2;//remember to have opposites
+    using namespace GpuTiming;
 
-    rect.top += dy2;
-    rect.bottom -= dy2;
+    ++g_FrameSerial;
+    for (auto& it : g_Frames)
+        RecycleFrame(it);
+
+    if (!g_FreeQueries.empty())
+        glDeleteQueries(static_cast<GLsizei>(g_FreeQueries.size()), g_FreeQueries.data());
+    g_FreeQueries.clear();
 }
 
 //--------------------------------------------------------------------------------------
-void ResizeRect(Rect& rect, long newWidth, long newHeight)
+GpuPassScope::GpuPassScope(const char* name, bool draw) noexcept :
+    mHandle(0)
 {
-    rect.top = rect.bottom + newHeight;
-    rect.right = rect.left + newWidth;
+    if (draw && !GpuTiming::g_TimeDraws)
+        return;
+
+    try
+    {
+        mHandle = BeginGpuPass(name);
+    }
+    catch (...)
+    {
+        mHandle = 0;
+    }
 }
 
 //--------------------------------------------------------------------------------------
-bool IntersectRect(const Rect& rect0, const Rect& rect1, Rect& rectIntersect)
+GpuPassScope::~GpuPassScope() noexcept
 {
+    if (mHandle != 0)
+        EndGpuPass(mHandle);
+}
 
-    //Left
-    if (rect0.left > rect1.left)
+namespace GLCounting
+{
+    //read by 'ProfileZone' on any thread, e.g. the async loader's workers
+    std::atomic<bool> g_Enabled{ false };
+
+    GLCallCounters g_FrameCounters;
+    std::map<const char*, GLCallCounters> g_FrameCallSites;
+
+    thread_local const char* t_CallSite = nullptr;
+
+    //the originals, while the counting versions are installed
+    PFNGLDRAWARRAYSPROC g_DrawArrays = nullptr;
+    PFNGLDRAWELEMENTSPROC g_DrawElements = nullptr;
+    PFNGLDRAWARRAYSINSTANCEDPROC g_DrawArraysInstanced = nullptr;
+    PFNGLDRAWELEMENTSINSTANCEDPROC g_DrawElementsInstanced = nullptr;
+    PFNGLBUFFERDATAPROC g_BufferData = nullptr;
+    PFNGLBUFFERSUBDATAPROC g_BufferSubData = nullptr;
+    PFNGLTEXIMAGE2DPROC g_TexImage2D = nullptr;
+    PFNGLTEXSUBIMAGE2DPROC g_TexSubImage2D = nullptr;
+    PFNGLCOMPRESSEDTEXIMAGE2DPROC g_CompressedTexImage2D = nullptr;
+    PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC g_CompressedTexSubImage2D = nullptr;
+    PFNGLTEXIMAGE3DPROC g_TexImage3D = nullptr;
+    PFNGLTEXSUBIMAGE3DPROC g_TexSubImage3D = nullptr;
+    PFNGLCOMPRESSEDTEXIMAGE3DPROC g_CompressedTexImage3D = nullptr;
+    PFNGLCOMPRESSEDTEXSUBIMAGE3DPROC g_CompressedTexSubImage3D = nullptr;
+    PFNGLUSEPROGRAMPROC g_UseProgram = nullptr;
+    PFNGLBINDPROGRAMPIPELINEPROC g_BindProgramPipeline = nullptr;
+    PFNGLBINDTEXTUREPROC g_BindTexture = nullptr;
+
+    //--------------------------------------------------------------------------------------
+    //counts go to both the frame total and the current call site
+    template<typename Func>
+    void Count(Func&& func)
     {
-        rectIntersect.left = rect0.left;
+        func(g_FrameCounters);
+        func(g_FrameCallSites[t_CallSite ? t_CallSite : ""]);
     }
-    else
+
+    //--------------------------------------------------------------------------------------
+    unsigned long long PixelSize(GLenum format, GLenum type)
     {
-        rectIntersect.left = rect1.left;
+        //packed types are a whole pixel
+        switch (type)
+        {
+        case GL_UNSIGNED_BYTE_3_3_2:
+        case GL_UNSIGNED_BYTE_2_3_3_REV:
+            return 1;
+        case GL_UNSIGNED_SHORT_5_6_5:
+        case GL_UNSIGNED_SHORT_5_6_5_REV:
+        case GL_UNSIGNED_SHORT_4_4_4_4:
+        case GL_UNSIGNED_SHORT_4_4_4_4_REV:
+        case GL_UNSIGNED_SHORT_5_5_5_1:
+        case GL_UNSIGNED_SHORT_1_5_5_5_REV:
+            return 2;
+        case GL_UNSIGNED_INT_8_8_8_8:
+        case GL_UNSIGNED_INT_8_8_8_8_REV:
+        case GL_UNSIGNED_INT_10_10_10_2:
+        case GL_UNSIGNED_INT_2_10_10_10_REV:
+        case GL_UNSIGNED_INT_24_8:
+        case GL_UNSIGNED_INT_10F_11F_11F_REV:
+        case GL_UNSIGNED_INT_5_9_9_9_REV:
+            return 4;
+        }
+
+        unsigned long long components = 4;
+        switch (format)
+        {
+        case GL_RED:
+        case GL_GREEN:
+        case GL_BLUE:
+        case GL_ALPHA:
+        case GL_LUMINANCE:
+        case GL_RED_INTEGER:
+        case GL_DEPTH_COMPONENT:
+        case GL_STENCIL_INDEX:
+            components = 1;
+            break;
+        case GL_RG:
+        case GL_LUMINANCE_ALPHA:
+        case GL_RG_INTEGER:
+        case GL_DEPTH_STENCIL:
+            components = 2;
+            break;
+        case GL_RGB:
+        case GL_BGR:
+        case GL_RGB_INTEGER:
+        case GL_BGR_INTEGER:
+            components = 3;
+            break;
+        }
+
+        switch (type)
+        {
+        case GL_UNSIGNED_BYTE:
+        case GL_BYTE:
+            return components;
+        case GL_UNSIGNED_SHORT:
+        case GL_SHORT:
+        case GL_HALF_FLOAT:
+            return components * 2;
+        default:
+            return components * 4;
+        }
     }
 
-    //Right
-    if (rect0.right < rect1.right)
+    //--------------------------------------------------------------------------------------
+    void APIENTRY DrawArrays(GLenum mode, GLint first, GLsizei count)
     {
-        rectIntersect.right = rect0.right;
+        Count([](GLCallCounters& c) { ++c.mDrawCalls; });
+        g_DrawArrays(mode, first, count);
     }
-    else
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
     {
-        rectIntersect.right = rect1.right;
+        Count([](GLCallCounters& c) { ++c.mDrawCalls; });
+        g_DrawElements(mode, count, type, indices);
     }
 
+    //--------------------------------------------------------------------------------------
+    void APIENTRY DrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instancecount)
+    {
+        Count([](GLCallCounters& c) { ++c.mDrawCalls; });
+        g_DrawArraysInstanced(mode, first, count, instancecount);
+    }
 
-    //Top
-    if (rect0.top < rect1.top)
+    //--------------------------------------------------------------------------------------
+    void APIENTRY DrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount)
     {
-        rectIntersect.top = rect0.top;
+        Count([](GLCallCounters& c) { ++c.mDrawCalls; });
+        g_DrawElementsInstanced(mode, count, type, indices, instancecount);
     }
-    else
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
     {
-        rectIntersect.top = rect1.top;
+        unsigned long long bytes = data ? (unsigned long long)size : 0;
+        Count([bytes](GLCallCounters& c) { ++c.mBufferUploads; c.mBufferUploadBytes += bytes; });
+        g_BufferData(target, size, data, usage);
     }
 
-    //Bottom
-    if (rect0.bottom > rect1.bottom)
+    //--------------------------------------------------------------------------------------
+    void APIENTRY BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
     {
-        rectIntersect.bottom = rect0.bottom;
+        unsigned long long bytes = (unsigned long long)size;
+        Count([bytes](GLCallCounters& c) { ++c.mBufferUploads; c.mBufferUploadBytes += bytes; });
+        g_BufferSubData(target, offset, size, data);
     }
-    else
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY TexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels)
     {
-        rectIntersect.bottom = rect1.bottom;
+        unsigned long long bytes = pixels ? (unsigned long long)width * height * PixelSize(format, type) : 0;
+        Count([bytes](GLCallCounters& c) { ++c.mTextureUploads; c.mTextureUploadBytes += bytes; });
+        g_TexImage2D(target, level, internalformat, width, height, border, format, type, pixels);
     }
 
-    //this will ONLY happen if the do NOT intersect
-    if (rectIntersect.left > rectIntersect.right || rectIntersect.top < rectIntersect.bottom)
+    //--------------------------------------------------------------------------------------
+    void APIENTRY TexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels)
     {
-        SetRectEmpty(rectIntersect);
-        return false;
+        unsigned long long bytes = (unsigned long long)width * height * PixelSize(format, type);
+        Count([bytes](GLCallCounters& c) { ++c.mTextureUploads; c.mTextureUploadBytes += bytes; });
+        g_TexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels);
     }
 
-    return true;
-}
+    //--------------------------------------------------------------------------------------
+    void APIENTRY CompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void* data)
+    {
+        unsigned long long bytes = data ? (unsigned long long)imageSize : 0;
+        Count([bytes](GLCallCounters& c) { ++c.mTextureUploads; c.mTextureUploadBytes += bytes; });
+        g_CompressedTexImage2D(target, level, internalformat, width, height, border, imageSize, data);
+    }
 
+    //--------------------------------------------------------------------------------------
+    void APIENTRY CompressedTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void* data)
+    {
+        unsigned long long bytes = (unsigned long long)imageSize;
+        Count([bytes](GLCallCounters& c) { ++c.mTextureUploads; c.mTextureUploadBytes += bytes; });
+        g_CompressedTexSubImage2D(target, level, xoffset, yoffset, width, height, format, imageSize, data);
+    }
 
-/*
-======================================================================================================================================================================================================
-Datatype Conversion Functions
+    //--------------------------------------------------------------------------------------
+    void APIENTRY TexImage3D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void* pixels)
+    {
+        unsigned long long bytes = pixels ? (unsigned long long)width * height * depth * PixelSize(format, type) : 0;
+        Count([bytes](GLCallCounters& c) { ++c.mTextureUploads; c.mTextureUploadBytes += bytes; });
+        g_TexImage3D(target, level, internalformat, width, height, depth, border, format, type, pixels);
+    }
 
-*/
+    //--------------------------------------------------------------------------------------
+    void APIENTRY TexSubImage3D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pixels)
+    {
+        unsigned long long bytes = (unsigned long long)width * height * depth * PixelSize(format, type);
+        Count([bytes](GLCallCounters& c) { ++c.mTextureUploads; c.mTextureUploadBytes += bytes; });
+        g_TexSubImage3D(target, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels);
+    }
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY CompressedTexImage3D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLsizei imageSize, const void* data)
+    {
+        unsigned long long bytes = data ? (unsigned long long)imageSize : 0;
+        Count([bytes](GLCallCounters& c) { ++c.mTextureUploads; c.mTextureUploadBytes += bytes; });
+        g_CompressedTexImage3D(target, level, internalformat, width, height, depth, border, imageSize, data);
+    }
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY CompressedTexSubImage3D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const void* data)
+    {
+        unsigned long long bytes = (unsigned long long)imageSize;
+        Count([bytes](GLCallCounters& c) { ++c.mTextureUploads; c.mTextureUploadBytes += bytes; });
+        g_CompressedTexSubImage3D(target, level, xoffset, yoffset, zoffset, width, height, depth, format, imageSize, data);
+    }
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY UseProgram(GLuint program)
+    {
+        Count([](GLCallCounters& c) { ++c.mProgramBinds; });
+        g_UseProgram(program);
+    }
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY BindProgramPipeline(GLuint pipeline)
+    {
+        Count([](GLCallCounters& c) { ++c.mProgramBinds; });
+        g_BindProgramPipeline(pipeline);
+    }
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY BindTexture(GLenum target, GLuint texture)
+    {
+        Count([](GLCallCounters& c) { ++c.mTextureBinds; });
+        g_BindTexture(target, texture);
+    }
+
+    //--------------------------------------------------------------------------------------
+    //swaps 'entry' with 'counting', keeping the original in 'original'
+    template<typename Proc>
+    void Install(Proc& entry, Proc& original, Proc counting)
+    {
+        original = entry;
+        if (original)
+            entry = counting;
+    }
+
+    //--------------------------------------------------------------------------------------
+    template<typename Proc>
+    void Uninstall(Proc& entry, Proc& original)
+    {
+        if (original)
+            entry = original;
+        original = nullptr;
+    }
+}
 
 //--------------------------------------------------------------------------------------
-Color4f ColorToFloat(const Color& color)
+GLCallCounters& GLCallCounters::operator+=(const GLCallCounters& other) noexcept
 {
-    Color4f col;
-    col.x = glm::clamp((float)color.x / 255.0f, 0.0f, 1.0f);
-    col.y = glm::clamp((float)color.y / 255.0f, 0.0f, 1.0f);
-    col.z = glm::clamp((float)color.z / 255.0f, 0.0f, 1.0f);
-    col.w = glm::clamp((float)color.w / 255.0f, 0.0f, 1.0f);
-    return col;
+    mDrawCalls += other.mDrawCalls;
+    mBufferUploads += other.mBufferUploads;
+    mBufferUploadBytes += other.mBufferUploadBytes;
+    mTextureUploads += other.mTextureUploads;
+    mTextureUploadBytes += other.mTextureUploadBytes;
+    mProgramBinds += other.mProgramBinds;
+    mTextureBinds += other.mTextureBinds;
+    return *this;
 }
 
 //--------------------------------------------------------------------------------------
-Color3f ColorToFloat3(const Color& color)
+void SetGLCallCountingEnabled(bool enabled)
 {
-    Color3f col;
-    col.x = glm::clamp((float)color.x / 255.0f, 0.0f, 1.0f);
-    col.y = glm::clamp((float)color.y / 255.0f, 0.0f, 1.0f);
-    col.z = glm::clamp((float)color.z / 255.0f, 0.0f, 1.0f);
-    return col;
-}
+    using namespace GLCounting;
 
-//--------------------------------------------------------------------------------------
-Point MultPoints(const Point& pt0, const Point& pt1)
-{
-    Point retPt;
-    retPt.x = pt1.x * pt0.x;
-    retPt.y = pt1.y * pt1.y;
+    if (enabled == g_Enabled.load(std::memory_order_relaxed))
+        return;
 
-    return retPt;
-}
+    if (enabled)
+    {
+        Install(glad_glDrawArrays, g_DrawArrays, &DrawArrays);
+        Install(glad_glDrawElements, g_DrawElements, &DrawElements);
+        Install(glad_glDrawArraysInstanced, g_DrawArraysInstanced, &DrawArraysInstanced);
+        Install(glad_glDrawElementsInstanced, g_DrawElementsInstanced, &DrawElementsInstanced);
+        Install(glad_glBufferData, g_BufferData, &BufferData);
+        Install(glad_glBufferSubData, g_BufferSubData, &BufferSubData);
+        Install(glad_glTexImage2D, g_TexImage2D, &TexImage2D);
+        Install(glad_glTexSubImage2D, g_TexSubImage2D, &TexSubImage2D);
+        Install(glad_glCompressedTexImage2D, g_CompressedTexImage2D, &CompressedTexImage2D);
+        Install(glad_glCompressedTexSubImage2D, g_CompressedTexSubImage2D, &CompressedTexSubImage2D);
+        Install(glad_glTexImage3D, g_TexImage3D, &TexImage3D);
+        Install(glad_glTexSubImage3D, g_TexSubImage3D, &TexSubImage3D);
+        Install(glad_glCompressedTexImage3D, g_CompressedTexImage3D, &CompressedTexImage3D);
+        Install(glad_glCompressedTexSubImage3D, g_CompressedTexSubImage3D, &CompressedTexSubImage3D);
+        Install(glad_glUseProgram, g_UseProgram, &UseProgram);
+        Install(glad_glBindProgramPipeline, g_BindProgramPipeline, &BindProgramPipeline);
+        Install(glad_glBindTexture, g_BindTexture, &BindTexture);
+    }
+    else
+    {
+        Uninstall(glad_glDrawArrays, g_DrawArrays);
+        Uninstall(glad_glDrawElements, g_DrawElements);
+        Uninstall(glad_glDrawArraysInstanced, g_DrawArraysInstanced);
+        Uninstall(glad_glDrawElementsInstanced, g_DrawElementsInstanced);
+        Uninstall(glad_glBufferData, g_BufferData);
+        Uninstall(glad_glBufferSubData, g_BufferSubData);
+        Uninstall(glad_glTexImage2D, g_TexImage2D);
+        Uninstall(glad_glTexSubImage2D, g_TexSubImage2D);
+        Uninstall(glad_glCompressedTexImage2D, g_CompressedTexImage2D);
+        Uninstall(glad_glCompressedTexSubImage2D, g_CompressedTexSubImage2D);
+        Uninstall(glad_glTexImage3D, g_TexImage3D);
+        Uninstall(glad_glTexSubImage3D, g_TexSubImage3D);
+        Uninstall(glad_glCompressedTexImage3D, g_CompressedTexImage3D);
+        Uninstall(glad_glCompressedTexSubImage3D, g_CompressedTexSubImage3D);
+        Uninstall(glad_glUseProgram, g_UseProgram);
+        Uninstall(glad_glBindProgramPipeline, g_BindProgramPipeline);
+        Uninstall(glad_glBindTexture, g_BindTexture);
+    }
 
+    g_Enabled.store(enabled, std::memory_order_relaxed);
+}
 
 //--------------------------------------------------------------------------------------
-glm::vec2 GetVec2FromRect(const Rect& rect, bool x, bool y)
+bool IsGLCallCountingEnabled()
 {
-    if (x)
-        if (y)
-            return glm::vec2(rect.right, rect.top);
-        else
-            return glm::vec2(rect.right, rect.bottom);
-    else
-        if (y)
-            return glm::vec2(rect.left, rect.top);
-        else
-            return glm::vec2(rect.left, rect.bottom);
+    return GLCounting::g_Enabled.load(std::memory_order_relaxed);
 }
 
 //--------------------------------------------------------------------------------------
-glm::vec2 GetVec2FromRect(const Rectf& rect, bool x, bool y)
+void ResolveGLCallCounters()
 {
-    if (x)
-        if (y)
-            return glm::vec2(rect.right, rect.top);
-        else
-            return glm::vec2(rect.right, rect.bottom);
-    else
-        if (y)
-            return glm::vec2(rect.left, rect.top);
-        else
-            return glm::vec2(rect.left, rect.bottom);
+    using namespace GLCounting;
+
+    if (!g_Enabled.load(std::memory_order_relaxed) && g_FrameCallSites.empty())
+        return;
+
+    auto& stats = FrameStats::g_StatsData;
+
+    stats.mGLCalls = g_FrameCounters;
+    stats.mGLCallSites.clear();
+    for (auto& it : g_FrameCallSites)
+        stats.mGLCallSites[it.first] += it.second;//the same name may be at different addresses
+
+    g_FrameCounters = GLCallCounters();
+    g_FrameCallSites.clear();
 }
 
-#pragma warning (disable : 4244)
-std::string WStringToString(const std::wstring& str) noexcept
+//--------------------------------------------------------------------------------------
+ProfileZone::ProfileZone(const char* name) noexcept :
+    mName(name), mPrevCallSite(nullptr), mStart(0), mActive(Profiling::g_Capturing.load(std::memory_order_relaxed)),
+    mTracksCallSite(GLCounting::g_Enabled.load(std::memory_order_relaxed))
 {
-    std::string temp(str.length(), ' ');
-    std::copy(str.begin(), str.end(), temp.begin());
-    return temp;
+    if (mTracksCallSite)
+    {
+        mPrevCallSite = GLCounting::t_CallSite;
+        GLCounting::t_CallSite = name;
+    }
+
+    if (mActive)
+        mStart = GetProfileTimestamp();
 }
 
-std::wstring StringToWString(const std::string& str) noexcept
+//--------------------------------------------------------------------------------------
+ProfileZone::~ProfileZone() noexcept
 {
-    std::wstring temp(str.length(), L' ');
-    std::copy(str.begin(), str.end(), temp.begin());
-    return temp;
+    if (mTracksCallSite)
+        GLCounting::t_CallSite = mPrevCallSite;
+
+    if (!mActive)
+        return;
+
+    uint64_t end = GetProfileTimestamp();
+
+    try
+    {
+        auto& buffer = Profiling::GetThreadBuffer();
+
+        std::lock_guard<std::mutex> lock(buffer.mBufferMutex);
+        if (buffer.mEvents.size() < GLUF_PROFILE_MAX_EVENTS_PER_THREAD)
+            buffer.mEvents.push_back({ mName, mStart, end - mStart });
+        else
+            ++buffer.mDroppedEvents;
+    }
+    catch (...)
+    {
+        //never let profiling take down the caller
+    }
 }
 
-#pragma warning (default : 4244)
+
 
 /*
 ======================================================================================================================================================================================================
-Shader API (Alpha)
-
-Note:
-    Attaching shaders to programs and programs to ppo's does not check if shader compilation failed, or if program linking failed respectively
+Recording OpenGL Backend
 
 */
 
-
-class CompileShaderException : public Exception
+namespace Recording
 {
-public:
-    virtual const char* what() const noexcept override
+    struct BufferObject
     {
-        return "Failed to Compile Shader!";
-    }
-
-    EXCEPTION_CONSTRUCTOR(CompileShaderException)
-};
+        std::vector<char> mData;
+        GLenum mUsage = GL_STATIC_DRAW;
+        GLenum mMapAccess = 0;
+    };
 
-class CreateGLShaderException : public Exception
-{
-public:
-    virtual const char* what() const noexcept override
+    struct TextureLevel
     {
-        return "OpenGL Failed to Create Shader Instance!";
-    }
-
-    EXCEPTION_CONSTRUCTOR(CreateGLShaderException)
-};
+        GLsizei mWidth = 0;
+        GLsizei mHeight = 0;
+        GLsizei mDepth = 1;
+        GLint mInternalFormat = 0;
+        bool mCompressed = false;
+        unsigned long long mPixelSize = 0;
+        unsigned long long mBytes = 0;
+    };
 
-class LinkProgramException : public Exception
-{
-public:
-    virtual const char* what() const noexcept override
+    struct TextureObject
     {
-        return "Failed to Link Program!";
-    }
+        GLenum mTarget = 0;
+        std::map<std::pair<GLenum, GLint>, TextureLevel> mLevels;//(target or cube face, level)
+        std::map<GLenum, GLint> mParams;
+    };
 
-    EXCEPTION_CONSTRUCTOR(LinkProgramException)
-};
+    struct ShaderObject
+    {
+        GLenum mType = 0;
+        std::string mSource;
+        bool mCompiled = false;
+        bool mDeletePending = false;
+    };
 
-class CreateGLProgramException : public Exception
-{
-public:
-    virtual const char* what() const noexcept override
+    struct ReflectedVariable
     {
-        return "OpenGL Failed to Create Program Instance!";
-    }
+        std::string mName;
+        GLenum mType = 0;
+        GLint mSize = 1;
+        GLint mLocation = -1;
+        GLint mBlockIndex = -1;//uniform block members have no location
+        GLint mOffset = -1;
+        GLint mArrayStride = -1;
+        GLint mMatrixStride = -1;
+    };
 
-    EXCEPTION_CONSTRUCTOR(CreateGLProgramException)
-};
+    struct ReflectedBlock
+    {
+        std::string mName;
+        GLint mBinding = 0;
+        GLint mDataSize = 0;
+    };
 
-class CreateGLPPOException : public Exception
-{
-public:
-    virtual const char* what() const noexcept override
+    struct ProgramObject
     {
-        return "OpenGL Failed to Create PPO Instance!";
-    }
+        std::vector<GLuint> mShaders;
+        bool mLinked = false;
+        std::vector<ReflectedVariable> mUniforms;
+        std::vector<ReflectedVariable> mAttributes;
+        std::vector<ReflectedBlock> mBlocks;
+        std::string mBinary;//the linked sources, handed out by 'glGetProgramBinary'
+    };
 
-    EXCEPTION_CONSTRUCTOR(CreateGLPPOException)
-};
+    //'glGetProgramBinary' format of the recording backend; the binary is just the linked sources
+#define GLUF_RECORDING_BINARY_FORMAT 0x474C5546
+
+    //the containers are never destroyed, so stubs called from other globals' destructors still work
+
+    bool g_Installed = false;
+    bool g_LogCommands = true;
+    std::vector<std::function<void()>>& g_Restore = *new std::vector<std::function<void()>>();
+
+    std::string& g_VersionString = *new std::string();
+    std::vector<std::string>& g_ExtensionList = *new std::vector<std::string>();
+    std::string& g_ExtensionString = *new std::string();
+
+    std::vector<RecordedGLCall>& g_Calls = *new std::vector<RecordedGLCall>();
+    unsigned long long g_CommandCount = 0;
+    GLCallCounters g_Counters;
+
+    GLuint g_NextName = 1;
+    std::map<GLuint, BufferObject>& g_Buffers = *new std::map<GLuint, BufferObject>();
+    std::map<GLuint, TextureObject>& g_Textures = *new std::map<GLuint, TextureObject>();
+    std::map<GLuint, ShaderObject>& g_Shaders = *new std::map<GLuint, ShaderObject>();
+    std::map<GLuint, ProgramObject>& g_Programs = *new std::map<GLuint, ProgramObject>();
+    std::map<GLuint, GLuint64>& g_Queries = *new std::map<GLuint, GLuint64>();
+    std::set<GLuint>& g_VertexArrays = *new std::set<GLuint>();
+    std::set<GLuint>& g_Framebuffers = *new std::set<GLuint>();
+    std::set<GLuint>& g_Renderbuffers = *new std::set<GLuint>();
+    std::set<GLuint>& g_Pipelines = *new std::set<GLuint>();
+
+    std::map<GLenum, GLuint>& g_BufferBindings = *new std::map<GLenum, GLuint>();
+    std::map<std::pair<GLuint, GLenum>, GLuint>& g_TextureBindings = *new std::map<std::pair<GLuint, GLenum>, GLuint>();//(unit, target)
+    GLuint g_ActiveTexture = 0;
+    GLuint g_VertexArrayBinding = 0;
+    GLuint g_CurrentProgram = 0;
+    GLuint g_FramebufferBinding = 0;
+    GLint g_Viewport[4] = { 0, 0, 0, 0 };
+    GLuint64 g_Timestamp = 0;
 
+    //--------------------------------------------------------------------------------------
+    void ResetState()
+    {
+        g_Calls.clear();
+        g_CommandCount = 0;
+        g_Counters = GLCallCounters();
+
+        g_NextName = 1;
+        g_Buffers.clear();
+        g_Textures.clear();
+        g_Shaders.clear();
+        g_Programs.clear();
+        g_Queries.clear();
+        g_VertexArrays.clear();
+        g_Framebuffers.clear();
+        g_Renderbuffers.clear();
+        g_Pipelines.clear();
+
+        g_BufferBindings.clear();
+        g_TextureBindings.clear();
+        g_ActiveTexture = 0;
+        g_VertexArrayBinding = 0;
+        g_CurrentProgram = 0;
+        g_FramebufferBinding = 0;
+        std::fill(g_Viewport, g_Viewport + 4, 0);
+        g_Timestamp = 0;
+    }
 
+    //--------------------------------------------------------------------------------------
+    void Record(const char* function, std::initializer_list<long long> args, unsigned long long bytes = 0)
+    {
+        ++g_CommandCount;
+        g_Timestamp += 1000;//every command "takes" a microsecond, so GPU timings are deterministic too
+        if (!g_LogCommands)
+            return;
 
-/*
+        RecordedGLCall call;
+        call.mFunction = function;
+        call.mArgs = args;
+        call.mBytes = bytes;
+        g_Calls.push_back(std::move(call));
+    }
 
-ShaderTypeToProgramStage
+    //--------------------------------------------------------------------------------------
+    long long Offset(const void* pointer)
+    {
+        return static_cast<long long>(reinterpret_cast<std::intptr_t>(pointer));
+    }
 
-*/
+    //--------------------------------------------------------------------------------------
+    void AddObject(std::set<GLuint>& objects, GLuint name)
+    {
+        objects.insert(name);
+    }
 
+    //--------------------------------------------------------------------------------------
+    template<typename T>
+    void AddObject(std::map<GLuint, T>& objects, GLuint name)
+    {
+        objects[name];
+    }
 
-//--------------------------------------------------------------------------------------
-ProgramStage ShaderTypeToProgramStage(ShaderType type)
-{
-    switch (type)
+    //--------------------------------------------------------------------------------------
+    template<typename Container>
+    void GenNames(const char* function, GLsizei n, GLuint* names, Container& objects)
     {
-    case SH_VERTEX_SHADER:
-        return PPO_VERTEX_SHADER_BIT;
-    case SH_TESSCONTROL_SHADER:
-        return PPO_TESSCONTROL_SHADER_BIT;
-    case SH_TESS_EVALUATION_SHADER:
-        return PPO_TESS_EVALUATION_SHADER_BIT;
-    case SH_GEOMETRY_SHADER:
-        return PPO_GEOMETRY_SHADER_BIT;
-    case SH_FRAGMENT_SHADER:
-        return PPO_FRAGMENT_SHADER_BIT;
-    default:
-        return PPO_INVALID_SHADER_BIT;
+        for (GLsizei i = 0; i < n; ++i)
+        {
+            names[i] = g_NextName++;
+            AddObject(objects, names[i]);
+        }
+        Record(function, { n, n > 0 ? names[0] : 0 });
     }
-};
 
-/*
-Shader
+    //--------------------------------------------------------------------------------------
+    template<typename Container>
+    void DeleteNames(const char* function, GLsizei n, const GLuint* names, Container& objects)
+    {
+        for (GLsizei i = 0; i < n; ++i)
+            objects.erase(names[i]);
+        Record(function, { n, n > 0 ? names[0] : 0 });
+    }
 
-    Data Members:
-        'mShaderId': OpenGL-Assigned Shader id
-        'mTmpShaderText': shader text cache kept if shaders are appending eachother
-        'mShaderType': what shader type is it (i.e. GL_FRAGMENT_SHADER)
+    //--------------------------------------------------------------------------------------
+    BufferObject* BoundBuffer(GLenum target)
+    {
+        auto binding = g_BufferBindings.find(target);
+        if (binding == g_BufferBindings.end() || binding->second == 0)
+            return nullptr;
 
-*/
-class Shader
-{
-    friend ShaderManager;
-    friend Program;
+        auto it = g_Buffers.find(binding->second);
+        return it == g_Buffers.end() ? nullptr : &it->second;
+    }
 
-    GLuint mShaderId;
+    //--------------------------------------------------------------------------------------
+    GLenum TextureTargetOf(GLenum target)
+    {
+        if (target >= GL_TEXTURE_CUBE_MAP_POSITIVE_X && target <= GL_TEXTURE_CUBE_MAP_NEGATIVE_Z)
+            return GL_TEXTURE_CUBE_MAP;
+        return target;
+    }
 
-    std::string mTmpShaderText;
+    //--------------------------------------------------------------------------------------
+    GLuint BoundTextureName(GLenum target)
+    {
+        auto it = g_TextureBindings.find({ g_ActiveTexture, TextureTargetOf(target) });
+        return it == g_TextureBindings.end() ? 0 : it->second;
+    }
 
-    ShaderType mShaderType;
+    //--------------------------------------------------------------------------------------
+    TextureObject* BoundTexture(GLenum target)
+    {
+        auto it = g_Textures.find(BoundTextureName(target));
+        return it == g_Textures.end() ? nullptr : &it->second;
+    }
 
-    //disallow copy and assign, because these must always be refered to by pointers
-    Shader(const Shader& other) = delete;
-    Shader& operator=(const Shader& other) = delete;
-public:
+    //--------------------------------------------------------------------------------------
+    //writes 'str' to a client buffer the way glGet*InfoLog and glGetActive* do
+    void WriteString(const std::string& str, GLsizei bufSize, GLsizei* length, GLchar* buffer)
+    {
+        GLsizei written = 0;
+        if (buffer && bufSize > 0)
+        {
+            written = std::min<GLsizei>(bufSize - 1, static_cast<GLsizei>(str.size()));
+            std::memcpy(buffer, str.data(), written);
+            buffer[written] = '\0';
+        }
 
-    /*
-    Constructor
-        Throws:
-            no-throw guarantee
-    
-    */
-    Shader() noexcept;
-    ~Shader() noexcept;
+        if (length)
+            *length = written;
+    }
 
-    //common shader is if the shader will not be deleted after building into a program
-    //this is used for things like lighting functions
 
     /*
-    Init
+    Shader Reflection
 
-        Parameters:
-            'shaderType': which shader type it is
+        Finds the uniform and vertex input declarations at global scope of GLSL source; enough to give the library
+            the same names, types, sizes, and locations a driver would
 
-        Throws:
-            no-throw guarantee
     */
-    void Init(ShaderType shaderType) noexcept;
 
+    //--------------------------------------------------------------------------------------
+    std::vector<std::string> Tokenize(const std::string& source)
+    {
+        std::vector<std::string> tokens;
 
-    /*
-    Load
-        
-        Parameters:
-            'shaderText': text to be added
-            'append': append 'shaderText' to 'mTmpShaderText' or clear 'mTmpShaderText'
+        bool lineStart = true;
+        std::size_t i = 0;
+        while (i < source.size())
+        {
+            char c = source[i];
+            char next = i + 1 < source.size() ? source[i + 1] : '\0';
 
-        Throws:
-            may throw 'std::bad_alloc' if string allocation fails
-    */
-    void Load(const std::string& shaderText, bool append = false);
+            if (c == '\n')
+            {
+                lineStart = true;
+                ++i;
+            }
+            else if (std::isspace(static_cast<unsigned char>(c)))
+            {
+                ++i;
+            }
+            else if (c == '#' && lineStart)
+            {
+                //preprocessor lines are not declarations
+                while (i < source.size() && source[i] != '\n')
+                    ++i;
+            }
+            else if (c == '/' && next == '/')
+            {
+                while (i < source.size() && source[i] != '\n')
+                    ++i;
+            }
+            else if (c == '/' && next == '*')
+            {
+                std::size_t end = source.find("*/", i + 2);
+                i = (end == std::string::npos) ? source.size() : end + 2;
+            }
+            else if (std::isalnum(static_cast<unsigned char>(c)) || c == '_')
+            {
+                std::size_t start = i;
+                while (i < source.size() && (std::isalnum(static_cast<unsigned char>(source[i])) || source[i] == '_'))
+                    ++i;
+                tokens.push_back(source.substr(start, i - start));
+                lineStart = false;
+            }
+            else
+            {
+                tokens.push_back(std::string(1, c));
+                lineStart = false;
+                ++i;
+            }
+        }
 
-    /*
-    LoadFromMemory
+        return tokens;
+    }
 
-        Parameters:
-            'shaderData': raw memory to read shader text from
-            'append': append text loaded from 'shaderData' to 'mTmpShaderText' or clear 'mTmpShaderText'
+    //--------------------------------------------------------------------------------------
+    GLenum TypeFromName(const std::string& name)
+    {
+        static const std::map<std::string, GLenum> types = {
+            { "float", GL_FLOAT }, { "vec2", GL_FLOAT_VEC2 }, { "vec3", GL_FLOAT_VEC3 }, { "vec4", GL_FLOAT_VEC4 },
+            { "double", GL_DOUBLE },
+            { "int", GL_INT }, { "ivec2", GL_INT_VEC2 }, { "ivec3", GL_INT_VEC3 }, { "ivec4", GL_INT_VEC4 },
+            { "uint", GL_UNSIGNED_INT }, { "uvec2", GL_UNSIGNED_INT_VEC2 }, { "uvec3", GL_UNSIGNED_INT_VEC3 }, { "uvec4", GL_UNSIGNED_INT_VEC4 },
+            { "bool", GL_BOOL }, { "bvec2", GL_BOOL_VEC2 }, { "bvec3", GL_BOOL_VEC3 }, { "bvec4", GL_BOOL_VEC4 },
+            { "mat2", GL_FLOAT_MAT2 }, { "mat3", GL_FLOAT_MAT3 }, { "mat4", GL_FLOAT_MAT4 },
+            { "mat2x2", GL_FLOAT_MAT2 }, { "mat3x3", GL_FLOAT_MAT3 }, { "mat4x4", GL_FLOAT_MAT4 },
+            { "mat2x3", GL_FLOAT_MAT2x3 }, { "mat2x4", GL_FLOAT_MAT2x4 }, { "mat3x2", GL_FLOAT_MAT3x2 },
+            { "mat3x4", GL_FLOAT_MAT3x4 }, { "mat4x2", GL_FLOAT_MAT4x2 }, { "mat4x3", GL_FLOAT_MAT4x3 },
+            { "sampler1D", GL_SAMPLER_1D }, { "sampler2D", GL_SAMPLER_2D }, { "sampler3D", GL_SAMPLER_3D },
+            { "samplerCube", GL_SAMPLER_CUBE }, { "sampler2DShadow", GL_SAMPLER_2D_SHADOW },
+            { "sampler2DArray", GL_SAMPLER_2D_ARRAY }, { "sampler2DArrayShadow", GL_SAMPLER_2D_ARRAY_SHADOW },
+            { "samplerCubeShadow", GL_SAMPLER_CUBE_SHADOW }, { "sampler2DMS", GL_SAMPLER_2D_MULTISAMPLE },
+            { "samplerBuffer", GL_SAMPLER_BUFFER },
+            { "isampler2D", GL_INT_SAMPLER_2D }, { "usampler2D", GL_UNSIGNED_INT_SAMPLER_2D }
+        };
 
-        Throws:
-            may throw 'std::bad_alloc' if string allocation fails            
-    */
-    //void LoadFromMemory(const std::vector<char>& shaderData, bool append = false);
+        auto it = types.find(name);
+        return it == types.end() ? 0 : it->second;
+    }
 
-    /*
-    LoadFromFile
+    //--------------------------------------------------------------------------------------
+    //the vertex input locations a variable of this type takes
+    GLint LocationSlots(GLenum type)
+    {
+        switch (type)
+        {
+        case GL_FLOAT_MAT2:
+        case GL_FLOAT_MAT2x3:
+        case GL_FLOAT_MAT2x4:
+            return 2;
+        case GL_FLOAT_MAT3:
+        case GL_FLOAT_MAT3x2:
+        case GL_FLOAT_MAT3x4:
+            return 3;
+        case GL_FLOAT_MAT4:
+        case GL_FLOAT_MAT4x2:
+        case GL_FLOAT_MAT4x3:
+            return 4;
+        default:
+            return 1;
+        }
+    }
 
-        Parameters:
-            'filePath': path of the file to open
-            'append': append 'filePath' to 'MTmpShaderText' or clear 'mTmpShaderText'
+    //--------------------------------------------------------------------------------------
+    //the std140 base alignment and size of one variable of this type
+    void Std140Layout(GLenum type, GLint& alignment, GLint& size)
+    {
+        GLint columns = LocationSlots(type);
+        if (columns > 1)
+        {
+            //every column is padded out to a vec4
+            alignment = 16;
+            size = columns * 16;
+            return;
+        }
 
-        Throws:
-            'std::ios_base::failure': if file fails to open or read
-    
-    */
-    //bool LoadFromFile(const std::wstring& filePath, bool append = false);
+        GLint components = 1;
+        switch (type)
+        {
+        case GL_FLOAT_VEC2:
+        case GL_INT_VEC2:
+        case GL_UNSIGNED_INT_VEC2:
+        case GL_BOOL_VEC2:
+            components = 2;
+            break;
+        case GL_FLOAT_VEC3:
+        case GL_INT_VEC3:
+        case GL_UNSIGNED_INT_VEC3:
+        case GL_BOOL_VEC3:
+            components = 3;
+            break;
+        case GL_FLOAT_VEC4:
+        case GL_INT_VEC4:
+        case GL_UNSIGNED_INT_VEC4:
+        case GL_BOOL_VEC4:
+            components = 4;
+            break;
+        }
 
-    /*
-    FlushText
+        GLint componentSize = (type == GL_DOUBLE) ? 8 : 4;
+        alignment = componentSize * (components == 1 ? 1 : (components == 2 ? 2 : 4));
+        size = componentSize * components;
+    }
 
-        Throws:
-            no-throw guarantee
-    */
-    void FlushText(void) noexcept { mTmpShaderText.clear(); }
+    //--------------------------------------------------------------------------------------
+    bool IsNumber(const std::string& token)
+    {
+        return !token.empty() && std::isdigit(static_cast<unsigned char>(token[0]));
+    }
 
+    //--------------------------------------------------------------------------------------
+    void ParseDeclaration(const std::vector<std::string>& statement, bool vertexStage, std::vector<ReflectedVariable>& uniforms, std::vector<ReflectedVariable>& attributes)
+    {
+        static const std::set<std::string> qualifiers = {
+            "const", "flat", "smooth", "noperspective", "centroid", "sample", "invariant", "precise",
+            "highp", "mediump", "lowp", "readonly", "writeonly", "coherent", "volatile", "restrict"
+        };
 
-    /*
-    Compile
-        
-        -Take all of the loaded text and compile into a shader
+        GLint location = -1;
+        bool isUniform = false;
+        bool isInput = false;
 
-        Parameters:
-            'retStruct': the returned information about shader compilation.
+        std::size_t i = 0;
+        for (; i < statement.size(); ++i)
+        {
+            const std::string& token = statement[i];
+            if (token == "layout")
+            {
+                if (i + 1 < statement.size() && statement[i + 1] == "(")
+                {
+                    for (i += 2; i < statement.size() && statement[i] != ")"; ++i)
+                    {
+                        if (statement[i] == "location" && i + 2 < statement.size() && statement[i + 1] == "=" && IsNumber(statement[i + 2]))
+                            location = std::stoi(statement[i + 2]);
+                    }
+                }
+            }
+            else if (token == "uniform")
+            {
+                isUniform = true;
+            }
+            else if (token == "in" || token == "attribute")
+            {
+                isInput = true;
+            }
+            else if (qualifiers.find(token) == qualifiers.end())
+            {
+                break;
+            }
+        }
 
-        Throws:
-            'CompileShaderException': if shader compilation fails
-            'CreateGLShaderException': if shader creaetion failes (because shader creation is stalled until compilation)
-    
-    */
-    void Compile(ShaderInfoStruct& retStruct);
+        if (!isUniform && !(isInput && vertexStage))
+            return;
 
+        if (i >= statement.size())
+            return;
 
-    /*
-    Destroy
+        GLenum type = TypeFromName(statement[i++]);
+        if (type == 0)
+            return;//structs and anything else we do not know
 
-        -equivilent to destructor, except object itself is not destroyed (i.e. it can be reused)
+        auto& variables = isUniform ? uniforms : attributes;
+        while (i < statement.size())
+        {
+            ReflectedVariable variable;
+            variable.mName = statement[i++];
+            variable.mType = type;
+            variable.mSize = 1;
+            variable.mLocation = location;
+            location = -1;
+
+            if (i < statement.size() && statement[i] == "[")
+            {
+                if (i + 1 < statement.size() && IsNumber(statement[i + 1]))
+                    variable.mSize = std::max(1, std::stoi(statement[i + 1]));
+                while (i < statement.size() && statement[i] != "]")
+                    ++i;
+                ++i;
+            }
 
-        Throws:
-            no-throw guarantee
-        
-    */
-    void Destroy() noexcept;
+            //skip initializers
+            if (i < statement.size() && statement[i] == "=")
+            {
+                int parens = 0;
+                for (++i; i < statement.size(); ++i)
+                {
+                    if (statement[i] == "(")
+                        ++parens;
+                    else if (statement[i] == ")")
+                        --parens;
+                    else if (statement[i] == "," && parens == 0)
+                        break;
+                }
+            }
 
-};
+            bool duplicate = false;
+            for (const auto& it : variables)
+                duplicate = duplicate || it.mName == variable.mName;
+            if (!duplicate)
+                variables.push_back(variable);
 
-using ShaderP = std::pair<ShaderType, ShaderPtr>;
+            if (i < statement.size() && statement[i] == ",")
+                ++i;
+            else
+                break;
+        }
+    }
 
+    //--------------------------------------------------------------------------------------
+    //lays out a uniform block's members with std140 rules; every block is treated as std140
+    void ParseBlock(const std::vector<std::string>& header, const std::vector<std::vector<std::string>>& members, bool hasInstance,
+        std::vector<ReflectedVariable>& uniforms, std::vector<ReflectedBlock>& blocks)
+    {
+        ReflectedBlock block;
+        GLint binding = -1;
+        for (std::size_t i = 0; i < header.size(); ++i)
+        {
+            if (header[i] == "binding" && i + 2 < header.size() && header[i + 1] == "=" && IsNumber(header[i + 2]))
+                binding = std::stoi(header[i + 2]);
+            else if (header[i] == "uniform" && i + 1 < header.size())
+                block.mName = header[i + 1];
+        }
 
-/*
-Program
+        if (block.mName.empty())
+            return;
 
-    Data Members:
-        'mProgramId': OpenGL assigned id
-        'mShaderBuff': buffer of shaders before linking
-        'mAttributeLocations': location of vertex attributes in program
-        'mUniformLocations': location of the uniforms in programs
-        'mStages': the stages which this program uses; initialized if separable set to true
+        //the same block in several stages is one block, and any stage may give its binding
+        for (auto& it : blocks)
+        {
+            if (it.mName == block.mName)
+            {
+                if (binding >= 0)
+                    it.mBinding = binding;
+                return;
+            }
+        }
+        block.mBinding = std::max(binding, 0);
 
-*/
-class Program
-{
-    friend ShaderManager;
+        GLint blockIndex = static_cast<GLint>(blocks.size());
+        std::string prefix = hasInstance ? block.mName + "." : "";
 
-    //GLuint mUniformBuffId;
-    GLuint mProgramId;
-    std::map<ShaderType, ShaderPtr > mShaderBuff;
-    VariableLocMap mAttributeLocations;
-    VariableLocMap mUniformLocations;
-    GLbitfield mStages;
+        GLint offset = 0;
+        for (const auto& member : members)
+        {
+            //the member parser wants a uniform declaration; layout qualifiers like row_major are ignored
+            std::vector<std::string> statement = member;
+            statement.insert(statement.begin(), "uniform");
 
-public:
+            std::vector<ReflectedVariable> parsed, unused;
+            ParseDeclaration(statement, false, parsed, unused);
 
-    /*
-    Constructor
-        Throws:
-            no-throw guarantee
+            for (auto& it : parsed)
+            {
+                GLint alignment = 0, size = 0;
+                Std140Layout(it.mType, alignment, size);
+                it.mArrayStride = 0;
+                it.mMatrixStride = (LocationSlots(it.mType) > 1) ? 16 : 0;
+                if (it.mSize > 1)
+                {
+                    //array elements are padded out to a vec4
+                    alignment = 16;
+                    it.mArrayStride = ((size + 15) / 16) * 16;
+                    size = it.mArrayStride * it.mSize;
+                }
 
-    */
-    Program() noexcept;
-    ~Program() noexcept;
+                offset = ((offset + alignment - 1) / alignment) * alignment;
 
-    /*
-    Init
-        Throws:
-            'CreateGLProgramException': OpenGL failed to create program using glCreateProgram
-    */
-    void Init();
+                it.mName = prefix + it.mName;
+                it.mLocation = -1;
+                it.mBlockIndex = blockIndex;
+                it.mOffset = offset;
+                uniforms.push_back(it);
 
-    /*
-    AttachShader
-        
-        Note:
-            if a shader already exists for that stage, it will be overwritten
+                offset += size;
+            }
+        }
 
-        Parameters:
-            'shader': pointer to shader which is being attached
+        block.mDataSize = ((offset + 15) / 16) * 16;
+        blocks.push_back(block);
+    }
 
-        Throws:
-            'std::invalid_argument': if 'shader == nullptr' or 'shader' is invalid
-    */
-    void AttachShader(ShaderPtr shader);
+    //--------------------------------------------------------------------------------------
+    void ReflectSource(const std::string& source, bool vertexStage, std::vector<ReflectedVariable>& uniforms, std::vector<ReflectedVariable>& attributes,
+        std::vector<ReflectedBlock>& blocks)
+    {
+        std::vector<std::string> statement;
+        int depth = 0;
 
-    /*
-    FlushShaders
+        //uniform blocks are collected member by member and parsed at the ';' after the closing brace
+        bool inBlock = false, afterBlock = false;
+        std::vector<std::string> blockHeader, member;
+        std::vector<std::vector<std::string>> members;
 
-        -Flush shader cache, but does not explicitly delete shaders
+        for (const auto& token : Tokenize(source))
+        {
+            //function bodies and other interface blocks are skipped entirely
+            if (token == "{")
+            {
+                if (depth == 0)
+                {
+                    inBlock = std::find(statement.begin(), statement.end(), "uniform") != statement.end();
+                    if (inBlock)
+                    {
+                        blockHeader = statement;
+                        members.clear();
+                        member.clear();
+                    }
+                    statement.clear();
+                }
+                ++depth;
+            }
+            else if (token == "}")
+            {
+                if (depth > 0)
+                    --depth;
+                if (depth == 0 && inBlock)
+                {
+                    inBlock = false;
+                    afterBlock = true;
+                }
+            }
+            else if (depth > 0)
+            {
+                if (!inBlock || depth != 1)
+                    continue;
 
-        Throws:
-            no-throw guarantee
-    */
-    void FlushShaders(void) noexcept;
+                if (token == ";")
+                {
+                    members.push_back(member);
+                    member.clear();
+                }
+                else
+                {
+                    member.push_back(token);
+                }
+            }
+            else if (token == ";")
+            {
+                if (afterBlock)
+                    ParseBlock(blockHeader, members, !statement.empty(), uniforms, blocks);
+                else
+                    ParseDeclaration(statement, vertexStage, uniforms, attributes);
+                afterBlock = false;
+                statement.clear();
+            }
+            else
+            {
+                statement.push_back(token);
+            }
+        }
+    }
 
+    //--------------------------------------------------------------------------------------
+    //explicit locations are kept; the rest are packed into the free ones in declaration order
+    void AssignLocations(std::vector<ReflectedVariable>& variables, bool vertexInputs)
+    {
+        std::set<GLint> used;
+        for (const auto& it : variables)
+        {
+            if (it.mLocation < 0)
+                continue;
 
-    /*
-    Build
-        
-        Parameters:
-            'retStruct': the returned information about program linking.  i.e. 'mSuccess'
-            'separate': whether this program will be used 'separately' (see OpenGL docs for definition)
+            GLint slots = it.mSize * (vertexInputs ? LocationSlots(it.mType) : 1);
+            for (GLint i = 0; i < slots; ++i)
+                used.insert(it.mLocation + i);
+        }
 
-        Throws:
-            'LinkProgramException': if program linking fails
-    */
-    void Build(ShaderInfoStruct& retStruct, bool separate);
+        GLint next = 0;
+        for (auto& it : variables)
+        {
+            if (it.mLocation >= 0 || it.mBlockIndex >= 0)
+                continue;
 
-    /*
-    GetId
+            GLint slots = it.mSize * (vertexInputs ? LocationSlots(it.mType) : 1);
+            for (;; ++next)
+            {
+                bool free = true;
+                for (GLint i = 0; i < slots && free; ++i)
+                    free = used.find(next + i) == used.end();
+                if (free)
+                    break;
+            }
 
-        Returns:
-            OpenGL Id of the program
-    */
-    GLuint GetId(){ return mProgramId; }
+            it.mLocation = next;
+            for (GLint i = 0; i < slots; ++i)
+                used.insert(next + i);
+            next += slots;
+        }
+    }
 
+    //--------------------------------------------------------------------------------------
+    //accepts "name", "name[0]" and "name[i]" like glGetUniformLocation
+    GLint FindLocation(const std::vector<ReflectedVariable>& variables, const std::string& name)
+    {
+        std::string base = name;
+        GLint index = 0;
 
-    /*
-    Destroy
+        std::size_t bracket = name.find('[');
+        if (bracket != std::string::npos)
+        {
+            base = name.substr(0, bracket);
+            if (bracket + 1 < name.size() && std::isdigit(static_cast<unsigned char>(name[bracket + 1])))
+                index = std::stoi(name.substr(bracket + 1));
+        }
 
-        -equivilent to destructor, except object itself is not destroyed (i.e. it can be reused)
+        for (const auto& it : variables)
+        {
+            if (it.mName == base && index < it.mSize)
+                return it.mBlockIndex >= 0 ? -1 : it.mLocation + index;
+        }
 
-        Throws:
-            no-throw guarantee
+        return -1;
+    }
 
-    */
-    void Destroy() noexcept;
+    //--------------------------------------------------------------------------------------
+    std::string ActiveName(const ReflectedVariable& variable)
+    {
+        return variable.mSize > 1 ? variable.mName + "[0]" : variable.mName;
+    }
 
-    /*
-    GetBitfield()
+    //--------------------------------------------------------------------------------------
+    std::size_t MaxNameLength(const std::vector<ReflectedVariable>& variables)
+    {
+        std::size_t ret = 0;
+        for (const auto& it : variables)
+            ret = std::max(ret, ActiveName(it).size() + 1);
+        return ret;
+    }
 
-        Returns:
-            GLbitfield of the program's stages; this is used when initializing and adding to PPO's
-    */
-    GLbitfield GetBitfield() const noexcept;
-};
+    //--------------------------------------------------------------------------------------
+    void LinkSources(ProgramObject& prog, const std::vector<std::pair<GLenum, std::string>>& sources)
+    {
+        prog.mUniforms.clear();
+        prog.mAttributes.clear();
+        prog.mBlocks.clear();
+        prog.mBinary.clear();
+        prog.mLinked = !sources.empty();
 
-/*
-SeparateProgram
+        for (const auto& it : sources)
+        {
+            ReflectSource(it.second, it.first == GL_VERTEX_SHADER, prog.mUniforms, prog.mAttributes, prog.mBlocks);
 
+            uint32_t header[2] = { static_cast<uint32_t>(it.first), static_cast<uint32_t>(it.second.size()) };
+            prog.mBinary.append(reinterpret_cast<const char*>(header), sizeof(header));
+            prog.mBinary += it.second;
+        }
 
-    Data Members:
-        'mPPOId': id of programmible pipeline object
-        'mPrograms': list of programs used; kept here so they do not delete themselves while this pipeline object exists
-        'mActiveProgram': the currently active program which is having uniforms buffered
+        AssignLocations(prog.mUniforms, false);
+        AssignLocations(prog.mAttributes, true);
+    }
 
-*/
-class SeparateProgram
-{
-    friend ShaderManager;
-    GLuint mPPOId;
 
-    ProgramPtrList mPrograms;//so the programs don't go deleting themselves until the PPO is destroyed
+    /*
+    Stubs
 
-    ProgramPtr mActiveProgram;//this is used as the 'active program' when assigning uniforms
+    */
 
-public:
-    SeparateProgram();
-    ~SeparateProgram();
+    //--------------------------------------------------------------------------------------
+    const GLubyte* APIENTRY GetString(GLenum name)
+    {
+        Record("glGetString", { name });
 
-    /*
-    Init
+        static const char* vendor = "ObjGLUF";
+        static const char* renderer = "ObjGLUF Recording Backend";
 
-        Throws:
-            'CreateGLPPOException': if opengl creation of PPO failed
-    */
-    void Init();
-    
-    /*
-    AttachProgram
-
-        Parameters:
-            'program': program to attach
-
-        Throws:
-            no-throw guarantee
-
-    */
-    void AttachProgram(const ProgramPtr& program);
+        switch (name)
+        {
+        case GL_VENDOR:
+            return reinterpret_cast<const GLubyte*>(vendor);
+        case GL_RENDERER:
+            return reinterpret_cast<const GLubyte*>(renderer);
+        case GL_VERSION:
+        case GL_SHADING_LANGUAGE_VERSION:
+            return reinterpret_cast<const GLubyte*>(g_VersionString.c_str());
+        case GL_EXTENSIONS:
+            return reinterpret_cast<const GLubyte*>(g_ExtensionString.c_str());
+        default:
+            return nullptr;
+        }
+    }
 
-    /*
-    ClearStages
+    //--------------------------------------------------------------------------------------
+    const GLubyte* APIENTRY GetStringi(GLenum name, GLuint index)
+    {
+        Record("glGetStringi", { name, index });
 
-        -Removes the give stages
+        if (name != GL_EXTENSIONS || index >= g_ExtensionList.size())
+            return nullptr;
+        return reinterpret_cast<const GLubyte*>(g_ExtensionList[index].c_str());
+    }
 
-        Parameters:
-            'stages': bitfield of stages, default value is all of them
+    //--------------------------------------------------------------------------------------
+    void APIENTRY GetIntegerv(GLenum pname, GLint* data)
+    {
+        Record("glGetIntegerv", { pname });
 
-        Throws:
-            no-throw guarantee
-    
-    */
-    void ClearStages(GLbitfield stages = GL_ALL_SHADER_BITS);
+        switch (pname)
+        {
+        case GL_MAJOR_VERSION:
+            *data = gGLVersionMajor;
+            break;
+        case GL_MINOR_VERSION:
+            *data = gGLVersionMinor;
+            break;
+        case GL_NUM_EXTENSIONS:
+            *data = static_cast<GLint>(g_ExtensionList.size());
+            break;
+        case GL_MAX_TEXTURE_SIZE:
+            *data = 16384;
+            break;
+        case GL_MAX_TEXTURE_IMAGE_UNITS:
+        case GL_MAX_VERTEX_ATTRIBS:
+            *data = 16;
+            break;
+        case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
+            *data = 80;
+            break;
+        case GL_MAX_UNIFORM_BUFFER_BINDINGS:
+            *data = 36;
+            break;
+        case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT:
+            *data = 256;
+            break;
+        case GL_NUM_PROGRAM_BINARY_FORMATS:
+            *data = 1;
+            break;
+        case GL_PROGRAM_BINARY_FORMATS:
+            *data = GLUF_RECORDING_BINARY_FORMAT;
+            break;
+        case GL_ACTIVE_TEXTURE:
+            *data = GL_TEXTURE0 + g_ActiveTexture;
+            break;
+        case GL_TEXTURE_BINDING_2D:
+            *data = BoundTextureName(GL_TEXTURE_2D);
+            break;
+        case GL_TEXTURE_BINDING_CUBE_MAP:
+            *data = BoundTextureName(GL_TEXTURE_CUBE_MAP);
+            break;
+        case GL_TEXTURE_BINDING_2D_ARRAY:
+            *data = BoundTextureName(GL_TEXTURE_2D_ARRAY);
+            break;
+        case GL_ARRAY_BUFFER_BINDING:
+            *data = g_BufferBindings[GL_ARRAY_BUFFER];
+            break;
+        case GL_ELEMENT_ARRAY_BUFFER_BINDING:
+            *data = g_BufferBindings[GL_ELEMENT_ARRAY_BUFFER];
+            break;
+        case GL_VERTEX_ARRAY_BINDING:
+            *data = g_VertexArrayBinding;
+            break;
+        case GL_CURRENT_PROGRAM:
+            *data = g_CurrentProgram;
+            break;
+        case GL_FRAMEBUFFER_BINDING:
+            *data = g_FramebufferBinding;
+            break;
+        case GL_VIEWPORT:
+            std::copy(g_Viewport, g_Viewport + 4, data);
+            break;
+        default:
+            *data = 0;
+            break;
+        }
+    }
 
-    /*
-    SetActiveShaderProgram
+    //--------------------------------------------------------------------------------------
+    void APIENTRY GetFloatv(GLenum pname, GLfloat* data)
+    {
+        Record("glGetFloatv", { pname });
 
-        Parameters:
-            'stage': the stage of which program will be active
+        const GLenum maxAnisotropy = 0x84FF;//GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT
+        *data = (pname == maxAnisotropy) ? 16.0f : 0.0f;
+    }
 
-        Throws:
-            no-throw guarantee
-    
-    */
-    void SetActiveShaderProgram(ProgramStage stage);
+    //--------------------------------------------------------------------------------------
+    GLenum APIENTRY GetError()
+    {
+        Record("glGetError", {});
+        return GL_NO_ERROR;
+    }
 
+    //--------------------------------------------------------------------------------------
+    void APIENTRY Enable(GLenum cap)
+    {
+        Record("glEnable", { cap });
+    }
 
-    /*
-    GetId
+    //--------------------------------------------------------------------------------------
+    void APIENTRY Disable(GLenum cap)
+    {
+        Record("glDisable", { cap });
+    }
 
-        Returns:
-            id of ppo object
-    
-    */
-    GLuint GetId()const noexcept{ return mPPOId; }
+    //--------------------------------------------------------------------------------------
+    void APIENTRY BlendFunc(GLenum sfactor, GLenum dfactor)
+    {
+        Record("glBlendFunc", { sfactor, dfactor });
+    }
 
-    /*
-    GetActiveProgram
+    //--------------------------------------------------------------------------------------
+    void APIENTRY BlendFuncSeparate(GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha)
+    {
+        Record("glBlendFuncSeparate", { sfactorRGB, dfactorRGB, sfactorAlpha, dfactorAlpha });
+    }
 
-        Returns:
-            the active program
+    //--------------------------------------------------------------------------------------
+    void APIENTRY BlendEquation(GLenum mode)
+    {
+        Record("glBlendEquation", { mode });
+    }
 
-        Throws:
-            'std::exception' if there is no active program
+    //--------------------------------------------------------------------------------------
+    void APIENTRY DepthFunc(GLenum func)
+    {
+        Record("glDepthFunc", { func });
+    }
 
-    */
-    const ProgramPtr& GetActiveProgram() const;
+    //--------------------------------------------------------------------------------------
+    void APIENTRY DepthMask(GLboolean flag)
+    {
+        Record("glDepthMask", { flag });
+    }
 
-};
+    //--------------------------------------------------------------------------------------
+    void APIENTRY ColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha)
+    {
+        Record("glColorMask", { red, green, blue, alpha });
+    }
 
+    //--------------------------------------------------------------------------------------
+    void APIENTRY CullFace(GLenum mode)
+    {
+        Record("glCullFace", { mode });
+    }
 
+    //--------------------------------------------------------------------------------------
+    void APIENTRY Viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+    {
+        g_Viewport[0] = x;
+        g_Viewport[1] = y;
+        g_Viewport[2] = width;
+        g_Viewport[3] = height;
+        Record("glViewport", { x, y, width, height });
+    }
 
-/*
-===================================================================================================
-SeparateProgram Methods
+    //--------------------------------------------------------------------------------------
+    void APIENTRY Scissor(GLint x, GLint y, GLsizei width, GLsizei height)
+    {
+        Record("glScissor", { x, y, width, height });
+    }
 
+    //--------------------------------------------------------------------------------------
+    void APIENTRY Clear(GLbitfield mask)
+    {
+        Record("glClear", { mask });
+    }
 
-*/
+    //--------------------------------------------------------------------------------------
+    void APIENTRY ClearColor(GLfloat, GLfloat, GLfloat, GLfloat)
+    {
+        Record("glClearColor", {});
+    }
 
-//--------------------------------------------------------------------------------------
-SeparateProgram::SeparateProgram()
-{
-    //prevents from attempting to create separate shaders w/o the extension
-    ASSERT_EXTENTION(GL_ARB_separate_shader_objects);
-}
+    //--------------------------------------------------------------------------------------
+    void APIENTRY ClearDepth(GLdouble)
+    {
+        Record("glClearDepth", {});
+    }
 
-//--------------------------------------------------------------------------------------
-SeparateProgram::~SeparateProgram()
-{
-    glDeleteProgramPipelines(1, &mPPOId); 
-}
+    //--------------------------------------------------------------------------------------
+    void APIENTRY Finish()
+    {
+        Record("glFinish", {});
+    }
 
-//--------------------------------------------------------------------------------------
-void SeparateProgram::Init()
-{
-    glGenProgramPipelines(1, &mPPOId);
+    //--------------------------------------------------------------------------------------
+    void APIENTRY Flush()
+    {
+        Record("glFlush", {});
+    }
 
-    if (mPPOId == 0)
+    //--------------------------------------------------------------------------------------
+    void APIENTRY PixelStorei(GLenum pname, GLint param)
     {
-        GLUF_CRITICAL_EXCEPTION(CreateGLPPOException());
+        Record("glPixelStorei", { pname, param });
     }
-}
 
-//--------------------------------------------------------------------------------------
-void SeparateProgram::AttachProgram(const ProgramPtr& program)
-{
-    glBindProgramPipeline(mPPOId);
-    mPrograms.push_back(program); 
-    glUseProgramStages(mPPOId, program->GetBitfield(), program->GetId());
-}
+    //--------------------------------------------------------------------------------------
+    void APIENTRY ReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels)
+    {
+        unsigned long long bytes = (unsigned long long)width * height * GLCounting::PixelSize(format, type);
+        if (pixels)
+            std::memset(pixels, 0, static_cast<std::size_t>(bytes));
+        Record("glReadPixels", { x, y, width, height, format, type }, bytes);
+    }
 
-//--------------------------------------------------------------------------------------
-void SeparateProgram::ClearStages(GLbitfield stages)
-{
-    glUseProgramStages(mPPOId, stages, 0);
+    //buffers
 
-    //remove the programs that are affected by this clear
-    for (auto it = mPrograms.begin(); it != mPrograms.end(); ++it)
+    //--------------------------------------------------------------------------------------
+    void APIENTRY GenBuffers(GLsizei n, GLuint* buffers)
     {
-        //if any of the bits of this bitfield are the same, then remove the program.  NOTE: IT IS BAD PRACTICE TO HAVE PROGRAMS HAVE MULTIPLE STAGES, AND ONLY REMOVE ONE OF THEM
-        if (((*it)->GetBitfield() & stages) != 0)
-            mPrograms.erase(it);
+        GenNames("glGenBuffers", n, buffers, g_Buffers);
     }
-}
-
-//--------------------------------------------------------------------------------------
-void SeparateProgram::SetActiveShaderProgram(ProgramStage stage)
-{
-    glBindProgramPipeline(mPPOId);
 
-    //does the currently bound program have this stage?
-    if (mActiveProgram)
-        if ((mActiveProgram->GetBitfield() & stage) != 0)
-            return;//do nothing
-    
-    //find which program contains this stage
-    bool success = false;
-    for (auto it : mPrograms)
+    //--------------------------------------------------------------------------------------
+    void APIENTRY DeleteBuffers(GLsizei n, const GLuint* buffers)
     {
-        if ((it->GetBitfield() & stage) != 0)
+        for (GLsizei i = 0; i < n; ++i)
         {
-            mActiveProgram = it;
-            success = true;
-            break;
+            for (auto& it : g_BufferBindings)
+                if (it.second == buffers[i])
+                    it.second = 0;
         }
+        DeleteNames("glDeleteBuffers", n, buffers, g_Buffers);
     }
 
-    if (!success)
+    //--------------------------------------------------------------------------------------
+    void APIENTRY BindBuffer(GLenum target, GLuint buffer)
     {
-        //if the stage does not exist, reset to default (null)
-        mActiveProgram = nullptr;
-        glActiveShaderProgram(mPPOId, 0);
+        g_BufferBindings[target] = buffer;
+        if (buffer != 0)
+            g_Buffers[buffer];
+        Record("glBindBuffer", { target, buffer });
+    }
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+    {
+        unsigned long long bytes = data ? (unsigned long long)size : 0;
+        ++g_Counters.mBufferUploads;
+        g_Counters.mBufferUploadBytes += bytes;
+        Record("glBufferData", { target, size, usage }, bytes);
+
+        BufferObject* buffer = BoundBuffer(target);
+        if (!buffer || size < 0)
+            return;
 
+        buffer->mUsage = usage;
+        if (data)
+            buffer->mData.assign(static_cast<const char*>(data), static_cast<const char*>(data) + size);
+        else
+            buffer->mData.assign(static_cast<std::size_t>(size), 0);
     }
-    else
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
     {
-        glActiveShaderProgram(mPPOId, mActiveProgram->GetId());
+        ++g_Counters.mBufferUploads;
+        g_Counters.mBufferUploadBytes += (unsigned long long)size;
+        Record("glBufferSubData", { target, offset, size }, (unsigned long long)size);
+
+        BufferObject* buffer = BoundBuffer(target);
+        if (!buffer || !data || offset < 0 || size < 0 || (std::size_t)(offset + size) > buffer->mData.size())
+            return;
+
+        std::memcpy(buffer->mData.data() + offset, data, static_cast<std::size_t>(size));
     }
-}
 
-//--------------------------------------------------------------------------------------
-const ProgramPtr& SeparateProgram::GetActiveProgram() const
-{
-    if (mActiveProgram == nullptr)
+    //--------------------------------------------------------------------------------------
+    void APIENTRY CopyBufferSubData(GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size)
     {
-        GLUF_NON_CRITICAL_EXCEPTION(NoActiveProgramUniformException());
+        Record("glCopyBufferSubData", { readTarget, writeTarget, readOffset, writeOffset, size });
+
+        BufferObject* src = BoundBuffer(readTarget);
+        BufferObject* dst = BoundBuffer(writeTarget);
+        if (!src || !dst || readOffset < 0 || writeOffset < 0 || size < 0 ||
+            (std::size_t)(readOffset + size) > src->mData.size() || (std::size_t)(writeOffset + size) > dst->mData.size())
+            return;
+
+        std::memmove(dst->mData.data() + writeOffset, src->mData.data() + readOffset, static_cast<std::size_t>(size));
     }
 
-    return mActiveProgram;
-}
+    //--------------------------------------------------------------------------------------
+    void* APIENTRY MapBuffer(GLenum target, GLenum access)
+    {
+        Record("glMapBuffer", { target, access });
 
+        BufferObject* buffer = BoundBuffer(target);
+        if (!buffer || buffer->mData.empty())
+            return nullptr;
 
-/*
-===================================================================================================
-Shader Methods
+        buffer->mMapAccess = access;
+        return buffer->mData.data();
+    }
 
+    //--------------------------------------------------------------------------------------
+    GLboolean APIENTRY UnmapBuffer(GLenum target)
+    {
+        BufferObject* buffer = BoundBuffer(target);
 
-*/
+        //writes through a mapping are uploads of the whole range
+        unsigned long long bytes = 0;
+        if (buffer && buffer->mMapAccess != 0 && buffer->mMapAccess != GL_READ_ONLY)
+        {
+            bytes = buffer->mData.size();
+            ++g_Counters.mBufferUploads;
+            g_Counters.mBufferUploadBytes += bytes;
+        }
+        Record("glUnmapBuffer", { target }, bytes);
 
+        if (!buffer || buffer->mMapAccess == 0)
+            return GL_FALSE;
 
-//--------------------------------------------------------------------------------------
-Shader::Shader() noexcept 
-{
-    mShaderId = 0;
-}
+        buffer->mMapAccess = 0;
+        return GL_TRUE;
+    }
 
-//--------------------------------------------------------------------------------------
-Shader::~Shader() noexcept 
-{
-    if (mShaderId != 0)
+    //--------------------------------------------------------------------------------------
+    void APIENTRY BufferStorage(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags)
     {
-        glDeleteShader(mShaderId);
+        unsigned long long bytes = data ? (unsigned long long)size : 0;
+        ++g_Counters.mBufferUploads;
+        g_Counters.mBufferUploadBytes += bytes;
+        Record("glBufferStorage", { target, size, flags }, bytes);
+
+        BufferObject* buffer = BoundBuffer(target);
+        if (!buffer || size < 0)
+            return;
+
+        if (data)
+            buffer->mData.assign(static_cast<const char*>(data), static_cast<const char*>(data) + size);
+        else
+            buffer->mData.assign(static_cast<std::size_t>(size), 0);
     }
-    mTmpShaderText.clear();
-}
 
-//--------------------------------------------------------------------------------------
-void Shader::Init(ShaderType shaderType) noexcept 
-{
-    mShaderType = shaderType;
-    mShaderId = 0;
-}
+    //--------------------------------------------------------------------------------------
+    void* APIENTRY MapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+    {
+        Record("glMapBufferRange", { target, offset, length, access });
 
-//--------------------------------------------------------------------------------------
-void Shader::Load(const std::string& shaderText, bool append)
-{
-    if (!append)
-        mTmpShaderText.clear();
+        BufferObject* buffer = BoundBuffer(target);
+        if (!buffer || offset < 0 || length <= 0 || (std::size_t)(offset + length) > buffer->mData.size())
+            return nullptr;
 
-    mTmpShaderText.append(shaderText);
-}
+        //persistent mappings are written straight into 'mData', so unmapping them is not an upload
+        bool write = (access & GL_MAP_WRITE_BIT) && !(access & GL_MAP_PERSISTENT_BIT);
+        buffer->mMapAccess = write ? GL_WRITE_ONLY : GL_READ_ONLY;
+        return buffer->mData.data() + offset;
+    }
 
-//--------------------------------------------------------------------------------------
-void Shader::Destroy() noexcept 
-{
-    if (mShaderId != 0)
+    //--------------------------------------------------------------------------------------
+    void APIENTRY FlushMappedBufferRange(GLenum target, GLintptr offset, GLsizeiptr length)
     {
-        glDeleteShader(mShaderId);
-        mShaderId = 0;
+        ++g_Counters.mBufferUploads;
+        g_Counters.mBufferUploadBytes += (unsigned long long)length;
+        Record("glFlushMappedBufferRange", { target, offset, length }, (unsigned long long)length);
     }
-    mTmpShaderText.clear();
-}
-
-//--------------------------------------------------------------------------------------
-/*void Shader::LoadFromMemory(const std::vector<char>& shaderData, bool append)
-{
-    if (!append)
-        mTmpShaderText.clear();
-
-    std::string loadedText;
 
-    try
+    //--------------------------------------------------------------------------------------
+    void APIENTRY BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
     {
-        LoadBinaryArrayIntoString(shaderData, loadedText);
+        g_BufferBindings[target] = buffer;
+        Record("glBindBufferRange", { target, index, buffer, offset, size });
     }
-    catch (...)
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY BindBufferBase(GLenum target, GLuint index, GLuint buffer)
     {
-        GLUF_ERROR("(Shader): Failed to load binary memory into shader string");
-        throw;
+        g_BufferBindings[target] = buffer;
+        Record("glBindBufferBase", { target, index, buffer });
     }
 
-    
-    mTmpShaderText += loadedText;
-
-}*/
+    //sync objects; nothing is ever in flight here, so every fence is already signaled
 
-//--------------------------------------------------------------------------------------
-/*bool Shader::LoadFromFile(const std::wstring& filePath, bool append)
-{
-    if (!append)
-        mTmpShaderText.clear();
+    //--------------------------------------------------------------------------------------
+    GLsync APIENTRY FenceSync(GLenum condition, GLbitfield flags)
+    {
+        Record("glFenceSync", { condition, flags });
+        return reinterpret_cast<GLsync>(static_cast<std::uintptr_t>(g_NextName++));
+    }
 
-    std::ifstream inFile(filePath);
-    inFile.exceptions(std::ios::badbit | std::ios::failbit);
+    //--------------------------------------------------------------------------------------
+    GLenum APIENTRY ClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout)
+    {
+        Record("glClientWaitSync", { flags, static_cast<long long>(timeout) });
+        return sync ? GL_ALREADY_SIGNALED : GL_WAIT_FAILED;
+    }
 
-    try
+    //--------------------------------------------------------------------------------------
+    void APIENTRY DeleteSync(GLsync sync)
     {
-#pragma warning (disable : 4244)
-        std::string newString;
+        Record("glDeleteSync", {});
+    }
 
-        inFile.seekg(0, std::ios::end);
-        newString.resize(inFile.tellg());
-        inFile.seekg(0, std::ios::beg);
+    //vertex arrays and drawing
 
-        //TODO: DOES THIS NEED TO HAVE A +1 SOMEWHERE TO ACCOUNT FOR NULL CHARACTER
-        inFile.read(&newString[0], newString.size());
-        inFile.close();
-    }
-    catch (...)
+    //--------------------------------------------------------------------------------------
+    void APIENTRY GenVertexArrays(GLsizei n, GLuint* arrays)
     {
-        GLUF_ERROR("(Shader): Failed to load shader text from file!");
-        throw;
+        GenNames("glGenVertexArrays", n, arrays, g_VertexArrays);
     }
 
-    return true;
-}*/
-
-#define FAILED_COMPILE 'F'
-#define FAILED_LINK    'F'
+    //--------------------------------------------------------------------------------------
+    void APIENTRY DeleteVertexArrays(GLsizei n, const GLuint* arrays)
+    {
+        for (GLsizei i = 0; i < n; ++i)
+            if (g_VertexArrayBinding == arrays[i])
+                g_VertexArrayBinding = 0;
+        DeleteNames("glDeleteVertexArrays", n, arrays, g_VertexArrays);
+    }
 
+    //--------------------------------------------------------------------------------------
+    void APIENTRY BindVertexArray(GLuint array)
+    {
+        g_VertexArrayBinding = array;
+        Record("glBindVertexArray", { array });
+    }
 
-//--------------------------------------------------------------------------------------
-void Shader::Compile(ShaderInfoStruct& returnStruct)
-{
-    //if the shader id is not 0, this means the previous compile attempt was successful, because if it was not, the program is deleted and reset to 0
-    if (mShaderId != 0)
+    //--------------------------------------------------------------------------------------
+    void APIENTRY EnableVertexAttribArray(GLuint index)
     {
-        returnStruct.mSuccess = false;
-        returnStruct.mLog = "F";
-        return;
+        Record("glEnableVertexAttribArray", { index });
     }
 
-    //create the shader
-    mShaderId = glCreateShader(mShaderType);
+    //--------------------------------------------------------------------------------------
+    void APIENTRY DisableVertexAttribArray(GLuint index)
+    {
+        Record("glDisableVertexAttribArray", { index });
+    }
 
-    //if shader creation failed, throw an exception
-    if (mShaderId == 0)
-        GLUF_CRITICAL_EXCEPTION(CreateGLShaderException());
+    //--------------------------------------------------------------------------------------
+    void APIENTRY VertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer)
+    {
+        Record("glVertexAttribPointer", { index, size, type, normalized, stride, Offset(pointer) });
+    }
 
-    //start by adding the strings to glShader Source.  This is done right before the compile
-    //process becuase it is hard to remove it if there is any reason to flush the text
+    //--------------------------------------------------------------------------------------
+    void APIENTRY DrawArrays(GLenum mode, GLint first, GLsizei count)
+    {
+        ++g_Counters.mDrawCalls;
+        Record("glDrawArrays", { mode, first, count });
+    }
 
-    std::string tmpText = mTmpShaderText;
+    //--------------------------------------------------------------------------------------
+    void APIENTRY DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
+    {
+        ++g_Counters.mDrawCalls;
+        Record("glDrawElements", { mode, count, type, Offset(indices) });
+    }
 
-    GLint tmpSize = (GLuint)mTmpShaderText.length();
-    tmpSize--; /*BECAUSE OF NULL TERMINATED STRINGS*/
+    //--------------------------------------------------------------------------------------
+    void APIENTRY DrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instancecount)
+    {
+        ++g_Counters.mDrawCalls;
+        Record("glDrawArraysInstanced", { mode, first, count, instancecount });
+    }
 
-    const GLchar* text = tmpText.c_str();
-    glShaderSource(mShaderId, 1, &text, &tmpSize);
+    //--------------------------------------------------------------------------------------
+    void APIENTRY DrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount)
+    {
+        ++g_Counters.mDrawCalls;
+        Record("glDrawElementsInstanced", { mode, count, type, Offset(indices), instancecount });
+    }
 
-    //flush text upon compile no matter what (if compile failed, why would we want to keep the error-ridden code)
-    FlushText();
+    //textures
 
-    glCompileShader(mShaderId);
+    //--------------------------------------------------------------------------------------
+    void APIENTRY GenTextures(GLsizei n, GLuint* textures)
+    {
+        GenNames("glGenTextures", n, textures, g_Textures);
+    }
 
-    GLint isCompiled = 0;
-    glGetShaderiv(mShaderId, GL_COMPILE_STATUS, &isCompiled);
-    returnStruct.mSuccess = (isCompiled == GL_FALSE) ? false : true;
+    //--------------------------------------------------------------------------------------
+    void APIENTRY DeleteTextures(GLsizei n, const GLuint* textures)
+    {
+        for (GLsizei i = 0; i < n; ++i)
+        {
+            for (auto& it : g_TextureBindings)
+                if (it.second == textures[i])
+                    it.second = 0;
+        }
+        DeleteNames("glDeleteTextures", n, textures, g_Textures);
+    }
 
-    GLint maxLength = 0;
-    glGetShaderiv(mShaderId, GL_INFO_LOG_LENGTH, &maxLength);
+    //--------------------------------------------------------------------------------------
+    void APIENTRY ActiveTexture(GLenum texture)
+    {
+        g_ActiveTexture = texture - GL_TEXTURE0;
+        Record("glActiveTexture", { texture });
+    }
 
-    //The maxLength includes the NULL character
-    returnStruct.mLog.resize(maxLength);
-    glGetShaderInfoLog(mShaderId, maxLength, &maxLength, &returnStruct.mLog[0]);
+    //--------------------------------------------------------------------------------------
+    void APIENTRY BindTexture(GLenum target, GLuint texture)
+    {
+        ++g_Counters.mTextureBinds;
+        Record("glBindTexture", { target, texture });
 
-    //Provide the infolog in whatever manor you deem best.
-    //Exit with failure.
+        g_TextureBindings[{ g_ActiveTexture, target }] = texture;
+        if (texture != 0)
+        {
+            auto& tex = g_Textures[texture];
+            if (tex.mTarget == 0)
+                tex.mTarget = target;
+        }
+    }
 
-    //if it failed, delete the shader, to have a universal way of determining failure
-    if (returnStruct.mSuccess == false)
+    //--------------------------------------------------------------------------------------
+    void APIENTRY BindSampler(GLuint unit, GLuint sampler)
     {
-        glDeleteShader(mShaderId);
-        mShaderId = 0;
-        GLUF_CRITICAL_EXCEPTION(CompileShaderException());
+        Record("glBindSampler", { unit, sampler });
     }
-    return;
-}
 
+    //--------------------------------------------------------------------------------------
+    void APIENTRY TexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels)
+    {
+        unsigned long long pixelSize = GLCounting::PixelSize(format, type);
+        unsigned long long bytes = pixels ? (unsigned long long)width * height * pixelSize : 0;
+        ++g_Counters.mTextureUploads;
+        g_Counters.mTextureUploadBytes += bytes;
+        Record("glTexImage2D", { target, level, internalformat, width, height, border, format, type }, bytes);
 
+        TextureObject* texture = BoundTexture(target);
+        if (!texture)
+            return;
 
+        TextureLevel& lvl = texture->mLevels[{ target, level }];
+        lvl.mWidth = width;
+        lvl.mHeight = height;
+        lvl.mInternalFormat = internalformat;
+        lvl.mCompressed = false;
+        lvl.mPixelSize = pixelSize;
+        lvl.mBytes = (unsigned long long)width * height * pixelSize;
+    }
 
+    //--------------------------------------------------------------------------------------
+    void APIENTRY TexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels)
+    {
+        unsigned long long bytes = (unsigned long long)width * height * GLCounting::PixelSize(format, type);
+        ++g_Counters.mTextureUploads;
+        g_Counters.mTextureUploadBytes += bytes;
+        Record("glTexSubImage2D", { target, level, xoffset, yoffset, width, height, format, type }, bytes);
+    }
 
-/*
-===================================================================================================
-Program Methods
+    //--------------------------------------------------------------------------------------
+    void APIENTRY CompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void* data)
+    {
+        unsigned long long bytes = data ? (unsigned long long)imageSize : 0;
+        ++g_Counters.mTextureUploads;
+        g_Counters.mTextureUploadBytes += bytes;
+        Record("glCompressedTexImage2D", { target, level, internalformat, width, height, border, imageSize }, bytes);
 
+        TextureObject* texture = BoundTexture(target);
+        if (!texture)
+            return;
 
-*/
+        TextureLevel& lvl = texture->mLevels[{ target, level }];
+        lvl.mWidth = width;
+        lvl.mHeight = height;
+        lvl.mInternalFormat = internalformat;
+        lvl.mCompressed = true;
+        lvl.mPixelSize = 0;
+        lvl.mBytes = (unsigned long long)imageSize;
+    }
 
-//--------------------------------------------------------------------------------------
-Program::Program() noexcept 
-{
-    mProgramId = 0;
-}
+    //--------------------------------------------------------------------------------------
+    void APIENTRY CompressedTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void* data)
+    {
+        ++g_Counters.mTextureUploads;
+        g_Counters.mTextureUploadBytes += (unsigned long long)imageSize;
+        Record("glCompressedTexSubImage2D", { target, level, xoffset, yoffset, width, height, format, imageSize }, (unsigned long long)imageSize);
+    }
 
-//--------------------------------------------------------------------------------------
-Program::~Program() noexcept 
-{
-    glDeleteProgram(mProgramId);
-}
+    //--------------------------------------------------------------------------------------
+    void APIENTRY TexImage3D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void* pixels)
+    {
+        unsigned long long pixelSize = GLCounting::PixelSize(format, type);
+        unsigned long long bytes = pixels ? (unsigned long long)width * height * depth * pixelSize : 0;
+        ++g_Counters.mTextureUploads;
+        g_Counters.mTextureUploadBytes += bytes;
+        Record("glTexImage3D", { target, level, internalformat, width, height, depth, border, format, type }, bytes);
 
-//--------------------------------------------------------------------------------------
-void Program::Init()
-{
-    //unlike with the shader, this will be created during initialization
-    mProgramId = glCreateProgram();
+        TextureObject* texture = BoundTexture(target);
+        if (!texture)
+            return;
 
-    if (mProgramId == 0)
-        GLUF_CRITICAL_EXCEPTION(CreateGLProgramException());
-}
+        TextureLevel& lvl = texture->mLevels[{ target, level }];
+        lvl.mWidth = width;
+        lvl.mHeight = height;
+        lvl.mDepth = depth;
+        lvl.mInternalFormat = internalformat;
+        lvl.mCompressed = false;
+        lvl.mPixelSize = pixelSize;
+        lvl.mBytes = (unsigned long long)width * height * depth * pixelSize;
+    }
 
-//--------------------------------------------------------------------------------------
-void Program::AttachShader(ShaderPtr shader)
-{
-    ShaderP toInsert{ shader->mShaderType, shader };
-    
-    //does this stage already have a shader assigned to it?
-    auto exists = mShaderBuff.find(shader->mShaderType);
-    if (exists != mShaderBuff.end())
+    //--------------------------------------------------------------------------------------
+    void APIENTRY TexSubImage3D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pixels)
     {
-        //if it does, delete it
-        mShaderBuff.erase(exists);
+        unsigned long long bytes = (unsigned long long)width * height * depth * GLCounting::PixelSize(format, type);
+        ++g_Counters.mTextureUploads;
+        g_Counters.mTextureUploadBytes += bytes;
+        Record("glTexSubImage3D", { target, level, xoffset, yoffset, zoffset, width, height, depth, format, type }, bytes);
     }
 
-    //finally, insert the new one
-    mShaderBuff.insert(toInsert);
+    //--------------------------------------------------------------------------------------
+    void APIENTRY CompressedTexImage3D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLsizei imageSize, const void* data)
+    {
+        unsigned long long bytes = data ? (unsigned long long)imageSize : 0;
+        ++g_Counters.mTextureUploads;
+        g_Counters.mTextureUploadBytes += bytes;
+        Record("glCompressedTexImage3D", { target, level, internalformat, width, height, depth, border, imageSize }, bytes);
 
-    //and add it to OpenGL
-    glAttachShader(mProgramId, shader->mShaderId);
-}
+        TextureObject* texture = BoundTexture(target);
+        if (!texture)
+            return;
 
-//--------------------------------------------------------------------------------------
-void Program::FlushShaders(void) noexcept 
-{
-    //simply go through all of the shaders, remove them, and clear the shader buffer
-    for (auto it : mShaderBuff)
+        TextureLevel& lvl = texture->mLevels[{ target, level }];
+        lvl.mWidth = width;
+        lvl.mHeight = height;
+        lvl.mDepth = depth;
+        lvl.mInternalFormat = internalformat;
+        lvl.mCompressed = true;
+        lvl.mPixelSize = 0;
+        lvl.mBytes = (unsigned long long)imageSize;
+    }
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY CompressedTexSubImage3D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const void* data)
     {
-        glDetachShader(mProgramId, it.second->mShaderId);
+        ++g_Counters.mTextureUploads;
+        g_Counters.mTextureUploadBytes += (unsigned long long)imageSize;
+        Record("glCompressedTexSubImage3D", { target, level, xoffset, yoffset, zoffset, width, height, depth, format, imageSize }, (unsigned long long)imageSize);
     }
-    mShaderBuff.clear();
-}
 
-//--------------------------------------------------------------------------------------
-void Program::Build(ShaderInfoStruct& retStruct, bool separate)
-{
-    //make sure we enable separate shading
-    if (separate)
-    { 
-        mStages = 0;
+    //--------------------------------------------------------------------------------------
+    //defines every level of an immutable texture the way glTexStorage* would, with no data
+    void AllocateStorage(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth)
+    {
+        TextureObject* texture = BoundTexture(target);
+        if (!texture)
+            return;
 
-        glProgramParameteri(mProgramId, GL_PROGRAM_SEPARABLE, GL_TRUE); 
+        texture->mParams[GL_TEXTURE_IMMUTABLE_FORMAT] = GL_TRUE;
+        texture->mParams[GL_TEXTURE_IMMUTABLE_LEVELS] = levels;
 
+        unsigned long long blockSize = 0;
+        unsigned long long pixelSize = 4;
+        switch (internalformat)
+        {
+        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT: case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT: case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT: case GL_COMPRESSED_RED_RGTC1: case GL_COMPRESSED_SIGNED_RED_RGTC1:
+            blockSize = 8;
+            break;
+        case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT: case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT: case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT:
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT: case GL_COMPRESSED_RG_RGTC2: case GL_COMPRESSED_SIGNED_RG_RGTC2:
+        case GL_COMPRESSED_RGBA_BPTC_UNORM_ARB: case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM_ARB: case GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT_ARB:
+        case GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT_ARB:
+            blockSize = 16;
+            break;
+        case GL_R8:
+            pixelSize = 1;
+            break;
+        case GL_RG8: case GL_R16: case GL_R16F: case GL_RGB565: case GL_RGB5_A1:
+            pixelSize = 2;
+            break;
+        case GL_RGB8: case GL_SRGB8:
+            pixelSize = 3;
+            break;
+        case GL_RGBA16: case GL_RGBA16F: case GL_RG32F:
+            pixelSize = 8;
+            break;
+        case GL_RGB32F:
+            pixelSize = 12;
+            break;
+        case GL_RGBA32F:
+            pixelSize = 16;
+            break;
+        }
 
-        //also create the 'mStages' list
+        //cubemaps have a level for each face
+        std::vector<GLenum> levelTargets;
+        if (target == GL_TEXTURE_CUBE_MAP)
+        {
+            for (GLenum face = 0; face < 6; ++face)
+                levelTargets.push_back(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face);
+        }
+        else
+        {
+            levelTargets.push_back(target);
+        }
 
-        for (auto it : mShaderBuff)
+        for (auto levelTarget : levelTargets)
         {
-            mStages |= ShaderTypeToProgramStage(it.first);
+            GLsizei levelWidth = width;
+            GLsizei levelHeight = height;
+            for (GLint level = 0; level < levels; ++level)
+            {
+                TextureLevel& lvl = texture->mLevels[{ levelTarget, level }];
+                lvl.mWidth = levelWidth;
+                lvl.mHeight = levelHeight;
+                lvl.mDepth = depth;
+                lvl.mInternalFormat = internalformat;
+                lvl.mCompressed = blockSize != 0;
+                lvl.mPixelSize = lvl.mCompressed ? 0 : pixelSize;
+                if (lvl.mCompressed)
+                    lvl.mBytes = (unsigned long long)((levelWidth + 3) / 4) * ((levelHeight + 3) / 4) * depth * blockSize;
+                else
+                    lvl.mBytes = (unsigned long long)levelWidth * levelHeight * depth * pixelSize;
+
+                levelWidth = std::max(levelWidth / 2, 1);
+                levelHeight = std::max(levelHeight / 2, 1);
+            }
         }
     }
 
-    //Link our program
-    glLinkProgram(mProgramId);
-
-    //Note the different functions here: glGetProgram* instead of glGetShader*.
-    GLint isLinked = 0;
-    glGetProgramiv(mProgramId, GL_LINK_STATUS, &isLinked);
-    retStruct.mSuccess = (isLinked == GL_FALSE) ? false : true;
-
-    GLint maxLength = 0;
-    glGetProgramiv(mProgramId, GL_INFO_LOG_LENGTH, &maxLength);
-
-    //The maxLength includes the NULL character
-    retStruct.mLog.resize(maxLength);
-    glGetProgramInfoLog(mProgramId, maxLength, &maxLength, &retStruct.mLog[0]);
-
-    if (!retStruct.mSuccess)
+    //--------------------------------------------------------------------------------------
+    void APIENTRY TexStorage2D(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height)
     {
-        //in the case of failure, DO NOT DELETE ANYTHING, but do throw an error
-        GLUF_CRITICAL_EXCEPTION(LinkProgramException());
+        Record("glTexStorage2D", { target, levels, internalformat, width, height });
+        AllocateStorage(target, levels, internalformat, width, height, 1);
     }
-    else
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY TexStorage3D(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth)
     {
-        FlushShaders();//this removes the references to them from the program, but they will still exist unless this is the last reference to them
-        
-        /*
-        
-        This region loads uniform and attribute locations
+        Record("glTexStorage3D", { target, levels, internalformat, width, height, depth });
+        AllocateStorage(target, levels, internalformat, width, height, depth);
+    }
 
-        */
-        
-        
-        //Load the variable names
-        GLint attribCount = 0;
-        glGetProgramiv(mProgramId, GL_ACTIVE_ATTRIBUTES, &attribCount);
+    //--------------------------------------------------------------------------------------
+    void APIENTRY GenerateMipmap(GLenum target)
+    {
+        Record("glGenerateMipmap", { target });
 
-        GLint maxLength;
-        glGetProgramiv(mProgramId, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxLength);
+        TextureObject* texture = BoundTexture(target);
+        if (!texture)
+            return;
 
-        //TODO: right now, these are just placeholders, but perhaps a more in depth variable information structure is needed
-        GLenum type;
-        GLint written, size;
+        auto base = texture->mLevels.find({ target, 0 });
+        if (base == texture->mLevels.end() || base->second.mCompressed)
+            return;
 
-        //this is used to trim the null charactors from the end of the string
-        const auto TrimString = [](std::string& toTrim)
+        TextureLevel lvl = base->second;
+        for (GLint level = 1; lvl.mWidth > 1 || lvl.mHeight > 1; ++level)
         {
-            for (unsigned int i = 0; i < toTrim.size(); ++i)
-            {
-                if (toTrim[i] == '\0')
-                {
-                    toTrim.erase(toTrim.begin() + i, toTrim.end());
-                    break;
-                }
+            lvl.mWidth = std::max(lvl.mWidth / 2, 1);
+            lvl.mHeight = std::max(lvl.mHeight / 2, 1);
+            lvl.mBytes = (unsigned long long)lvl.mWidth * lvl.mHeight * lvl.mPixelSize;
+            texture->mLevels[{ target, level }] = lvl;
+        }
+    }
 
-            }
-        };
+    //--------------------------------------------------------------------------------------
+    void APIENTRY TexParameteri(GLenum target, GLenum pname, GLint param)
+    {
+        Record("glTexParameteri", { target, pname, param });
+        if (TextureObject* texture = BoundTexture(target))
+            texture->mParams[pname] = param;
+    }
 
+    //--------------------------------------------------------------------------------------
+    void APIENTRY TexParameterf(GLenum target, GLenum pname, GLfloat param)
+    {
+        Record("glTexParameterf", { target, pname });
+        if (TextureObject* texture = BoundTexture(target))
+            texture->mParams[pname] = static_cast<GLint>(param);
+    }
 
-        std::string data;
-        for (int i = 0; i < attribCount; ++i)
-        {
-            //resize and clear every time is a bit messy, but is the only way to make sure the string is the right length
-            data.resize(maxLength);
+    //--------------------------------------------------------------------------------------
+    void APIENTRY TexParameterfv(GLenum target, GLenum pname, const GLfloat*)
+    {
+        Record("glTexParameterfv", { target, pname });
+    }
 
-            glGetActiveAttrib(mProgramId, i, maxLength, &written, &size, &type, &data[0]);
-            TrimString(data);
-            mAttributeLocations.insert(VariableLocPair(data, glGetAttribLocation(mProgramId, &data[0])));
+    //--------------------------------------------------------------------------------------
+    void APIENTRY GetTexParameteriv(GLenum target, GLenum pname, GLint* params)
+    {
+        Record("glGetTexParameteriv", { target, pname });
 
-            data.clear();
+        *params = (pname == GL_TEXTURE_MAX_LEVEL) ? 1000 : 0;
+        if (TextureObject* texture = BoundTexture(target))
+        {
+            auto it = texture->mParams.find(pname);
+            if (it != texture->mParams.end())
+                *params = it->second;
         }
+    }
 
-        GLint uniformCount = 0;
-        glGetProgramiv(mProgramId, GL_ACTIVE_UNIFORMS, &uniformCount);
+    //--------------------------------------------------------------------------------------
+    void APIENTRY GetTexLevelParameteriv(GLenum target, GLint level, GLenum pname, GLint* params)
+    {
+        Record("glGetTexLevelParameteriv", { target, level, pname });
 
-        for (int i = 0; i < uniformCount; ++i)
-        {
-            //resize and clear every time is a bit messy, but is the only way to make sure the string is the right length
-            data.resize(maxLength);
+        *params = 0;
+        TextureObject* texture = BoundTexture(target);
+        if (!texture)
+            return;
 
-            glGetActiveUniform(mProgramId, i, maxLength, &written, &size, &type, &data[0]);
-            TrimString(data);
-            mUniformLocations.insert(VariableLocPair(data, glGetUniformLocation(mProgramId, &data[0])));
+        auto it = texture->mLevels.find({ target, level });
+        if (it == texture->mLevels.end())
+            return;
 
-            data.clear();
+        const TextureLevel& lvl = it->second;
+        switch (pname)
+        {
+        case GL_TEXTURE_WIDTH:
+            *params = lvl.mWidth;
+            break;
+        case GL_TEXTURE_HEIGHT:
+            *params = lvl.mHeight;
+            break;
+        case GL_TEXTURE_DEPTH:
+            *params = lvl.mDepth;
+            break;
+        case GL_TEXTURE_INTERNAL_FORMAT:
+            *params = lvl.mInternalFormat;
+            break;
+        case GL_TEXTURE_COMPRESSED:
+            *params = lvl.mCompressed ? GL_TRUE : GL_FALSE;
+            break;
+        case GL_TEXTURE_COMPRESSED_IMAGE_SIZE:
+            *params = lvl.mCompressed ? static_cast<GLint>(lvl.mBytes) : 0;
+            break;
+        case GL_TEXTURE_RED_SIZE:
+            *params = static_cast<GLint>(lvl.mPixelSize * 8);//the whole texel, so the component sizes still add up
+            break;
         }
     }
-}
 
-//--------------------------------------------------------------------------------------
-void Program::Destroy() noexcept 
-{ 
-    if (mProgramId != 0)
+    //framebuffers
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY GenFramebuffers(GLsizei n, GLuint* framebuffers)
     {
-        glDeleteProgram(mProgramId);
-        mProgramId = 0;
+        GenNames("glGenFramebuffers", n, framebuffers, g_Framebuffers);
     }
-    mShaderBuff.clear();
-    mAttributeLocations.clear();
-    mUniformLocations.clear();
-}
-
-//--------------------------------------------------------------------------------------
-GLbitfield Program::GetBitfield() const noexcept
-{
-    return mStages;
 
-    return 0;
-}
+    //--------------------------------------------------------------------------------------
+    void APIENTRY DeleteFramebuffers(GLsizei n, const GLuint* framebuffers)
+    {
+        for (GLsizei i = 0; i < n; ++i)
+            if (g_FramebufferBinding == framebuffers[i])
+                g_FramebufferBinding = 0;
+        DeleteNames("glDeleteFramebuffers", n, framebuffers, g_Framebuffers);
+    }
 
+    //--------------------------------------------------------------------------------------
+    void APIENTRY BindFramebuffer(GLenum target, GLuint framebuffer)
+    {
+        g_FramebufferBinding = framebuffer;
+        Record("glBindFramebuffer", { target, framebuffer });
+    }
 
-/*
-===================================================================================================
-ShaderManager Methods
+    //--------------------------------------------------------------------------------------
+    GLenum APIENTRY CheckFramebufferStatus(GLenum target)
+    {
+        Record("glCheckFramebufferStatus", { target });
+        return GL_FRAMEBUFFER_COMPLETE;
+    }
 
+    //--------------------------------------------------------------------------------------
+    void APIENTRY FramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)
+    {
+        Record("glFramebufferTexture2D", { target, attachment, textarget, texture, level });
+    }
 
-*/
+    //--------------------------------------------------------------------------------------
+    void APIENTRY FramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
+    {
+        Record("glFramebufferRenderbuffer", { target, attachment, renderbuffertarget, renderbuffer });
+    }
 
-/*
-//--------------------------------------------------------------------------------------
-ShaderPtr ShaderManager::CreateShader(std::wstring shad, ShaderType type, bool file, bool separate)
-{
-    ShaderPtr shader(new Shader());
-    shader->Init(type);
+    //--------------------------------------------------------------------------------------
+    void APIENTRY GenRenderbuffers(GLsizei n, GLuint* renderbuffers)
+    {
+        GenNames("glGenRenderbuffers", n, renderbuffers, g_Renderbuffers);
+    }
 
-    (file) ? shader->LoadFromFile(shad.c_str()) : shader->Load(shad.c_str());
+    //--------------------------------------------------------------------------------------
+    void APIENTRY DeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers)
+    {
+        DeleteNames("glDeleteRenderbuffers", n, renderbuffers, g_Renderbuffers);
+    }
 
-    ShaderInfoStruct output;
-    shader->Compile(output);
-    mCompileLogs.insert(std::pair<ShaderPtr, ShaderInfoStruct>(shader, output));
+    //--------------------------------------------------------------------------------------
+    void APIENTRY BindRenderbuffer(GLenum target, GLuint renderbuffer)
+    {
+        Record("glBindRenderbuffer", { target, renderbuffer });
+    }
 
-    //log it if it failed
-    if (!output)
+    //--------------------------------------------------------------------------------------
+    void APIENTRY RenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
     {
-        std::wstringstream ss;
-        ss << "Shader Compilation Failed: \n" << output.mLog;
-        GLUF_ERROR(ss.str().c_str());
+        Record("glRenderbufferStorage", { target, internalformat, width, height });
     }
 
-    return shader;
-}
-*/
+    //queries
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::AddCompileLog(const ShaderPtr& shader, const ShaderInfoStruct& log)
-{
-    //TODO: vs2013 does not support shared locking
-    _TSAFE_SCOPE(mCompLogMutex);
+    //--------------------------------------------------------------------------------------
+    void APIENTRY GenQueries(GLsizei n, GLuint* ids)
+    {
+        GenNames("glGenQueries", n, ids, g_Queries);
+    }
 
-    mCompileLogs.insert(std::pair<ShaderPtr, ShaderInfoStruct>(shader, log));
-}
+    //--------------------------------------------------------------------------------------
+    void APIENTRY DeleteQueries(GLsizei n, const GLuint* ids)
+    {
+        DeleteNames("glDeleteQueries", n, ids, g_Queries);
+    }
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::AddLinkLog(const ProgramPtr& program, const ShaderInfoStruct& log)
-{
-    _TSAFE_SCOPE(mLinkLogMutex);
+    //--------------------------------------------------------------------------------------
+    void APIENTRY QueryCounter(GLuint id, GLenum target)
+    {
+        Record("glQueryCounter", { id, target });
+        g_Queries[id] = g_Timestamp;
+    }
 
-    mLinklogs.insert(std::pair<ProgramPtr, ShaderInfoStruct>(program, log));
-}
+    //--------------------------------------------------------------------------------------
+    void APIENTRY GetQueryObjectuiv(GLuint id, GLenum pname, GLuint* params)
+    {
+        Record("glGetQueryObjectuiv", { id, pname });
+        *params = (pname == GL_QUERY_RESULT_AVAILABLE) ? GL_TRUE : static_cast<GLuint>(g_Queries[id]);
+    }
 
-//--------------------------------------------------------------------------------------
-GLuint ShaderManager::GetUniformIdFromName(const SepProgramPtr& ppo, const std::string& name) const
-{
-    auto activeProgram = ppo->GetActiveProgram();
-    auto it = activeProgram->mUniformLocations.find(name);
-    if (it == activeProgram->mUniformLocations.end())
+    //--------------------------------------------------------------------------------------
+    void APIENTRY GetQueryObjectui64v(GLuint id, GLenum pname, GLuint64* params)
     {
-        GLUF_NON_CRITICAL_EXCEPTION(std::invalid_argument("Uniform Name Not Found!"));
-        return 0;//if we are in release mode, and the name does not exist, default to the 0th, however this MAY CREATE UNDESIRED RESULTS
+        Record("glGetQueryObjectui64v", { id, pname });
+        *params = (pname == GL_QUERY_RESULT_AVAILABLE) ? GL_TRUE : g_Queries[id];
     }
 
-    return it->second;
-}
+    //shaders and programs
 
-//--------------------------------------------------------------------------------------
-GLuint ShaderManager::GetUniformIdFromName(const ProgramPtr& prog, const std::string& name) const
-{
-    auto it = prog->mUniformLocations.find(name);
-    if (it == prog->mUniformLocations.end())
+    //--------------------------------------------------------------------------------------
+    GLuint APIENTRY CreateShader(GLenum type)
     {
-        GLUF_NON_CRITICAL_EXCEPTION(std::invalid_argument("Uniform Name Not Found!"));
-        return 0;//if we are in release mode, and the name does not exist, default to the 0th, however this MAY CREATE UNDESIRED RESULTS
+        GLuint name = g_NextName++;
+        g_Shaders[name].mType = type;
+        Record("glCreateShader", { type, name });
+        return name;
     }
 
-    return it->second;
-}
+    //--------------------------------------------------------------------------------------
+    void APIENTRY DeleteShader(GLuint shader)
+    {
+        Record("glDeleteShader", { shader });
 
+        //like a driver, attached shaders live until they are detached
+        for (const auto& it : g_Programs)
+        {
+            if (std::find(it.second.mShaders.begin(), it.second.mShaders.end(), shader) != it.second.mShaders.end())
+            {
+                g_Shaders[shader].mDeletePending = true;
+                return;
+            }
+        }
+        g_Shaders.erase(shader);
+    }
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::CreateShaderFromFile(ShaderPtr& outShader, const std::string& filePath, ShaderType type)
-{
-    //create the shader
-    outShader = std::make_shared<Shader>();
+    //--------------------------------------------------------------------------------------
+    void APIENTRY ShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length)
+    {
+        std::string source;
+        for (GLsizei i = 0; i < count; ++i)
+        {
+            if (length && length[i] >= 0)
+                source.append(string[i], length[i]);
+            else
+                source.append(string[i]);
+        }
+        Record("glShaderSource", { shader, count }, source.size());
 
-    //file to open
-    std::ifstream inFile;
-    inFile.exceptions(std::ios::badbit | std::ios::failbit);
+        auto it = g_Shaders.find(shader);
+        if (it != g_Shaders.end())
+            it->second.mSource = std::move(source);
+    }
 
-    ShaderInfoStruct output;
-    try
+    //--------------------------------------------------------------------------------------
+    void APIENTRY CompileShader(GLuint shader)
     {
-        //Load the text from the file
-        std::string newString;
+        Record("glCompileShader", { shader });
 
-        //open the file
-        inFile.open(filePath);
-
-        //get the file length
-        inFile.seekg(0, std::ios::end);
-        newString.resize(static_cast<unsigned int>(inFile.tellg()));
-        inFile.seekg(0, std::ios::beg);
+        auto it = g_Shaders.find(shader);
+        if (it != g_Shaders.end())
+            it->second.mCompiled = !it->second.mSource.empty();
+    }
 
-        //TODO: DOES THIS NEED TO HAVE A +1 SOMEWHERE TO ACCOUNT FOR NULL CHARACTER
-        inFile.read(&newString[0], newString.size());
-        inFile.close();
+    //--------------------------------------------------------------------------------------
+    void APIENTRY GetShaderiv(GLuint shader, GLenum pname, GLint* params)
+    {
+        Record("glGetShaderiv", { shader, pname });
 
-        //load it from the file
-        outShader->Load(newString);
+        *params = 0;
+        auto it = g_Shaders.find(shader);
+        if (it == g_Shaders.end())
+            return;
 
-        //compile it
-        outShader->Compile(output);
-        AddCompileLog(outShader, output);
+        switch (pname)
+        {
+        case GL_COMPILE_STATUS:
+            *params = it->second.mCompiled ? GL_TRUE : GL_FALSE;
+            break;
+        case GL_SHADER_TYPE:
+            *params = it->second.mType;
+            break;
+        case GL_DELETE_STATUS:
+            *params = it->second.mDeletePending ? GL_TRUE : GL_FALSE;
+            break;
+        case GL_SHADER_SOURCE_LENGTH:
+            *params = it->second.mSource.empty() ? 0 : static_cast<GLint>(it->second.mSource.size() + 1);
+            break;
+        case GL_COMPLETION_STATUS_ARB:
+            *params = GL_TRUE;//compiles finish immediately
+            break;
+        }
     }
-    catch (const std::ios_base::failure& e)
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY GetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
     {
-        GLUF_ERROR_LONG("(ShaderManager): Shader File Load Failed: " << e.what());
-        RETHROW;//rethrow here, because if file loading failed, the it never got to compilation
+        Record("glGetShaderInfoLog", { shader, bufSize });
+        WriteString("", bufSize, length, infoLog);
     }
-    catch (const CompileShaderException& e)
+
+    //--------------------------------------------------------------------------------------
+    GLuint APIENTRY CreateProgram()
     {
-        GLUF_ERROR_LONG("(ShaderManager): " << e.what());
-        //add the log if file load failed
-        AddCompileLog(outShader, output);
+        GLuint name = g_NextName++;
+        g_Programs[name];
+        Record("glCreateProgram", { name });
+        return name;
+    }
 
-        GLUF_CRITICAL_EXCEPTION(MakeShaderException());
+    //--------------------------------------------------------------------------------------
+    void APIENTRY DeleteProgram(GLuint program)
+    {
+        Record("glDeleteProgram", { program });
+
+        auto it = g_Programs.find(program);
+        if (it == g_Programs.end())
+            return;
+
+        for (GLuint shader : it->second.mShaders)
+        {
+            auto sh = g_Shaders.find(shader);
+            if (sh != g_Shaders.end() && sh->second.mDeletePending)
+                g_Shaders.erase(sh);
+        }
+        g_Programs.erase(it);
     }
-    catch (const CreateGLShaderException& e)
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY AttachShader(GLuint program, GLuint shader)
     {
-        GLUF_ERROR_LONG("(ShaderManager): " << e.what());
-        GLUF_CRITICAL_EXCEPTION(MakeShaderException());//don't add compile log if the shader could not be created
+        Record("glAttachShader", { program, shader });
+
+        auto it = g_Programs.find(program);
+        if (it != g_Programs.end())
+            it->second.mShaders.push_back(shader);
     }
 
-}
+    //--------------------------------------------------------------------------------------
+    void APIENTRY DetachShader(GLuint program, GLuint shader)
+    {
+        Record("glDetachShader", { program, shader });
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::CreateShaderFromText(ShaderPtr& outShader, const std::string& text, ShaderType type)
-{
-    outShader = std::make_shared<Shader>();
+        auto it = g_Programs.find(program);
+        if (it == g_Programs.end())
+            return;
 
-    ShaderInfoStruct out;
-    try
+        auto& shaders = it->second.mShaders;
+        shaders.erase(std::remove(shaders.begin(), shaders.end(), shader), shaders.end());
+
+        auto sh = g_Shaders.find(shader);
+        if (sh != g_Shaders.end() && sh->second.mDeletePending)
+            g_Shaders.erase(sh);
+    }
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY MaxShaderCompilerThreadsARB(GLuint count)
     {
-        //initialize the shader
-        outShader->Init(type);
+        Record("glMaxShaderCompilerThreadsARB", { count });
+    }
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY ProgramParameteri(GLuint program, GLenum pname, GLint value)
+    {
+        Record("glProgramParameteri", { program, pname, value });
+    }
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY LinkProgram(GLuint program)
+    {
+        Record("glLinkProgram", { program });
+
+        auto it = g_Programs.find(program);
+        if (it == g_Programs.end())
+            return;
 
-        //load from the text
-        outShader->Load(text);
+        ProgramObject& prog = it->second;
+        std::vector<std::pair<GLenum, std::string>> sources;
+        bool compiled = true;
+        for (GLuint shader : prog.mShaders)
+        {
+            auto sh = g_Shaders.find(shader);
+            if (sh == g_Shaders.end() || !sh->second.mCompiled)
+                compiled = false;
+            else
+                sources.push_back({ sh->second.mType, sh->second.mSource });
+        }
 
-        //compile it
-        outShader->Compile(out);
-        AddCompileLog(outShader, out);
+        LinkSources(prog, sources);
+        prog.mLinked = prog.mLinked && compiled;
     }
-    catch (const CompileShaderException& e)
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY GetProgramBinary(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary)
     {
-        GLUF_ERROR_LONG("(ShaderManager): " << e.what() << "\n ========Log======== \n" << out.mLog);
-        //add the log if file load failed
-        AddCompileLog(outShader, out);
+        Record("glGetProgramBinary", { program, bufSize });
 
-        GLUF_CRITICAL_EXCEPTION(MakeShaderException());
+        GLsizei written = 0;
+        auto it = g_Programs.find(program);
+        if (it != g_Programs.end() && it->second.mLinked && bufSize >= static_cast<GLsizei>(it->second.mBinary.size()))
+        {
+            written = static_cast<GLsizei>(it->second.mBinary.size());
+            std::memcpy(binary, it->second.mBinary.data(), written);
+            *binaryFormat = GLUF_RECORDING_BINARY_FORMAT;
+        }
+
+        if (length)
+            *length = written;
     }
-    catch (const CreateGLShaderException& e)
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY ProgramBinary(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length)
     {
-        GLUF_ERROR_LONG("(ShaderManager): " << e.what());
-        GLUF_CRITICAL_EXCEPTION(MakeShaderException());//don't add compile log if the shader could not be created
+        Record("glProgramBinary", { program, binaryFormat, length }, length);
+
+        auto it = g_Programs.find(program);
+        if (it == g_Programs.end())
+            return;
+
+        //anything malformed fails to link, like a real driver rejecting a stale binary
+        std::vector<std::pair<GLenum, std::string>> sources;
+        const char* data = static_cast<const char*>(binary);
+        bool valid = (binaryFormat == GLUF_RECORDING_BINARY_FORMAT);
+        std::size_t offset = 0;
+        while (valid && offset < static_cast<std::size_t>(length))
+        {
+            uint32_t header[2];
+            if (length - offset < sizeof(header))
+            {
+                valid = false;
+                break;
+            }
+            std::memcpy(header, data + offset, sizeof(header));
+            offset += sizeof(header);
+
+            if (length - offset < header[1])
+            {
+                valid = false;
+                break;
+            }
+            sources.push_back({ header[0], std::string(data + offset, header[1]) });
+            offset += header[1];
+        }
+
+        if (!valid)
+            sources.clear();
+        LinkSources(it->second, sources);
     }
-}
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::CreateShaderFromMemory(ShaderPtr& outShader, const std::vector<char>& memory, ShaderType type)
-{
-    //load the string from the memory
-    std::string outString;
-    LoadBinaryArrayIntoString(memory, outString);
+    //--------------------------------------------------------------------------------------
+    void APIENTRY GetProgramiv(GLuint program, GLenum pname, GLint* params)
+    {
+        Record("glGetProgramiv", { program, pname });
 
-    //newline here is needed, because end of loaded file might not have one, which is required for the end of a shader for some reason
-    return CreateShaderFromText(outShader, outString + "\n", type);
-}
+        *params = 0;
+        auto it = g_Programs.find(program);
+        if (it == g_Programs.end())
+            return;
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::CreateProgram(ProgramPtr& outProgram, ShaderPtrList shaders, bool separate)
-{
-    outProgram = std::make_shared<Program>();
+        const ProgramObject& prog = it->second;
+        switch (pname)
+        {
+        case GL_LINK_STATUS:
+        case GL_VALIDATE_STATUS:
+            *params = prog.mLinked ? GL_TRUE : GL_FALSE;
+            break;
+        case GL_ATTACHED_SHADERS:
+            *params = static_cast<GLint>(prog.mShaders.size());
+            break;
+        case GL_ACTIVE_ATTRIBUTES:
+            *params = static_cast<GLint>(prog.mAttributes.size());
+            break;
+        case GL_ACTIVE_ATTRIBUTE_MAX_LENGTH:
+            *params = static_cast<GLint>(MaxNameLength(prog.mAttributes));
+            break;
+        case GL_ACTIVE_UNIFORMS:
+            *params = static_cast<GLint>(prog.mUniforms.size());
+            break;
+        case GL_ACTIVE_UNIFORM_MAX_LENGTH:
+            *params = static_cast<GLint>(MaxNameLength(prog.mUniforms));
+            break;
+        case GL_PROGRAM_BINARY_LENGTH:
+            *params = prog.mLinked ? static_cast<GLint>(prog.mBinary.size()) : 0;
+            break;
+        case GL_COMPLETION_STATUS_ARB:
+            *params = GL_TRUE;
+            break;
+        case GL_ACTIVE_UNIFORM_BLOCKS:
+            *params = static_cast<GLint>(prog.mBlocks.size());
+            break;
+        case GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH:
+            for (const auto& block : prog.mBlocks)
+                *params = std::max(*params, static_cast<GLint>(block.mName.size() + 1));
+            break;
+        }
+    }
 
-    ShaderInfoStruct out;
-    try
+    //--------------------------------------------------------------------------------------
+    void APIENTRY GetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
     {
-        //initialize
-        outProgram->Init();
+        Record("glGetProgramInfoLog", { program, bufSize });
+        WriteString("", bufSize, length, infoLog);
+    }
 
-        //add the shaders
-        for (auto it : shaders)
+    //--------------------------------------------------------------------------------------
+    void GetActiveVariable(const std::vector<ReflectedVariable>& variables, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name)
+    {
+        if (index >= variables.size())
         {
-            outProgram->AttachShader(it);
+            WriteString("", bufSize, length, name);
+            return;
         }
 
-        //build the program
-        outProgram->Build(out, separate);
-        AddLinkLog(outProgram, out);
+        const ReflectedVariable& variable = variables[index];
+        WriteString(ActiveName(variable), bufSize, length, name);
+        if (size)
+            *size = variable.mSize;
+        if (type)
+            *type = variable.mType;
     }
-    catch (const CreateGLProgramException& e)
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY GetActiveAttrib(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name)
     {
-        GLUF_ERROR_LONG("(ShaderManager): " << e.what());
-        GLUF_CRITICAL_EXCEPTION(MakeShaderException());
+        Record("glGetActiveAttrib", { program, index, bufSize });
+
+        static const std::vector<ReflectedVariable> none;
+        auto it = g_Programs.find(program);
+        GetActiveVariable(it == g_Programs.end() ? none : it->second.mAttributes, index, bufSize, length, size, type, name);
     }
-    catch (const LinkProgramException& e)
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY GetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name)
     {
-        GLUF_ERROR_LONG("(ShaderManager): " << e.what() << "\n ========Log======== \n" << out.mLog);
-        AddLinkLog(outProgram, out);//if linking failed, still add the log
+        Record("glGetActiveUniform", { program, index, bufSize });
+
+        static const std::vector<ReflectedVariable> none;
+        auto it = g_Programs.find(program);
+        GetActiveVariable(it == g_Programs.end() ? none : it->second.mUniforms, index, bufSize, length, size, type, name);
     }
-    catch (const std::invalid_argument& e)
+
+    //--------------------------------------------------------------------------------------
+    GLint APIENTRY GetAttribLocation(GLuint program, const GLchar* name)
     {
-        GLUF_ERROR_LONG("(ShaderManager): " << e.what());
-        outProgram->FlushShaders();//if any of the shaders failed to add, flush so it is in a valid state
-        GLUF_CRITICAL_EXCEPTION(MakeShaderException());
+        Record("glGetAttribLocation", { program });
+
+        auto it = g_Programs.find(program);
+        return it == g_Programs.end() ? -1 : FindLocation(it->second.mAttributes, name);
     }
-}
 
+    //--------------------------------------------------------------------------------------
+    GLint APIENTRY GetUniformLocation(GLuint program, const GLchar* name)
+    {
+        Record("glGetUniformLocation", { program });
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::CreateProgram(ProgramPtr& outProgram, ShaderSourceList shaderSources, bool separate)
-{
-    ShaderPtrList shaders;
-    for (auto it : shaderSources)
+        auto it = g_Programs.find(program);
+        return it == g_Programs.end() ? -1 : FindLocation(it->second.mUniforms, name);
+    }
+
+    //--------------------------------------------------------------------------------------
+    const ReflectedBlock* FindBlock(GLuint program, GLuint index)
+    {
+        auto it = g_Programs.find(program);
+        if (it == g_Programs.end() || index >= it->second.mBlocks.size())
+            return nullptr;
+        return &it->second.mBlocks[index];
+    }
+
+    //--------------------------------------------------------------------------------------
+    GLuint APIENTRY GetUniformBlockIndex(GLuint program, const GLchar* uniformBlockName)
     {
-        //create the shader from the text
-        std::shared_ptr<Shader> nowShader;
-        CreateShaderFromText(nowShader, it.second, it.first);
+        Record("glGetUniformBlockIndex", { program });
 
-        //add the shader to the list
-        shaders.push_back(nowShader);
+        auto it = g_Programs.find(program);
+        if (it == g_Programs.end())
+            return GL_INVALID_INDEX;
 
-        //the exception hierarchy handles all errors for this method
+        for (std::size_t i = 0; i < it->second.mBlocks.size(); ++i)
+            if (it->second.mBlocks[i].mName == uniformBlockName)
+                return static_cast<GLuint>(i);
+        return GL_INVALID_INDEX;
     }
 
-    CreateProgram(outProgram, shaders, separate);
-}
+    //--------------------------------------------------------------------------------------
+    void APIENTRY GetActiveUniformBlockName(GLuint program, GLuint uniformBlockIndex, GLsizei bufSize, GLsizei* length, GLchar* uniformBlockName)
+    {
+        Record("glGetActiveUniformBlockName", { program, uniformBlockIndex, bufSize });
 
+        const ReflectedBlock* block = FindBlock(program, uniformBlockIndex);
+        WriteString(block ? block->mName : "", bufSize, length, uniformBlockName);
+    }
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::CreateProgramFromFiles(ProgramPtr& outProgram, ShaderPathList shaderPaths, bool separate)
-{
-    ShaderPtrList shaders;
-    for (auto it : shaderPaths)
+    //--------------------------------------------------------------------------------------
+    void APIENTRY GetActiveUniformBlockiv(GLuint program, GLuint uniformBlockIndex, GLenum pname, GLint* params)
     {
-        //create the shader from the text
-        auto nowShader = std::make_shared<Shader>();
-        CreateShaderFromFile(nowShader, it.second, it.first);
+        Record("glGetActiveUniformBlockiv", { program, uniformBlockIndex, pname });
 
-        //add the shader to the list
-        shaders.push_back(nowShader);
+        const ReflectedBlock* block = FindBlock(program, uniformBlockIndex);
+        if (!block)
+            return;
 
-        //the exception hierarchy handles all errors for this method
+        switch (pname)
+        {
+        case GL_UNIFORM_BLOCK_BINDING:
+            *params = block->mBinding;
+            break;
+        case GL_UNIFORM_BLOCK_DATA_SIZE:
+            *params = block->mDataSize;
+            break;
+        case GL_UNIFORM_BLOCK_NAME_LENGTH:
+            *params = static_cast<GLint>(block->mName.size() + 1);
+            break;
+        case GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS:
+            *params = 0;
+            for (const auto& it : g_Programs[program].mUniforms)
+                *params += (it.mBlockIndex == static_cast<GLint>(uniformBlockIndex)) ? 1 : 0;
+            break;
+        }
     }
 
-    CreateProgram(outProgram, shaders, separate);
-}
+    //--------------------------------------------------------------------------------------
+    void APIENTRY GetActiveUniformsiv(GLuint program, GLsizei uniformCount, const GLuint* uniformIndices, GLenum pname, GLint* params)
+    {
+        Record("glGetActiveUniformsiv", { program, uniformCount, pname });
 
-//for removing things
+        auto it = g_Programs.find(program);
+        for (GLsizei i = 0; i < uniformCount; ++i)
+        {
+            if (it == g_Programs.end() || uniformIndices[i] >= it->second.mUniforms.size())
+                continue;
+
+            const ReflectedVariable& variable = it->second.mUniforms[uniformIndices[i]];
+            switch (pname)
+            {
+            case GL_UNIFORM_TYPE:
+                params[i] = static_cast<GLint>(variable.mType);
+                break;
+            case GL_UNIFORM_SIZE:
+                params[i] = variable.mSize;
+                break;
+            case GL_UNIFORM_NAME_LENGTH:
+                params[i] = static_cast<GLint>(ActiveName(variable).size() + 1);
+                break;
+            case GL_UNIFORM_BLOCK_INDEX:
+                params[i] = variable.mBlockIndex;
+                break;
+            case GL_UNIFORM_OFFSET:
+                params[i] = variable.mOffset;
+                break;
+            case GL_UNIFORM_ARRAY_STRIDE:
+                params[i] = variable.mArrayStride;
+                break;
+            case GL_UNIFORM_MATRIX_STRIDE:
+                params[i] = variable.mMatrixStride;
+                break;
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY UniformBlockBinding(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding)
+    {
+        Record("glUniformBlockBinding", { program, uniformBlockIndex, uniformBlockBinding });
+
+        auto it = g_Programs.find(program);
+        if (it != g_Programs.end() && uniformBlockIndex < it->second.mBlocks.size())
+            it->second.mBlocks[uniformBlockIndex].mBinding = static_cast<GLint>(uniformBlockBinding);
+    }
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY UseProgram(GLuint program)
+    {
+        ++g_Counters.mProgramBinds;
+        g_CurrentProgram = program;
+        Record("glUseProgram", { program });
+    }
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY GenProgramPipelines(GLsizei n, GLuint* pipelines)
+    {
+        GenNames("glGenProgramPipelines", n, pipelines, g_Pipelines);
+    }
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY DeleteProgramPipelines(GLsizei n, const GLuint* pipelines)
+    {
+        DeleteNames("glDeleteProgramPipelines", n, pipelines, g_Pipelines);
+    }
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY BindProgramPipeline(GLuint pipeline)
+    {
+        ++g_Counters.mProgramBinds;
+        Record("glBindProgramPipeline", { pipeline });
+    }
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY UseProgramStages(GLuint pipeline, GLbitfield stages, GLuint program)
+    {
+        Record("glUseProgramStages", { pipeline, stages, program });
+    }
+
+    //--------------------------------------------------------------------------------------
+    void APIENTRY ActiveShaderProgram(GLuint pipeline, GLuint program)
+    {
+        Record("glActiveShaderProgram", { pipeline, program });
+    }
+
+    //uniforms; values are not kept, only how much was sent
+
+#define GLUF_RECORDING_UNIFORM_SCALAR(suffix, type) \
+    void APIENTRY Uniform##suffix(GLint location, type) \
+    { \
+        Record("glUniform" #suffix, { location }, sizeof(type)); \
+    } \
+    void APIENTRY ProgramUniform##suffix(GLuint program, GLint location, type) \
+    { \
+        Record("glProgramUniform" #suffix, { program, location }, sizeof(type)); \
+    }
+
+#define GLUF_RECORDING_UNIFORM_VECTOR(suffix, type, components) \
+    void APIENTRY Uniform##suffix(GLint location, GLsizei count, const type*) \
+    { \
+        Record("glUniform" #suffix, { location, count }, (unsigned long long)count * components * sizeof(type)); \
+    } \
+    void APIENTRY ProgramUniform##suffix(GLuint program, GLint location, GLsizei count, const type*) \
+    { \
+        Record("glProgramUniform" #suffix, { program, location, count }, (unsigned long long)count * components * sizeof(type)); \
+    }
+
+#define GLUF_RECORDING_UNIFORM_MATRIX(suffix, components) \
+    void APIENTRY Uniform##suffix(GLint location, GLsizei count, GLboolean transpose, const GLfloat*) \
+    { \
+        Record("glUniform" #suffix, { location, count, transpose }, (unsigned long long)count * components * sizeof(GLfloat)); \
+    } \
+    void APIENTRY ProgramUniform##suffix(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat*) \
+    { \
+        Record("glProgramUniform" #suffix, { program, location, count, transpose }, (unsigned long long)count * components * sizeof(GLfloat)); \
+    }
+
+    GLUF_RECORDING_UNIFORM_SCALAR(1f, GLfloat)
+    GLUF_RECORDING_UNIFORM_SCALAR(1i, GLint)
+    GLUF_RECORDING_UNIFORM_SCALAR(1ui, GLuint)
+    GLUF_RECORDING_UNIFORM_VECTOR(1fv, GLfloat, 1)
+    GLUF_RECORDING_UNIFORM_VECTOR(1iv, GLint, 1)
+    GLUF_RECORDING_UNIFORM_VECTOR(1uiv, GLuint, 1)
+    GLUF_RECORDING_UNIFORM_VECTOR(2fv, GLfloat, 2)
+    GLUF_RECORDING_UNIFORM_VECTOR(3fv, GLfloat, 3)
+    GLUF_RECORDING_UNIFORM_VECTOR(4fv, GLfloat, 4)
+    GLUF_RECORDING_UNIFORM_VECTOR(2iv, GLint, 2)
+    GLUF_RECORDING_UNIFORM_VECTOR(3iv, GLint, 3)
+    GLUF_RECORDING_UNIFORM_VECTOR(4iv, GLint, 4)
+    GLUF_RECORDING_UNIFORM_VECTOR(2uiv, GLuint, 2)
+    GLUF_RECORDING_UNIFORM_VECTOR(3uiv, GLuint, 3)
+    GLUF_RECORDING_UNIFORM_VECTOR(4uiv, GLuint, 4)
+    GLUF_RECORDING_UNIFORM_MATRIX(Matrix2fv, 4)
+    GLUF_RECORDING_UNIFORM_MATRIX(Matrix3fv, 9)
+    GLUF_RECORDING_UNIFORM_MATRIX(Matrix4fv, 16)
+    GLUF_RECORDING_UNIFORM_MATRIX(Matrix2x3fv, 6)
+    GLUF_RECORDING_UNIFORM_MATRIX(Matrix2x4fv, 8)
+    GLUF_RECORDING_UNIFORM_MATRIX(Matrix3x2fv, 6)
+    GLUF_RECORDING_UNIFORM_MATRIX(Matrix3x4fv, 12)
+    GLUF_RECORDING_UNIFORM_MATRIX(Matrix4x2fv, 8)
+    GLUF_RECORDING_UNIFORM_MATRIX(Matrix4x3fv, 12)
+
+#undef GLUF_RECORDING_UNIFORM_SCALAR
+#undef GLUF_RECORDING_UNIFORM_VECTOR
+#undef GLUF_RECORDING_UNIFORM_MATRIX
+
+    //--------------------------------------------------------------------------------------
+    template<typename Proc>
+    void Install(Proc& entry, Proc stub)
+    {
+        Proc original = entry;
+        g_Restore.push_back([&entry, original]() { entry = original; });
+        entry = stub;
+    }
+
+    //--------------------------------------------------------------------------------------
+    void InstallAll()
+    {
+#define GLUF_RECORDING_INSTALL(name) Install(glad_gl##name, &name)
+#define GLUF_RECORDING_INSTALL_UNIFORM(suffix) GLUF_RECORDING_INSTALL(Uniform##suffix); GLUF_RECORDING_INSTALL(ProgramUniform##suffix)
+
+        GLUF_RECORDING_INSTALL(GetString);
+        GLUF_RECORDING_INSTALL(GetStringi);
+        GLUF_RECORDING_INSTALL(GetIntegerv);
+        GLUF_RECORDING_INSTALL(GetFloatv);
+        GLUF_RECORDING_INSTALL(GetError);
+        GLUF_RECORDING_INSTALL(Enable);
+        GLUF_RECORDING_INSTALL(Disable);
+        GLUF_RECORDING_INSTALL(BlendFunc);
+        GLUF_RECORDING_INSTALL(BlendFuncSeparate);
+        GLUF_RECORDING_INSTALL(BlendEquation);
+        GLUF_RECORDING_INSTALL(DepthFunc);
+        GLUF_RECORDING_INSTALL(DepthMask);
+        GLUF_RECORDING_INSTALL(ColorMask);
+        GLUF_RECORDING_INSTALL(CullFace);
+        GLUF_RECORDING_INSTALL(Viewport);
+        GLUF_RECORDING_INSTALL(Scissor);
+        GLUF_RECORDING_INSTALL(Clear);
+        GLUF_RECORDING_INSTALL(ClearColor);
+        GLUF_RECORDING_INSTALL(ClearDepth);
+        GLUF_RECORDING_INSTALL(Finish);
+        GLUF_RECORDING_INSTALL(Flush);
+        GLUF_RECORDING_INSTALL(PixelStorei);
+        GLUF_RECORDING_INSTALL(ReadPixels);
+
+        GLUF_RECORDING_INSTALL(GenBuffers);
+        GLUF_RECORDING_INSTALL(DeleteBuffers);
+        GLUF_RECORDING_INSTALL(BindBuffer);
+        GLUF_RECORDING_INSTALL(BufferData);
+        GLUF_RECORDING_INSTALL(BufferSubData);
+        GLUF_RECORDING_INSTALL(CopyBufferSubData);
+        GLUF_RECORDING_INSTALL(MapBuffer);
+        GLUF_RECORDING_INSTALL(UnmapBuffer);
+        GLUF_RECORDING_INSTALL(BufferStorage);
+        GLUF_RECORDING_INSTALL(MapBufferRange);
+        GLUF_RECORDING_INSTALL(FlushMappedBufferRange);
+        GLUF_RECORDING_INSTALL(BindBufferRange);
+        GLUF_RECORDING_INSTALL(BindBufferBase);
+        GLUF_RECORDING_INSTALL(FenceSync);
+        GLUF_RECORDING_INSTALL(ClientWaitSync);
+        GLUF_RECORDING_INSTALL(DeleteSync);
+
+        GLUF_RECORDING_INSTALL(GenVertexArrays);
+        GLUF_RECORDING_INSTALL(DeleteVertexArrays);
+        GLUF_RECORDING_INSTALL(BindVertexArray);
+        GLUF_RECORDING_INSTALL(EnableVertexAttribArray);
+        GLUF_RECORDING_INSTALL(DisableVertexAttribArray);
+        GLUF_RECORDING_INSTALL(VertexAttribPointer);
+        GLUF_RECORDING_INSTALL(DrawArrays);
+        GLUF_RECORDING_INSTALL(DrawElements);
+        GLUF_RECORDING_INSTALL(DrawArraysInstanced);
+        GLUF_RECORDING_INSTALL(DrawElementsInstanced);
+
+        GLUF_RECORDING_INSTALL(GenTextures);
+        GLUF_RECORDING_INSTALL(DeleteTextures);
+        GLUF_RECORDING_INSTALL(ActiveTexture);
+        GLUF_RECORDING_INSTALL(BindTexture);
+        GLUF_RECORDING_INSTALL(BindSampler);
+        GLUF_RECORDING_INSTALL(TexImage2D);
+        GLUF_RECORDING_INSTALL(TexSubImage2D);
+        GLUF_RECORDING_INSTALL(CompressedTexImage2D);
+        GLUF_RECORDING_INSTALL(CompressedTexSubImage2D);
+        GLUF_RECORDING_INSTALL(TexImage3D);
+        GLUF_RECORDING_INSTALL(TexSubImage3D);
+        GLUF_RECORDING_INSTALL(CompressedTexImage3D);
+        GLUF_RECORDING_INSTALL(CompressedTexSubImage3D);
+        GLUF_RECORDING_INSTALL(TexStorage2D);
+        GLUF_RECORDING_INSTALL(TexStorage3D);
+        GLUF_RECORDING_INSTALL(GenerateMipmap);
+        GLUF_RECORDING_INSTALL(TexParameteri);
+        GLUF_RECORDING_INSTALL(TexParameterf);
+        GLUF_RECORDING_INSTALL(TexParameterfv);
+        GLUF_RECORDING_INSTALL(GetTexParameteriv);
+        GLUF_RECORDING_INSTALL(GetTexLevelParameteriv);
+
+        GLUF_RECORDING_INSTALL(GenFramebuffers);
+        GLUF_RECORDING_INSTALL(DeleteFramebuffers);
+        GLUF_RECORDING_INSTALL(BindFramebuffer);
+        GLUF_RECORDING_INSTALL(CheckFramebufferStatus);
+        GLUF_RECORDING_INSTALL(FramebufferTexture2D);
+        GLUF_RECORDING_INSTALL(FramebufferRenderbuffer);
+        GLUF_RECORDING_INSTALL(GenRenderbuffers);
+        GLUF_RECORDING_INSTALL(DeleteRenderbuffers);
+        GLUF_RECORDING_INSTALL(BindRenderbuffer);
+        GLUF_RECORDING_INSTALL(RenderbufferStorage);
+
+        GLUF_RECORDING_INSTALL(GenQueries);
+        GLUF_RECORDING_INSTALL(DeleteQueries);
+        GLUF_RECORDING_INSTALL(QueryCounter);
+        GLUF_RECORDING_INSTALL(GetQueryObjectuiv);
+        GLUF_RECORDING_INSTALL(GetQueryObjectui64v);
+
+        GLUF_RECORDING_INSTALL(CreateShader);
+        GLUF_RECORDING_INSTALL(DeleteShader);
+        GLUF_RECORDING_INSTALL(ShaderSource);
+        GLUF_RECORDING_INSTALL(CompileShader);
+        GLUF_RECORDING_INSTALL(GetShaderiv);
+        GLUF_RECORDING_INSTALL(GetShaderInfoLog);
+        GLUF_RECORDING_INSTALL(CreateProgram);
+        GLUF_RECORDING_INSTALL(DeleteProgram);
+        GLUF_RECORDING_INSTALL(AttachShader);
+        GLUF_RECORDING_INSTALL(DetachShader);
+        GLUF_RECORDING_INSTALL(MaxShaderCompilerThreadsARB);
+        GLUF_RECORDING_INSTALL(ProgramParameteri);
+        GLUF_RECORDING_INSTALL(LinkProgram);
+        GLUF_RECORDING_INSTALL(GetProgramBinary);
+        GLUF_RECORDING_INSTALL(ProgramBinary);
+        GLUF_RECORDING_INSTALL(GetProgramiv);
+        GLUF_RECORDING_INSTALL(GetProgramInfoLog);
+        GLUF_RECORDING_INSTALL(GetActiveAttrib);
+        GLUF_RECORDING_INSTALL(GetActiveUniform);
+        GLUF_RECORDING_INSTALL(GetAttribLocation);
+        GLUF_RECORDING_INSTALL(GetUniformLocation);
+        GLUF_RECORDING_INSTALL(GetUniformBlockIndex);
+        GLUF_RECORDING_INSTALL(GetActiveUniformBlockName);
+        GLUF_RECORDING_INSTALL(GetActiveUniformBlockiv);
+        GLUF_RECORDING_INSTALL(GetActiveUniformsiv);
+        GLUF_RECORDING_INSTALL(UniformBlockBinding);
+        GLUF_RECORDING_INSTALL(UseProgram);
+        GLUF_RECORDING_INSTALL(GenProgramPipelines);
+        GLUF_RECORDING_INSTALL(DeleteProgramPipelines);
+        GLUF_RECORDING_INSTALL(BindProgramPipeline);
+        GLUF_RECORDING_INSTALL(UseProgramStages);
+        GLUF_RECORDING_INSTALL(ActiveShaderProgram);
+
+        GLUF_RECORDING_INSTALL_UNIFORM(1f);
+        GLUF_RECORDING_INSTALL_UNIFORM(1i);
+        GLUF_RECORDING_INSTALL_UNIFORM(1ui);
+        GLUF_RECORDING_INSTALL_UNIFORM(1fv);
+        GLUF_RECORDING_INSTALL_UNIFORM(1iv);
+        GLUF_RECORDING_INSTALL_UNIFORM(1uiv);
+        GLUF_RECORDING_INSTALL_UNIFORM(2fv);
+        GLUF_RECORDING_INSTALL_UNIFORM(3fv);
+        GLUF_RECORDING_INSTALL_UNIFORM(4fv);
+        GLUF_RECORDING_INSTALL_UNIFORM(2iv);
+        GLUF_RECORDING_INSTALL_UNIFORM(3iv);
+        GLUF_RECORDING_INSTALL_UNIFORM(4iv);
+        GLUF_RECORDING_INSTALL_UNIFORM(2uiv);
+        GLUF_RECORDING_INSTALL_UNIFORM(3uiv);
+        GLUF_RECORDING_INSTALL_UNIFORM(4uiv);
+        GLUF_RECORDING_INSTALL_UNIFORM(Matrix2fv);
+        GLUF_RECORDING_INSTALL_UNIFORM(Matrix3fv);
+        GLUF_RECORDING_INSTALL_UNIFORM(Matrix4fv);
+        GLUF_RECORDING_INSTALL_UNIFORM(Matrix2x3fv);
+        GLUF_RECORDING_INSTALL_UNIFORM(Matrix2x4fv);
+        GLUF_RECORDING_INSTALL_UNIFORM(Matrix3x2fv);
+        GLUF_RECORDING_INSTALL_UNIFORM(Matrix3x4fv);
+        GLUF_RECORDING_INSTALL_UNIFORM(Matrix4x2fv);
+        GLUF_RECORDING_INSTALL_UNIFORM(Matrix4x3fv);
+
+#undef GLUF_RECORDING_INSTALL_UNIFORM
+#undef GLUF_RECORDING_INSTALL
+    }
+}
+
+//--------------------------------------------------------------------------------------
+bool InstallRecordingBackend(GLuint glVersion2Digit, bool logCommands)
+{
+    using namespace Recording;
+
+    if (g_Installed)
+    {
+        GLUF_ERROR("InstallRecordingBackend: Already installed");
+        return false;
+    }
+
+    if (glVersion2Digit < 21)
+    {
+        GLUF_ERROR("InstallRecordingBackend: OpenGL Version To Low!");
+        return false;
+    }
+
+    //the counting layer has to wrap the stubs, not the other way around
+    bool counting = IsGLCallCountingEnabled();
+    SetGLCallCountingEnabled(false);
+
+    ResetState();
+    g_LogCommands = logCommands;
+
+    std::stringstream ss;
+    ss << glVersion2Digit / 10 << "." << glVersion2Digit % 10 << ".0 ObjGLUF Recording";
+    g_VersionString = ss.str();
+
+    g_ExtensionList = { "GL_ARB_buffer_storage", "GL_ARB_framebuffer_object", "GL_ARB_parallel_shader_compile", "GL_ARB_separate_shader_objects", "GL_ARB_timer_query",
+        "GL_ARB_vertex_array_object", "GL_EXT_texture_compression_s3tc", "GL_EXT_texture_filter_anisotropic" };
+    g_ExtensionString.clear();
+    for (const auto& it : g_ExtensionList)
+        g_ExtensionString += it + " ";
+
+    InstallAll();
+    g_Installed = true;
+
+    bool ret = InitContextInfo();
+
+    ClearRecordedGLCalls();//the setup queries are not part of the stream
+
+    SetGLCallCountingEnabled(counting);
+    return ret;
+}
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::DeleteShader(ShaderPtr& shader) noexcept
+void UninstallRecordingBackend()
 {
-    //make sure it exists
-    if (shader)
-        shader->Destroy();
+    using namespace Recording;
+
+    if (!g_Installed)
+        return;
+
+    bool counting = IsGLCallCountingEnabled();
+    SetGLCallCountingEnabled(false);
+
+    for (auto it = g_Restore.rbegin(); it != g_Restore.rend(); ++it)
+        (*it)();
+    g_Restore.clear();
+
+    ResetState();
+    g_Installed = false;
+
+    //the shadowed state belonged to the recording backend
+    GLSTATE.Invalidate();
+
+    SetGLCallCountingEnabled(counting);
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::DeleteProgram(ProgramPtr& program) noexcept
+bool IsRecordingBackendInstalled()
 {
-    //make sure it exists
-    if (program)
-        program->Destroy();
+    return Recording::g_Installed;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::FlushLogs() 
+const std::vector<RecordedGLCall>& GetRecordedGLCalls()
 {
-    mLinklogs.clear();
-    mCompileLogs.clear();
+    return Recording::g_Calls;
 }
 
-
-//for accessing things
-
 //--------------------------------------------------------------------------------------
-const GLuint ShaderManager::GetShaderId(const ShaderPtr& shader) const
+RecordingStats GetRecordingStats()
 {
-    GLUF_NULLPTR_CHECK(shader);
+    using namespace Recording;
 
-    return shader->mShaderId;
-}
+    RecordingStats ret;
+    ret.mCalls = g_Counters;
+    ret.mCommandCount = g_CommandCount;
 
+    ret.mLiveBuffers = static_cast<unsigned int>(g_Buffers.size());
+    ret.mLiveTextures = static_cast<unsigned int>(g_Textures.size());
+    ret.mLiveShaders = static_cast<unsigned int>(g_Shaders.size());
+    ret.mLivePrograms = static_cast<unsigned int>(g_Programs.size());
+    ret.mLiveVertexArrays = static_cast<unsigned int>(g_VertexArrays.size());
+    ret.mLiveFramebuffers = static_cast<unsigned int>(g_Framebuffers.size());
 
-//--------------------------------------------------------------------------------------
-const ShaderType ShaderManager::GetShaderType(const ShaderPtr& shader) const
-{
-    GLUF_NULLPTR_CHECK(shader);
+    for (const auto& it : g_Buffers)
+        ret.mBufferMemory += it.second.mData.size();
+    for (const auto& it : g_Textures)
+        for (const auto& level : it.second.mLevels)
+            ret.mTextureMemory += level.second.mBytes;
 
-    return shader->mShaderType;
+    return ret;
 }
 
-
 //--------------------------------------------------------------------------------------
-const GLuint ShaderManager::GetProgramId(const ProgramPtr& program) const
+void ClearRecordedGLCalls()
 {
-    GLUF_NULLPTR_CHECK(program);
-
-    return program->mProgramId;
+    Recording::g_Calls.clear();
+    Recording::g_CommandCount = 0;
+    Recording::g_Counters = GLCallCounters();
 }
 
 //--------------------------------------------------------------------------------------
-const CompileOutputStruct ShaderManager::GetShaderLog(const ShaderPtr& shaderPtr) const
+void WriteRecordedGLCalls(std::ostream& stream)
 {
-    GLUF_NULLPTR_CHECK(shaderPtr);
-    _TSAFE_SCOPE(mCompLogMutex);
+    for (const auto& it : Recording::g_Calls)
+    {
+        stream << it.mFunction << "(";
+        for (std::size_t i = 0; i < it.mArgs.size(); ++i)
+            stream << (i == 0 ? "" : ", ") << it.mArgs[i];
+        stream << ")";
 
-    return mCompileLogs.find(shaderPtr)->second;
+        if (it.mBytes != 0)
+            stream << " [" << it.mBytes << " bytes]";
+        stream << "\n";
+    }
 }
 
 
-//--------------------------------------------------------------------------------------
-const LinkOutputStruct ShaderManager::GetProgramLog(const ProgramPtr& programPtr) const
-{
-    GLUF_NULLPTR_CHECK(programPtr);
-    _TSAFE_SCOPE(mLinkLogMutex);
-
-    return mLinklogs.find(programPtr)->second;
-}
+/*
+======================================================================================================================================================================================================
+IO and Stream Utilities
 
-//for using things
+*/
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::UseProgram(const ProgramPtr& program) const
+void LoadFileIntoMemory(const std::string& path, std::string& textMemory)
 {
-    GLUF_NULLPTR_CHECK(program);
-
-    //binding a null program means the program is uninitialized or broken, which is an error
-    if (program->GetId() == 0)
-        GLUF_NON_CRITICAL_EXCEPTION(UseProgramException());
-
-    //make sure this is not bound when using a program
-    glBindProgramPipeline(0);
-
-    glUseProgram(program->mProgramId);
-}
+    MappedFile file;
+    try
+    {
+        file.Open(path);
+    }
+    catch (const std::ios_base::failure& e)
+    {
+        GLUF_ERROR_LONG("Failed to Open File: " << e.what());
+        RETHROW;
+    }
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::UseProgramNull() const noexcept
-{
-    glUseProgram(0);
-    glBindProgramPipeline(0);//juse in case we are using pipelines
+    textMemory.assign(file.data(), file.size());
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::CreateSeparateProgram(SepProgramPtr& ppo, const ProgramPtrList& programs) const
+void LoadFileIntoMemory(const std::string& path, std::vector<char>& binMemory)
 {
-    ppo = std::make_shared<SeparateProgram>();
-
+    MappedFile file;
     try
     {
-        //initialize the PPO
-        ppo->Init();
-
-        for (auto it : programs)
-        {
-            GLUF_NULLPTR_CHECK(it);
-            if (it->GetId() == 0)
-                GLUF_CRITICAL_EXCEPTION(std::invalid_argument("Uninitialized Program Attempted to be Added to a PPO"));
-
-            ppo->AttachProgram(it);
-        }
-    }
-    catch (const CreateGLPPOException& e)
-    {
-        GLUF_ERROR_LONG("(ShaderManager): " << e.what());
-        GLUF_CRITICAL_EXCEPTION(MakePPOException());
+        file.Open(path);
     }
-    catch (const std::invalid_argument& e)
+    catch (const std::ios_base::failure& e)
     {
-        GLUF_ERROR_LONG("(ShaderManager): " << e.what());
+        GLUF_ERROR_LONG("Failed to Open File: " << e.what());
         RETHROW;
     }
+
+    binMemory.assign(file.data(), file.data() + file.size());
 }
 
 //--------------------------------------------------------------------------------------
-const GLuint ShaderManager::GetShaderVariableLocation(const ProgramPtr& program, LocationType locType, const std::string& varName) const
+void LoadBinaryArrayIntoString(char* rawMemory, std::size_t size, std::string& outString)
 {
-    GLUF_NULLPTR_CHECK(program);
-
-    VariableLocMap::iterator it;
-
-    if (locType == GLT_ATTRIB)
+    if (rawMemory == nullptr)
     {
-        it = program->mAttributeLocations.find(varName);
+        GLUF_ERROR("Cannot Load Null Ptr Into String!");
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("Cannot Load Null Ptr Into String!"));
+    }
+    
+    //for automatic deletion if exception thrown
+    auto streamBuf = std::make_shared<MemStreamBuf>(rawMemory, size);
+   
+    std::istream indata(streamBuf.get());
+    indata.exceptions(std::ifstream::badbit);
+    char ch = ' ';
 
-        if (it == program->mAttributeLocations.end())
-        {
-            GLUF_NON_CRITICAL_EXCEPTION(std::invalid_argument("\"varName\" Could not be found when searching program attributes!"));
-            return 0;
-        }
+    try
+    {
+        while (indata.get(ch))
+            outString += ch;
     }
-    else
+    catch (std::ios_base::failure e)
     {
-        it = program->mUniformLocations.find(varName);
-
-        if (it == program->mUniformLocations.end())
-        {
-            GLUF_NON_CRITICAL_EXCEPTION(std::invalid_argument("\"varName\" Could not be found when searching program uniforms!"));
-            return 0;
-        }
+        outString.clear();
+        GLUF_ERROR_LONG("Failed to load binary array into string: " << e.what());
+        RETHROW;
     }
+}
 
-    return it->second;
+
+//--------------------------------------------------------------------------------------
+void LoadBinaryArrayIntoString(const std::vector<char>& rawMemory, std::string& outString)
+{
+    //const cast is OK to use here, because we know 'rawMemory' will not be modified
+    LoadBinaryArrayIntoString(const_cast<char*>(&rawMemory[0]), rawMemory.size(), outString);
 }
 
 //--------------------------------------------------------------------------------------
-const VariableLocMap& ShaderManager::GetShaderAttribLocations(const ProgramPtr& program) const
+MappedFile::MappedFile(const std::string& path)
 {
-    GLUF_NULLPTR_CHECK(program);
-    return program->mAttributeLocations;
+    Open(path);
 }
 
 //--------------------------------------------------------------------------------------
-const VariableLocMap& ShaderManager::GetShaderUniformLocations(const ProgramPtr& program) const
+MappedFile::~MappedFile() noexcept
 {
-    GLUF_NULLPTR_CHECK(program);
-    return program->mUniformLocations;
+    Close();
 }
 
 //--------------------------------------------------------------------------------------
-const VariableLocMap ShaderManager::GetShaderAttribLocations(const SepProgramPtr& program) const
+MappedFile::MappedFile(MappedFile&& other) noexcept
 {
-    GLUF_NULLPTR_CHECK(program);
-    VariableLocMap ret;
+    *this = std::move(other);
+}
 
-    for (auto it : program->mPrograms)
+//--------------------------------------------------------------------------------------
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
     {
-        ret.insert(it->mAttributeLocations.begin(), it->mAttributeLocations.end());
-    }
+        Close();
 
-    return ret;
+        mData = other.mData;
+        mSize = other.mSize;
+        mOpen = other.mOpen;
+#ifdef _WIN32
+        mFileHandle = other.mFileHandle;
+        mMappingHandle = other.mMappingHandle;
+        other.mFileHandle = nullptr;
+        other.mMappingHandle = nullptr;
+#endif
+        other.mData = nullptr;
+        other.mSize = 0;
+        other.mOpen = false;
+    }
+    return *this;
 }
 
 //--------------------------------------------------------------------------------------
-const VariableLocMap ShaderManager::GetShaderUniformLocations(const SepProgramPtr& program) const
+void MappedFile::Open(const std::string& path)
 {
-    GLUF_NULLPTR_CHECK(program);
+    Close();
 
-    VariableLocMap ret;
+#ifdef _WIN32
 
-    for (auto it : program->mPrograms)
+    //paths are utf8, so widen them for the W api
+    int wideLen = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+    std::wstring widePath(wideLen > 0 ? wideLen : 0, L'\0');
+    if (wideLen > 0)
+        MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &widePath[0], wideLen);
+
+    HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
     {
-        ret.insert(it->mUniformLocations.begin(), it->mUniformLocations.end());
+        GLUF_CRITICAL_EXCEPTION(std::ios_base::failure("(MappedFile): Failed to Open \"" + path + "\""));
     }
 
-    return ret;
-}
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize))
+    {
+        CloseHandle(file);
+        GLUF_CRITICAL_EXCEPTION(std::ios_base::failure("(MappedFile): Failed to Get Size of \"" + path + "\""));
+    }
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::AttachProgram(SepProgramPtr& ppo, const ProgramPtr& program) const
-{
-    GLUF_NULLPTR_CHECK(ppo);
-    GLUF_NULLPTR_CHECK(program);
+    mFileHandle = file;
+    mSize = static_cast<std::size_t>(fileSize.QuadPart);
+    mOpen = true;
 
-    if (program->GetId() == 0)
-        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("Uninitialized Program Attempted to be Added to a PPO"));
+    //zero length files cannot be mapped, but they are still valid files
+    if (mSize == 0)
+        return;
 
-    ppo->AttachProgram(program);
-}
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        Close();
+        GLUF_CRITICAL_EXCEPTION(std::ios_base::failure("(MappedFile): Failed to Map \"" + path + "\""));
+    }
+    mMappingHandle = mapping;
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::AttachPrograms(SepProgramPtr& ppo, const ProgramPtrList& programs) const
-{
-    GLUF_NULLPTR_CHECK(ppo);
+    mData = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (mData == nullptr)
+    {
+        Close();
+        GLUF_CRITICAL_EXCEPTION(std::ios_base::failure("(MappedFile): Failed to Map \"" + path + "\""));
+    }
 
-    for (auto it : programs)
+#else
+
+    int file = open(path.c_str(), O_RDONLY);
+    if (file == -1)
     {
-        GLUF_NULLPTR_CHECK(it);
-        if (it->GetId() == 0)
-            GLUF_CRITICAL_EXCEPTION(std::invalid_argument("Uninitialized Program Attempted to be Added to a PPO"));
+        GLUF_CRITICAL_EXCEPTION(std::ios_base::failure("(MappedFile): Failed to Open \"" + path + "\""));
+    }
 
-        ppo->AttachProgram(it);
+    struct stat fileStat;
+    if (fstat(file, &fileStat) == -1)
+    {
+        close(file);
+        GLUF_CRITICAL_EXCEPTION(std::ios_base::failure("(MappedFile): Failed to Get Size of \"" + path + "\""));
     }
-}
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::ClearPrograms(SepProgramPtr& ppo, GLbitfield stages) const
-{
-    GLUF_NULLPTR_CHECK(ppo);
-    ppo->ClearStages(stages);
+    mSize = static_cast<std::size_t>(fileStat.st_size);
+    mOpen = true;
+
+    //zero length files cannot be mapped, but they are still valid files
+    if (mSize == 0)
+    {
+        close(file);
+        return;
+    }
+
+    void* data = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, file, 0);
+
+    //the mapping holds its own reference to the file
+    close(file);
+
+    if (data == MAP_FAILED)
+    {
+        mSize = 0;
+        mOpen = false;
+        GLUF_CRITICAL_EXCEPTION(std::ios_base::failure("(MappedFile): Failed to Map \"" + path + "\""));
+    }
+
+    //most loaders walk the file front to back once
+    madvise(data, mSize, MADV_SEQUENTIAL);
+
+    mData = static_cast<const char*>(data);
+
+#endif
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::UseProgram(const SepProgramPtr& ppo) const
+void MappedFile::Close() noexcept
 {
-    GLUF_NULLPTR_CHECK(ppo);
-    glUseProgram(0);
-    glBindProgramPipeline(ppo->GetId());
+#ifdef _WIN32
+
+    if (mData != nullptr)
+        UnmapViewOfFile(mData);
+    if (mMappingHandle != nullptr)
+        CloseHandle(mMappingHandle);
+    if (mFileHandle != nullptr)
+        CloseHandle(mFileHandle);
+
+    mMappingHandle = nullptr;
+    mFileHandle = nullptr;
+
+#else
+
+    if (mData != nullptr)
+        munmap(const_cast<char*>(mData), mSize);
+
+#endif
+
+    mData = nullptr;
+    mSize = 0;
+    mOpen = false;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLActiveShaderProgram(SepProgramPtr& ppo, ShaderType stage) const
+MappedFilePtr MapFile(const std::string& path)
 {
-    GLUF_NULLPTR_CHECK(ppo);
-    ppo->SetActiveShaderProgram(ShaderTypeToProgramStage(stage));
+    return std::make_shared<MappedFile>(path);
 }
 
+
 /*
+======================================================================================================================================================================================================
+Misc.  Classes
 
-GLUniform*
 
 */
 
+glm::mat4 MatrixStack::mIdentity = glm::mat4();
 
-/*
-
-float's
-
-*/
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLUniform1f(GLuint loc, const GLfloat& value) const noexcept
+void MatrixStack::Push(const glm::mat4& matrix)
 {
-    glUniform1f(loc, value);
-}
+    if (mStack.size() != 0)
+    {
+        //if there are already things on the stack, instead of multiplying through EVERY TIME TOP IS CALLED, make it more efficient 
+        //so the top is ALWAYS a concatenation
+        glm::mat4 transformed = matrix * Top();
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::GLUniform2f(GLuint loc, const glm::vec2& value) const noexcept
-{
-    glUniform2fv(loc, 1, &value[0]);
+        mStack.push(transformed);
+    }
+    else
+    {
+        mStack.push(matrix);
+    }
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLUniform3f(GLuint loc, const glm::vec3& value) const noexcept
+void MatrixStack::Pop(void)
 {
-    glUniform3fv(loc, 1, &value[0]);
+    mStack.pop();
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLUniform4f(GLuint loc, const glm::vec4& value) const noexcept
+const glm::mat4& MatrixStack::Top(void) const
 {
-    glUniform4fv(loc, 1, &value[0]);
-}
+    //if it is empty, then we want to return the identity
+    if (mStack.size() == 0)
+        return mIdentity;
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::GLUniform1f(const ProgramPtr& prog, const std::string& name, const GLfloat& value) const 
-{    
-    glUniform1f(GetUniformIdFromName(prog, name), value);
+    return mStack.top();
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLUniform2f(const ProgramPtr& prog, const std::string& name, const glm::vec2& value) const 
+size_t MatrixStack::Size(void) const
 {
-    glUniform2fv(GetUniformIdFromName(prog, name), 1, &value[0]);
+    return mStack.size();
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLUniform3f(const ProgramPtr& prog, const std::string& name, const glm::vec3& value) const
+bool MatrixStack::Empty(void) const
 {
-    glUniform3fv(GetUniformIdFromName(prog, name), 1, &value[0]);
+    return mStack.empty();
 }
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::GLUniform4f(const ProgramPtr& prog, const std::string& name, const glm::vec4& value) const 
-{
-    glUniform4fv(GetUniformIdFromName(prog, name), 1, &value[0]);
-}
 
 /*
-
-int's
+======================================================================================================================================================================================================
+OpenGL Basic Data Structures and Operators
 
 */
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLUniform1i(GLuint loc, const GLint& value) const noexcept
+bool PtInRect(const Rect& rect, const Point& pt)
 {
-    glUniform1i(loc, value);
+    //for the first comparison, it is impossible for both statements to be false, 
+    //because if the y is greater than the top, it is automatically greater than the bottom, and vise versa
+    return    (pt.y >= rect.bottom && pt.y <= rect.top) &&
+        (pt.x <= rect.right && pt.x >= rect.left);
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLUniform2i(GLuint loc, const glm::i32vec2& value) const noexcept
+void SetRectEmpty(Rect& rect)
 {
-    glUniform2iv(loc, 1, &value[0]);
+    rect.top = rect.bottom = rect.left = rect.right = 0;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLUniform3i(GLuint loc, const glm::i32vec3& value) const noexcept
+void SetRect(Rect& rect, long left, long top, long right, long bottom)
 {
-    glUniform3iv(loc, 1, &value[0]);
+    rect.top = top;
+    rect.bottom = bottom;
+    rect.left = left;
+    rect.right = right;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLUniform4i(GLuint loc, const glm::i32vec4& value) const noexcept
+void SetRect(Rectf& rect, float left, float top, float right, float bottom)
 {
-    glUniform4iv(loc, 1, &value[0]);
+    rect.top = top;
+    rect.bottom = bottom;
+    rect.left = left;
+    rect.right = right;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLUniform1i(const ProgramPtr& prog, const std::string& name, const GLint& value) const 
+void OffsetRect(Rect& rect, long x, long y)
 {
-    glUniform1i(GetUniformIdFromName(prog, name), value);
+    rect.top += y;
+    rect.bottom += y;
+    rect.left += x;
+    rect.right += x;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLUniform2i(const ProgramPtr& prog, const std::string& name, const glm::i32vec2& value) const 
+void RepositionRect(Rect& rect, long newX, long newY)
 {
-    glUniform2iv(GetUniformIdFromName(prog, name), 1, &value[0]);
+    long deltaX = newX - rect.left;
+    long deltaY = newY - rect.bottom;
+
+    rect.left = newX; 
+    rect.right += deltaX;
+    rect.bottom = newY;
+    rect.top += deltaY;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLUniform3i(const ProgramPtr& prog, const std::string& name, const glm::i32vec3& value) const
+long RectHeight(const Rect& rect)
 {
-    glUniform3iv(GetUniformIdFromName(prog, name), 1, &value[0]);
+    return rect.top - rect.bottom;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLUniform4i(const ProgramPtr& prog, const std::string& name, const glm::i32vec4& value) const 
+long RectWidth(const Rect& rect)
 {
-    glUniform4iv(GetUniformIdFromName(prog, name), 1, &value[0]);
+    return rect.right - rect.left;
 }
 
 
-/*
-
-uint's
-
-*/
-
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLUniform1ui(GLuint loc, const GLuint& value) const noexcept
+void InflateRect(Rect& rect, long dx, long dy)
 {
-    glUniform1ui(loc, value);
-}
+    long dx2 = dx / 2;
+    long dy2 = dy / 2;
+    rect.left -= dx2;
+    rect.right += dx2;//remember to have opposites
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::GLUniform2ui(GLuint loc, const glm::u32vec2& value) const noexcept
-{
-    glUniform2uiv(loc, 1, &value[0]);
+    rect.top += dy2;
+    rect.bottom -= dy2;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLUniform3ui(GLuint loc, const glm::u32vec3& value) const noexcept
+void ResizeRect(Rect& rect, long newWidth, long newHeight)
 {
-    glUniform3uiv(loc, 1, &value[0]);
+    rect.top = rect.bottom + newHeight;
+    rect.right = rect.left + newWidth;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLUniform4ui(GLuint loc, const glm::u32vec4& value) const noexcept
+bool IntersectRect(const Rect& rect0, const Rect& rect1, Rect& rectIntersect)
 {
-    glUniform4uiv(loc, 1, &value[0]);
-}
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::GLUniform1ui(const ProgramPtr& prog, const std::string& name, const GLuint& value) const 
-{
-    glUniform1ui(GetUniformIdFromName(prog, name), value);
-}
+    //Left
+    if (rect0.left > rect1.left)
+    {
+        rectIntersect.left = rect0.left;
+    }
+    else
+    {
+        rectIntersect.left = rect1.left;
+    }
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::GLUniform2ui(const ProgramPtr& prog, const std::string& name, const glm::u32vec2& value) const 
-{
-    glUniform2uiv(GetUniformIdFromName(prog, name), 1, &value[0]);
-}
+    //Right
+    if (rect0.right < rect1.right)
+    {
+        rectIntersect.right = rect0.right;
+    }
+    else
+    {
+        rectIntersect.right = rect1.right;
+    }
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::GLUniform3ui(const ProgramPtr& prog, const std::string& name, const glm::u32vec3& value) const
-{
-    glUniform3uiv(GetUniformIdFromName(prog, name), 1, &value[0]);
-}
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::GLUniform4ui(const ProgramPtr& prog, const std::string& name, const glm::u32vec4& value) const
-{
-    glUniform4uiv(GetUniformIdFromName(prog, name), 1, &value[0]);
+    //Top
+    if (rect0.top < rect1.top)
+    {
+        rectIntersect.top = rect0.top;
+    }
+    else
+    {
+        rectIntersect.top = rect1.top;
+    }
+
+    //Bottom
+    if (rect0.bottom > rect1.bottom)
+    {
+        rectIntersect.bottom = rect0.bottom;
+    }
+    else
+    {
+        rectIntersect.bottom = rect1.bottom;
+    }
+
+    //this will ONLY happen if the do NOT intersect
+    if (rectIntersect.left > rectIntersect.right || rectIntersect.top < rectIntersect.bottom)
+    {
+        SetRectEmpty(rectIntersect);
+        return false;
+    }
+
+    return true;
 }
 
-/*
 
-matrices
+/*
+======================================================================================================================================================================================================
+Asset Archives
 
 */
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLUniformMatrix2f(GLuint loc, const glm::mat2& value) const noexcept
+std::string NormalizeAssetName(const std::string& name)
 {
-    glUniformMatrix2fv(loc, 1, 0, &value[0][0]);
-}
+    std::string ret = name;
+    std::replace(ret.begin(), ret.end(), '\\', '/');
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::GLUniformMatrix3f(GLuint loc, const glm::mat3& value) const noexcept
-{
-    glUniformMatrix3fv(loc, 1, 0, &value[0][0]);
-}
+    while (true)
+    {
+        if (ret.compare(0, 2, "./") == 0)
+            ret.erase(0, 2);
+        else if (!ret.empty() && ret[0] == '/')
+            ret.erase(0, 1);
+        else
+            break;
+    }
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::GLUniformMatrix4f(GLuint loc, const glm::mat4& value) const noexcept
-{
-    glUniformMatrix4fv(loc, 1, 0, &value[0][0]);
+    return ret;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLUniformMatrix2x3f(GLuint loc, const glm::mat2x3& value) const noexcept
+AssetArchive::AssetArchive(const std::string& path)
 {
-    glUniformMatrix2x3fv(loc, 1, 0, &value[0][0]);
+    Open(path);
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLUniformMatrix3x2f(GLuint loc, const glm::mat3x2& value) const noexcept
+void AssetArchive::Open(const std::string& path)
 {
-    glUniformMatrix3x2fv(loc, 1, 0, &value[0][0]);
-}
+    Close();
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::GLUniformMatrix2x4f(GLuint loc, const glm::mat2x4& value) const noexcept
-{
-    glUniformMatrix2x4fv(loc, 1, 0, &value[0][0]);
-}
+    MappedFilePtr file;
+    try
+    {
+        file = MapFile(path);
+    }
+    catch (const std::ios_base::failure& e)
+    {
+        GLUF_ERROR_LONG("(AssetArchive): " << e.what());
+        RETHROW;
+    }
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::GLUniformMatrix4x2f(GLuint loc, const glm::mat4x2& value) const noexcept
-{
-    glUniformMatrix4x2fv(loc, 1, 0, &value[0][0]);
-}
+    //validate everything up front, so lookups never have to
+    MemorySpan data = file->GetView();
+    if (data.size() < sizeof(ArchiveHeader))
+    {
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(AssetArchive): File Too Small For Header!"));
+    }
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::GLUniformMatrix3x4f(GLuint loc, const glm::mat3x4& value) const noexcept
-{
-    glUniformMatrix3x4fv(loc, 1, 0, &value[0][0]);
-}
+    ArchiveHeader header;
+    std::memcpy(&header, data.data(), sizeof(ArchiveHeader));
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::GLUniformMatrix4x3f(GLuint loc, const glm::mat4x3& value) const noexcept
-{
-    //warning here can be IGNORED
-    glUniformMatrix4x3fv(loc, 1, 0, &value[0][0]);
-}
+    if (std::memcmp(header.mMagic, GLUF_ARCHIVE_MAGIC, sizeof(header.mMagic)) != 0)
+    {
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(AssetArchive): Incorrect File Format!"));
+    }
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::GLUniformMatrix2f(const ProgramPtr& prog, const std::string& name, const glm::mat2& value) const
-{
-    glUniformMatrix2fv(GetUniformIdFromName(prog, name), 1, 0, &value[0][0]);
-}
+    if (header.mVersion != GLUF_ARCHIVE_VERSION)
+    {
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(AssetArchive): Unsupported Archive Version!"));
+    }
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::GLUniformMatrix3f(const ProgramPtr& prog, const std::string& name, const glm::mat3& value) const
-{
-    glUniformMatrix3fv(GetUniformIdFromName(prog, name), 1, 0, &value[0][0]);
+    uint64_t tocSize = static_cast<uint64_t>(header.mEntryCount) * sizeof(ArchiveEntry);
+    if (header.mTocOffset % alignof(ArchiveEntry) != 0 || header.mTocOffset > data.size() || tocSize > data.size() - header.mTocOffset)
+    {
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(AssetArchive): Table of Contents Out of Range!"));
+    }
+
+    if (header.mNamesOffset > data.size() || header.mNamesSize > data.size() - header.mNamesOffset)
+    {
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(AssetArchive): Name Table Out of Range!"));
+    }
+
+    const ArchiveEntry* entries = reinterpret_cast<const ArchiveEntry*>(data.data() + header.mTocOffset);
+    for (uint32_t i = 0; i < header.mEntryCount; ++i)
+    {
+        const ArchiveEntry& entry = entries[i];
+        if (entry.mOffset > data.size() || entry.mSize > data.size() - entry.mOffset ||
+            entry.mNameOffset > header.mNamesSize || entry.mNameLength > header.mNamesSize - entry.mNameOffset)
+        {
+            GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(AssetArchive): Entry Out of Range!"));
+        }
+
+        if (i > 0 && entries[i - 1].mNameHash > entry.mNameHash)
+        {
+            GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(AssetArchive): Table of Contents Not Sorted!"));
+        }
+    }
+
+    mFile = file;
+    mEntries = entries;
+    mEntryCount = header.mEntryCount;
+    mNames = data.data() + header.mNamesOffset;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLUniformMatrix4f(const ProgramPtr& prog, const std::string& name, const glm::mat4& value) const
+void AssetArchive::Close() noexcept
 {
-    glUniformMatrix4fv(GetUniformIdFromName(prog, name), 1, 0, &value[0][0]);
+    mFile = nullptr;
+    mEntries = nullptr;
+    mEntryCount = 0;
+    mNames = nullptr;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLUniformMatrix2x3f(const ProgramPtr& prog, const std::string& name, const glm::mat2x3& value) const
+const ArchiveEntry* AssetArchive::FindEntry(const std::string& name) const noexcept
 {
-    glUniformMatrix2x3fv(GetUniformIdFromName(prog, name), 1, 0, &value[0][0]);
+    if (mEntries == nullptr)
+        return nullptr;
+
+    std::string normalized = NormalizeAssetName(name);
+    uint64_t hash = HashBytesFNV1a(normalized.data(), normalized.size());
+
+    const ArchiveEntry* end = mEntries + mEntryCount;
+    const ArchiveEntry* it = std::lower_bound(mEntries, end, hash,
+        [](const ArchiveEntry& entry, uint64_t value) { return entry.mNameHash < value; });
+
+    //walk any hash collisions
+    for (; it != end && it->mNameHash == hash; ++it)
+    {
+        if (it->mNameLength == normalized.size() && std::memcmp(mNames + it->mNameOffset, normalized.data(), normalized.size()) == 0)
+            return it;
+    }
+
+    return nullptr;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLUniformMatrix3x2f(const ProgramPtr& prog, const std::string& name, const glm::mat3x2& value) const
+MemorySpan AssetArchive::GetAsset(const std::string& name) const
 {
-    glUniformMatrix3x2fv(GetUniformIdFromName(prog, name), 1, 0, &value[0][0]);
+    MemorySpan ret;
+    if (!TryGetAsset(name, ret))
+    {
+        GLUF_ERROR_LONG("(AssetArchive): Asset Not Found: \"" << name << "\"");
+        GLUF_CRITICAL_EXCEPTION(std::out_of_range("(AssetArchive): Asset Not Found"));
+    }
+
+    return ret;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLUniformMatrix2x4f(const ProgramPtr& prog, const std::string& name, const glm::mat2x4& value) const
+bool AssetArchive::TryGetAsset(const std::string& name, MemorySpan& outAsset) const noexcept
 {
-    glUniformMatrix2x4fv(GetUniformIdFromName(prog, name), 1, 0, &value[0][0]);
+    const ArchiveEntry* entry = FindEntry(name);
+    if (entry == nullptr)
+        return false;
+
+    outAsset = MemorySpan(mFile->data() + entry->mOffset, static_cast<std::size_t>(entry->mSize));
+    return true;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLUniformMatrix4x2f(const ProgramPtr& prog, const std::string& name, const glm::mat4x2& value) const
+bool AssetArchive::Contains(const std::string& name) const noexcept
 {
-    glUniformMatrix4x2fv(GetUniformIdFromName(prog, name), 1, 0, &value[0][0]);
+    return FindEntry(name) != nullptr;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLUniformMatrix3x4f(const ProgramPtr& prog, const std::string& name, const glm::mat3x4& value) const
+std::vector<std::string> AssetArchive::GetAssetNames() const
 {
-    glUniformMatrix3x4fv(GetUniformIdFromName(prog, name), 1, 0, &value[0][0]);
+    std::vector<std::string> ret;
+    ret.reserve(mEntryCount);
+    for (uint32_t i = 0; i < mEntryCount; ++i)
+    {
+        ret.emplace_back(mNames + mEntries[i].mNameOffset, mEntries[i].mNameLength);
+    }
+    return ret;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLUniformMatrix4x3f(const ProgramPtr& prog, const std::string& name, const glm::mat4x3& value) const
+void WriteAssetArchive(const std::string& archivePath, const AssetPathList& assets)
 {
-    glUniformMatrix4x3fv(GetUniformIdFromName(prog, name), 1, 0, &value[0][0]);
-}
+    struct PendingEntry
+    {
+        ArchiveEntry mEntry;
+        std::string mName;
+        std::string mPath;
+    };
 
+    //build the entries and name table
+    std::vector<PendingEntry> pending;
+    pending.reserve(assets.size());
+    std::map<std::string, std::string> usedNames;
+    for (auto it : assets)
+    {
+        PendingEntry entry = {};
+        entry.mName = NormalizeAssetName(it.first);
+        entry.mPath = it.second;
 
+        if (!usedNames.insert({ entry.mName, it.first }).second)
+        {
+            GLUF_ERROR_LONG("(WriteAssetArchive): Duplicate Asset Name: \"" << entry.mName << "\"");
+            GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(WriteAssetArchive): Duplicate Asset Name"));
+        }
 
+        entry.mEntry.mNameHash = HashBytesFNV1a(entry.mName.data(), entry.mName.size());
+        pending.push_back(entry);
+    }
 
+    std::sort(pending.begin(), pending.end(), [](const PendingEntry& a, const PendingEntry& b)
+    {
+        return a.mEntry.mNameHash < b.mEntry.mNameHash;
+    });
 
-/*
+    std::string names;
+    for (auto& it : pending)
+    {
+        it.mEntry.mNameOffset = static_cast<uint32_t>(names.size());
+        it.mEntry.mNameLength = static_cast<uint32_t>(it.mName.size());
+        names += it.mName;
+    }
 
-GLProgramUniform*
+    ArchiveHeader header = {};
+    std::memcpy(header.mMagic, GLUF_ARCHIVE_MAGIC, sizeof(header.mMagic));
+    header.mVersion = GLUF_ARCHIVE_VERSION;
+    header.mEntryCount = static_cast<uint32_t>(pending.size());
+    header.mTocOffset = sizeof(ArchiveHeader);
+    header.mNamesOffset = header.mTocOffset + pending.size() * sizeof(ArchiveEntry);
+    header.mNamesSize = names.size();
 
+    std::ofstream outFile;
+    outFile.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+    try
+    {
+        outFile.open(archivePath, std::ios::binary | std::ios::out | std::ios::trunc);
 
-*/
+        //lay out the payloads first, so the table of contents can be written in one go
+        uint64_t offset = header.mNamesOffset + header.mNamesSize;
+        std::vector<MappedFile> inputs(pending.size());
+        for (std::size_t i = 0; i < pending.size(); ++i)
+        {
+            inputs[i].Open(pending[i].mPath);
 
-//macro for easier readibility; the purpose of this line is to throw a 'NoActiveProgramUniformException' in debug mode 
-#ifdef _DEBUG
+            offset = ((offset + GLUF_ARCHIVE_ALIGNMENT - 1) / GLUF_ARCHIVE_ALIGNMENT) * GLUF_ARCHIVE_ALIGNMENT;
+            pending[i].mEntry.mOffset = offset;
+            pending[i].mEntry.mSize = inputs[i].size();
+            offset += inputs[i].size();
+        }
 
-#define HAS_ACTIVE_PROGRAM(ppo) ppo->GetActiveProgram();
+        outFile.write(reinterpret_cast<const char*>(&header), sizeof(ArchiveHeader));
+        for (auto& it : pending)
+            outFile.write(reinterpret_cast<const char*>(&it.mEntry), sizeof(ArchiveEntry));
+        outFile.write(names.data(), names.size());
 
-#else
+        std::vector<char> padding(GLUF_ARCHIVE_ALIGNMENT, 0);
+        uint64_t written = header.mNamesOffset + header.mNamesSize;
+        for (std::size_t i = 0; i < pending.size(); ++i)
+        {
+            outFile.write(padding.data(), static_cast<std::streamsize>(pending[i].mEntry.mOffset - written));
+            outFile.write(inputs[i].data(), static_cast<std::streamsize>(inputs[i].size()));
+            written = pending[i].mEntry.mOffset + pending[i].mEntry.mSize;
+        }
 
-#define HAS_ACTIVE_PROGRAM(ppo)
+        outFile.close();
+    }
+    catch (const std::ios_base::failure& e)
+    {
+        GLUF_ERROR_LONG("(WriteAssetArchive): Failed to Write \"" << archivePath << "\": " << e.what());
+        RETHROW;
+    }
+}
 
-#endif
 
 /*
-
-float's
+======================================================================================================================================================================================================
+Datatype Conversion Functions
 
 */
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniform1f(const SepProgramPtr& ppo, GLuint loc, const GLfloat& value) const
+Color4f ColorToFloat(const Color& color)
 {
-    HAS_ACTIVE_PROGRAM(ppo);
-
-    glProgramUniform1f(ppo->GetActiveProgram()->GetId(), loc, value);
-}
-
-//--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniform2f(const SepProgramPtr& ppo, GLuint loc, const glm::vec2& value) const
-{
-    HAS_ACTIVE_PROGRAM(ppo);
-
-    glProgramUniform2fv(ppo->GetActiveProgram()->GetId(), loc, 1, &value[0]);
+    Color4f col;
+    col.x = glm::clamp((float)color.x / 255.0f, 0.0f, 1.0f);
+    col.y = glm::clamp((float)color.y / 255.0f, 0.0f, 1.0f);
+    col.z = glm::clamp((float)color.z / 255.0f, 0.0f, 1.0f);
+    col.w = glm::clamp((float)color.w / 255.0f, 0.0f, 1.0f);
+    return col;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniform3f(const SepProgramPtr& ppo, GLuint loc, const glm::vec3& value) const
+Color3f ColorToFloat3(const Color& color)
 {
-    HAS_ACTIVE_PROGRAM(ppo);
-
-    glProgramUniform3fv(ppo->GetActiveProgram()->GetId(), loc, 1, &value[0]);
+    Color3f col;
+    col.x = glm::clamp((float)color.x / 255.0f, 0.0f, 1.0f);
+    col.y = glm::clamp((float)color.y / 255.0f, 0.0f, 1.0f);
+    col.z = glm::clamp((float)color.z / 255.0f, 0.0f, 1.0f);
+    return col;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniform4f(const SepProgramPtr& ppo, GLuint loc, const glm::vec4& value) const
+Point MultPoints(const Point& pt0, const Point& pt1)
 {
-    HAS_ACTIVE_PROGRAM(ppo);
+    Point retPt;
+    retPt.x = pt1.x * pt0.x;
+    retPt.y = pt1.y * pt1.y;
 
-    glProgramUniform4fv(ppo->GetActiveProgram()->GetId(), loc, 1, &value[0]);
+    return retPt;
 }
 
+
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniform1f(const SepProgramPtr& ppo, const std::string& name, const GLfloat& value) const
+glm::vec2 GetVec2FromRect(const Rect& rect, bool x, bool y)
 {
-    glProgramUniform1f(ppo->GetActiveProgram()->GetId(), GetUniformIdFromName(ppo, name), value);
+    if (x)
+        if (y)
+            return glm::vec2(rect.right, rect.top);
+        else
+            return glm::vec2(rect.right, rect.bottom);
+    else
+        if (y)
+            return glm::vec2(rect.left, rect.top);
+        else
+            return glm::vec2(rect.left, rect.bottom);
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniform2f(const SepProgramPtr& ppo, const std::string& name, const glm::vec2& value) const
+glm::vec2 GetVec2FromRect(const Rectf& rect, bool x, bool y)
 {
-    glProgramUniform2fv(ppo->GetActiveProgram()->GetId(), GetUniformIdFromName(ppo, name), 1, &value[0]);
+    if (x)
+        if (y)
+            return glm::vec2(rect.right, rect.top);
+        else
+            return glm::vec2(rect.right, rect.bottom);
+    else
+        if (y)
+            return glm::vec2(rect.left, rect.top);
+        else
+            return glm::vec2(rect.left, rect.bottom);
 }
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniform3f(const SepProgramPtr& ppo, const std::string& name, const glm::vec3& value) const
+#pragma warning (disable : 4244)
+std::string WStringToString(const std::wstring& str) noexcept
 {
-    glProgramUniform3fv(ppo->GetActiveProgram()->GetId(), GetUniformIdFromName(ppo, name), 1, &value[0]);
+    std::string temp(str.length(), ' ');
+    std::copy(str.begin(), str.end(), temp.begin());
+    return temp;
 }
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniform4f(const SepProgramPtr& ppo, const std::string& name, const glm::vec4& value) const
+std::wstring StringToWString(const std::string& str) noexcept
 {
-    glProgramUniform4fv(ppo->GetActiveProgram()->GetId(), GetUniformIdFromName(ppo, name), 1, &value[0]);
+    std::wstring temp(str.length(), L' ');
+    std::copy(str.begin(), str.end(), temp.begin());
+    return temp;
 }
 
+#pragma warning (default : 4244)
 
 /*
-
-int's
+======================================================================================================================================================================================================
+OpenGL State Cache
 
 */
 
-//--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniform1i(const SepProgramPtr& ppo, GLuint loc, const GLint& value) const
+#define GLUF_STATE_UNKNOWN 0xFFFFFFFFu
+
+namespace StateCache
 {
-    HAS_ACTIVE_PROGRAM(ppo);
+    //indices into 'GLStateCache::mBuffers'
+    const GLenum g_BufferTargets[GLUF_STATE_BUFFER_TARGETS] = 
+    {
+        GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, GL_UNIFORM_BUFFER, GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, GL_PIXEL_UNPACK_BUFFER,
+        GL_PIXEL_PACK_BUFFER, GL_TEXTURE_BUFFER, GL_DRAW_INDIRECT_BUFFER, GL_SHADER_STORAGE_BUFFER, GL_TRANSFORM_FEEDBACK_BUFFER
+    };
+
+    //indices into 'GLStateCache::mTextures', and the query for each one's binding
+    const GLenum g_TextureTargets[GLUF_STATE_TEXTURE_TARGETS] = 
+    {
+        GL_TEXTURE_2D, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_2D_ARRAY, GL_TEXTURE_3D, GL_TEXTURE_1D, GL_TEXTURE_1D_ARRAY, GL_TEXTURE_RECTANGLE,
+        GL_TEXTURE_CUBE_MAP_ARRAY, GL_TEXTURE_BUFFER, GL_TEXTURE_2D_MULTISAMPLE, GL_TEXTURE_2D_MULTISAMPLE_ARRAY
+    };
+    const GLenum g_TextureBindingQueries[GLUF_STATE_TEXTURE_TARGETS] =
+    {
+        GL_TEXTURE_BINDING_2D, GL_TEXTURE_BINDING_CUBE_MAP, GL_TEXTURE_BINDING_2D_ARRAY, GL_TEXTURE_BINDING_3D, GL_TEXTURE_BINDING_1D,
+        GL_TEXTURE_BINDING_1D_ARRAY, GL_TEXTURE_BINDING_RECTANGLE, GL_TEXTURE_BINDING_CUBE_MAP_ARRAY, GL_TEXTURE_BINDING_BUFFER,
+        GL_TEXTURE_BINDING_2D_MULTISAMPLE, GL_TEXTURE_BINDING_2D_MULTISAMPLE_ARRAY
+    };
 
-    glProgramUniform1i(ppo->GetActiveProgram()->GetId(), loc, value);
+    //indices into 'GLStateCache::mCapabilities'
+    const GLenum g_Capabilities[GLUF_STATE_CAPABILITIES] = 
+    {
+        GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE, GL_DEPTH_CLAMP, GL_SCISSOR_TEST, GL_STENCIL_TEST, GL_MULTISAMPLE, GL_FRAMEBUFFER_SRGB,
+        GL_POLYGON_OFFSET_FILL, GL_PRIMITIVE_RESTART, GL_RASTERIZER_DISCARD, GL_SAMPLE_ALPHA_TO_COVERAGE, GL_PROGRAM_POINT_SIZE,
+        GL_TEXTURE_CUBE_MAP_SEAMLESS, GL_LINE_SMOOTH
+    };
+
+    //--------------------------------------------------------------------------------------
+    template<std::size_t Count>
+    int FindEnum(const GLenum (&list)[Count], GLenum value) noexcept
+    {
+        for (std::size_t i = 0; i < Count; ++i)
+        {
+            if (list[i] == value)
+                return static_cast<int>(i);
+        }
+        return -1;
+    }
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniform2i(const SepProgramPtr& ppo, GLuint loc, const glm::i32vec2& value) const
+unsigned long long GLStateCacheStats::GetTotalSkipped() const noexcept
 {
-    HAS_ACTIVE_PROGRAM(ppo);
-
-    glProgramUniform2iv(ppo->GetActiveProgram()->GetId(), loc, 1, &value[0]);
+    return mProgramBindsSkipped + mVertexArrayBindsSkipped + mBufferBindsSkipped + mTextureBindsSkipped + mSamplerBindsSkipped + mStateSkipped;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniform3i(const SepProgramPtr& ppo, GLuint loc, const glm::i32vec3& value) const
+GLStateCache::GLStateCache() noexcept
 {
-    HAS_ACTIVE_PROGRAM(ppo);
-
-    glProgramUniform3iv(ppo->GetActiveProgram()->GetId(), loc, 1, &value[0]);
+    Invalidate();
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniform4i(const SepProgramPtr& ppo, GLuint loc, const glm::i32vec4& value) const
+void GLStateCache::Invalidate() noexcept
 {
-    HAS_ACTIVE_PROGRAM(ppo);
+    mProgram = GLUF_STATE_UNKNOWN;
+    mPipeline = GLUF_STATE_UNKNOWN;
+    mVertexArray = GLUF_STATE_UNKNOWN;
+    std::fill(std::begin(mBuffers), std::end(mBuffers), GLUF_STATE_UNKNOWN);
+    for (auto& it : mUniformBindings)
+        it = { GLUF_STATE_UNKNOWN, 0, 0 };
 
-    glProgramUniform4iv(ppo->GetActiveProgram()->GetId(), loc, 1, &value[0]);
+    mActiveTexture = GLUF_STATE_UNKNOWN;
+    for (auto& it : mTextures)
+        std::fill(std::begin(it), std::end(it), GLUF_STATE_UNKNOWN);
+    std::fill(std::begin(mSamplers), std::end(mSamplers), GLUF_STATE_UNKNOWN);
+
+    std::fill(std::begin(mCapabilities), std::end(mCapabilities), -1);
+    std::fill(std::begin(mBlendFunc), std::end(mBlendFunc), GLUF_STATE_UNKNOWN);
+    std::fill(std::begin(mBlendEquation), std::end(mBlendEquation), GLUF_STATE_UNKNOWN);
+    mDepthFunc = GLUF_STATE_UNKNOWN;
+    mDepthMask = -1;
+    mCullFace = GLUF_STATE_UNKNOWN;
+    mViewportKnown = false;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniform1i(const SepProgramPtr& ppo, const std::string& name, const GLint& value) const
+void GLStateCache::SetEnabled(bool enabled) noexcept
 {
-    glProgramUniform1i(ppo->GetActiveProgram()->GetId(), GetUniformIdFromName(ppo, name), value);
+    //whatever happened while disabled was still tracked, so the shadow is good either way
+    mEnabled = enabled;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniform2i(const SepProgramPtr& ppo, const std::string& name, const glm::i32vec2& value) const
+GLuint* GLStateCache::FindBuffer(GLenum target) noexcept
 {
-    glProgramUniform2iv(ppo->GetActiveProgram()->GetId(), GetUniformIdFromName(ppo, name), 1, &value[0]);
+    int index = StateCache::FindEnum(StateCache::g_BufferTargets, target);
+    return index == -1 ? nullptr : &mBuffers[index];
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniform3i(const SepProgramPtr& ppo, const std::string& name, const glm::i32vec3& value) const
+GLuint* GLStateCache::FindTexture(GLuint unit, GLenum target) noexcept
 {
-    glProgramUniform3iv(ppo->GetActiveProgram()->GetId(), GetUniformIdFromName(ppo, name), 1, &value[0]);
+    if (unit >= GLUF_STATE_TEXTURE_UNITS)
+        return nullptr;
+
+    int index = StateCache::FindEnum(StateCache::g_TextureTargets, target);
+    return index == -1 ? nullptr : &mTextures[unit][index];
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniform4i(const SepProgramPtr& ppo, const std::string& name, const glm::i32vec4& value) const
+signed char* GLStateCache::FindCapability(GLenum cap) noexcept
 {
-    glProgramUniform4iv(ppo->GetActiveProgram()->GetId(), GetUniformIdFromName(ppo, name), 1, &value[0]);
+    int index = StateCache::FindEnum(StateCache::g_Capabilities, cap);
+    return index == -1 ? nullptr : &mCapabilities[index];
 }
 
-
-/*
-
-uint's
-
-*/
-
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniform1ui(const SepProgramPtr& ppo, GLuint loc, const GLuint& value) const
+void GLStateCache::UseProgram(GLuint program) noexcept
 {
-    HAS_ACTIVE_PROGRAM(ppo);
+    if (mEnabled && mProgram == program)
+    {
+        ++mStats.mProgramBindsSkipped;
+        return;
+    }
 
-    glProgramUniform1ui(ppo->GetActiveProgram()->GetId(), loc, value);
+    glUseProgram(program);
+    mProgram = program;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniform2ui(const SepProgramPtr& ppo, GLuint loc, const glm::u32vec2& value) const
+void GLStateCache::BindProgramPipeline(GLuint pipeline) noexcept
 {
-    HAS_ACTIVE_PROGRAM(ppo);
+    if (mEnabled && mPipeline == pipeline)
+    {
+        ++mStats.mProgramBindsSkipped;
+        return;
+    }
 
-    glProgramUniform2uiv(ppo->GetActiveProgram()->GetId(), loc, 1, &value[0]);
+    glBindProgramPipeline(pipeline);
+    mPipeline = pipeline;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniform3ui(const SepProgramPtr& ppo, GLuint loc, const glm::u32vec3& value) const
+void GLStateCache::BindVertexArray(GLuint vertexArray) noexcept
 {
-    HAS_ACTIVE_PROGRAM(ppo);
+    if (mEnabled && mVertexArray == vertexArray)
+    {
+        ++mStats.mVertexArrayBindsSkipped;
+        return;
+    }
 
-    glProgramUniform3uiv(ppo->GetActiveProgram()->GetId(), loc, 1, &value[0]);
+    glBindVertexArray(vertexArray);
+    mVertexArray = vertexArray;
+
+    //the index buffer binding belongs to the vertex array
+    *FindBuffer(GL_ELEMENT_ARRAY_BUFFER) = GLUF_STATE_UNKNOWN;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniform4ui(const SepProgramPtr& ppo, GLuint loc, const glm::u32vec4& value) const
+void GLStateCache::BindBuffer(GLenum target, GLuint buffer) noexcept
 {
-    HAS_ACTIVE_PROGRAM(ppo);
+    GLuint* shadow = FindBuffer(target);
+    if (mEnabled && shadow != nullptr && *shadow == buffer)
+    {
+        ++mStats.mBufferBindsSkipped;
+        return;
+    }
 
-    glProgramUniform4uiv(ppo->GetActiveProgram()->GetId(), loc, 1, &value[0]);
+    glBindBuffer(target, buffer);
+    if (shadow != nullptr)
+        *shadow = buffer;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniform1ui(const SepProgramPtr& ppo, const std::string& name, const GLuint& value) const
+void GLStateCache::BindBufferBase(GLenum target, GLuint index, GLuint buffer) noexcept
 {
-    glProgramUniform1ui(ppo->GetActiveProgram()->GetId(), GetUniformIdFromName(ppo, name), value);
+    //a size of -1 marks the whole buffer
+    BindBufferRange(target, index, buffer, 0, -1);
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniform2ui(const SepProgramPtr& ppo, const std::string& name, const glm::u32vec2& value) const
+void GLStateCache::BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) noexcept
 {
-    glProgramUniform2uiv(ppo->GetActiveProgram()->GetId(), GetUniformIdFromName(ppo, name), 1, &value[0]);
+    IndexedBinding* shadow = (target == GL_UNIFORM_BUFFER && index < GLUF_STATE_UNIFORM_BINDINGS) ? &mUniformBindings[index] : nullptr;
+    if (mEnabled && shadow != nullptr && shadow->mBuffer == buffer && shadow->mOffset == offset && shadow->mSize == size)
+    {
+        ++mStats.mBufferBindsSkipped;
+        return;
+    }
+
+    if (size == -1)
+        glBindBufferBase(target, index, buffer);
+    else
+        glBindBufferRange(target, index, buffer, offset, size);
+
+    if (shadow != nullptr)
+        *shadow = { buffer, offset, size };
+
+    //the indexed binds also bind the generic binding point
+    GLuint* generic = FindBuffer(target);
+    if (generic != nullptr)
+        *generic = buffer;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniform3ui(const SepProgramPtr& ppo, const std::string& name, const glm::u32vec3& value) const
+void GLStateCache::ActiveTexture(GLenum texture) noexcept
 {
-    glProgramUniform3uiv(ppo->GetActiveProgram()->GetId(), GetUniformIdFromName(ppo, name), 1, &value[0]);
+    GLuint unit = texture - GL_TEXTURE0;
+    if (mEnabled && mActiveTexture == unit)
+    {
+        ++mStats.mTextureBindsSkipped;
+        return;
+    }
+
+    glActiveTexture(texture);
+    mActiveTexture = unit;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniform4ui(const SepProgramPtr& ppo, const std::string& name, const glm::u32vec4& value) const
+void GLStateCache::BindTexture(GLenum target, GLuint texture) noexcept
 {
-    glProgramUniform4uiv(ppo->GetActiveProgram()->GetId(), GetUniformIdFromName(ppo, name), 1, &value[0]);
+    GLuint* shadow = FindTexture(mActiveTexture, target);
+    if (mEnabled && shadow != nullptr && *shadow == texture)
+    {
+        ++mStats.mTextureBindsSkipped;
+        return;
+    }
+
+    glBindTexture(target, texture);
+    if (shadow != nullptr)
+        *shadow = texture;
 }
 
-/*
+//--------------------------------------------------------------------------------------
+void GLStateCache::BindTexture(GLuint unit, GLenum target, GLuint texture) noexcept
+{
+    //callers may edit the texture right after this, so the unit has to be active even if the bind is dropped
+    ActiveTexture(GL_TEXTURE0 + unit);
 
-matricies
+    GLuint* shadow = FindTexture(unit, target);
+    if (mEnabled && shadow != nullptr && *shadow == texture)
+    {
+        ++mStats.mTextureBindsSkipped;
+        return;
+    }
 
-*/
+    glBindTexture(target, texture);
+    if (shadow != nullptr)
+        *shadow = texture;
+}
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniformMatrix2f(const SepProgramPtr& ppo, GLuint loc, const glm::mat2& value) const
+void GLStateCache::BindSampler(GLuint unit, GLuint sampler) noexcept
 {
-    HAS_ACTIVE_PROGRAM(ppo);
+    GLuint* shadow = unit < GLUF_STATE_TEXTURE_UNITS ? &mSamplers[unit] : nullptr;
+    if (mEnabled && shadow != nullptr && *shadow == sampler)
+    {
+        ++mStats.mSamplerBindsSkipped;
+        return;
+    }
 
-    glProgramUniformMatrix2fv(ppo->GetActiveProgram()->GetId(), loc, 1, 0, &value[0][0]);
+    glBindSampler(unit, sampler);
+    if (shadow != nullptr)
+        *shadow = sampler;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniformMatrix3f(const SepProgramPtr& ppo, GLuint loc, const glm::mat3& value) const
+void GLStateCache::Enable(GLenum cap) noexcept
 {
-    HAS_ACTIVE_PROGRAM(ppo);
+    SetCapability(cap, true);
+}
 
-    glProgramUniformMatrix3fv(ppo->GetActiveProgram()->GetId(), loc, 1, 0, &value[0][0]);
+//--------------------------------------------------------------------------------------
+void GLStateCache::Disable(GLenum cap) noexcept
+{
+    SetCapability(cap, false);
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniformMatrix4f(const SepProgramPtr& ppo, GLuint loc, const glm::mat4& value) const
+void GLStateCache::SetCapability(GLenum cap, bool enabled) noexcept
 {
-    HAS_ACTIVE_PROGRAM(ppo);
+    signed char* shadow = FindCapability(cap);
+    signed char value = enabled ? 1 : 0;
+    if (mEnabled && shadow != nullptr && *shadow == value)
+    {
+        ++mStats.mStateSkipped;
+        return;
+    }
+
+    if (enabled)
+        glEnable(cap);
+    else
+        glDisable(cap);
 
-    glProgramUniformMatrix4fv(ppo->GetActiveProgram()->GetId(), loc, 1, 0, &value[0][0]);
+    if (shadow != nullptr)
+        *shadow = value;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniformMatrix2x3f(const SepProgramPtr& ppo, GLuint loc, const glm::mat2x3& value) const
+void GLStateCache::BlendFunc(GLenum source, GLenum destination) noexcept
 {
-    HAS_ACTIVE_PROGRAM(ppo);
+    if (mEnabled && mBlendFunc[0] == source && mBlendFunc[1] == destination && mBlendFunc[2] == source && mBlendFunc[3] == destination)
+    {
+        ++mStats.mStateSkipped;
+        return;
+    }
 
-    glProgramUniformMatrix2x3fv(ppo->GetActiveProgram()->GetId(), loc, 1, 0, &value[0][0]);
+    glBlendFunc(source, destination);
+    mBlendFunc[0] = mBlendFunc[2] = source;
+    mBlendFunc[1] = mBlendFunc[3] = destination;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniformMatrix3x2f(const SepProgramPtr& ppo, GLuint loc, const glm::mat3x2& value) const
+void GLStateCache::BlendFuncSeparate(GLenum sourceRGB, GLenum destinationRGB, GLenum sourceAlpha, GLenum destinationAlpha) noexcept
 {
-    HAS_ACTIVE_PROGRAM(ppo);
+    if (mEnabled && mBlendFunc[0] == sourceRGB && mBlendFunc[1] == destinationRGB && mBlendFunc[2] == sourceAlpha && mBlendFunc[3] == destinationAlpha)
+    {
+        ++mStats.mStateSkipped;
+        return;
+    }
 
-    glProgramUniformMatrix3x2fv(ppo->GetActiveProgram()->GetId(), loc, 1, 0, &value[0][0]);
+    glBlendFuncSeparate(sourceRGB, destinationRGB, sourceAlpha, destinationAlpha);
+    mBlendFunc[0] = sourceRGB;
+    mBlendFunc[1] = destinationRGB;
+    mBlendFunc[2] = sourceAlpha;
+    mBlendFunc[3] = destinationAlpha;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniformMatrix2x4f(const SepProgramPtr& ppo, GLuint loc, const glm::mat2x4& value) const
+void GLStateCache::BlendEquation(GLenum mode) noexcept
 {
-    HAS_ACTIVE_PROGRAM(ppo);
+    if (mEnabled && mBlendEquation[0] == mode && mBlendEquation[1] == mode)
+    {
+        ++mStats.mStateSkipped;
+        return;
+    }
 
-    glProgramUniformMatrix2x4fv(ppo->GetActiveProgram()->GetId(), loc, 1, 0, &value[0][0]);
+    glBlendEquation(mode);
+    mBlendEquation[0] = mBlendEquation[1] = mode;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniformMatrix4x2f(const SepProgramPtr& ppo, GLuint loc, const glm::mat4x2& value) const
+void GLStateCache::DepthFunc(GLenum func) noexcept
 {
-    HAS_ACTIVE_PROGRAM(ppo);
+    if (mEnabled && mDepthFunc == func)
+    {
+        ++mStats.mStateSkipped;
+        return;
+    }
 
-    glProgramUniformMatrix4x2fv(ppo->GetActiveProgram()->GetId(), loc, 1, 0, &value[0][0]);
+    glDepthFunc(func);
+    mDepthFunc = func;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniformMatrix3x4f(const SepProgramPtr& ppo, GLuint loc, const glm::mat3x4& value) const
+void GLStateCache::DepthMask(GLboolean flag) noexcept
 {
-    HAS_ACTIVE_PROGRAM(ppo);
+    signed char value = flag ? 1 : 0;
+    if (mEnabled && mDepthMask == value)
+    {
+        ++mStats.mStateSkipped;
+        return;
+    }
 
-    glProgramUniformMatrix3x4fv(ppo->GetActiveProgram()->GetId(), loc, 1, 0, &value[0][0]);
+    glDepthMask(flag);
+    mDepthMask = value;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniformMatrix4x3f(const SepProgramPtr& ppo, GLuint loc, const glm::mat4x3& value) const
+void GLStateCache::CullFace(GLenum mode) noexcept
 {
-    HAS_ACTIVE_PROGRAM(ppo);
+    if (mEnabled && mCullFace == mode)
+    {
+        ++mStats.mStateSkipped;
+        return;
+    }
 
-    glProgramUniformMatrix4x3fv(ppo->GetActiveProgram()->GetId(), loc, 1, 0, &value[0][0]);
+    glCullFace(mode);
+    mCullFace = mode;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniformMatrix2f(const SepProgramPtr& ppo, const std::string& name, const glm::mat2& value) const
+void GLStateCache::Viewport(GLint x, GLint y, GLsizei width, GLsizei height) noexcept
 {
-    glProgramUniformMatrix2fv(ppo->GetActiveProgram()->GetId(), GetUniformIdFromName(ppo, name), 1, 0, &value[0][0]);
+    if (mEnabled && mViewportKnown && mViewport[0] == x && mViewport[1] == y && mViewport[2] == width && mViewport[3] == height)
+    {
+        ++mStats.mStateSkipped;
+        return;
+    }
+
+    glViewport(x, y, width, height);
+    mViewport[0] = x;
+    mViewport[1] = y;
+    mViewport[2] = width;
+    mViewport[3] = height;
+    mViewportKnown = true;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniformMatrix3f(const SepProgramPtr& ppo, const std::string& name, const glm::mat3& value) const
+void GLStateCache::DeleteBuffers(GLsizei count, const GLuint* buffers) noexcept
 {
-    glProgramUniformMatrix3fv(ppo->GetActiveProgram()->GetId(), GetUniformIdFromName(ppo, name), 1, 0, &value[0][0]);
+    glDeleteBuffers(count, buffers);
+
+    for (GLsizei i = 0; i < count; ++i)
+    {
+        if (buffers[i] == 0)
+            continue;
+
+        for (auto& it : mBuffers)
+        {
+            if (it == buffers[i])
+                it = 0;
+        }
+        for (auto& it : mUniformBindings)
+        {
+            if (it.mBuffer == buffers[i])
+                it = { 0, 0, 0 };
+        }
+    }
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniformMatrix4f(const SepProgramPtr& ppo, const std::string& name, const glm::mat4& value) const
+void GLStateCache::DeleteTextures(GLsizei count, const GLuint* textures) noexcept
 {
-    glProgramUniformMatrix4fv(ppo->GetActiveProgram()->GetId(), GetUniformIdFromName(ppo, name), 1, 0, &value[0][0]);
+    glDeleteTextures(count, textures);
+
+    for (GLsizei i = 0; i < count; ++i)
+    {
+        if (textures[i] == 0)
+            continue;
+
+        for (auto& unit : mTextures)
+        {
+            for (auto& it : unit)
+            {
+                if (it == textures[i])
+                    it = 0;
+            }
+        }
+    }
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniformMatrix2x3f(const SepProgramPtr& ppo, const std::string& name, const glm::mat2x3& value) const
+void GLStateCache::DeleteVertexArrays(GLsizei count, const GLuint* vertexArrays) noexcept
 {
-    glProgramUniformMatrix2x3fv(ppo->GetActiveProgram()->GetId(), GetUniformIdFromName(ppo, name), 1, 0, &value[0][0]);
+    glDeleteVertexArrays(count, vertexArrays);
+
+    for (GLsizei i = 0; i < count; ++i)
+    {
+        if (vertexArrays[i] != 0 && vertexArrays[i] == mVertexArray)
+        {
+            mVertexArray = 0;
+            *FindBuffer(GL_ELEMENT_ARRAY_BUFFER) = GLUF_STATE_UNKNOWN;
+        }
+    }
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniformMatrix3x2f(const SepProgramPtr& ppo, const std::string& name, const glm::mat3x2& value) const
+void GLStateCache::DeleteSamplers(GLsizei count, const GLuint* samplers) noexcept
 {
-    glProgramUniformMatrix3x2fv(ppo->GetActiveProgram()->GetId(), GetUniformIdFromName(ppo, name), 1, 0, &value[0][0]);
+    glDeleteSamplers(count, samplers);
+
+    for (GLsizei i = 0; i < count; ++i)
+    {
+        if (samplers[i] == 0)
+            continue;
+
+        for (auto& it : mSamplers)
+        {
+            if (it == samplers[i])
+                it = 0;
+        }
+    }
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniformMatrix2x4f(const SepProgramPtr& ppo, const std::string& name, const glm::mat2x4& value) const
+void GLStateCache::DeleteProgram(GLuint program) noexcept
 {
-    glProgramUniformMatrix2x4fv(ppo->GetActiveProgram()->GetId(), GetUniformIdFromName(ppo, name), 1, 0, &value[0][0]);
+    glDeleteProgram(program);
+
+    if (program != 0 && program == mProgram)
+        mProgram = GLUF_STATE_UNKNOWN;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniformMatrix4x2f(const SepProgramPtr& ppo, const std::string& name, const glm::mat4x2& value) const
+void GLStateCache::DeleteProgramPipelines(GLsizei count, const GLuint* pipelines) noexcept
 {
-    glProgramUniformMatrix4x2fv(ppo->GetActiveProgram()->GetId(), GetUniformIdFromName(ppo, name), 1, 0, &value[0][0]);
+    glDeleteProgramPipelines(count, pipelines);
+
+    for (GLsizei i = 0; i < count; ++i)
+    {
+        if (pipelines[i] != 0 && pipelines[i] == mPipeline)
+            mPipeline = GLUF_STATE_UNKNOWN;
+    }
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniformMatrix3x4f(const SepProgramPtr& ppo, const std::string& name, const glm::mat3x4& value) const
+GLuint GLStateCache::GetProgram() noexcept
 {
-    glProgramUniformMatrix3x4fv(ppo->GetActiveProgram()->GetId(), GetUniformIdFromName(ppo, name), 1, 0, &value[0][0]);
+    if (!mEnabled || mProgram == GLUF_STATE_UNKNOWN)
+    {
+        GLint program = 0;
+        glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+        mProgram = static_cast<GLuint>(program);
+    }
+
+    return mProgram;
 }
 
 //--------------------------------------------------------------------------------------
-void ShaderManager::GLProgramUniformMatrix4x3f(const SepProgramPtr& ppo, const std::string& name, const glm::mat4x3& value) const
+GLuint GLStateCache::GetVertexArray() noexcept
 {
-    glProgramUniformMatrix4x3fv(ppo->GetActiveProgram()->GetId(), GetUniformIdFromName(ppo, name), 1, 0, &value[0][0]);
+    if (!mEnabled || mVertexArray == GLUF_STATE_UNKNOWN)
+    {
+        GLint vertexArray = 0;
+        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &vertexArray);
+        mVertexArray = static_cast<GLuint>(vertexArray);
+    }
+
+    return mVertexArray;
 }
 
-/*
-======================================================================================================================================================================================================
+//--------------------------------------------------------------------------------------
+GLuint GLStateCache::GetTexture(GLenum target) noexcept
+{
+    if (!mEnabled || mActiveTexture == GLUF_STATE_UNKNOWN)
+    {
+        GLint active = GL_TEXTURE0;
+        glGetIntegerv(GL_ACTIVE_TEXTURE, &active);
+        mActiveTexture = static_cast<GLuint>(active) - GL_TEXTURE0;
+    }
 
-Buffer and Texture (alpha)
+    int index = StateCache::FindEnum(StateCache::g_TextureTargets, target);
+    if (index == -1)
+        return 0;
 
+    GLuint* shadow = FindTexture(mActiveTexture, target);
+    if (!mEnabled || shadow == nullptr || *shadow == GLUF_STATE_UNKNOWN)
+    {
+        GLint texture = 0;
+        glGetIntegerv(StateCache::g_TextureBindingQueries[index], &texture);
+        if (shadow == nullptr)
+            return static_cast<GLuint>(texture);
 
-*/
+        *shadow = static_cast<GLuint>(texture);
+    }
 
+    return *shadow;
+}
 
-/*
+//--------------------------------------------------------------------------------------
+void GLStateCache::ResetStats() noexcept
+{
+    mStats = GLStateCacheStats();
+}
 
-Texture Utilities:
 
-*/
+/*
+======================================================================================================================================================================================================
+Shader API (Alpha)
 
+Note:
+    Attaching shaders to programs and programs to ppo's does not check if shader compilation failed, or if program linking failed respectively
 
+*/
 
-#define FOURCC_DXT1 0x31545844 // Equivalent to "DXT1" in ASCII
-#define FOURCC_DXT3 0x33545844 // Equivalent to "DXT3" in ASCII
-#define FOURCC_DXT5 0x35545844 // Equivalent to "DXT5" in ASCII
 
-/*
-LoadTextureDDS
+class CompileShaderException : public Exception
+{
+public:
+    virtual const char* what() const noexcept override
+    {
+        return "Failed to Compile Shader!";
+    }
 
-    Parameters:
-        'rawData': raw data loaded from file to put into OpenGL
+    EXCEPTION_CONSTRUCTOR(CompileShaderException)
+};
 
-    Returns:
-        OpenGL Id of texture created
+class CreateGLShaderException : public Exception
+{
+public:
+    virtual const char* what() const noexcept override
+    {
+        return "OpenGL Failed to Create Shader Instance!";
+    }
 
-    Throws:
-        'std::invalid_argument': if data is too small, is not the correct file format, 
+    EXCEPTION_CONSTRUCTOR(CreateGLShaderException)
+};
 
-*/
-//--------------------------------------------------------------------------------------
-GLuint LoadTextureDDS(const std::vector<char>& rawData)
+class LinkProgramException : public Exception
 {
-    //TODO support more compatibility, ie RGB, BGR, don't make it dependent on ABGR
+public:
+    virtual const char* what() const noexcept override
+    {
+        return "Failed to Link Program!";
+    }
 
+    EXCEPTION_CONSTRUCTOR(LinkProgramException)
+};
 
-    //verify size of header
-    if (rawData.size() < 128)
+class CreateGLProgramException : public Exception
+{
+public:
+    virtual const char* what() const noexcept override
     {
-        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(LoadTextureDDS): Raw Data Too Small For Header!"));
+        return "OpenGL Failed to Create Program Instance!";
     }
 
-    //verify the type of file
-    std::string filecode(rawData.begin(), rawData.begin() + 4);
-    if (filecode != "DDS ")
+    EXCEPTION_CONSTRUCTOR(CreateGLProgramException)
+};
+
+class CreateGLPPOException : public Exception
+{
+public:
+    virtual const char* what() const noexcept override
     {
-        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(LoadTextureDDS): Incorrect File Format!"));
+        return "OpenGL Failed to Create PPO Instance!";
     }
 
-    //load the header
+    EXCEPTION_CONSTRUCTOR(CreateGLPPOException)
+};
 
-    //this is all the data I need, but I just need to load it properly to opengl (NOTE: this is all offset by 4 bytes because of the filecode)
-    unsigned int height = *(unsigned int*)&(rawData[12]);
-    unsigned int width = *(unsigned int*)&(rawData[16]);
-    unsigned int linearSize = *(unsigned int*)&(rawData[20]);
-    unsigned int mipMapCount = *(unsigned int*)&(rawData[28]);
-    unsigned int flags = *(unsigned int*)&(rawData[80]);
-    unsigned int fourCC = *(unsigned int*)&(rawData[84]);
-    unsigned int RGBBitCount = *(unsigned int*)&(rawData[88]);
-    unsigned int RBitMask = *(unsigned int*)&(rawData[92]);
-    unsigned int GBitMask = *(unsigned int*)&(rawData[96]);
-    unsigned int BBitMask = *(unsigned int*)&(rawData[100]);
-    unsigned int ABitMask = *(unsigned int*)&(rawData[104]);
 
-    //how big is it going to be including all mipmaps?
-    unsigned int bufsize = mipMapCount > 1 ? linearSize * 2 : linearSize;
 
-    //verify size of data again once header is loaded
-                                                            //this does not work when the file is compressed
-    /*if (rawData.size() < 128 + bufsize)
-    {
-        throw std::invalid_argument("(LoadTextureDDS): Raw Data Too Small!");
-    }*/
+/*
 
+ShaderTypeToProgramStage
 
-    unsigned int components = (fourCC == FOURCC_DXT1) ? 3 : 4;
-    unsigned int compressedFormat;
-    switch (fourCC)
+*/
+
+
+//--------------------------------------------------------------------------------------
+ProgramStage ShaderTypeToProgramStage(ShaderType type)
+{
+    switch (type)
     {
-    case FOURCC_DXT1:
-        compressedFormat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
-        break;
-    case FOURCC_DXT3:
-        compressedFormat = GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
-        break;
-    case FOURCC_DXT5:
-        compressedFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
-        break;
+    case SH_VERTEX_SHADER:
+        return PPO_VERTEX_SHADER_BIT;
+    case SH_TESSCONTROL_SHADER:
+        return PPO_TESSCONTROL_SHADER_BIT;
+    case SH_TESS_EVALUATION_SHADER:
+        return PPO_TESS_EVALUATION_SHADER_BIT;
+    case SH_GEOMETRY_SHADER:
+        return PPO_GEOMETRY_SHADER_BIT;
+    case SH_FRAGMENT_SHADER:
+        return PPO_FRAGMENT_SHADER_BIT;
     default:
-        compressedFormat = 0;//uncompressed
+        return PPO_INVALID_SHADER_BIT;
     }
+};
 
-    // Create one OpenGL texture
-    GLuint textureID;
-    glGenTextures(1, &textureID);
+/*
+HasParallelShaderCompile
 
-    //make sure OpenGL successfully created the texture before loading it
-    if (textureID == 0)
-        GLUF_CRITICAL_EXCEPTION(TextureCreationException());
+    Returns:
+        true if the driver compiles and links in the background, and can be polled with GL_COMPLETION_STATUS
 
-    // "Bind" the newly created texture : all future texture functions will modify this texture
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, mipMapCount - 1);//REMEMBER it is max mip, NOT mip count
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_RED);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_GREEN);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_BLUE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_ALPHA);
+    Note:
+        GL_KHR_parallel_shader_compile and GL_ARB_parallel_shader_compile share their enums, and the loader only
+            carries the ARB entry points
+*/
+//--------------------------------------------------------------------------------------
+bool HasParallelShaderCompile()
+{
+    return gExtensions.HasExtension("GL_KHR_parallel_shader_compile") || gExtensions.HasExtension("GL_ARB_parallel_shader_compile");
+}
 
-    if (compressedFormat != 0)
-    {
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+/*
+Shader
 
-        unsigned int blockSize = (compressedFormat == GL_COMPRESSED_RGBA_S3TC_DXT1_EXT) ? 8 : 16;
-        unsigned int offset = 128;// initial offset to compensate for header and file code
+    Data Members:
+        'mShaderId': OpenGL-Assigned Shader id
+        'mTmpShaderText': shader text cache kept if shaders are appending eachother
+        'mShaderType': what shader type is it (i.e. GL_FRAGMENT_SHADER)
 
-        /* load the mipmaps */
-        for (unsigned int level = 0; level < mipMapCount/* && (width || height)*/; ++level)
-        {
-            unsigned int mipSize = ((width + 3) / 4)*((height + 3) / 4)*blockSize;
-            glCompressedTexImage2D(GL_TEXTURE_2D, 
-                level, compressedFormat, 
-                width, height,
-                0, mipSize, 
-                rawData.data() + offset);
+*/
+class Shader
+{
+    friend ShaderManager;
+    friend Program;
 
-            offset += mipSize;
-            width /= 2;
-            height /= 2;
+    GLuint mShaderId;
 
-            // Deal with Non-Power-Of-Two textures
-            if (width < 1) width = 1;
-            if (height < 1) height = 1;
+    std::string mTmpShaderText;
 
-        }
+    ShaderType mShaderType;
 
-    }
-    else
-    {
-        unsigned int offset = 128;// initial offset to compensate for header and file code
+    //disallow copy and assign, because these must always be refered to by pointers
+    Shader(const Shader& other) = delete;
+    Shader& operator=(const Shader& other) = delete;
+public:
 
-        for (unsigned int level = 0; level < mipMapCount/* && (width || height)*/; ++level)
-        {
-            glTexImage2D(GL_TEXTURE_2D, 
-                level, GL_RGBA, 
-                width, height, 
-                0, GL_RGBA, GL_UNSIGNED_BYTE, 
-                rawData.data() + offset);
+    /*
+    Constructor
+        Throws:
+            no-throw guarantee
+    
+    */
+    Shader() noexcept;
+    ~Shader() noexcept;
 
-            unsigned int mipSize = (width * height * 4);
-            offset += mipSize;
-            width /= 2;
-            height /= 2;
+    //common shader is if the shader will not be deleted after building into a program
+    //this is used for things like lighting functions
 
-            // Deal with Non-Power-Of-Two textures
-            if (width < 1) width = 1;
-            if (height < 1) height = 1;
-        }
-    }
+    /*
+    Init
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+        Parameters:
+            'shaderType': which shader type it is
 
-    return textureID;
-}
+        Throws:
+            no-throw guarantee
+    */
+    void Init(ShaderType shaderType) noexcept;
 
-//--------------------------------------------------------------------------------------
-GLuint LoadTextureCubemapDDS(const std::vector<char>& rawData)
-{    
-    //TODO support more compatibility, ie RGB, BGR, don't make it dependent on ABGR
 
+    /*
+    Load
+        
+        Parameters:
+            'shaderText': text to be added
+            'append': append 'shaderText' to 'mTmpShaderText' or clear 'mTmpShaderText'
 
-    //verify size of header
-    if (rawData.size() < 128)
-    {
-        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(LoadTextureDDS): Raw Data Too Small For Header!"));
-    }
+        Throws:
+            may throw 'std::bad_alloc' if string allocation fails
+    */
+    void Load(const std::string& shaderText, bool append = false);
 
-    //verify the type of file 
-    std::string filecode(rawData.begin(), rawData.begin() + 4);
-    if (filecode != "DDS ")
-    {
-        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(LoadTextureDDS): Incorrect File Format!"));
-    }
-    
-    //load the header
+    /*
+    LoadFromMemory
 
-    //this is all the data I need, but I just need to load it properly to opengl (NOTE: this is all offset by 4 bytes because of the filecode)
-    unsigned int height = *(unsigned int*)&(rawData[12]);
-    unsigned int width = *(unsigned int*)&(rawData[16]);
-    unsigned int linearSize = *(unsigned int*)&(rawData[20]);
-    unsigned int mipMapCount = *(unsigned int*)&(rawData[28]);
-    unsigned int flags = *(unsigned int*)&(rawData[80]);
-    unsigned int fourCC = *(unsigned int*)&(rawData[84]);
-    unsigned int RGBBitCount = *(unsigned int*)&(rawData[88]);
-    unsigned int RBitMask = *(unsigned int*)&(rawData[92]);
-    unsigned int GBitMask = *(unsigned int*)&(rawData[96]);
-    unsigned int BBitMask = *(unsigned int*)&(rawData[100]);
-    unsigned int ABitMask = *(unsigned int*)&(rawData[104]);
+        Parameters:
+            'shaderData': raw memory to read shader text from
+            'append': append text loaded from 'shaderData' to 'mTmpShaderText' or clear 'mTmpShaderText'
 
-    //how big is it going to be including all mipmaps? 
-    unsigned int bufsize = mipMapCount > 1 ? linearSize * 2 : linearSize;
+        Throws:
+            may throw 'std::bad_alloc' if string allocation fails            
+    */
+    //void LoadFromMemory(const std::vector<char>& shaderData, bool append = false);
 
-    //verify size of data again once header is loaded
-    if (rawData.size() < 128 + bufsize)
-    {
-        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(LoadTextureDDS): Raw Data Too Small!"));
-    }
-    
+    /*
+    LoadFromFile
 
-    unsigned int components = (fourCC == FOURCC_DXT1) ? 3 : 4;
-    unsigned int compressedFormat;
-    switch (fourCC)
-    {
-    case FOURCC_DXT1:
-        compressedFormat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
-        break;
-    case FOURCC_DXT3:
-        compressedFormat = GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
-        break;
-    case FOURCC_DXT5:
-        compressedFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
-        break;
-    default:
-        compressedFormat = 0;//uncompressed
-    }
+        Parameters:
+            'filePath': path of the file to open
+            'append': append 'filePath' to 'MTmpShaderText' or clear 'mTmpShaderText'
 
-    // Create one OpenGL texture
-    GLuint textureID;
-    glGenTextures(1, &textureID);
+        Throws:
+            'std::ios_base::failure': if file fails to open or read
+    
+    */
+    //bool LoadFromFile(const std::wstring& filePath, bool append = false);
 
-    //make sure OpenGL successfully created the texture before loading it
-    if (textureID == 0)
-        GLUF_CRITICAL_EXCEPTION(TextureCreationException());
+    /*
+    FlushText
 
+        Throws:
+            no-throw guarantee
+    */
+    void FlushText(void) noexcept { mTmpShaderText.clear(); }
 
-    // "Bind" the newly created texture : all future texture functions will modify this texture
-    glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BASE_LEVEL, 0);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, 0);//REMEMBER it is max mip, NOT mip count
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_SWIZZLE_R, GL_RED);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_SWIZZLE_G, GL_GREEN);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_SWIZZLE_B, GL_BLUE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_SWIZZLE_A, GL_ALPHA);
 
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    /*
+    Compile
+        
+        -Take all of the loaded text and compile into a shader
 
-    //this method is not the prettyest, but it is the easiest to load
-    if (compressedFormat != 0)
-    {
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        Parameters:
+            'retStruct': the returned information about shader compilation.
 
-        unsigned int blockSize = (compressedFormat == GL_COMPRESSED_RGBA_S3TC_DXT1_EXT) ? 8 : 16;
-        unsigned int offset = 128;// initial offset to compensate for header and file code
-
-        unsigned int pertexSize = width;
-
-        unsigned int mipSize = ((pertexSize + 3) / 4)*((pertexSize + 3) / 4)*blockSize;
-        glCompressedTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_X, 
-            0, compressedFormat, 
-            pertexSize, pertexSize,
-            0, mipSize, 
-            rawData.data() + offset);
-        offset += mipSize;
-        glCompressedTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_Z, 
-            0, compressedFormat, 
-            pertexSize, pertexSize,
-            0, mipSize, 
-            rawData.data() + offset);
-        offset += mipSize;
-        glCompressedTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X, 
-            0, compressedFormat, 
-            pertexSize, pertexSize,
-            0, mipSize, 
-            rawData.data() + offset);
-        offset += mipSize;
-        glCompressedTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_Z, 
-            0, compressedFormat, 
-            pertexSize, pertexSize,
-            0, mipSize, 
-            rawData.data() + offset);
-        offset += mipSize;
-        glCompressedTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_Y, 
-            0, compressedFormat, 
-            pertexSize, pertexSize,
-            0, mipSize, 
-            rawData.data() + offset);
-        offset += mipSize;
-        glCompressedTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_Y, 
-            0, compressedFormat, 
-            pertexSize, pertexSize,
-            0, mipSize, 
-            rawData.data() + offset);
+        Throws:
+            'CompileShaderException': if shader compilation fails
+            'CreateGLShaderException': if shader creaetion failes (because shader creation is stalled until compilation)
+    
+    */
+    void Compile(ShaderInfoStruct& retStruct);
 
-    }
-    else
-    {
-        unsigned int offset = 128;// initial offset to compensate for header and file code
-        unsigned int pertexSize = width;
-        unsigned int mipSize = (pertexSize * pertexSize * 4);
-
-        glTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_X, 
-            0, GL_RGBA, 
-            pertexSize, pertexSize, 
-            0, GL_RGBA, GL_UNSIGNED_BYTE, 
-            (const GLvoid*)(rawData.data() + offset));
-        offset += mipSize;
-        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_Z, 
-            0, GL_RGBA, 
-            pertexSize, pertexSize, 
-            0, GL_RGBA, GL_UNSIGNED_BYTE, 
-            (const GLvoid*)(rawData.data() + offset));
-        offset += mipSize;
-        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X, 
-            0, GL_RGBA, 
-            pertexSize, pertexSize, 
-            0, GL_RGBA, GL_UNSIGNED_BYTE, 
-            (const GLvoid*)(rawData.data() + offset));
-        offset += mipSize;
-        glTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_Z, 
-            0, GL_RGBA, 
-            pertexSize, pertexSize, 
-            0, GL_RGBA, GL_UNSIGNED_BYTE, 
-            (const GLvoid*)(rawData.data() + offset));
-        offset += mipSize;
-        glTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_Y, 
-            0, GL_RGBA, 
-            pertexSize, pertexSize, 
-            0, GL_RGBA, GL_UNSIGNED_BYTE,
-            (const GLvoid*)(rawData.data() + offset));
-        offset += mipSize;
-        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_Y, 
-            0, GL_RGBA, 
-            pertexSize, pertexSize, 
-            0, GL_RGBA, GL_UNSIGNED_BYTE, 
-            (const GLvoid*)(rawData.data() + offset));
-    }
+    /*
+    SubmitCompile
 
+        -First half of 'Compile'; hands the text to the driver without waiting for the result
 
-    return textureID;
-}
+        Parameters:
+            'text': text to compile instead of the loaded text, which saves copying it into the shader first
 
+        Throws:
+            'CreateGLShaderException': if shader creation fails
+    */
+    void SubmitCompile();
+    void SubmitCompile(const std::string& text);
 
+    /*
+    FinishCompile
 
-//--------------------------------------------------------------------------------------
-GLuint LoadTextureFromFile(const std::string& filePath, TextureFileFormat format)
-{
-    std::vector<char> memory;
+        -Second half of 'Compile'; blocks until the driver is done compiling
 
-    try
-    {
-        LoadFileIntoMemory(filePath, memory);
-    }
-    catch (const std::ios_base::failure& e)
-    {
-        GLUF_ERROR_LONG("(LoadTextureFromFile): " << e.what());
-    }
+        Parameters:
+            'retStruct': the returned information about shader compilation.
 
-    GLuint texId;
-    try
-    {
-        texId = LoadTextureFromMemory(memory, format);
-    }
-    catch (const TextureCreationException& e)
-    {
-        GLUF_ERROR_LONG("(LoadTextureFromFile): " << e.what());
-        RETHROW;
-    }
+        Throws:
+            'CompileShaderException': if shader compilation fails
+    */
+    void FinishCompile(ShaderInfoStruct& retStruct);
 
-    return texId;
-}
 
+    /*
+    Destroy
 
-//--------------------------------------------------------------------------------------
-GLuint LoadTextureFromMemory(const std::vector<char>& data, TextureFileFormat format)
-{
+        -equivilent to destructor, except object itself is not destroyed (i.e. it can be reused)
 
-    try
-    {
-        switch (format)
-        {
-        case TFF_DDS:
-            return LoadTextureDDS(data);
-        case TTF_DDS_CUBEMAP:
-            return LoadTextureCubemapDDS(data);
-        }
-    }
-    catch (const TextureCreationException& e)
-    {
-        GLUF_ERROR_LONG("(LoadTextureFromMemory): " << e.what());
-        RETHROW;
-    }
-    return 0;
-}
+        Throws:
+            no-throw guarantee
+        
+    */
+    void Destroy() noexcept;
+
+};
+
+using ShaderP = std::pair<ShaderType, ShaderPtr>;
 
 
 /*
+Program
 
-Buffer Utilities
+    Data Members:
+        'mProgramId': OpenGL assigned id
+        'mShaderBuff': buffer of shaders before linking
+        'mAttributeLocations': location of vertex attributes in program
+        'mUniformLocations': location of the uniforms in programs
+        'mUniformTable': open-addressed hash table over the uniforms in 'mUniformLocations' which have a location (so
+            not uniform block members), keyed by 'HashStringFNV1a' of the name; the size is always a power of two, and
+            at most half full
+        'mAttributeInfo': reflection record of each attribute in 'mAttributeLocations'
+        'mUniformInfo': reflection record of each uniform in 'mUniformLocations'
+        'mUniformShadowSlots': where each uniform location's last uploaded value is kept in 'mUniformShadow',
+            indexed by location
+        'mUniformShadow': copy of the value last uploaded to each uniform, so redundant uploads can be skipped
+        'mUniformBlocks': the active uniform blocks, by block name
+        'mStages': the stages which this program uses; initialized if separable set to true
 
 */
-
-//--------------------------------------------------------------------------------------
-const VertexAttribInfo& VertexArrayBase::GetAttribInfoFromLoc(AttribLoc loc) const
+class Program
 {
-    auto val = mAttribInfos.find(loc);
-    if (val == mAttribInfos.end())
-        GLUF_NON_CRITICAL_EXCEPTION(std::invalid_argument("\"loc\" not found in attribute list"));
+    friend ShaderManager;
 
-    return val->second;
-}
+    struct UniformTableEntry
+    {
+        uint64_t mNameHash = 0;
+        const std::string* mName = nullptr;//key in 'mUniformLocations'; nullptr if the slot is empty
+        GLint mLocation = -1;
+    };
 
-//--------------------------------------------------------------------------------------
-VertexArrayBase::VertexArrayBase(GLenum PrimType, GLenum buffUsage, bool index) : mUsageType(buffUsage), mPrimitiveType(PrimType)
-{
-    SWITCH_GL_VERSION
-    GL_VERSION_GREATER_EQUAL(30)
+    struct UniformShadowSlot
     {
-        glGenVertexArrayBindVertexArray(&mVertexArrayId);
+        GLenum mType = GL_NONE;//type the setters upload for this location; GL_NONE if it is not shadowed
+        GLenum mUniformType = GL_NONE;//the reflected type, for checking setters in debug builds
+        uint32_t mOffset = 0;//into 'mUniformShadow'
+        uint32_t mSize = 0;
+        GLint mElementsLeft = 0;//array elements from this location to the end of the array, including this one
+        bool mValid = false;//false until the first upload, since the initial value is not tracked
+    };
 
-        if (mVertexArrayId == 0)
-            GLUF_CRITICAL_EXCEPTION(MakeVOAException());
+    //GLuint mUniformBuffId;
+    GLuint mProgramId;
+    std::map<ShaderType, ShaderPtr > mShaderBuff;
+    VariableLocMap mAttributeLocations;
+    VariableLocMap mUniformLocations;
+    std::vector<UniformTableEntry> mUniformTable;
+    ShaderVariableInfoMap mAttributeInfo;
+    ShaderVariableInfoMap mUniformInfo;
+    std::vector<UniformShadowSlot> mUniformShadowSlots;
+    std::vector<char> mUniformShadow;
+    UniformBlockMap mUniformBlocks;
+    GLbitfield mStages;
 
-    }
+    /*
+    BuildUniformTable
 
-    if (index)
-    {
-        glGenBuffers(1, &mIndexBuffer);
-        if (mIndexBuffer == 0)
-        {
-            GLUF_ERROR("Failed to create index buffer!");
-            GLUF_CRITICAL_EXCEPTION(MakeBufferException());
-        }
+        -Rebuilds 'mUniformTable' from 'mUniformLocations', leaving out the uniforms with location -1; call whenever
+            'mUniformLocations' changes
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+        Throws:
+            may throw 'std::bad_alloc'
+    */
+    void BuildUniformTable();
 
-    }
-}
+    /*
+    BuildUniformShadow
 
-//--------------------------------------------------------------------------------------
-VertexArrayBase::~VertexArrayBase() noexcept
-{
-    BindVertexArray();
+        -Rebuilds 'mUniformShadowSlots' and 'mUniformShadow' from 'mUniformLocations' and 'mUniformInfo', and
+            forgets every uploaded value; call whenever either changes
 
-    glDeleteBuffers(1, &mIndexBuffer);
+        Throws:
+            may throw 'std::bad_alloc'
+    */
+    void BuildUniformShadow();
 
-    SWITCH_GL_VERSION
-    GL_VERSION_GREATER_EQUAL(30)
-        glDeleteVertexArrays(1, &mVertexArrayId);
+    /*
+    LoadUniformBlocks
 
-    UnBindVertexArray();
-}
+        -Reflects 'mUniformBlocks' from the linked program
 
-//--------------------------------------------------------------------------------------
-VertexArrayBase::VertexArrayBase(VertexArrayBase&& other)
-{
-    //set this class
-    mVertexArrayId      = other.mVertexArrayId;
-    mVertexCount        = other.mVertexCount;
-    mUsageType          = other.mUsageType;
-    mPrimitiveType      = other.mPrimitiveType;
-    mAttribInfos        = std::move(other.mAttribInfos);
-    mIndexBuffer        = other.mIndexBuffer;
-    mIndexCount         = other.mIndexCount;
-    mTempVAOId          = other.mTempVAOId;//likely will be 0 anyways
+        Throws:
+            may throw 'std::bad_alloc'
+    */
+    void LoadUniformBlocks();
 
+public:
 
-    //reset other class
-    other.mVertexArrayId        = 0;
-    other.mVertexCount          = 0;
-    other.mUsageType            = GL_STATIC_DRAW;
-    other.mPrimitiveType        = GL_TRIANGLES;
-    //other.mAttribInfos.clear();
-    other.mIndexBuffer          = 0;
-    other.mIndexCount           = 0;
-    other.mTempVAOId            = 0;//likely will be 0 anyways
-}
+    /*
+    Constructor
+        Throws:
+            no-throw guarantee
 
-//--------------------------------------------------------------------------------------
-VertexArrayBase& VertexArrayBase::operator=(VertexArrayBase&& other)
-{
-    //set this class
-    mVertexArrayId = other.mVertexArrayId;
-    mVertexCount = other.mVertexCount;
-    mUsageType = other.mUsageType;
-    mPrimitiveType = other.mPrimitiveType;
-    mAttribInfos = std::move(other.mAttribInfos);
-    mIndexBuffer = other.mIndexBuffer;
-    mIndexCount = other.mIndexCount;
-    mTempVAOId = other.mTempVAOId;//likely will be 0 anyways
+    */
+    Program() noexcept;
+    ~Program() noexcept;
 
+    /*
+    Init
+        Throws:
+            'CreateGLProgramException': OpenGL failed to create program using glCreateProgram
+    */
+    void Init();
 
-    //reset other class
-    other.mVertexArrayId = 0;
-    other.mVertexCount = 0;
-    other.mUsageType = GL_STATIC_DRAW;
-    other.mPrimitiveType = GL_TRIANGLES;
-    //other.mAttribInfos.clear();
-    other.mIndexBuffer = 0;
-    other.mIndexCount = 0;
-    other.mTempVAOId = 0;//likely will be 0 anyways
+    /*
+    AttachShader
+        
+        Note:
+            if a shader already exists for that stage, it will be overwritten
 
-    return *this;
-}
+        Parameters:
+            'shader': pointer to shader which is being attached
 
-//--------------------------------------------------------------------------------------
-void VertexArrayBase::AddVertexAttrib(const VertexAttribInfo& info)
-{
-    //don't do null checks, because BindVertexArray already does them for us
-    BindVertexArray();
+        Throws:
+            'std::invalid_argument': if 'shader == nullptr' or 'shader' is invalid
+    */
+    void AttachShader(ShaderPtr shader);
 
-    //make sure the attribute contains valid data
-    if (info.mBytesPerElement == 0 || info.mElementsPerValue == 0)
-        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("Invalid Data in Vertex Attribute Info!"));
+    /*
+    FlushShaders
 
-    mAttribInfos.insert(std::pair<AttribLoc, VertexAttribInfo>(info.mVertexAttribLocation, info));
+        -Flush shader cache, but does not explicitly delete shaders
 
-    //this is a bit inefficient to refresh every time an attribute is added, but this should not be significant
-    RefreshDataBufferAttribute();
+        Throws:
+            no-throw guarantee
+    */
+    void FlushShaders(void) noexcept;
 
-    //enable the new attribute
-    glEnableVertexAttribArray(info.mVertexAttribLocation);
 
-    UnBindVertexArray();
-}
+    /*
+    Build
+        
+        Parameters:
+            'retStruct': the returned information about program linking.  i.e. 'mSuccess'
+            'separate': whether this program will be used 'separately' (see OpenGL docs for definition)
 
-//--------------------------------------------------------------------------------------
-void VertexArrayBase::RemoveVertexAttrib(AttribLoc loc)
-{
-    auto val = mAttribInfos.find(loc);
-    if (val == mAttribInfos.end())
-        GLUF_NON_CRITICAL_EXCEPTION(std::invalid_argument("\"loc\" not found in attribute list"));
+        Throws:
+            'LinkProgramException': if program linking fails
+    */
+    void Build(ShaderInfoStruct& retStruct, bool separate);
 
-    mAttribInfos.erase(val);
+    /*
+    SubmitBuild
 
-    RefreshDataBufferAttribute();
-}
+        -First half of 'Build'; starts linking without waiting for the result
 
-//--------------------------------------------------------------------------------------
-void VertexArrayBase::BindVertexArray() noexcept
-{
-    SWITCH_GL_VERSION
-    GL_VERSION_GREATER_EQUAL(30)
-    {
-        //store the old one before binding this one
-        GLint tmpVAOId = 0;
-        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &tmpVAOId);
-        mTempVAOId = static_cast<GLuint>(tmpVAOId);
+        Parameters:
+            'separate': whether this program will be used 'separately' (see OpenGL docs for definition)
+    */
+    void SubmitBuild(bool separate);
 
-        glBindVertexArray(mVertexArrayId);
-    }
-}
+    /*
+    FinishBuild
 
-//--------------------------------------------------------------------------------------
-void VertexArrayBase::UnBindVertexArray() noexcept
-{    
-    SWITCH_GL_VERSION
-    GL_VERSION_GREATER_EQUAL(30)
-    {
-        glBindVertexArray(mTempVAOId);
-        mTempVAOId = 0;
-    }
-}
+        -Second half of 'Build'; blocks until the link is done, unless 'IsBuildComplete' returned true
 
-//--------------------------------------------------------------------------------------
-void VertexArrayBase::Draw() noexcept
-{
-    BindVertexArray();
+        Parameters:
+            'retStruct': the returned information about program linking.  i.e. 'mSuccess'
+
+        Throws:
+            'LinkProgramException': if program linking fails
+    */
+    void FinishBuild(ShaderInfoStruct& retStruct);
+
+    /*
+    IsBuildComplete
+
+        Returns:
+            true if 'FinishBuild' will not block; always true without GL_ARB/KHR_parallel_shader_compile
+    */
+    bool IsBuildComplete() const;
+
+    /*
+    GetId
+
+        Returns:
+            OpenGL Id of the program
+    */
+    GLuint GetId(){ return mProgramId; }
+
+
+    /*
+    Destroy
+
+        -equivilent to destructor, except object itself is not destroyed (i.e. it can be reused)
+
+        Throws:
+            no-throw guarantee
+
+    */
+    void Destroy() noexcept;
+
+    /*
+    GetBitfield()
+
+        Returns:
+            GLbitfield of the program's stages; this is used when initializing and adding to PPO's
+    */
+    GLbitfield GetBitfield() const noexcept;
+
+    /*
+    FindUniform
+
+        Parameters:
+            'nameHash': 'HashStringFNV1a' of the uniform's name
+            'name': the name itself, to rule out hash collisions; nullptr to trust the hash
+
+        Returns:
+            location of the uniform, or -1 if the program does not have it
+
+        Throws:
+            no-throw guarantee
+    */
+    GLint FindUniform(uint64_t nameHash, const std::string* name = nullptr) const noexcept;
+};
+
+/*
+SeparateProgram
+
+
+    Data Members:
+        'mPPOId': id of programmible pipeline object
+        'mPrograms': list of programs used; kept here so they do not delete themselves while this pipeline object exists
+        'mActiveProgram': the currently active program which is having uniforms buffered
+
+*/
+class SeparateProgram
+{
+    friend ShaderManager;
+    GLuint mPPOId;
+
+    ProgramPtrList mPrograms;//so the programs don't go deleting themselves until the PPO is destroyed
+
+    ProgramPtr mActiveProgram;//this is used as the 'active program' when assigning uniforms
+
+public:
+    SeparateProgram();
+    ~SeparateProgram();
+
+    /*
+    Init
+
+        Throws:
+            'CreateGLPPOException': if opengl creation of PPO failed
+    */
+    void Init();
+    
+    /*
+    AttachProgram
+
+        Parameters:
+            'program': program to attach
+
+        Throws:
+            no-throw guarantee
+
+    */
+    void AttachProgram(const ProgramPtr& program);
+
+    /*
+    ClearStages
+
+        -Removes the give stages
+
+        Parameters:
+            'stages': bitfield of stages, default value is all of them
+
+        Throws:
+            no-throw guarantee
+    
+    */
+    void ClearStages(GLbitfield stages = GL_ALL_SHADER_BITS);
+
+    /*
+    SetActiveShaderProgram
+
+        Parameters:
+            'stage': the stage of which program will be active
+
+        Throws:
+            no-throw guarantee
+    
+    */
+    void SetActiveShaderProgram(ProgramStage stage);
+
+
+    /*
+    GetId
+
+        Returns:
+            id of ppo object
+    
+    */
+    GLuint GetId()const noexcept{ return mPPOId; }
+
+    /*
+    GetActiveProgram
+
+        Returns:
+            the active program
+
+        Throws:
+            'std::exception' if there is no active program
+
+    */
+    const ProgramPtr& GetActiveProgram() const;
+
+};
+
+
+
+/*
+PendingProgram
+
+    Data Members:
+        'mShaders': shaders submitted for this program, kept until the compile results are checked
+        'mProgram': the program being linked, or the finished program once resolved
+        'mError': exception from submission, rethrown (and logged) on resolution; after resolution, the final error
+        'mCacheDir': binary cache to store the program in once it links; empty if the cache is not used
+        'mCacheKey': key of the program in the binary cache
+        'mFromCache': the program was loaded from the binary cache, so there is nothing to wait on
+        'mResolved': 'ResolveProgram' has already checked the results
+
+*/
+class PendingProgram
+{
+    friend ShaderManager;
+
+    ShaderPtrList mShaders;
+    ProgramPtr mProgram;
+    std::exception_ptr mError;
+
+    std::string mCacheDir;
+    uint64_t mCacheKey = 0;
+    bool mFromCache = false;
+    bool mResolved = false;
+};
+
+
+/*
+===================================================================================================
+SeparateProgram Methods
+
+
+*/
+
+//--------------------------------------------------------------------------------------
+SeparateProgram::SeparateProgram()
+{
+    //prevents from attempting to create separate shaders w/o the extension
+    ASSERT_EXTENTION(GL_ARB_separate_shader_objects);
+}
+
+//--------------------------------------------------------------------------------------
+SeparateProgram::~SeparateProgram()
+{
+    GLSTATE.DeleteProgramPipelines(1, &mPPOId);
+}
+
+//--------------------------------------------------------------------------------------
+void SeparateProgram::Init()
+{
+    glGenProgramPipelines(1, &mPPOId);
+
+    if (mPPOId == 0)
+    {
+        GLUF_CRITICAL_EXCEPTION(CreateGLPPOException());
+    }
+}
+
+//--------------------------------------------------------------------------------------
+void SeparateProgram::AttachProgram(const ProgramPtr& program)
+{
+    GLSTATE.BindProgramPipeline(mPPOId);
+    mPrograms.push_back(program); 
+    glUseProgramStages(mPPOId, program->GetBitfield(), program->GetId());
+}
+
+//--------------------------------------------------------------------------------------
+void SeparateProgram::ClearStages(GLbitfield stages)
+{
+    glUseProgramStages(mPPOId, stages, 0);
+
+    //remove the programs that are affected by this clear
+    for (auto it = mPrograms.begin(); it != mPrograms.end(); ++it)
+    {
+        //if any of the bits of this bitfield are the same, then remove the program.  NOTE: IT IS BAD PRACTICE TO HAVE PROGRAMS HAVE MULTIPLE STAGES, AND ONLY REMOVE ONE OF THEM
+        if (((*it)->GetBitfield() & stages) != 0)
+            mPrograms.erase(it);
+    }
+}
+
+//--------------------------------------------------------------------------------------
+void SeparateProgram::SetActiveShaderProgram(ProgramStage stage)
+{
+    GLSTATE.BindProgramPipeline(mPPOId);
+
+    //does the currently bound program have this stage?
+    if (mActiveProgram)
+        if ((mActiveProgram->GetBitfield() & stage) != 0)
+            return;//do nothing
+    
+    //find which program contains this stage
+    bool success = false;
+    for (auto it : mPrograms)
+    {
+        if ((it->GetBitfield() & stage) != 0)
+        {
+            mActiveProgram = it;
+            success = true;
+            break;
+        }
+    }
+
+    if (!success)
+    {
+        //if the stage does not exist, reset to default (null)
+        mActiveProgram = nullptr;
+        glActiveShaderProgram(mPPOId, 0);
+
+    }
+    else
+    {
+        glActiveShaderProgram(mPPOId, mActiveProgram->GetId());
+    }
+}
+
+//--------------------------------------------------------------------------------------
+const ProgramPtr& SeparateProgram::GetActiveProgram() const
+{
+    if (mActiveProgram == nullptr)
+    {
+        GLUF_NON_CRITICAL_EXCEPTION(NoActiveProgramUniformException());
+    }
+
+    return mActiveProgram;
+}
+
+
+/*
+===================================================================================================
+Shader Methods
+
+
+*/
+
+
+//--------------------------------------------------------------------------------------
+Shader::Shader() noexcept 
+{
+    mShaderId = 0;
+}
+
+//--------------------------------------------------------------------------------------
+Shader::~Shader() noexcept 
+{
+    if (mShaderId != 0)
+    {
+        glDeleteShader(mShaderId);
+    }
+    mTmpShaderText.clear();
+}
+
+//--------------------------------------------------------------------------------------
+void Shader::Init(ShaderType shaderType) noexcept 
+{
+    mShaderType = shaderType;
+    mShaderId = 0;
+}
+
+//--------------------------------------------------------------------------------------
+void Shader::Load(const std::string& shaderText, bool append)
+{
+    if (!append)
+        mTmpShaderText.clear();
+
+    mTmpShaderText.append(shaderText);
+}
+
+//--------------------------------------------------------------------------------------
+void Shader::Destroy() noexcept 
+{
+    if (mShaderId != 0)
+    {
+        glDeleteShader(mShaderId);
+        mShaderId = 0;
+    }
+    mTmpShaderText.clear();
+}
+
+//--------------------------------------------------------------------------------------
+/*void Shader::LoadFromMemory(const std::vector<char>& shaderData, bool append)
+{
+    if (!append)
+        mTmpShaderText.clear();
+
+    std::string loadedText;
+
+    try
+    {
+        LoadBinaryArrayIntoString(shaderData, loadedText);
+    }
+    catch (...)
+    {
+        GLUF_ERROR("(Shader): Failed to load binary memory into shader string");
+        throw;
+    }
+
+    
+    mTmpShaderText += loadedText;
+
+}*/
+
+//--------------------------------------------------------------------------------------
+/*bool Shader::LoadFromFile(const std::wstring& filePath, bool append)
+{
+    if (!append)
+        mTmpShaderText.clear();
+
+    std::ifstream inFile(filePath);
+    inFile.exceptions(std::ios::badbit | std::ios::failbit);
+
+    try
+    {
+#pragma warning (disable : 4244)
+        std::string newString;
+
+        inFile.seekg(0, std::ios::end);
+        newString.resize(inFile.tellg());
+        inFile.seekg(0, std::ios::beg);
+
+        //TODO: DOES THIS NEED TO HAVE A +1 SOMEWHERE TO ACCOUNT FOR NULL CHARACTER
+        inFile.read(&newString[0], newString.size());
+        inFile.close();
+    }
+    catch (...)
+    {
+        GLUF_ERROR("(Shader): Failed to load shader text from file!");
+        throw;
+    }
+
+    return true;
+}*/
+
+#define FAILED_COMPILE 'F'
+#define FAILED_LINK    'F'
+
+
+//--------------------------------------------------------------------------------------
+void Shader::Compile(ShaderInfoStruct& returnStruct)
+{
+    //if the shader id is not 0, this means the previous compile attempt was successful, because if it was not, the program is deleted and reset to 0
+    if (mShaderId != 0)
+    {
+        returnStruct.mSuccess = false;
+        returnStruct.mLog = "F";
+        return;
+    }
+
+    SubmitCompile();
+    FinishCompile(returnStruct);
+}
+
+//--------------------------------------------------------------------------------------
+void Shader::SubmitCompile()
+{
+    //start by adding the strings to glShader Source.  This is done right before the compile
+    //process becuase it is hard to remove it if there is any reason to flush the text
+    SubmitCompile(mTmpShaderText);
+
+    //flush text upon compile no matter what (if compile failed, why would we want to keep the error-ridden code)
+    FlushText();
+}
+
+//--------------------------------------------------------------------------------------
+void Shader::SubmitCompile(const std::string& text)
+{
+    //create the shader
+    mShaderId = glCreateShader(mShaderType);
+
+    //if shader creation failed, throw an exception
+    if (mShaderId == 0)
+        GLUF_CRITICAL_EXCEPTION(CreateGLShaderException());
+
+    //the driver reads straight from 'text'; the length is exact, so it does not need to be terminated
+    GLint length = static_cast<GLint>(text.length());
+    const GLchar* source = text.c_str();
+    glShaderSource(mShaderId, 1, &source, &length);
+
+    glCompileShader(mShaderId);
+}
+
+//--------------------------------------------------------------------------------------
+void Shader::FinishCompile(ShaderInfoStruct& returnStruct)
+{
+    GLint isCompiled = 0;
+    glGetShaderiv(mShaderId, GL_COMPILE_STATUS, &isCompiled);
+    returnStruct.mSuccess = (isCompiled == GL_FALSE) ? false : true;
+
+    GLint maxLength = 0;
+    glGetShaderiv(mShaderId, GL_INFO_LOG_LENGTH, &maxLength);
+
+    //The maxLength includes the NULL character
+    returnStruct.mLog.resize(maxLength);
+    glGetShaderInfoLog(mShaderId, maxLength, &maxLength, &returnStruct.mLog[0]);
+
+    //Provide the infolog in whatever manor you deem best.
+    //Exit with failure.
+
+    //if it failed, delete the shader, to have a universal way of determining failure
+    if (returnStruct.mSuccess == false)
+    {
+        glDeleteShader(mShaderId);
+        mShaderId = 0;
+        GLUF_CRITICAL_EXCEPTION(CompileShaderException());
+    }
+    return;
+}
+
+
+
+
+
+/*
+===================================================================================================
+Program Methods
+
+
+*/
+
+//--------------------------------------------------------------------------------------
+Program::Program() noexcept 
+{
+    mProgramId = 0;
+    mStages = 0;
+}
+
+//--------------------------------------------------------------------------------------
+Program::~Program() noexcept 
+{
+    GLSTATE.DeleteProgram(mProgramId);
+}
+
+//--------------------------------------------------------------------------------------
+void Program::Init()
+{
+    //unlike with the shader, this will be created during initialization
+    mProgramId = glCreateProgram();
+
+    if (mProgramId == 0)
+        GLUF_CRITICAL_EXCEPTION(CreateGLProgramException());
+}
+
+//--------------------------------------------------------------------------------------
+void Program::AttachShader(ShaderPtr shader)
+{
+    ShaderP toInsert{ shader->mShaderType, shader };
+    
+    //does this stage already have a shader assigned to it?
+    auto exists = mShaderBuff.find(shader->mShaderType);
+    if (exists != mShaderBuff.end())
+    {
+        //if it does, delete it
+        mShaderBuff.erase(exists);
+    }
+
+    //finally, insert the new one
+    mShaderBuff.insert(toInsert);
+
+    //and add it to OpenGL
+    glAttachShader(mProgramId, shader->mShaderId);
+}
+
+//--------------------------------------------------------------------------------------
+void Program::FlushShaders(void) noexcept 
+{
+    //simply go through all of the shaders, remove them, and clear the shader buffer
+    for (auto it : mShaderBuff)
+    {
+        glDetachShader(mProgramId, it.second->mShaderId);
+    }
+    mShaderBuff.clear();
+}
+
+//--------------------------------------------------------------------------------------
+void Program::Build(ShaderInfoStruct& retStruct, bool separate)
+{
+    SubmitBuild(separate);
+    FinishBuild(retStruct);
+}
+
+//--------------------------------------------------------------------------------------
+void Program::SubmitBuild(bool separate)
+{
+    GLUF_PROFILE_ZONE("Program::SubmitBuild");
+
+    //make sure we enable separate shading
+    if (separate)
+    { 
+        mStages = 0;
+
+        glProgramParameteri(mProgramId, GL_PROGRAM_SEPARABLE, GL_TRUE); 
+
+
+        //also create the 'mStages' list
+
+        for (auto it : mShaderBuff)
+        {
+            mStages |= ShaderTypeToProgramStage(it.first);
+        }
+    }
+
+    //Link our program
+    glLinkProgram(mProgramId);
+}
+
+//--------------------------------------------------------------------------------------
+bool Program::IsBuildComplete() const
+{
+    if (!HasParallelShaderCompile())
+        return true;
+
+    GLint isComplete = GL_FALSE;
+    glGetProgramiv(mProgramId, GL_COMPLETION_STATUS_ARB, &isComplete);
+    return isComplete != GL_FALSE;
+}
+
+//--------------------------------------------------------------------------------------
+void Program::FinishBuild(ShaderInfoStruct& retStruct)
+{
+    GLUF_PROFILE_ZONE("Program::FinishBuild");
+
+    //Note the different functions here: glGetProgram* instead of glGetShader*.
+    GLint isLinked = 0;
+    glGetProgramiv(mProgramId, GL_LINK_STATUS, &isLinked);
+    retStruct.mSuccess = (isLinked == GL_FALSE) ? false : true;
+
+    GLint maxLength = 0;
+    glGetProgramiv(mProgramId, GL_INFO_LOG_LENGTH, &maxLength);
+
+    //The maxLength includes the NULL character
+    retStruct.mLog.resize(maxLength);
+    glGetProgramInfoLog(mProgramId, maxLength, &maxLength, &retStruct.mLog[0]);
+
+    if (!retStruct.mSuccess)
+    {
+        //in the case of failure, DO NOT DELETE ANYTHING, but do throw an error
+        GLUF_CRITICAL_EXCEPTION(LinkProgramException());
+    }
+    else
+    {
+        FlushShaders();//this removes the references to them from the program, but they will still exist unless this is the last reference to them
+        
+        /*
+        
+        This region loads uniform and attribute locations
+
+        */
+        
+        
+        //Load the variable names
+        GLint attribCount = 0;
+        glGetProgramiv(mProgramId, GL_ACTIVE_ATTRIBUTES, &attribCount);
+
+        GLint maxLength;
+        glGetProgramiv(mProgramId, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxLength);
+
+        GLenum type;
+        GLint written, size;
+
+        //this is used to trim the null charactors from the end of the string
+        const auto TrimString = [](std::string& toTrim)
+        {
+            for (unsigned int i = 0; i < toTrim.size(); ++i)
+            {
+                if (toTrim[i] == '\0')
+                {
+                    toTrim.erase(toTrim.begin() + i, toTrim.end());
+                    break;
+                }
+
+            }
+        };
+
+
+        std::string data;
+        for (int i = 0; i < attribCount; ++i)
+        {
+            //resize and clear every time is a bit messy, but is the only way to make sure the string is the right length
+            data.resize(maxLength);
+
+            glGetActiveAttrib(mProgramId, i, maxLength, &written, &size, &type, &data[0]);
+            TrimString(data);
+
+            ShaderVariableInfo& info = mAttributeInfo[data];
+            info.mType = type;
+            info.mArraySize = size;
+            info.mLocation = glGetAttribLocation(mProgramId, &data[0]);
+            mAttributeLocations.insert(VariableLocPair(data, info.mLocation));
+
+            data.clear();
+        }
+
+        GLint uniformCount = 0;
+        glGetProgramiv(mProgramId, GL_ACTIVE_UNIFORMS, &uniformCount);
+
+        //uniform names can be longer than any attribute's
+        glGetProgramiv(mProgramId, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+        //block layout is queried for every uniform at once, in active uniform order
+        std::vector<std::string> uniformNames;
+        uniformNames.reserve(uniformCount);
+
+        for (int i = 0; i < uniformCount; ++i)
+        {
+            //resize and clear every time is a bit messy, but is the only way to make sure the string is the right length
+            data.resize(maxLength);
+
+            glGetActiveUniform(mProgramId, i, maxLength, &written, &size, &type, &data[0]);
+            TrimString(data);
+
+            ShaderVariableInfo& info = mUniformInfo[data];
+            info.mType = type;
+            info.mArraySize = size;
+            info.mLocation = glGetUniformLocation(mProgramId, &data[0]);
+            mUniformLocations.insert(VariableLocPair(data, info.mLocation));
+            uniformNames.push_back(data);
+
+            data.clear();
+        }
+
+        if (uniformCount > 0 && (gGLVersion2Digit >= 31 || gExtensions.HasExtension("GL_ARB_uniform_buffer_object")))
+        {
+            std::vector<GLuint> indices(uniformCount);
+            for (GLuint i = 0; i < static_cast<GLuint>(uniformCount); ++i)
+                indices[i] = i;
+
+            const GLenum properties[] = { GL_UNIFORM_BLOCK_INDEX, GL_UNIFORM_OFFSET, GL_UNIFORM_ARRAY_STRIDE, GL_UNIFORM_MATRIX_STRIDE };
+            std::vector<GLint> values[4];
+            for (unsigned int j = 0; j < 4; ++j)
+            {
+                values[j].assign(uniformCount, -1);
+                glGetActiveUniformsiv(mProgramId, uniformCount, indices.data(), properties[j], values[j].data());
+            }
+
+            for (int i = 0; i < uniformCount; ++i)
+            {
+                //the offset and strides only mean something inside a block
+                ShaderVariableInfo& info = mUniformInfo[uniformNames[i]];
+                info.mBlockIndex = values[0][i];
+                if (info.mBlockIndex >= 0)
+                {
+                    info.mOffset = values[1][i];
+                    info.mArrayStride = values[2][i];
+                    info.mMatrixStride = values[3][i];
+                }
+            }
+        }
+
+        BuildUniformTable();
+        BuildUniformShadow();
+        LoadUniformBlocks();
+    }
+}
+
+//--------------------------------------------------------------------------------------
+void Program::BuildUniformTable()
+{
+    std::size_t capacity = 8;
+    while (capacity < mUniformLocations.size() * 2)
+        capacity *= 2;
+
+    mUniformTable.assign(capacity, UniformTableEntry());
+
+    for (const auto& it : mUniformLocations)
+    {
+        //block members have no location to find
+        if (static_cast<GLint>(it.second) == -1)
+            continue;
+
+        UniformTableEntry entry;
+        entry.mNameHash = HashBytesFNV1a(it.first.data(), it.first.size());
+        entry.mName = &it.first;
+        entry.mLocation = static_cast<GLint>(it.second);
+
+        //linear probing; the table is never more than half full, so this always finds a slot quickly
+        std::size_t slot = static_cast<std::size_t>(entry.mNameHash) & (capacity - 1);
+        while (mUniformTable[slot].mName != nullptr)
+        {
+            if (mUniformTable[slot].mNameHash == entry.mNameHash)
+            {
+                GLUF_ERROR_LONG("(Program): Uniforms \"" << *mUniformTable[slot].mName << "\" and \"" << it.first << "\" Have the Same Name Hash; Handles Will Only Find the First");
+            }
+            slot = (slot + 1) & (capacity - 1);
+        }
+        mUniformTable[slot] = entry;
+    }
+}
+
+//--------------------------------------------------------------------------------------
+GLenum GetUniformSetterType(GLenum type) noexcept
+{
+    switch (type)
+    {
+    case GL_FLOAT:
+    case GL_FLOAT_VEC2:
+    case GL_FLOAT_VEC3:
+    case GL_FLOAT_VEC4:
+    case GL_INT:
+    case GL_INT_VEC2:
+    case GL_INT_VEC3:
+    case GL_INT_VEC4:
+    case GL_UNSIGNED_INT:
+    case GL_UNSIGNED_INT_VEC2:
+    case GL_UNSIGNED_INT_VEC3:
+    case GL_UNSIGNED_INT_VEC4:
+    case GL_FLOAT_MAT2:
+    case GL_FLOAT_MAT3:
+    case GL_FLOAT_MAT4:
+    case GL_FLOAT_MAT2x3:
+    case GL_FLOAT_MAT2x4:
+    case GL_FLOAT_MAT3x2:
+    case GL_FLOAT_MAT3x4:
+    case GL_FLOAT_MAT4x2:
+    case GL_FLOAT_MAT4x3:
+        return type;
+
+    //booleans are almost always set with 'GLUniform*i'
+    case GL_BOOL:
+        return GL_INT;
+    case GL_BOOL_VEC2:
+        return GL_INT_VEC2;
+    case GL_BOOL_VEC3:
+        return GL_INT_VEC3;
+    case GL_BOOL_VEC4:
+        return GL_INT_VEC4;
+
+    //samplers and images are only ever set with 'GLUniform1i'
+    case GL_SAMPLER_1D:
+    case GL_SAMPLER_2D:
+    case GL_SAMPLER_3D:
+    case GL_SAMPLER_CUBE:
+    case GL_SAMPLER_1D_SHADOW:
+    case GL_SAMPLER_2D_SHADOW:
+    case GL_SAMPLER_1D_ARRAY:
+    case GL_SAMPLER_2D_ARRAY:
+    case GL_SAMPLER_1D_ARRAY_SHADOW:
+    case GL_SAMPLER_2D_ARRAY_SHADOW:
+    case GL_SAMPLER_2D_MULTISAMPLE:
+    case GL_SAMPLER_2D_MULTISAMPLE_ARRAY:
+    case GL_SAMPLER_CUBE_SHADOW:
+    case GL_SAMPLER_BUFFER:
+    case GL_SAMPLER_2D_RECT:
+    case GL_SAMPLER_2D_RECT_SHADOW:
+    case GL_SAMPLER_CUBE_MAP_ARRAY_ARB:
+    case GL_SAMPLER_CUBE_MAP_ARRAY_SHADOW_ARB:
+    case GL_INT_SAMPLER_1D:
+    case GL_INT_SAMPLER_2D:
+    case GL_INT_SAMPLER_3D:
+    case GL_INT_SAMPLER_CUBE:
+    case GL_INT_SAMPLER_1D_ARRAY:
+    case GL_INT_SAMPLER_2D_ARRAY:
+    case GL_INT_SAMPLER_2D_MULTISAMPLE:
+    case GL_INT_SAMPLER_2D_MULTISAMPLE_ARRAY:
+    case GL_INT_SAMPLER_BUFFER:
+    case GL_INT_SAMPLER_2D_RECT:
+    case GL_INT_SAMPLER_CUBE_MAP_ARRAY_ARB:
+    case GL_UNSIGNED_INT_SAMPLER_1D:
+    case GL_UNSIGNED_INT_SAMPLER_2D:
+    case GL_UNSIGNED_INT_SAMPLER_3D:
+    case GL_UNSIGNED_INT_SAMPLER_CUBE:
+    case GL_UNSIGNED_INT_SAMPLER_1D_ARRAY:
+    case GL_UNSIGNED_INT_SAMPLER_2D_ARRAY:
+    case GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE:
+    case GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE_ARRAY:
+    case GL_UNSIGNED_INT_SAMPLER_BUFFER:
+    case GL_UNSIGNED_INT_SAMPLER_2D_RECT:
+    case GL_UNSIGNED_INT_SAMPLER_CUBE_MAP_ARRAY_ARB:
+    case GL_IMAGE_1D:
+    case GL_IMAGE_2D:
+    case GL_IMAGE_3D:
+    case GL_IMAGE_2D_RECT:
+    case GL_IMAGE_CUBE:
+    case GL_IMAGE_BUFFER:
+    case GL_IMAGE_1D_ARRAY:
+    case GL_IMAGE_2D_ARRAY:
+    case GL_IMAGE_CUBE_MAP_ARRAY:
+    case GL_IMAGE_2D_MULTISAMPLE:
+    case GL_IMAGE_2D_MULTISAMPLE_ARRAY:
+    case GL_INT_IMAGE_1D:
+    case GL_INT_IMAGE_2D:
+    case GL_INT_IMAGE_3D:
+    case GL_INT_IMAGE_2D_RECT:
+    case GL_INT_IMAGE_CUBE:
+    case GL_INT_IMAGE_BUFFER:
+    case GL_INT_IMAGE_1D_ARRAY:
+    case GL_INT_IMAGE_2D_ARRAY:
+    case GL_INT_IMAGE_CUBE_MAP_ARRAY:
+    case GL_INT_IMAGE_2D_MULTISAMPLE:
+    case GL_INT_IMAGE_2D_MULTISAMPLE_ARRAY:
+    case GL_UNSIGNED_INT_IMAGE_1D:
+    case GL_UNSIGNED_INT_IMAGE_2D:
+    case GL_UNSIGNED_INT_IMAGE_3D:
+    case GL_UNSIGNED_INT_IMAGE_2D_RECT:
+    case GL_UNSIGNED_INT_IMAGE_CUBE:
+    case GL_UNSIGNED_INT_IMAGE_BUFFER:
+    case GL_UNSIGNED_INT_IMAGE_1D_ARRAY:
+    case GL_UNSIGNED_INT_IMAGE_2D_ARRAY:
+    case GL_UNSIGNED_INT_IMAGE_CUBE_MAP_ARRAY:
+    case GL_UNSIGNED_INT_IMAGE_2D_MULTISAMPLE:
+    case GL_UNSIGNED_INT_IMAGE_2D_MULTISAMPLE_ARRAY:
+        return GL_INT;
+
+    //doubles and anything newer have no setters, so they are never shadowed
+    default:
+        return GL_NONE;
+    }
+}
+
+//--------------------------------------------------------------------------------------
+uint32_t GetUniformSetterSize(GLenum setterType) noexcept
+{
+    switch (setterType)
+    {
+    case GL_FLOAT:
+    case GL_INT:
+    case GL_UNSIGNED_INT:
+        return 4;
+    case GL_FLOAT_VEC2:
+    case GL_INT_VEC2:
+    case GL_UNSIGNED_INT_VEC2:
+        return 8;
+    case GL_FLOAT_VEC3:
+    case GL_INT_VEC3:
+    case GL_UNSIGNED_INT_VEC3:
+        return 12;
+    case GL_FLOAT_VEC4:
+    case GL_INT_VEC4:
+    case GL_UNSIGNED_INT_VEC4:
+    case GL_FLOAT_MAT2:
+        return 16;
+    case GL_FLOAT_MAT2x3:
+    case GL_FLOAT_MAT3x2:
+        return 24;
+    case GL_FLOAT_MAT2x4:
+    case GL_FLOAT_MAT4x2:
+        return 32;
+    case GL_FLOAT_MAT3:
+        return 36;
+    case GL_FLOAT_MAT3x4:
+    case GL_FLOAT_MAT4x3:
+        return 48;
+    case GL_FLOAT_MAT4:
+        return 64;
+    default:
+        return 0;
+    }
+}
+
+//--------------------------------------------------------------------------------------
+//OpenGL lets booleans be set with the float, int, or unsigned int setter of the same size
+bool UniformSetterMatches(GLenum uniformType, GLenum setterType) noexcept
+{
+    if (GetUniformSetterType(uniformType) == setterType)
+        return true;
+
+    switch (uniformType)
+    {
+    case GL_BOOL:
+        return setterType == GL_FLOAT || setterType == GL_UNSIGNED_INT;
+    case GL_BOOL_VEC2:
+        return setterType == GL_FLOAT_VEC2 || setterType == GL_UNSIGNED_INT_VEC2;
+    case GL_BOOL_VEC3:
+        return setterType == GL_FLOAT_VEC3 || setterType == GL_UNSIGNED_INT_VEC3;
+    case GL_BOOL_VEC4:
+        return setterType == GL_FLOAT_VEC4 || setterType == GL_UNSIGNED_INT_VEC4;
+    default:
+        return false;
+    }
+}
+
+//--------------------------------------------------------------------------------------
+void Program::BuildUniformShadow()
+{
+    //locations are small in practice; anything past this is just not shadowed rather than growing the slot list
+    const GLuint maxShadowedLocation = 4096;
+
+    mUniformShadowSlots.clear();
+    mUniformShadow.clear();
+
+    uint32_t shadowSize = 0;
+    for (const auto& it : mUniformLocations)
+    {
+        auto typeIt = mUniformInfo.find(it.first);
+        if (typeIt == mUniformInfo.end())
+            continue;
+
+        GLenum setterType = GetUniformSetterType(typeIt->second.mType);
+        uint32_t size = GetUniformSetterSize(setterType);
+        if (size == 0)
+            continue;
+
+        //array elements each get their own consecutive location, starting with the one for "name[0]"
+        GLuint elementCount = static_cast<GLuint>(std::max(typeIt->second.mArraySize, 1));
+        for (GLuint i = 0; i < elementCount; ++i)
+        {
+            GLuint location = it.second + i;
+            if (it.second == static_cast<GLuint>(-1) || location >= maxShadowedLocation)
+                break;
+
+            if (location >= mUniformShadowSlots.size())
+                mUniformShadowSlots.resize(location + 1);
+
+            UniformShadowSlot& slot = mUniformShadowSlots[location];
+            slot.mType = setterType;
+            slot.mUniformType = typeIt->second.mType;
+            slot.mOffset = shadowSize;
+            slot.mSize = size;
+            slot.mElementsLeft = static_cast<GLint>(elementCount - i);
+            shadowSize += size;
+        }
+    }
+
+    mUniformShadow.resize(shadowSize);
+}
+
+//--------------------------------------------------------------------------------------
+void Program::LoadUniformBlocks()
+{
+    mUniformBlocks.clear();
+
+    if (gGLVersion2Digit < 31 && !gExtensions.HasExtension("GL_ARB_uniform_buffer_object"))
+        return;
+
+    GLint blockCount = 0;
+    glGetProgramiv(mProgramId, GL_ACTIVE_UNIFORM_BLOCKS, &blockCount);
+
+    GLint maxLength = 0;
+    glGetProgramiv(mProgramId, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxLength);
+
+    std::string name;
+    for (GLint i = 0; i < blockCount; ++i)
+    {
+        GLsizei written = 0;
+        name.resize(std::max(maxLength, 1));
+        glGetActiveUniformBlockName(mProgramId, i, maxLength, &written, &name[0]);
+        name.resize(written);
+
+        GLint binding = 0;
+        UniformBlockInfo info;
+        info.mIndex = static_cast<GLuint>(i);
+        glGetActiveUniformBlockiv(mProgramId, i, GL_UNIFORM_BLOCK_BINDING, &binding);
+        glGetActiveUniformBlockiv(mProgramId, i, GL_UNIFORM_BLOCK_DATA_SIZE, &info.mDataSize);
+        info.mBinding = static_cast<GLuint>(binding);
+
+        mUniformBlocks[name] = info;
+    }
+}
+
+//--------------------------------------------------------------------------------------
+GLint Program::FindUniform(uint64_t nameHash, const std::string* name) const noexcept
+{
+    if (mUniformTable.empty())
+        return -1;
+
+    std::size_t mask = mUniformTable.size() - 1;
+    for (std::size_t slot = static_cast<std::size_t>(nameHash) & mask; mUniformTable[slot].mName != nullptr; slot = (slot + 1) & mask)
+    {
+        const UniformTableEntry& entry = mUniformTable[slot];
+        if (entry.mNameHash == nameHash && (name == nullptr || *entry.mName == *name))
+            return entry.mLocation;
+    }
+
+    return -1;
+}
+
+//--------------------------------------------------------------------------------------
+void Program::Destroy() noexcept 
+{ 
+    if (mProgramId != 0)
+    {
+        GLSTATE.DeleteProgram(mProgramId);
+        mProgramId = 0;
+    }
+    mShaderBuff.clear();
+    mAttributeLocations.clear();
+    mUniformLocations.clear();
+    mUniformTable.clear();
+    mAttributeInfo.clear();
+    mUniformInfo.clear();
+    mUniformShadowSlots.clear();
+    mUniformShadow.clear();
+    mUniformBlocks.clear();
+}
+
+//--------------------------------------------------------------------------------------
+GLbitfield Program::GetBitfield() const noexcept
+{
+    return mStages;
+
+    return 0;
+}
+
+
+/*
+===================================================================================================
+Program Binary Cache
+
+
+*/
+
+namespace ProgramBinaryCache
+{
+#define GLUF_PROGRAM_BINARY_MAGIC "GLUFPBC"
+#define GLUF_PROGRAM_BINARY_VERSION 3
+
+    /*
+    File Layout
+
+        'EntryHeader', then 'mAttributeCount' + 'mUniformCount' 'EntryVariable's, then the name table,
+            then the driver's program binary
+
+    */
+    struct EntryHeader
+    {
+        char     mMagic[8];
+        uint32_t mVersion;
+        uint32_t mBinaryFormat;
+        uint64_t mKey;
+        uint32_t mStages;
+        uint32_t mAttributeCount;
+        uint32_t mUniformCount;
+        uint32_t mNamesSize;
+        uint64_t mBinarySize;
+    };
+
+    struct EntryVariable
+    {
+        uint32_t mNameOffset;//relative to the start of the name table
+        uint32_t mNameLength;
+        uint32_t mLocation;
+        uint32_t mType;
+        int32_t  mArraySize;
+        int32_t  mBlockIndex;
+        int32_t  mOffset;
+        int32_t  mArrayStride;
+        int32_t  mMatrixStride;
+        uint32_t mPadding;
+    };
+
+    struct ParsedEntry
+    {
+        GLenum mBinaryFormat = 0;
+        const char* mBinary = nullptr;
+        GLsizei mBinarySize = 0;
+        GLbitfield mStages = 0;
+        VariableLocMap mAttributes;
+        VariableLocMap mUniforms;
+        ShaderVariableInfoMap mAttributeInfo;
+        ShaderVariableInfoMap mUniformInfo;
+    };
+
+    //--------------------------------------------------------------------------------------
+    bool IsSupported()
+    {
+        if (gGLVersion2Digit < 41 && !gExtensions.HasExtension("GL_ARB_get_program_binary"))
+            return false;
+
+        //some drivers expose the entry points but no formats, in which case nothing can be cached
+        GLint formatCount = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+        return formatCount > 0;
+    }
+
+    //--------------------------------------------------------------------------------------
+    std::string GetEntryPath(const std::string& directory, uint64_t key)
+    {
+        std::stringstream ss;
+        ss << directory;
+        if (directory.back() != '/' && directory.back() != '\\')
+            ss << '/';
+        ss << std::hex << std::setw(16) << std::setfill('0') << key << ".glufbin";
+        return ss.str();
+    }
+
+    //--------------------------------------------------------------------------------------
+    bool ParseVariables(const EntryVariable* variables, uint32_t count, const char* names, uint32_t namesSize, VariableLocMap& outMap, ShaderVariableInfoMap& outInfo)
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const EntryVariable& variable = variables[i];
+            if (variable.mNameOffset > namesSize || variable.mNameLength > namesSize - variable.mNameOffset)
+                return false;
+
+            std::string name(names + variable.mNameOffset, variable.mNameLength);
+
+            ShaderVariableInfo& info = outInfo[name];
+            info.mType = variable.mType;
+            info.mArraySize = variable.mArraySize;
+            info.mLocation = static_cast<GLint>(variable.mLocation);
+            info.mBlockIndex = variable.mBlockIndex;
+            info.mOffset = variable.mOffset;
+            info.mArrayStride = variable.mArrayStride;
+            info.mMatrixStride = variable.mMatrixStride;
+
+            outMap.insert(VariableLocPair(std::move(name), variable.mLocation));
+        }
+        return true;
+    }
+
+    //--------------------------------------------------------------------------------------
+    bool ParseEntry(const MemorySpan& data, uint64_t key, ParsedEntry& outEntry)
+    {
+        if (data.size() < sizeof(EntryHeader))
+            return false;
+
+        EntryHeader header;
+        std::memcpy(&header, data.data(), sizeof(EntryHeader));
+
+        if (std::memcmp(header.mMagic, GLUF_PROGRAM_BINARY_MAGIC, sizeof(header.mMagic)) != 0 ||
+            header.mVersion != GLUF_PROGRAM_BINARY_VERSION || header.mKey != key)
+            return false;
+
+        uint64_t tableSize = (static_cast<uint64_t>(header.mAttributeCount) + header.mUniformCount) * sizeof(EntryVariable);
+        uint64_t payloadSize = tableSize + header.mNamesSize + header.mBinarySize;
+        if (payloadSize > data.size() - sizeof(EntryHeader) || header.mBinarySize == 0 ||
+            header.mBinarySize > static_cast<uint64_t>(std::numeric_limits<GLsizei>::max()))
+            return false;
+
+        //copy the table out, because the mapping carries no alignment guarantee past the header
+        std::vector<EntryVariable> table(header.mAttributeCount + header.mUniformCount);
+        if (!table.empty())
+            std::memcpy(table.data(), data.data() + sizeof(EntryHeader), static_cast<std::size_t>(tableSize));
+
+        const char* names = data.data() + sizeof(EntryHeader) + tableSize;
+        if (!ParseVariables(table.data(), header.mAttributeCount, names, header.mNamesSize, outEntry.mAttributes, outEntry.mAttributeInfo) ||
+            !ParseVariables(table.data() + header.mAttributeCount, header.mUniformCount, names, header.mNamesSize, outEntry.mUniforms, outEntry.mUniformInfo))
+            return false;
+
+        outEntry.mBinaryFormat = header.mBinaryFormat;
+        outEntry.mBinary = names + header.mNamesSize;
+        outEntry.mBinarySize = static_cast<GLsizei>(header.mBinarySize);
+        outEntry.mStages = header.mStages;
+        return true;
+    }
+
+    //--------------------------------------------------------------------------------------
+    void AppendVariables(const VariableLocMap& variables, const ShaderVariableInfoMap& info, std::vector<EntryVariable>& table, std::string& names)
+    {
+        for (const auto& it : variables)
+        {
+            ShaderVariableInfo record;
+            auto infoIt = info.find(it.first);
+            if (infoIt != info.end())
+                record = infoIt->second;
+
+            EntryVariable variable = {};
+            variable.mNameOffset = static_cast<uint32_t>(names.size());
+            variable.mNameLength = static_cast<uint32_t>(it.first.size());
+            variable.mLocation = it.second;
+            variable.mType = record.mType;
+            variable.mArraySize = record.mArraySize;
+            variable.mBlockIndex = record.mBlockIndex;
+            variable.mOffset = record.mOffset;
+            variable.mArrayStride = record.mArrayStride;
+            variable.mMatrixStride = record.mMatrixStride;
+            table.push_back(variable);
+
+            names += it.first;
+        }
+    }
+
+    //--------------------------------------------------------------------------------------
+    uint64_t HashDriverString(GLenum name, uint64_t hash)
+    {
+        const char* str = reinterpret_cast<const char*>(glGetString(name));
+        if (str == nullptr)
+            return hash;
+
+        //include the terminator, so adjacent strings can not run together
+        return HashBytesFNV1a(str, std::strlen(str) + 1, hash);
+    }
+}
+
+//--------------------------------------------------------------------------------------
+uint64_t HashProgramSources(const ShaderSourceList& shaderSources, bool separate)
+{
+    using namespace ProgramBinaryCache;
+
+    uint64_t hash = HashStringFNV1a(GLUF_PROGRAM_BINARY_MAGIC);
+    hash = HashDriverString(GL_VENDOR, hash);
+    hash = HashDriverString(GL_RENDERER, hash);
+    hash = HashDriverString(GL_VERSION, hash);
+
+    for (const auto& it : shaderSources)
+    {
+        uint32_t type = static_cast<uint32_t>(it.first);
+        uint64_t length = it.second.size();
+        hash = HashBytesFNV1a(&type, sizeof(type), hash);
+        hash = HashBytesFNV1a(&length, sizeof(length), hash);
+        hash = HashBytesFNV1a(it.second.data(), it.second.size(), hash);
+    }
+
+    unsigned char separateByte = separate ? 1 : 0;
+    return HashBytesFNV1a(&separateByte, sizeof(separateByte), hash);
+}
+
+
+/*
+===================================================================================================
+Shader Preprocessor
+
+
+*/
+
+namespace ShaderPreprocessor
+{
+    /*
+    Context
+
+        Data Members:
+            'mDirs', 'mArchive': the include search paths
+            'mModernLines': true for GLSL 3.30 and ES 3.00 and newer, where '#line N' numbers the next line N; before
+                that, it is N + 1
+            'mStack': keys of the files currently being expanded, to catch include cycles
+            'mOnce': keys of included files which have '#pragma once'
+            'mFiles': the file behind each source string number
+            'mOut': the preprocessed text
+
+    */
+    struct Context
+    {
+        const std::vector<std::string>* mDirs = nullptr;
+        const AssetArchive* mArchive = nullptr;
+        bool mModernLines = true;
+        std::vector<std::string> mStack;
+        std::set<std::string> mOnce;
+        ShaderNameList mFiles;
+        std::string mOut;
+    };
+
+    /*
+    Source
+
+        Data Members:
+            'mText': the file's contents
+            'mPath': the file's path, or asset name if it came from the archive
+            'mKey': unique name of the file, for '#pragma once' and cycles
+            'mFromArchive': whether 'mPath' is an asset name
+
+    */
+    struct Source
+    {
+        std::string mText;
+        std::string mPath;
+        std::string mKey;
+        bool mFromArchive = false;
+    };
+
+    //--------------------------------------------------------------------------------------
+    bool IsBlank(char ch) noexcept
+    {
+        return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\v' || ch == '\f';
+    }
+
+    //--------------------------------------------------------------------------------------
+    bool IsAbsolutePath(const std::string& path) noexcept
+    {
+        return (!path.empty() && (path[0] == '/' || path[0] == '\\')) || (path.size() > 1 && path[1] == ':');
+    }
+
+    //--------------------------------------------------------------------------------------
+    std::string CollapsePath(const std::string& path)
+    {
+        //resolve "." and "..", so a file reached two ways only has one key
+        std::string normalized = path;
+        std::replace(normalized.begin(), normalized.end(), '\\', '/');
+
+        bool absolute = !normalized.empty() && normalized[0] == '/';
+        std::vector<std::string> parts;
+        std::size_t start = 0;
+        while (start <= normalized.size())
+        {
+            std::size_t end = normalized.find('/', start);
+            if (end == std::string::npos)
+                end = normalized.size();
+
+            std::string part = normalized.substr(start, end - start);
+            if (part == "..")
+            {
+                if (!parts.empty() && parts.back() != "..")
+                    parts.pop_back();
+                else if (!absolute)
+                    parts.push_back(part);
+            }
+            else if (!part.empty() && part != ".")
+            {
+                parts.push_back(part);
+            }
+
+            start = end + 1;
+        }
+
+        std::string ret = absolute ? "/" : "";
+        for (std::size_t i = 0; i < parts.size(); ++i)
+        {
+            if (i != 0)
+                ret += '/';
+            ret += parts[i];
+        }
+        return ret;
+    }
+
+    //--------------------------------------------------------------------------------------
+    std::string JoinPath(const std::string& directory, const std::string& name)
+    {
+        if (directory.empty() || IsAbsolutePath(name))
+            return CollapsePath(name);
+
+        return CollapsePath(directory + "/" + name);
+    }
+
+    //--------------------------------------------------------------------------------------
+    std::string DirectoryOf(const std::string& path)
+    {
+        std::size_t slash = path.find_last_of("/\\");
+        return slash == std::string::npos ? std::string() : path.substr(0, slash);
+    }
+
+    //--------------------------------------------------------------------------------------
+    bool TryLoadFile(const std::string& path, Source& outSource)
+    {
+        //missing files are expected while searching, so this does not go through 'LoadFileIntoMemory', which logs
+        MappedFile file;
+        try
+        {
+            file.Open(path);
+        }
+        catch (const std::ios_base::failure&)
+        {
+            return false;
+        }
+
+        outSource.mText.assign(file.data(), file.size());
+        outSource.mPath = path;
+        outSource.mKey = "file:" + path;
+        outSource.mFromArchive = false;
+        return true;
+    }
+
+    //--------------------------------------------------------------------------------------
+    bool TryLoadAsset(const AssetArchive* archive, const std::string& name, Source& outSource)
+    {
+        MemorySpan asset;
+        std::string normalized = NormalizeAssetName(CollapsePath(name));
+        if (archive == nullptr || !archive->TryGetAsset(normalized, asset))
+            return false;
+
+        outSource.mText.assign(asset.data(), asset.size());
+        outSource.mPath = normalized;
+        outSource.mKey = "archive:" + normalized;
+        outSource.mFromArchive = true;
+        return true;
+    }
+
+    //--------------------------------------------------------------------------------------
+    bool Resolve(const Context& context, const std::string& name, bool relative, const Source& includer, Source& outSource)
+    {
+        if (relative)
+        {
+            std::string path = JoinPath(DirectoryOf(includer.mPath), name);
+            if (includer.mFromArchive)
+            {
+                if (TryLoadAsset(context.mArchive, path, outSource))
+                    return true;
+            }
+            else if (!includer.mPath.empty() && TryLoadFile(path, outSource))
+            {
+                return true;
+            }
+        }
+
+        for (const auto& it : *context.mDirs)
+        {
+            if (TryLoadFile(JoinPath(it, name), outSource))
+                return true;
+        }
+
+        return TryLoadAsset(context.mArchive, name, outSource);
+    }
+
+    //--------------------------------------------------------------------------------------
+    std::size_t ParseDirective(const std::string& line, std::string& outRest)
+    {
+        //returns the length of the directive name, which is at the start of 'outRest'
+        std::size_t i = 0;
+        while (i < line.size() && IsBlank(line[i]))
+            ++i;
+        if (i == line.size() || line[i] != '#')
+            return 0;
+
+        ++i;
+        while (i < line.size() && IsBlank(line[i]))
+            ++i;
+
+        std::size_t start = i;
+        while (i < line.size() && (std::isalnum(static_cast<unsigned char>(line[i])) || line[i] == '_'))
+            ++i;
+
+        outRest = line.substr(start);
+        return i - start;
+    }
+
+    //--------------------------------------------------------------------------------------
+    bool IsDirective(const std::string& rest, std::size_t nameLength, const char* name) noexcept
+    {
+        return nameLength == std::strlen(name) && rest.compare(0, nameLength, name) == 0;
+    }
+
+    //--------------------------------------------------------------------------------------
+    std::string TrimmedArgument(const std::string& rest, std::size_t nameLength)
+    {
+        std::size_t start = nameLength;
+        while (start < rest.size() && IsBlank(rest[start]))
+            ++start;
+
+        std::size_t end = rest.size();
+        while (end > start && IsBlank(rest[end - 1]))
+            --end;
+
+        return rest.substr(start, end - start);
+    }
+
+    //--------------------------------------------------------------------------------------
+    bool UpdateCommentState(const std::string& line, bool inComment) noexcept
+    {
+        for (std::size_t i = 0; i + 1 < line.size(); ++i)
+        {
+            if (inComment)
+            {
+                if (line[i] == '*' && line[i + 1] == '/')
+                {
+                    inComment = false;
+                    ++i;
+                }
+            }
+            else if (line[i] == '/' && line[i + 1] == '/')
+            {
+                break;
+            }
+            else if (line[i] == '/' && line[i + 1] == '*')
+            {
+                inComment = true;
+                ++i;
+            }
+        }
+
+        return inComment;
+    }
+
+    //--------------------------------------------------------------------------------------
+    void AppendLineDirective(Context& context, std::size_t nextLine, std::size_t fileIndex)
+    {
+        std::size_t line = context.mModernLines ? nextLine : nextLine - 1;
+        context.mOut += "#line " + std::to_string(line) + " " + std::to_string(fileIndex) + "\n";
+    }
+
+    //--------------------------------------------------------------------------------------
+    void AppendDefines(Context& context, const ShaderDefineList& defines)
+    {
+        for (const auto& it : defines)
+        {
+            context.mOut += "#define " + it.first;
+            if (!it.second.empty())
+                context.mOut += " " + it.second;
+            context.mOut += "\n";
+        }
+    }
+
+    //--------------------------------------------------------------------------------------
+    [[noreturn]] void Fail(const Source& source, std::size_t line, const std::string& message)
+    {
+        GLUF_ERROR_LONG("(ShaderManager): " << (source.mPath.empty() ? std::string("<source>") : source.mPath) <<
+            "(" << line << "): " << message);
+        throw ShaderPreprocessException();
+    }
+
+    //--------------------------------------------------------------------------------------
+    void Expand(Context& context, const Source& source, std::size_t fileIndex, const ShaderDefineList* defines)
+    {
+        //'defines' is only given for the top level source
+        if (context.mStack.size() > GLUF_SHADER_INCLUDE_DEPTH)
+            Fail(source, 0, "Includes Nested Too Deeply");
+        context.mStack.push_back(source.mKey);
+
+        const std::string& text = source.mText;
+        bool inComment = false;
+        std::size_t lineNumber = 0;
+        std::size_t start = 0;
+        while (start < text.size())
+        {
+            std::size_t end = text.find('\n', start);
+            if (end == std::string::npos)
+                end = text.size();
+
+            std::string line = text.substr(start, end - start);
+            start = end + 1;
+            ++lineNumber;
+
+            std::string rest;
+            std::size_t nameLength = inComment ? 0 : ParseDirective(line, rest);
+            inComment = UpdateCommentState(line, inComment);
+
+            if (IsDirective(rest, nameLength, "include"))
+            {
+                std::string argument = TrimmedArgument(rest, nameLength);
+                char close = argument.empty() ? 0 : (argument[0] == '"' ? '"' : (argument[0] == '<' ? '>' : 0));
+                std::size_t closePos = close == 0 ? std::string::npos : argument.find(close, 1);
+                if (closePos == std::string::npos || closePos == 1)
+                    Fail(source, lineNumber, "Malformed #include: " + line);
+
+                std::string name = argument.substr(1, closePos - 1);
+                Source included;
+                if (!Resolve(context, name, close == '"', source, included))
+                    Fail(source, lineNumber, "Include Not Found: \"" + name + "\"");
+
+                if (context.mOnce.find(included.mKey) != context.mOnce.end())
+                {
+                    context.mOut += "\n";
+                    continue;
+                }
+
+                if (std::find(context.mStack.begin(), context.mStack.end(), included.mKey) != context.mStack.end())
+                    Fail(source, lineNumber, "Include Cycle: \"" + name + "\" Includes Itself");
+
+                auto found = std::find(context.mFiles.begin(), context.mFiles.end(), included.mPath);
+                std::size_t includedIndex = found - context.mFiles.begin();
+                if (found == context.mFiles.end())
+                    context.mFiles.push_back(included.mPath);
+
+                AppendLineDirective(context, 1, includedIndex);
+                Expand(context, included, includedIndex, nullptr);
+                AppendLineDirective(context, lineNumber + 1, fileIndex);
+            }
+            else if (IsDirective(rest, nameLength, "pragma") && TrimmedArgument(rest, nameLength) == "once")
+            {
+                context.mOnce.insert(source.mKey);
+                context.mOut += "\n";
+            }
+            else if (IsDirective(rest, nameLength, "version"))
+            {
+                //only the top level source keeps its version, and the defines go right after it
+                if (defines == nullptr)
+                {
+                    context.mOut += "\n";
+                    continue;
+                }
+
+                context.mOut += line + "\n";
+                if (!defines->empty())
+                {
+                    AppendDefines(context, *defines);
+                    AppendLineDirective(context, lineNumber + 1, fileIndex);
+                }
+            }
+            else
+            {
+                context.mOut += line;
+                context.mOut += "\n";
+            }
+        }
+
+        context.mStack.pop_back();
+    }
+
+    //--------------------------------------------------------------------------------------
+    void LoadSources(const ShaderPathList& shaderPaths, ShaderSourceList& outSources)
+    {
+        for (const auto& it : shaderPaths)
+        {
+            std::string text;
+            try
+            {
+                LoadFileIntoMemory(it.second, text);
+            }
+            catch (const std::ios_base::failure& e)
+            {
+                GLUF_ERROR_LONG("(ShaderManager): Shader File Load Failed: " << e.what());
+                RETHROW;
+            }
+
+            //newline here is needed, because end of loaded file might not have one, which is required for the end of a shader for some reason
+            text += "\n";
+            outSources.insert({ it.first, std::move(text) });
+        }
+    }
+
+    //--------------------------------------------------------------------------------------
+    bool FindVersion(const std::string& text, int& outVersion)
+    {
+        bool inComment = false;
+        std::size_t start = 0;
+        while (start < text.size())
+        {
+            std::size_t end = text.find('\n', start);
+            if (end == std::string::npos)
+                end = text.size();
+
+            std::string line = text.substr(start, end - start);
+            start = end + 1;
+
+            std::string rest;
+            std::size_t nameLength = inComment ? 0 : ParseDirective(line, rest);
+            inComment = UpdateCommentState(line, inComment);
+            if (nameLength == 0)
+                continue;
+
+            if (!IsDirective(rest, nameLength, "version"))
+                return false;
+
+            //i.e. "#version __VERSION__", which is substituted later; assume it is current
+            std::string number = TrimmedArgument(rest, nameLength);
+            outVersion = std::isdigit(static_cast<unsigned char>(number.empty() ? 0 : number[0])) ? std::atoi(number.c_str()) : 330;
+            return true;
+        }
+
+        return false;
+    }
+}
+
+
+/*
+===================================================================================================
+ShaderManager Methods
+
+
+*/
+
+/*
+//--------------------------------------------------------------------------------------
+ShaderPtr ShaderManager::CreateShader(std::wstring shad, ShaderType type, bool file, bool separate)
+{
+    ShaderPtr shader(new Shader());
+    shader->Init(type);
+
+    (file) ? shader->LoadFromFile(shad.c_str()) : shader->Load(shad.c_str());
+
+    ShaderInfoStruct output;
+    shader->Compile(output);
+    mCompileLogs.insert(std::pair<ShaderPtr, ShaderInfoStruct>(shader, output));
+
+    //log it if it failed
+    if (!output)
+    {
+        std::wstringstream ss;
+        ss << "Shader Compilation Failed: \n" << output.mLog;
+        GLUF_ERROR(ss.str().c_str());
+    }
+
+    return shader;
+}
+*/
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::AddCompileLog(const ShaderPtr& shader, const ShaderInfoStruct& log)
+{
+    //TODO: vs2013 does not support shared locking
+    _TSAFE_SCOPE(mCompLogMutex);
+
+    mCompileLogs.insert(std::pair<ShaderPtr, ShaderInfoStruct>(shader, log));
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::AddLinkLog(const ProgramPtr& program, const ShaderInfoStruct& log)
+{
+    _TSAFE_SCOPE(mLinkLogMutex);
+
+    mLinklogs.insert(std::pair<ProgramPtr, ShaderInfoStruct>(program, log));
+}
+
+//--------------------------------------------------------------------------------------
+GLuint ShaderManager::GetUniformIdFromName(const SepProgramPtr& ppo, const std::string& name) const
+{
+    return GetUniformIdFromName(ppo->GetActiveProgram(), name);
+}
+
+//--------------------------------------------------------------------------------------
+GLuint ShaderManager::GetUniformIdFromName(const ProgramPtr& prog, const std::string& name) const
+{
+    //the hash table only costs one string compare, where the map costs one per level
+    GLint location = prog->FindUniform(HashBytesFNV1a(name.data(), name.size()), &name);
+    if (location != -1)
+        return static_cast<GLuint>(location);
+
+    //the table leaves out uniform block members, which the map lists with location -1; that is returned as it always
+    //  was, and only names in neither are missing
+    auto it = prog->mUniformLocations.find(name);
+    if (it == prog->mUniformLocations.end())
+    {
+        GLUF_NON_CRITICAL_EXCEPTION(std::invalid_argument("Uniform Name Not Found!"));
+        return 0;//if we are in release mode, and the name does not exist, default to the 0th, however this MAY CREATE UNDESIRED RESULTS
+    }
+
+    return it->second;
+}
+
+//--------------------------------------------------------------------------------------
+UniformHandle ShaderManager::GetUniformHandle(const ProgramPtr& program, uint64_t nameHash) const
+{
+    GLUF_NULLPTR_CHECK(program);
+
+    UniformHandle ret;
+    ret.mNameHash = nameHash;
+    ret.mLocation = program->FindUniform(nameHash);
+    return ret;
+}
+
+//--------------------------------------------------------------------------------------
+UniformHandle ShaderManager::GetUniformHandle(const ProgramPtr& program, const std::string& name) const
+{
+    GLUF_NULLPTR_CHECK(program);
+
+    UniformHandle ret;
+    ret.mNameHash = HashBytesFNV1a(name.data(), name.size());
+    ret.mLocation = program->FindUniform(ret.mNameHash, &name);
+    return ret;
+}
+
+//--------------------------------------------------------------------------------------
+UniformHandle ShaderManager::GetUniformHandle(const SepProgramPtr& ppo, uint64_t nameHash) const
+{
+    GLUF_NULLPTR_CHECK(ppo);
+
+    return GetUniformHandle(ppo->GetActiveProgram(), nameHash);
+}
+
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::CreateShaderFromFile(ShaderPtr& outShader, const std::string& filePath, ShaderType type)
+{
+    //map the file, the text only gets copied once, into the shader itself
+    MappedFile file;
+    try
+    {
+        file.Open(filePath);
+    }
+    catch (const std::ios_base::failure& e)
+    {
+        GLUF_ERROR_LONG("(ShaderManager): Shader File Load Failed: " << e.what());
+        RETHROW;//rethrow here, because if file loading failed, the it never got to compilation
+    }
+
+    CreateShaderFromMemory(outShader, file, type);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::CreateShaderFromText(ShaderPtr& outShader, const std::string& text, ShaderType type)
+{
+    SubmitShader(outShader, text, type);
+    FinishShader(outShader);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::SubmitShader(ShaderPtr& outShader, const std::string& text, ShaderType type)
+{
+    uint32_t typeValue = static_cast<uint32_t>(type);
+    uint64_t key = HashBytesFNV1a(text.data(), text.size(), HashBytesFNV1a(&typeValue, sizeof(typeValue)));
+
+    _TSAFE_SCOPE(mShaderObjectMutex);
+
+    //a shader that failed, or was deleted, has no id, and is compiled again; so is one whose hash collides, which then
+    //  takes over the entry
+    auto found = mShaderObjects.find(key);
+    if (found != mShaderObjects.end() && found->second.mType == type && found->second.mText == text)
+    {
+        ShaderPtr existing = found->second.mShader.lock();
+        if (existing && existing->mShaderId != 0)
+        {
+            ++mShaderObjectStats.mHits;
+            outShader = std::move(existing);
+            return;
+        }
+    }
+
+    outShader = std::make_shared<Shader>();
+
+    try
+    {
+        //initialize the shader
+        outShader->Init(type);
+
+        //start compiling it, straight from the text
+        outShader->SubmitCompile(text);
+    }
+    catch (const CreateGLShaderException& e)
+    {
+        GLUF_ERROR_LONG("(ShaderManager): " << e.what());
+        GLUF_CRITICAL_EXCEPTION(MakeShaderException());//don't add compile log if the shader could not be created
+    }
+
+    ++mShaderObjectStats.mCompiled;
+    mShaderObjects[key] = { type, text, outShader };
+
+    //drop the entries of shaders that have been freed once in a while, so the cache does not only grow
+    if (mShaderObjects.size() >= mShaderObjectSweep)
+    {
+        for (auto it = mShaderObjects.begin(); it != mShaderObjects.end();)
+        {
+            if (it->second.mShader.expired())
+                it = mShaderObjects.erase(it);
+            else
+                ++it;
+        }
+        mShaderObjectSweep = std::max<std::size_t>(64, mShaderObjects.size() * 2);
+    }
+    mShaderObjectStats.mTracked = mShaderObjects.size();
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::FinishShader(const ShaderPtr& shader)
+{
+    //a shared shader which already failed to compile for someone else; its log is already recorded
+    if (shader->mShaderId == 0)
+    {
+        GLUF_ERROR("(ShaderManager): Shader Previously Failed to Compile");
+        GLUF_CRITICAL_EXCEPTION(MakeShaderException());
+    }
+
+    //shared shaders only need to be checked the first time
+    {
+        _TSAFE_SCOPE(mCompLogMutex);
+        if (mCompileLogs.find(shader) != mCompileLogs.end())
+            return;
+    }
+
+    ShaderInfoStruct out;
+    try
+    {
+        shader->FinishCompile(out);
+        AddCompileLog(shader, out);
+    }
+    catch (const CompileShaderException& e)
+    {
+        GLUF_ERROR_LONG("(ShaderManager): " << e.what() << "\n ========Log======== \n" << out.mLog);
+        //add the log if file load failed
+        AddCompileLog(shader, out);
+
+        GLUF_CRITICAL_EXCEPTION(MakeShaderException());
+    }
+}
+
+//--------------------------------------------------------------------------------------
+ShaderObjectStats ShaderManager::GetShaderObjectStats() const
+{
+    _TSAFE_SCOPE(mShaderObjectMutex);
+
+    return mShaderObjectStats;
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::CreateShaderFromMemory(ShaderPtr& outShader, const MemorySpan& memory, ShaderType type)
+{
+    //load the string from the memory
+    std::string outString;
+    outString.reserve(memory.size() + 1);
+    outString.assign(memory.begin(), memory.end());
+
+    //newline here is needed, because end of loaded file might not have one, which is required for the end of a shader for some reason
+    outString += "\n";
+    return CreateShaderFromText(outShader, outString, type);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::LinkProgram(ProgramPtr& outProgram, const ShaderPtrList& shaders, bool separate, bool retrievable)
+{
+    SubmitLink(outProgram, shaders, separate, retrievable);
+    FinishLink(outProgram);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::SubmitLink(ProgramPtr& outProgram, const ShaderPtrList& shaders, bool separate, bool retrievable)
+{
+    outProgram = std::make_shared<Program>();
+
+    try
+    {
+        //initialize
+        outProgram->Init();
+
+        //the driver may only keep the binary around if asked to before linking
+        if (retrievable)
+            glProgramParameteri(outProgram->mProgramId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+        //add the shaders
+        for (auto it : shaders)
+        {
+            outProgram->AttachShader(it);
+        }
+
+        //start building the program
+        outProgram->SubmitBuild(separate);
+    }
+    catch (const CreateGLProgramException& e)
+    {
+        GLUF_ERROR_LONG("(ShaderManager): " << e.what());
+        GLUF_CRITICAL_EXCEPTION(MakeShaderException());
+    }
+    catch (const std::invalid_argument& e)
+    {
+        GLUF_ERROR_LONG("(ShaderManager): " << e.what());
+        outProgram->FlushShaders();//if any of the shaders failed to add, flush so it is in a valid state
+        GLUF_CRITICAL_EXCEPTION(MakeShaderException());
+    }
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::FinishLink(const ProgramPtr& program)
+{
+    ShaderInfoStruct out;
+    try
+    {
+        program->FinishBuild(out);
+        AddLinkLog(program, out);
+    }
+    catch (const LinkProgramException& e)
+    {
+        GLUF_ERROR_LONG("(ShaderManager): " << e.what() << "\n ========Log======== \n" << out.mLog);
+        AddLinkLog(program, out);//if linking failed, still add the log
+    }
+}
+
+//--------------------------------------------------------------------------------------
+bool ShaderManager::LoadCachedProgram(ProgramPtr& outProgram, const std::string& directory, uint64_t key, bool separate) noexcept
+{
+    GLUF_PROFILE_ZONE("LoadCachedProgram");
+
+    using namespace ProgramBinaryCache;
+
+    std::string path = GetEntryPath(directory, key);
+    bool rejected = false;
+    try
+    {
+        MappedFile file;
+        try
+        {
+            file.Open(path);
+        }
+        catch (const std::ios_base::failure&)
+        {
+            //nothing cached for this program yet
+            _TSAFE_SCOPE(mBinaryCacheMutex);
+            ++mBinaryCacheStats.mMisses;
+            return false;
+        }
+
+        ParsedEntry entry;
+        if (!ParseEntry(file, key, entry))
+        {
+            GLUF_ERROR_LONG("(ShaderManager): Discarding Invalid Program Binary \"" << path << "\"");
+            rejected = true;
+        }
+        else
+        {
+            auto program = std::make_shared<Program>();
+            program->Init();
+
+            if (separate)
+                glProgramParameteri(program->mProgramId, GL_PROGRAM_SEPARABLE, GL_TRUE);
+
+            glProgramBinary(program->mProgramId, entry.mBinaryFormat, entry.mBinary, entry.mBinarySize);
+
+            GLint isLinked = 0;
+            glGetProgramiv(program->mProgramId, GL_LINK_STATUS, &isLinked);
+            if (isLinked == GL_FALSE)
+            {
+                //expected after driver updates that keep the same version string
+                rejected = true;
+            }
+            else
+            {
+                program->mStages = entry.mStages;
+                program->mAttributeLocations = std::move(entry.mAttributes);
+                program->mUniformLocations = std::move(entry.mUniforms);
+                program->mAttributeInfo = std::move(entry.mAttributeInfo);
+                program->mUniformInfo = std::move(entry.mUniformInfo);
+                program->BuildUniformTable();
+                program->BuildUniformShadow();
+                program->LoadUniformBlocks();
+
+                ShaderInfoStruct out;
+                out.mSuccess = true;
+                AddLinkLog(program, out);
+
+                outProgram = program;
+
+                _TSAFE_SCOPE(mBinaryCacheMutex);
+                ++mBinaryCacheStats.mHits;
+                return true;
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        GLUF_ERROR_LONG("(ShaderManager): Program Binary Load Failed: " << e.what());
+    }
+
+    //the file is closed by now, so it can be removed
+    if (rejected)
+        std::remove(path.c_str());
+
+    _TSAFE_SCOPE(mBinaryCacheMutex);
+    ++mBinaryCacheStats.mMisses;
+    if (rejected)
+        ++mBinaryCacheStats.mRejected;
+    return false;
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::StoreCachedProgram(const ProgramPtr& program, const std::string& directory, uint64_t key) noexcept
+{
+    GLUF_PROFILE_ZONE("StoreCachedProgram");
+
+    using namespace ProgramBinaryCache;
+
+    GLint isLinked = 0;
+    glGetProgramiv(program->mProgramId, GL_LINK_STATUS, &isLinked);
+    if (isLinked == GL_FALSE)
+        return;
+
+    GLint binaryLength = 0;
+    glGetProgramiv(program->mProgramId, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+    if (binaryLength <= 0)
+        return;
+
+    std::string path = GetEntryPath(directory, key);
+    std::string tmpPath = path + ".tmp";
+    try
+    {
+        std::vector<char> binary(binaryLength);
+        GLenum binaryFormat = 0;
+        GLsizei written = 0;
+        glGetProgramBinary(program->mProgramId, binaryLength, &written, &binaryFormat, binary.data());
+        if (written <= 0)
+            return;
+
+        std::vector<EntryVariable> table;
+        std::string names;
+        AppendVariables(program->mAttributeLocations, program->mAttributeInfo, table, names);
+        AppendVariables(program->mUniformLocations, program->mUniformInfo, table, names);
+
+        EntryHeader header = {};
+        std::memcpy(header.mMagic, GLUF_PROGRAM_BINARY_MAGIC, sizeof(header.mMagic));
+        header.mVersion = GLUF_PROGRAM_BINARY_VERSION;
+        header.mBinaryFormat = binaryFormat;
+        header.mKey = key;
+        header.mStages = program->mStages;
+        header.mAttributeCount = static_cast<uint32_t>(program->mAttributeLocations.size());
+        header.mUniformCount = static_cast<uint32_t>(program->mUniformLocations.size());
+        header.mNamesSize = static_cast<uint32_t>(names.size());
+        header.mBinarySize = static_cast<uint64_t>(written);
+
+        //write next to the real entry and swap it in, so a crash never leaves a truncated binary behind
+        {
+            std::ofstream outFile;
+            outFile.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+            outFile.open(tmpPath, std::ios::binary | std::ios::out | std::ios::trunc);
+
+            outFile.write(reinterpret_cast<const char*>(&header), sizeof(EntryHeader));
+            if (!table.empty())
+                outFile.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(EntryVariable));
+            outFile.write(names.data(), names.size());
+            outFile.write(binary.data(), written);
+        }
+
+        std::remove(path.c_str());
+        if (std::rename(tmpPath.c_str(), path.c_str()) != 0)
+        {
+            GLUF_ERROR_LONG("(ShaderManager): Failed to Move Program Binary Into Place: \"" << path << "\"");
+            std::remove(tmpPath.c_str());
+            return;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        GLUF_ERROR_LONG("(ShaderManager): Failed to Write Program Binary \"" << tmpPath << "\": " << e.what());
+        std::remove(tmpPath.c_str());
+        return;
+    }
+
+    _TSAFE_SCOPE(mBinaryCacheMutex);
+    ++mBinaryCacheStats.mStored;
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::SetProgramBinaryCache(const std::string& directory)
+{
+    _TSAFE_SCOPE(mBinaryCacheMutex);
+
+    mBinaryCacheDir = directory;
+    mBinaryCacheStats = ProgramBinaryCacheStats();
+}
+
+//--------------------------------------------------------------------------------------
+std::string ShaderManager::GetProgramBinaryCache() const
+{
+    _TSAFE_SCOPE(mBinaryCacheMutex);
+
+    return mBinaryCacheDir;
+}
+
+//--------------------------------------------------------------------------------------
+ProgramBinaryCacheStats ShaderManager::GetProgramBinaryCacheStats() const
+{
+    _TSAFE_SCOPE(mBinaryCacheMutex);
+
+    return mBinaryCacheStats;
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::SubmitProgram(PendingProgramPtr& outPending, ShaderSourceList shaderSources, bool separate)
+{
+    GLUF_PROFILE_ZONE("ShaderManager::SubmitProgram");
+
+    outPending = std::make_shared<PendingProgram>();
+    PendingProgram& pending = *outPending;
+
+    try
+    {
+        std::string cacheDir = GetProgramBinaryCache();
+        if (!cacheDir.empty() && ProgramBinaryCache::IsSupported())
+        {
+            pending.mCacheKey = HashProgramSources(shaderSources, separate);
+            if (LoadCachedProgram(pending.mProgram, cacheDir, pending.mCacheKey, separate))
+            {
+                pending.mFromCache = true;
+                return;
+            }
+            pending.mCacheDir = cacheDir;
+        }
+
+        //hand everything to the driver before asking about any of it, so it can all compile at once
+        for (auto it : shaderSources)
+        {
+            ShaderPtr shader;
+            SubmitShader(shader, it.second, it.first);
+            pending.mShaders.push_back(shader);
+        }
+
+        SubmitLink(pending.mProgram, pending.mShaders, separate, !pending.mCacheDir.empty());
+    }
+    catch (...)
+    {
+        //the error is reported when the program is resolved, like the compile and link results
+        pending.mError = std::current_exception();
+    }
+}
+
+//--------------------------------------------------------------------------------------
+bool ShaderManager::IsProgramReady(const PendingProgramPtr& pending) const
+{
+    GLUF_NULLPTR_CHECK(pending);
+
+    if (pending->mResolved || pending->mFromCache || pending->mError)
+        return true;
+
+    //linking waits on the shaders, so the program finishing means everything has
+    return pending->mProgram->IsBuildComplete();
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::ResolveProgram(ProgramPtr& outProgram, const PendingProgramPtr& pending)
+{
+    GLUF_PROFILE_ZONE("ShaderManager::ResolveProgram");
+
+    GLUF_NULLPTR_CHECK(pending);
+
+    if (!pending->mResolved)
+    {
+        pending->mResolved = true;
+        try
+        {
+            if (pending->mError)
+                std::rethrow_exception(pending->mError);
+
+            if (!pending->mFromCache)
+            {
+                for (const auto& it : pending->mShaders)
+                    FinishShader(it);
+
+                FinishLink(pending->mProgram);
+
+                if (!pending->mCacheDir.empty())
+                    StoreCachedProgram(pending->mProgram, pending->mCacheDir, pending->mCacheKey);
+            }
+        }
+        catch (...)
+        {
+            pending->mError = std::current_exception();
+            pending->mProgram = nullptr;
+        }
+        pending->mShaders.clear();
+    }
+
+    if (pending->mError)
+        std::rethrow_exception(pending->mError);
+
+    outProgram = pending->mProgram;
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::SetMaxShaderCompilerThreads(GLuint count) const
+{
+    //only the ARB entry point is loaded; drivers with just the KHR extension keep their default
+    if (glMaxShaderCompilerThreadsARB != nullptr && gExtensions.HasExtension("GL_ARB_parallel_shader_compile"))
+        glMaxShaderCompilerThreadsARB(count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::CreateProgram(ProgramPtr& outProgram, ShaderPtrList shaders, bool separate)
+{
+    LinkProgram(outProgram, shaders, separate, false);
+}
+
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::CreateProgram(ProgramPtr& outProgram, ShaderSourceList shaderSources, bool separate)
+{
+    //the same path as the asynchronous version, just without anything to do in between
+    PendingProgramPtr pending;
+    SubmitProgram(pending, std::move(shaderSources), separate);
+    ResolveProgram(outProgram, pending);
+}
+
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::CreateProgramFromFiles(ProgramPtr& outProgram, ShaderPathList shaderPaths, bool separate)
+{
+    //load the text up front, so the binary cache can be checked before anything is compiled
+    ShaderSourceList sources;
+    ShaderPreprocessor::LoadSources(shaderPaths, sources);
+
+    CreateProgram(outProgram, sources, separate);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::AddShaderIncludeDirectory(const std::string& directory)
+{
+    _TSAFE_SCOPE(mIncludeMutex);
+
+    mIncludeDirs.push_back(directory);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::SetShaderIncludeArchive(const AssetArchivePtr& archive)
+{
+    _TSAFE_SCOPE(mIncludeMutex);
+
+    mIncludeArchive = archive;
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::ClearShaderIncludePaths()
+{
+    _TSAFE_SCOPE(mIncludeMutex);
+
+    mIncludeDirs.clear();
+    mIncludeArchive = nullptr;
+}
+
+//--------------------------------------------------------------------------------------
+std::string ShaderManager::PreprocessShader(const std::string& text, const ShaderDefineList& defines, const std::string& filePath,
+    ShaderNameList* outFiles) const
+{
+    GLUF_PROFILE_ZONE("ShaderManager::PreprocessShader");
+
+    using namespace ShaderPreprocessor;
+
+    //copy the search paths, so they can change while the files are read
+    std::vector<std::string> dirs;
+    AssetArchivePtr archive;
+    {
+        _TSAFE_SCOPE(mIncludeMutex);
+        dirs = mIncludeDirs;
+        archive = mIncludeArchive;
+    }
+
+    Context context;
+    context.mDirs = &dirs;
+    context.mArchive = archive.get();
+
+    Source root;
+    root.mText = text;
+    root.mPath = filePath.empty() ? filePath : CollapsePath(filePath);
+    root.mKey = "file:" + root.mPath;
+    context.mFiles.push_back(root.mPath);
+
+    //without a '#version', the shader is GLSL 1.10, and the defines go at the very top
+    int version = 110;
+    bool hasVersion = FindVersion(text, version);
+    context.mModernLines = version >= 300;
+
+    context.mOut.reserve(text.size() + 64 * defines.size());
+    if (!hasVersion && !defines.empty())
+    {
+        AppendDefines(context, defines);
+        AppendLineDirective(context, 1, 0);
+    }
+
+    const ShaderDefineList noDefines;
+    Expand(context, root, 0, hasVersion ? &defines : &noDefines);
+
+    if (outFiles != nullptr)
+        *outFiles = std::move(context.mFiles);
+
+    return std::move(context.mOut);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::SubmitProgramVariant(PendingProgramPtr& outPending, const ShaderSourceList& shaderSources, const ShaderDefineList& defines,
+    bool separate, const ShaderPathList& sourcePaths)
+{
+    GLUF_PROFILE_ZONE("ShaderManager::SubmitProgramVariant");
+
+    ShaderSourceList preprocessed;
+    for (const auto& it : shaderSources)
+    {
+        auto path = sourcePaths.find(it.first);
+        preprocessed.insert({ it.first, PreprocessShader(it.second, defines, path == sourcePaths.end() ? std::string() : path->second) });
+    }
+
+    //the defines are part of the text, so this is the permutation, no matter which material asked for it
+    uint64_t key = HashProgramSources(preprocessed, separate);
+
+    _TSAFE_SCOPE(mVariantMutex);
+    ++mVariantStats.mRequests;
+
+    auto found = mProgramVariants.find(key);
+    if (found != mProgramVariants.end())
+    {
+        outPending = found->second;
+        return;
+    }
+
+    ++mVariantStats.mCompiled;
+    SubmitProgram(outPending, std::move(preprocessed), separate);
+    mProgramVariants.insert({ key, outPending });
+    mVariantStats.mCached = mProgramVariants.size();
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::CreateProgramVariant(ProgramPtr& outProgram, const ShaderSourceList& shaderSources, const ShaderDefineList& defines, bool separate)
+{
+    PendingProgramPtr pending;
+    SubmitProgramVariant(pending, shaderSources, defines, separate);
+    ResolveProgram(outProgram, pending);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::CreateProgramVariantFromFiles(ProgramPtr& outProgram, const ShaderPathList& shaderPaths, const ShaderDefineList& defines, bool separate)
+{
+    ShaderSourceList sources;
+    ShaderPreprocessor::LoadSources(shaderPaths, sources);
+
+    PendingProgramPtr pending;
+    SubmitProgramVariant(pending, sources, defines, separate, shaderPaths);
+    ResolveProgram(outProgram, pending);
+}
+
+//--------------------------------------------------------------------------------------
+ProgramVariantStats ShaderManager::GetProgramVariantStats() const
+{
+    _TSAFE_SCOPE(mVariantMutex);
+
+    return mVariantStats;
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::FlushProgramVariants()
+{
+    _TSAFE_SCOPE(mVariantMutex);
+
+    mProgramVariants.clear();
+    mVariantStats = ProgramVariantStats();
+}
+
+//for removing things
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::DeleteShader(ShaderPtr& shader) noexcept
+{
+    //make sure it exists
+    if (shader)
+        shader->Destroy();
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::DeleteProgram(ProgramPtr& program) noexcept
+{
+    //make sure it exists
+    if (program)
+        program->Destroy();
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::FlushLogs() 
+{
+    mLinklogs.clear();
+    mCompileLogs.clear();
+}
+
+
+//for accessing things
+
+//--------------------------------------------------------------------------------------
+const GLuint ShaderManager::GetShaderId(const ShaderPtr& shader) const
+{
+    GLUF_NULLPTR_CHECK(shader);
+
+    return shader->mShaderId;
+}
+
+
+//--------------------------------------------------------------------------------------
+const ShaderType ShaderManager::GetShaderType(const ShaderPtr& shader) const
+{
+    GLUF_NULLPTR_CHECK(shader);
+
+    return shader->mShaderType;
+}
+
+
+//--------------------------------------------------------------------------------------
+const GLuint ShaderManager::GetProgramId(const ProgramPtr& program) const
+{
+    GLUF_NULLPTR_CHECK(program);
+
+    return program->mProgramId;
+}
+
+//--------------------------------------------------------------------------------------
+const CompileOutputStruct ShaderManager::GetShaderLog(const ShaderPtr& shaderPtr) const
+{
+    GLUF_NULLPTR_CHECK(shaderPtr);
+    _TSAFE_SCOPE(mCompLogMutex);
+
+    return mCompileLogs.find(shaderPtr)->second;
+}
+
+
+//--------------------------------------------------------------------------------------
+const LinkOutputStruct ShaderManager::GetProgramLog(const ProgramPtr& programPtr) const
+{
+    GLUF_NULLPTR_CHECK(programPtr);
+    _TSAFE_SCOPE(mLinkLogMutex);
+
+    return mLinklogs.find(programPtr)->second;
+}
+
+//for using things
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::UseProgram(const ProgramPtr& program) const
+{
+    GLUF_NULLPTR_CHECK(program);
+
+    //binding a null program means the program is uninitialized or broken, which is an error
+    if (program->GetId() == 0)
+        GLUF_NON_CRITICAL_EXCEPTION(UseProgramException());
+
+    //the program may have been changed behind our back through 'GLSTATE'
+    if (mBoundProgram == program && mBoundProgramId == program->mProgramId && GLSTATE.GetProgram() == program->mProgramId)
+    {
+        ++mUniformShadowStats.mBindsSkipped;
+        return;
+    }
+
+    //make sure this is not bound when using a program
+    GLSTATE.BindProgramPipeline(0);
+
+    GLSTATE.UseProgram(program->mProgramId);
+
+    mBoundProgram = program;
+    mBoundProgramId = program->mProgramId;
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::UseProgramNull() const noexcept
+{
+    GLSTATE.UseProgram(0);
+    GLSTATE.BindProgramPipeline(0);//juse in case we are using pipelines
+
+    mBoundProgram = nullptr;
+    mBoundProgramId = 0;
+}
+
+//--------------------------------------------------------------------------------------
+UniformShadowStats ShaderManager::GetUniformShadowStats() const noexcept
+{
+    return mUniformShadowStats;
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::ResetUniformShadowStats() noexcept
+{
+    mUniformShadowStats = UniformShadowStats();
+}
+
+//--------------------------------------------------------------------------------------
+bool ShaderManager::UniformChanged(Program* program, GLuint loc, GLenum setterType, const void* value, std::size_t size, GLsizei count) const noexcept
+{
+    //this also catches location -1, which OpenGL ignores anyway
+    if (program == nullptr || loc >= program->mUniformShadowSlots.size() || count < 1)
+        return true;
+
+    auto& slots = program->mUniformShadowSlots;
+
+#ifdef GLUF_DEBUG
+    const Program::UniformShadowSlot& first = slots[loc];
+    if (first.mUniformType != GL_NONE)
+    {
+        if (!UniformSetterMatches(first.mUniformType, setterType))
+        {
+            GLUF_ERROR_LONG("(ShaderManager): Uniform at Location " << loc << " Is Type 0x" << std::hex << first.mUniformType <<
+                ", But Was Set as Type 0x" << setterType << std::dec);
+        }
+        else if (count > first.mElementsLeft)
+        {
+            GLUF_ERROR_LONG("(ShaderManager): " << count << " Elements Set at Location " << loc << ", But the Array Only Has " << first.mElementsLeft << " Left");
+        }
+    }
+#endif
+
+    //every element has to be shadowed as this type for the upload to be skippable
+    if (loc + count > slots.size())
+        return true;
+
+    bool changed = false;
+    const char* values = static_cast<const char*>(value);
+    for (GLsizei i = 0; i < count; ++i)
+    {
+        const Program::UniformShadowSlot& slot = slots[loc + i];
+        if (slot.mType != setterType || slot.mSize != size)
+            return true;
+
+        changed = changed || !slot.mValid || std::memcmp(program->mUniformShadow.data() + slot.mOffset, values + i * size, size) != 0;
+    }
+
+    if (!changed)
+    {
+        ++mUniformShadowStats.mUniformsSkipped;
+        return false;
+    }
+
+    for (GLsizei i = 0; i < count; ++i)
+    {
+        Program::UniformShadowSlot& slot = slots[loc + i];
+        std::memcpy(program->mUniformShadow.data() + slot.mOffset, values + i * size, size);
+        slot.mValid = true;
+    }
+    return true;
+}
+
+//--------------------------------------------------------------------------------------
+bool ShaderManager::BoundUniformChanged(GLuint loc, GLenum setterType, const void* value, std::size_t size, GLsizei count) const noexcept
+{
+    //the value lands in the current program, whose shadow we only have if it is still 'mBoundProgram'
+    GLuint current = GLSTATE.GetProgram();
+    if (current != mBoundProgramId)
+    {
+#ifdef GLUF_DEBUG
+        if (current != GLUF_STATE_UNKNOWN)
+        {
+            GLUF_ERROR_LONG("(ShaderManager): Program " << current << " Is Current, But the Manager Bound Program " << mBoundProgramId <<
+                "; Use 'SHADERMANAGER.UseProgram' Before Setting Uniforms");
+        }
+#endif
+        return true;
+    }
+
+    return UniformChanged(mBoundProgram.get(), loc, setterType, value, size, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::CreateSeparateProgram(SepProgramPtr& ppo, const ProgramPtrList& programs) const
+{
+    ppo = std::make_shared<SeparateProgram>();
+
+    try
+    {
+        //initialize the PPO
+        ppo->Init();
+
+        for (auto it : programs)
+        {
+            GLUF_NULLPTR_CHECK(it);
+            if (it->GetId() == 0)
+                GLUF_CRITICAL_EXCEPTION(std::invalid_argument("Uninitialized Program Attempted to be Added to a PPO"));
+
+            ppo->AttachProgram(it);
+        }
+    }
+    catch (const CreateGLPPOException& e)
+    {
+        GLUF_ERROR_LONG("(ShaderManager): " << e.what());
+        GLUF_CRITICAL_EXCEPTION(MakePPOException());
+    }
+    catch (const std::invalid_argument& e)
+    {
+        GLUF_ERROR_LONG("(ShaderManager): " << e.what());
+        RETHROW;
+    }
+}
+
+//--------------------------------------------------------------------------------------
+const GLuint ShaderManager::GetShaderVariableLocation(const ProgramPtr& program, LocationType locType, const std::string& varName) const
+{
+    GLUF_NULLPTR_CHECK(program);
+
+    VariableLocMap::iterator it;
+
+    if (locType == GLT_ATTRIB)
+    {
+        it = program->mAttributeLocations.find(varName);
+
+        if (it == program->mAttributeLocations.end())
+        {
+            GLUF_NON_CRITICAL_EXCEPTION(std::invalid_argument("\"varName\" Could not be found when searching program attributes!"));
+            return 0;
+        }
+    }
+    else
+    {
+        it = program->mUniformLocations.find(varName);
+
+        if (it == program->mUniformLocations.end())
+        {
+            GLUF_NON_CRITICAL_EXCEPTION(std::invalid_argument("\"varName\" Could not be found when searching program uniforms!"));
+            return 0;
+        }
+    }
+
+    return it->second;
+}
+
+//--------------------------------------------------------------------------------------
+const VariableLocMap& ShaderManager::GetShaderAttribLocations(const ProgramPtr& program) const
+{
+    GLUF_NULLPTR_CHECK(program);
+    return program->mAttributeLocations;
+}
+
+//--------------------------------------------------------------------------------------
+const VariableLocMap& ShaderManager::GetShaderUniformLocations(const ProgramPtr& program) const
+{
+    GLUF_NULLPTR_CHECK(program);
+    return program->mUniformLocations;
+}
+
+//--------------------------------------------------------------------------------------
+const VariableLocMap ShaderManager::GetShaderAttribLocations(const SepProgramPtr& program) const
+{
+    GLUF_NULLPTR_CHECK(program);
+    VariableLocMap ret;
+
+    for (auto it : program->mPrograms)
+    {
+        ret.insert(it->mAttributeLocations.begin(), it->mAttributeLocations.end());
+    }
+
+    return ret;
+}
+
+//--------------------------------------------------------------------------------------
+const VariableLocMap ShaderManager::GetShaderUniformLocations(const SepProgramPtr& program) const
+{
+    GLUF_NULLPTR_CHECK(program);
+
+    VariableLocMap ret;
+
+    for (auto it : program->mPrograms)
+    {
+        ret.insert(it->mUniformLocations.begin(), it->mUniformLocations.end());
+    }
+
+    return ret;
+}
+
+//--------------------------------------------------------------------------------------
+const ShaderVariableInfo& ShaderManager::GetShaderVariableInfo(const ProgramPtr& program, LocationType locType, const std::string& varName) const
+{
+    static const ShaderVariableInfo none;
+
+    const ShaderVariableInfoMap& variables = GetShaderVariableInfo(program, locType);
+    auto it = variables.find(varName);
+    if (it == variables.end())
+    {
+        GLUF_NON_CRITICAL_EXCEPTION(std::invalid_argument("\"varName\" Could not be found when searching program variable info!"));
+        return none;
+    }
+
+    return it->second;
+}
+
+//--------------------------------------------------------------------------------------
+const ShaderVariableInfoMap& ShaderManager::GetShaderVariableInfo(const ProgramPtr& program, LocationType locType) const
+{
+    GLUF_NULLPTR_CHECK(program);
+    return (locType == GLT_ATTRIB) ? program->mAttributeInfo : program->mUniformInfo;
+}
+
+//--------------------------------------------------------------------------------------
+const ShaderVariableInfoMap ShaderManager::GetShaderVariableInfo(const SepProgramPtr& program, LocationType locType) const
+{
+    GLUF_NULLPTR_CHECK(program);
+
+    ShaderVariableInfoMap ret;
+
+    for (auto it : program->mPrograms)
+    {
+        const ShaderVariableInfoMap& variables = (locType == GLT_ATTRIB) ? it->mAttributeInfo : it->mUniformInfo;
+        ret.insert(variables.begin(), variables.end());
+    }
+
+    return ret;
+}
+
+//--------------------------------------------------------------------------------------
+const UniformBlockMap& ShaderManager::GetUniformBlocks(const ProgramPtr& program) const
+{
+    GLUF_NULLPTR_CHECK(program);
+    return program->mUniformBlocks;
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::SetUniformBlockBinding(const ProgramPtr& program, const std::string& blockName, GLuint binding) const
+{
+    GLUF_NULLPTR_CHECK(program);
+
+    auto it = program->mUniformBlocks.find(blockName);
+    if (it == program->mUniformBlocks.end())
+    {
+        GLUF_NON_CRITICAL_EXCEPTION(std::invalid_argument("\"blockName\" Could not be found when searching program uniform blocks!"));
+        return;
+    }
+
+    if (it->second.mBinding == binding)
+        return;
+
+    glUniformBlockBinding(program->mProgramId, it->second.mIndex, binding);
+    it->second.mBinding = binding;
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::AttachProgram(SepProgramPtr& ppo, const ProgramPtr& program) const
+{
+    GLUF_NULLPTR_CHECK(ppo);
+    GLUF_NULLPTR_CHECK(program);
+
+    if (program->GetId() == 0)
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("Uninitialized Program Attempted to be Added to a PPO"));
+
+    ppo->AttachProgram(program);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::AttachPrograms(SepProgramPtr& ppo, const ProgramPtrList& programs) const
+{
+    GLUF_NULLPTR_CHECK(ppo);
+
+    for (auto it : programs)
+    {
+        GLUF_NULLPTR_CHECK(it);
+        if (it->GetId() == 0)
+            GLUF_CRITICAL_EXCEPTION(std::invalid_argument("Uninitialized Program Attempted to be Added to a PPO"));
+
+        ppo->AttachProgram(it);
+    }
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::ClearPrograms(SepProgramPtr& ppo, GLbitfield stages) const
+{
+    GLUF_NULLPTR_CHECK(ppo);
+    ppo->ClearStages(stages);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::UseProgram(const SepProgramPtr& ppo) const
+{
+    GLUF_NULLPTR_CHECK(ppo);
+    GLSTATE.UseProgram(0);
+    GLSTATE.BindProgramPipeline(ppo->GetId());
+
+    //'GLUniform*' now goes to the PPO's active program, which is not tracked
+    mBoundProgram = nullptr;
+    mBoundProgramId = 0;
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLActiveShaderProgram(SepProgramPtr& ppo, ShaderType stage) const
+{
+    GLUF_NULLPTR_CHECK(ppo);
+    ppo->SetActiveShaderProgram(ShaderTypeToProgramStage(stage));
+}
+
+/*
+
+GLUniform*
+
+*/
+
+
+/*
+
+float's
+
+*/
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform1f(GLuint loc, const GLfloat& value) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_FLOAT, &value, sizeof(value)))
+        glUniform1f(loc, value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform2f(GLuint loc, const glm::vec2& value) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_FLOAT_VEC2, &value, sizeof(value)))
+        glUniform2fv(loc, 1, &value[0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform3f(GLuint loc, const glm::vec3& value) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_FLOAT_VEC3, &value, sizeof(value)))
+        glUniform3fv(loc, 1, &value[0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform4f(GLuint loc, const glm::vec4& value) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_FLOAT_VEC4, &value, sizeof(value)))
+        glUniform4fv(loc, 1, &value[0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform1f(const ProgramPtr& prog, const std::string& name, const GLfloat& value) const 
+{    
+    GLUniform1f(GetUniformIdFromName(prog, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform2f(const ProgramPtr& prog, const std::string& name, const glm::vec2& value) const 
+{
+    GLUniform2f(GetUniformIdFromName(prog, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform3f(const ProgramPtr& prog, const std::string& name, const glm::vec3& value) const
+{
+    GLUniform3f(GetUniformIdFromName(prog, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform4f(const ProgramPtr& prog, const std::string& name, const glm::vec4& value) const 
+{
+    GLUniform4f(GetUniformIdFromName(prog, name), value);
+}
+
+/*
+
+int's
+
+*/
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform1i(GLuint loc, const GLint& value) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_INT, &value, sizeof(value)))
+        glUniform1i(loc, value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform2i(GLuint loc, const glm::i32vec2& value) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_INT_VEC2, &value, sizeof(value)))
+        glUniform2iv(loc, 1, &value[0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform3i(GLuint loc, const glm::i32vec3& value) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_INT_VEC3, &value, sizeof(value)))
+        glUniform3iv(loc, 1, &value[0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform4i(GLuint loc, const glm::i32vec4& value) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_INT_VEC4, &value, sizeof(value)))
+        glUniform4iv(loc, 1, &value[0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform1i(const ProgramPtr& prog, const std::string& name, const GLint& value) const 
+{
+    GLUniform1i(GetUniformIdFromName(prog, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform2i(const ProgramPtr& prog, const std::string& name, const glm::i32vec2& value) const 
+{
+    GLUniform2i(GetUniformIdFromName(prog, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform3i(const ProgramPtr& prog, const std::string& name, const glm::i32vec3& value) const
+{
+    GLUniform3i(GetUniformIdFromName(prog, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform4i(const ProgramPtr& prog, const std::string& name, const glm::i32vec4& value) const 
+{
+    GLUniform4i(GetUniformIdFromName(prog, name), value);
+}
+
+
+/*
+
+uint's
+
+*/
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform1ui(GLuint loc, const GLuint& value) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_UNSIGNED_INT, &value, sizeof(value)))
+        glUniform1ui(loc, value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform2ui(GLuint loc, const glm::u32vec2& value) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_UNSIGNED_INT_VEC2, &value, sizeof(value)))
+        glUniform2uiv(loc, 1, &value[0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform3ui(GLuint loc, const glm::u32vec3& value) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_UNSIGNED_INT_VEC3, &value, sizeof(value)))
+        glUniform3uiv(loc, 1, &value[0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform4ui(GLuint loc, const glm::u32vec4& value) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_UNSIGNED_INT_VEC4, &value, sizeof(value)))
+        glUniform4uiv(loc, 1, &value[0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform1ui(const ProgramPtr& prog, const std::string& name, const GLuint& value) const 
+{
+    GLUniform1ui(GetUniformIdFromName(prog, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform2ui(const ProgramPtr& prog, const std::string& name, const glm::u32vec2& value) const 
+{
+    GLUniform2ui(GetUniformIdFromName(prog, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform3ui(const ProgramPtr& prog, const std::string& name, const glm::u32vec3& value) const
+{
+    GLUniform3ui(GetUniformIdFromName(prog, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform4ui(const ProgramPtr& prog, const std::string& name, const glm::u32vec4& value) const
+{
+    GLUniform4ui(GetUniformIdFromName(prog, name), value);
+}
+
+/*
+
+matrices
+
+*/
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix2f(GLuint loc, const glm::mat2& value) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_FLOAT_MAT2, &value, sizeof(value)))
+        glUniformMatrix2fv(loc, 1, 0, &value[0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix3f(GLuint loc, const glm::mat3& value) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_FLOAT_MAT3, &value, sizeof(value)))
+        glUniformMatrix3fv(loc, 1, 0, &value[0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix4f(GLuint loc, const glm::mat4& value) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_FLOAT_MAT4, &value, sizeof(value)))
+        glUniformMatrix4fv(loc, 1, 0, &value[0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix2x3f(GLuint loc, const glm::mat2x3& value) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_FLOAT_MAT2x3, &value, sizeof(value)))
+        glUniformMatrix2x3fv(loc, 1, 0, &value[0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix3x2f(GLuint loc, const glm::mat3x2& value) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_FLOAT_MAT3x2, &value, sizeof(value)))
+        glUniformMatrix3x2fv(loc, 1, 0, &value[0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix2x4f(GLuint loc, const glm::mat2x4& value) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_FLOAT_MAT2x4, &value, sizeof(value)))
+        glUniformMatrix2x4fv(loc, 1, 0, &value[0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix4x2f(GLuint loc, const glm::mat4x2& value) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_FLOAT_MAT4x2, &value, sizeof(value)))
+        glUniformMatrix4x2fv(loc, 1, 0, &value[0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix3x4f(GLuint loc, const glm::mat3x4& value) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_FLOAT_MAT3x4, &value, sizeof(value)))
+        glUniformMatrix3x4fv(loc, 1, 0, &value[0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix4x3f(GLuint loc, const glm::mat4x3& value) const noexcept
+{
+    //warning here can be IGNORED
+    if (BoundUniformChanged(loc, GL_FLOAT_MAT4x3, &value, sizeof(value)))
+        glUniformMatrix4x3fv(loc, 1, 0, &value[0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix2f(const ProgramPtr& prog, const std::string& name, const glm::mat2& value) const
+{
+    GLUniformMatrix2f(GetUniformIdFromName(prog, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix3f(const ProgramPtr& prog, const std::string& name, const glm::mat3& value) const
+{
+    GLUniformMatrix3f(GetUniformIdFromName(prog, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix4f(const ProgramPtr& prog, const std::string& name, const glm::mat4& value) const
+{
+    GLUniformMatrix4f(GetUniformIdFromName(prog, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix2x3f(const ProgramPtr& prog, const std::string& name, const glm::mat2x3& value) const
+{
+    GLUniformMatrix2x3f(GetUniformIdFromName(prog, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix3x2f(const ProgramPtr& prog, const std::string& name, const glm::mat3x2& value) const
+{
+    GLUniformMatrix3x2f(GetUniformIdFromName(prog, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix2x4f(const ProgramPtr& prog, const std::string& name, const glm::mat2x4& value) const
+{
+    GLUniformMatrix2x4f(GetUniformIdFromName(prog, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix4x2f(const ProgramPtr& prog, const std::string& name, const glm::mat4x2& value) const
+{
+    GLUniformMatrix4x2f(GetUniformIdFromName(prog, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix3x4f(const ProgramPtr& prog, const std::string& name, const glm::mat3x4& value) const
+{
+    GLUniformMatrix3x4f(GetUniformIdFromName(prog, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix4x3f(const ProgramPtr& prog, const std::string& name, const glm::mat4x3& value) const
+{
+    GLUniformMatrix4x3f(GetUniformIdFromName(prog, name), value);
+}
+
+/*
+
+handles; a missing uniform has location -1, which OpenGL silently ignores
+
+*/
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform1f(UniformHandle handle, const GLfloat& value) const noexcept
+{
+    GLUniform1f(static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform2f(UniformHandle handle, const glm::vec2& value) const noexcept
+{
+    GLUniform2f(static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform3f(UniformHandle handle, const glm::vec3& value) const noexcept
+{
+    GLUniform3f(static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform4f(UniformHandle handle, const glm::vec4& value) const noexcept
+{
+    GLUniform4f(static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform1i(UniformHandle handle, const GLint& value) const noexcept
+{
+    GLUniform1i(static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform2i(UniformHandle handle, const glm::i32vec2& value) const noexcept
+{
+    GLUniform2i(static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform3i(UniformHandle handle, const glm::i32vec3& value) const noexcept
+{
+    GLUniform3i(static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform4i(UniformHandle handle, const glm::i32vec4& value) const noexcept
+{
+    GLUniform4i(static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform1ui(UniformHandle handle, const GLuint& value) const noexcept
+{
+    GLUniform1ui(static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform2ui(UniformHandle handle, const glm::u32vec2& value) const noexcept
+{
+    GLUniform2ui(static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform3ui(UniformHandle handle, const glm::u32vec3& value) const noexcept
+{
+    GLUniform3ui(static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform4ui(UniformHandle handle, const glm::u32vec4& value) const noexcept
+{
+    GLUniform4ui(static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix2f(UniformHandle handle, const glm::mat2& value) const noexcept
+{
+    GLUniformMatrix2f(static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix3f(UniformHandle handle, const glm::mat3& value) const noexcept
+{
+    GLUniformMatrix3f(static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix4f(UniformHandle handle, const glm::mat4& value) const noexcept
+{
+    GLUniformMatrix4f(static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix2x3f(UniformHandle handle, const glm::mat2x3& value) const noexcept
+{
+    GLUniformMatrix2x3f(static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix3x2f(UniformHandle handle, const glm::mat3x2& value) const noexcept
+{
+    GLUniformMatrix3x2f(static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix2x4f(UniformHandle handle, const glm::mat2x4& value) const noexcept
+{
+    GLUniformMatrix2x4f(static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix4x2f(UniformHandle handle, const glm::mat4x2& value) const noexcept
+{
+    GLUniformMatrix4x2f(static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix3x4f(UniformHandle handle, const glm::mat3x4& value) const noexcept
+{
+    GLUniformMatrix3x4f(static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix4x3f(UniformHandle handle, const glm::mat4x3& value) const noexcept
+{
+    GLUniformMatrix4x3f(static_cast<GLuint>(handle.mLocation), value);
+}
+
+
+
+/*
+
+Uniform Arrays
+
+*/
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform1fv(GLuint loc, const GLfloat* values, GLsizei count) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_FLOAT, values, sizeof(GLfloat), count))
+        glUniform1fv(loc, count, values);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform2fv(GLuint loc, const glm::vec2* values, GLsizei count) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_FLOAT_VEC2, values, sizeof(glm::vec2), count))
+        glUniform2fv(loc, count, &values[0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform3fv(GLuint loc, const glm::vec3* values, GLsizei count) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_FLOAT_VEC3, values, sizeof(glm::vec3), count))
+        glUniform3fv(loc, count, &values[0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform4fv(GLuint loc, const glm::vec4* values, GLsizei count) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_FLOAT_VEC4, values, sizeof(glm::vec4), count))
+        glUniform4fv(loc, count, &values[0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform1iv(GLuint loc, const GLint* values, GLsizei count) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_INT, values, sizeof(GLint), count))
+        glUniform1iv(loc, count, values);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform2iv(GLuint loc, const glm::i32vec2* values, GLsizei count) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_INT_VEC2, values, sizeof(glm::i32vec2), count))
+        glUniform2iv(loc, count, &values[0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform3iv(GLuint loc, const glm::i32vec3* values, GLsizei count) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_INT_VEC3, values, sizeof(glm::i32vec3), count))
+        glUniform3iv(loc, count, &values[0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform4iv(GLuint loc, const glm::i32vec4* values, GLsizei count) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_INT_VEC4, values, sizeof(glm::i32vec4), count))
+        glUniform4iv(loc, count, &values[0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform1uiv(GLuint loc, const GLuint* values, GLsizei count) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_UNSIGNED_INT, values, sizeof(GLuint), count))
+        glUniform1uiv(loc, count, values);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform2uiv(GLuint loc, const glm::u32vec2* values, GLsizei count) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_UNSIGNED_INT_VEC2, values, sizeof(glm::u32vec2), count))
+        glUniform2uiv(loc, count, &values[0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform3uiv(GLuint loc, const glm::u32vec3* values, GLsizei count) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_UNSIGNED_INT_VEC3, values, sizeof(glm::u32vec3), count))
+        glUniform3uiv(loc, count, &values[0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform4uiv(GLuint loc, const glm::u32vec4* values, GLsizei count) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_UNSIGNED_INT_VEC4, values, sizeof(glm::u32vec4), count))
+        glUniform4uiv(loc, count, &values[0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix2fv(GLuint loc, const glm::mat2* values, GLsizei count) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_FLOAT_MAT2, values, sizeof(glm::mat2), count))
+        glUniformMatrix2fv(loc, count, 0, &values[0][0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix3fv(GLuint loc, const glm::mat3* values, GLsizei count) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_FLOAT_MAT3, values, sizeof(glm::mat3), count))
+        glUniformMatrix3fv(loc, count, 0, &values[0][0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix4fv(GLuint loc, const glm::mat4* values, GLsizei count) const noexcept
+{
+    if (BoundUniformChanged(loc, GL_FLOAT_MAT4, values, sizeof(glm::mat4), count))
+        glUniformMatrix4fv(loc, count, 0, &values[0][0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform1fv(const ProgramPtr& prog, const std::string& name, const GLfloat* values, GLsizei count) const
+{
+    GLUniform1fv(GetUniformIdFromName(prog, name), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform2fv(const ProgramPtr& prog, const std::string& name, const glm::vec2* values, GLsizei count) const
+{
+    GLUniform2fv(GetUniformIdFromName(prog, name), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform3fv(const ProgramPtr& prog, const std::string& name, const glm::vec3* values, GLsizei count) const
+{
+    GLUniform3fv(GetUniformIdFromName(prog, name), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform4fv(const ProgramPtr& prog, const std::string& name, const glm::vec4* values, GLsizei count) const
+{
+    GLUniform4fv(GetUniformIdFromName(prog, name), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform1iv(const ProgramPtr& prog, const std::string& name, const GLint* values, GLsizei count) const
+{
+    GLUniform1iv(GetUniformIdFromName(prog, name), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform2iv(const ProgramPtr& prog, const std::string& name, const glm::i32vec2* values, GLsizei count) const
+{
+    GLUniform2iv(GetUniformIdFromName(prog, name), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform3iv(const ProgramPtr& prog, const std::string& name, const glm::i32vec3* values, GLsizei count) const
+{
+    GLUniform3iv(GetUniformIdFromName(prog, name), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform4iv(const ProgramPtr& prog, const std::string& name, const glm::i32vec4* values, GLsizei count) const
+{
+    GLUniform4iv(GetUniformIdFromName(prog, name), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform1uiv(const ProgramPtr& prog, const std::string& name, const GLuint* values, GLsizei count) const
+{
+    GLUniform1uiv(GetUniformIdFromName(prog, name), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform2uiv(const ProgramPtr& prog, const std::string& name, const glm::u32vec2* values, GLsizei count) const
+{
+    GLUniform2uiv(GetUniformIdFromName(prog, name), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform3uiv(const ProgramPtr& prog, const std::string& name, const glm::u32vec3* values, GLsizei count) const
+{
+    GLUniform3uiv(GetUniformIdFromName(prog, name), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform4uiv(const ProgramPtr& prog, const std::string& name, const glm::u32vec4* values, GLsizei count) const
+{
+    GLUniform4uiv(GetUniformIdFromName(prog, name), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix2fv(const ProgramPtr& prog, const std::string& name, const glm::mat2* values, GLsizei count) const
+{
+    GLUniformMatrix2fv(GetUniformIdFromName(prog, name), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix3fv(const ProgramPtr& prog, const std::string& name, const glm::mat3* values, GLsizei count) const
+{
+    GLUniformMatrix3fv(GetUniformIdFromName(prog, name), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix4fv(const ProgramPtr& prog, const std::string& name, const glm::mat4* values, GLsizei count) const
+{
+    GLUniformMatrix4fv(GetUniformIdFromName(prog, name), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform1fv(UniformHandle handle, const GLfloat* values, GLsizei count) const noexcept
+{
+    GLUniform1fv(static_cast<GLuint>(handle.mLocation), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform2fv(UniformHandle handle, const glm::vec2* values, GLsizei count) const noexcept
+{
+    GLUniform2fv(static_cast<GLuint>(handle.mLocation), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform3fv(UniformHandle handle, const glm::vec3* values, GLsizei count) const noexcept
+{
+    GLUniform3fv(static_cast<GLuint>(handle.mLocation), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform4fv(UniformHandle handle, const glm::vec4* values, GLsizei count) const noexcept
+{
+    GLUniform4fv(static_cast<GLuint>(handle.mLocation), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform1iv(UniformHandle handle, const GLint* values, GLsizei count) const noexcept
+{
+    GLUniform1iv(static_cast<GLuint>(handle.mLocation), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform2iv(UniformHandle handle, const glm::i32vec2* values, GLsizei count) const noexcept
+{
+    GLUniform2iv(static_cast<GLuint>(handle.mLocation), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform3iv(UniformHandle handle, const glm::i32vec3* values, GLsizei count) const noexcept
+{
+    GLUniform3iv(static_cast<GLuint>(handle.mLocation), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform4iv(UniformHandle handle, const glm::i32vec4* values, GLsizei count) const noexcept
+{
+    GLUniform4iv(static_cast<GLuint>(handle.mLocation), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform1uiv(UniformHandle handle, const GLuint* values, GLsizei count) const noexcept
+{
+    GLUniform1uiv(static_cast<GLuint>(handle.mLocation), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform2uiv(UniformHandle handle, const glm::u32vec2* values, GLsizei count) const noexcept
+{
+    GLUniform2uiv(static_cast<GLuint>(handle.mLocation), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform3uiv(UniformHandle handle, const glm::u32vec3* values, GLsizei count) const noexcept
+{
+    GLUniform3uiv(static_cast<GLuint>(handle.mLocation), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniform4uiv(UniformHandle handle, const glm::u32vec4* values, GLsizei count) const noexcept
+{
+    GLUniform4uiv(static_cast<GLuint>(handle.mLocation), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix2fv(UniformHandle handle, const glm::mat2* values, GLsizei count) const noexcept
+{
+    GLUniformMatrix2fv(static_cast<GLuint>(handle.mLocation), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix3fv(UniformHandle handle, const glm::mat3* values, GLsizei count) const noexcept
+{
+    GLUniformMatrix3fv(static_cast<GLuint>(handle.mLocation), values, count);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLUniformMatrix4fv(UniformHandle handle, const glm::mat4* values, GLsizei count) const noexcept
+{
+    GLUniformMatrix4fv(static_cast<GLuint>(handle.mLocation), values, count);
+}
+
+
+
+
+
+/*
+
+GLProgramUniform*
+
+
+*/
+
+//macro for easier readibility; the purpose of this line is to throw a 'NoActiveProgramUniformException' in debug mode 
+#ifdef _DEBUG
+
+#define HAS_ACTIVE_PROGRAM(ppo) ppo->GetActiveProgram();
+
+#else
+
+#define HAS_ACTIVE_PROGRAM(ppo)
+
+#endif
+
+/*
+
+float's
+
+*/
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform1f(const SepProgramPtr& ppo, GLuint loc, const GLfloat& value) const
+{
+    HAS_ACTIVE_PROGRAM(ppo);
+
+    const ProgramPtr& program = ppo->GetActiveProgram();
+    if (UniformChanged(program.get(), loc, GL_FLOAT, &value, sizeof(value)))
+        glProgramUniform1f(program->GetId(), loc, value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform2f(const SepProgramPtr& ppo, GLuint loc, const glm::vec2& value) const
+{
+    HAS_ACTIVE_PROGRAM(ppo);
+
+    const ProgramPtr& program = ppo->GetActiveProgram();
+    if (UniformChanged(program.get(), loc, GL_FLOAT_VEC2, &value, sizeof(value)))
+        glProgramUniform2fv(program->GetId(), loc, 1, &value[0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform3f(const SepProgramPtr& ppo, GLuint loc, const glm::vec3& value) const
+{
+    HAS_ACTIVE_PROGRAM(ppo);
+
+    const ProgramPtr& program = ppo->GetActiveProgram();
+    if (UniformChanged(program.get(), loc, GL_FLOAT_VEC3, &value, sizeof(value)))
+        glProgramUniform3fv(program->GetId(), loc, 1, &value[0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform4f(const SepProgramPtr& ppo, GLuint loc, const glm::vec4& value) const
+{
+    HAS_ACTIVE_PROGRAM(ppo);
+
+    const ProgramPtr& program = ppo->GetActiveProgram();
+    if (UniformChanged(program.get(), loc, GL_FLOAT_VEC4, &value, sizeof(value)))
+        glProgramUniform4fv(program->GetId(), loc, 1, &value[0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform1f(const SepProgramPtr& ppo, const std::string& name, const GLfloat& value) const
+{
+    GLProgramUniform1f(ppo, GetUniformIdFromName(ppo, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform2f(const SepProgramPtr& ppo, const std::string& name, const glm::vec2& value) const
+{
+    GLProgramUniform2f(ppo, GetUniformIdFromName(ppo, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform3f(const SepProgramPtr& ppo, const std::string& name, const glm::vec3& value) const
+{
+    GLProgramUniform3f(ppo, GetUniformIdFromName(ppo, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform4f(const SepProgramPtr& ppo, const std::string& name, const glm::vec4& value) const
+{
+    GLProgramUniform4f(ppo, GetUniformIdFromName(ppo, name), value);
+}
+
+
+/*
+
+int's
+
+*/
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform1i(const SepProgramPtr& ppo, GLuint loc, const GLint& value) const
+{
+    HAS_ACTIVE_PROGRAM(ppo);
+
+    const ProgramPtr& program = ppo->GetActiveProgram();
+    if (UniformChanged(program.get(), loc, GL_INT, &value, sizeof(value)))
+        glProgramUniform1i(program->GetId(), loc, value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform2i(const SepProgramPtr& ppo, GLuint loc, const glm::i32vec2& value) const
+{
+    HAS_ACTIVE_PROGRAM(ppo);
+
+    const ProgramPtr& program = ppo->GetActiveProgram();
+    if (UniformChanged(program.get(), loc, GL_INT_VEC2, &value, sizeof(value)))
+        glProgramUniform2iv(program->GetId(), loc, 1, &value[0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform3i(const SepProgramPtr& ppo, GLuint loc, const glm::i32vec3& value) const
+{
+    HAS_ACTIVE_PROGRAM(ppo);
+
+    const ProgramPtr& program = ppo->GetActiveProgram();
+    if (UniformChanged(program.get(), loc, GL_INT_VEC3, &value, sizeof(value)))
+        glProgramUniform3iv(program->GetId(), loc, 1, &value[0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform4i(const SepProgramPtr& ppo, GLuint loc, const glm::i32vec4& value) const
+{
+    HAS_ACTIVE_PROGRAM(ppo);
+
+    const ProgramPtr& program = ppo->GetActiveProgram();
+    if (UniformChanged(program.get(), loc, GL_INT_VEC4, &value, sizeof(value)))
+        glProgramUniform4iv(program->GetId(), loc, 1, &value[0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform1i(const SepProgramPtr& ppo, const std::string& name, const GLint& value) const
+{
+    GLProgramUniform1i(ppo, GetUniformIdFromName(ppo, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform2i(const SepProgramPtr& ppo, const std::string& name, const glm::i32vec2& value) const
+{
+    GLProgramUniform2i(ppo, GetUniformIdFromName(ppo, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform3i(const SepProgramPtr& ppo, const std::string& name, const glm::i32vec3& value) const
+{
+    GLProgramUniform3i(ppo, GetUniformIdFromName(ppo, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform4i(const SepProgramPtr& ppo, const std::string& name, const glm::i32vec4& value) const
+{
+    GLProgramUniform4i(ppo, GetUniformIdFromName(ppo, name), value);
+}
+
+
+/*
+
+uint's
+
+*/
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform1ui(const SepProgramPtr& ppo, GLuint loc, const GLuint& value) const
+{
+    HAS_ACTIVE_PROGRAM(ppo);
+
+    const ProgramPtr& program = ppo->GetActiveProgram();
+    if (UniformChanged(program.get(), loc, GL_UNSIGNED_INT, &value, sizeof(value)))
+        glProgramUniform1ui(program->GetId(), loc, value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform2ui(const SepProgramPtr& ppo, GLuint loc, const glm::u32vec2& value) const
+{
+    HAS_ACTIVE_PROGRAM(ppo);
+
+    const ProgramPtr& program = ppo->GetActiveProgram();
+    if (UniformChanged(program.get(), loc, GL_UNSIGNED_INT_VEC2, &value, sizeof(value)))
+        glProgramUniform2uiv(program->GetId(), loc, 1, &value[0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform3ui(const SepProgramPtr& ppo, GLuint loc, const glm::u32vec3& value) const
+{
+    HAS_ACTIVE_PROGRAM(ppo);
+
+    const ProgramPtr& program = ppo->GetActiveProgram();
+    if (UniformChanged(program.get(), loc, GL_UNSIGNED_INT_VEC3, &value, sizeof(value)))
+        glProgramUniform3uiv(program->GetId(), loc, 1, &value[0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform4ui(const SepProgramPtr& ppo, GLuint loc, const glm::u32vec4& value) const
+{
+    HAS_ACTIVE_PROGRAM(ppo);
+
+    const ProgramPtr& program = ppo->GetActiveProgram();
+    if (UniformChanged(program.get(), loc, GL_UNSIGNED_INT_VEC4, &value, sizeof(value)))
+        glProgramUniform4uiv(program->GetId(), loc, 1, &value[0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform1ui(const SepProgramPtr& ppo, const std::string& name, const GLuint& value) const
+{
+    GLProgramUniform1ui(ppo, GetUniformIdFromName(ppo, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform2ui(const SepProgramPtr& ppo, const std::string& name, const glm::u32vec2& value) const
+{
+    GLProgramUniform2ui(ppo, GetUniformIdFromName(ppo, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform3ui(const SepProgramPtr& ppo, const std::string& name, const glm::u32vec3& value) const
+{
+    GLProgramUniform3ui(ppo, GetUniformIdFromName(ppo, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform4ui(const SepProgramPtr& ppo, const std::string& name, const glm::u32vec4& value) const
+{
+    GLProgramUniform4ui(ppo, GetUniformIdFromName(ppo, name), value);
+}
+
+/*
+
+matricies
+
+*/
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniformMatrix2f(const SepProgramPtr& ppo, GLuint loc, const glm::mat2& value) const
+{
+    HAS_ACTIVE_PROGRAM(ppo);
+
+    const ProgramPtr& program = ppo->GetActiveProgram();
+    if (UniformChanged(program.get(), loc, GL_FLOAT_MAT2, &value, sizeof(value)))
+        glProgramUniformMatrix2fv(program->GetId(), loc, 1, 0, &value[0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniformMatrix3f(const SepProgramPtr& ppo, GLuint loc, const glm::mat3& value) const
+{
+    HAS_ACTIVE_PROGRAM(ppo);
+
+    const ProgramPtr& program = ppo->GetActiveProgram();
+    if (UniformChanged(program.get(), loc, GL_FLOAT_MAT3, &value, sizeof(value)))
+        glProgramUniformMatrix3fv(program->GetId(), loc, 1, 0, &value[0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniformMatrix4f(const SepProgramPtr& ppo, GLuint loc, const glm::mat4& value) const
+{
+    HAS_ACTIVE_PROGRAM(ppo);
+
+    const ProgramPtr& program = ppo->GetActiveProgram();
+    if (UniformChanged(program.get(), loc, GL_FLOAT_MAT4, &value, sizeof(value)))
+        glProgramUniformMatrix4fv(program->GetId(), loc, 1, 0, &value[0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniformMatrix2x3f(const SepProgramPtr& ppo, GLuint loc, const glm::mat2x3& value) const
+{
+    HAS_ACTIVE_PROGRAM(ppo);
+
+    const ProgramPtr& program = ppo->GetActiveProgram();
+    if (UniformChanged(program.get(), loc, GL_FLOAT_MAT2x3, &value, sizeof(value)))
+        glProgramUniformMatrix2x3fv(program->GetId(), loc, 1, 0, &value[0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniformMatrix3x2f(const SepProgramPtr& ppo, GLuint loc, const glm::mat3x2& value) const
+{
+    HAS_ACTIVE_PROGRAM(ppo);
+
+    const ProgramPtr& program = ppo->GetActiveProgram();
+    if (UniformChanged(program.get(), loc, GL_FLOAT_MAT3x2, &value, sizeof(value)))
+        glProgramUniformMatrix3x2fv(program->GetId(), loc, 1, 0, &value[0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniformMatrix2x4f(const SepProgramPtr& ppo, GLuint loc, const glm::mat2x4& value) const
+{
+    HAS_ACTIVE_PROGRAM(ppo);
+
+    const ProgramPtr& program = ppo->GetActiveProgram();
+    if (UniformChanged(program.get(), loc, GL_FLOAT_MAT2x4, &value, sizeof(value)))
+        glProgramUniformMatrix2x4fv(program->GetId(), loc, 1, 0, &value[0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniformMatrix4x2f(const SepProgramPtr& ppo, GLuint loc, const glm::mat4x2& value) const
+{
+    HAS_ACTIVE_PROGRAM(ppo);
+
+    const ProgramPtr& program = ppo->GetActiveProgram();
+    if (UniformChanged(program.get(), loc, GL_FLOAT_MAT4x2, &value, sizeof(value)))
+        glProgramUniformMatrix4x2fv(program->GetId(), loc, 1, 0, &value[0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniformMatrix3x4f(const SepProgramPtr& ppo, GLuint loc, const glm::mat3x4& value) const
+{
+    HAS_ACTIVE_PROGRAM(ppo);
+
+    const ProgramPtr& program = ppo->GetActiveProgram();
+    if (UniformChanged(program.get(), loc, GL_FLOAT_MAT3x4, &value, sizeof(value)))
+        glProgramUniformMatrix3x4fv(program->GetId(), loc, 1, 0, &value[0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniformMatrix4x3f(const SepProgramPtr& ppo, GLuint loc, const glm::mat4x3& value) const
+{
+    HAS_ACTIVE_PROGRAM(ppo);
+
+    const ProgramPtr& program = ppo->GetActiveProgram();
+    if (UniformChanged(program.get(), loc, GL_FLOAT_MAT4x3, &value, sizeof(value)))
+        glProgramUniformMatrix4x3fv(program->GetId(), loc, 1, 0, &value[0][0]);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniformMatrix2f(const SepProgramPtr& ppo, const std::string& name, const glm::mat2& value) const
+{
+    GLProgramUniformMatrix2f(ppo, GetUniformIdFromName(ppo, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniformMatrix3f(const SepProgramPtr& ppo, const std::string& name, const glm::mat3& value) const
+{
+    GLProgramUniformMatrix3f(ppo, GetUniformIdFromName(ppo, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniformMatrix4f(const SepProgramPtr& ppo, const std::string& name, const glm::mat4& value) const
+{
+    GLProgramUniformMatrix4f(ppo, GetUniformIdFromName(ppo, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniformMatrix2x3f(const SepProgramPtr& ppo, const std::string& name, const glm::mat2x3& value) const
+{
+    GLProgramUniformMatrix2x3f(ppo, GetUniformIdFromName(ppo, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniformMatrix3x2f(const SepProgramPtr& ppo, const std::string& name, const glm::mat3x2& value) const
+{
+    GLProgramUniformMatrix3x2f(ppo, GetUniformIdFromName(ppo, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniformMatrix2x4f(const SepProgramPtr& ppo, const std::string& name, const glm::mat2x4& value) const
+{
+    GLProgramUniformMatrix2x4f(ppo, GetUniformIdFromName(ppo, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniformMatrix4x2f(const SepProgramPtr& ppo, const std::string& name, const glm::mat4x2& value) const
+{
+    GLProgramUniformMatrix4x2f(ppo, GetUniformIdFromName(ppo, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniformMatrix3x4f(const SepProgramPtr& ppo, const std::string& name, const glm::mat3x4& value) const
+{
+    GLProgramUniformMatrix3x4f(ppo, GetUniformIdFromName(ppo, name), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniformMatrix4x3f(const SepProgramPtr& ppo, const std::string& name, const glm::mat4x3& value) const
+{
+    GLProgramUniformMatrix4x3f(ppo, GetUniformIdFromName(ppo, name), value);
+}
+
+/*
+
+handles
+
+*/
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform1f(const SepProgramPtr& ppo, UniformHandle handle, const GLfloat& value) const
+{
+    GLProgramUniform1f(ppo, static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform2f(const SepProgramPtr& ppo, UniformHandle handle, const glm::vec2& value) const
+{
+    GLProgramUniform2f(ppo, static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform3f(const SepProgramPtr& ppo, UniformHandle handle, const glm::vec3& value) const
+{
+    GLProgramUniform3f(ppo, static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform4f(const SepProgramPtr& ppo, UniformHandle handle, const glm::vec4& value) const
+{
+    GLProgramUniform4f(ppo, static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform1i(const SepProgramPtr& ppo, UniformHandle handle, const GLint& value) const
+{
+    GLProgramUniform1i(ppo, static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform2i(const SepProgramPtr& ppo, UniformHandle handle, const glm::i32vec2& value) const
+{
+    GLProgramUniform2i(ppo, static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform3i(const SepProgramPtr& ppo, UniformHandle handle, const glm::i32vec3& value) const
+{
+    GLProgramUniform3i(ppo, static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform4i(const SepProgramPtr& ppo, UniformHandle handle, const glm::i32vec4& value) const
+{
+    GLProgramUniform4i(ppo, static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform1ui(const SepProgramPtr& ppo, UniformHandle handle, const GLuint& value) const
+{
+    GLProgramUniform1ui(ppo, static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform2ui(const SepProgramPtr& ppo, UniformHandle handle, const glm::u32vec2& value) const
+{
+    GLProgramUniform2ui(ppo, static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform3ui(const SepProgramPtr& ppo, UniformHandle handle, const glm::u32vec3& value) const
+{
+    GLProgramUniform3ui(ppo, static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniform4ui(const SepProgramPtr& ppo, UniformHandle handle, const glm::u32vec4& value) const
+{
+    GLProgramUniform4ui(ppo, static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniformMatrix2f(const SepProgramPtr& ppo, UniformHandle handle, const glm::mat2& value) const
+{
+    GLProgramUniformMatrix2f(ppo, static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniformMatrix3f(const SepProgramPtr& ppo, UniformHandle handle, const glm::mat3& value) const
+{
+    GLProgramUniformMatrix3f(ppo, static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniformMatrix4f(const SepProgramPtr& ppo, UniformHandle handle, const glm::mat4& value) const
+{
+    GLProgramUniformMatrix4f(ppo, static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniformMatrix2x3f(const SepProgramPtr& ppo, UniformHandle handle, const glm::mat2x3& value) const
+{
+    GLProgramUniformMatrix2x3f(ppo, static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniformMatrix3x2f(const SepProgramPtr& ppo, UniformHandle handle, const glm::mat3x2& value) const
+{
+    GLProgramUniformMatrix3x2f(ppo, static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniformMatrix2x4f(const SepProgramPtr& ppo, UniformHandle handle, const glm::mat2x4& value) const
+{
+    GLProgramUniformMatrix2x4f(ppo, static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniformMatrix4x2f(const SepProgramPtr& ppo, UniformHandle handle, const glm::mat4x2& value) const
+{
+    GLProgramUniformMatrix4x2f(ppo, static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniformMatrix3x4f(const SepProgramPtr& ppo, UniformHandle handle, const glm::mat3x4& value) const
+{
+    GLProgramUniformMatrix3x4f(ppo, static_cast<GLuint>(handle.mLocation), value);
+}
+
+//--------------------------------------------------------------------------------------
+void ShaderManager::GLProgramUniformMatrix4x3f(const SepProgramPtr& ppo, UniformHandle handle, const glm::mat4x3& value) const
+{
+    GLProgramUniformMatrix4x3f(ppo, static_cast<GLuint>(handle.mLocation), value);
+}
+
+/*
+======================================================================================================================================================================================================
+
+Buffer and Texture (alpha)
+
+
+*/
+
+
+/*
+
+Texture Utilities:
+
+*/
+
+
+
+#define FOURCC_DXT1 0x31545844 // Equivalent to "DXT1" in ASCII
+#define FOURCC_DXT3 0x33545844 // Equivalent to "DXT3" in ASCII
+#define FOURCC_DXT5 0x35545844 // Equivalent to "DXT5" in ASCII
+
+namespace DDS
+{
+    const unsigned int g_HeaderSize = 128;//including the file code
+    const unsigned int g_DX10HeaderSize = 20;
+
+    //DDS_PIXELFORMAT flags
+    const unsigned int g_PFAlphaPixels = 0x1;
+    const unsigned int g_PFAlpha = 0x2;
+    const unsigned int g_PFFourCC = 0x4;
+    const unsigned int g_PFRGB = 0x40;
+    const unsigned int g_PFLuminance = 0x20000;
+
+    //DDS_HEADER flags and caps
+    const unsigned int g_FlagDepth = 0x800000;
+    const unsigned int g_Caps2Cubemap = 0x200;
+    const unsigned int g_Caps2AllFaces = 0xFC00;
+    const unsigned int g_Caps2Volume = 0x200000;
+
+    //DDS_HEADER_DXT10
+    const unsigned int g_DimensionTexture1D = 2;
+    const unsigned int g_DimensionTexture2D = 3;
+    const unsigned int g_MiscTextureCube = 0x4;
+
+    //--------------------------------------------------------------------------------------
+    constexpr unsigned int MakeFourCC(char a, char b, char c, char d)
+    {
+        return static_cast<unsigned int>(static_cast<unsigned char>(a)) | (static_cast<unsigned int>(static_cast<unsigned char>(b)) << 8) |
+            (static_cast<unsigned int>(static_cast<unsigned char>(c)) << 16) | (static_cast<unsigned int>(static_cast<unsigned char>(d)) << 24);
+    }
+
+    //--------------------------------------------------------------------------------------
+    //the header fields are not necessarily aligned within the data
+    unsigned int ReadU32(const MemorySpan& rawData, std::size_t offset)
+    {
+        unsigned int value;
+        std::memcpy(&value, rawData.data() + offset, sizeof(value));
+        return value;
+    }
+
+    //--------------------------------------------------------------------------------------
+    void SetCompressed(DDSImage& image, GLenum format)
+    {
+        image.mCompressedFormat = format;
+        image.mInternalFormat = format;
+        image.mFormat = 0;
+        image.mType = 0;
+    }
+
+    //--------------------------------------------------------------------------------------
+    void SetUncompressed(DDSImage& image, GLenum internalFormat, GLenum format, GLenum type)
+    {
+        image.mCompressedFormat = 0;
+        image.mInternalFormat = internalFormat;
+        image.mFormat = format;
+        image.mType = type;
+    }
+
+    //--------------------------------------------------------------------------------------
+    void SetSwizzle(DDSImage& image, GLint r, GLint g, GLint b, GLint a)
+    {
+        image.mSwizzle[0] = r;
+        image.mSwizzle[1] = g;
+        image.mSwizzle[2] = b;
+        image.mSwizzle[3] = a;
+    }
+
+    //--------------------------------------------------------------------------------------
+    //BC1 and BC4 use 8 bytes per 4x4 block, the rest use 16
+    unsigned int BlockSize(GLenum compressedFormat)
+    {
+        switch (compressedFormat)
+        {
+        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RED_RGTC1:
+        case GL_COMPRESSED_SIGNED_RED_RGTC1:
+            return 8;
+        default:
+            return 16;
+        }
+    }
+
+    //--------------------------------------------------------------------------------------
+    bool SetFormatFromDXGI(DDSImage& image, unsigned int dxgiFormat)
+    {
+        switch (dxgiFormat)
+        {
+        case 70: case 71: SetCompressed(image, GL_COMPRESSED_RGBA_S3TC_DXT1_EXT); break;//BC1
+        case 72: SetCompressed(image, GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT); break;
+        case 73: case 74: SetCompressed(image, GL_COMPRESSED_RGBA_S3TC_DXT3_EXT); break;//BC2
+        case 75: SetCompressed(image, GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT); break;
+        case 76: case 77: SetCompressed(image, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT); break;//BC3
+        case 78: SetCompressed(image, GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT); break;
+        case 79: case 80: SetCompressed(image, GL_COMPRESSED_RED_RGTC1); break;//BC4
+        case 81: SetCompressed(image, GL_COMPRESSED_SIGNED_RED_RGTC1); break;
+        case 82: case 83: SetCompressed(image, GL_COMPRESSED_RG_RGTC2); break;//BC5
+        case 84: SetCompressed(image, GL_COMPRESSED_SIGNED_RG_RGTC2); break;
+        case 94: case 95: SetCompressed(image, GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT_ARB); break;//BC6H
+        case 96: SetCompressed(image, GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT_ARB); break;
+        case 97: case 98: SetCompressed(image, GL_COMPRESSED_RGBA_BPTC_UNORM_ARB); break;//BC7
+        case 99: SetCompressed(image, GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM_ARB); break;
+
+        case 2: SetUncompressed(image, GL_RGBA32F, GL_RGBA, GL_FLOAT); break;
+        case 6: SetUncompressed(image, GL_RGB32F, GL_RGB, GL_FLOAT); break;
+        case 10: SetUncompressed(image, GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT); break;
+        case 11: SetUncompressed(image, GL_RGBA16, GL_RGBA, GL_UNSIGNED_SHORT); break;
+        case 16: SetUncompressed(image, GL_RG32F, GL_RG, GL_FLOAT); break;
+        case 24: SetUncompressed(image, GL_RGB10_A2, GL_RGBA, GL_UNSIGNED_INT_2_10_10_10_REV); break;
+        case 26: SetUncompressed(image, GL_R11F_G11F_B10F, GL_RGB, GL_UNSIGNED_INT_10F_11F_11F_REV); break;
+        case 27: case 28: SetUncompressed(image, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE); break;
+        case 29: SetUncompressed(image, GL_SRGB8_ALPHA8, GL_RGBA, GL_UNSIGNED_BYTE); break;
+        case 34: SetUncompressed(image, GL_RG16F, GL_RG, GL_HALF_FLOAT); break;
+        case 35: SetUncompressed(image, GL_RG16, GL_RG, GL_UNSIGNED_SHORT); break;
+        case 41: SetUncompressed(image, GL_R32F, GL_RED, GL_FLOAT); break;
+        case 49: SetUncompressed(image, GL_RG8, GL_RG, GL_UNSIGNED_BYTE); break;
+        case 54: SetUncompressed(image, GL_R16F, GL_RED, GL_HALF_FLOAT); break;
+        case 56: SetUncompressed(image, GL_R16, GL_RED, GL_UNSIGNED_SHORT); break;
+        case 61: SetUncompressed(image, GL_R8, GL_RED, GL_UNSIGNED_BYTE); break;
+        case 65://A8
+            SetUncompressed(image, GL_R8, GL_RED, GL_UNSIGNED_BYTE);
+            SetSwizzle(image, GL_ZERO, GL_ZERO, GL_ZERO, GL_RED);
+            break;
+        case 67: SetUncompressed(image, GL_RGB9_E5, GL_RGB, GL_UNSIGNED_INT_5_9_9_9_REV); break;
+        case 85: SetUncompressed(image, GL_RGB565, GL_RGB, GL_UNSIGNED_SHORT_5_6_5); break;
+        case 86: SetUncompressed(image, GL_RGB5_A1, GL_BGRA, GL_UNSIGNED_SHORT_1_5_5_5_REV); break;
+        case 87: case 90: SetUncompressed(image, GL_RGBA8, GL_BGRA, GL_UNSIGNED_BYTE); break;
+        case 88: case 92: SetUncompressed(image, GL_RGB8, GL_BGRA, GL_UNSIGNED_BYTE); break;
+        case 91: SetUncompressed(image, GL_SRGB8_ALPHA8, GL_BGRA, GL_UNSIGNED_BYTE); break;
+        case 93: SetUncompressed(image, GL_SRGB8, GL_BGRA, GL_UNSIGNED_BYTE); break;
+        default:
+            return false;
+        }
+        return true;
+    }
+
+    //--------------------------------------------------------------------------------------
+    bool SetFormatFromFourCC(DDSImage& image, unsigned int fourCC)
+    {
+        switch (fourCC)
+        {
+        case MakeFourCC('D', 'X', 'T', '1'): SetCompressed(image, GL_COMPRESSED_RGBA_S3TC_DXT1_EXT); break;
+        case MakeFourCC('D', 'X', 'T', '2'):
+        case MakeFourCC('D', 'X', 'T', '3'): SetCompressed(image, GL_COMPRESSED_RGBA_S3TC_DXT3_EXT); break;
+        case MakeFourCC('D', 'X', 'T', '4'):
+        case MakeFourCC('D', 'X', 'T', '5'): SetCompressed(image, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT); break;
+        case MakeFourCC('A', 'T', 'I', '1'):
+        case MakeFourCC('B', 'C', '4', 'U'): SetCompressed(image, GL_COMPRESSED_RED_RGTC1); break;
+        case MakeFourCC('B', 'C', '4', 'S'): SetCompressed(image, GL_COMPRESSED_SIGNED_RED_RGTC1); break;
+        case MakeFourCC('A', 'T', 'I', '2'):
+        case MakeFourCC('B', 'C', '5', 'U'): SetCompressed(image, GL_COMPRESSED_RG_RGTC2); break;
+        case MakeFourCC('B', 'C', '5', 'S'): SetCompressed(image, GL_COMPRESSED_SIGNED_RG_RGTC2); break;
+
+        //D3DFORMAT values stored in the fourCC field
+        case 36: SetUncompressed(image, GL_RGBA16, GL_RGBA, GL_UNSIGNED_SHORT); break;
+        case 111: SetUncompressed(image, GL_R16F, GL_RED, GL_HALF_FLOAT); break;
+        case 112: SetUncompressed(image, GL_RG16F, GL_RG, GL_HALF_FLOAT); break;
+        case 113: SetUncompressed(image, GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT); break;
+        case 114: SetUncompressed(image, GL_R32F, GL_RED, GL_FLOAT); break;
+        case 115: SetUncompressed(image, GL_RG32F, GL_RG, GL_FLOAT); break;
+        case 116: SetUncompressed(image, GL_RGBA32F, GL_RGBA, GL_FLOAT); break;
+        default:
+            return false;
+        }
+        return true;
+    }
+
+    //--------------------------------------------------------------------------------------
+    struct MaskFormat
+    {
+        unsigned int mBitCount;
+        unsigned int mMasks[4];//r, g, b, a
+        GLenum mInternalFormat;
+        GLenum mFormat;
+        GLenum mType;
+    };
+
+    //uncompressed layouts described with bit masks; the alpha mask only counts if DDPF_ALPHAPIXELS is set
+    const MaskFormat g_RGBFormats[] = 
+    {
+        { 32, { 0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000 }, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE },
+        { 32, { 0x000000ff, 0x0000ff00, 0x00ff0000, 0x00000000 }, GL_RGB8, GL_RGBA, GL_UNSIGNED_BYTE },
+        { 32, { 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000 }, GL_RGBA8, GL_BGRA, GL_UNSIGNED_BYTE },
+        { 32, { 0x00ff0000, 0x0000ff00, 0x000000ff, 0x00000000 }, GL_RGB8, GL_BGRA, GL_UNSIGNED_BYTE },
+        { 32, { 0x000003ff, 0x000ffc00, 0x3ff00000, 0xc0000000 }, GL_RGB10_A2, GL_RGBA, GL_UNSIGNED_INT_2_10_10_10_REV },
+        { 32, { 0x3ff00000, 0x000ffc00, 0x000003ff, 0xc0000000 }, GL_RGB10_A2, GL_BGRA, GL_UNSIGNED_INT_2_10_10_10_REV },
+        { 32, { 0x0000ffff, 0xffff0000, 0x00000000, 0x00000000 }, GL_RG16, GL_RG, GL_UNSIGNED_SHORT },
+        { 24, { 0x00ff0000, 0x0000ff00, 0x000000ff, 0x00000000 }, GL_RGB8, GL_BGR, GL_UNSIGNED_BYTE },
+        { 24, { 0x000000ff, 0x0000ff00, 0x00ff0000, 0x00000000 }, GL_RGB8, GL_RGB, GL_UNSIGNED_BYTE },
+        { 16, { 0x0000f800, 0x000007e0, 0x0000001f, 0x00000000 }, GL_RGB565, GL_RGB, GL_UNSIGNED_SHORT_5_6_5 },
+        { 16, { 0x00007c00, 0x000003e0, 0x0000001f, 0x00008000 }, GL_RGB5_A1, GL_BGRA, GL_UNSIGNED_SHORT_1_5_5_5_REV },
+        { 16, { 0x00007c00, 0x000003e0, 0x0000001f, 0x00000000 }, GL_RGB5, GL_BGRA, GL_UNSIGNED_SHORT_1_5_5_5_REV },
+        { 16, { 0x00000f00, 0x000000f0, 0x0000000f, 0x0000f000 }, GL_RGBA4, GL_BGRA, GL_UNSIGNED_SHORT_4_4_4_4_REV },
+        { 16, { 0x000000ff, 0x0000ff00, 0x00000000, 0x00000000 }, GL_RG8, GL_RG, GL_UNSIGNED_BYTE },
+        { 8,  { 0x000000ff, 0x00000000, 0x00000000, 0x00000000 }, GL_R8, GL_RED, GL_UNSIGNED_BYTE }
+    };
+
+    //--------------------------------------------------------------------------------------
+    bool SetFormatFromMasks(DDSImage& image, unsigned int flags, unsigned int bitCount, const unsigned int (&masks)[4])
+    {
+        unsigned int alphaMask = (flags & g_PFAlphaPixels) ? masks[3] : 0;
+
+        if (flags & g_PFRGB)
+        {
+            for (const auto& it : g_RGBFormats)
+            {
+                if (it.mBitCount == bitCount && it.mMasks[0] == masks[0] && it.mMasks[1] == masks[1] && it.mMasks[2] == masks[2] && it.mMasks[3] == alphaMask)
+                {
+                    SetUncompressed(image, it.mInternalFormat, it.mFormat, it.mType);
+                    return true;
+                }
+            }
+        }
+        else if (flags & g_PFLuminance)
+        {
+            if (bitCount == 8 && masks[0] == 0xff && alphaMask == 0)
+            {
+                SetUncompressed(image, GL_R8, GL_RED, GL_UNSIGNED_BYTE);
+                SetSwizzle(image, GL_RED, GL_RED, GL_RED, GL_ONE);
+                return true;
+            }
+            if (bitCount == 16 && masks[0] == 0xffff && alphaMask == 0)
+            {
+                SetUncompressed(image, GL_R16, GL_RED, GL_UNSIGNED_SHORT);
+                SetSwizzle(image, GL_RED, GL_RED, GL_RED, GL_ONE);
+                return true;
+            }
+            if (bitCount == 16 && masks[0] == 0xff && alphaMask == 0xff00)
+            {
+                SetUncompressed(image, GL_RG8, GL_RG, GL_UNSIGNED_BYTE);
+                SetSwizzle(image, GL_RED, GL_RED, GL_RED, GL_GREEN);
+                return true;
+            }
+        }
+        else if (flags & g_PFAlpha)
+        {
+            if (bitCount == 8 && masks[3] == 0xff)
+            {
+                SetUncompressed(image, GL_R8, GL_RED, GL_UNSIGNED_BYTE);
+                SetSwizzle(image, GL_ZERO, GL_ZERO, GL_ZERO, GL_RED);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    //--------------------------------------------------------------------------------------
+    std::size_t LevelSize(const DDSImage& image, unsigned int width, unsigned int height)
+    {
+        if (image.mCompressedFormat != 0)
+            return static_cast<std::size_t>((width + 3) / 4) * ((height + 3) / 4) * BlockSize(image.mCompressedFormat);
+
+        //DDS rows are tightly packed
+        return static_cast<std::size_t>(width) * height * GLCounting::PixelSize(image.mFormat, image.mType);
+    }
+
+    //--------------------------------------------------------------------------------------
+    bool HasTextureStorage()
+    {
+        return gGLVersion2Digit >= 42 || gExtensions.HasExtension("GL_ARB_texture_storage");
+    }
+
+    //--------------------------------------------------------------------------------------
+    bool HasCubeMapArray()
+    {
+        return gGLVersion2Digit >= 40 || gExtensions.HasExtension("GL_ARB_texture_cube_map_array");
+    }
+
+    //--------------------------------------------------------------------------------------
+    bool IsIdentitySwizzle(const DDSImage& image)
+    {
+        return image.mSwizzle[0] == GL_RED && image.mSwizzle[1] == GL_GREEN && image.mSwizzle[2] == GL_BLUE && image.mSwizzle[3] == GL_ALPHA;
+    }
+
+    //--------------------------------------------------------------------------------------
+    //creates the texture for 'image' and leaves it bound.  With texture storage every level is allocated here; without
+    //  it, only array levels are (or every level if 'allocateAll'), and the rest are defined as they are uploaded
+    GLuint CreateTexture(const DDSImage& image, bool allocateAll)
+    {
+        GLenum target = image.mTarget;
+        bool compressed = image.mCompressedFormat != 0;
+        bool layered = target == GL_TEXTURE_2D_ARRAY || target == GL_TEXTURE_CUBE_MAP_ARRAY;
+        bool immutable = HasTextureStorage();
+
+        // Create one OpenGL texture
+        GLuint textureID;
+        glGenTextures(1, &textureID);
+
+        //make sure OpenGL successfully created the texture before loading it
+        if (textureID == 0)
+            GLUF_CRITICAL_EXCEPTION(TextureCreationException());
+
+        // "Bind" the newly created texture : all future texture functions will modify this texture
+        GLSTATE.BindTexture(target, textureID);
+
+        //immutable textures are complete with exactly the levels they were allocated with, so only mutable ones need the range
+        if (!immutable)
+        {
+            glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, 0);
+            glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(image.mMipCount) - 1);//REMEMBER it is max mip, NOT mip count
+        }
+
+        //new textures already have the identity swizzle
+        if (!IsIdentitySwizzle(image))
+        {
+            glTexParameteri(target, GL_TEXTURE_SWIZZLE_R, image.mSwizzle[0]);
+            glTexParameteri(target, GL_TEXTURE_SWIZZLE_G, image.mSwizzle[1]);
+            glTexParameteri(target, GL_TEXTURE_SWIZZLE_B, image.mSwizzle[2]);
+            glTexParameteri(target, GL_TEXTURE_SWIZZLE_A, image.mSwizzle[3]);
+        }
+
+        //DDS rows are tightly packed
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+        GLsizei levels = static_cast<GLsizei>(image.mMipCount);
+        GLsizei layerFaces = static_cast<GLsizei>(image.mLayers * image.mFaces);
+        if (immutable)
+        {
+            //allocate every level of every face at once; the levels are then only filled in
+            if (layered)
+                glTexStorage3D(target, levels, image.mInternalFormat, image.mWidth, image.mHeight, layerFaces);
+            else
+                glTexStorage2D(target, levels, image.mInternalFormat, image.mWidth, image.mHeight);
+        }
+        else if (layered)
+        {
+            //each layer's whole mip chain is together in the file, so allocate every level before filling in the layers
+            for (unsigned int level = 0; level < image.mMipCount; ++level)
+            {
+                const DDSMipLevel& mip = image.mMipLevels[level];
+                if (compressed)
+                    glCompressedTexImage3D(target, level, image.mCompressedFormat, mip.mWidth, mip.mHeight, layerFaces, 0, static_cast<GLsizei>(mip.mSize * layerFaces), nullptr);
+                else
+                    glTexImage3D(target, level, image.mInternalFormat, mip.mWidth, mip.mHeight, layerFaces, 0, image.mFormat, image.mType, nullptr);
+            }
+        }
+        else if (allocateAll)
+        {
+            for (unsigned int face = 0; face < image.mFaces; ++face)
+            {
+                GLenum faceTarget = (target == GL_TEXTURE_CUBE_MAP) ? GL_TEXTURE_CUBE_MAP_POSITIVE_X + face : target;
+                for (unsigned int level = 0; level < image.mMipCount; ++level)
+                {
+                    const DDSMipLevel& mip = image.mMipLevels[face * image.mMipCount + level];
+                    if (compressed)
+                        glCompressedTexImage2D(faceTarget, level, image.mCompressedFormat, mip.mWidth, mip.mHeight, 0, static_cast<GLsizei>(mip.mSize), nullptr);
+                    else
+                        glTexImage2D(faceTarget, level, image.mInternalFormat, mip.mWidth, mip.mHeight, 0, image.mFormat, image.mType, nullptr);
+                }
+            }
+        }
+
+        return textureID;
+    }
+
+    //--------------------------------------------------------------------------------------
+    //uploads one level of the bound texture; 'data' may be an offset into the bound GL_PIXEL_UNPACK_BUFFER.  'subImage'
+    //  is true if the level was already allocated by 'CreateTexture' (array levels always are)
+    void UploadLevel(const DDSImage& image, const DDSMipLevel& mip, const void* data, bool subImage)
+    {
+        GLenum target = image.mTarget;
+        bool compressed = image.mCompressedFormat != 0;
+
+        if (target == GL_TEXTURE_2D_ARRAY || target == GL_TEXTURE_CUBE_MAP_ARRAY)
+        {
+            GLint layerFace = static_cast<GLint>(mip.mLayer * image.mFaces + mip.mFace);
+            if (compressed)
+                glCompressedTexSubImage3D(target, mip.mLevel, 0, 0, layerFace, mip.mWidth, mip.mHeight, 1, image.mCompressedFormat, static_cast<GLsizei>(mip.mSize), data);
+            else
+                glTexSubImage3D(target, mip.mLevel, 0, 0, layerFace, mip.mWidth, mip.mHeight, 1, image.mFormat, image.mType, data);
+            return;
+        }
+
+        //DDS faces are in the same order as OpenGL's
+        GLenum faceTarget = (target == GL_TEXTURE_CUBE_MAP) ? GL_TEXTURE_CUBE_MAP_POSITIVE_X + mip.mFace : target;
+        if (subImage)
+        {
+            if (compressed)
+                glCompressedTexSubImage2D(faceTarget, mip.mLevel, 0, 0, mip.mWidth, mip.mHeight, image.mCompressedFormat, static_cast<GLsizei>(mip.mSize), data);
+            else
+                glTexSubImage2D(faceTarget, mip.mLevel, 0, 0, mip.mWidth, mip.mHeight, image.mFormat, image.mType, data);
+        }
+        else
+        {
+            if (compressed)
+                glCompressedTexImage2D(faceTarget, mip.mLevel, image.mCompressedFormat, mip.mWidth, mip.mHeight, 0, static_cast<GLsizei>(mip.mSize), data);
+            else
+                glTexImage2D(faceTarget, mip.mLevel, image.mInternalFormat, mip.mWidth, mip.mHeight, 0, image.mFormat, image.mType, data);
+        }
+    }
+}
+
+/*
+
+Block Compression Decoding:
+
+*/
+
+namespace BCDecoding
+{
+    //rows of blocks are handed out to threads in runs of about this many blocks
+    const unsigned int g_BlocksPerTask = 4096;
+
+    //--------------------------------------------------------------------------------------
+    //every decoder writes a whole 4x4 block, row by row, into 'out'
+    using DecodeBlockFunc = void(*)(const unsigned char* block, unsigned char* out);
+
+    //--------------------------------------------------------------------------------------
+    struct BlockFormat
+    {
+        GLenum mCompressedFormat;
+        DecodeBlockFunc mDecode;
+        unsigned int mBlockSize;
+
+        //the decoded layout
+        unsigned int mPixelSize;
+        GLenum mInternalFormat;
+        GLenum mFormat;
+        GLenum mType;
+    };
+
+    /*
+
+    SIMD Kernels
+
+    */
+
+    //--------------------------------------------------------------------------------------
+    //'palette' is four RGBA8 colors, and 'indices' holds sixteen 2 bit indices, pixel 0 in the lowest bits
+    using ExpandColorsFunc = void(*)(const std::uint32_t (&palette)[4], std::uint32_t indices, std::uint32_t* out);
+
+    //--------------------------------------------------------------------------------------
+    void ExpandColorsScalar(const std::uint32_t (&palette)[4], std::uint32_t indices, std::uint32_t* out)
+    {
+        for (unsigned int i = 0; i < 16; ++i, indices >>= 2)
+            out[i] = palette[indices & 3];
+    }
+
+    //--------------------------------------------------------------------------------------
+    //BC7's interpolation of 16 RGBA8 pixels: every byte is ((64 - w) * e0 + w * e1 + 32) >> 6, where the endpoints 'e0' and
+    //  'e1' and the weights (0 to 64) are packed per pixel the same way as the pixels.  AVX2 measured no faster than
+    //  SSE2 here, so there is no AVX2 version
+    void LerpColorsScalar(const std::uint32_t* e0, const std::uint32_t* e1, const std::uint32_t* weights, std::uint32_t* out)
+    {
+        const unsigned char* first = reinterpret_cast<const unsigned char*>(e0);
+        const unsigned char* second = reinterpret_cast<const unsigned char*>(e1);
+        const unsigned char* weight = reinterpret_cast<const unsigned char*>(weights);
+        unsigned char* pixels = reinterpret_cast<unsigned char*>(out);
+        for (unsigned int i = 0; i < 64; ++i)
+            pixels[i] = static_cast<unsigned char>(((64 - weight[i]) * first[i] + weight[i] * second[i] + 32) >> 6);
+    }
+
+#ifdef GLUF_SSE2
+    //--------------------------------------------------------------------------------------
+    //SSE2 has no variable shuffle, so each pixel picks its color with two masked blends, one per index bit
+    void ExpandColorsSSE2(const std::uint32_t (&palette)[4], std::uint32_t indices, std::uint32_t* out)
+    {
+        const __m128i lowBits = _mm_setr_epi32(0x01, 0x04, 0x10, 0x40);
+        const __m128i highBits = _mm_setr_epi32(0x02, 0x08, 0x20, 0x80);
+        const __m128i color0 = _mm_set1_epi32(static_cast<int>(palette[0]));
+        const __m128i color2 = _mm_set1_epi32(static_cast<int>(palette[2]));
+        const __m128i color01 = _mm_xor_si128(color0, _mm_set1_epi32(static_cast<int>(palette[1])));
+        const __m128i color23 = _mm_xor_si128(color2, _mm_set1_epi32(static_cast<int>(palette[3])));
+
+        for (unsigned int row = 0; row < 4; ++row, indices >>= 8)
+        {
+            __m128i rowIndices = _mm_set1_epi32(static_cast<int>(indices & 0xff));
+            __m128i low = _mm_cmpeq_epi32(_mm_and_si128(rowIndices, lowBits), lowBits);
+            __m128i high = _mm_cmpeq_epi32(_mm_and_si128(rowIndices, highBits), highBits);
+
+            //a ^ ((a ^ b) & mask) picks b where the mask is set
+            __m128i first = _mm_xor_si128(color0, _mm_and_si128(color01, low));
+            __m128i second = _mm_xor_si128(color2, _mm_and_si128(color23, low));
+            __m128i pixels = _mm_xor_si128(first, _mm_and_si128(_mm_xor_si128(first, second), high));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + row * 4), pixels);
+        }
+    }
+
+    //--------------------------------------------------------------------------------------
+    //two rows at a time, looking the palette up with a cross lane permute
+    GLUF_TARGET_AVX2 void ExpandColorsAVX2(const std::uint32_t (&palette)[4], std::uint32_t indices, std::uint32_t* out)
+    {
+        const __m256i colors = _mm256_setr_epi32(static_cast<int>(palette[0]), static_cast<int>(palette[1]), static_cast<int>(palette[2]), static_cast<int>(palette[3]),
+            static_cast<int>(palette[0]), static_cast<int>(palette[1]), static_cast<int>(palette[2]), static_cast<int>(palette[3]));
+        const __m256i shifts = _mm256_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14);
+        const __m256i three = _mm256_set1_epi32(3);
+
+        __m256i top = _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32(static_cast<int>(indices & 0xffff)), shifts), three);
+        __m256i bottom = _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32(static_cast<int>(indices >> 16)), shifts), three);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_permutevar8x32_epi32(colors, top));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 8), _mm256_permutevar8x32_epi32(colors, bottom));
+    }
+
+    //--------------------------------------------------------------------------------------
+    //one 16 bit lane per channel; the sum is at most 255 * 64 + 32, so it cannot overflow
+    inline __m128i Lerp16(__m128i e0, __m128i e1, __m128i weights)
+    {
+        __m128i sum = _mm_add_epi16(_mm_mullo_epi16(e0, _mm_sub_epi16(_mm_set1_epi16(64), weights)), _mm_mullo_epi16(e1, weights));
+        return _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(32)), 6);
+    }
+
+    //--------------------------------------------------------------------------------------
+    void LerpColorsSSE2(const std::uint32_t* e0, const std::uint32_t* e1, const std::uint32_t* weights, std::uint32_t* out)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        for (unsigned int i = 0; i < 16; i += 4)
+        {
+            __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(e0 + i));
+            __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(e1 + i));
+            __m128i weight = _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i));
+
+            __m128i low = Lerp16(_mm_unpacklo_epi8(first, zero), _mm_unpacklo_epi8(second, zero), _mm_unpacklo_epi8(weight, zero));
+            __m128i high = Lerp16(_mm_unpackhi_epi8(first, zero), _mm_unpackhi_epi8(second, zero), _mm_unpackhi_epi8(weight, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(low, high));
+        }
+    }
+
+    //--------------------------------------------------------------------------------------
+    bool HasAVX2()
+    {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+
+        //the OS has to save the YMM registers too
+        __cpuid(info, 1);
+        if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6)
+            return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+#endif
+    }
+#endif
+
+    //--------------------------------------------------------------------------------------
+    ExpandColorsFunc SelectExpandColors()
+    {
+#ifdef GLUF_SSE2
+        return HasAVX2() ? ExpandColorsAVX2 : ExpandColorsSSE2;
+#else
+        return ExpandColorsScalar;
+#endif
+    }
+
+    const ExpandColorsFunc g_ExpandColors = SelectExpandColors();
+
+    /*
+
+    BC1-BC5
+
+    */
+
+    //--------------------------------------------------------------------------------------
+    inline std::uint32_t PackRGBA(unsigned int r, unsigned int g, unsigned int b, unsigned int a)
+    {
+        return r | (g << 8) | (b << 16) | (a << 24);
+    }
+
+    //--------------------------------------------------------------------------------------
+    //the color half of BC1-BC3; 'punchThrough' allows BC1's three color mode, where index 3 is transparent black
+    void DecodeColors(const unsigned char* block, bool punchThrough, bool transparent, unsigned char* out)
+    {
+        unsigned int c0 = block[0] | (block[1] << 8);
+        unsigned int c1 = block[2] | (block[3] << 8);
+
+        //565 to 888, copying the top bits into the bottom
+        unsigned int r0 = ((c0 >> 8) & 0xf8) | (c0 >> 13);
+        unsigned int g0 = ((c0 >> 3) & 0xfc) | ((c0 >> 9) & 0x3);
+        unsigned int b0 = ((c0 << 3) & 0xf8) | ((c0 >> 2) & 0x7);
+        unsigned int r1 = ((c1 >> 8) & 0xf8) | (c1 >> 13);
+        unsigned int g1 = ((c1 >> 3) & 0xfc) | ((c1 >> 9) & 0x3);
+        unsigned int b1 = ((c1 << 3) & 0xf8) | ((c1 >> 2) & 0x7);
+
+        std::uint32_t palette[4];
+        bool fourColors = c0 > c1 || !punchThrough;
+#ifdef GLUF_SSE2
+        //both ways of filling in the two middle colors at once, one channel per lane, then the one the endpoint order
+        //  asks for is kept.  Dividing by 3 is a multiply by 65536 / 3 rounded up, which is exact for sums this small
+        __m128i ends = _mm_setr_epi16(static_cast<short>(r0), static_cast<short>(g0), static_cast<short>(b0), 255,
+            static_cast<short>(r1), static_cast<short>(g1), static_cast<short>(b1), 255);
+        __m128i swapped = _mm_shuffle_epi32(ends, _MM_SHUFFLE(1, 0, 3, 2));
+        __m128i thirds = _mm_mulhi_epu16(_mm_add_epi16(_mm_add_epi16(ends, ends), swapped), _mm_set1_epi16(21846));
+
+        //the three color mode's last entry is black, or transparent black
+        __m128i halves = _mm_srli_epi16(_mm_add_epi16(ends, swapped), 1);
+        halves = _mm_or_si128(_mm_and_si128(halves, _mm_setr_epi16(-1, -1, -1, -1, 0, 0, 0, 0)),
+            transparent ? _mm_setzero_si128() : _mm_setr_epi16(0, 0, 0, 0, 0, 0, 0, 255));
+
+        __m128i select = _mm_set1_epi16(fourColors ? -1 : 0);
+        __m128i middle = _mm_or_si128(_mm_and_si128(select, thirds), _mm_andnot_si128(select, halves));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(palette), _mm_packus_epi16(ends, middle));
+#else
+        palette[0] = PackRGBA(r0, g0, b0, 255);
+        palette[1] = PackRGBA(r1, g1, b1, 255);
+        if (fourColors)
+        {
+            palette[2] = PackRGBA((2 * r0 + r1) / 3, (2 * g0 + g1) / 3, (2 * b0 + b1) / 3, 255);
+            palette[3] = PackRGBA((r0 + 2 * r1) / 3, (g0 + 2 * g1) / 3, (b0 + 2 * b1) / 3, 255);
+        }
+        else
+        {
+            palette[2] = PackRGBA((r0 + r1) / 2, (g0 + g1) / 2, (b0 + b1) / 2, 255);
+            palette[3] = transparent ? 0 : PackRGBA(0, 0, 0, 255);
+        }
+#endif
+
+        std::uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | (static_cast<std::uint32_t>(block[7]) << 24);
+        g_ExpandColors(palette, indices, reinterpret_cast<std::uint32_t*>(out));
+    }
+
+#ifdef GLUF_SSE2
+    //--------------------------------------------------------------------------------------
+    //divides each 16 bit lane by multiplying with 'reciprocal' (65536 / the divisor, rounded up) and keeping the top half,
+    //  which is exact only for the small sums BC4 interpolates; signed lanes round toward zero, like the scalar division
+    template<bool Signed>
+    inline __m128i DivideSmall(__m128i value, unsigned short reciprocal)
+    {
+        if (!Signed)
+            return _mm_mulhi_epu16(value, _mm_set1_epi16(static_cast<short>(reciprocal)));
+
+        __m128i sign = _mm_srai_epi16(value, 15);
+        __m128i magnitude = _mm_sub_epi16(_mm_xor_si128(value, sign), sign);
+        magnitude = _mm_mulhi_epu16(magnitude, _mm_set1_epi16(static_cast<short>(reciprocal)));
+        return _mm_sub_epi16(_mm_xor_si128(magnitude, sign), sign);
+    }
+#endif
+
+    //--------------------------------------------------------------------------------------
+    //one BC4 channel (also BC3's alpha and each half of BC5), written to every 'stride'th byte of 'out'
+    template<bool Signed>
+    void DecodeChannel(const unsigned char* block, unsigned char* out, unsigned int stride)
+    {
+        //-128 is read as -127, so both signed ranges are symmetric
+        int e0 = Signed ? std::max<int>(static_cast<signed char>(block[0]), -127) : block[0];
+        int e1 = Signed ? std::max<int>(static_cast<signed char>(block[1]), -127) : block[1];
+
+        //signed values are stored as their two's complement bytes
+        unsigned char palette[16];
+#ifdef GLUF_SSE2
+        //both palettes at once, one entry per lane, then the one the endpoint order asks for is kept
+        __m128i first = _mm_set1_epi16(static_cast<short>(e0));
+        __m128i second = _mm_set1_epi16(static_cast<short>(e1));
+        __m128i sevenths = _mm_add_epi16(_mm_mullo_epi16(first, _mm_setr_epi16(7, 0, 6, 5, 4, 3, 2, 1)), _mm_mullo_epi16(second, _mm_setr_epi16(0, 7, 1, 2, 3, 4, 5, 6)));
+        __m128i fifths = _mm_add_epi16(_mm_mullo_epi16(first, _mm_setr_epi16(5, 0, 4, 3, 2, 1, 0, 0)), _mm_mullo_epi16(second, _mm_setr_epi16(0, 5, 1, 2, 3, 4, 0, 0)));
+
+        //multiplies by 65536 / 7 and 65536 / 5 rounded up, which are exact for sums this small
+        sevenths = DivideSmall<Signed>(sevenths, 9363);
+        fifths = DivideSmall<Signed>(fifths, 13108);
+        fifths = _mm_or_si128(fifths, Signed ? _mm_setr_epi16(0, 0, 0, 0, 0, 0, -127, 127) : _mm_setr_epi16(0, 0, 0, 0, 0, 0, 0, 255));
+
+        __m128i select = _mm_set1_epi16(e0 > e1 ? -1 : 0);
+        __m128i entries = _mm_or_si128(_mm_and_si128(select, sevenths), _mm_andnot_si128(select, fifths));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(palette), Signed ? _mm_packs_epi16(entries, entries) : _mm_packus_epi16(entries, entries));
+#else
+        int entries[8] = { e0, e1 };
+        if (e0 > e1)
+        {
+            for (int i = 1; i < 7; ++i)
+                entries[i + 1] = ((7 - i) * e0 + i * e1) / 7;
+        }
+        else
+        {
+            for (int i = 1; i < 5; ++i)
+                entries[i + 1] = ((5 - i) * e0 + i * e1) / 5;
+            entries[6] = Signed ? -127 : 0;
+            entries[7] = Signed ? 127 : 255;
+        }
+
+        for (unsigned int i = 0; i < 8; ++i)
+            palette[i] = static_cast<unsigned char>(entries[i]);
+#endif
+
+        std::uint64_t indices = 0;
+        for (unsigned int i = 0; i < 6; ++i)
+            indices |= static_cast<std::uint64_t>(block[2 + i]) << (8 * i);
+
+        for (unsigned int i = 0; i < 16; ++i, indices >>= 3)
+            out[i * stride] = palette[indices & 7];
+    }
+
+    //--------------------------------------------------------------------------------------
+    void DecodeBC1(const unsigned char* block, unsigned char* out)
+    {
+        DecodeColors(block, true, true, out);
+    }
+
+    //--------------------------------------------------------------------------------------
+    void DecodeBC1Opaque(const unsigned char* block, unsigned char* out)
+    {
+        DecodeColors(block, true, false, out);
+    }
+
+    //--------------------------------------------------------------------------------------
+    void DecodeBC2(const unsigned char* block, unsigned char* out)
+    {
+        DecodeColors(block + 8, false, false, out);
+
+        //4 bit alpha, stretched to 8
+        for (unsigned int i = 0; i < 16; ++i)
+            out[i * 4 + 3] = static_cast<unsigned char>(((block[i / 2] >> ((i & 1) * 4)) & 0xf) * 17);
+    }
+
+    //--------------------------------------------------------------------------------------
+    void DecodeBC3(const unsigned char* block, unsigned char* out)
+    {
+        DecodeColors(block + 8, false, false, out);
+        DecodeChannel<false>(block, out + 3, 4);
+    }
+
+    //--------------------------------------------------------------------------------------
+    template<bool Signed>
+    void DecodeBC4(const unsigned char* block, unsigned char* out)
+    {
+        DecodeChannel<Signed>(block, out, 1);
+    }
+
+    //--------------------------------------------------------------------------------------
+    template<bool Signed>
+    void DecodeBC5(const unsigned char* block, unsigned char* out)
+    {
+        DecodeChannel<Signed>(block, out, 2);
+        DecodeChannel<Signed>(block + 8, out + 1, 2);
+    }
+
+    /*
+
+    BC6H and BC7
+
+    */
+
+    //--------------------------------------------------------------------------------------
+    //reads the fields of a 128 bit block, least significant bit first, by shifting them out of the bottom
+    class BitReader
+    {
+        std::uint64_t mLow;
+        std::uint64_t mHigh;
+
+    public:
+        explicit BitReader(const unsigned char* block)
+        {
+            std::memcpy(&mLow, block, sizeof(mLow));
+            std::memcpy(&mHigh, block + 8, sizeof(mHigh));
+        }
+
+        //up to 63 bits, which is enough for every index set; splitting the high shift keeps 'count' 0 defined
+        std::uint64_t ReadWide(unsigned int count)
+        {
+            std::uint64_t value = mLow & ((1ull << count) - 1);
+            mLow = (mLow >> count) | ((mHigh << (63 - count)) << 1);
+            mHigh >>= count;
+            return value;
+        }
+
+        //every field but the index sets is 16 bits or less
+        unsigned int Read(unsigned int count)
+        {
+            return static_cast<unsigned int>(ReadWide(count));
+        }
+    };
+
+    //--------------------------------------------------------------------------------------
+    //reads a set of 16 indices at once, and puts back the top bit the anchor pixels leave out, which is always 0.
+    //  'anchors' has to be ascending; pixel 'i' ends up in bits ['i' * 'indexBits', ('i' + 1) * 'indexBits')
+    std::uint64_t ReadIndices(BitReader& bits, unsigned int indexBits, const unsigned int* anchors, unsigned int anchorCount)
+    {
+        std::uint64_t indices = bits.ReadWide(16 * indexBits - anchorCount);
+        for (unsigned int i = 0; i < anchorCount; ++i)
+        {
+            unsigned int topBit = anchors[i] * indexBits + indexBits - 1;
+            indices = (indices & ((1ull << topBit) - 1)) | (((indices >> topBit) << 1) << topBit);
+        }
+        return indices;
+    }
+
+    //interpolation weights for 2, 3, and 4 bit indices, out of 64
+    const int g_Weights2[4] = { 0, 21, 43, 64 };
+    const int g_Weights3[8] = { 0, 9, 18, 27, 37, 46, 55, 64 };
+    const int g_Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    //--------------------------------------------------------------------------------------
+    inline const int* Weights(unsigned int indexBits)
+    {
+        return indexBits == 2 ? g_Weights2 : (indexBits == 3 ? g_Weights3 : g_Weights4);
+    }
+
+    //--------------------------------------------------------------------------------------
+    inline int Interpolate(int e0, int e1, int weight)
+    {
+        return ((64 - weight) * e0 + weight * e1 + 32) >> 6;
+    }
+
+    //which subset each pixel belongs to, for the 64 two and three subset partitions
+    const unsigned char g_Partitions2[64][16] =
+    {
+        { 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1 }, { 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1 },
+        { 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1 }, { 0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 1, 1, 1 },
+        { 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 1, 1 }, { 0, 0, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 1, 1, 1, 1 },
+        { 0, 0, 0, 1, 0, 0, 1, 1, 0, 1, 1, 1, 1, 1, 1, 1 }, { 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 1, 0, 1, 1, 1 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 1 }, { 0, 0, 1, 1, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 },
+        { 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 1, 1, 1, 1, 1, 1 }, { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 1, 1 },
+        { 0, 0, 0, 1, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 }, { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1 },
+        { 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 }, { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1 },
+        { 0, 0, 0, 0, 1, 0, 0, 0, 1, 1, 1, 0, 1, 1, 1, 1 }, { 0, 1, 1, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 1, 1, 0 }, { 0, 1, 1, 1, 0, 0, 1, 1, 0, 0, 0, 1, 0, 0, 0, 0 },
+        { 0, 0, 1, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 1, 0, 0, 0, 1, 1, 0, 0, 1, 1, 1, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 1, 0, 0 }, { 0, 1, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 0, 1 },
+        { 0, 0, 1, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0 }, { 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 1, 0, 0 },
+        { 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0 }, { 0, 0, 1, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1, 1, 0, 0 },
+        { 0, 0, 0, 1, 0, 1, 1, 1, 1, 1, 1, 0, 1, 0, 0, 0 }, { 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0 },
+        { 0, 1, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 1, 0 }, { 0, 0, 1, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 1, 0, 0 },
+        { 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1 }, { 0, 0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1 },
+        { 0, 1, 0, 1, 1, 0, 1, 0, 0, 1, 0, 1, 1, 0, 1, 0 }, { 0, 0, 1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1, 0, 0 },
+        { 0, 0, 1, 1, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1, 0, 0 }, { 0, 1, 0, 1, 0, 1, 0, 1, 1, 0, 1, 0, 1, 0, 1, 0 },
+        { 0, 1, 1, 0, 1, 0, 0, 1, 0, 1, 1, 0, 1, 0, 0, 1 }, { 0, 1, 0, 1, 1, 0, 1, 0, 1, 0, 1, 0, 0, 1, 0, 1 },
+        { 0, 1, 1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1, 1, 0 }, { 0, 0, 0, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 0, 0, 0 },
+        { 0, 0, 1, 1, 0, 0, 1, 0, 0, 1, 0, 0, 1, 1, 0, 0 }, { 0, 0, 1, 1, 1, 0, 1, 1, 1, 1, 0, 1, 1, 1, 0, 0 },
+        { 0, 1, 1, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0, 1, 1, 0 }, { 0, 0, 1, 1, 1, 1, 0, 0, 1, 1, 0, 0, 0, 0, 1, 1 },
+        { 0, 1, 1, 0, 0, 1, 1, 0, 1, 0, 0, 1, 1, 0, 0, 1 }, { 0, 0, 0, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 0, 0, 0 },
+        { 0, 1, 0, 0, 1, 1, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0 }, { 0, 0, 1, 0, 0, 1, 1, 1, 0, 0, 1, 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 1, 1, 0, 0, 1, 0 }, { 0, 0, 0, 0, 0, 1, 0, 0, 1, 1, 1, 0, 0, 1, 0, 0 },
+        { 0, 1, 1, 0, 1, 1, 0, 0, 1, 0, 0, 1, 0, 0, 1, 1 }, { 0, 0, 1, 1, 0, 1, 1, 0, 1, 1, 0, 0, 1, 0, 0, 1 },
+        { 0, 1, 1, 0, 0, 0, 1, 1, 1, 0, 0, 1, 1, 1, 0, 0 }, { 0, 0, 1, 1, 1, 0, 0, 1, 1, 1, 0, 0, 0, 1, 1, 0 },
+        { 0, 1, 1, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 0, 0, 1 }, { 0, 1, 1, 0, 0, 0, 1, 1, 0, 0, 1, 1, 1, 0, 0, 1 },
+        { 0, 1, 1, 1, 1, 1, 1, 0, 1, 0, 0, 0, 0, 0, 0, 1 }, { 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 1, 0, 0, 1, 1, 1 },
+        { 0, 0, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1 }, { 0, 0, 1, 1, 0, 0, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0 },
+        { 0, 0, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0 }, { 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 1, 1, 0, 1, 1, 1 }
+    };
+
+    const unsigned char g_Partitions3[64][16] =
+    {
+        { 0, 0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 1, 2, 2, 2, 2 }, { 0, 0, 0, 1, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 2, 1 },
+        { 0, 0, 0, 0, 2, 0, 0, 1, 2, 2, 1, 1, 2, 2, 1, 1 }, { 0, 2, 2, 2, 0, 0, 2, 2, 0, 0, 1, 1, 0, 1, 1, 1 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2 }, { 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 2, 2, 0, 0, 2, 2 },
+        { 0, 0, 2, 2, 0, 0, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1 }, { 0, 0, 1, 1, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2 }, { 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2 },
+        { 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2 }, { 0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2 },
+        { 0, 1, 1, 2, 0, 1, 1, 2, 0, 1, 1, 2, 0, 1, 1, 2 }, { 0, 1, 2, 2, 0, 1, 2, 2, 0, 1, 2, 2, 0, 1, 2, 2 },
+        { 0, 0, 1, 1, 0, 1, 1, 2, 1, 1, 2, 2, 1, 2, 2, 2 }, { 0, 0, 1, 1, 2, 0, 0, 1, 2, 2, 0, 0, 2, 2, 2, 0 },
+        { 0, 0, 0, 1, 0, 0, 1, 1, 0, 1, 1, 2, 1, 1, 2, 2 }, { 0, 1, 1, 1, 0, 0, 1, 1, 2, 0, 0, 1, 2, 2, 0, 0 },
+        { 0, 0, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1, 2, 2 }, { 0, 0, 2, 2, 0, 0, 2, 2, 0, 0, 2, 2, 1, 1, 1, 1 },
+        { 0, 1, 1, 1, 0, 1, 1, 1, 0, 2, 2, 2, 0, 2, 2, 2 }, { 0, 0, 0, 1, 0, 0, 0, 1, 2, 2, 2, 1, 2, 2, 2, 1 },
+        { 0, 0, 0, 0, 0, 0, 1, 1, 0, 1, 2, 2, 0, 1, 2, 2 }, { 0, 0, 0, 0, 1, 1, 0, 0, 2, 2, 1, 0, 2, 2, 1, 0 },
+        { 0, 1, 2, 2, 0, 1, 2, 2, 0, 0, 1, 1, 0, 0, 0, 0 }, { 0, 0, 1, 2, 0, 0, 1, 2, 1, 1, 2, 2, 2, 2, 2, 2 },
+        { 0, 1, 1, 0, 1, 2, 2, 1, 1, 2, 2, 1, 0, 1, 1, 0 }, { 0, 0, 0, 0, 0, 1, 1, 0, 1, 2, 2, 1, 1, 2, 2, 1 },
+        { 0, 0, 2, 2, 1, 1, 0, 2, 1, 1, 0, 2, 0, 0, 2, 2 }, { 0, 1, 1, 0, 0, 1, 1, 0, 2, 0, 0, 2, 2, 2, 2, 2 },
+        { 0, 0, 1, 1, 0, 1, 2, 2, 0, 1, 2, 2, 0, 0, 1, 1 }, { 0, 0, 0, 0, 2, 0, 0, 0, 2, 2, 1, 1, 2, 2, 2, 1 },
+        { 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 2, 2, 2 }, { 0, 2, 2, 2, 0, 0, 2, 2, 0, 0, 1, 2, 0, 0, 1, 1 },
+        { 0, 0, 1, 1, 0, 0, 1, 2, 0, 0, 2, 2, 0, 2, 2, 2 }, { 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0 },
+        { 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 0, 0, 0, 0 }, { 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0 },
+        { 0, 1, 2, 0, 2, 0, 1, 2, 1, 2, 0, 1, 0, 1, 2, 0 }, { 0, 0, 1, 1, 2, 2, 0, 0, 1, 1, 2, 2, 0, 0, 1, 1 },
+        { 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 0, 0, 0, 0, 1, 1 }, { 0, 1, 0, 1, 0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2 },
+        { 0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 2, 1, 2, 1, 2, 1 }, { 0, 0, 2, 2, 1, 1, 2, 2, 0, 0, 2, 2, 1, 1, 2, 2 },
+        { 0, 0, 2, 2, 0, 0, 1, 1, 0, 0, 2, 2, 0, 0, 1, 1 }, { 0, 2, 2, 0, 1, 2, 2, 1, 0, 2, 2, 0, 1, 2, 2, 1 },
+        { 0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2, 0, 1, 0, 1 }, { 0, 0, 0, 0, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1 },
+        { 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 2, 2, 2, 2 }, { 0, 2, 2, 2, 0, 1, 1, 1, 0, 2, 2, 2, 0, 1, 1, 1 },
+        { 0, 0, 0, 2, 1, 1, 1, 2, 0, 0, 0, 2, 1, 1, 1, 2 }, { 0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1, 2 },
+        { 0, 2, 2, 2, 0, 1, 1, 1, 0, 1, 1, 1, 0, 2, 2, 2 }, { 0, 0, 0, 2, 1, 1, 1, 2, 1, 1, 1, 2, 0, 0, 0, 2 },
+        { 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 2, 2 }, { 0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 1, 2 },
+        { 0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 2, 2, 2, 2, 2, 2 }, { 0, 0, 2, 2, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 2, 2 },
+        { 0, 0, 2, 2, 1, 1, 2, 2, 1, 1, 2, 2, 0, 0, 2, 2 }, { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2 },
+        { 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1 }, { 0, 2, 2, 2, 1, 2, 2, 2, 0, 2, 2, 2, 1, 2, 2, 2 },
+        { 0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2 }, { 0, 1, 1, 1, 2, 0, 1, 1, 2, 2, 0, 1, 2, 2, 2, 0 }
+    };
+
+    //the pixel of each subset whose index is stored with one bit less; subset 0's is always pixel 0
+    const unsigned char g_Anchors2[64] =
+    {
+        15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+        15,  2,  8,  2,  2,  8,  8, 15,  2,  8,  2,  2,  8,  8,  2,  2,
+        15, 15,  6,  8,  2,  8, 15, 15,  2,  8,  2,  2,  2, 15, 15,  6,
+         6,  2,  6,  8, 15, 15,  2,  2, 15, 15, 15, 15, 15,  2,  2, 15
+    };
+
+    const unsigned char g_Anchors3Second[64] =
+    {
+         3,  3, 15, 15,  8,  3, 15, 15,  8,  8,  6,  6,  6,  5,  3,  3,
+         3,  3,  8, 15,  3,  3,  6, 10,  5,  8,  8,  6,  8,  5, 15, 15,
+         8, 15,  3,  5,  6, 10,  8, 15, 15,  3, 15,  5, 15, 15, 15, 15,
+         3, 15,  5,  5,  5,  8,  5, 10,  5, 10,  8, 13, 15, 12,  3,  3
+    };
+
+    const unsigned char g_Anchors3Third[64] =
+    {
+        15,  8,  8,  3, 15, 15,  3,  8, 15, 15, 15, 15, 15, 15, 15,  8,
+        15,  8, 15,  3, 15,  8, 15,  8,  3, 15,  6, 10, 15, 15, 10,  8,
+        15,  3, 15, 10, 10,  8,  9, 10,  6, 15,  8, 15,  3,  6,  6,  8,
+        15,  3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  3, 15, 15,  8
+    };
+
+    //--------------------------------------------------------------------------------------
+    inline unsigned int AnchorIndex(unsigned int subsets, unsigned int partition, unsigned int subset)
+    {
+        if (subset == 0)
+            return 0;
+        if (subsets == 2)
+            return g_Anchors2[partition];
+        return subset == 1 ? g_Anchors3Second[partition] : g_Anchors3Third[partition];
+    }
+
+    //--------------------------------------------------------------------------------------
+    struct BC7Mode
+    {
+        unsigned int mSubsets;
+        unsigned int mPartitionBits;
+        unsigned int mRotationBits;
+        unsigned int mIndexSelectionBits;
+        unsigned int mColorBits;
+        unsigned int mAlphaBits;
+        unsigned int mEndpointPBits;
+        unsigned int mSharedPBits;
+        unsigned int mIndexBits;
+        unsigned int mIndexBits2;
+    };
+
+    const BC7Mode g_BC7Modes[8] =
+    {
+        { 3, 4, 0, 0, 4, 0, 1, 0, 3, 0 },
+        { 2, 6, 0, 0, 6, 0, 0, 1, 3, 0 },
+        { 3, 6, 0, 0, 5, 0, 0, 0, 2, 0 },
+        { 2, 6, 0, 0, 7, 0, 1, 0, 2, 0 },
+        { 1, 0, 2, 1, 5, 6, 0, 0, 2, 3 },
+        { 1, 0, 2, 0, 7, 8, 0, 0, 2, 2 },
+        { 1, 0, 0, 0, 7, 7, 1, 0, 4, 0 },
+        { 2, 6, 0, 0, 5, 5, 1, 0, 2, 0 }
+    };
+
+    //--------------------------------------------------------------------------------------
+    //widens an endpoint to 8 bits, copying the top bits into the bottom
+    inline int Unquantize7(unsigned int value, unsigned int bits)
+    {
+        value <<= 8 - bits;
+        return static_cast<int>(value | (value >> bits));
+    }
+
+    //--------------------------------------------------------------------------------------
+    //swaps the alpha byte of a packed color with byte 'rotation' - 1, like BC7's rotation does
+    inline std::uint32_t Rotate(std::uint32_t color, unsigned int rotation)
+    {
+        if (rotation == 0)
+            return color;
+
+        unsigned int shift = (rotation - 1) * 8;
+        std::uint32_t alpha = color >> 24;
+        std::uint32_t other = (color >> shift) & 0xff;
+        return (color & ~(0xff000000u | (0xffu << shift))) | (other << 24) | (alpha << shift);
+    }
+
+    //--------------------------------------------------------------------------------------
+    void DecodeBC7(const unsigned char* block, unsigned char* out)
+    {
+        //reserved; decodes to transparent black
+        if (block[0] == 0)
+        {
+            std::memset(out, 0, 64);
+            return;
+        }
+
+        //the mode is the position of the lowest set bit
+        unsigned int mode = 0;
+        while ((block[0] & (1u << mode)) == 0)
+            ++mode;
+
+        BitReader bits(block);
+        bits.Read(mode + 1);
+
+        const BC7Mode& info = g_BC7Modes[mode];
+        unsigned int partition = bits.Read(info.mPartitionBits);
+        unsigned int rotation = bits.Read(info.mRotationBits);
+        unsigned int indexSelection = bits.Read(info.mIndexSelectionBits);
+
+        //every red, then every green, blue, and alpha
+        unsigned int endpointCount = info.mSubsets * 2;
+        unsigned int endpoints[6][4];
+        for (unsigned int channel = 0; channel < 3; ++channel)
+        {
+            for (unsigned int e = 0; e < endpointCount; ++e)
+                endpoints[e][channel] = bits.Read(info.mColorBits);
+        }
+        for (unsigned int e = 0; e < endpointCount; ++e)
+            endpoints[e][3] = bits.Read(info.mAlphaBits);
+
+        //p-bits are an extra least significant bit, either one per endpoint or shared by both of a subset's
+        unsigned int colorBits = info.mColorBits;
+        unsigned int alphaBits = info.mAlphaBits;
+        if (info.mEndpointPBits || info.mSharedPBits)
+        {
+            unsigned int pBits[6];
+            for (unsigned int e = 0; e < endpointCount; ++e)
+                pBits[e] = (info.mSharedPBits && (e & 1)) ? pBits[e - 1] : bits.Read(1);
+
+            for (unsigned int e = 0; e < endpointCount; ++e)
+            {
+                for (unsigned int channel = 0; channel < 4; ++channel)
+                    endpoints[e][channel] = (endpoints[e][channel] << 1) | pBits[e];
+            }
+            ++colorBits;
+            if (alphaBits)
+                ++alphaBits;
+        }
+
+        //the rotation swaps alpha with one of the colors after interpolating, which is the same as swapping them in the
+        //  endpoints and the weights before
+        std::uint32_t colors[6];
+        for (unsigned int e = 0; e < endpointCount; ++e)
+        {
+            unsigned int alpha = alphaBits ? Unquantize7(endpoints[e][3], alphaBits) : 255;
+            colors[e] = Rotate(PackRGBA(Unquantize7(endpoints[e][0], colorBits), Unquantize7(endpoints[e][1], colorBits),
+                Unquantize7(endpoints[e][2], colorBits), alpha), rotation);
+        }
+        std::uint32_t colorMask = Rotate(0x00010101, rotation);
+        std::uint32_t alphaMask = Rotate(0x01000000, rotation);
+
+        //the anchor pixels' indices leave out their top bit, which is always 0; the second index set only has pixel 0
+        const unsigned char* partitions = info.mSubsets == 3 ? g_Partitions3[partition] : g_Partitions2[partition];
+        unsigned int anchors[3] = { 0, 0, 0 };
+        if (info.mSubsets == 2)
+        {
+            anchors[1] = g_Anchors2[partition];
+        }
+        else if (info.mSubsets == 3)
+        {
+            anchors[1] = std::min(g_Anchors3Second[partition], g_Anchors3Third[partition]);
+            anchors[2] = std::max(g_Anchors3Second[partition], g_Anchors3Third[partition]);
+        }
+        std::uint64_t indices = ReadIndices(bits, info.mIndexBits, anchors, info.mSubsets);
+        std::uint64_t indices2 = info.mIndexBits2 ? ReadIndices(bits, info.mIndexBits2, anchors, 1) : indices;
+
+        //with two index sets, the color uses the first and the alpha the second, unless the index selection bit swaps them
+        unsigned int secondIndexBits = info.mIndexBits2 ? info.mIndexBits2 : info.mIndexBits;
+        std::uint64_t colorIndices = indexSelection ? indices2 : indices;
+        std::uint64_t alphaIndices = indexSelection ? indices : indices2;
+        unsigned int colorIndexBits = indexSelection ? secondIndexBits : info.mIndexBits;
+        unsigned int alphaIndexBits = indexSelection ? info.mIndexBits : secondIndexBits;
+
+        const int* colorWeights = Weights(colorIndexBits);
+        const int* alphaWeights = Weights(alphaIndexBits);
+        std::uint64_t colorIndexMask = (1u << colorIndexBits) - 1;
+        std::uint64_t alphaIndexMask = (1u << alphaIndexBits) - 1;
+
+        std::uint32_t e0[16];
+        std::uint32_t e1[16];
+        std::uint32_t weights[16];
+        for (unsigned int i = 0; i < 16; ++i)
+        {
+            unsigned int subset = info.mSubsets == 1 ? 0 : partitions[i];
+            e0[i] = colors[subset * 2];
+            e1[i] = colors[subset * 2 + 1];
+
+            unsigned int colorWeight = colorWeights[(colorIndices >> (i * colorIndexBits)) & colorIndexMask];
+            unsigned int alphaWeight = alphaWeights[(alphaIndices >> (i * alphaIndexBits)) & alphaIndexMask];
+            weights[i] = colorWeight * colorMask + alphaWeight * alphaMask;
+        }
+
+#ifdef GLUF_SSE2
+        LerpColorsSSE2(e0, e1, weights, reinterpret_cast<std::uint32_t*>(out));
+#else
+        LerpColorsScalar(e0, e1, weights, reinterpret_cast<std::uint32_t*>(out));
+#endif
+    }
+
+    //BC6H endpoint fields: 'w' and 'x' are the first subset's endpoints, 'y' and 'z' the second's
+    enum BC6HField : unsigned char { RW, GW, BW, RX, GX, BX, RY, GY, BY, RZ, GZ, BZ };
+
+    //--------------------------------------------------------------------------------------
+    //bits 'mFrom' through 'mTo' of a field, as the format lists them: bits are stored starting from 'mTo', so the
+    //  few fields listed with 'mFrom' < 'mTo' are stored in reverse
+    struct BC6HBits
+    {
+        BC6HField mField;
+        unsigned char mFrom;
+        unsigned char mTo;
+    };
+
+    //--------------------------------------------------------------------------------------
+    struct BC6HMode
+    {
+        bool mTransformed;//'x', 'y', and 'z' are stored as deltas from 'w'
+        unsigned int mEndpointBits;
+        unsigned int mDeltaBits[3];
+        std::vector<BC6HBits> mLayout;
+    };
+
+    //in the order of the mode numbers in the format description; 'mLayout' starts after the mode bits
+    const BC6HMode g_BC6HModes[14] =
+    {
+        { true, 10, { 5, 5, 5 }, { { GY, 4, 4 }, { BY, 4, 4 }, { BZ, 4, 4 }, { RW, 9, 0 }, { GW, 9, 0 }, { BW, 9, 0 }, { RX, 4, 0 }, { GZ, 4, 4 },
+            { GY, 3, 0 }, { GX, 4, 0 }, { BZ, 0, 0 }, { GZ, 3, 0 }, { BX, 4, 0 }, { BZ, 1, 1 }, { BY, 3, 0 }, { RY, 4, 0 }, { BZ, 2, 2 }, { RZ, 4, 0 },
+            { BZ, 3, 3 } } },
+        { true, 7, { 6, 6, 6 }, { { GY, 5, 5 }, { GZ, 4, 4 }, { GZ, 5, 5 }, { RW, 6, 0 }, { BZ, 0, 0 }, { BZ, 1, 1 }, { BY, 4, 4 }, { GW, 6, 0 },
+            { BY, 5, 5 }, { BZ, 2, 2 }, { GY, 4, 4 }, { BW, 6, 0 }, { BZ, 3, 3 }, { BZ, 5, 5 }, { BZ, 4, 4 }, { RX, 5, 0 }, { GY, 3, 0 }, { GX, 5, 0 },
+            { GZ, 3, 0 }, { BX, 5, 0 }, { BY, 3, 0 }, { RY, 5, 0 }, { RZ, 5, 0 } } },
+        { true, 11, { 5, 4, 4 }, { { RW, 9, 0 }, { GW, 9, 0 }, { BW, 9, 0 }, { RX, 4, 0 }, { RW, 10, 10 }, { GY, 3, 0 }, { GX, 3, 0 }, { GW, 10, 10 },
+            { BZ, 0, 0 }, { GZ, 3, 0 }, { BX, 3, 0 }, { BW, 10, 10 }, { BZ, 1, 1 }, { BY, 3, 0 }, { RY, 4, 0 }, { BZ, 2, 2 }, { RZ, 4, 0 }, { BZ, 3, 3 } } },
+        { true, 11, { 4, 5, 4 }, { { RW, 9, 0 }, { GW, 9, 0 }, { BW, 9, 0 }, { RX, 3, 0 }, { RW, 10, 10 }, { GZ, 4, 4 }, { GY, 3, 0 }, { GX, 4, 0 },
+            { GW, 10, 10 }, { GZ, 3, 0 }, { BX, 3, 0 }, { BW, 10, 10 }, { BZ, 1, 1 }, { BY, 3, 0 }, { RY, 3, 0 }, { BZ, 0, 0 }, { BZ, 2, 2 }, { RZ, 3, 0 },
+            { GY, 4, 4 }, { BZ, 3, 3 } } },
+        { true, 11, { 4, 4, 5 }, { { RW, 9, 0 }, { GW, 9, 0 }, { BW, 9, 0 }, { RX, 3, 0 }, { RW, 10, 10 }, { BY, 4, 4 }, { GY, 3, 0 }, { GX, 3, 0 },
+            { GW, 10, 10 }, { BZ, 0, 0 }, { GZ, 3, 0 }, { BX, 4, 0 }, { BW, 10, 10 }, { BY, 3, 0 }, { RY, 3, 0 }, { BZ, 1, 1 }, { BZ, 2, 2 }, { RZ, 3, 0 },
+            { BZ, 4, 4 }, { BZ, 3, 3 } } },
+        { true, 9, { 5, 5, 5 }, { { RW, 8, 0 }, { BY, 4, 4 }, { GW, 8, 0 }, { GY, 4, 4 }, { BW, 8, 0 }, { BZ, 4, 4 }, { RX, 4, 0 }, { GZ, 4, 4 },
+            { GY, 3, 0 }, { GX, 4, 0 }, { BZ, 0, 0 }, { GZ, 3, 0 }, { BX, 4, 0 }, { BZ, 1, 1 }, { BY, 3, 0 }, { RY, 4, 0 }, { BZ, 2, 2 }, { RZ, 4, 0 },
+            { BZ, 3, 3 } } },
+        { true, 8, { 6, 5, 5 }, { { RW, 7, 0 }, { GZ, 4, 4 }, { BY, 4, 4 }, { GW, 7, 0 }, { BZ, 2, 2 }, { GY, 4, 4 }, { BW, 7, 0 }, { BZ, 3, 3 },
+            { BZ, 4, 4 }, { RX, 5, 0 }, { GY, 3, 0 }, { GX, 4, 0 }, { BZ, 0, 0 }, { GZ, 3, 0 }, { BX, 4, 0 }, { BZ, 1, 1 }, { BY, 3, 0 }, { RY, 5, 0 },
+            { RZ, 5, 0 } } },
+        { true, 8, { 5, 6, 5 }, { { RW, 7, 0 }, { BZ, 0, 0 }, { BY, 4, 4 }, { GW, 7, 0 }, { GY, 5, 5 }, { GY, 4, 4 }, { BW, 7, 0 }, { GZ, 5, 5 },
+            { BZ, 4, 4 }, { RX, 4, 0 }, { GZ, 4, 4 }, { GY, 3, 0 }, { GX, 5, 0 }, { GZ, 3, 0 }, { BX, 4, 0 }, { BZ, 1, 1 }, { BY, 3, 0 }, { RY, 4, 0 },
+            { BZ, 2, 2 }, { RZ, 4, 0 }, { BZ, 3, 3 } } },
+        { true, 8, { 5, 5, 6 }, { { RW, 7, 0 }, { BZ, 1, 1 }, { BY, 4, 4 }, { GW, 7, 0 }, { BY, 5, 5 }, { GY, 4, 4 }, { BW, 7, 0 }, { BZ, 5, 5 },
+            { BZ, 4, 4 }, { RX, 4, 0 }, { GZ, 4, 4 }, { GY, 3, 0 }, { GX, 4, 0 }, { BZ, 0, 0 }, { GZ, 3, 0 }, { BX, 5, 0 }, { BY, 3, 0 }, { RY, 4, 0 },
+            { BZ, 2, 2 }, { RZ, 4, 0 }, { BZ, 3, 3 } } },
+        { false, 6, { 6, 6, 6 }, { { RW, 5, 0 }, { GZ, 4, 4 }, { BZ, 0, 0 }, { BZ, 1, 1 }, { BY, 4, 4 }, { GW, 5, 0 }, { GY, 5, 5 }, { BY, 5, 5 },
+            { BZ, 2, 2 }, { GY, 4, 4 }, { BW, 5, 0 }, { GZ, 5, 5 }, { BZ, 3, 3 }, { BZ, 5, 5 }, { BZ, 4, 4 }, { RX, 5, 0 }, { GY, 3, 0 }, { GX, 5, 0 },
+            { GZ, 3, 0 }, { BX, 5, 0 }, { BY, 3, 0 }, { RY, 5, 0 }, { RZ, 5, 0 } } },
+        { false, 10, { 10, 10, 10 }, { { RW, 9, 0 }, { GW, 9, 0 }, { BW, 9, 0 }, { RX, 9, 0 }, { GX, 9, 0 }, { BX, 9, 0 } } },
+        { true, 11, { 9, 9, 9 }, { { RW, 9, 0 }, { GW, 9, 0 }, { BW, 9, 0 }, { RX, 8, 0 }, { RW, 10, 10 }, { GX, 8, 0 }, { GW, 10, 10 }, { BX, 8, 0 },
+            { BW, 10, 10 } } },
+        { true, 12, { 8, 8, 8 }, { { RW, 9, 0 }, { GW, 9, 0 }, { BW, 9, 0 }, { RX, 7, 0 }, { RW, 10, 11 }, { GX, 7, 0 }, { GW, 10, 11 }, { BX, 7, 0 },
+            { BW, 10, 11 } } },
+        { true, 16, { 4, 4, 4 }, { { RW, 9, 0 }, { GW, 9, 0 }, { BW, 9, 0 }, { RX, 3, 0 }, { RW, 10, 15 }, { GX, 3, 0 }, { GW, 10, 15 }, { BX, 3, 0 },
+            { BW, 10, 15 } } }
+    };
+
+    //--------------------------------------------------------------------------------------
+    inline unsigned int ReverseBits(unsigned int value, unsigned int count)
+    {
+        unsigned int ret = 0;
+        for (unsigned int i = 0; i < count; ++i, value >>= 1)
+            ret = (ret << 1) | (value & 1);
+        return ret;
+    }
+
+    //--------------------------------------------------------------------------------------
+    inline int SignExtend(int value, unsigned int bits)
+    {
+        int shift = 32 - static_cast<int>(bits);
+        return static_cast<int>(static_cast<unsigned int>(value) << shift) >> shift;
+    }
+
+    //--------------------------------------------------------------------------------------
+    //spreads an endpoint over the full 16 bit range before interpolating
+    template<bool Signed>
+    int UnquantizeBC6H(int value, unsigned int bits)
+    {
+        if (!Signed)
+        {
+            if (bits >= 15 || value == 0)
+                return value;
+            if (value == (1 << bits) - 1)
+                return 0xffff;
+            return ((value << 16) + 0x8000) >> bits;
+        }
+
+        if (bits >= 16 || value == 0)
+            return value;
+
+        bool negative = value < 0;
+        int magnitude = negative ? -value : value;
+        int ret;
+        if (magnitude >= (1 << (bits - 1)) - 1)
+            ret = 0x7fff;
+        else
+            ret = ((magnitude << 15) + 0x4000) >> (bits - 1);
+        return negative ? -ret : ret;
+    }
+
+    //--------------------------------------------------------------------------------------
+    //scales an interpolated value into the bits of a half float
+    template<bool Signed>
+    std::uint16_t FinishBC6H(int value)
+    {
+        if (!Signed)
+            return static_cast<std::uint16_t>((value * 31) >> 6);
+
+        if (value < 0)
+            return static_cast<std::uint16_t>(0x8000 | (((-value) * 31) >> 5));
+        return static_cast<std::uint16_t>((value * 31) >> 5);
+    }
+
+    //--------------------------------------------------------------------------------------
+    //'out' is 16 RGB16F pixels
+    template<bool Signed>
+    void DecodeBC6H(const unsigned char* block, unsigned char* out)
+    {
+        BitReader bits(block);
+
+        //two bits select modes 1 and 2, the rest use five
+        unsigned int modeBits = bits.Read(2);
+        int mode = static_cast<int>(modeBits);
+        if (modeBits >= 2)
+        {
+            modeBits |= bits.Read(3) << 2;
+
+            //the low two bits choose the column, the high three the row
+            const int modes[32] =
+            {
+                -1, -1, 2, 10, -1, -1, 3, 11, -1, -1, 4, 12, -1, -1, 5, 13,
+                -1, -1, 6, -1, -1, -1, 7, -1, -1, -1, 8, -1, -1, -1, 9, -1
+            };
+            mode = modes[modeBits];
+        }
+
+        //reserved; decodes to black
+        if (mode < 0)
+        {
+            std::memset(out, 0, 16 * 6);
+            return;
+        }
+
+        //each run of bits is read at once; the reversed ones are flipped after
+        const BC6HMode& info = g_BC6HModes[mode];
+        int fields[12] = {};
+        for (const auto& it : info.mLayout)
+        {
+            bool reversed = it.mFrom < it.mTo;
+            unsigned int lowBit = reversed ? it.mFrom : it.mTo;
+            unsigned int count = (reversed ? it.mTo : it.mFrom) - lowBit + 1;
+
+            unsigned int value = bits.Read(count);
+            if (reversed)
+                value = ReverseBits(value, count);
+            fields[it.mField] |= static_cast<int>(value << lowBit);
+        }
+
+        bool twoRegions = mode < 10;
+        unsigned int partition = twoRegions ? bits.Read(5) : 0;
+        unsigned int endpointCount = twoRegions ? 4 : 2;
+
+        //w, x, y, z
+        int endpoints[4][3];
+        for (unsigned int e = 0; e < endpointCount; ++e)
+        {
+            for (unsigned int channel = 0; channel < 3; ++channel)
+            {
+                int value = fields[e * 3 + channel];
+                unsigned int fieldBits = e == 0 ? info.mEndpointBits : info.mDeltaBits[channel];
+                if (e == 0 || !info.mTransformed)
+                {
+                    endpoints[e][channel] = Signed ? SignExtend(value, info.mEndpointBits) : value;
+                    continue;
+                }
+
+                //deltas are always signed, and wrap around within the endpoint's bits
+                value = (endpoints[0][channel] + SignExtend(value, fieldBits)) & ((1 << info.mEndpointBits) - 1);
+                endpoints[e][channel] = Signed ? SignExtend(value, info.mEndpointBits) : value;
+            }
+        }
+
+        for (unsigned int e = 0; e < endpointCount; ++e)
+        {
+            for (unsigned int channel = 0; channel < 3; ++channel)
+                endpoints[e][channel] = UnquantizeBC6H<Signed>(endpoints[e][channel], info.mEndpointBits);
+        }
+
+        //two regions use 3 bit indices, one region 4 bit indices; anchors drop their top bit
+        unsigned int indexBits = twoRegions ? 3 : 4;
+        const unsigned int anchors[2] = { 0, g_Anchors2[partition] };
+        std::uint64_t indices = ReadIndices(bits, indexBits, anchors, twoRegions ? 2 : 1);
+        std::uint64_t indexMask = (1u << indexBits) - 1;
+        const int* weights = Weights(indexBits);
+        const unsigned char* partitions = g_Partitions2[partition];
+
+#ifdef GLUF_SSE2
+        //each channel's endpoints sit in one 32 bit lane as a pair of 16 bit values, so one multiply-add interpolates a
+        //  pixel.  Unsigned endpoints are moved into the signed range first; the weights add up to 64, so adding
+        //  64 times the bias back after undoes that
+        const int bias = Signed ? 0 : 0x8000;
+        __m128i pairs[2];
+        for (unsigned int subset = 0; subset < endpointCount / 2; ++subset)
+        {
+            const int* e0 = endpoints[subset * 2];
+            const int* e1 = endpoints[subset * 2 + 1];
+            pairs[subset] = _mm_setr_epi32(((e0[0] - bias) & 0xffff) | ((e1[0] - bias) << 16), ((e0[1] - bias) & 0xffff) | ((e1[1] - bias) << 16),
+                ((e0[2] - bias) & 0xffff) | ((e1[2] - bias) << 16), 0);
+        }
+        const __m128i round = _mm_set1_epi32(32 + bias * 64);
+
+        //each pixel is stored with a fourth channel, which the next pixel overwrites
+        std::uint16_t pixels[16 * 3 + 1];
+        for (unsigned int i = 0; i < 16; ++i)
+        {
+            unsigned int subset = twoRegions ? partitions[i] : 0;
+            int weight = weights[(indices >> (i * indexBits)) & indexMask];
+            __m128i value = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(pairs[subset], _mm_set1_epi32((64 - weight) | (weight << 16))), round), 6);
+
+            //see 'FinishBC6H'; the magnitudes fit in 15 bits, so they survive the signed pack, and the sign goes on after
+            __m128i finished;
+            if (Signed)
+            {
+                __m128i sign = _mm_srai_epi32(value, 31);
+                __m128i magnitude = _mm_sub_epi32(_mm_xor_si128(value, sign), sign);
+                magnitude = _mm_srli_epi32(_mm_sub_epi32(_mm_slli_epi32(magnitude, 5), magnitude), 5);
+                finished = _mm_or_si128(_mm_packs_epi32(magnitude, magnitude), _mm_and_si128(_mm_packs_epi32(sign, sign), _mm_set1_epi16(-0x8000)));
+            }
+            else
+            {
+                finished = _mm_srli_epi32(_mm_sub_epi32(_mm_slli_epi32(value, 5), value), 6);
+                finished = _mm_packs_epi32(finished, finished);
+            }
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(pixels + i * 3), finished);
+        }
+#else
+        std::uint16_t pixels[16 * 3];
+        for (unsigned int i = 0; i < 16; ++i)
+        {
+            unsigned int subset = twoRegions ? partitions[i] : 0;
+            int weight = weights[(indices >> (i * indexBits)) & indexMask];
+
+            for (unsigned int channel = 0; channel < 3; ++channel)
+            {
+                int value = Interpolate(endpoints[subset * 2][channel], endpoints[subset * 2 + 1][channel], weight);
+                pixels[i * 3 + channel] = FinishBC6H<Signed>(value);
+            }
+        }
+#endif
+
+        std::memcpy(out, pixels, 16 * 6);
+    }
+
+    /*
+
+    Formats
+
+    */
+
+    const BlockFormat g_BlockFormats[] =
+    {
+        { GL_COMPRESSED_RGB_S3TC_DXT1_EXT, DecodeBC1Opaque, 8, 4, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE },
+        { GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, DecodeBC1, 8, 4, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE },
+        { GL_COMPRESSED_SRGB_S3TC_DXT1_EXT, DecodeBC1Opaque, 8, 4, GL_SRGB8_ALPHA8, GL_RGBA, GL_UNSIGNED_BYTE },
+        { GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT, DecodeBC1, 8, 4, GL_SRGB8_ALPHA8, GL_RGBA, GL_UNSIGNED_BYTE },
+        { GL_COMPRESSED_RGBA_S3TC_DXT3_EXT, DecodeBC2, 16, 4, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE },
+        { GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT, DecodeBC2, 16, 4, GL_SRGB8_ALPHA8, GL_RGBA, GL_UNSIGNED_BYTE },
+        { GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, DecodeBC3, 16, 4, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE },
+        { GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT, DecodeBC3, 16, 4, GL_SRGB8_ALPHA8, GL_RGBA, GL_UNSIGNED_BYTE },
+        { GL_COMPRESSED_RED_RGTC1, DecodeBC4<false>, 8, 1, GL_R8, GL_RED, GL_UNSIGNED_BYTE },
+        { GL_COMPRESSED_SIGNED_RED_RGTC1, DecodeBC4<true>, 8, 1, GL_R8_SNORM, GL_RED, GL_BYTE },
+        { GL_COMPRESSED_RG_RGTC2, DecodeBC5<false>, 16, 2, GL_RG8, GL_RG, GL_UNSIGNED_BYTE },
+        { GL_COMPRESSED_SIGNED_RG_RGTC2, DecodeBC5<true>, 16, 2, GL_RG8_SNORM, GL_RG, GL_BYTE },
+        { GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT_ARB, DecodeBC6H<false>, 16, 6, GL_RGB16F, GL_RGB, GL_HALF_FLOAT },
+        { GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT_ARB, DecodeBC6H<true>, 16, 6, GL_RGB16F, GL_RGB, GL_HALF_FLOAT },
+        { GL_COMPRESSED_RGBA_BPTC_UNORM_ARB, DecodeBC7, 16, 4, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE },
+        { GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM_ARB, DecodeBC7, 16, 4, GL_SRGB8_ALPHA8, GL_RGBA, GL_UNSIGNED_BYTE }
+    };
+
+    //--------------------------------------------------------------------------------------
+    const BlockFormat* FindBlockFormat(GLenum compressedFormat)
+    {
+        for (const auto& it : g_BlockFormats)
+        {
+            if (it.mCompressedFormat == compressedFormat)
+                return &it;
+        }
+        return nullptr;
+    }
+
+    //--------------------------------------------------------------------------------------
+    //decodes rows of blocks ['firstRow', 'lastRow') of a level; the edge blocks of levels which are not a multiple of 4
+    //  only write the pixels inside the level
+    void DecodeRows(const BlockFormat& format, const unsigned char* src, unsigned int width, unsigned int height, unsigned char* dst,
+        unsigned int firstRow, unsigned int lastRow)
+    {
+        unsigned int blocksWide = (width + 3) / 4;
+        std::size_t pitch = static_cast<std::size_t>(width) * format.mPixelSize;
+        std::size_t blockPitch = 4 * format.mPixelSize;
+
+        alignas(32) unsigned char pixels[16 * 6];
+        for (unsigned int row = firstRow; row < lastRow; ++row)
+        {
+            const unsigned char* block = src + static_cast<std::size_t>(row) * blocksWide * format.mBlockSize;
+            unsigned char* dstRow = dst + static_cast<std::size_t>(row) * 4 * pitch;
+            unsigned int rows = std::min(4u, height - row * 4);
+
+            for (unsigned int column = 0; column < blocksWide; ++column, block += format.mBlockSize)
+            {
+                format.mDecode(block, pixels);
+
+                std::size_t bytes = std::min(4u, width - column * 4) * format.mPixelSize;
+                for (unsigned int y = 0; y < rows; ++y)
+                    std::memcpy(dstRow + y * pitch + column * blockPitch, pixels + y * blockPitch, bytes);
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------------------
+    struct DecodeTask
+    {
+        const DDSMipLevel* mSrc;
+        const DDSMipLevel* mDst;
+        unsigned int mFirstRow;
+        unsigned int mLastRow;
+    };
+
+    //--------------------------------------------------------------------------------------
+    //the tasks of one 'DecompressDDS' call, shared with the 'ASYNCLOADER' workers helping out.  A helper may only start
+    //  after every task was claimed, so it must not touch anything but this
+    struct DecodeJob
+    {
+        const BlockFormat* mFormat = nullptr;
+        const unsigned char* mSrc = nullptr;
+        unsigned char* mDst = nullptr;
+        std::vector<DecodeTask> mTasks;
+
+        std::atomic<std::size_t> mNextTask{ 0 };
+        std::atomic<std::size_t> mTasksDone{ 0 };
+        std::mutex mDoneMutex;
+        std::condition_variable mDoneCondition;
+
+        void Work() noexcept
+        {
+            for (std::size_t i = mNextTask++; i < mTasks.size(); i = mNextTask++)
+            {
+                const DecodeTask& task = mTasks[i];
+                DecodeRows(*mFormat, mSrc + task.mSrc->mOffset, task.mSrc->mWidth, task.mSrc->mHeight, mDst + task.mDst->mOffset,
+                    task.mFirstRow, task.mLastRow);
+
+                if (++mTasksDone == mTasks.size())
+                {
+                    { std::lock_guard<std::mutex> lock(mDoneMutex); }
+                    mDoneCondition.notify_all();
+                }
+            }
+        }
+
+        //only waits on tasks somebody already claimed, so this never waits for a helper to get scheduled
+        void Wait()
+        {
+            std::unique_lock<std::mutex> lock(mDoneMutex);
+            mDoneCondition.wait(lock, [this]() { return mTasksDone == mTasks.size(); });
+        }
+    };
+}
+
+//--------------------------------------------------------------------------------------
+DDSImage ParseDDS(const MemorySpan& rawData)
+{
+    GLUF_PROFILE_ZONE("ParseDDS");
+
+    using namespace DDS;
+
+    //verify size of header
+    if (rawData.size() < g_HeaderSize)
+    {
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(ParseDDS): Raw Data Too Small For Header!"));
+    }
+
+    //verify the type of file
+    std::string filecode(rawData.begin(), rawData.begin() + 4);
+    if (filecode != "DDS ")
+    {
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(ParseDDS): Incorrect File Format!"));
+    }
+
+    //load the header (NOTE: this is all offset by 4 bytes because of the filecode)
+    unsigned int flags = ReadU32(rawData, 8);
+    unsigned int height = ReadU32(rawData, 12);
+    unsigned int width = ReadU32(rawData, 16);
+    unsigned int depth = ReadU32(rawData, 24);
+    unsigned int mipMapCount = ReadU32(rawData, 28);
+    unsigned int pfFlags = ReadU32(rawData, 80);
+    unsigned int fourCC = ReadU32(rawData, 84);
+    unsigned int bitCount = ReadU32(rawData, 88);
+    unsigned int masks[4] = { ReadU32(rawData, 92), ReadU32(rawData, 96), ReadU32(rawData, 100), ReadU32(rawData, 104) };
+    unsigned int caps2 = ReadU32(rawData, 112);
+
+    DDSImage image;
+    std::size_t offset = g_HeaderSize;
+    bool cubemap = false;
+
+    if ((pfFlags & g_PFFourCC) && fourCC == MakeFourCC('D', 'X', '1', '0'))
+    {
+        if (rawData.size() < g_HeaderSize + g_DX10HeaderSize)
+            GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(ParseDDS): Raw Data Too Small For DX10 Header!"));
+
+        unsigned int dxgiFormat = ReadU32(rawData, 128);
+        unsigned int dimension = ReadU32(rawData, 132);
+        unsigned int miscFlag = ReadU32(rawData, 136);
+        unsigned int arraySize = ReadU32(rawData, 140);
+        offset += g_DX10HeaderSize;
+
+        if (!SetFormatFromDXGI(image, dxgiFormat))
+            GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(ParseDDS): Unsupported DXGI Format " + std::to_string(dxgiFormat) + "!"));
+
+        //1D textures load as 2D textures one texel tall
+        if (dimension != g_DimensionTexture2D && dimension != g_DimensionTexture1D)
+            GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(ParseDDS): Only 1D and 2D Textures Are Supported!"));
+
+        if (arraySize == 0)
+            GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(ParseDDS): Array Size Of 0!"));
+
+        cubemap = (miscFlag & g_MiscTextureCube) != 0;
+        image.mLayers = arraySize;
+    }
+    else
+    {
+        bool known = (pfFlags & g_PFFourCC) ? SetFormatFromFourCC(image, fourCC) : SetFormatFromMasks(image, pfFlags, bitCount, masks);
+        if (!known)
+            GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(ParseDDS): Unsupported Pixel Format!"));
+
+        if ((caps2 & g_Caps2Volume) || ((flags & g_FlagDepth) && depth > 1))
+            GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(ParseDDS): Volume Textures Are Not Supported!"));
+
+        if (caps2 & g_Caps2Cubemap)
+        {
+            if ((caps2 & g_Caps2AllFaces) != g_Caps2AllFaces)
+                GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(ParseDDS): Partial Cubemaps Are Not Supported!"));
+            cubemap = true;
+        }
+    }
+
+    if (width == 0 || height == 0)
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(ParseDDS): Texture Has No Size!"));
+
+    if (cubemap && width != height)
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(ParseDDS): Cubemap Faces Are Not Square!"));
+
+    if (cubemap && image.mLayers > 1 && !HasCubeMapArray())
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(ParseDDS): Cubemap Arrays Need OpenGL 4.0 Or ARB_texture_cube_map_array!"));
+
+    //files without DDSD_MIPMAPCOUNT store 0 here, but still contain the base level
+    if (mipMapCount == 0)
+        mipMapCount = 1;
+
+    unsigned int maxMipCount = 1;
+    for (unsigned int size = std::max(width, height); size > 1; size /= 2)
+        ++maxMipCount;
+    if (mipMapCount > maxMipCount)
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(ParseDDS): More Mip Levels Than The Texture Size Allows!"));
+
+    image.mWidth = width;
+    image.mHeight = height;
+    image.mFaces = cubemap ? 6 : 1;
+    image.mMipCount = mipMapCount;
+    if (image.mLayers > 1)
+        image.mTarget = cubemap ? GL_TEXTURE_CUBE_MAP_ARRAY : GL_TEXTURE_2D_ARRAY;
+    else
+        image.mTarget = cubemap ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D;
+
+    //check the array size against the data before reserving room for every level of it
+    if (image.mLayers > 1)
+    {
+        std::size_t remaining = rawData.size() - offset;
+        std::size_t elementSize = 0;
+        unsigned int levelWidth = width;
+        unsigned int levelHeight = height;
+        for (unsigned int level = 0; level < mipMapCount && elementSize <= remaining; ++level)
+        {
+            elementSize += LevelSize(image, levelWidth, levelHeight);
+            levelWidth = std::max(levelWidth / 2, 1u);
+            levelHeight = std::max(levelHeight / 2, 1u);
+        }
+
+        if (static_cast<std::size_t>(image.mLayers) * image.mFaces > remaining / elementSize)
+            GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(ParseDDS): Array Size Runs Past The End Of The Data!"));
+    }
+
+    /* walk the mipmaps of every face of every layer, in file order */
+    image.mMipLevels.reserve(static_cast<std::size_t>(image.mLayers) * image.mFaces * mipMapCount);
+    for (unsigned int layer = 0; layer < image.mLayers; ++layer)
+    {
+        for (unsigned int face = 0; face < image.mFaces; ++face)
+        {
+            unsigned int levelWidth = width;
+            unsigned int levelHeight = height;
+            for (unsigned int level = 0; level < mipMapCount; ++level)
+            {
+                DDSMipLevel mip;
+                mip.mWidth = levelWidth;
+                mip.mHeight = levelHeight;
+                mip.mLevel = level;
+                mip.mLayer = layer;
+                mip.mFace = face;
+                mip.mOffset = offset;
+                mip.mSize = LevelSize(image, levelWidth, levelHeight);
+
+                //'offset' never passes the end, so this can not overflow
+                if (mip.mSize > rawData.size() - offset)
+                    GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(ParseDDS): Mip Level Runs Past The End Of The Data!"));
+
+                image.mMipLevels.push_back(mip);
+
+                offset += mip.mSize;
+
+                // Deal with Non-Power-Of-Two textures
+                levelWidth = std::max(levelWidth / 2, 1u);
+                levelHeight = std::max(levelHeight / 2, 1u);
+            }
+        }
+    }
+
+    return image;
+}
+
+//--------------------------------------------------------------------------------------
+bool IsCompressedFormatSupported(GLenum compressedFormat)
+{
+    switch (compressedFormat)
+    {
+    case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+    case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+        return gSupportsS3TC;
+    case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT:
+    case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+        return gSupportsS3TCsRGB;
+    case GL_COMPRESSED_RED_RGTC1:
+    case GL_COMPRESSED_SIGNED_RED_RGTC1:
+    case GL_COMPRESSED_RG_RGTC2:
+    case GL_COMPRESSED_SIGNED_RG_RGTC2:
+        return gSupportsRGTC;
+    case GL_COMPRESSED_RGBA_BPTC_UNORM_ARB:
+    case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM_ARB:
+    case GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT_ARB:
+    case GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT_ARB:
+        return gSupportsBPTC;
+    default:
+        return false;
+    }
+}
+
+//--------------------------------------------------------------------------------------
+DDSImage DecompressDDS(const DDSImage& image, const MemorySpan& rawData, std::vector<char>& decoded)
+{
+    GLUF_PROFILE_ZONE("DecompressDDS");
+
+    using namespace BCDecoding;
+
+    const BlockFormat* format = FindBlockFormat(image.mCompressedFormat);
+    if (!format)
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(DecompressDDS): Image Is Not Block Compressed!"));
+
+    //same levels, tightly packed one after another
+    DDSImage ret = image;
+    DDS::SetUncompressed(ret, format->mInternalFormat, format->mFormat, format->mType);
+
+    std::size_t offset = 0;
+    for (auto& it : ret.mMipLevels)
+    {
+        it.mOffset = offset;
+        it.mSize = static_cast<std::size_t>(it.mWidth) * it.mHeight * format->mPixelSize;
+        offset += it.mSize;
+    }
+    decoded.resize(offset);
+
+    //split every level into runs of block rows, so small levels are not a task each
+    auto job = std::make_shared<DecodeJob>();
+    job->mFormat = format;
+    job->mSrc = reinterpret_cast<const unsigned char*>(rawData.data());
+    job->mDst = reinterpret_cast<unsigned char*>(decoded.data());
+    for (std::size_t i = 0; i < image.mMipLevels.size(); ++i)
+    {
+        const DDSMipLevel& mip = image.mMipLevels[i];
+        if (mip.mSize > rawData.size() || mip.mOffset > rawData.size() - mip.mSize)
+            GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(DecompressDDS): Mip Level Runs Past The End Of The Data!"));
+
+        unsigned int blocksWide = (mip.mWidth + 3) / 4;
+        unsigned int blockRows = (mip.mHeight + 3) / 4;
+        unsigned int rowsPerTask = std::max(1u, g_BlocksPerTask / blocksWide);
+        for (unsigned int row = 0; row < blockRows; row += rowsPerTask)
+            job->mTasks.push_back({ &mip, &ret.mMipLevels[i], row, std::min(row + rowsPerTask, blockRows) });
+    }
+
+    //idle 'ASYNCLOADER' workers help out instead of new threads, so loads decoding on the workers do not oversubscribe
+    //  the cores.  A pool which is not running is not started for this; the decode then stays on this thread, which
+    //  takes tasks either way, so it never waits on a busy pool
+    unsigned int hwThreads = std::thread::hardware_concurrency();
+    std::size_t helpers = job->mTasks.empty() ? 0 : std::min<std::size_t>(hwThreads > 1 ? hwThreads - 1 : 0, job->mTasks.size() - 1);
+    for (std::size_t i = 0; i < helpers; ++i)
+    {
+        if (!ASYNCLOADER.TryQueueWork([job]() { job->Work(); }))
+            break;
+    }
+
+    job->Work();
+    job->Wait();
+
+    return ret;
+}
+
+/*
+UploadDDS
+
+    Parameters:
+        'image': the parsed layout of 'rawData'
+        'rawData': raw data loaded from file to put into OpenGL
+
+    Returns:
+        OpenGL Id of texture created, which is a 'image.mTarget' texture
+
+    Throws:
+        'TextureCreationException': if OpenGL failed to create the texture
+
+    Note:
+        With GL 4.2 or ARB_texture_storage, every level is allocated at once with glTexStorage* and filled in with 
+            sub-image uploads, so the texture is immutable; older contexts define each level with glTexImage*
+        Block compressed formats the context does not support are decoded with 'DecompressDDS' first
+
+*/
+//--------------------------------------------------------------------------------------
+GLuint UploadDDS(const DDSImage& image, const MemorySpan& rawData)
+{
+    GLUF_PROFILE_ZONE("UploadDDS");
+
+    //the context can not sample this format, so upload the decoded texels instead
+    if (image.mCompressedFormat != 0 && !IsCompressedFormatSupported(image.mCompressedFormat))
+    {
+        std::vector<char> decoded;
+        DDSImage decodedImage = DecompressDDS(image, rawData, decoded);
+        return UploadDDS(decodedImage, decoded);
+    }
+
+    //mutable 2D and cube textures define each level as it is uploaded
+    bool layered = image.mTarget == GL_TEXTURE_2D_ARRAY || image.mTarget == GL_TEXTURE_CUBE_MAP_ARRAY;
+    bool subImage = DDS::HasTextureStorage() || layered;
+
+    GLuint textureID = DDS::CreateTexture(image, false);
+
+    /* load the mipmaps */
+    for (const auto& mip : image.mMipLevels)
+        DDS::UploadLevel(image, mip, rawData.data() + mip.mOffset, subImage);
+
+    GLSTATE.BindTexture(image.mTarget, 0);
+
+    return textureID;
+}
+
+/*
+LoadTextureDDS
+
+    Parameters:
+        'rawData': raw data loaded from file to put into OpenGL
+        'target': if not null, set to what the texture binds to, which the header decides
+
+    Returns:
+        OpenGL Id of texture created
+
+    Throws:
+        'std::invalid_argument': if data is too small, is not the correct file format, 
+
+*/
+//--------------------------------------------------------------------------------------
+GLuint LoadTextureDDS(const MemorySpan& rawData, GLenum* target)
+{
+    GLUF_PROFILE_ZONE("LoadTextureDDS");
+
+    DDSImage image = ParseDDS(rawData);
+    if (target)
+        *target = image.mTarget;
+
+    return UploadDDS(image, rawData);
+}
+
+//--------------------------------------------------------------------------------------
+GLuint LoadTextureCubemapDDS(const MemorySpan& rawData, GLenum* target)
+{    
+    GLUF_PROFILE_ZONE("LoadTextureCubemapDDS");
+
+    //files which are real cubemaps go through the regular path; the rest are six faces laid out one after another
+    if (rawData.size() >= 128 && std::string(rawData.begin(), rawData.begin() + 4) == "DDS " && (DDS::ReadU32(rawData, 112) & DDS::g_Caps2Cubemap) != 0)
+    {
+        return LoadTextureDDS(rawData, target);
+    }
+
+    if (target)
+        *target = GL_TEXTURE_CUBE_MAP;
+
+
+    //verify size of header
+    if (rawData.size() < 128)
+    {
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(LoadTextureDDS): Raw Data Too Small For Header!"));
+    }
+
+    //verify the type of file 
+    std::string filecode(rawData.begin(), rawData.begin() + 4);
+    if (filecode != "DDS ")
+    {
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(LoadTextureDDS): Incorrect File Format!"));
+    }
+    
+    //load the header (NOTE: this is all offset by 4 bytes because of the filecode)
+    unsigned int width = DDS::ReadU32(rawData, 16);
+    unsigned int fourCC = DDS::ReadU32(rawData, 84);
+
+    if (width == 0)
+    {
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(LoadTextureDDS): Texture Has No Size!"));
+    }
+
+    //only the base level of each face is loaded
+    DDSImage image;
+    image.mTarget = GL_TEXTURE_CUBE_MAP;
+    image.mWidth = width;
+    image.mHeight = width;
+    image.mFaces = 6;
+    image.mMipCount = 1;
+
+    switch (fourCC)
+    {
+    case FOURCC_DXT1:
+        DDS::SetCompressed(image, GL_COMPRESSED_RGBA_S3TC_DXT1_EXT);
+        break;
+    case FOURCC_DXT3:
+        DDS::SetCompressed(image, GL_COMPRESSED_RGBA_S3TC_DXT3_EXT);
+        break;
+    case FOURCC_DXT5:
+        DDS::SetCompressed(image, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT);
+        break;
+    default:
+        DDS::SetUncompressed(image, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE);
+    }
+
+    //the faces are stored in this order, not OpenGL's
+    const unsigned int fileFaces[6] = { 1, 4, 0, 5, 3, 2 };//-X, +Z, +X, -Z, -Y, +Y
+
+    std::size_t faceSize = DDS::LevelSize(image, width, width);
+    std::size_t offset = 128;// initial offset to compensate for header and file code
+    for (unsigned int face : fileFaces)
+    {
+        if (faceSize > rawData.size() - offset)
+        {
+            GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(LoadTextureDDS): Raw Data Too Small!"));
+        }
+
+        DDSMipLevel mip;
+        mip.mWidth = width;
+        mip.mHeight = width;
+        mip.mFace = face;
+        mip.mOffset = offset;
+        mip.mSize = faceSize;
+        image.mMipLevels.push_back(mip);
+
+        offset += faceSize;
+    }
+
+    GLuint textureID = UploadDDS(image, rawData);
+
+    GLSTATE.BindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    GLSTATE.BindTexture(GL_TEXTURE_CUBE_MAP, 0);
+
+    return textureID;
+}
+
+
+
+//--------------------------------------------------------------------------------------
+GLuint LoadTextureFromFile(const std::string& filePath, TextureFileFormat format, GLenum* target)
+{
+    //the texture data is handed straight from the mapping to OpenGL
+    MappedFile memory;
+
+    try
+    {
+        memory.Open(filePath);
+    }
+    catch (const std::ios_base::failure& e)
+    {
+        GLUF_ERROR_LONG("(LoadTextureFromFile): " << e.what());
+    }
+
+    GLuint texId;
+    try
+    {
+        texId = LoadTextureFromMemory(memory, format, target);
+    }
+    catch (const TextureCreationException& e)
+    {
+        GLUF_ERROR_LONG("(LoadTextureFromFile): " << e.what());
+        RETHROW;
+    }
+
+    return texId;
+}
+
+
+//--------------------------------------------------------------------------------------
+GLuint LoadTextureFromMemory(const MemorySpan& data, TextureFileFormat format, GLenum* target)
+{
+
+    try
+    {
+        switch (format)
+        {
+        case TFF_DDS:
+            return LoadTextureDDS(data, target);
+        case TTF_DDS_CUBEMAP:
+            return LoadTextureCubemapDDS(data, target);
+        }
+    }
+    catch (const TextureCreationException& e)
+    {
+        GLUF_ERROR_LONG("(LoadTextureFromMemory): " << e.what());
+        RETHROW;
+    }
+    return 0;
+}
+
+//--------------------------------------------------------------------------------------
+std::size_t GetTextureMemorySize(GLuint texture, GLenum target)
+{
+    GLuint prevTexture = GLSTATE.GetTexture(target);
+    GLSTATE.BindTexture(target, texture);
+
+    //cubemap levels are queried per face
+    std::vector<GLenum> levelTargets;
+    if (target == GL_TEXTURE_CUBE_MAP)
+    {
+        for (GLenum face = 0; face < 6; ++face)
+            levelTargets.push_back(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face);
+    }
+    else
+    {
+        levelTargets.push_back(target);
+    }
+
+    GLint maxLevel = 1000;
+    glGetTexParameteriv(target, GL_TEXTURE_MAX_LEVEL, &maxLevel);
+
+    std::size_t size = 0;
+    for (auto levelTarget : levelTargets)
+    {
+        for (GLint level = 0; level <= maxLevel; ++level)
+        {
+            GLint width = 0, height = 0, depth = 0, compressed = GL_FALSE;
+            glGetTexLevelParameteriv(levelTarget, level, GL_TEXTURE_WIDTH, &width);
+            if (width == 0)
+                break;//no more levels
+
+            glGetTexLevelParameteriv(levelTarget, level, GL_TEXTURE_COMPRESSED, &compressed);
+            if (compressed == GL_TRUE)
+            {
+                GLint compressedSize = 0;
+                glGetTexLevelParameteriv(levelTarget, level, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &compressedSize);
+                size += static_cast<std::size_t>(compressedSize);
+                continue;
+            }
+
+            glGetTexLevelParameteriv(levelTarget, level, GL_TEXTURE_HEIGHT, &height);
+            glGetTexLevelParameteriv(levelTarget, level, GL_TEXTURE_DEPTH, &depth);
+
+            //the sum of the component sizes is the texel size; luminance and intensity sizes are not queried, since
+            //  the core profile dropped them, and the DDS loader uploads those formats as swizzled red/green textures
+            GLint bits = 0;
+            const GLenum componentQueries[] = { GL_TEXTURE_RED_SIZE, GL_TEXTURE_GREEN_SIZE, GL_TEXTURE_BLUE_SIZE, GL_TEXTURE_ALPHA_SIZE, GL_TEXTURE_DEPTH_SIZE, GL_TEXTURE_STENCIL_SIZE };
+            for (auto query : componentQueries)
+            {
+                GLint componentBits = 0;
+                glGetTexLevelParameteriv(levelTarget, level, query, &componentBits);
+                bits += componentBits;
+            }
+
+            size += static_cast<std::size_t>(width) * glm::max(height, 1) * glm::max(depth, 1) * ((bits + 7) / 8);
+        }
+    }
+
+    GLSTATE.BindTexture(target, prevTexture);
+
+    return size;
+}
+
+
+/*
+
+Buffer Utilities
+
+*/
+
+//--------------------------------------------------------------------------------------
+const VertexAttribInfo& VertexArrayBase::GetAttribInfoFromLoc(AttribLoc loc) const
+{
+    auto val = mAttribInfos.find(loc);
+    if (val == mAttribInfos.end())
+        GLUF_NON_CRITICAL_EXCEPTION(std::invalid_argument("\"loc\" not found in attribute list"));
+
+    return val->second;
+}
+
+//--------------------------------------------------------------------------------------
+VertexArrayBase::VertexArrayBase(GLenum PrimType, GLenum buffUsage, bool index) : mUsageType(buffUsage), mPrimitiveType(PrimType)
+{
+    SWITCH_GL_VERSION
+    GL_VERSION_GREATER_EQUAL(30)
+    {
+        glGenVertexArrays(1, &mVertexArrayId);
+
+        if (mVertexArrayId == 0)
+            GLUF_CRITICAL_EXCEPTION(MakeVOAException());
+
+        GLSTATE.BindVertexArray(mVertexArrayId);
+
+    }
+
+    if (index)
+    {
+        glGenBuffers(1, &mIndexBuffer);
+        if (mIndexBuffer == 0)
+        {
+            GLUF_ERROR("Failed to create index buffer!");
+            GLUF_CRITICAL_EXCEPTION(MakeBufferException());
+        }
+
+        GLSTATE.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+
+    }
+}
+
+//--------------------------------------------------------------------------------------
+VertexArrayBase::~VertexArrayBase() noexcept
+{
+    //no need to bind; deleting a bound vertex array reverts to the default one
+    GLSTATE.DeleteBuffers(1, &mIndexBuffer);
+
+    SWITCH_GL_VERSION
+    GL_VERSION_GREATER_EQUAL(30)
+        GLSTATE.DeleteVertexArrays(1, &mVertexArrayId);
+}
+
+//--------------------------------------------------------------------------------------
+VertexArrayBase::VertexArrayBase(VertexArrayBase&& other)
+{
+    //set this class
+    mVertexArrayId      = other.mVertexArrayId;
+    mVertexCount        = other.mVertexCount;
+    mUsageType          = other.mUsageType;
+    mPrimitiveType      = other.mPrimitiveType;
+    mAttribInfos        = std::move(other.mAttribInfos);
+    mIndexBuffer        = other.mIndexBuffer;
+    mIndexCount         = other.mIndexCount;
+    mTempVAOId          = other.mTempVAOId;//likely will be 0 anyways
+
+
+    //reset other class
+    other.mVertexArrayId        = 0;
+    other.mVertexCount          = 0;
+    other.mUsageType            = GL_STATIC_DRAW;
+    other.mPrimitiveType        = GL_TRIANGLES;
+    //other.mAttribInfos.clear();
+    other.mIndexBuffer          = 0;
+    other.mIndexCount           = 0;
+    other.mTempVAOId            = 0;//likely will be 0 anyways
+}
+
+//--------------------------------------------------------------------------------------
+VertexArrayBase& VertexArrayBase::operator=(VertexArrayBase&& other)
+{
+    //set this class
+    mVertexArrayId = other.mVertexArrayId;
+    mVertexCount = other.mVertexCount;
+    mUsageType = other.mUsageType;
+    mPrimitiveType = other.mPrimitiveType;
+    mAttribInfos = std::move(other.mAttribInfos);
+    mIndexBuffer = other.mIndexBuffer;
+    mIndexCount = other.mIndexCount;
+    mTempVAOId = other.mTempVAOId;//likely will be 0 anyways
+
+
+    //reset other class
+    other.mVertexArrayId = 0;
+    other.mVertexCount = 0;
+    other.mUsageType = GL_STATIC_DRAW;
+    other.mPrimitiveType = GL_TRIANGLES;
+    //other.mAttribInfos.clear();
+    other.mIndexBuffer = 0;
+    other.mIndexCount = 0;
+    other.mTempVAOId = 0;//likely will be 0 anyways
+
+    return *this;
+}
+
+//--------------------------------------------------------------------------------------
+void VertexArrayBase::AddVertexAttrib(const VertexAttribInfo& info)
+{
+    //don't do null checks, because BindVertexArray already does them for us
+    BindVertexArray();
+
+    //make sure the attribute contains valid data
+    if (info.mBytesPerElement == 0 || info.mElementsPerValue == 0)
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("Invalid Data in Vertex Attribute Info!"));
+
+    mAttribInfos.insert(std::pair<AttribLoc, VertexAttribInfo>(info.mVertexAttribLocation, info));
+
+    //this is a bit inefficient to refresh every time an attribute is added, but this should not be significant
+    RefreshDataBufferAttribute();
+
+    //enable the new attribute
+    glEnableVertexAttribArray(info.mVertexAttribLocation);
+
+    UnBindVertexArray();
+}
+
+//--------------------------------------------------------------------------------------
+void VertexArrayBase::RemoveVertexAttrib(AttribLoc loc)
+{
+    auto val = mAttribInfos.find(loc);
+    if (val == mAttribInfos.end())
+        GLUF_NON_CRITICAL_EXCEPTION(std::invalid_argument("\"loc\" not found in attribute list"));
+
+    mAttribInfos.erase(val);
+
+    RefreshDataBufferAttribute();
+}
+
+//--------------------------------------------------------------------------------------
+void VertexArrayBase::BindVertexArray() noexcept
+{
+    SWITCH_GL_VERSION
+    GL_VERSION_GREATER_EQUAL(30)
+    {
+        //store the old one before binding this one; this is only a query the first time
+        mTempVAOId = GLSTATE.GetVertexArray();
+
+        GLSTATE.BindVertexArray(mVertexArrayId);
+    }
+}
+
+//--------------------------------------------------------------------------------------
+void VertexArrayBase::UnBindVertexArray() noexcept
+{    
+    SWITCH_GL_VERSION
+    GL_VERSION_GREATER_EQUAL(30)
+    {
+        GLSTATE.BindVertexArray(mTempVAOId);
+        mTempVAOId = 0;
+    }
+}
+
+//--------------------------------------------------------------------------------------
+void VertexArrayBase::Draw() noexcept
+{
+    GLUF_GPU_DRAW_PASS("VertexArray::Draw");
+
+    BindVertexArray();
+
+    SWITCH_GL_VERSION
+    GL_VERSION_LESS(30)
+    {
+        EnableVertexAttributes();//must disable and re-enable every time with openGL less than 3.0
+    }
+
+    if (mIndexBuffer != 0)
+    {
+        //the index buffer is part of the vertex array state after 3.0
+        SWITCH_GL_VERSION
+        GL_VERSION_LESS(30)
+            GLSTATE.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+
+        glDrawElements(mPrimitiveType, mIndexCount, GL_UNSIGNED_INT, nullptr);
+    }
+    else
+    {
+        glDrawArrays(mPrimitiveType, 0, mVertexCount);
+    }
+
+    SWITCH_GL_VERSION
+    GL_VERSION_LESS(30)
+    {
+        DisableVertexAttributes();
+    }
+
+    //the vertex array stays bound, so drawing it again does not rebind it
+}
+
+//--------------------------------------------------------------------------------------
+void VertexArrayBase::DrawRange(GLuint start, GLuint count) noexcept
+{
+    GLUF_GPU_DRAW_PASS("VertexArray::DrawRange");
+
+    BindVertexArray();
+
+    SWITCH_GL_VERSION
+    GL_VERSION_LESS(30)
+    {
+        EnableVertexAttributes();//must disable and re-enable every time with openGL less than 3.0
+    }
+
+    if (mIndexBuffer != 0)
+    {
+        //the index buffer is part of the vertex array state after 3.0
+        SWITCH_GL_VERSION
+        GL_VERSION_LESS(30)
+            GLSTATE.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+
+        glDrawElements(mPrimitiveType, count, GL_UNSIGNED_INT, static_cast<GLuint*>(nullptr) + start);
+    }
+    else
+    {
+        glDrawArrays(mPrimitiveType, (start < 0 || start > mVertexCount) ? 0 : start, (count > mVertexCount) ? mVertexCount : count);
+    }
+
+    SWITCH_GL_VERSION
+    GL_VERSION_LESS(30)
+    {
+        DisableVertexAttributes();
+    }
+
+    //the vertex array stays bound, so drawing it again does not rebind it
+}
+
+//--------------------------------------------------------------------------------------
+void VertexArrayBase::DrawInstanced(GLuint instances) noexcept
+{
+    GLUF_GPU_DRAW_PASS("VertexArray::DrawInstanced");
+
+    BindVertexArray();
+
+    SWITCH_GL_VERSION
+    GL_VERSION_LESS(30)
+    {
+        EnableVertexAttributes();//must disable and re-enable every time with openGL less than 3.0
+    }
+
+    if (mIndexBuffer != 0)
+    {
+        //the index buffer is part of the vertex array state after 3.0
+        SWITCH_GL_VERSION
+        GL_VERSION_LESS(30)
+            GLSTATE.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+
+        glDrawElementsInstanced(mPrimitiveType, mIndexCount, GL_UNSIGNED_INT, nullptr, instances);
+    }
+    else
+    {
+        glDrawArraysInstanced(mPrimitiveType, 0, mVertexCount, instances);
+    }
+
+    SWITCH_GL_VERSION
+    GL_VERSION_LESS(30)
+    {
+        DisableVertexAttributes();
+    }
+
+    //the vertex array stays bound, so drawing it again does not rebind it
+}
+
+//--------------------------------------------------------------------------------------
+std::size_t VertexArrayBase::GetBufferMemorySize() const noexcept
+{
+    return static_cast<std::size_t>(mIndexCount) * sizeof(GLuint);
+}
+
+//helper function
+//--------------------------------------------------------------------------------------
+void VertexArrayBase::BufferIndicesBase(GLuint indexCount, const GLvoid* data) noexcept
+{
+    BindVertexArray();
+    mIndexCount = indexCount;
+    GLSTATE.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * mIndexCount, data, mUsageType);
+
+    UnBindVertexArray();
+}
+
+//--------------------------------------------------------------------------------------
+void VertexArrayBase::BufferIndices(const std::vector<GLuint>& indices) noexcept
+{
+    BufferIndicesBase(indices.size(), &indices[0]);
+}
+
+//--------------------------------------------------------------------------------------
+void VertexArrayBase::BufferIndices(const std::vector<glm::u32vec2>& indices) noexcept
+{
+    BufferIndicesBase(indices.size() * 2, &indices[0]);
+}
+
+//--------------------------------------------------------------------------------------
+void VertexArrayBase::BufferIndices(const std::vector<glm::u32vec3>& indices) noexcept
+{
+    BufferIndicesBase(indices.size() * 3, &indices[0]);
+}
+
+//--------------------------------------------------------------------------------------
+void VertexArrayBase::BufferIndices(const std::vector<glm::u32vec4>& indices) noexcept
+{
+    BufferIndicesBase(indices.size() * 4, &indices[0]);
+}
+
+//--------------------------------------------------------------------------------------
+/*void VertexArrayBase::EnableVertexAttribute(AttribLoc loc)
+{
+    auto it = mDisabledAttribInfos.find(loc);
+    if (it == mDisabledAttribInfos.end())
+        return;
+
+    mAttribInfos[loc] = it->second;
+
+    mDisabledAttribInfos.erase(it);
+}
+
+//--------------------------------------------------------------------------------------
+void VertexArrayBase::DisableVertexAttribute(AttribLoc loc)
+{
+    auto it = mAttribInfos.find(loc);
+    if (it == mAttribInfos.end())
+        return;
+
+    mDisabledAttribInfos[loc] = it->second;
+
+    mAttribInfos.erase(it);
+}*/
+
+
+
+/*
+RoundNearestMultiple
+
+    Parameters:
+        'num': Number to round
+        'multiple': which multiple to round to
+
+    Throws:
+        'std::invalid_argument' if multiple == 0
+       
+    Note:
+        This always rounds up to the next multiple
+        Usage is to make sure memory is within certain boundaries (i.e. 4 byte boundaries)
+
+*/
+//--------------------------------------------------------------------------------------
+int RoundNearestMultiple(unsigned int num, unsigned int multiple)
+{
+    if (multiple == 0)
+    {
+        GLUF_NON_CRITICAL_EXCEPTION(std::invalid_argument("Multiple Cannot Be 0"));
+        return 0;//if the multiple is 0, still needs to return something in release mode
+    }
+
+    unsigned int nearestMultiple = 0;
+
+    //loop up to the 
+    for (unsigned int i = 0; i < num; i += multiple)
+    {
+        nearestMultiple = i;
+    }
+
+    nearestMultiple += multiple;
+    return nearestMultiple;
+}
+
+//--------------------------------------------------------------------------------------
+void VertexArrayAoS::RefreshDataBufferAttribute() noexcept
+{
+    SWITCH_GL_VERSION
+    GL_VERSION_GREATER_EQUAL(30)//this is done at draw time in opengl less than 3.0
+    {
+
+        BindVertexArray();
+
+        GLSTATE.BindBuffer(GL_ARRAY_BUFFER, mDataBuffer);
+
+        GLuint stride = GetVertexSize();
+        for (auto it : mAttribInfos)
+        {
+            //the last parameter might be wrong
+            glVertexAttribPointer(it.second.mVertexAttribLocation, it.second.mElementsPerValue, it.second.mType, GL_FALSE, stride, reinterpret_cast<GLvoid*>(static_cast<uintptr_t>(it.second.mOffset)));
+        }
+
+        UnBindVertexArray();
+    }
+}
+
+//--------------------------------------------------------------------------------------
+VertexArrayAoS::VertexArrayAoS(GLenum PrimType, GLenum buffUsage, bool indexed) : VertexArrayBase(PrimType, buffUsage, indexed)
+{
+    //the VAO is already bound
+
+    glGenBuffers(1, &mDataBuffer);
+    glGenBuffers(1, &mCopyBuffer);
+
+    if (mDataBuffer == 0 || mCopyBuffer == 0)
+        GLUF_CRITICAL_EXCEPTION(MakeBufferException());
+}
+
+//--------------------------------------------------------------------------------------
+VertexArrayAoS::~VertexArrayAoS() noexcept
+{
+    BindVertexArray();
+
+    GLSTATE.DeleteBuffers(1, &mDataBuffer);
+
+    UnBindVertexArray();
+}
+
+//--------------------------------------------------------------------------------------
+VertexArrayAoS::VertexArrayAoS(VertexArrayAoS&& other) : VertexArrayBase(std::move(other))
+{
+    mDataBuffer = other.mDataBuffer;
+
+    other.mDataBuffer = 0;
+}
+
+//--------------------------------------------------------------------------------------
+VertexArrayAoS& VertexArrayAoS::operator=(VertexArrayAoS&& other)
+{
+    //since there is no possibility for user error, not catching dynamic cast here is A-OK
+
+    VertexArrayBase* thisParentPtr = dynamic_cast<VertexArrayBase*>(this);
+    *thisParentPtr = std::move(other);
+
+    mDataBuffer = other.mDataBuffer;
+    other.mDataBuffer = 0;
+
+    return *this;
+}
+
+//--------------------------------------------------------------------------------------
+void VertexArrayAoS::BufferData(const MemorySpan& data)
+{
+    GLuint vertexSize = GetVertexSize();
+    if (vertexSize == 0 || data.size() % vertexSize != 0)
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(VertexArrayAoS::BufferData): data size is not a multiple of the vertex size"));
+
+    BindVertexArray();
+    GLSTATE.BindBuffer(GL_ARRAY_BUFFER, mDataBuffer);
+
+    glBufferData(GL_ARRAY_BUFFER, data.size(), data.empty() ? nullptr : data.data(), mUsageType);
+
+    mVertexCount = static_cast<GLuint>(data.size() / vertexSize);
+
+    UnBindVertexArray();
+}
+
+//--------------------------------------------------------------------------------------
+std::size_t VertexArrayAoS::GetBufferMemorySize() const noexcept
+{
+    return VertexArrayBase::GetBufferMemorySize() + static_cast<std::size_t>(mVertexCount) * GetVertexSize();
+}
+
+//--------------------------------------------------------------------------------------
+GLuint VertexArrayAoS::GetVertexSize() const noexcept
+{
+    GLuint stride = 0;
+    //WOW: this before was allocating memory to find the size of the memory, then didn't even delete it
+    for (auto it : mAttribInfos)
+    {
+        //round to the 4 bytes bounderies
+        stride += it.second.mElementsPerValue * RoundNearestMultiple(it.second.mBytesPerElement, 4);
+    }
+
+    return stride;
+}
+
+//--------------------------------------------------------------------------------------
+void VertexArrayAoS::AddVertexAttrib(const VertexAttribInfo& info)
+{
+    //don't do null checks, because BindVertexArray already does them for us
+    BindVertexArray();
+
+    //make sure the attribute contains valid data
+    if (info.mBytesPerElement == 0 || info.mElementsPerValue == 0)
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("Invalid Data in Vertex Attribute Info!"));
+    
+    mAttribInfos.insert(std::pair<AttribLoc, VertexAttribInfo>(info.mVertexAttribLocation, info));
+
+    //this is a bit inefficient to refresh every time an attribute is added, but this should not be significant
+    RefreshDataBufferAttribute();
+
+    //enable the new attribute
+    glEnableVertexAttribArray(info.mVertexAttribLocation);//not harmful in opengl less than 3.0
+
+    UnBindVertexArray();
+}
+
+//--------------------------------------------------------------------------------------
+void VertexArrayAoS::AddVertexAttrib(const VertexAttribInfo& info, GLuint offset)
+{
+    //don't do null checks, because BindVertexArray already does them for us
+    BindVertexArray();
+
+    //make sure the attribute contains valid data
+    if (info.mBytesPerElement == 0 || info.mElementsPerValue == 0)
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("Invalid Data in Vertex Attribute Info!"));
+
+    //insert the offset into the data
+    VertexAttribInfo tmpCopy = info;
+    tmpCopy.mOffset = offset;
+
+    mAttribInfos.insert(std::pair<AttribLoc, VertexAttribInfo>(info.mVertexAttribLocation, tmpCopy));
+
+    //this is a bit inefficient to refresh every time an attribute is added, but this should not be significant
+    RefreshDataBufferAttribute();
+
+    //enable the new attribute
+    glEnableVertexAttribArray(info.mVertexAttribLocation);//not harmful in opengl less than 3.0
+
+    UnBindVertexArray();
+}
+
+//--------------------------------------------------------------------------------------
+void VertexArrayAoS::ResizeBuffer(GLsizei numVertices, bool keepOldData, GLsizei newOldDataOffset)
+{
+    //if we are keeping the old data, move it into a new buffer
+    GLsizei vertSize = GetVertexSize();
+    GLsizei newTotalSize = vertSize * numVertices;
+    if (keepOldData)
+    {
+        GLsizei totalSize = vertSize * mVertexCount;
+        GLsizei newOldDataTotalOffset = vertSize * newOldDataOffset;
+
+        GLSTATE.BindBuffer(GL_COPY_READ_BUFFER, mDataBuffer);
+        GLSTATE.BindBuffer(GL_COPY_WRITE_BUFFER, mCopyBuffer);
+        
+        //resize the copy buffer
+        glBufferData(GL_COPY_WRITE_BUFFER, totalSize, nullptr, GL_STREAM_COPY);
+
+        //copy the data
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, totalSize);
+
+        //change binding
+        GLSTATE.BindBuffer(GL_COPY_READ_BUFFER, mCopyBuffer);
+        GLSTATE.BindBuffer(GL_COPY_WRITE_BUFFER, mDataBuffer);
+
+        //resize the data buffer
+        glBufferData(GL_COPY_WRITE_BUFFER, newTotalSize, nullptr, GL_STREAM_COPY);
+
+        //copy the data back
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, newOldDataTotalOffset, totalSize);
+    }
+    else
+    {
+        GLSTATE.BindBuffer(GL_ARRAY_BUFFER, mDataBuffer);
+        glBufferData(GL_ARRAY_BUFFER, newTotalSize, nullptr, GL_STREAM_DRAW);
+    }
+
+    mVertexCount = numVertices;
+}
+
+//--------------------------------------------------------------------------------------
+void VertexArrayAoS::EnableVertexAttributes() const noexcept
+{
+    GLSTATE.BindBuffer(GL_ARRAY_BUFFER, mDataBuffer);
+
+    GLuint stride = GetVertexSize();
+    for (auto it : mAttribInfos)
+    {
+        glEnableVertexAttribArray(it.second.mVertexAttribLocation);
+        glVertexAttribPointer(it.second.mVertexAttribLocation, it.second.mElementsPerValue, it.second.mType, GL_FALSE, stride, reinterpret_cast<const GLvoid*>(it.second.mOffset));
+    }
+
+}
+
+//--------------------------------------------------------------------------------------
+void VertexArrayAoS::DisableVertexAttributes() const noexcept
+{
+    GLSTATE.BindBuffer(GL_ARRAY_BUFFER, mDataBuffer);
+
+    for(auto it : mAttribInfos)
+    {
+        glDisableVertexAttribArray(it.second.mVertexAttribLocation);
+    }
+}
+
+
+
+//--------------------------------------------------------------------------------------
+void VertexArraySoA::RefreshDataBufferAttribute() noexcept
+{
+    //this is done at draw time less than opengl 3.0
+    SWITCH_GL_VERSION
+    GL_VERSION_GREATER_EQUAL(30)
+    {
+        BindVertexArray();
+        for (auto it : mAttribInfos)
+        {
+            GLSTATE.BindBuffer(GL_ARRAY_BUFFER, mDataBuffers[it.second.mVertexAttribLocation]);
+            glVertexAttribPointer(it.second.mVertexAttribLocation, it.second.mElementsPerValue, it.second.mType, GL_FALSE, 0, nullptr);
+        }
+        UnBindVertexArray();
+    }
+}
+
+//--------------------------------------------------------------------------------------
+std::size_t VertexArraySoA::GetBufferMemorySize() const noexcept
+{
+    std::size_t size = VertexArrayBase::GetBufferMemorySize();
+    for (auto it : mAttribInfos)
+    {
+        size += static_cast<std::size_t>(mVertexCount) * it.second.mBytesPerElement * it.second.mElementsPerValue;
+    }
+
+    return size;
+}
+
+//--------------------------------------------------------------------------------------
+GLuint VertexArraySoA::GetBufferIdFromAttribLoc(AttribLoc loc) const
+{
+    auto ret = mDataBuffers.find(loc);
+    if (ret == mDataBuffers.end())
+        GLUF_CRITICAL_EXCEPTION(InvalidAttrubuteLocationException());
+
+    return ret->second;
+}
+
+//--------------------------------------------------------------------------------------
+VertexArraySoA::VertexArraySoA(GLenum PrimType, GLenum buffUsage, bool indexed) : VertexArrayBase(PrimType, buffUsage, indexed)
+{
+}
+
+//--------------------------------------------------------------------------------------
+VertexArraySoA::~VertexArraySoA() noexcept
+{
+    BindVertexArray();
+    for (auto it : mDataBuffers)
+        GLSTATE.DeleteBuffers(1, &it.second);
+    UnBindVertexArray();
+}
+
+//--------------------------------------------------------------------------------------
+VertexArraySoA::VertexArraySoA(VertexArraySoA&& other) : VertexArrayBase(std::move(other))
+{
+    mDataBuffers = std::move(other.mDataBuffers);
+}
+
+//--------------------------------------------------------------------------------------
+VertexArraySoA& VertexArraySoA::operator=(VertexArraySoA&& other)
+{
+    //since there is no possibility for user error, not catching dynamic cast here is A-OK
+
+    VertexArrayBase* thisParentPtr = dynamic_cast<VertexArrayBase*>(this);
+    *thisParentPtr = std::move(other);
+
+    mDataBuffers = std::move(other.mDataBuffers);
+
+    return *this;
+}
+
+//--------------------------------------------------------------------------------------
+void VertexArraySoA::GetBarebonesMesh(MeshBarebones& inData)
+{
+    BindVertexArray();
+
+    std::map<AttribLoc, GLuint>::iterator it = mDataBuffers.find(GLUF_VERTEX_ATTRIB_POSITION);
+    if (mIndexBuffer == 0 || it == mDataBuffers.end())
+    {
+        GLUF_CRITICAL_EXCEPTION(InvalidAttrubuteLocationException());
+    }
+    
+    GLSTATE.BindBuffer(GL_ARRAY_BUFFER, it->second);
+    glm::vec3* pVerts = (glm::vec3*)glMapBuffer(GL_ARRAY_BUFFER, GL_READ_ONLY);
+
+    inData.mVertices = ArrToVec(pVerts, mVertexCount);
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+
+
+    GLSTATE.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+    GLuint* pIndices = (GLuint*)glMapBuffer(GL_ELEMENT_ARRAY_BUFFER, GL_READ_ONLY);
+
+    inData.mIndices = ArrToVec(pIndices, mIndexCount);
+    glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+
+    UnBindVertexArray();
+}
+
+//--------------------------------------------------------------------------------------
+void VertexArraySoA::AddVertexAttrib(const VertexAttribInfo& info) noexcept
+{
+    BindVertexArray();
+
+    mAttribInfos.insert(std::pair<AttribLoc, VertexAttribInfo>(info.mVertexAttribLocation, info));
+
+    GLuint newBuff = 0;
+    glGenBuffers(1, &newBuff);
+    mDataBuffers.insert(std::pair<AttribLoc, GLuint>(info.mVertexAttribLocation, newBuff));
+    
+    RefreshDataBufferAttribute();
+
+    UnBindVertexArray();
+}
+
+//--------------------------------------------------------------------------------------
+void VertexArraySoA::RemoveVertexAttrib(AttribLoc loc) noexcept
+{
+    BindVertexArray();
+
+    auto it = mDataBuffers.find(loc);
+
+    GLSTATE.DeleteBuffers(1, &(it->second));
+    mDataBuffers.erase(it);
+
+    VertexArrayBase::RemoveVertexAttrib(loc);
+
+    UnBindVertexArray();
+}
+
+//--------------------------------------------------------------------------------------
+void VertexArraySoA::EnableVertexAttributes() const noexcept
+{
+    auto it = mDataBuffers.begin();
+    for (auto itAttrib : mAttribInfos)
+    {
+        GLSTATE.BindBuffer(GL_ARRAY_BUFFER, it->second);
+        glEnableVertexAttribArray(itAttrib.second.mVertexAttribLocation);
+        glVertexAttribPointer(itAttrib.second.mVertexAttribLocation, itAttrib.second.mElementsPerValue, itAttrib.second.mType, GL_FALSE, 0, nullptr);
+        ++it;
+    }
+}
+
+//--------------------------------------------------------------------------------------
+void VertexArraySoA::DisableVertexAttributes() const noexcept
+{
+    for (auto it : mAttribInfos)
+    {
+        glDisableVertexAttribArray(it.second.mVertexAttribLocation);
+    }
+}
+
+
+
+/*
+=======================================================================================================================================================================================================
+Uniform Buffers
+
+*/
+
+//--------------------------------------------------------------------------------------
+UniformStreamBuffer::UniformStreamBuffer() noexcept
+{
+}
+
+//--------------------------------------------------------------------------------------
+UniformStreamBuffer::~UniformStreamBuffer() noexcept
+{
+    Destroy();
+}
+
+//--------------------------------------------------------------------------------------
+void UniformStreamBuffer::Init(GLsizeiptr frameSize, bool allowPersistent)
+{
+    Destroy();
+
+    if (gGLVersion2Digit < 31 && !gExtensions.HasExtension("GL_ARB_uniform_buffer_object"))
+    {
+        GLUF_ERROR("(UniformStreamBuffer): Uniform Buffers Require OpenGL 3.1 or GL_ARB_uniform_buffer_object");
+        GLUF_CRITICAL_EXCEPTION(MakeBufferException());
+    }
+
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    mAlignment = std::max(alignment, 1);
+
+    //every region has to start on an aligned offset too
+    mFrameSize = (std::max<GLsizeiptr>(frameSize, 1) + mAlignment - 1) / mAlignment * mAlignment;
+
+    mPersistent = allowPersistent && glBufferStorage != nullptr &&
+        (gGLVersion2Digit >= 44 || gExtensions.HasExtension("GL_ARB_buffer_storage"));
+
+    glGenBuffers(1, &mBufferId);
+    if (mBufferId == 0)
+        GLUF_CRITICAL_EXCEPTION(MakeBufferException());
+
+    GLSTATE.BindBuffer(GL_UNIFORM_BUFFER, mBufferId);
+    if (mPersistent)
+    {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        GLsizeiptr size = mFrameSize * GLUF_UNIFORM_STREAM_FRAMES;
+
+        glBufferStorage(GL_UNIFORM_BUFFER, size, nullptr, flags);
+        mMapped = static_cast<char*>(glMapBufferRange(GL_UNIFORM_BUFFER, 0, size, flags));
+        if (mMapped == nullptr)
+        {
+            Destroy();
+            GLUF_CRITICAL_EXCEPTION(MakeBufferException());
+        }
+    }
+    else
+    {
+        glBufferData(GL_UNIFORM_BUFFER, mFrameSize, nullptr, GL_STREAM_DRAW);
+        mStaging.resize(static_cast<std::size_t>(mFrameSize));
+    }
+    GLSTATE.BindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+//--------------------------------------------------------------------------------------
+void UniformStreamBuffer::Destroy() noexcept
+{
+    for (auto& it : mFences)
+    {
+        if (it != nullptr)
+            glDeleteSync(it);
+        it = nullptr;
+    }
+
+    if (mBufferId != 0)
+    {
+        if (mMapped != nullptr)
+        {
+            GLSTATE.BindBuffer(GL_UNIFORM_BUFFER, mBufferId);
+            glUnmapBuffer(GL_UNIFORM_BUFFER);
+            GLSTATE.BindBuffer(GL_UNIFORM_BUFFER, 0);
+        }
+        GLSTATE.DeleteBuffers(1, &mBufferId);
+    }
+
+    mBufferId = 0;
+    mPersistent = false;
+    mFrameSize = 0;
+    mFrame = 0;
+    mHead = 0;
+    mFlushed = 0;
+    mMapped = nullptr;
+    mStaging.clear();
+    mStaging.shrink_to_fit();
+}
+
+//--------------------------------------------------------------------------------------
+UniformStreamAllocation UniformStreamBuffer::Allocate(GLsizeiptr size)
+{
+    GLsizeiptr offset = (mHead + mAlignment - 1) / mAlignment * mAlignment;
+    if (mBufferId == 0 || size <= 0 || offset + size > mFrameSize)
+    {
+        GLUF_ERROR_LONG("(UniformStreamBuffer): Out of Space; " << size << " Bytes Requested With " << mFrameSize - mHead << " Left This Frame");
+        GLUF_CRITICAL_EXCEPTION(std::length_error("Uniform Stream Buffer Full"));
+    }
+
+    UniformStreamAllocation ret;
+    ret.mSize = size;
+    if (mPersistent)
+    {
+        ret.mOffset = mFrame * mFrameSize + offset;
+        ret.mData = mMapped + ret.mOffset;
+    }
+    else
+    {
+        ret.mOffset = offset;
+        ret.mData = mStaging.data() + offset;
+    }
+
+    ++mStats.mAllocations;
+    mStats.mAllocatedBytes += static_cast<unsigned long long>(offset + size - mHead);
+    mHead = offset + size;
+
+    return ret;
+}
+
+//--------------------------------------------------------------------------------------
+void UniformStreamBuffer::Flush()
+{
+    if (mPersistent || mHead <= mFlushed)
+        return;
+
+    GLSTATE.BindBuffer(GL_UNIFORM_BUFFER, mBufferId);
+    glBufferSubData(GL_UNIFORM_BUFFER, mFlushed, mHead - mFlushed, mStaging.data() + mFlushed);
+    GLSTATE.BindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    ++mStats.mUploads;
+    mFlushed = mHead;
+}
+
+//--------------------------------------------------------------------------------------
+void UniformStreamBuffer::Bind(const UniformStreamAllocation& allocation, GLuint binding)
+{
+    //the data has to be in the buffer before anything draws with it
+    if (!mPersistent && allocation.mOffset + allocation.mSize > mFlushed)
+        Flush();
+
+    GLSTATE.BindBufferRange(GL_UNIFORM_BUFFER, binding, mBufferId, allocation.mOffset, allocation.mSize);
+}
+
+//--------------------------------------------------------------------------------------
+void UniformStreamBuffer::EndFrame()
+{
+    if (mBufferId == 0)
+        return;
+
+    if (!mPersistent)
+    {
+        //orphan the storage, so the next frame's upload does not wait on draws still reading this one
+        if (mHead > 0)
+        {
+            GLSTATE.BindBuffer(GL_UNIFORM_BUFFER, mBufferId);
+            glBufferData(GL_UNIFORM_BUFFER, mFrameSize, nullptr, GL_STREAM_DRAW);
+            GLSTATE.BindBuffer(GL_UNIFORM_BUFFER, 0);
+        }
+        mHead = 0;
+        mFlushed = 0;
+        return;
+    }
+
+    mFences[mFrame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    mFrame = (mFrame + 1) % GLUF_UNIFORM_STREAM_FRAMES;
+    mHead = 0;
+
+    GLsync& fence = mFences[mFrame];
+    if (fence == nullptr)
+        return;
+
+    GLenum result = glClientWaitSync(fence, 0, 0);
+    if (result == GL_TIMEOUT_EXPIRED)
+    {
+        ++mStats.mFenceWaits;
+
+        //one second at a time, so a lost context can not hang here forever
+        do
+        {
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+        } while (result == GL_TIMEOUT_EXPIRED);
+    }
+
+    if (result == GL_WAIT_FAILED)
+        GLUF_ERROR("(UniformStreamBuffer): Waiting on a Frame Fence Failed");
+
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+//--------------------------------------------------------------------------------------
+void UniformBlock::Attach(const ProgramPtr& program)
+{
+    GLUF_NULLPTR_CHECK(program);
+
+    const UniformBlockMap& blocks = SHADERMANAGER.GetUniformBlocks(program);
+    auto it = blocks.find(mName);
+    if (it == blocks.end())
+    {
+        GLUF_ERROR_LONG("(UniformBlock): Program Has No Active Uniform Block \"" << mName << "\"");
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("Uniform Block Not Found"));
+    }
+
+    if (mDataSize != 0 && it->second.mDataSize != mDataSize)
+    {
+        GLUF_ERROR_LONG("(UniformBlock): \"" << mName << "\" Is " << it->second.mDataSize << " Bytes in This Program, But " << mDataSize << " in Others");
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("Uniform Block Layout Mismatch"));
+    }
+
+    SHADERMANAGER.SetUniformBlockBinding(program, mName, mBinding);
+    mDataSize = it->second.mDataSize;
+}
+
+//--------------------------------------------------------------------------------------
+UniformStreamAllocation UniformBlock::Write(UniformStreamBuffer& stream, const void* data, std::size_t size) const
+{
+    if (mDataSize != 0 && size > static_cast<std::size_t>(mDataSize))
+    {
+        GLUF_ERROR_LONG("(UniformBlock): " << size << " Bytes Pushed to \"" << mName << "\", Which Only Has " << mDataSize);
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("Uniform Block Data Too Large"));
+    }
+
+    //the block is allocated at its full size, in case the struct leaves off trailing padding
+    GLsizeiptr blockSize = std::max<GLsizeiptr>(mDataSize, static_cast<GLsizeiptr>(size));
+    UniformStreamAllocation allocation = stream.Allocate(blockSize);
+
+    std::memcpy(allocation.mData, data, size);
+    if (static_cast<std::size_t>(blockSize) > size)
+        std::memset(static_cast<char*>(allocation.mData) + size, 0, static_cast<std::size_t>(blockSize) - size);
+
+    return allocation;
+}
+
+//--------------------------------------------------------------------------------------
+void UniformBlock::Bind(UniformStreamBuffer& stream, const UniformStreamAllocation& allocation) const
+{
+    stream.Bind(allocation, mBinding);
+}
+
+//--------------------------------------------------------------------------------------
+UniformStreamAllocation UniformBlock::Push(UniformStreamBuffer& stream, const void* data, std::size_t size) const
+{
+    UniformStreamAllocation allocation = Write(stream, data, size);
+    Bind(stream, allocation);
+    return allocation;
+}
+
+
+
+/*
+=======================================================================================================================================================================================================
+GPU Resource Cache
+
+*/
+
+ResourceCache g_ResourceCache;
+
+//--------------------------------------------------------------------------------------
+TextureResource::~TextureResource()
+{
+    if (mTextureId != 0)
+        GLSTATE.DeleteTextures(1, &mTextureId);
+}
+
+//--------------------------------------------------------------------------------------
+std::shared_ptr<void> ResourceCache::FindEntry(const std::string& key, ResourceType type)
+{
+    auto it = mEntries.find(key);
+    if (it == mEntries.end())
+        return nullptr;
+
+    if (it->second.mType != type)
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("Resource Cache Key \"" + key + "\" Used For Different Resource Types"));
+
+    //move to the front of the LRU list
+    mLRUList.splice(mLRUList.begin(), mLRUList, it->second.mLRUPosition);
+    return it->second.mResource;
+}
+
+//--------------------------------------------------------------------------------------
+std::shared_ptr<void> ResourceCache::InsertEntry(const std::string& key, std::shared_ptr<void> resource, ResourceType type, std::size_t memorySize)
+{
+    //another thread may have loaded the same key while we were loading
+    auto existing = FindEntry(key, type);
+    if (existing)
+        return existing;
+
+    mLRUList.push_front(key);
+    mEntries.insert({ key, CacheEntry{ resource, type, memorySize, mLRUList.begin() } });
+
+    if (type == RT_TEXTURE)
+        mTextureMemory += memorySize;
+    else
+        mBufferMemory += memorySize;
+
+    return resource;
+}
+
+//--------------------------------------------------------------------------------------
+void ResourceCache::EraseEntry(std::unordered_map<std::string, CacheEntry>::iterator it, std::vector<std::shared_ptr<void>>& released)
+{
+    if (it->second.mType == RT_TEXTURE)
+        mTextureMemory -= it->second.mMemorySize;
+    else
+        mBufferMemory -= it->second.mMemorySize;
+
+    //resources are released by the caller after unlocking
+    released.push_back(std::move(it->second.mResource));
+
+    mLRUList.erase(it->second.mLRUPosition);
+    mEntries.erase(it);
+}
+
+//--------------------------------------------------------------------------------------
+void ResourceCache::TrimTo(std::size_t budget, std::vector<std::shared_ptr<void>>& released)
+{
+    auto lruIt = mLRUList.end();
+    while (mTextureMemory + mBufferMemory > budget && lruIt != mLRUList.begin())
+    {
+        --lruIt;
+
+        auto it = mEntries.find(*lruIt);
+
+        //someone outside of the cache is still using this one
+        if (it->second.mResource.use_count() > 1)
+            continue;
+
+        //erasing invalidates 'lruIt', so step back to the already visited neighbor first
+        ++lruIt;
+        EraseEntry(it, released);
+        ++mEvictions;
+    }
+}
+
+//--------------------------------------------------------------------------------------
+TextureResourcePtr ResourceCache::GetTexture(const std::string& filePath, TextureFileFormat format)
+{
+    //a 'TFF_DDS' file may hold a cubemap or an array, so the loader reports the target
+    return LoadTexture(filePath, [&filePath, format](GLenum& target) { return LoadTextureFromFile(filePath, format, &target); });
+}
+
+//--------------------------------------------------------------------------------------
+TextureResourcePtr ResourceCache::GetTexture(const std::string& key, const std::function<GLuint()>& loader, GLenum target)
+{
+    return LoadTexture(key, [&loader, target](GLenum& loadedTarget) { loadedTarget = target; return loader(); });
+}
+
+//--------------------------------------------------------------------------------------
+TextureResourcePtr ResourceCache::LoadTexture(const std::string& key, const std::function<GLuint(GLenum& target)>& loader)
+{
+    {
+        std::lock_guard<std::mutex> lock(mCacheMutex);
+        auto found = FindEntry(key, RT_TEXTURE);
+        if (found)
+        {
+            ++mHits;
+            return std::static_pointer_cast<TextureResource>(found);
+        }
+        ++mMisses;
+    }
+
+    GLuint texture = 0;
+    GLenum target = GL_TEXTURE_2D;
+    try
+    {
+        texture = loader(target);
+    }
+    catch (...)
+    {
+        RETHROW;
+    }
+
+    auto resource = std::make_shared<TextureResource>(texture, target, GetTextureMemorySize(texture, target));
+
+    std::shared_ptr<void> ret;
+    std::vector<std::shared_ptr<void>> released;
+    {
+        std::lock_guard<std::mutex> lock(mCacheMutex);
+        ret = InsertEntry(key, resource, RT_TEXTURE, resource->GetMemorySize());
+        TrimTo(mBudget, released);
+    }
+
+    return std::static_pointer_cast<TextureResource>(ret);
+}
+
+//--------------------------------------------------------------------------------------
+VertexArrayPtr ResourceCache::GetVertexArray(const std::string& key, const std::function<VertexArrayPtr()>& loader)
+{
+    {
+        std::lock_guard<std::mutex> lock(mCacheMutex);
+        auto found = FindEntry(key, RT_BUFFER);
+        if (found)
+        {
+            ++mHits;
+            return std::static_pointer_cast<VertexArray>(found);
+        }
+        ++mMisses;
+    }
+
+    VertexArrayPtr vertexArray;
+    try
+    {
+        vertexArray = loader();
+    }
+    catch (...)
+    {
+        RETHROW;
+    }
+
+    if (!vertexArray)
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("Resource Cache Loader for \"" + key + "\" Returned Nothing"));
+
+    std::shared_ptr<void> ret;
+    std::vector<std::shared_ptr<void>> released;
+    {
+        std::lock_guard<std::mutex> lock(mCacheMutex);
+        ret = InsertEntry(key, vertexArray, RT_BUFFER, vertexArray->GetBufferMemorySize());
+        TrimTo(mBudget, released);
+    }
+
+    return std::static_pointer_cast<VertexArray>(ret);
+}
+
+//--------------------------------------------------------------------------------------
+bool ResourceCache::Contains(const std::string& key) const
+{
+    std::lock_guard<std::mutex> lock(mCacheMutex);
+    return mEntries.find(key) != mEntries.end();
+}
+
+//--------------------------------------------------------------------------------------
+void ResourceCache::Remove(const std::string& key)
+{
+    std::vector<std::shared_ptr<void>> released;
+    {
+        std::lock_guard<std::mutex> lock(mCacheMutex);
+        auto it = mEntries.find(key);
+        if (it != mEntries.end())
+            EraseEntry(it, released);
+    }
+}
+
+//--------------------------------------------------------------------------------------
+void ResourceCache::SetBudget(std::size_t bytes)
+{
+    std::vector<std::shared_ptr<void>> released;
+    {
+        std::lock_guard<std::mutex> lock(mCacheMutex);
+        mBudget = bytes;
+        TrimTo(mBudget, released);
+    }
+}
+
+//--------------------------------------------------------------------------------------
+std::size_t ResourceCache::GetBudget() const
+{
+    std::lock_guard<std::mutex> lock(mCacheMutex);
+    return mBudget;
+}
+
+//--------------------------------------------------------------------------------------
+void ResourceCache::Trim()
+{
+    std::vector<std::shared_ptr<void>> released;
+    {
+        std::lock_guard<std::mutex> lock(mCacheMutex);
+        TrimTo(mBudget, released);
+    }
+}
+
+//--------------------------------------------------------------------------------------
+void ResourceCache::Purge()
+{
+    std::vector<std::shared_ptr<void>> released;
+    {
+        std::lock_guard<std::mutex> lock(mCacheMutex);
+        TrimTo(0, released);
+    }
+}
+
+//--------------------------------------------------------------------------------------
+void ResourceCache::Clear()
+{
+    std::vector<std::shared_ptr<void>> released;
+    {
+        std::lock_guard<std::mutex> lock(mCacheMutex);
+        while (!mEntries.empty())
+            EraseEntry(mEntries.begin(), released);
+    }
+}
+
+//--------------------------------------------------------------------------------------
+std::size_t ResourceCache::GetTextureMemory() const
+{
+    std::lock_guard<std::mutex> lock(mCacheMutex);
+    return mTextureMemory;
+}
+
+//--------------------------------------------------------------------------------------
+std::size_t ResourceCache::GetBufferMemory() const
+{
+    std::lock_guard<std::mutex> lock(mCacheMutex);
+    return mBufferMemory;
+}
+
+//--------------------------------------------------------------------------------------
+std::size_t ResourceCache::GetTotalMemory() const
+{
+    std::lock_guard<std::mutex> lock(mCacheMutex);
+    return mTextureMemory + mBufferMemory;
+}
+
+//--------------------------------------------------------------------------------------
+std::size_t ResourceCache::GetEntryCount() const
+{
+    std::lock_guard<std::mutex> lock(mCacheMutex);
+    return mEntries.size();
+}
+
+//--------------------------------------------------------------------------------------
+unsigned long long ResourceCache::GetHitCount() const
+{
+    std::lock_guard<std::mutex> lock(mCacheMutex);
+    return mHits;
+}
+
+//--------------------------------------------------------------------------------------
+unsigned long long ResourceCache::GetMissCount() const
+{
+    std::lock_guard<std::mutex> lock(mCacheMutex);
+    return mMisses;
+}
+
+//--------------------------------------------------------------------------------------
+unsigned long long ResourceCache::GetEvictionCount() const
+{
+    std::lock_guard<std::mutex> lock(mCacheMutex);
+    return mEvictions;
+}
+
+
+
+/*
+=======================================================================================================================================================================================================
+Assimp Utility Functions
+
+*/
+
+//--------------------------------------------------------------------------------------
+std::shared_ptr<VertexArray> LoadVertexArrayFromScene(const aiScene* scene, GLuint meshNum)
+{
+    if (meshNum > scene->mNumMeshes)
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("\"meshNum\" is higher than number of meshes in \"scene\""));
+
+    //const aiMesh* mesh = scene->mMeshes[meshNum];
+
+    std::shared_ptr<VertexArray> arr = LoadVertexArrayFromScene(scene, g_stdAttrib, meshNum);
+
+    /*if (mesh->HasPositions())
+        vertexData->AddVertexAttrib(g_attribPOS);
+    if (mesh->HasNormals())
+        vertexData->AddVertexAttrib(g_attribNORM);
+    if (mesh->HasTextureCoords(0))
+        vertexData->AddVertexAttrib(g_attribUV0);
+    if (mesh->HasTextureCoords(1))
+        vertexData->AddVertexAttrib(g_attribUV1);
+    if (mesh->HasTextureCoords(2))
+        vertexData->AddVertexAttrib(g_attribUV2);
+    if (mesh->HasTextureCoords(3))
+        vertexData->AddVertexAttrib(g_attribUV3);
+    if (mesh->HasTextureCoords(4))
+        vertexData->AddVertexAttrib(g_attribUV4);
+    if (mesh->HasTextureCoords(5))
+        vertexData->AddVertexAttrib(g_attribUV5);
+    if (mesh->HasTextureCoords(6))
+        vertexData->AddVertexAttrib(g_attribUV6);
+    if (mesh->HasTextureCoords(7))
+        vertexData->AddVertexAttrib(g_attribUV7);
+
+    if (mesh->HasVertexColors(0))
+        vertexData->AddVertexAttrib(g_attribCOLOR0);
+    if (mesh->HasVertexColors(1))
+        vertexData->AddVertexAttrib(g_attribCOLOR1);
+    if (mesh->HasVertexColors(2))
+        vertexData->AddVertexAttrib(g_attribCOLOR2);
+    if (mesh->HasVertexColors(3))
+        vertexData->AddVertexAttrib(g_attribCOLOR3);
+    if (mesh->HasVertexColors(4))
+        vertexData->AddVertexAttrib(g_attribCOLOR4);
+    if (mesh->HasVertexColors(5))
+        vertexData->AddVertexAttrib(g_attribCOLOR5);
+    if (mesh->HasVertexColors(6))
+        vertexData->AddVertexAttrib(g_attribCOLOR6);
+    if (mesh->HasVertexColors(7))
+        vertexData->AddVertexAttrib(g_attribCOLOR7);
+    if (mesh->HasTangentsAndBitangents())
+    {
+        vertexData->AddVertexAttrib(g_attribTAN);
+        vertexData->AddVertexAttrib(g_attribBITAN);
+    }
+
+
+    if (mesh->HasPositions())
+    vertexData->BufferData(GLUF_VERTEX_ATTRIB_POSITION, mesh->mNumVertices, mesh->mVertices);
+    if (mesh->HasNormals())
+    vertexData->BufferData(GLUF_VERTEX_ATTRIB_NORMAL, mesh->mNumVertices, mesh->mNormals);
+    if (mesh->HasTextureCoords(0))
+    vertexData->BufferData(GLUF_VERTEX_ATTRIB_UV0, mesh->mNumVertices, AssimpToGlm3_2(mesh->mTextureCoords[0], mesh->mNumVertices));
+    if (mesh->HasTextureCoords(1))
+    vertexData->BufferData(GLUF_VERTEX_ATTRIB_UV1, mesh->mNumVertices, AssimpToGlm3_2(mesh->mTextureCoords[1], mesh->mNumVertices));
+    if (mesh->HasTextureCoords(2))
+    vertexData->BufferData(GLUF_VERTEX_ATTRIB_UV2, mesh->mNumVertices, AssimpToGlm3_2(mesh->mTextureCoords[2], mesh->mNumVertices));
+    if (mesh->HasTextureCoords(3))
+    vertexData->BufferData(GLUF_VERTEX_ATTRIB_UV3, mesh->mNumVertices, AssimpToGlm3_2(mesh->mTextureCoords[3], mesh->mNumVertices));
+    if (mesh->HasTextureCoords(4))
+    vertexData->BufferData(GLUF_VERTEX_ATTRIB_UV4, mesh->mNumVertices, AssimpToGlm3_2(mesh->mTextureCoords[4], mesh->mNumVertices));
+    if (mesh->HasTextureCoords(5))
+    vertexData->BufferData(GLUF_VERTEX_ATTRIB_UV5, mesh->mNumVertices, AssimpToGlm3_2(mesh->mTextureCoords[5], mesh->mNumVertices));
+    if (mesh->HasTextureCoords(6))
+    vertexData->BufferData(GLUF_VERTEX_ATTRIB_UV6, mesh->mNumVertices, AssimpToGlm3_2(mesh->mTextureCoords[6], mesh->mNumVertices));
+    if (mesh->HasTextureCoords(7))
+    vertexData->BufferData(GLUF_VERTEX_ATTRIB_UV7, mesh->mNumVertices, AssimpToGlm3_2(mesh->mTextureCoords[7], mesh->mNumVertices));
 
-    SWITCH_GL_VERSION
-    GL_VERSION_LESS(30)
+    if (mesh->HasVertexColors(0))
+    vertexData->BufferData(GLUF_VERTEX_ATTRIB_COLOR0, mesh->mNumVertices, mesh->mColors[0]);
+    if (mesh->HasVertexColors(1))
+    vertexData->BufferData(GLUF_VERTEX_ATTRIB_COLOR1, mesh->mNumVertices, mesh->mColors[1]);
+    if (mesh->HasVertexColors(2))
+    vertexData->BufferData(GLUF_VERTEX_ATTRIB_COLOR2, mesh->mNumVertices, mesh->mColors[2]);
+    if (mesh->HasVertexColors(3))
+    vertexData->BufferData(GLUF_VERTEX_ATTRIB_COLOR3, mesh->mNumVertices, mesh->mColors[3]);
+    if (mesh->HasVertexColors(4))
+    vertexData->BufferData(GLUF_VERTEX_ATTRIB_COLOR4, mesh->mNumVertices, mesh->mColors[4]);
+    if (mesh->HasVertexColors(5))
+    vertexData->BufferData(GLUF_VERTEX_ATTRIB_COLOR5, mesh->mNumVertices, mesh->mColors[5]);
+    if (mesh->HasVertexColors(6))
+    vertexData->BufferData(GLUF_VERTEX_ATTRIB_COLOR6, mesh->mNumVertices, mesh->mColors[6]);
+    if (mesh->HasVertexColors(7))
+    vertexData->BufferData(GLUF_VERTEX_ATTRIB_COLOR7, mesh->mNumVertices, mesh->mColors[7]);
+    if (mesh->HasTangentsAndBitangents())
     {
-        EnableVertexAttributes();//must disable and re-enable every time with openGL less than 3.0
+    vertexData->BufferData(GLUF_VERTEX_ATTRIB_BITAN, mesh->mNumVertices, mesh->mBitangents);
+    vertexData->BufferData(GLUF_VERTEX_ATTRIB_TAN, mesh->mNumVertices, mesh->mTangents);
     }
 
-    if (mIndexBuffer != 0)
+    std::vector<GLuint> indices;
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i)
     {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
-        glDrawElements(mPrimitiveType, mIndexCount, GL_UNSIGNED_INT, nullptr);
+    aiFace curr = mesh->mFaces[i];
+    indices.push_back(curr.mIndices[0]);
+    indices.push_back(curr.mIndices[1]);
+    indices.push_back(curr.mIndices[2]);
     }
-    else
+    vertexData->BufferIndices(&indices[0], indices.size());*/
+
+return arr;
+}
+
+/*
+
+AssimpVertexStruct
+
+
+*/
+
+//--------------------------------------------------------------------------------------
+struct AssimpVertexStruct : public VertexStruct
+{
+    std::vector<aiVector2D> v2;
+    std::vector<aiVector3D> v3;
+    std::vector<aiColor4D> v4;
+
+    AssimpVertexStruct(size_t vec2Cnt, size_t vec3Cnt, size_t vec4Cnt)
     {
-        glDrawArrays(mPrimitiveType, 0, mVertexCount);
+        v2.resize(vec2Cnt);
+        v3.resize(vec3Cnt);
+        v4.resize(vec4Cnt);
     }
 
-    SWITCH_GL_VERSION
-    GL_VERSION_LESS(30)
+    AssimpVertexStruct(){};
+
+    virtual char* get_data() const override
     {
-        DisableVertexAttributes();
+        char* ret = new char[size()];
+
+        size_t v2Size = 2 * v2.size() * 4;
+        size_t v3Size = 3 * v3.size() * 4;
+        size_t v4Size = 4 * v4.size() * 4;
+
+        memcpy(ret, v2.data(), v2Size);
+        memcpy(ret + v2Size, v3.data(), v3Size);
+        memcpy(ret + v2Size + v3Size, v4.data(), v4Size);
+
+        return ret;
     }
 
-    UnBindVertexArray();
-}
+    virtual size_t size() const override
+    {
+        return 4 * (2 * v2.size() + 3 * v3.size() + 4 * v4.size());
+    }
+
+    virtual size_t n_elem_size(size_t element)
+    {
+        size_t i = 0;
+        if (element < v2.size())
+            return sizeof(aiVector2D);
+
+        i += v2.size();
+
+        if (element < i + v3.size())
+            return sizeof(aiVector3D);
+
+        i += v3.size();
+
+        if (element < i + v4.size())
+            return sizeof(aiColor4D);
+
+        return 0;//if it is too big, just return 0; not worth an exception
+    }
+
+    virtual void buffer_element(void* data, size_t element) override
+    {
+        size_t i = 0;
+        if (element < v2.size())
+        {
+            v2[element] = static_cast<aiVector2D*>(data)[0];
+            return;
+        }
+
+        i += v2.size();
+
+        if (element < i + v3.size())
+        {
+            v3[element - i] = static_cast<aiVector3D*>(data)[0];
+            return;
+        }
+
+        i += v3.size();
+
+        if (element < i + v4.size())
+        {
+            v4[element - i] = static_cast<aiColor4D*>(data)[0];
+            return;
+        }
+    }
+
+    static GLVector<AssimpVertexStruct> MakeMany(size_t howMany, size_t vec2Cnt, size_t vec3Cnt, size_t vec4Cnt)
+    {
+        GLVector<AssimpVertexStruct> ret;
+        ret.reserve(howMany);
+
+        //the individual struct object that will be cloned to fill the return vector
+        AssimpVertexStruct clone{ vec2Cnt, vec3Cnt, vec4Cnt };
+        
+        //use 'fill' version of vector::insert for increased speed
+        ret.insert(ret.begin(), howMany, clone);
+
+        return ret;
+    }
+};
+
 
 //--------------------------------------------------------------------------------------
-void VertexArrayBase::DrawRange(GLuint start, GLuint count) noexcept
+MeshData ConvertMeshFromScene(const aiScene* scene, const VertexAttribMap& inputs, GLuint meshNum)
 {
-    BindVertexArray();
+    GLUF_PROFILE_ZONE("ConvertMeshFromScene");
 
-    SWITCH_GL_VERSION
-    GL_VERSION_LESS(30)
+    if (meshNum >= scene->mNumMeshes)
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("\"meshNum\" is higher than the number of meshes in \"scene\""));
+
+    const aiMesh* mesh = scene->mMeshes[meshNum];
+
+    MeshData meshData;
+    meshData.mIndexed = mesh->HasFaces();
+
+    //attributes are only recorded here; 'LoadVertexArrayFromMeshData' adds them to the vertex array
+    const auto AddVertexAttrib = [&meshData](const VertexAttribInfo& info, GLuint offset)
+    {
+        VertexAttribInfo tmpCopy = info;
+        tmpCopy.mOffset = offset;
+        meshData.mAttributes.push_back(tmpCopy);
+    };
+
+    //which vertex attributes go where in assimp loading vertex struct
+    std::map<AttribLoc, int> vertexAttribLoc;
+
+    //the number of each vec type
+    unsigned char numVec2 = 0;
+    unsigned char numVec3 = 0;
+    unsigned char numVec4 = 0;
+
+    auto itUV0 = inputs.find(GLUF_VERTEX_ATTRIB_UV0);
+    auto it = itUV0;
+    if (mesh->HasTextureCoords(0) && it != inputs.end())
+    {
+        AddVertexAttrib(it->second, numVec2 * 8);
+        vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV0] = numVec2;
+        ++numVec2;
+    }
+
+    auto itUV1 = inputs.find(GLUF_VERTEX_ATTRIB_UV1);
+    it = itUV1;
+    if (mesh->HasTextureCoords(1) && it != inputs.end())
+    {
+        AddVertexAttrib(it->second, numVec2 * 8);
+        vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV1] = numVec2;
+        ++numVec2;
+    }
+
+    auto itUV2 = inputs.find(GLUF_VERTEX_ATTRIB_UV2);
+    it = itUV2;
+    if (mesh->HasTextureCoords(2) && it != inputs.end())
+    {
+        AddVertexAttrib(it->second, numVec2 * 8);
+        vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV2] = numVec2;
+        ++numVec2;
+    }
+
+    auto itUV3 = inputs.find(GLUF_VERTEX_ATTRIB_UV3);
+    it = itUV3;
+    if (mesh->HasTextureCoords(3) && it != inputs.end())
+    {
+        AddVertexAttrib(it->second, numVec2 * 8);
+        vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV3] = numVec2;
+        ++numVec2;
+    }
+
+    auto itUV4 = inputs.find(GLUF_VERTEX_ATTRIB_UV4);
+    it = itUV4;
+    if (mesh->HasTextureCoords(4) && it != inputs.end())
+    {
+        AddVertexAttrib(it->second, numVec2 * 8);
+        vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV4] = numVec2;
+        ++numVec2;
+    }
+
+    auto itUV5 = inputs.find(GLUF_VERTEX_ATTRIB_UV5);
+    it = itUV5;
+    if (mesh->HasTextureCoords(5) && it != inputs.end())
+    {
+        AddVertexAttrib(it->second, numVec2 * 8);
+        vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV5] = numVec2;
+        ++numVec2;
+    }
+
+    auto itUV6 = inputs.find(GLUF_VERTEX_ATTRIB_UV6);
+    it = itUV6;
+    if (mesh->HasTextureCoords(6) && it != inputs.end())
+    {
+        AddVertexAttrib(it->second, numVec2 * 8);
+        vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV6] = numVec2;
+        ++numVec2;
+    }
+
+    auto itUV7 = inputs.find(GLUF_VERTEX_ATTRIB_UV7);
+    it = itUV7;
+    if (mesh->HasTextureCoords(7) && it != inputs.end())
+    {
+        AddVertexAttrib(it->second, numVec2 * 8);
+        vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV7] = numVec2;
+        ++numVec2;
+    }
+
+
+    unsigned int runningOffsetTotal = numVec2 * 8;
+
+
+    //vec3's go between vec2's and vec4's
+    auto itPos = inputs.find(GLUF_VERTEX_ATTRIB_POSITION);
+    it = itPos;
+    if (mesh->HasPositions() && it != inputs.end())
+    {
+        AddVertexAttrib(it->second, numVec3 * 12 + runningOffsetTotal);
+        vertexAttribLoc[GLUF_VERTEX_ATTRIB_POSITION] = numVec3 + numVec2;
+        ++numVec3;
+    }
+
+    auto itNorm = inputs.find(GLUF_VERTEX_ATTRIB_NORMAL);
+    it = itNorm;
+    if (mesh->HasNormals() && it != inputs.end())
+    {
+        AddVertexAttrib(it->second, numVec3 * 12 + runningOffsetTotal);
+        vertexAttribLoc[GLUF_VERTEX_ATTRIB_NORMAL] = numVec3 + numVec2;
+        ++numVec3;
+    }
+
+
+    auto itTan = inputs.find(GLUF_VERTEX_ATTRIB_TAN);
+    auto itBitan = inputs.find(GLUF_VERTEX_ATTRIB_BITAN);
+    if (mesh->HasTangentsAndBitangents() && itTan != inputs.end() && itBitan != inputs.end())
     {
-        EnableVertexAttributes();//must disable and re-enable every time with openGL less than 3.0
+        AddVertexAttrib(itTan->second, numVec3 * 12 + runningOffsetTotal);
+        AddVertexAttrib(itBitan->second, (numVec3 + 1) * 12 + runningOffsetTotal);
+        vertexAttribLoc[GLUF_VERTEX_ATTRIB_TAN] = numVec3 + numVec2;
+        vertexAttribLoc[GLUF_VERTEX_ATTRIB_BITAN] = numVec3 + 1 + numVec2;
+        numVec3 += 2;
     }
 
-    if (mIndexBuffer != 0)
+    //to keep from doing unncessessary addition
+    unsigned char runningTotal = numVec3 + numVec2;
+
+    runningOffsetTotal += numVec3 * 12;
+
+    auto itCol0 = inputs.find(GLUF_VERTEX_ATTRIB_COLOR0);
+    it = itCol0;
+    if (mesh->HasVertexColors(0) && it != inputs.end())
     {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
-        glDrawElements(mPrimitiveType, count, GL_UNSIGNED_INT, static_cast<GLuint*>(nullptr) + start);
+        AddVertexAttrib(it->second, numVec4 * 16 + runningOffsetTotal);
+        vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR0] = numVec4 + runningTotal;
+        ++numVec4;
     }
-    else
+
+    auto itCol1 = inputs.find(GLUF_VERTEX_ATTRIB_COLOR1);
+    it = itCol1;
+    if (mesh->HasVertexColors(1) && it != inputs.end())
     {
-        glDrawArrays(mPrimitiveType, (start < 0 || start > mVertexCount) ? 0 : start, (count > mVertexCount) ? mVertexCount : count);
+        AddVertexAttrib(it->second, numVec4 * 16 + runningOffsetTotal);
+        vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR1] = numVec4 + runningTotal;
+        ++numVec4;
     }
 
-    SWITCH_GL_VERSION
-    GL_VERSION_LESS(30)
+    auto itCol2 = inputs.find(GLUF_VERTEX_ATTRIB_COLOR2);
+    it = itCol2;
+    if (mesh->HasVertexColors(2) && it != inputs.end())
     {
-        DisableVertexAttributes();
+        AddVertexAttrib(it->second, numVec4 * 16 + runningOffsetTotal);
+        vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR2] = numVec4 + runningTotal;
+        ++numVec4;
     }
 
-    UnBindVertexArray();
-}
-
-//--------------------------------------------------------------------------------------
-void VertexArrayBase::DrawInstanced(GLuint instances) noexcept
-{
-    BindVertexArray();
-
-    SWITCH_GL_VERSION
-    GL_VERSION_LESS(30)
+    auto itCol3 = inputs.find(GLUF_VERTEX_ATTRIB_COLOR3);
+    it = itCol3;
+    if (mesh->HasVertexColors(3) && it != inputs.end())
     {
-        EnableVertexAttributes();//must disable and re-enable every time with openGL less than 3.0
+        AddVertexAttrib(it->second, numVec4 * 16 + runningOffsetTotal);
+        vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR3] = numVec4 + runningTotal;
+        ++numVec4;
     }
 
-    if (mIndexBuffer != 0)
+    auto itCol4 = inputs.find(GLUF_VERTEX_ATTRIB_COLOR4);
+    it = itCol4;
+    if (mesh->HasVertexColors(4) && it != inputs.end())
     {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
-        glDrawElementsInstanced(mPrimitiveType, mIndexCount, GL_UNSIGNED_INT, nullptr, instances);
+        AddVertexAttrib(it->second, numVec4 * 16 + runningOffsetTotal);
+        vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR4] = numVec4 + runningTotal;
+        ++numVec4;
     }
-    else
+    
+    auto itCol5 = inputs.find(GLUF_VERTEX_ATTRIB_COLOR5);
+    it = itCol5;
+    if (mesh->HasVertexColors(5) && it != inputs.end())
     {
-        glDrawArraysInstanced(mPrimitiveType, 0, mVertexCount, instances);
+        AddVertexAttrib(it->second, numVec4 * 16 + runningOffsetTotal);
+        vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR5] = numVec4 + runningTotal;
+        ++numVec4;
     }
 
-    SWITCH_GL_VERSION
-    GL_VERSION_LESS(30)
+    auto itCol6 = inputs.find(GLUF_VERTEX_ATTRIB_COLOR6);
+    it = itCol6;
+    if (mesh->HasVertexColors(6) && it != inputs.end())
     {
-        DisableVertexAttributes();
+        AddVertexAttrib(it->second, numVec4 * 16 + runningOffsetTotal);
+        vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR6] = numVec4 + runningTotal;
+        ++numVec4;
     }
 
-    UnBindVertexArray();
-}
-
-//helper function
-//--------------------------------------------------------------------------------------
-void VertexArrayBase::BufferIndicesBase(GLuint indexCount, const GLvoid* data) noexcept
-{
-    BindVertexArray();
-    mIndexCount = indexCount;
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * mIndexCount, data, mUsageType);
-
-    UnBindVertexArray();
-}
-
-//--------------------------------------------------------------------------------------
-void VertexArrayBase::BufferIndices(const std::vector<GLuint>& indices) noexcept
-{
-    BufferIndicesBase(indices.size(), &indices[0]);
-}
+    auto itCol7 = inputs.find(GLUF_VERTEX_ATTRIB_COLOR7);
+    it = itCol7;
+    if (mesh->HasVertexColors(7) && it != inputs.end())
+    {
+        AddVertexAttrib(it->second, numVec4 * 16 + runningOffsetTotal);
+        vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR7] = numVec4 + runningTotal;
+        ++numVec4;
+    }
 
-//--------------------------------------------------------------------------------------
-void VertexArrayBase::BufferIndices(const std::vector<glm::u32vec2>& indices) noexcept
-{
-    BufferIndicesBase(indices.size() * 2, &indices[0]);
-}
 
-//--------------------------------------------------------------------------------------
-void VertexArrayBase::BufferIndices(const std::vector<glm::u32vec3>& indices) noexcept
-{
-    BufferIndicesBase(indices.size() * 3, &indices[0]);
-}
 
-//--------------------------------------------------------------------------------------
-void VertexArrayBase::BufferIndices(const std::vector<glm::u32vec4>& indices) noexcept
-{
-    BufferIndicesBase(indices.size() * 4, &indices[0]);
-}
+    //the custom vertex array
+    GLVector<AssimpVertexStruct> vertexBuffer = AssimpVertexStruct::MakeMany(mesh->mNumVertices, numVec2, numVec3, numVec4);
 
-//--------------------------------------------------------------------------------------
-/*void VertexArrayBase::EnableVertexAttribute(AttribLoc loc)
-{
-    auto it = mDisabledAttribInfos.find(loc);
-    if (it == mDisabledAttribInfos.end())
-        return;
+    if (mesh->HasPositions() && itPos != inputs.end())
+    {
+        //positions will ALWAYS be the first vec3
+        vertexBuffer.buffer_element(mesh->mVertices, vertexAttribLoc[GLUF_VERTEX_ATTRIB_POSITION]);
+    }
+    if (mesh->HasNormals() && itNorm != inputs.end())
+    {
+        vertexBuffer.buffer_element(mesh->mNormals, vertexAttribLoc[GLUF_VERTEX_ATTRIB_NORMAL]);
+    }
 
-    mAttribInfos[loc] = it->second;
 
-    mDisabledAttribInfos.erase(it);
-}
 
-//--------------------------------------------------------------------------------------
-void VertexArrayBase::DisableVertexAttribute(AttribLoc loc)
-{
-    auto it = mAttribInfos.find(loc);
-    if (it == mAttribInfos.end())
-        return;
+    /*
 
-    mDisabledAttribInfos[loc] = it->second;
+    Instead of flipping the pixels when loading textures, UV's will be flipped instead
 
-    mAttribInfos.erase(it);
-}*/
+    Also, since we are using 2 dimmentional texture coordinates, make sure to convert to 2 element vectors
 
+    */
 
+    //note: data2D must be size in length
+    const auto FlipAndConvertUVArray = [](aiVector3D* data, aiVector2D*& data2D, const unsigned int size)
+    {
+        for (unsigned int i = 0; i < size; ++i)
+        {
+            data2D[i].x = data[i].x;
+            data2D[i].y = 1.0f - data[i].y;
+        }
+    };
 
-/*
-RoundNearestMultiple
+    aiVector2D* data2D = nullptr;
+    if (mesh->HasTextureCoords(0) && itUV0 != inputs.end())
+    {
+        //do not initialize data2D until here, because if there is not a first texture coord, then there wil be no others
+        data2D = new aiVector2D[mesh->mNumVertices];
 
-    Parameters:
-        'num': Number to round
-        'multiple': which multiple to round to
+        FlipAndConvertUVArray(mesh->mTextureCoords[0], data2D, mesh->mNumVertices);
+        vertexBuffer.buffer_element(data2D, vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV0]);
+    }
+    if (mesh->HasTextureCoords(1) && itUV1 != inputs.end())
+    {
+        FlipAndConvertUVArray(mesh->mTextureCoords[1], data2D, mesh->mNumVertices);
+        vertexBuffer.buffer_element(data2D, vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV1]);
+    }
+    if (mesh->HasTextureCoords(2) && itUV2 != inputs.end())
+    {
+        FlipAndConvertUVArray(mesh->mTextureCoords[2], data2D, mesh->mNumVertices);
+        vertexBuffer.buffer_element(data2D, vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV2]);
+    }
+    if (mesh->HasTextureCoords(3) && itUV3 != inputs.end())
+    {
+        FlipAndConvertUVArray(mesh->mTextureCoords[3], data2D, mesh->mNumVertices);
+        vertexBuffer.buffer_element(data2D, vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV3]);
+    }
+    if (mesh->HasTextureCoords(4) && itUV4 != inputs.end())
+    {
+        FlipAndConvertUVArray(mesh->mTextureCoords[4], data2D, mesh->mNumVertices);
+        vertexBuffer.buffer_element(data2D, vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV4]);
+    }
+    if (mesh->HasTextureCoords(5) && itUV5 != inputs.end())
+    {
+        FlipAndConvertUVArray(mesh->mTextureCoords[5], data2D, mesh->mNumVertices);
+        vertexBuffer.buffer_element(data2D, vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV5]);
+    }
+    if (mesh->HasTextureCoords(6) && itUV6 != inputs.end())
+    {
+        FlipAndConvertUVArray(mesh->mTextureCoords[6], data2D, mesh->mNumVertices);
+        vertexBuffer.buffer_element(data2D, vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV6]);
+    }
+    if (mesh->HasTextureCoords(7) && itUV7 != inputs.end())
+    {
+        FlipAndConvertUVArray(mesh->mTextureCoords[7], data2D, mesh->mNumVertices);
+        vertexBuffer.buffer_element(data2D, vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV7]);
+    }
+    delete[] data2D;
 
-    Throws:
-        'std::invalid_argument' if multiple == 0
-       
-    Note:
-        This always rounds up to the next multiple
-        Usage is to make sure memory is within certain boundaries (i.e. 4 byte boundaries)
 
-*/
-//--------------------------------------------------------------------------------------
-int RoundNearestMultiple(unsigned int num, unsigned int multiple)
-{
-    if (multiple == 0)
+    if (mesh->HasVertexColors(0) && itCol0 != inputs.end())
     {
-        GLUF_NON_CRITICAL_EXCEPTION(std::invalid_argument("Multiple Cannot Be 0"));
-        return 0;//if the multiple is 0, still needs to return something in release mode
+        vertexBuffer.buffer_element(mesh->mColors[0], vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR0]);
+    }
+    if (mesh->HasVertexColors(1) && itCol1 != inputs.end())
+    {
+        vertexBuffer.buffer_element(mesh->mColors[1], vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR1]);
+    }
+    if (mesh->HasVertexColors(2) && itCol2 != inputs.end())
+    {
+        vertexBuffer.buffer_element(mesh->mColors[2], vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR2]);
+    }
+    if (mesh->HasVertexColors(3) && itCol3 != inputs.end())
+    {
+        vertexBuffer.buffer_element(mesh->mColors[3], vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR3]);
+    }
+    if (mesh->HasVertexColors(4) && itCol4 != inputs.end())
+    {
+        vertexBuffer.buffer_element(mesh->mColors[4], vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR4]);
+    }
+    if (mesh->HasVertexColors(5) && itCol5 != inputs.end())
+    {
+        vertexBuffer.buffer_element(mesh->mColors[5], vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR5]);
+    }
+    if (mesh->HasVertexColors(6) && itCol6 != inputs.end())
+    {
+        vertexBuffer.buffer_element(mesh->mColors[6], vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR6]);
+    }
+    if (mesh->HasVertexColors(7) && itCol7 != inputs.end())
+    {
+        vertexBuffer.buffer_element(mesh->mColors[7], vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR7]);
+    }
+    if (mesh->HasTangentsAndBitangents() && itBitan != inputs.end() && itTan != inputs.end())
+    {
+        vertexBuffer.buffer_element(mesh->mTangents, vertexAttribLoc[GLUF_VERTEX_ATTRIB_TAN]);
+        vertexBuffer.buffer_element(mesh->mBitangents, vertexAttribLoc[GLUF_VERTEX_ATTRIB_BITAN]);
     }
 
-    unsigned int nearestMultiple = 0;
-
-    //loop up to the 
-    for (unsigned int i = 0; i < num; i += multiple)
+    //pack the vertices into one interleaved array
+    meshData.mVertexCount = mesh->mNumVertices;
+    if (!vertexBuffer.empty())
     {
-        nearestMultiple = i;
+        const char* packed = static_cast<const char*>(vertexBuffer.gl_data());
+        meshData.mVertexData.assign(packed, packed + vertexBuffer.front().size() * vertexBuffer.size());
     }
 
-    nearestMultiple += multiple;
-    return nearestMultiple;
-}
 
-//--------------------------------------------------------------------------------------
-void VertexArrayAoS::RefreshDataBufferAttribute() noexcept
-{
-    SWITCH_GL_VERSION
-    GL_VERSION_GREATER_EQUAL(30)//this is done at draw time in opengl less than 3.0
+    meshData.mIndices.reserve(mesh->mNumFaces);
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i)
     {
-
-        BindVertexArray();
-
-        glBindBuffer(GL_ARRAY_BUFFER, mDataBuffer);
-
-        GLuint stride = GetVertexSize();
-        for (auto it : mAttribInfos)
-        {
-            //the last parameter might be wrong
-            glVertexAttribPointer(it.second.mVertexAttribLocation, it.second.mElementsPerValue, it.second.mType, GL_FALSE, stride, reinterpret_cast<GLvoid*>(static_cast<uintptr_t>(it.second.mOffset)));
-        }
-
-        UnBindVertexArray();
+        aiFace curr = mesh->mFaces[i];
+        meshData.mIndices.push_back({ curr.mIndices[0], curr.mIndices[1], curr.mIndices[2] });
     }
-}
-
-//--------------------------------------------------------------------------------------
-VertexArrayAoS::VertexArrayAoS(GLenum PrimType, GLenum buffUsage, bool indexed) : VertexArrayBase(PrimType, buffUsage, indexed)
-{
-    //the VAO is already bound
-
-    glGenBuffers(1, &mDataBuffer);
-    glGenBuffers(1, &mCopyBuffer);
 
-    if (mDataBuffer == 0 || mCopyBuffer == 0)
-        GLUF_CRITICAL_EXCEPTION(MakeBufferException());
+    return meshData;
 }
 
 //--------------------------------------------------------------------------------------
-VertexArrayAoS::~VertexArrayAoS() noexcept
+std::shared_ptr<VertexArray> LoadVertexArrayFromMeshData(const MeshData& meshData)
 {
-    BindVertexArray();
+    auto vertexData = std::make_shared<VertexArray>(GL_TRIANGLES, GL_STATIC_DRAW, meshData.mIndexed);
 
-    glDeleteBuffers(1, &mDataBuffer);
-
-    UnBindVertexArray();
-}
+    for (const auto& it : meshData.mAttributes)
+        vertexData->AddVertexAttrib(it, it.mOffset);
 
-//--------------------------------------------------------------------------------------
-VertexArrayAoS::VertexArrayAoS(VertexArrayAoS&& other) : VertexArrayBase(std::move(other))
-{
-    mDataBuffer = other.mDataBuffer;
+    //don't forget to buffer the actual data :) (i actually forgot this part at first)
+    vertexData->BufferData(meshData.mVertexData);
+    vertexData->BufferIndices(meshData.mIndices);
 
-    other.mDataBuffer = 0;
+    return vertexData;
 }
 
 //--------------------------------------------------------------------------------------
-VertexArrayAoS& VertexArrayAoS::operator=(VertexArrayAoS&& other)
+std::shared_ptr<VertexArray> LoadVertexArrayFromScene(const aiScene* scene, const VertexAttribMap& inputs, GLuint meshNum)
 {
-    //since there is no possibility for user error, not catching dynamic cast here is A-OK
-
-    VertexArrayBase* thisParentPtr = dynamic_cast<VertexArrayBase*>(this);
-    *thisParentPtr = std::move(other);
-
-    mDataBuffer = other.mDataBuffer;
-    other.mDataBuffer = 0;
+    GLUF_PROFILE_ZONE("LoadVertexArrayFromScene");
 
-    return *this;
+    return LoadVertexArrayFromMeshData(ConvertMeshFromScene(scene, inputs, meshNum));
 }
 
-//--------------------------------------------------------------------------------------
-GLuint VertexArrayAoS::GetVertexSize() const noexcept
-{
-    GLuint stride = 0;
-    //WOW: this before was allocating memory to find the size of the memory, then didn't even delete it
-    for (auto it : mAttribInfos)
-    {
-        //round to the 4 bytes bounderies
-        stride += it.second.mElementsPerValue * RoundNearestMultiple(it.second.mBytesPerElement, 4);
-    }
-
-    return stride;
-}
 
 //--------------------------------------------------------------------------------------
-void VertexArrayAoS::AddVertexAttrib(const VertexAttribInfo& info)
+std::vector<std::shared_ptr<VertexArray>> LoadVertexArraysFromScene(const aiScene* scene, GLuint meshOffset, GLuint numMeshes)
 {
-    //don't do null checks, because BindVertexArray already does them for us
-    BindVertexArray();
-
-    //make sure the attribute contains valid data
-    if (info.mBytesPerElement == 0 || info.mElementsPerValue == 0)
-        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("Invalid Data in Vertex Attribute Info!"));
-    
-    mAttribInfos.insert(std::pair<AttribLoc, VertexAttribInfo>(info.mVertexAttribLocation, info));
-
-    //this is a bit inefficient to refresh every time an attribute is added, but this should not be significant
-    RefreshDataBufferAttribute();
+    std::vector<std::shared_ptr<VertexArray>> arrays;
 
-    //enable the new attribute
-    glEnableVertexAttribArray(info.mVertexAttribLocation);//not harmful in opengl less than 3.0
+    if (numMeshes > scene->mNumMeshes)
+    {
+        arrays.push_back(nullptr);
+        return arrays;
+    }
 
-    UnBindVertexArray();
+    for(unsigned int cnt = 0; cnt < numMeshes; ++cnt)
+    {
+        arrays.push_back(LoadVertexArrayFromScene(scene, cnt));//new VertexArray(GL_TRIANGLES, GL_STATIC_DRAW, mesh->HasFaces());
+    }
+    return arrays;
 }
 
 //--------------------------------------------------------------------------------------
-void VertexArrayAoS::AddVertexAttrib(const VertexAttribInfo& info, GLuint offset)
+const aiScene* LoadSceneFromMemory(Assimp::Importer& importer, const MemorySpan& data, unsigned int postProcessFlags, const std::string& formatHint)
 {
-    //don't do null checks, because BindVertexArray already does them for us
-    BindVertexArray();
-
-    //make sure the attribute contains valid data
-    if (info.mBytesPerElement == 0 || info.mElementsPerValue == 0)
-        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("Invalid Data in Vertex Attribute Info!"));
-
-    //insert the offset into the data
-    VertexAttribInfo tmpCopy = info;
-    tmpCopy.mOffset = offset;
-
-    mAttribInfos.insert(std::pair<AttribLoc, VertexAttribInfo>(info.mVertexAttribLocation, tmpCopy));
-
-    //this is a bit inefficient to refresh every time an attribute is added, but this should not be significant
-    RefreshDataBufferAttribute();
+    if (data.empty())
+    {
+        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("(LoadSceneFromMemory): Scene Data is Empty!"));
+    }
 
-    //enable the new attribute
-    glEnableVertexAttribArray(info.mVertexAttribLocation);//not harmful in opengl less than 3.0
+    const aiScene* scene = importer.ReadFileFromMemory(data.data(), data.size(), postProcessFlags, formatHint.c_str());
+    if (scene == nullptr)
+    {
+        GLUF_ERROR_LONG("(LoadSceneFromMemory): " << importer.GetErrorString());
+    }
 
-    UnBindVertexArray();
+    return scene;
 }
 
 //--------------------------------------------------------------------------------------
-void VertexArrayAoS::ResizeBuffer(GLsizei numVertices, bool keepOldData, GLsizei newOldDataOffset)
+const aiScene* LoadSceneFromFile(Assimp::Importer& importer, const std::string& path, unsigned int postProcessFlags)
 {
-    //if we are keeping the old data, move it into a new buffer
-    GLsizei vertSize = GetVertexSize();
-    GLsizei newTotalSize = vertSize * numVertices;
-    if (keepOldData)
+    MappedFile file;
+    try
     {
-        GLsizei totalSize = vertSize * mVertexCount;
-        GLsizei newOldDataTotalOffset = vertSize * newOldDataOffset;
-
-        glBindBuffer(GL_COPY_READ_BUFFER, mDataBuffer);
-        glBindBuffer(GL_COPY_WRITE_BUFFER, mCopyBuffer);
-        
-        //resize the copy buffer
-        glBufferData(GL_COPY_WRITE_BUFFER, totalSize, nullptr, GL_STREAM_COPY);
-
-        //copy the data
-        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, totalSize);
-
-        //change binding
-        glBindBuffer(GL_COPY_READ_BUFFER, mCopyBuffer);
-        glBindBuffer(GL_COPY_WRITE_BUFFER, mDataBuffer);
-
-        //resize the data buffer
-        glBufferData(GL_COPY_WRITE_BUFFER, newTotalSize, nullptr, GL_STREAM_COPY);
-
-        //copy the data back
-        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, newOldDataTotalOffset, totalSize);
+        file.Open(path);
     }
-    else
+    catch (const std::ios_base::failure& e)
     {
-        glBindBuffer(GL_ARRAY_BUFFER, mDataBuffer);
-        glBufferData(GL_ARRAY_BUFFER, newTotalSize, nullptr, GL_STREAM_DRAW);
+        GLUF_ERROR_LONG("(LoadSceneFromFile): " << e.what());
+        RETHROW;
     }
 
-    mVertexCount = numVertices;
+    //assimp picks the importer from the extension
+    std::string hint;
+    auto extPos = path.find_last_of('.');
+    if (extPos != std::string::npos)
+        hint = path.substr(extPos + 1);
+
+    //the importer copies what it needs into the scene, so the mapping can be released afterward
+    return LoadSceneFromMemory(importer, file, postProcessFlags, hint);
 }
 
-//--------------------------------------------------------------------------------------
-void VertexArrayAoS::EnableVertexAttributes() const noexcept
+/*
+VertexArray* LoadVertexArrayFromFile(std::string path)
 {
-    glBindBuffer(GL_ARRAY_BUFFER, mDataBuffer);
-
-    GLuint stride = GetVertexSize();
-    for (auto it : mAttribInfos)
-    {
-        glEnableVertexAttribArray(it.second.mVertexAttribLocation);
-        glVertexAttribPointer(it.second.mVertexAttribLocation, it.second.mElementsPerValue, it.second.mType, GL_FALSE, stride, reinterpret_cast<const GLvoid*>(it.second.mOffset));
-    }
+    Assimp::Importer importer;
+    const aiScene* scene = importer.ReadFile(path,
+        aiProcess_CalcTangentSpace |
+        aiProcess_Triangulate |
+        aiProcess_JoinIdenticalVertices |
+        aiProcess_SortByPType);
 
-}
+    const aiMesh* mesh = scene->mMeshes[0];
 
-//--------------------------------------------------------------------------------------
-void VertexArrayAoS::DisableVertexAttributes() const noexcept
-{
-    glBindBuffer(GL_ARRAY_BUFFER, mDataBuffer);
+    VertexArray vertexData(GL_TRIANGLES, GL_STATIC_DRAW, mesh->HasFaces());
 
-    for(auto it : mAttribInfos)
+    if (mesh->HasPositions())
+        vertexData.AddVertexAttrib(g_attribPOS);
+    if (mesh->HasNormals())
+        vertexData.AddVertexAttrib(g_attribNORM);
+    if (mesh->HasTextureCoords(0))
+        vertexData.AddVertexAttrib(g_attribUV);
+    if (mesh->HasTangentsAndBitangents())
     {
-        glDisableVertexAttribArray(it.second.mVertexAttribLocation);
+        vertexData.AddVertexAttrib(g_attribTAN);
+        vertexData.AddVertexAttrib(g_attribBITAN);
     }
-}
+    if (mesh->HasVertexColors(0))
+        vertexData.AddVertexAttrib(g_attribCOLOR);
 
 
+    if (mesh->HasPositions())
+        vertexData.BufferData(VERTEX_ATTRIB_POSITION, mesh->mNumVertices, mesh->mVertices);
+    if (mesh->HasNormals())
+        vertexData.BufferData(VERTEX_ATTRIB_NORMAL, mesh->mNumVertices, mesh->mNormals);
+    if (mesh->HasTextureCoords(0))
+        vertexData.BufferData(VERTEX_ATTRIB_UV, mesh->mNumVertices, AssimpToGlm3_2(mesh->mTextureCoords[0], mesh->mNumVertices));
+    if (mesh->HasTangentsAndBitangents())
+    {
+        vertexData.BufferData(VERTEX_ATTRIB_BITAN, mesh->mNumVertices, mesh->mBitangents);
+        vertexData.BufferData(VERTEX_ATTRIB_TAN, mesh->mNumVertices, mesh->mTangents);
+    }
+    if (mesh->HasVertexColors(0))
+        vertexData.BufferData(VERTEX_ATTRIB_COLOR, mesh->mNumVertices, mesh->mColors[0]);
 
-//--------------------------------------------------------------------------------------
-void VertexArraySoA::RefreshDataBufferAttribute() noexcept
-{
-    //this is done at draw time less than opengl 3.0
-    SWITCH_GL_VERSION
-    GL_VERSION_GREATER_EQUAL(30)
+    std::vector<GLuint> indices;
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i)
     {
-        BindVertexArray();
-        for (auto it : mAttribInfos)
-        {
-            glBindBuffer(GL_ARRAY_BUFFER, mDataBuffers[it.second.mVertexAttribLocation]);
-            glVertexAttribPointer(it.second.mVertexAttribLocation, it.second.mElementsPerValue, it.second.mType, GL_FALSE, 0, nullptr);
-        }
-        UnBindVertexArray();
+        aiFace curr = mesh->mFaces[i];
+        indices.push_back(curr.mIndices[0]);
+        indices.push_back(curr.mIndices[1]);
+        indices.push_back(curr.mIndices[2]);
     }
+    vertexData.BufferIndices(&indices[0], indices.size());
+
+    return vertexData;
+    return LoadVertexArray(scene);
 }
 
-//--------------------------------------------------------------------------------------
-GLuint VertexArraySoA::GetBufferIdFromAttribLoc(AttribLoc loc) const
+VertexArray *LoadVertexArrayFromFile(unsigned int size, void* data)
 {
-    auto ret = mDataBuffers.find(loc);
-    if (ret == mDataBuffers.end())
-        GLUF_CRITICAL_EXCEPTION(InvalidAttrubuteLocationException());
+    Assimp::Importer importer;
+    const aiScene* scene = importer.ReadFileFromMemory(data, size,
+        aiProcess_CalcTangentSpace |
+        aiProcess_Triangulate |
+        aiProcess_JoinIdenticalVertices |
+        aiProcess_SortByPType);
 
-    return ret->second;
-}
+    return LoadVertexArray(scene);
+}*/
 
-//--------------------------------------------------------------------------------------
-VertexArraySoA::VertexArraySoA(GLenum PrimType, GLenum buffUsage, bool indexed) : VertexArrayBase(PrimType, buffUsage, indexed)
-{
-}
 
-//--------------------------------------------------------------------------------------
-VertexArraySoA::~VertexArraySoA() noexcept
-{
-    BindVertexArray();
-    for (auto it : mDataBuffers)
-        glDeleteBuffers(1, &it.second);
-    UnBindVertexArray();
-}
+/*
+======================================================================================================================================================================================================
+Asynchronous Asset Loading
+
+*/
+
+AsyncLoader g_AsyncLoader;
 
 //--------------------------------------------------------------------------------------
-VertexArraySoA::VertexArraySoA(VertexArraySoA&& other) : VertexArrayBase(std::move(other))
+AsyncLoader::~AsyncLoader()
 {
-    mDataBuffers = std::move(other.mDataBuffers);
+    Shutdown();
 }
 
 //--------------------------------------------------------------------------------------
-VertexArraySoA& VertexArraySoA::operator=(VertexArraySoA&& other)
+void AsyncLoader::Init(unsigned int numThreads)
 {
-    //since there is no possibility for user error, not catching dynamic cast here is A-OK
-
-    VertexArrayBase* thisParentPtr = dynamic_cast<VertexArrayBase*>(this);
-    *thisParentPtr = std::move(other);
-
-    mDataBuffers = std::move(other.mDataBuffers);
-
-    return *this;
+    _TSAFE_SCOPE(mWorkMutex);
+    StartWorkers(numThreads);
 }
 
 //--------------------------------------------------------------------------------------
-void VertexArraySoA::GetBarebonesMesh(MeshBarebones& inData)
+void AsyncLoader::StartWorkers(unsigned int numThreads)
 {
-    BindVertexArray();
+    //NOTE: 'mWorkMutex' must be locked by the caller
+    if (!mWorkers.empty())
+        return;
 
-    std::map<AttribLoc, GLuint>::iterator it = mDataBuffers.find(GLUF_VERTEX_ATTRIB_POSITION);
-    if (mIndexBuffer == 0 || it == mDataBuffers.end())
+    if (numThreads == 0)
     {
-        GLUF_CRITICAL_EXCEPTION(InvalidAttrubuteLocationException());
+        unsigned int hwThreads = std::thread::hardware_concurrency();
+        numThreads = hwThreads > 1 ? hwThreads - 1 : 1;
     }
-    
-    glBindBuffer(GL_ARRAY_BUFFER, it->second);
-    glm::vec3* pVerts = (glm::vec3*)glMapBuffer(GL_ARRAY_BUFFER, GL_READ_ONLY);
-
-    inData.mVertices = ArrToVec(pVerts, mVertexCount);
-    glUnmapBuffer(GL_ARRAY_BUFFER);
-
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
-    GLuint* pIndices = (GLuint*)glMapBuffer(GL_ELEMENT_ARRAY_BUFFER, GL_READ_ONLY);
-
-    inData.mIndices = ArrToVec(pIndices, mIndexCount);
-    glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
 
-    UnBindVertexArray();
+    mShutdown = false;
+    for (unsigned int i = 0; i < numThreads; ++i)
+        mWorkers.emplace_back(&AsyncLoader::WorkerMain, this);
 }
 
 //--------------------------------------------------------------------------------------
-void VertexArraySoA::AddVertexAttrib(const VertexAttribInfo& info) noexcept
+void AsyncLoader::Shutdown() noexcept
 {
-    BindVertexArray();
+    {
+        _TSAFE_SCOPE(mWorkMutex);
+        if (mWorkers.empty())
+            return;
+        mShutdown = true;
+    }
+    mWorkCondition.notify_all();
 
-    mAttribInfos.insert(std::pair<AttribLoc, VertexAttribInfo>(info.mVertexAttribLocation, info));
+    for (auto& it : mWorkers)
+    {
+        if (it.joinable())
+            it.join();
+    }
 
-    GLuint newBuff = 0;
-    glGenBuffers(1, &newBuff);
-    mDataBuffers.insert(std::pair<AttribLoc, GLuint>(info.mVertexAttribLocation, newBuff));
-    
-    RefreshDataBufferAttribute();
+    _TSAFE_SCOPE(mWorkMutex);
+    mWorkers.clear();
 
-    UnBindVertexArray();
+    //the context is about to go away, so nothing left here can be finished
+    std::lock_guard<std::mutex> uploadLock(mUploadMutex);
+    mUploadQueue.clear();
+    mPollTasks.clear();
 }
 
 //--------------------------------------------------------------------------------------
-void VertexArraySoA::RemoveVertexAttrib(AttribLoc loc) noexcept
+void AsyncLoader::WorkerMain()
 {
-    BindVertexArray();
+    while (true)
+    {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mWorkMutex);
+            mWorkCondition.wait(lock, [this]() { return mShutdown || !mWorkQueue.empty(); });
 
-    auto it = mDataBuffers.find(loc);
+            //finish what is already queued before exiting
+            if (mWorkQueue.empty())
+                return;
 
-    glDeleteBuffers(1, &(it->second));
-    mDataBuffers.erase(it);
+            task = std::move(mWorkQueue.front());
+            mWorkQueue.pop_front();
+            ++mActiveWorkCount;
+        }
 
-    VertexArrayBase::RemoveVertexAttrib(loc);
+        try
+        {
+            task();
+        }
+        catch (const std::exception& e)
+        {
+            //'LoadAsync' tasks store their own exceptions; this only catches raw 'QueueWork' tasks
+            GLUF_ERROR_LONG("(AsyncLoader): Unhandled exception in worker task: " << e.what());
+        }
+        catch (...)
+        {
+            GLUF_ERROR("(AsyncLoader): Unhandled exception in worker task");
+        }
 
-    UnBindVertexArray();
+        --mActiveWorkCount;
+    }
 }
 
 //--------------------------------------------------------------------------------------
-void VertexArraySoA::EnableVertexAttributes() const noexcept
+void AsyncLoader::QueueWork(Task task)
 {
-    auto it = mDataBuffers.begin();
-    for (auto itAttrib : mAttribInfos)
     {
-        glBindBuffer(GL_ARRAY_BUFFER, it->second);
-        glEnableVertexAttribArray(itAttrib.second.mVertexAttribLocation);
-        glVertexAttribPointer(itAttrib.second.mVertexAttribLocation, itAttrib.second.mElementsPerValue, itAttrib.second.mType, GL_FALSE, 0, nullptr);
-        ++it;
+        _TSAFE_SCOPE(mWorkMutex);
+        StartWorkers(0);
+        mWorkQueue.push_back(std::move(task));
     }
+    mWorkCondition.notify_one();
 }
 
 //--------------------------------------------------------------------------------------
-void VertexArraySoA::DisableVertexAttributes() const noexcept
+bool AsyncLoader::TryQueueWork(Task task)
 {
-    for (auto it : mAttribInfos)
     {
-        glDisableVertexAttribArray(it.second.mVertexAttribLocation);
+        _TSAFE_SCOPE(mWorkMutex);
+        if (mWorkers.empty() || mShutdown)
+            return false;
+        mWorkQueue.push_back(std::move(task));
     }
+    mWorkCondition.notify_one();
+    return true;
 }
 
-
-
-/*
-=======================================================================================================================================================================================================
-Assimp Utility Functions
-
-*/
-
 //--------------------------------------------------------------------------------------
-std::shared_ptr<VertexArray> LoadVertexArrayFromScene(const aiScene* scene, GLuint meshNum)
+void AsyncLoader::QueueUpload(Task task)
 {
-    if (meshNum > scene->mNumMeshes)
-        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("\"meshNum\" is higher than number of meshes in \"scene\""));
-
-    //const aiMesh* mesh = scene->mMeshes[meshNum];
+    _TSAFE_SCOPE(mUploadMutex);
+    mUploadQueue.push_back(std::move(task));
+}
 
-    std::shared_ptr<VertexArray> arr = LoadVertexArrayFromScene(scene, g_stdAttrib, meshNum);
+//--------------------------------------------------------------------------------------
+void AsyncLoader::QueuePoll(PollTask task)
+{
+    _TSAFE_SCOPE(mUploadMutex);
+    mPollTasks.push_back(std::move(task));
+}
 
-    /*if (mesh->HasPositions())
-        vertexData->AddVertexAttrib(g_attribPOS);
-    if (mesh->HasNormals())
-        vertexData->AddVertexAttrib(g_attribNORM);
-    if (mesh->HasTextureCoords(0))
-        vertexData->AddVertexAttrib(g_attribUV0);
-    if (mesh->HasTextureCoords(1))
-        vertexData->AddVertexAttrib(g_attribUV1);
-    if (mesh->HasTextureCoords(2))
-        vertexData->AddVertexAttrib(g_attribUV2);
-    if (mesh->HasTextureCoords(3))
-        vertexData->AddVertexAttrib(g_attribUV3);
-    if (mesh->HasTextureCoords(4))
-        vertexData->AddVertexAttrib(g_attribUV4);
-    if (mesh->HasTextureCoords(5))
-        vertexData->AddVertexAttrib(g_attribUV5);
-    if (mesh->HasTextureCoords(6))
-        vertexData->AddVertexAttrib(g_attribUV6);
-    if (mesh->HasTextureCoords(7))
-        vertexData->AddVertexAttrib(g_attribUV7);
+//--------------------------------------------------------------------------------------
+unsigned int AsyncLoader::ProcessUploads(double budget)
+{
+    double start = GetTime();
+    unsigned int count = 0;
 
-    if (mesh->HasVertexColors(0))
-        vertexData->AddVertexAttrib(g_attribCOLOR0);
-    if (mesh->HasVertexColors(1))
-        vertexData->AddVertexAttrib(g_attribCOLOR1);
-    if (mesh->HasVertexColors(2))
-        vertexData->AddVertexAttrib(g_attribCOLOR2);
-    if (mesh->HasVertexColors(3))
-        vertexData->AddVertexAttrib(g_attribCOLOR3);
-    if (mesh->HasVertexColors(4))
-        vertexData->AddVertexAttrib(g_attribCOLOR4);
-    if (mesh->HasVertexColors(5))
-        vertexData->AddVertexAttrib(g_attribCOLOR5);
-    if (mesh->HasVertexColors(6))
-        vertexData->AddVertexAttrib(g_attribCOLOR6);
-    if (mesh->HasVertexColors(7))
-        vertexData->AddVertexAttrib(g_attribCOLOR7);
-    if (mesh->HasTangentsAndBitangents())
+    //polls are cheap, so every one is checked once per call regardless of the budget
+    std::vector<PollTask> polls;
     {
-        vertexData->AddVertexAttrib(g_attribTAN);
-        vertexData->AddVertexAttrib(g_attribBITAN);
+        _TSAFE_SCOPE(mUploadMutex);
+        polls.swap(mPollTasks);
     }
 
-
-    if (mesh->HasPositions())
-    vertexData->BufferData(GLUF_VERTEX_ATTRIB_POSITION, mesh->mNumVertices, mesh->mVertices);
-    if (mesh->HasNormals())
-    vertexData->BufferData(GLUF_VERTEX_ATTRIB_NORMAL, mesh->mNumVertices, mesh->mNormals);
-    if (mesh->HasTextureCoords(0))
-    vertexData->BufferData(GLUF_VERTEX_ATTRIB_UV0, mesh->mNumVertices, AssimpToGlm3_2(mesh->mTextureCoords[0], mesh->mNumVertices));
-    if (mesh->HasTextureCoords(1))
-    vertexData->BufferData(GLUF_VERTEX_ATTRIB_UV1, mesh->mNumVertices, AssimpToGlm3_2(mesh->mTextureCoords[1], mesh->mNumVertices));
-    if (mesh->HasTextureCoords(2))
-    vertexData->BufferData(GLUF_VERTEX_ATTRIB_UV2, mesh->mNumVertices, AssimpToGlm3_2(mesh->mTextureCoords[2], mesh->mNumVertices));
-    if (mesh->HasTextureCoords(3))
-    vertexData->BufferData(GLUF_VERTEX_ATTRIB_UV3, mesh->mNumVertices, AssimpToGlm3_2(mesh->mTextureCoords[3], mesh->mNumVertices));
-    if (mesh->HasTextureCoords(4))
-    vertexData->BufferData(GLUF_VERTEX_ATTRIB_UV4, mesh->mNumVertices, AssimpToGlm3_2(mesh->mTextureCoords[4], mesh->mNumVertices));
-    if (mesh->HasTextureCoords(5))
-    vertexData->BufferData(GLUF_VERTEX_ATTRIB_UV5, mesh->mNumVertices, AssimpToGlm3_2(mesh->mTextureCoords[5], mesh->mNumVertices));
-    if (mesh->HasTextureCoords(6))
-    vertexData->BufferData(GLUF_VERTEX_ATTRIB_UV6, mesh->mNumVertices, AssimpToGlm3_2(mesh->mTextureCoords[6], mesh->mNumVertices));
-    if (mesh->HasTextureCoords(7))
-    vertexData->BufferData(GLUF_VERTEX_ATTRIB_UV7, mesh->mNumVertices, AssimpToGlm3_2(mesh->mTextureCoords[7], mesh->mNumVertices));
-
-    if (mesh->HasVertexColors(0))
-    vertexData->BufferData(GLUF_VERTEX_ATTRIB_COLOR0, mesh->mNumVertices, mesh->mColors[0]);
-    if (mesh->HasVertexColors(1))
-    vertexData->BufferData(GLUF_VERTEX_ATTRIB_COLOR1, mesh->mNumVertices, mesh->mColors[1]);
-    if (mesh->HasVertexColors(2))
-    vertexData->BufferData(GLUF_VERTEX_ATTRIB_COLOR2, mesh->mNumVertices, mesh->mColors[2]);
-    if (mesh->HasVertexColors(3))
-    vertexData->BufferData(GLUF_VERTEX_ATTRIB_COLOR3, mesh->mNumVertices, mesh->mColors[3]);
-    if (mesh->HasVertexColors(4))
-    vertexData->BufferData(GLUF_VERTEX_ATTRIB_COLOR4, mesh->mNumVertices, mesh->mColors[4]);
-    if (mesh->HasVertexColors(5))
-    vertexData->BufferData(GLUF_VERTEX_ATTRIB_COLOR5, mesh->mNumVertices, mesh->mColors[5]);
-    if (mesh->HasVertexColors(6))
-    vertexData->BufferData(GLUF_VERTEX_ATTRIB_COLOR6, mesh->mNumVertices, mesh->mColors[6]);
-    if (mesh->HasVertexColors(7))
-    vertexData->BufferData(GLUF_VERTEX_ATTRIB_COLOR7, mesh->mNumVertices, mesh->mColors[7]);
-    if (mesh->HasTangentsAndBitangents())
+    std::vector<PollTask> unfinished;
+    for (auto& it : polls)
     {
-    vertexData->BufferData(GLUF_VERTEX_ATTRIB_BITAN, mesh->mNumVertices, mesh->mBitangents);
-    vertexData->BufferData(GLUF_VERTEX_ATTRIB_TAN, mesh->mNumVertices, mesh->mTangents);
-    }
+        //a poll which throws is dropped, the same as one which finished
+        bool finished = true;
+        try
+        {
+            finished = it();
+        }
+        catch (const std::exception& e)
+        {
+            GLUF_ERROR_LONG("(AsyncLoader): Unhandled exception in poll task: " << e.what());
+        }
+        catch (...)
+        {
+            GLUF_ERROR("(AsyncLoader): Unhandled exception in poll task");
+        }
 
-    std::vector<GLuint> indices;
-    for (unsigned int i = 0; i < mesh->mNumFaces; ++i)
-    {
-    aiFace curr = mesh->mFaces[i];
-    indices.push_back(curr.mIndices[0]);
-    indices.push_back(curr.mIndices[1]);
-    indices.push_back(curr.mIndices[2]);
+        if (finished)
+            ++count;
+        else
+            unfinished.push_back(std::move(it));
     }
-    vertexData->BufferIndices(&indices[0], indices.size());*/
-
-return arr;
-}
-
-/*
-
-AssimpVertexStruct
-
-
-*/
-
-//--------------------------------------------------------------------------------------
-struct AssimpVertexStruct : public VertexStruct
-{
-    std::vector<aiVector2D> v2;
-    std::vector<aiVector3D> v3;
-    std::vector<aiColor4D> v4;
 
-    AssimpVertexStruct(size_t vec2Cnt, size_t vec3Cnt, size_t vec4Cnt)
+    if (!unfinished.empty())
     {
-        v2.resize(vec2Cnt);
-        v3.resize(vec3Cnt);
-        v4.resize(vec4Cnt);
+        _TSAFE_SCOPE(mUploadMutex);
+        mPollTasks.insert(mPollTasks.begin(), std::make_move_iterator(unfinished.begin()), std::make_move_iterator(unfinished.end()));
     }
 
-    AssimpVertexStruct(){};
-
-    virtual char* get_data() const override
+    while (true)
     {
-        char* ret = new char[size()];
+        Task task;
+        {
+            _TSAFE_SCOPE(mUploadMutex);
+            if (mUploadQueue.empty())
+                break;
 
-        size_t v2Size = 2 * v2.size() * 4;
-        size_t v3Size = 3 * v3.size() * 4;
-        size_t v4Size = 4 * v4.size() * 4;
+            task = std::move(mUploadQueue.front());
+            mUploadQueue.pop_front();
+        }
 
-        memcpy(ret, v2.data(), v2Size);
-        memcpy(ret + v2Size, v3.data(), v3Size);
-        memcpy(ret + v2Size + v3Size, v4.data(), v4Size);
+        //tasks are run outside of the lock, so they may queue more uploads
+        try
+        {
+            task();
+        }
+        catch (const std::exception& e)
+        {
+            //'LoadAsync' tasks store their own exceptions; this only catches raw 'QueueUpload' tasks
+            GLUF_ERROR_LONG("(AsyncLoader): Unhandled exception in upload task: " << e.what());
+        }
+        catch (...)
+        {
+            GLUF_ERROR("(AsyncLoader): Unhandled exception in upload task");
+        }
+        ++count;
 
-        return ret;
+        if (GetTime() - start >= budget)
+            break;
     }
 
-    virtual size_t size() const override
-    {
-        return 4 * (2 * v2.size() + 3 * v3.size() + 4 * v4.size());
-    }
+    return count;
+}
 
-    virtual size_t n_elem_size(size_t element)
-    {
-        size_t i = 0;
-        if (element < v2.size())
-            return sizeof(aiVector2D);
+//--------------------------------------------------------------------------------------
+std::size_t AsyncLoader::GetPendingWorkCount() const
+{
+    _TSAFE_SCOPE(mWorkMutex);
+    return mWorkQueue.size() + mActiveWorkCount;
+}
 
-        i += v2.size();
+//--------------------------------------------------------------------------------------
+std::size_t AsyncLoader::GetPendingUploadCount() const
+{
+    _TSAFE_SCOPE(mUploadMutex);
+    return mUploadQueue.size() + mPollTasks.size();
+}
 
-        if (element < i + v3.size())
-            return sizeof(aiVector3D);
+//--------------------------------------------------------------------------------------
+std::future<GLuint> AsyncLoader::LoadTextureFromFileAsync(const std::string& filePath, TextureFileFormat format)
+{
+    return LoadAsync<GLuint>([filePath, format]() -> std::function<GLuint()>
+    {
+        MappedFilePtr file = MapFile(filePath);
 
-        i += v3.size();
+        if (format == TFF_DDS)
+        {
+            //walk the header here, so the context thread only has to make the GL calls
+            auto image = std::make_shared<DDSImage>(ParseDDS(*file));
 
-        if (element < i + v4.size())
-            return sizeof(aiColor4D);
+            //likewise for decoding formats the context does not support
+            if (image->mCompressedFormat != 0 && !IsCompressedFormatSupported(image->mCompressedFormat))
+            {
+                auto decoded = std::make_shared<std::vector<char>>();
+                auto decodedImage = std::make_shared<DDSImage>(DecompressDDS(*image, *file, *decoded));
+                return [decoded, decodedImage]()
+                {
+                    return UploadDDS(*decodedImage, *decoded);
+                };
+            }
 
-        return 0;//if it is too big, just return 0; not worth an exception
-    }
+            return [file, image]()
+            {
+                return UploadDDS(*image, *file);
+            };
+        }
 
-    virtual void buffer_element(void* data, size_t element) override
-    {
-        size_t i = 0;
-        if (element < v2.size())
+        return [file, format]()
         {
-            v2[element] = static_cast<aiVector2D*>(data)[0];
-            return;
-        }
+            return LoadTextureFromMemory(*file, format);
+        };
+    });
+}
 
-        i += v2.size();
+//--------------------------------------------------------------------------------------
+std::future<ProgramPtr> AsyncLoader::CreateProgramFromFilesAsync(const ShaderPathList& shaderPaths, bool separate)
+{
+    auto promise = std::make_shared<std::promise<ProgramPtr>>();
+    std::future<ProgramPtr> ret = promise->get_future();
 
-        if (element < i + v3.size())
+    QueueWork([this, promise, shaderPaths, separate]()
+    {
+        auto sources = std::make_shared<ShaderSourceList>();
+        try
         {
-            v3[element - i] = static_cast<aiVector3D*>(data)[0];
-            return;
-        }
-
-        i += v3.size();
+            for (auto it : shaderPaths)
+            {
+                std::string text;
+                LoadFileIntoMemory(it.second, text);
 
-        if (element < i + v4.size())
+                //newline here is needed, because end of loaded file might not have one
+                text += "\n";
+                sources->insert({ it.first, std::move(text) });
+            }
+        }
+        catch (...)
         {
-            v4[element - i] = static_cast<aiColor4D*>(data)[0];
+            promise->set_exception(std::current_exception());
             return;
         }
-    }
 
-    static GLVector<AssimpVertexStruct> MakeMany(size_t howMany, size_t vec2Cnt, size_t vec3Cnt, size_t vec4Cnt)
-    {
-        GLVector<AssimpVertexStruct> ret;
-        ret.reserve(howMany);
+        //submit on the context thread, then poll once per 'ProcessUploads' instead of blocking on the driver
+        QueueUpload([this, promise, sources, separate]()
+        {
+            PendingProgramPtr pending;
+            SHADERMANAGER.SubmitProgram(pending, *sources, separate);
 
-        //the individual struct object that will be cloned to fill the return vector
-        AssimpVertexStruct clone{ vec2Cnt, vec3Cnt, vec4Cnt };
-        
-        //use 'fill' version of vector::insert for increased speed
-        ret.insert(ret.begin(), howMany, clone);
+            QueuePoll([promise, pending]()
+            {
+                if (!SHADERMANAGER.IsProgramReady(pending))
+                    return false;
 
-        return ret;
-    }
-};
+                try
+                {
+                    ProgramPtr program;
+                    SHADERMANAGER.ResolveProgram(program, pending);
+                    promise->set_value(program);
+                }
+                catch (...)
+                {
+                    promise->set_exception(std::current_exception());
+                }
+                return true;
+            });
+        });
+    });
 
+    return ret;
+}
 
 //--------------------------------------------------------------------------------------
-std::shared_ptr<VertexArray> LoadVertexArrayFromScene(const aiScene* scene, const VertexAttribMap& inputs, GLuint meshNum)
+std::future<VertexArrayPtr> AsyncLoader::LoadVertexArrayFromFileAsync(const std::string& filePath, const VertexAttribMap& inputs, unsigned int postProcessFlags, GLuint meshNum)
 {
-    if (meshNum > scene->mNumMeshes)
-        GLUF_CRITICAL_EXCEPTION(std::invalid_argument("\"meshNum\" is higher than the number of meshes in \"scene\""));
+    return LoadAsync<VertexArrayPtr>([filePath, inputs, postProcessFlags, meshNum]() -> std::function<VertexArrayPtr()>
+    {
+        //each load gets its own importer, because they are not thread-safe
+        Assimp::Importer importer;
+        const aiScene* scene = LoadSceneFromFile(importer, filePath, postProcessFlags);
+        if (scene == nullptr)
+            throw std::runtime_error("(LoadVertexArrayFromFileAsync): Failed to import \"" + filePath + "\"");
 
-    const aiMesh* mesh = scene->mMeshes[meshNum];
+        //convert here too, so only the buffer uploads are left for the context thread
+        auto meshData = std::make_shared<MeshData>(ConvertMeshFromScene(scene, inputs, meshNum));
+        return [meshData]()
+        {
+            return LoadVertexArrayFromMeshData(*meshData);
+        };
+    });
+}
 
-    auto vertexData = std::make_shared<VertexArray>(GL_TRIANGLES, GL_STATIC_DRAW, mesh->HasFaces());
 
-    //which vertex attributes go where in assimp loading vertex struct
-    std::map<AttribLoc, int> vertexAttribLoc;
+/*
+======================================================================================================================================================================================================
+Texture Streaming
 
-    //the number of each vec type
-    unsigned char numVec2 = 0;
-    unsigned char numVec3 = 0;
-    unsigned char numVec4 = 0;
+*/
 
-    auto itUV0 = inputs.find(GLUF_VERTEX_ATTRIB_UV0);
-    auto it = itUV0;
-    if (mesh->HasTextureCoords(0) && it != inputs.end())
-    {
-        vertexData->AddVertexAttrib(it->second, numVec2 * 8);
-        vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV0] = numVec2;
-        ++numVec2;
-    }
+TextureStreamer g_TextureStreamer;
 
-    auto itUV1 = inputs.find(GLUF_VERTEX_ATTRIB_UV1);
-    it = itUV1;
-    if (mesh->HasTextureCoords(1) && it != inputs.end())
-    {
-        vertexData->AddVertexAttrib(it->second, numVec2 * 8);
-        vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV1] = numVec2;
-        ++numVec2;
-    }
+namespace TextureStreaming
+{
+    //'StagingBuffer::mState'
+    const unsigned int g_Free = 0;
+    const unsigned int g_Copying = 1;//a worker is copying a level in
+    const unsigned int g_Copied = 2;//ready to upload
+    const unsigned int g_InFlight = 3;//uploaded; waiting for the GPU to finish reading it
 
-    auto itUV2 = inputs.find(GLUF_VERTEX_ATTRIB_UV2);
-    it = itUV2;
-    if (mesh->HasTextureCoords(2) && it != inputs.end())
+    //--------------------------------------------------------------------------------------
+    //false once a progressive texture's handle has been released, which deletes the texture
+    template<typename Job>
+    bool IsStreamJobLive(const Job& job)
     {
-        vertexData->AddVertexAttrib(it->second, numVec2 * 8);
-        vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV2] = numVec2;
-        ++numVec2;
+        return !job.mCancelled && (!job.mProgressive || !job.mHandle.expired());
     }
 
-    auto itUV3 = inputs.find(GLUF_VERTEX_ATTRIB_UV3);
-    it = itUV3;
-    if (mesh->HasTextureCoords(3) && it != inputs.end())
+    //--------------------------------------------------------------------------------------
+    //swaps the job's data for decoded texels if the context can not sample its format
+    template<typename Job>
+    void DecodeIfUnsupported(Job& job)
     {
-        vertexData->AddVertexAttrib(it->second, numVec2 * 8);
-        vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV3] = numVec2;
-        ++numVec2;
-    }
+        if (job.mImage->mCompressedFormat == 0 || IsCompressedFormatSupported(job.mImage->mCompressedFormat))
+            return;
 
-    auto itUV4 = inputs.find(GLUF_VERTEX_ATTRIB_UV4);
-    it = itUV4;
-    if (mesh->HasTextureCoords(4) && it != inputs.end())
-    {
-        vertexData->AddVertexAttrib(it->second, numVec2 * 8);
-        vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV4] = numVec2;
-        ++numVec2;
+        auto decoded = std::make_shared<std::vector<char>>();
+        job.mImage = std::make_shared<DDSImage>(DecompressDDS(*job.mImage, job.mData, *decoded));
+        job.mData = *decoded;
+        job.mOwner = decoded;
     }
+}
 
-    auto itUV5 = inputs.find(GLUF_VERTEX_ATTRIB_UV5);
-    it = itUV5;
-    if (mesh->HasTextureCoords(5) && it != inputs.end())
-    {
-        vertexData->AddVertexAttrib(it->second, numVec2 * 8);
-        vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV5] = numVec2;
-        ++numVec2;
-    }
+//--------------------------------------------------------------------------------------
+StreamedTexture::~StreamedTexture()
+{
+    if (mTextureId != 0)
+        GLSTATE.DeleteTextures(1, &mTextureId);
+}
 
-    auto itUV6 = inputs.find(GLUF_VERTEX_ATTRIB_UV6);
-    it = itUV6;
-    if (mesh->HasTextureCoords(6) && it != inputs.end())
-    {
-        vertexData->AddVertexAttrib(it->second, numVec2 * 8);
-        vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV6] = numVec2;
-        ++numVec2;
-    }
+//--------------------------------------------------------------------------------------
+TextureStreamer::~TextureStreamer() noexcept
+{
+    Destroy();
+}
 
-    auto itUV7 = inputs.find(GLUF_VERTEX_ATTRIB_UV7);
-    it = itUV7;
-    if (mesh->HasTextureCoords(7) && it != inputs.end())
+//--------------------------------------------------------------------------------------
+void TextureStreamer::Init(GLuint bufferCount, std::size_t bufferSize, std::size_t frameBudget, bool allowPersistent)
+{
+    Destroy();
+
+    if (gGLVersion2Digit < 30 && !gExtensions.HasExtension("GL_ARB_map_buffer_range"))
     {
-        vertexData->AddVertexAttrib(it->second, numVec2 * 8);
-        vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV7] = numVec2;
-        ++numVec2;
+        GLUF_ERROR("(TextureStreamer): Texture Streaming Requires OpenGL 3.0 or GL_ARB_map_buffer_range");
+        GLUF_CRITICAL_EXCEPTION(MakeBufferException());
     }
 
+    mBufferSize = std::max<std::size_t>(bufferSize, 1);
+    mFrameBudget = frameBudget;
 
-    unsigned int runningOffsetTotal = numVec2 * 8;
-
+    //without fences a persistent buffer could be overwritten while the GPU still reads it
+    mFences = glFenceSync != nullptr && (gGLVersion2Digit >= 32 || gExtensions.HasExtension("GL_ARB_sync"));
+    mPersistent = allowPersistent && mFences && glBufferStorage != nullptr &&
+        (gGLVersion2Digit >= 44 || gExtensions.HasExtension("GL_ARB_buffer_storage"));
 
-    //vec3's go between vec2's and vec4's
-    auto itPos = inputs.find(GLUF_VERTEX_ATTRIB_POSITION);
-    it = itPos;
-    if (mesh->HasPositions() && it != inputs.end())
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    for (GLuint i = 0; i < std::max(bufferCount, 1u); ++i)
     {
-        vertexData->AddVertexAttrib(it->second, numVec3 * 12 + runningOffsetTotal);
-        vertexAttribLoc[GLUF_VERTEX_ATTRIB_POSITION] = numVec3 + numVec2;
-        ++numVec3;
-    }
+        mBuffers.push_back(std::unique_ptr<StagingBuffer>(new StagingBuffer()));
+        StagingBuffer& buffer = *mBuffers.back();
 
-    auto itNorm = inputs.find(GLUF_VERTEX_ATTRIB_NORMAL);
-    it = itNorm;
-    if (mesh->HasNormals() && it != inputs.end())
-    {
-        vertexData->AddVertexAttrib(it->second, numVec3 * 12 + runningOffsetTotal);
-        vertexAttribLoc[GLUF_VERTEX_ATTRIB_NORMAL] = numVec3 + numVec2;
-        ++numVec3;
+        glGenBuffers(1, &buffer.mBufferId);
+        if (buffer.mBufferId == 0)
+        {
+            Destroy();
+            GLUF_CRITICAL_EXCEPTION(MakeBufferException());
+        }
+
+        GLSTATE.BindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.mBufferId);
+        if (mPersistent)
+        {
+            glBufferStorage(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(mBufferSize), nullptr, flags);
+            buffer.mMapped = static_cast<char*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(mBufferSize), flags));
+            if (buffer.mMapped == nullptr)
+            {
+                Destroy();
+                GLUF_CRITICAL_EXCEPTION(MakeBufferException());
+            }
+        }
+        else
+        {
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(mBufferSize), nullptr, GL_STREAM_DRAW);
+        }
     }
+    GLSTATE.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
 
+//--------------------------------------------------------------------------------------
+void TextureStreamer::Destroy() noexcept
+{
+    using namespace TextureStreaming;
 
-    auto itTan = inputs.find(GLUF_VERTEX_ATTRIB_TAN);
-    auto itBitan = inputs.find(GLUF_VERTEX_ATTRIB_BITAN);
-    if (mesh->HasTangentsAndBitangents() && itTan != inputs.end() && itBitan != inputs.end())
+    if (mBuffers.empty())
+        return;
+
+    //every job still referenced here is unfinished
+    std::vector<std::shared_ptr<StreamJob>> unfinished(mJobs.begin(), mJobs.end());
+    for (auto& it : mBuffers)
     {
-        vertexData->AddVertexAttrib(itTan->second, numVec3 * 12 + runningOffsetTotal);
-        vertexData->AddVertexAttrib(itBitan->second, (numVec3 + 1) * 12 + runningOffsetTotal);
-        vertexAttribLoc[GLUF_VERTEX_ATTRIB_TAN] = numVec3 + numVec2;
-        vertexAttribLoc[GLUF_VERTEX_ATTRIB_BITAN] = numVec3 + 1 + numVec2;
-        numVec3 += 2;
-    }
+        //workers may still be writing into the mapping
+        while (it->mState.load(std::memory_order_acquire) == g_Copying)
+            std::this_thread::yield();
 
-    //to keep from doing unncessessary addition
-    unsigned char runningTotal = numVec3 + numVec2;
+        if (it->mJob && it->mJob->mPendingLevels > 0 && std::find(unfinished.begin(), unfinished.end(), it->mJob) == unfinished.end())
+            unfinished.push_back(it->mJob);
 
-    runningOffsetTotal += numVec3 * 12;
+        if (it->mFence != nullptr)
+            glDeleteSync(it->mFence);
 
-    auto itCol0 = inputs.find(GLUF_VERTEX_ATTRIB_COLOR0);
-    it = itCol0;
-    if (mesh->HasVertexColors(0) && it != inputs.end())
-    {
-        vertexData->AddVertexAttrib(it->second, numVec4 * 16 + runningOffsetTotal);
-        vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR0] = numVec4 + runningTotal;
-        ++numVec4;
+        if (it->mBufferId != 0)
+        {
+            if (it->mMapped != nullptr)
+            {
+                GLSTATE.BindBuffer(GL_PIXEL_UNPACK_BUFFER, it->mBufferId);
+                glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            }
+            GLSTATE.DeleteBuffers(1, &it->mBufferId);
+        }
     }
+    GLSTATE.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 
-    auto itCol1 = inputs.find(GLUF_VERTEX_ATTRIB_COLOR1);
-    it = itCol1;
-    if (mesh->HasVertexColors(1) && it != inputs.end())
+    //progressive textures belong to their handles
+    for (auto& it : unfinished)
     {
-        vertexData->AddVertexAttrib(it->second, numVec4 * 16 + runningOffsetTotal);
-        vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR1] = numVec4 + runningTotal;
-        ++numVec4;
+        if (!it->mProgressive)
+            GLSTATE.DeleteTextures(1, &it->mTextureId);
     }
 
-    auto itCol2 = inputs.find(GLUF_VERTEX_ATTRIB_COLOR2);
-    it = itCol2;
-    if (mesh->HasVertexColors(2) && it != inputs.end())
-    {
-        vertexData->AddVertexAttrib(it->second, numVec4 * 16 + runningOffsetTotal);
-        vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR2] = numVec4 + runningTotal;
-        ++numVec4;
-    }
+    mBuffers.clear();
+    mJobs.clear();
 
-    auto itCol3 = inputs.find(GLUF_VERTEX_ATTRIB_COLOR3);
-    it = itCol3;
-    if (mesh->HasVertexColors(3) && it != inputs.end())
-    {
-        vertexData->AddVertexAttrib(it->second, numVec4 * 16 + runningOffsetTotal);
-        vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR3] = numVec4 + runningTotal;
-        ++numVec4;
-    }
+    mBufferSize = 0;
+    mPersistent = false;
+    mFences = false;
 
-    auto itCol4 = inputs.find(GLUF_VERTEX_ATTRIB_COLOR4);
-    it = itCol4;
-    if (mesh->HasVertexColors(4) && it != inputs.end())
-    {
-        vertexData->AddVertexAttrib(it->second, numVec4 * 16 + runningOffsetTotal);
-        vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR4] = numVec4 + runningTotal;
-        ++numVec4;
-    }
-    
-    auto itCol5 = inputs.find(GLUF_VERTEX_ATTRIB_COLOR5);
-    it = itCol5;
-    if (mesh->HasVertexColors(5) && it != inputs.end())
-    {
-        vertexData->AddVertexAttrib(it->second, numVec4 * 16 + runningOffsetTotal);
-        vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR5] = numVec4 + runningTotal;
-        ++numVec4;
-    }
+    //a poll queued before this can not be removed from 'ASYNCLOADER', so it is told to drop itself instead
+    mPollQueued = false;
+    ++mPollGeneration;
+    mStats.mQueuedBytes = 0;
+    mStats.mInFlightBytes = 0;
+    mStats.mQueuedTextures = 0;
+}
 
-    auto itCol6 = inputs.find(GLUF_VERTEX_ATTRIB_COLOR6);
-    it = itCol6;
-    if (mesh->HasVertexColors(6) && it != inputs.end())
+//--------------------------------------------------------------------------------------
+std::future<GLuint> TextureStreamer::StreamTextureFromFileAsync(const std::string& filePath)
+{
+    auto promise = std::make_shared<std::promise<GLuint>>();
+    std::future<GLuint> ret = promise->get_future();
+
+    ASYNCLOADER.QueueWork([this, promise, filePath]()
     {
-        vertexData->AddVertexAttrib(it->second, numVec4 * 16 + runningOffsetTotal);
-        vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR6] = numVec4 + runningTotal;
-        ++numVec4;
-    }
+        auto job = std::make_shared<StreamJob>();
+        job->mPromise = promise;
+        try
+        {
+            MappedFilePtr file = MapFile(filePath);
+            job->mImage = std::make_shared<DDSImage>(ParseDDS(*file));
+            job->mData = *file;
+            job->mOwner = file;
+            TextureStreaming::DecodeIfUnsupported(*job);
+        }
+        catch (...)
+        {
+            promise->set_exception(std::current_exception());
+            return;
+        }
 
-    auto itCol7 = inputs.find(GLUF_VERTEX_ATTRIB_COLOR7);
-    it = itCol7;
-    if (mesh->HasVertexColors(7) && it != inputs.end())
+        ASYNCLOADER.QueueUpload([this, job]()
+        {
+            try
+            {
+                Enqueue(job);
+            }
+            catch (...)
+            {
+                job->mPromise->set_exception(std::current_exception());
+            }
+        });
+    });
+
+    return ret;
+}
+
+//--------------------------------------------------------------------------------------
+std::future<GLuint> TextureStreamer::StreamDDS(std::shared_ptr<const DDSImage> image, const MemorySpan& rawData, std::shared_ptr<const void> owner)
+{
+    GLUF_NULLPTR_CHECK(image);
+
+    auto job = std::make_shared<StreamJob>();
+    job->mImage = std::move(image);
+    job->mData = rawData;
+    job->mOwner = std::move(owner);
+    job->mPromise = std::make_shared<std::promise<GLuint>>();
+
+    std::future<GLuint> ret = job->mPromise->get_future();
+    Enqueue(job);
+
+    return ret;
+}
+
+//--------------------------------------------------------------------------------------
+StreamedTexturePtr TextureStreamer::StreamTextureFromFileProgressive(const std::string& filePath, float priority)
+{
+    auto handle = std::make_shared<StreamedTexture>();
+    handle->SetPriority(priority);
+
+    std::weak_ptr<StreamedTexture> weakHandle = handle;
+    ASYNCLOADER.QueueWork([this, weakHandle, filePath]()
     {
-        vertexData->AddVertexAttrib(it->second, numVec4 * 16 + runningOffsetTotal);
-        vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR7] = numVec4 + runningTotal;
-        ++numVec4;
-    }
+        auto job = std::make_shared<StreamJob>();
+        job->mHandle = weakHandle;
+        job->mProgressive = true;
 
+        std::string error;
+        try
+        {
+            MappedFilePtr file = MapFile(filePath);
+            job->mImage = std::make_shared<DDSImage>(ParseDDS(*file));
+            job->mData = *file;
+            job->mOwner = file;
+            TextureStreaming::DecodeIfUnsupported(*job);
+        }
+        catch (const std::exception& e)
+        {
+            error = e.what();
+        }
 
+        //the handle may only be touched on the context thread
+        ASYNCLOADER.QueueUpload([this, job, error]()
+        {
+            try
+            {
+                if (!error.empty())
+                    throw std::runtime_error(error);
+                Enqueue(job);
+            }
+            catch (const std::exception& e)
+            {
+                GLUF_ERROR_LONG("(TextureStreamer): Failed to Stream a Texture: " << e.what());
+                if (StreamedTexturePtr handle = job->mHandle.lock())
+                    handle->mFailed = true;
+            }
+        });
+    });
 
-    //the custom vertex array
-    GLVector<AssimpVertexStruct> vertexBuffer = AssimpVertexStruct::MakeMany(mesh->mNumVertices, numVec2, numVec3, numVec4);
+    return handle;
+}
 
-    if (mesh->HasPositions() && itPos != inputs.end())
-    {
-        //positions will ALWAYS be the first vec3
-        vertexBuffer.buffer_element(mesh->mVertices, vertexAttribLoc[GLUF_VERTEX_ATTRIB_POSITION]);
-    }
-    if (mesh->HasNormals() && itNorm != inputs.end())
-    {
-        vertexBuffer.buffer_element(mesh->mNormals, vertexAttribLoc[GLUF_VERTEX_ATTRIB_NORMAL]);
-    }
+//--------------------------------------------------------------------------------------
+StreamedTexturePtr TextureStreamer::StreamDDSProgressive(std::shared_ptr<const DDSImage> image, const MemorySpan& rawData, std::shared_ptr<const void> owner, float priority)
+{
+    GLUF_NULLPTR_CHECK(image);
 
+    auto handle = std::make_shared<StreamedTexture>();
+    handle->SetPriority(priority);
 
+    auto job = std::make_shared<StreamJob>();
+    job->mImage = std::move(image);
+    job->mData = rawData;
+    job->mOwner = std::move(owner);
+    job->mHandle = handle;
+    job->mProgressive = true;
 
-    /*
+    Enqueue(job);
 
-    Instead of flipping the pixels when loading textures, UV's will be flipped instead
+    return handle;
+}
 
-    Also, since we are using 2 dimmentional texture coordinates, make sure to convert to 2 element vectors
+//--------------------------------------------------------------------------------------
+void TextureStreamer::Enqueue(const std::shared_ptr<StreamJob>& job)
+{
+    if (mBuffers.empty())
+        GLUF_CRITICAL_EXCEPTION(std::logic_error("(TextureStreamer): Not Initialized"));
 
-    */
+    //the file loaders already decoded on a worker
+    TextureStreaming::DecodeIfUnsupported(*job);
+    const DDSImage& image = *job->mImage;
 
-    //note: data2D must be size in length
-    const auto FlipAndConvertUVArray = [](aiVector3D* data, aiVector2D*& data2D, const unsigned int size)
+    StreamedTexturePtr handle;
+    if (job->mProgressive)
     {
-        for (unsigned int i = 0; i < size; ++i)
-        {
-            data2D[i].x = data[i].x;
-            data2D[i].y = 1.0f - data[i].y;
-        }
-    };
+        //released before it was even created
+        handle = job->mHandle.lock();
+        if (!handle)
+            return;
+    }
 
-    aiVector2D* data2D = nullptr;
-    if (mesh->HasTextureCoords(0) && itUV0 != inputs.end())
-    {
-        //do not initialize data2D until here, because if there is not a first texture coord, then there wil be no others
-        data2D = new aiVector2D[mesh->mNumVertices];
+    //every level is defined up front, so the levels can be filled in any order
+    job->mTextureId = DDS::CreateTexture(image, true);
 
-        FlipAndConvertUVArray(mesh->mTextureCoords[0], data2D, mesh->mNumVertices);
-        vertexBuffer.buffer_element(data2D, vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV0]);
-    }
-    if (mesh->HasTextureCoords(1) && itUV1 != inputs.end())
-    {
-        FlipAndConvertUVArray(mesh->mTextureCoords[1], data2D, mesh->mNumVertices);
-        vertexBuffer.buffer_element(data2D, vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV1]);
-    }
-    if (mesh->HasTextureCoords(2) && itUV2 != inputs.end())
-    {
-        FlipAndConvertUVArray(mesh->mTextureCoords[2], data2D, mesh->mNumVertices);
-        vertexBuffer.buffer_element(data2D, vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV2]);
-    }
-    if (mesh->HasTextureCoords(3) && itUV3 != inputs.end())
-    {
-        FlipAndConvertUVArray(mesh->mTextureCoords[3], data2D, mesh->mNumVertices);
-        vertexBuffer.buffer_element(data2D, vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV3]);
-    }
-    if (mesh->HasTextureCoords(4) && itUV4 != inputs.end())
-    {
-        FlipAndConvertUVArray(mesh->mTextureCoords[4], data2D, mesh->mNumVertices);
-        vertexBuffer.buffer_element(data2D, vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV4]);
-    }
-    if (mesh->HasTextureCoords(5) && itUV5 != inputs.end())
-    {
-        FlipAndConvertUVArray(mesh->mTextureCoords[5], data2D, mesh->mNumVertices);
-        vertexBuffer.buffer_element(data2D, vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV5]);
-    }
-    if (mesh->HasTextureCoords(6) && itUV6 != inputs.end())
+    std::size_t layerFaces = static_cast<std::size_t>(image.mLayers) * image.mFaces;
+    job->mOrder.reserve(image.mMipLevels.size());
+    if (handle)
     {
-        FlipAndConvertUVArray(mesh->mTextureCoords[6], data2D, mesh->mNumVertices);
-        vertexBuffer.buffer_element(data2D, vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV6]);
-    }
-    if (mesh->HasTextureCoords(7) && itUV7 != inputs.end())
-    {
-        FlipAndConvertUVArray(mesh->mTextureCoords[7], data2D, mesh->mNumVertices);
-        vertexBuffer.buffer_element(data2D, vertexAttribLoc[GLUF_VERTEX_ATTRIB_UV7]);
-    }
-    delete[] data2D;
+        //nothing is drawable until the smallest level arrives
+        glTexParameteri(image.mTarget, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(image.mMipCount) - 1);
 
+        handle->mTextureId = job->mTextureId;
+        handle->mTarget = image.mTarget;
+        handle->mMipCount = image.mMipCount;
+        handle->mBaseLevel = image.mMipCount;
 
-    if (mesh->HasVertexColors(0) && itCol0 != inputs.end())
-    {
-        vertexBuffer.buffer_element(mesh->mColors[0], vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR0]);
-    }
-    if (mesh->HasVertexColors(1) && itCol1 != inputs.end())
-    {
-        vertexBuffer.buffer_element(mesh->mColors[1], vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR1]);
-    }
-    if (mesh->HasVertexColors(2) && itCol2 != inputs.end())
-    {
-        vertexBuffer.buffer_element(mesh->mColors[2], vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR2]);
-    }
-    if (mesh->HasVertexColors(3) && itCol3 != inputs.end())
-    {
-        vertexBuffer.buffer_element(mesh->mColors[3], vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR3]);
+        //smallest level first, every face of a level together
+        for (unsigned int level = image.mMipCount; level-- > 0;)
+        {
+            for (std::size_t layerFace = 0; layerFace < layerFaces; ++layerFace)
+                job->mOrder.push_back(layerFace * image.mMipCount + level);
+        }
+        job->mFacesLeft.assign(image.mMipCount, static_cast<unsigned int>(layerFaces));
     }
-    if (mesh->HasVertexColors(4) && itCol4 != inputs.end())
+    else
     {
-        vertexBuffer.buffer_element(mesh->mColors[4], vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR4]);
+        for (std::size_t i = 0; i < image.mMipLevels.size(); ++i)
+            job->mOrder.push_back(i);
     }
-    if (mesh->HasVertexColors(5) && itCol5 != inputs.end())
+    GLSTATE.BindTexture(image.mTarget, 0);
+
+    for (const auto& it : image.mMipLevels)
+        mStats.mQueuedBytes += it.mSize;
+    ++mStats.mQueuedTextures;
+    mJobs.push_back(job);
+
+    if (!mPollQueued)
     {
-        vertexBuffer.buffer_element(mesh->mColors[5], vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR5]);
+        mPollQueued = true;
+        unsigned int generation = mPollGeneration;
+        ASYNCLOADER.QueuePoll([this, generation]()
+        {
+            //'Destroy' ran since this was queued; a newer poll owns 'mPollQueued' now
+            if (generation != mPollGeneration)
+                return true;
+
+            if (!Update())
+                return false;
+
+            mPollQueued = false;
+            return true;
+        });
     }
-    if (mesh->HasVertexColors(6) && itCol6 != inputs.end())
+}
+
+//--------------------------------------------------------------------------------------
+bool TextureStreamer::Update()
+{
+    GLUF_PROFILE_ZONE("TextureStreamer::Update");
+
+    using namespace TextureStreaming;
+
+    mStats.mFrameBytes = 0;
+    if (mBuffers.empty())
+        return true;
+
+    //recycle the buffers the GPU is done with, and upload the ones the workers have filled
+    for (auto& it : mBuffers)
     {
-        vertexBuffer.buffer_element(mesh->mColors[6], vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR6]);
+        unsigned int state = it->mState.load(std::memory_order_acquire);
+        if (state == g_InFlight)
+            Retire(*it);
+        else if (state == g_Copied)
+            Submit(*it);
     }
-    if (mesh->HasVertexColors(7) && itCol7 != inputs.end())
+    GLSTATE.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    //drop the progressive textures nobody wants anymore
+    for (auto it = mJobs.begin(); it != mJobs.end();)
     {
-        vertexBuffer.buffer_element(mesh->mColors[7], vertexAttribLoc[GLUF_VERTEX_ATTRIB_COLOR7]);
+        if ((*it)->mProgressive && (*it)->mHandle.expired())
+        {
+            Cancel(**it);
+            it = mJobs.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
     }
-    if (mesh->HasTangentsAndBitangents() && itBitan != inputs.end() && itTan != inputs.end())
+
+    //then start copying queued levels into the free ones
+    auto freeBuffer = mBuffers.begin();
+    while (!mJobs.empty())
     {
-        vertexBuffer.buffer_element(mesh->mTangents, vertexAttribLoc[GLUF_VERTEX_ATTRIB_TAN]);
-        vertexBuffer.buffer_element(mesh->mBitangents, vertexAttribLoc[GLUF_VERTEX_ATTRIB_BITAN]);
-    }
+        auto jobIt = PickJob();
+        std::shared_ptr<StreamJob> job = *jobIt;
+        std::size_t level = job->mOrder[job->mNextLevel];
+        std::size_t size = job->mImage->mMipLevels[level].mSize;
 
-    //don't forget to buffer the actual data :) (i actually forgot this part at first)
-    vertexData->BufferData(vertexBuffer);
+        if (mStats.mFrameBytes > 0 && mStats.mFrameBytes + size > mFrameBudget)
+            break;
 
+        if (size <= mBufferSize)
+        {
+            while (freeBuffer != mBuffers.end() && (*freeBuffer)->mState.load(std::memory_order_acquire) != g_Free)
+                ++freeBuffer;
+            if (freeBuffer == mBuffers.end())
+                break;
+        }
 
-    std::vector<glm::u32vec3> indices;
-    for (unsigned int i = 0; i < mesh->mNumFaces; ++i)
+        if (++job->mNextLevel == job->mOrder.size())
+            mJobs.erase(jobIt);
+        mStats.mQueuedBytes -= size;
+        mStats.mFrameBytes += size;
+
+        ++job->mPendingLevels;
+        if (size > mBufferSize || !Stage(**freeBuffer, job, level))
+            UploadDirect(job, level);
+    }
+    GLSTATE.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    return IsIdle();
+}
+
+//--------------------------------------------------------------------------------------
+std::deque<std::shared_ptr<TextureStreamer::StreamJob>>::iterator TextureStreamer::PickJob()
+{
+    //whole textures go in order, ahead of refining progressive ones, and every progressive texture gets its
+    //  smallest level before any of them are refined
+    auto best = mJobs.end();
+    float bestPriority = 0.0f;
+    for (auto it = mJobs.begin(); it != mJobs.end(); ++it)
     {
-        aiFace curr = mesh->mFaces[i];
-        indices.push_back({ curr.mIndices[0], curr.mIndices[1], curr.mIndices[2] });
+        if (!(*it)->mProgressive || (*it)->mNextLevel == 0)
+            return it;
+
+        StreamedTexturePtr handle = (*it)->mHandle.lock();
+        float priority = handle ? handle->GetPriority() : 0.0f;
+        if (best == mJobs.end() || priority > bestPriority)
+        {
+            best = it;
+            bestPriority = priority;
+        }
     }
-    vertexData->BufferIndices(indices);
 
-    return vertexData;
+    return best;
 }
 
+//--------------------------------------------------------------------------------------
+void TextureStreamer::Cancel(StreamJob& job)
+{
+    //the levels already started finish on their own, but are not uploaded
+    for (std::size_t i = job.mNextLevel; i < job.mOrder.size(); ++i)
+        mStats.mQueuedBytes -= job.mImage->mMipLevels[job.mOrder[i]].mSize;
+
+    job.mNextLevel = job.mOrder.size();
+    job.mCancelled = true;
+    if (job.mPendingLevels == 0)
+        --mStats.mQueuedTextures;
+}
 
 //--------------------------------------------------------------------------------------
-std::vector<std::shared_ptr<VertexArray>> LoadVertexArraysFromScene(const aiScene* scene, GLuint meshOffset, GLuint numMeshes)
+bool TextureStreamer::Stage(StagingBuffer& buffer, const std::shared_ptr<StreamJob>& job, std::size_t level)
 {
-    std::vector<std::shared_ptr<VertexArray>> arrays;
+    using namespace TextureStreaming;
 
-    if (numMeshes > scene->mNumMeshes)
+    const DDSMipLevel& mip = job->mImage->mMipLevels[level];
+
+    char* dest = buffer.mMapped;
+    if (!mPersistent)
     {
-        arrays.push_back(nullptr);
-        return arrays;
+        //invalidating lets the driver hand back fresh memory if the last upload from this buffer is still pending
+        GLSTATE.BindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.mBufferId);
+        dest = static_cast<char*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(mip.mSize), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+        if (dest == nullptr)
+        {
+            GLUF_ERROR("(TextureStreamer): Failed to Map a Staging Buffer");
+            return false;
+        }
+        buffer.mMapped = dest;
     }
 
-    for(unsigned int cnt = 0; cnt < numMeshes; ++cnt)
+    buffer.mJob = job;
+    buffer.mLevel = level;
+    buffer.mState.store(g_Copying, std::memory_order_relaxed);
+    mStats.mInFlightBytes += mip.mSize;
+
+    //'job' keeps the source alive, and 'Destroy' waits for the copy, so neither pointer can dangle
+    StagingBuffer* target = &buffer;
+    const char* source = job->mData.data() + mip.mOffset;
+    std::size_t size = mip.mSize;
+    ASYNCLOADER.QueueWork([target, dest, source, size]()
     {
-        arrays.push_back(LoadVertexArrayFromScene(scene, cnt));//new VertexArray(GL_TRIANGLES, GL_STATIC_DRAW, mesh->HasFaces());
-    }
-    return arrays;
+        std::memcpy(dest, source, size);
+        target->mState.store(g_Copied, std::memory_order_release);
+    });
+
+    return true;
 }
 
-/*
-VertexArray* LoadVertexArrayFromFile(std::string path)
+//--------------------------------------------------------------------------------------
+void TextureStreamer::Submit(StagingBuffer& buffer)
 {
-    Assimp::Importer importer;
-    const aiScene* scene = importer.ReadFile(path,
-        aiProcess_CalcTangentSpace |
-        aiProcess_Triangulate |
-        aiProcess_JoinIdenticalVertices |
-        aiProcess_SortByPType);
+    using namespace TextureStreaming;
 
-    const aiMesh* mesh = scene->mMeshes[0];
+    std::shared_ptr<StreamJob> job = buffer.mJob;
+    const DDSMipLevel& mip = job->mImage->mMipLevels[buffer.mLevel];
 
-    VertexArray vertexData(GL_TRIANGLES, GL_STATIC_DRAW, mesh->HasFaces());
+    GLSTATE.BindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.mBufferId);
+    if (!mPersistent)
+    {
+        buffer.mMapped = nullptr;
 
-    if (mesh->HasPositions())
-        vertexData.AddVertexAttrib(g_attribPOS);
-    if (mesh->HasNormals())
-        vertexData.AddVertexAttrib(g_attribNORM);
-    if (mesh->HasTextureCoords(0))
-        vertexData.AddVertexAttrib(g_attribUV);
-    if (mesh->HasTangentsAndBitangents())
+        //the contents are lost if the mapping was invalidated (i.e. by a display mode change)
+        if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_FALSE)
+        {
+            GLUF_ERROR("(TextureStreamer): Staging Buffer Contents Were Lost; Uploading From Client Memory");
+
+            mStats.mInFlightBytes -= mip.mSize;
+            buffer.mJob.reset();
+            buffer.mState.store(g_Free, std::memory_order_relaxed);
+
+            UploadDirect(job, buffer.mLevel);
+            return;
+        }
+    }
+
+    //the texture of a released handle is already gone
+    std::size_t level = buffer.mLevel;
+    if (TextureStreaming::IsStreamJobLive(*job))
     {
-        vertexData.AddVertexAttrib(g_attribTAN);
-        vertexData.AddVertexAttrib(g_attribBITAN);
+        //the data pointer is an offset into the bound staging buffer
+        GLSTATE.BindTexture(job->mImage->mTarget, job->mTextureId);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        DDS::UploadLevel(*job->mImage, mip, nullptr, true);
+        GLSTATE.BindTexture(job->mImage->mTarget, 0);
+
+        mStats.mStreamedBytes += mip.mSize;
     }
-    if (mesh->HasVertexColors(0))
-        vertexData.AddVertexAttrib(g_attribCOLOR);
 
+    buffer.mState.store(g_InFlight, std::memory_order_relaxed);
+    if (mFences)
+        buffer.mFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    else
+        Retire(buffer);
 
-    if (mesh->HasPositions())
-        vertexData.BufferData(VERTEX_ATTRIB_POSITION, mesh->mNumVertices, mesh->mVertices);
-    if (mesh->HasNormals())
-        vertexData.BufferData(VERTEX_ATTRIB_NORMAL, mesh->mNumVertices, mesh->mNormals);
-    if (mesh->HasTextureCoords(0))
-        vertexData.BufferData(VERTEX_ATTRIB_UV, mesh->mNumVertices, AssimpToGlm3_2(mesh->mTextureCoords[0], mesh->mNumVertices));
-    if (mesh->HasTangentsAndBitangents())
+    FinishLevel(job, level);
+}
+
+//--------------------------------------------------------------------------------------
+void TextureStreamer::Retire(StagingBuffer& buffer)
+{
+    using namespace TextureStreaming;
+
+    if (buffer.mFence != nullptr)
     {
-        vertexData.BufferData(VERTEX_ATTRIB_BITAN, mesh->mNumVertices, mesh->mBitangents);
-        vertexData.BufferData(VERTEX_ATTRIB_TAN, mesh->mNumVertices, mesh->mTangents);
+        GLenum result = glClientWaitSync(buffer.mFence, 0, 0);
+        if (result == GL_TIMEOUT_EXPIRED)
+            return;
+        if (result == GL_WAIT_FAILED)
+            GLUF_ERROR("(TextureStreamer): Waiting on a Staging Buffer Fence Failed");
+
+        glDeleteSync(buffer.mFence);
+        buffer.mFence = nullptr;
     }
-    if (mesh->HasVertexColors(0))
-        vertexData.BufferData(VERTEX_ATTRIB_COLOR, mesh->mNumVertices, mesh->mColors[0]);
 
-    std::vector<GLuint> indices;
-    for (unsigned int i = 0; i < mesh->mNumFaces; ++i)
+    mStats.mInFlightBytes -= buffer.mJob->mImage->mMipLevels[buffer.mLevel].mSize;
+    buffer.mJob.reset();
+    buffer.mState.store(g_Free, std::memory_order_relaxed);
+}
+
+//--------------------------------------------------------------------------------------
+void TextureStreamer::UploadDirect(const std::shared_ptr<StreamJob>& job, std::size_t level)
+{
+    const DDSMipLevel& mip = job->mImage->mMipLevels[level];
+
+    if (TextureStreaming::IsStreamJobLive(*job))
     {
-        aiFace curr = mesh->mFaces[i];
-        indices.push_back(curr.mIndices[0]);
-        indices.push_back(curr.mIndices[1]);
-        indices.push_back(curr.mIndices[2]);
+        //with a staging buffer bound, the pointer would be taken as an offset into it
+        GLSTATE.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        GLSTATE.BindTexture(job->mImage->mTarget, job->mTextureId);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        DDS::UploadLevel(*job->mImage, mip, job->mData.data() + mip.mOffset, true);
+        GLSTATE.BindTexture(job->mImage->mTarget, 0);
+
+        mStats.mDirectBytes += mip.mSize;
     }
-    vertexData.BufferIndices(&indices[0], indices.size());
 
-    return vertexData;
-    return LoadVertexArray(scene);
+    FinishLevel(job, level);
 }
 
-VertexArray *LoadVertexArrayFromFile(unsigned int size, void* data)
+//--------------------------------------------------------------------------------------
+void TextureStreamer::FinishLevel(const std::shared_ptr<StreamJob>& job, std::size_t level)
 {
-    Assimp::Importer importer;
-    const aiScene* scene = importer.ReadFileFromMemory(data, size,
-        aiProcess_CalcTangentSpace |
-        aiProcess_Triangulate |
-        aiProcess_JoinIdenticalVertices |
-        aiProcess_SortByPType);
+    --job->mPendingLevels;
 
-    return LoadVertexArray(scene);
-}*/
+    StreamedTexturePtr handle = job->mHandle.lock();
+    if (handle && !job->mCancelled)
+    {
+        //once every face of a level is in, it and everything coarser is drawable
+        const DDSImage& image = *job->mImage;
+        if (--job->mFacesLeft[image.mMipLevels[level].mLevel] == 0)
+        {
+            unsigned int base = handle->mBaseLevel;
+            while (base > 0 && job->mFacesLeft[base - 1] == 0)
+                --base;
+
+            if (base != handle->mBaseLevel)
+            {
+                GLSTATE.BindTexture(image.mTarget, job->mTextureId);
+                glTexParameteri(image.mTarget, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(base));
+                GLSTATE.BindTexture(image.mTarget, 0);
+                handle->mBaseLevel = base;
+            }
+        }
+    }
+    else if (job->mProgressive)
+    {
+        job->mCancelled = true;
+    }
+
+    if (job->mPendingLevels > 0 || job->mNextLevel < job->mOrder.size())
+        return;
+
+    --mStats.mQueuedTextures;
+    if (!job->mCancelled)
+        ++mStats.mTexturesCompleted;
+    if (job->mPromise)
+        job->mPromise->set_value(job->mTextureId);
+}
 
 }
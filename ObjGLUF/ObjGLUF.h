@@ -68,7 +68,17 @@ for more details.
 #include <stdlib.h>
 #include <stack>
 #include <mutex>
+#include <thread>
+#include <future>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <atomic>
+#include <chrono>
+#include <unordered_map>
 #include <exception>
+#include <stdexcept>
+#include <cstdint>
 
 #ifndef OBJGLUF_EXPORTS
 #ifndef SUPPRESS_RADIAN_ERROR
@@ -92,6 +102,9 @@ for more details.
     #endif
 #endif
 
+//uncomment this to compile out profiling zones entirely
+//#define GLUF_DISABLE_PROFILING
+
 
 
 /*
@@ -227,6 +240,60 @@ Statistics
 
 */
 
+#define GLUF_FRAME_HISTORY_SIZE 512 //must be a power of 2
+
+/*
+GLCallCounters
+
+    OpenGL calls counted by the call counting layer (see 'SetGLCallCountingEnabled')
+
+    Data Members:
+        'mDrawCalls': glDraw* calls
+        'mBufferUploads', 'mBufferUploadBytes': glBufferData/glBufferSubData calls and the bytes they were given
+        'mTextureUploads', 'mTextureUploadBytes': glTexImage2D/glTexSubImage2D/glCompressedTex*Image2D calls and bytes
+        'mProgramBinds': glUseProgram/glBindProgramPipeline calls
+        'mTextureBinds': glBindTexture calls
+
+*/
+struct GLCallCounters
+{
+    unsigned long long mDrawCalls = 0LL;
+    unsigned long long mBufferUploads = 0LL;
+    unsigned long long mBufferUploadBytes = 0LL;
+    unsigned long long mTextureUploads = 0LL;
+    unsigned long long mTextureUploadBytes = 0LL;
+    unsigned long long mProgramBinds = 0LL;
+    unsigned long long mTextureBinds = 0LL;
+
+    GLCallCounters& operator+=(const GLCallCounters& other) noexcept;
+};
+
+/*
+StatsData
+
+    Data Members:
+        'mPreviousFrame': time of the last FPS update
+        'mUpdateInterval': seconds between FPS updates
+        'mFrameCount': frame count since previous update
+        'mCurrFPS': averaged FPS over the last update interval
+        'mFormattedStatsData': cache for 'GetFrameStatsString'
+        'mLastFrameTime': time 'Stats_func' was last called
+        'mHitchThreshold': frames longer than this (in seconds) count as hitches
+        'mFrameTimes': ring buffer of the most recent frame times in seconds
+        'mFrameTimeCount': number of frame times ever recorded; the next one goes in 'mFrameTimeCount % GLUF_FRAME_HISTORY_SIZE'
+        'mHitchCount': number of hitches ever recorded
+        'mGpuPassTimes': GPU time spent in each pass recorded with 'GLUF_GPU_PASS', summed over one frame
+        'mGpuDroppedFrames': frames whose GPU timings were not ready in time and were discarded
+        'mGLCalls': OpenGL calls made during the previous frame
+        'mGLCallSites': 'mGLCalls' split up by the innermost profile zone they were made in ("" if none)
+        'mGLStateSkips': redundant binds and state changes 'GLSTATE' dropped during the previous frame
+
+    Multithreading:
+        Only the thread calling 'Stats_func' writes the ring buffer, and it never locks; 'SampleFrameTimes' may
+            be called from any thread, and at worst sees a frame time from one frame later than it expected
+        'mGpuPassTimes', 'mGLCalls', 'mGLCallSites', and 'mGLStateSkips' are only safe to read from the thread calling 'Stats_func'
+
+*/
 class StatsData
 {
 public:
@@ -235,16 +302,381 @@ public:
     unsigned long long mFrameCount = 0LL;//frame count since previous update
     float mCurrFPS = 0.0f;
     std::wstring mFormattedStatsData = L"";
+
+    double mLastFrameTime = 0.0;
+    double mHitchThreshold = 1.0 / 30.0;
+
+    std::atomic<float> mFrameTimes[GLUF_FRAME_HISTORY_SIZE];
+    std::atomic<unsigned long long> mFrameTimeCount{ 0 };
+    std::atomic<unsigned long long> mHitchCount{ 0 };
+
+    std::map<std::string, float> mGpuPassTimes;//milliseconds, from GLUF_GPU_TIMER_FRAMES frames ago
+    unsigned long long mGpuDroppedFrames = 0LL;
+
+    GLCallCounters mGLCalls;
+    std::map<std::string, GLCallCounters> mGLCallSites;
+    unsigned long long mGLStateSkips = 0LL;
+
+    StatsData()
+    {
+        for (auto& it : mFrameTimes)
+            it.store(0.0f, std::memory_order_relaxed);
+    }
+};
+
+/*
+FrameTimeSummary
+
+    Statistics over the frame time history, all times are in seconds
+
+    Data Members:
+        'mSampleCount': number of frames the statistics are over; 0 if no frames have been recorded
+        'mHitchCount': number of hitches ever recorded, not only the ones in the history
+
+*/
+struct FrameTimeSummary
+{
+    unsigned int mSampleCount = 0;
+    float mMin = 0.0f;
+    float mMax = 0.0f;
+    float mAverage = 0.0f;
+    float mP50 = 0.0f;
+    float mP95 = 0.0f;
+    float mP99 = 0.0f;
+    unsigned long long mHitchCount = 0LL;
 };
 
+/*
+Stats_func
+
+    Note:
+        Call once per frame; records this frame's time and updates the FPS every 'mUpdateInterval' seconds
+
+*/
 OBJGLUF_API void Stats_func();
+
+/*
+GetFrameStatsString
+
+    Returns:
+        FPS, frame time percentiles, and hitch count formatted for display; this is only built when called
+
+*/
 OBJGLUF_API const std::wstring& GetFrameStatsString();
 OBJGLUF_API const StatsData& GetFrameStats();
+
+/*
+SampleFrameTimes
+
+    Returns:
+        statistics over the frame time history
+
+    Note:
+        Copies the history and partially sorts it, so this is cheap enough to call every frame, but it is never
+            done by 'Stats_func' itself
+
+*/
+OBJGLUF_API FrameTimeSummary SampleFrameTimes();
+
+/*
+SetHitchThreshold
+
+    Parameters:
+        'seconds': frames longer than this are counted as hitches
+
+*/
+OBJGLUF_API void SetHitchThreshold(double seconds);
 OBJGLUF_API const std::wstring& GetDeviceStatus();
 
 #define Stats ::Stats_func
 
 
+/*
+======================================================================================================================================================================================================
+Profiling
+
+*/
+
+/*
+ProfileEvent
+
+    Data Members:
+        'mName': name of the zone; must be a string literal, or otherwise outlive the capture
+        'mStart': microseconds since the profiler epoch the zone began
+        'mDuration': microseconds the zone lasted
+
+*/
+struct ProfileEvent
+{
+    const char* mName;
+    uint64_t mStart;
+    uint64_t mDuration;
+};
+
+#define GLUF_PROFILE_MAX_EVENTS_PER_THREAD 65536
+
+/*
+ProfileThreadBuffer
+
+    Events recorded by one thread; the profiler keeps these alive after their threads exit so they can be exported
+
+    Data Members:
+        'mThreadId': sequential id given to the thread when it first records a zone
+        'mThreadName': name shown in the trace viewer
+        'mEvents': completed zones, in order of completion
+        'mDroppedEvents': zones not recorded because 'mEvents' was full
+        'mBufferMutex': only contended while exporting or clearing
+
+*/
+struct ProfileThreadBuffer
+{
+    unsigned int mThreadId = 0;
+    std::string mThreadName;
+    std::vector<ProfileEvent> mEvents;
+    unsigned long long mDroppedEvents = 0;
+    std::mutex mBufferMutex;
+};
+
+/*
+Profiler Functions
+
+    BeginProfileCapture: clears previous events and starts recording zones
+    EndProfileCapture: stops recording zones
+    IsProfileCapturing: is a capture in progress
+    SetProfileThreadName: names the calling thread in exported traces
+    ClearProfileEvents: discards all recorded events
+    GetProfileTimestamp: microseconds since the profiler epoch
+
+    Note:
+        Zones outside of a capture only cost one atomic load
+*/
+OBJGLUF_API void BeginProfileCapture();
+OBJGLUF_API void EndProfileCapture();
+OBJGLUF_API bool IsProfileCapturing();
+OBJGLUF_API void SetProfileThreadName(const std::string& name);
+OBJGLUF_API void ClearProfileEvents();
+OBJGLUF_API uint64_t GetProfileTimestamp();
+
+/*
+WriteChromeTrace
+
+    Parameters:
+        'stream': stream to write to
+        'filePath': file to write to
+
+    Note:
+        Writes every recorded event in the Chrome trace-event JSON format, which can be opened in chrome://tracing
+            or any compatible trace viewer.  Can be called during a capture
+
+    Throws:
+        'std::ios_base::failure': if the file could not be opened
+*/
+OBJGLUF_API void WriteChromeTrace(std::ostream& stream);
+OBJGLUF_API void WriteChromeTrace(const std::string& filePath);
+
+/*
+ProfileZone
+
+    Records the time between its construction and destruction while a capture is in progress; use 'GLUF_PROFILE_ZONE'.
+        While OpenGL calls are being counted, it also names the call site they are attributed to
+
+*/
+class OBJGLUF_API ProfileZone
+{
+    const char* mName;
+    const char* mPrevCallSite;
+    uint64_t mStart;
+    bool mActive;
+    bool mTracksCallSite;
+
+public:
+    explicit ProfileZone(const char* name) noexcept;
+    ~ProfileZone() noexcept;
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+};
+
+#define GLUF_PROFILE_CONCAT_IMPL(a, b) a##b
+#define GLUF_PROFILE_CONCAT(a, b) GLUF_PROFILE_CONCAT_IMPL(a, b)
+
+#define GLUF_GPU_TIMER_FRAMES 4
+
+/*
+GPU Timing Functions
+
+    SetGpuTimingEnabled: start or stop recording GPU passes; disabled by default.  'timeDraws' also records a pass
+        around every 'VertexArray' draw ('GLUF_GPU_DRAW_PASS'), which costs two timestamps per draw, so it is off 
+        unless asked for
+    IsGpuTimingEnabled/IsGpuDrawTimingEnabled: the current settings
+    IsGpuTimingSupported: does the context support timestamp queries (OpenGL 3.3 or ARB_timer_query)
+    BeginGpuPass: records a timestamp at the start of a pass; returns a handle to end it with, or 0 if nothing was recorded
+    EndGpuPass: records a timestamp at the end of the pass 'handle' refers to; does nothing for 0, or if the pass was
+        discarded when its frame ended
+    ResolveGpuTimers: ends the frame's GPU timings and reads back the ones from GLUF_GPU_TIMER_FRAMES frames ago into
+        'StatsData::mGpuPassTimes'; 'Stats_func' calls this
+    ReleaseGpuTimers: deletes all query objects; 'Terminate' calls this
+
+    Multithreading:
+        Context thread only
+
+    Note:
+        Timestamps are used rather than GL_TIME_ELAPSED so passes can nest; a nested pass's time is also counted in
+            its parent.  Results are never waited on; a frame whose results are not ready when its queries are
+            reused is dropped instead
+*/
+using GpuPassHandle = unsigned long long;
+
+OBJGLUF_API void SetGpuTimingEnabled(bool enabled, bool timeDraws = false);
+OBJGLUF_API bool IsGpuTimingEnabled();
+OBJGLUF_API bool IsGpuDrawTimingEnabled();
+OBJGLUF_API bool IsGpuTimingSupported();
+OBJGLUF_API GpuPassHandle BeginGpuPass(const char* name);
+OBJGLUF_API void EndGpuPass(GpuPassHandle handle);
+OBJGLUF_API void ResolveGpuTimers();
+OBJGLUF_API void ReleaseGpuTimers();
+
+/*
+GpuPassScope
+
+    Records the GPU time of the commands issued during its lifetime; use 'GLUF_GPU_PASS', or 'GLUF_GPU_DRAW_PASS' for
+        passes around single draws, which are only recorded if 'SetGpuTimingEnabled' was given 'timeDraws'
+
+*/
+class OBJGLUF_API GpuPassScope
+{
+    GpuPassHandle mHandle;
+
+public:
+    explicit GpuPassScope(const char* name, bool draw = false) noexcept;
+    ~GpuPassScope() noexcept;
+
+    GpuPassScope(const GpuPassScope&) = delete;
+    GpuPassScope& operator=(const GpuPassScope&) = delete;
+};
+
+/*
+GL Call Counting Functions
+
+    SetGLCallCountingEnabled: swaps the glad entry points the library uses for ones that count calls and bytes, or
+        swaps the originals back; must be called after 'InitOpenGLExtensions'
+    IsGLCallCountingEnabled: are calls being counted
+    ResolveGLCallCounters: moves this frame's counts into 'StatsData::mGLCalls' and 'StatsData::mGLCallSites' and
+        resets them; 'Stats_func' calls this
+
+    Multithreading:
+        Context thread only
+
+    Note:
+        Disabled by default; when disabled there is no overhead at all.  Uploads given no data (allocation only)
+            are counted, but add no bytes
+*/
+OBJGLUF_API void SetGLCallCountingEnabled(bool enabled);
+OBJGLUF_API bool IsGLCallCountingEnabled();
+OBJGLUF_API void ResolveGLCallCounters();
+
+#ifndef GLUF_DISABLE_PROFILING
+    #define GLUF_PROFILE_ZONE(name) GLUF::ProfileZone GLUF_PROFILE_CONCAT(__profileZone, __LINE__)(name)
+    #define GLUF_PROFILE_FUNCTION() GLUF_PROFILE_ZONE(__FUNCTION__)
+    #define GLUF_GPU_PASS(name) GLUF::GpuPassScope GLUF_PROFILE_CONCAT(__gpuPass, __LINE__)(name)
+    #define GLUF_GPU_DRAW_PASS(name) GLUF::GpuPassScope GLUF_PROFILE_CONCAT(__gpuPass, __LINE__)(name, true)
+#else
+    #define GLUF_PROFILE_ZONE(name)
+    #define GLUF_PROFILE_FUNCTION()
+    #define GLUF_GPU_PASS(name)
+    #define GLUF_GPU_DRAW_PASS(name)
+#endif
+
+
+/*
+======================================================================================================================================================================================================
+Recording OpenGL Backend
+
+*/
+
+/*
+RecordedGLCall
+
+    One command in the recording backend's command stream
+
+    Data Members:
+        'mFunction': the OpenGL function name, i.e. "glBufferData"
+        'mArgs': the integer arguments; pointers to client data are left out, offsets passed as pointers are kept
+        'mBytes': the client data the call read or wrote
+
+*/
+struct RecordedGLCall
+{
+    const char* mFunction = nullptr;
+    std::vector<long long> mArgs;
+    unsigned long long mBytes = 0;
+};
+
+/*
+RecordingStats
+
+    Data Members:
+        'mCalls': the counters since installing or 'ClearRecordedGLCalls', counted like the call counting layer
+        'mCommandCount': commands recorded in the same time, whether or not they were logged
+        'mLive*': simulated objects which currently exist
+        'mBufferMemory', 'mTextureMemory': bytes held by the simulated buffers and texture levels
+
+*/
+struct RecordingStats
+{
+    GLCallCounters mCalls;
+    unsigned long long mCommandCount = 0;
+
+    unsigned int mLiveBuffers = 0;
+    unsigned int mLiveTextures = 0;
+    unsigned int mLiveShaders = 0;
+    unsigned int mLivePrograms = 0;
+    unsigned int mLiveVertexArrays = 0;
+    unsigned int mLiveFramebuffers = 0;
+
+    unsigned long long mBufferMemory = 0;
+    unsigned long long mTextureMemory = 0;
+};
+
+/*
+Recording Backend Functions
+
+    InstallRecordingBackend: points the glad entry points at stubs which simulate a driver, so the library runs with no
+        OpenGL context at all.  Does the same setup as 'InitOpenGLExtensions', reporting 'glVersion2Digit' as the
+        version along with the extensions the stubs support
+    UninstallRecordingBackend: restores the previous entry points and deletes all simulated objects; call
+        'InitOpenGLExtensions' again before using a real context
+    IsRecordingBackendInstalled: are the stubs installed
+    GetRecordedGLCalls: the command stream since installing or the last 'ClearRecordedGLCalls'
+    GetRecordingStats: call counters and simulated object totals
+    ClearRecordedGLCalls: clears the command stream and counters; simulated objects are kept
+    WriteRecordedGLCalls: writes the command stream one call per line, i.e. "glBindBuffer(34962, 1)"
+
+    Parameters:
+        'glVersion2Digit': the OpenGL version to report, i.e. 43 for 4.3; decides which code paths the library takes
+        'logCommands': keep the command stream; when false, only the counters and object state are kept
+
+    Multithreading:
+        Context thread only
+
+    Note:
+        The stubs keep enough state to answer the queries the library makes: buffer contents (so mapping and copying
+            work), texture level sizes, compile and link status, and uniform and attribute reflection parsed from
+            the shader source.  Nothing is rasterized; 'glReadPixels' returns zeros.
+        Only functions the library uses, plus common frame setup (clear, viewport, depth and blend state), are
+            stubbed; anything else keeps its previous entry point.
+        Object names start from 1 on every install, so command streams are deterministic.  Call counting
+            (see 'SetGLCallCountingEnabled') keeps working on top of the stubs
+*/
+OBJGLUF_API bool InstallRecordingBackend(GLuint glVersion2Digit = 43, bool logCommands = true);
+OBJGLUF_API void UninstallRecordingBackend();
+OBJGLUF_API bool IsRecordingBackendInstalled();
+OBJGLUF_API const std::vector<RecordedGLCall>& GetRecordedGLCalls();
+OBJGLUF_API RecordingStats GetRecordingStats();
+OBJGLUF_API void ClearRecordedGLCalls();
+OBJGLUF_API void WriteRecordedGLCalls(std::ostream& stream);
+
+
 /*
 ======================================================================================================================================================================================================
 Macros for constant approach for varying operating systems
@@ -333,6 +765,49 @@ OBJGLUF_API void Terminate();
 
 OBJGLUF_API const std::vector<std::string>& GetGLExtensions();
 
+/*
+InitHeadless
+
+    Creates a hidden window whose context renders into an offscreen framebuffer object, for running without a
+        display (batch rendering, benchmarks, CI).  This calls 'Init' and 'InitOpenGLExtensions', and leaves the
+        context current and the framebuffer bound, so the rest of the library works as if it had a window; the
+        returned window can be passed to 'InitGui'
+
+    Parameters:
+        'width', 'height': the size of the framebuffer, and of the hidden window
+        'preferEGL': try an EGL context before the platform's native one
+
+    Returns:
+        the hidden window, or nullptr on failure
+
+    Note:
+        On machines with no display server at all, GLFW must be built with OSMesa as its window system (configure
+            with 'OBJGLUF_HEADLESS' on); the window is then a software buffer and EGL is not needed.
+        If framebuffer objects are not supported (before OpenGL 3.0, without ARB_framebuffer_object), the hidden
+            window's own framebuffer is used instead
+        Window hints set before this call are used for the hidden window, except the two this sets itself.  GLFW can
+            not report a hint's current value, so afterwards GLFW_VISIBLE is back at its default (GL_TRUE), and with
+            'preferEGL' so is GLFW_CONTEXT_CREATION_API (GLFW_NATIVE_CONTEXT_API); set them again for later windows
+            if they were changed
+*/
+OBJGLUF_API GLFWwindow* InitHeadless(GLuint width, GLuint height, bool preferEGL = true);
+
+/*
+Headless Context Functions
+
+    IsHeadless: was the context created by 'InitHeadless'
+    GetDefaultFramebuffer: the framebuffer to bind instead of 0 when rendering to the "screen"; 0 with a window
+    ReadHeadlessPixels: reads back the default framebuffer as tightly packed RGBA8 rows, bottom row first
+    ReleaseHeadless: deletes the framebuffer and destroys the hidden window; 'Terminate' calls this
+
+    Multithreading:
+        Context thread only
+*/
+OBJGLUF_API bool IsHeadless();
+OBJGLUF_API GLuint GetDefaultFramebuffer();
+OBJGLUF_API void ReadHeadlessPixels(std::vector<unsigned char>& rgba, GLuint& width, GLuint& height);
+OBJGLUF_API void ReleaseHeadless();
+
 /*
 ======================================================================================================================================================================================================
 Context Controller Methods
@@ -370,6 +845,7 @@ LoadFileIntoMemory
 
     Note:
         If 'binMemory' is not empty, the data will be overwritten
+        This copies the whole file; prefer 'MappedFile' when the loader can take a 'MemorySpan'
 */
 OBJGLUF_API void LoadFileIntoMemory(const std::string& path, std::vector<char>& binMemory);
 OBJGLUF_API void LoadFileIntoMemory(const std::string& path, std::string& memory);
@@ -392,73 +868,220 @@ OBJGLUF_API void LoadBinaryArrayIntoString(const std::vector<char>& rawMemory, s
 
 
 /*
-======================================================================================================================================================================================================
-OpenGL Basic Data Structures and Operators
+MemorySpan
 
-Note: these only play a significant role in Gui, but are presented here as basic types and utilities which can be used independently of the Gui
+    A non-owning, read-only view of a contiguous block of bytes.  The naming mirrors 'std::vector<char>' so the
+        loaders can take either one without caring where the bytes live
 
-*/
+    Data Members:
+        'mData': pointer to the first byte
+        'mSize': number of bytes in the view
 
+    Note:
+        The span does NOT keep its memory alive; whoever created it (a 'std::vector<char>', a 'MappedFile', etc.)
+            must outlive it
 
-//Rect is supposed to be used where the origin is bottom left
-struct OBJGLUF_API Rect
+*/
+class OBJGLUF_API MemorySpan
 {
-    union{ long left, x; };
-    long top, right;
-    union{ long bottom, y; };
-};
+    const char* mData = nullptr;
+    std::size_t mSize = 0;
+public:
 
-struct OBJGLUF_API Rectf
-{
-    float left, top, right, bottom;
-};
+    MemorySpan() noexcept {}
+    MemorySpan(const char* data, std::size_t size) noexcept : mData(data), mSize(size) {}
+    MemorySpan(const std::vector<char>& data) noexcept : mData(data.data()), mSize(data.size()) {}
+    MemorySpan(const std::string& data) noexcept : mData(data.data()), mSize(data.size()) {}
 
-struct OBJGLUF_API Point
-{
-    union{ long x, width; };
-    union{ long y, height; };
+    const char* data() const noexcept { return mData; }
+    std::size_t size() const noexcept { return mSize; }
+    bool empty() const noexcept { return mSize == 0; }
 
-    Point(long val1, long val2) : x(val1), y(val2){}
-    Point() : x(0L), y(0L){}
+    const char* begin() const noexcept { return mData; }
+    const char* end() const noexcept { return mData + mSize; }
+
+    const char& operator[](std::size_t i) const noexcept { return mData[i]; }
+
+    /*
+    SubSpan
+
+        Parameters:
+            'offset': byte offset into this span
+            'count': number of bytes in the new span
+
+        Throws:
+            'std::out_of_range': if 'offset' + 'count' goes past the end of this span
+    */
+    MemorySpan SubSpan(std::size_t offset, std::size_t count) const
+    {
+        if (offset > mSize || count > mSize - offset)
+            throw std::out_of_range("(MemorySpan): SubSpan Out of Range");
+        return MemorySpan(mData + offset, count);
+    }
 };
 
-inline Point operator /(const Point& pt0, const Point& pt1)
-{
-    return{ pt0.x / pt1.x, pt0.y / pt1.y };
-}
 
-inline Point operator /(const Point& pt0, const long& f)
-{
-    return{ pt0.x / f, pt0.y / f };
-}
+/*
+MappedFile
 
-inline Point operator -(const Point& pt0, const Point& pt1)
-{
-    return{ pt0.x - pt1.x, pt0.y - pt1.y };
-}
+    A read-only, memory-mapped view of a file on disk.  Pages are faulted in by the OS as they are touched,
+        so nothing is copied into process memory up front
 
-inline bool operator ==(const Rect& rc0, const Rect& rc1)
-{
-    return
-        (
-        rc0.left == rc1.left && rc0.right == rc1.right &&
-        rc0.top == rc1.top  && rc0.bottom == rc1.bottom
-        );
-}
+    Data Members:
+        'mData': the base address of the mapping
+        'mSize': size of the file in bytes (64 bit, so files over 4GB are fine)
+        'mOpen': true if a file is currently mapped (empty files have no base address)
+        'mFileHandle': OS file handle (Windows only)
+        'mMappingHandle': OS file mapping handle (Windows only)
 
-inline bool operator !=(const Rect& rc0, const Rect& rc1)
-{
-    return !(rc0 == rc1);
-}
+    Throws:
+        'std::ios_base::failure': from the constructor/'Open' if the file could not be opened or mapped
 
-inline void bFlip(bool& b)
+    Note:
+        The view stays valid until 'Close' is called or the object is destroyed; a 'MemorySpan' taken
+            from it must not outlive it.  Use 'MappedFilePtr' when the memory needs to be shared with
+            something that keeps referencing it (i.e. FreeType faces)
+
+*/
+class OBJGLUF_API MappedFile
 {
-    b = !b;
-}
+    const char* mData = nullptr;
+    std::size_t mSize = 0;
+    bool mOpen = false;
 
-OBJGLUF_API bool        PtInRect(const Rect& rect, const Point& pt);
-OBJGLUF_API void        SetRectEmpty(Rect& rect);
-OBJGLUF_API void        SetRect(Rect& rect, long left, long top, long right, long bottom);
+#ifdef _WIN32
+    void* mFileHandle = nullptr;
+    void* mMappingHandle = nullptr;
+#endif
+
+public:
+
+    MappedFile() noexcept {}
+    explicit MappedFile(const std::string& path);
+    ~MappedFile() noexcept;
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /*
+    Open
+
+        Parameters:
+            'path': path of the file to map
+
+        Throws:
+            'std::ios_base::failure': if the file could not be opened or mapped
+
+        Note:
+            If a file is already mapped, it is closed first
+    */
+    void Open(const std::string& path);
+
+    /*
+    Close
+
+        Note:
+            Unmaps the file; any spans taken from this are invalid afterward
+    */
+    void Close() noexcept;
+
+    bool IsOpen() const noexcept { return mOpen; }
+
+    const char* data() const noexcept { return mData; }
+    std::size_t size() const noexcept { return mSize; }
+
+    MemorySpan GetView() const noexcept { return MemorySpan(mData, mSize); }
+    operator MemorySpan() const noexcept { return GetView(); }
+};
+
+using MappedFilePtr = std::shared_ptr<MappedFile>;
+
+/*
+MapFile
+
+    Parameters:
+        'path': path of file to map
+
+    Returns:
+        a shared, read-only mapping of the file
+
+    Throws:
+        'std::ios_base::failure': if the file could not be opened or mapped
+*/
+OBJGLUF_API MappedFilePtr MapFile(const std::string& path);
+
+
+/*
+======================================================================================================================================================================================================
+OpenGL Basic Data Structures and Operators
+
+Note: these only play a significant role in Gui, but are presented here as basic types and utilities which can be used independently of the Gui
+
+*/
+
+
+//Rect is supposed to be used where the origin is bottom left
+struct OBJGLUF_API Rect
+{
+    union{ long left, x; };
+    long top, right;
+    union{ long bottom, y; };
+};
+
+struct OBJGLUF_API Rectf
+{
+    float left, top, right, bottom;
+};
+
+struct OBJGLUF_API Point
+{
+    union{ long x, width; };
+    union{ long y, height; };
+
+    Point(long val1, long val2) : x(val1), y(val2){}
+    Point() : x(0L), y(0L){}
+};
+
+inline Point operator /(const Point& pt0, const Point& pt1)
+{
+    return{ pt0.x / pt1.x, pt0.y / pt1.y };
+}
+
+inline Point operator /(const Point& pt0, const long& f)
+{
+    return{ pt0.x / f, pt0.y / f };
+}
+
+inline Point operator -(const Point& pt0, const Point& pt1)
+{
+    return{ pt0.x - pt1.x, pt0.y - pt1.y };
+}
+
+inline bool operator ==(const Rect& rc0, const Rect& rc1)
+{
+    return
+        (
+        rc0.left == rc1.left && rc0.right == rc1.right &&
+        rc0.top == rc1.top  && rc0.bottom == rc1.bottom
+        );
+}
+
+inline bool operator !=(const Rect& rc0, const Rect& rc1)
+{
+    return !(rc0 == rc1);
+}
+
+inline void bFlip(bool& b)
+{
+    b = !b;
+}
+
+OBJGLUF_API bool        PtInRect(const Rect& rect, const Point& pt);
+OBJGLUF_API void        SetRectEmpty(Rect& rect);
+OBJGLUF_API void        SetRect(Rect& rect, long left, long top, long right, long bottom);
 OBJGLUF_API void        SetRect(Rectf& rect, float left, float top, float right, float bottom);
 OBJGLUF_API void        OffsetRect(Rect& rect, long x, long y);
 OBJGLUF_API void        RepositionRect(Rect& rect, long newX, long newY);
@@ -584,6 +1207,177 @@ inline std::vector<std::string> SplitStr(const std::string &s, char delim, bool
     return elems;
 }
 
+/*
+Hash*FNV1a
+
+    Parameters:
+        'str': null terminated string to hash
+        'data': bytes to hash
+        'size': number of bytes in 'data'
+        'hash': running hash value, for hashing several pieces as one
+
+    Returns:
+        64 bit FNV-1a hash of the input
+
+    Note:
+        'HashStringFNV1a' is constexpr, so string literals can be hashed at compile time
+*/
+#define GLUF_FNV1A_OFFSET_BASIS 14695981039346656037ULL
+#define GLUF_FNV1A_PRIME        1099511628211ULL
+
+constexpr uint64_t HashStringFNV1a(const char* str, uint64_t hash = GLUF_FNV1A_OFFSET_BASIS)
+{
+    return (*str == '\0') ? hash : HashStringFNV1a(str + 1, (hash ^ static_cast<uint64_t>(static_cast<unsigned char>(*str))) * GLUF_FNV1A_PRIME);
+}
+
+inline uint64_t HashBytesFNV1a(const void* data, std::size_t size, uint64_t hash = GLUF_FNV1A_OFFSET_BASIS) noexcept
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<uint64_t>(bytes[i]);
+        hash *= GLUF_FNV1A_PRIME;
+    }
+    return hash;
+}
+
+
+/*
+======================================================================================================================================================================================================
+Asset Archives
+
+    Many small asset files can be packed into a single archive, which is mapped once and read with zero-copy 'MemorySpan's
+
+    Archive Layout (little endian):
+        'ArchiveHeader'
+        'ArchiveEntry' * mEntryCount, sorted by 'mNameHash'
+        asset names, not null terminated
+        payloads, each starting on a 'GLUF_ARCHIVE_ALIGNMENT' byte boundary
+
+*/
+
+#define GLUF_ARCHIVE_MAGIC "GLUFPAK"
+#define GLUF_ARCHIVE_VERSION 1
+#define GLUF_ARCHIVE_ALIGNMENT 4096
+
+struct ArchiveHeader
+{
+    char     mMagic[8];
+    uint32_t mVersion;
+    uint32_t mEntryCount;
+    uint64_t mTocOffset;
+    uint64_t mNamesOffset;
+    uint64_t mNamesSize;
+};
+
+struct ArchiveEntry
+{
+    uint64_t mNameHash;
+    uint64_t mOffset;
+    uint64_t mSize;
+    uint32_t mNameOffset;//relative to 'ArchiveHeader::mNamesOffset'
+    uint32_t mNameLength;
+};
+
+static_assert(sizeof(ArchiveHeader) == 40, "ArchiveHeader must match the on-disk layout");
+static_assert(sizeof(ArchiveEntry) == 32, "ArchiveEntry must match the on-disk layout");
+
+//maps asset names to the file paths to pack them from
+using AssetPathList = std::map<std::string, std::string>;
+
+/*
+NormalizeAssetName
+
+    Parameters:
+        'name': asset name or relative path
+
+    Returns:
+        'name' with '\\' replaced by '/', and any leading "./" or '/' removed; this is the form stored in archives
+*/
+OBJGLUF_API std::string NormalizeAssetName(const std::string& name);
+
+/*
+AssetArchive
+
+    Reads an archive written by 'WriteAssetArchive'
+
+    Data Members:
+        'mFile': the mapped archive
+        'mEntries': the table of contents, inside of the mapping
+        'mEntryCount': number of entries in 'mEntries'
+        'mNames': the asset name block, inside of the mapping
+
+    Note:
+        Spans returned point directly into the mapping, so they are valid as long as this archive (or 'GetFile') is alive.
+        Lookups are a binary search on the name hash, followed by a name compare
+
+*/
+class OBJGLUF_API AssetArchive
+{
+    MappedFilePtr mFile;
+    const ArchiveEntry* mEntries = nullptr;
+    uint32_t mEntryCount = 0;
+    const char* mNames = nullptr;
+
+    const ArchiveEntry* FindEntry(const std::string& name) const noexcept;
+
+public:
+
+    AssetArchive() noexcept {}
+    explicit AssetArchive(const std::string& path);
+
+    /*
+    Open
+
+        Parameters:
+            'path': path of the archive to map
+
+        Throws:
+            'std::ios_base::failure': if the file could not be opened or mapped
+            'std::invalid_argument': if the file is not a valid archive, or any entry lies outside of it
+    */
+    void Open(const std::string& path);
+    void Close() noexcept;
+    bool IsOpen() const noexcept { return mFile != nullptr; }
+
+    /*
+    GetAsset
+
+        Parameters:
+            'name': name of the asset, as it was packed
+
+        Returns:
+            view of the asset's data within the archive
+
+        Throws:
+            'std::out_of_range': if the archive does not contain 'name'
+    */
+    MemorySpan GetAsset(const std::string& name) const;
+    bool TryGetAsset(const std::string& name, MemorySpan& outAsset) const noexcept;
+    bool Contains(const std::string& name) const noexcept;
+
+    std::size_t GetAssetCount() const noexcept { return mEntryCount; }
+    std::vector<std::string> GetAssetNames() const;
+
+    //for loaders which need to keep the data alive (i.e. fonts)
+    const MappedFilePtr& GetFile() const noexcept { return mFile; }
+};
+
+using AssetArchivePtr = std::shared_ptr<AssetArchive>;
+
+/*
+WriteAssetArchive
+
+    Parameters:
+        'archivePath': path of the archive to create
+        'assets': asset names, and the files to pack them from
+
+    Throws:
+        'std::ios_base::failure': if any input could not be read, or the archive could not be written
+        'std::invalid_argument': if two names are the same once normalized
+*/
+OBJGLUF_API void WriteAssetArchive(const std::string& archivePath, const AssetPathList& assets);
+
 
 
 
@@ -678,94 +1472,308 @@ OBJGLUF_API std::wstring StringToWString(const std::string& str) noexcept;
 
 /*
 ======================================================================================================================================================================================================
-Shader API (Alpha)
+OpenGL State Cache
 
 Note:
-    -Classes and Structs for dealing directly with OpenGL may use some C types
+    -Library code changes bindings and fixed function state through 'GLSTATE', which remembers what it last set and
+        drops calls that would not change anything
 
 */
 
+#define GLUF_STATE_TEXTURE_UNITS 32 //texture and sampler bindings on units past this are passed straight through
+#define GLUF_STATE_UNIFORM_BINDINGS 36 //the same for indexed uniform buffer bindings
+#define GLUF_STATE_BUFFER_TARGETS 11 //buffer targets the cache knows; see 'GLStateCache::FindBuffer'
+#define GLUF_STATE_TEXTURE_TARGETS 11 //texture targets the cache knows; see 'GLStateCache::FindTexture'
+#define GLUF_STATE_CAPABILITIES 15 //glEnable capabilities the cache knows; see 'GLStateCache::FindCapability'
 
-enum LocationType
-{
-    GLT_ATTRIB = 0,
-    GLT_UNIFORM,
-};
-
-struct OBJGLUF_API ShaderInfoStruct
-{
-    bool mSuccess = false;
-
-    std::string mLog;
-
-    operator bool() const
-    {
-        return mSuccess;
-    }
-};
+/*
+GLStateCacheStats
 
-enum ShaderType
-{
-    SH_VERTEX_SHADER = GL_VERTEX_SHADER,
-    SH_TESSCONTROL_SHADER = GL_TESS_CONTROL_SHADER,
-    SH_TESS_EVALUATION_SHADER = GL_TESS_EVALUATION_SHADER,
-    SH_GEOMETRY_SHADER = GL_GEOMETRY_SHADER,
-    SH_FRAGMENT_SHADER = GL_FRAGMENT_SHADER,
-    SH_COMPUTE_SHADER = GL_COMPUTE_SHADER
-};
+    Data Members:
+        '*Skipped': calls dropped because the state was already set, by kind
+        'mStateSkipped': enables, blend, depth, cull, and viewport changes
 
-enum ProgramStage
+*/
+struct GLStateCacheStats
 {
-    PPO_INVALID_SHADER_BIT = 0,//this is 0, since passing a null bitfield signifies not to use this program for any stage
-    PPO_VERTEX_SHADER_BIT = GL_VERTEX_SHADER_BIT,
-    PPO_TESSCONTROL_SHADER_BIT = GL_TESS_CONTROL_SHADER_BIT,
-    PPO_TESS_EVALUATION_SHADER_BIT = GL_TESS_EVALUATION_SHADER_BIT,
-    PPO_GEOMETRY_SHADER_BIT = GL_GEOMETRY_SHADER_BIT,
-    PPO_FRAGMENT_SHADER_BIT = GL_FRAGMENT_SHADER_BIT
+    unsigned long long mProgramBindsSkipped = 0;
+    unsigned long long mVertexArrayBindsSkipped = 0;
+    unsigned long long mBufferBindsSkipped = 0;
+    unsigned long long mTextureBindsSkipped = 0;
+    unsigned long long mSamplerBindsSkipped = 0;
+    unsigned long long mStateSkipped = 0;
+
+    unsigned long long GetTotalSkipped() const noexcept;
 };
 
 /*
-ShaderTypeToProgramStage
-
-    Parameters:
-        'type': which shader type it is
-
-    Returns:
-        corresponding 'ProgramStage' to 'type'
-*/
-ProgramStage ShaderTypeToProgramStage(ShaderType type);
+GLStateCache
 
-//use type alias because the compile and link output are both the same
-using CompileOutputStruct = ShaderInfoStruct;
-using LinkOutputStruct    = ShaderInfoStruct;
+    -Shadows the current context's bound program, pipeline, vertex array, buffers, textures, samplers, enables,
+        blend, depth, cull, and viewport state.  Each setter calls OpenGL only if the value differs from the shadow.
+        Nothing is known at first, so the first call of each kind always goes through
 
+    Data Members:
+        'mEnabled': if false, every call goes through; the shadow is still kept up to date
+        'mProgram', 'mPipeline', 'mVertexArray': current bindings
+        'mBuffers': non-indexed buffer bindings, by target
+        'mUniformBindings': indexed GL_UNIFORM_BUFFER bindings
+        'mActiveTexture': index of the active texture unit (not GL_TEXTUREi)
+        'mTextures': texture bindings, by unit and target
+        'mSamplers': sampler bindings, by unit
+        'mCapabilities': glEnable state; -1 if unknown
+        'mBlendFunc': source rgb, destination rgb, source alpha, destination alpha
+        'mBlendEquation': rgb and alpha equations
+        'mDepthFunc', 'mDepthMask', 'mCullFace', 'mViewport': the rest of the state
+        'mStats': running totals of dropped calls
 
-/*
+    Multithreading:
+        Not thread safe; only use it on the thread the context is current on
 
-Opaque Shader Classes
+    Note:
+        Anything changed by calling OpenGL directly is not seen, and a later call through here which matches the
+            stale shadow is dropped.  Raw OpenGL calls that change cached state require a call to 'Invalidate' before
+            the cache is used again (as does third party code which may make them); or set that state through here as
+            well.  'Dialog::OnRender' and 'TextHelper::Begin' invalidate on their own
+        GL_ELEMENT_ARRAY_BUFFER is part of the vertex array, so binding a different vertex array forgets it
 
 */
+class OBJGLUF_API GLStateCache
+{
+    struct IndexedBinding
+    {
+        GLuint mBuffer;
+        GLintptr mOffset;
+        GLsizeiptr mSize;
+    };
+
+    bool mEnabled = true;
+
+    GLuint mProgram;
+    GLuint mPipeline;
+    GLuint mVertexArray;
+    GLuint mBuffers[GLUF_STATE_BUFFER_TARGETS];
+    IndexedBinding mUniformBindings[GLUF_STATE_UNIFORM_BINDINGS];
+
+    GLuint mActiveTexture;
+    GLuint mTextures[GLUF_STATE_TEXTURE_UNITS][GLUF_STATE_TEXTURE_TARGETS];
+    GLuint mSamplers[GLUF_STATE_TEXTURE_UNITS];
+
+    signed char mCapabilities[GLUF_STATE_CAPABILITIES];
+    GLenum mBlendFunc[4];
+    GLenum mBlendEquation[2];
+    GLenum mDepthFunc;
+    signed char mDepthMask;
+    GLenum mCullFace;
+    GLint mViewport[4];
+    bool mViewportKnown;
+
+    GLStateCacheStats mStats;
+
+    GLuint* FindBuffer(GLenum target) noexcept;
+    GLuint* FindTexture(GLuint unit, GLenum target) noexcept;
+    signed char* FindCapability(GLenum cap) noexcept;
 
-class OBJGLUF_API Shader;
-class OBJGLUF_API Program;
-class OBJGLUF_API SeparateProgram;
+public:
 
+    GLStateCache() noexcept;
 
-/*
+    /*
+    Invalidate
 
-Shader Aliases
+        -Forgets all state, so the next call of each kind goes through.  Called automatically when a context is
+            initialized (see 'InitOpenGLExtensions' and 'InstallRecordingBackend')
 
-*/
+        Throws:
+            no-throw guarantee
+    */
+    void Invalidate() noexcept;
 
-using ShaderPtr         = std::shared_ptr<Shader>;
+    /*
+    *Enabled
+
+        Parameters:
+            'enabled': false passes every call through, i.e. to check whether a rendering bug is caused by stale state
+    */
+    void SetEnabled(bool enabled) noexcept;
+    bool IsEnabled() const noexcept { return mEnabled; }
+
+    /*
+    Bindings
+
+        -Same as the OpenGL functions with the same names.  'BindTexture(unit, ...)' always leaves 'unit' the active
+            texture unit, even when the bind itself is dropped; there, and in 'BindSampler', 'unit' is an index, not GL_TEXTUREi
+
+        Throws:
+            no-throw guarantee
+    */
+    void UseProgram(GLuint program) noexcept;
+    void BindProgramPipeline(GLuint pipeline) noexcept;
+    void BindVertexArray(GLuint vertexArray) noexcept;
+    void BindBuffer(GLenum target, GLuint buffer) noexcept;
+    void BindBufferBase(GLenum target, GLuint index, GLuint buffer) noexcept;
+    void BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) noexcept;
+    void ActiveTexture(GLenum texture) noexcept;
+    void BindTexture(GLenum target, GLuint texture) noexcept;
+    void BindTexture(GLuint unit, GLenum target, GLuint texture) noexcept;
+    void BindSampler(GLuint unit, GLuint sampler) noexcept;
+
+    /*
+    Fixed Function State
+
+        -Same as the OpenGL functions with the same names
+
+        Throws:
+            no-throw guarantee
+    */
+    void Enable(GLenum cap) noexcept;
+    void Disable(GLenum cap) noexcept;
+    void SetCapability(GLenum cap, bool enabled) noexcept;
+    void BlendFunc(GLenum source, GLenum destination) noexcept;
+    void BlendFuncSeparate(GLenum sourceRGB, GLenum destinationRGB, GLenum sourceAlpha, GLenum destinationAlpha) noexcept;
+    void BlendEquation(GLenum mode) noexcept;
+    void DepthFunc(GLenum func) noexcept;
+    void DepthMask(GLboolean flag) noexcept;
+    void CullFace(GLenum mode) noexcept;
+    void Viewport(GLint x, GLint y, GLsizei width, GLsizei height) noexcept;
+
+    /*
+    Delete*
+
+        -Same as the OpenGL functions with the same names, which also reset any binding of the deleted objects.  Use
+            these instead of glDelete*, otherwise a new object which reuses a deleted name might not get bound
+
+        Throws:
+            no-throw guarantee
+    */
+    void DeleteBuffers(GLsizei count, const GLuint* buffers) noexcept;
+    void DeleteTextures(GLsizei count, const GLuint* textures) noexcept;
+    void DeleteVertexArrays(GLsizei count, const GLuint* vertexArrays) noexcept;
+    void DeleteSamplers(GLsizei count, const GLuint* samplers) noexcept;
+    void DeleteProgram(GLuint program) noexcept;
+    void DeleteProgramPipelines(GLsizei count, const GLuint* pipelines) noexcept;
+
+    /*
+    Get*
+
+        Returns:
+            the current binding; queried from OpenGL if it is not known (or the cache is disabled), which remembers it
+
+        Throws:
+            no-throw guarantee
+    */
+    GLuint GetProgram() noexcept;
+    GLuint GetVertexArray() noexcept;
+    GLuint GetTexture(GLenum target) noexcept;
+
+    /*
+    *Stats
+
+        Returns:
+            totals of the calls dropped since the last reset
+    */
+    const GLStateCacheStats& GetStats() const noexcept { return mStats; }
+    void ResetStats() noexcept;
+};
+
+extern GLStateCache OBJGLUF_API g_GLStateCache;
+
+#define GLSTATE GLUF::g_GLStateCache
+
+
+/*
+======================================================================================================================================================================================================
+Shader API (Alpha)
+
+Note:
+    -Classes and Structs for dealing directly with OpenGL may use some C types
+
+*/
+
+
+enum LocationType
+{
+    GLT_ATTRIB = 0,
+    GLT_UNIFORM,
+};
+
+struct OBJGLUF_API ShaderInfoStruct
+{
+    bool mSuccess = false;
+
+    std::string mLog;
+
+    operator bool() const
+    {
+        return mSuccess;
+    }
+};
+
+enum ShaderType
+{
+    SH_VERTEX_SHADER = GL_VERTEX_SHADER,
+    SH_TESSCONTROL_SHADER = GL_TESS_CONTROL_SHADER,
+    SH_TESS_EVALUATION_SHADER = GL_TESS_EVALUATION_SHADER,
+    SH_GEOMETRY_SHADER = GL_GEOMETRY_SHADER,
+    SH_FRAGMENT_SHADER = GL_FRAGMENT_SHADER,
+    SH_COMPUTE_SHADER = GL_COMPUTE_SHADER
+};
+
+enum ProgramStage
+{
+    PPO_INVALID_SHADER_BIT = 0,//this is 0, since passing a null bitfield signifies not to use this program for any stage
+    PPO_VERTEX_SHADER_BIT = GL_VERTEX_SHADER_BIT,
+    PPO_TESSCONTROL_SHADER_BIT = GL_TESS_CONTROL_SHADER_BIT,
+    PPO_TESS_EVALUATION_SHADER_BIT = GL_TESS_EVALUATION_SHADER_BIT,
+    PPO_GEOMETRY_SHADER_BIT = GL_GEOMETRY_SHADER_BIT,
+    PPO_FRAGMENT_SHADER_BIT = GL_FRAGMENT_SHADER_BIT
+};
+
+/*
+ShaderTypeToProgramStage
+
+    Parameters:
+        'type': which shader type it is
+
+    Returns:
+        corresponding 'ProgramStage' to 'type'
+*/
+ProgramStage ShaderTypeToProgramStage(ShaderType type);
+
+//use type alias because the compile and link output are both the same
+using CompileOutputStruct = ShaderInfoStruct;
+using LinkOutputStruct    = ShaderInfoStruct;
+
+
+/*
+
+Opaque Shader Classes
+
+*/
+
+class OBJGLUF_API Shader;
+class OBJGLUF_API Program;
+class OBJGLUF_API SeparateProgram;
+class OBJGLUF_API PendingProgram;
+
+
+/*
+
+Shader Aliases
+
+*/
+
+using ShaderPtr         = std::shared_ptr<Shader>;
 using ShaderPtrWeak     = std::weak_ptr<Shader>;
 using ProgramPtr        = std::shared_ptr<Program>;
 using ProgramPtrWeak    = std::weak_ptr<Program>;
 using SepProgramPtr     = std::shared_ptr<SeparateProgram>;
 using SepProgramPtrWeak = std::weak_ptr<SeparateProgram>;
+using PendingProgramPtr = std::shared_ptr<PendingProgram>;
 
 using ShaderSourceList      = std::map<ShaderType, std::string>;
 using ShaderPathList        = std::map<ShaderType, std::string>;
+using ShaderDefineList      = std::map<std::string, std::string>;
 using ShaderIdList          = std::vector<GLuint>;
 using ProgramIdList         = std::vector<GLuint>;
 using ShaderNameList        = std::vector<std::string>;
@@ -779,6 +1787,25 @@ using ProgramPtrListWeak    = std::vector<ProgramPtrWeak>;
 using VariableLocMap    = std::map<std::string, GLuint>;
 using VariableLocPair = std::pair < std::string, GLuint > ;
 
+//deepest '#include' nesting 'ShaderManager::PreprocessShader' allows
+#define GLUF_SHADER_INCLUDE_DEPTH 32
+
+/*
+HashProgramSources
+
+    Parameters:
+        'shaderSources': the source text of each stage
+        'separate': whether the program will be separable
+
+    Returns:
+        64 bit key for the linked program; covers the sources, the set of stages, 'separate', and the
+            driver's vendor/renderer/version strings, so a driver change never reuses an old binary
+
+    Note:
+        this queries the driver strings, so a context must be current
+*/
+OBJGLUF_API uint64_t HashProgramSources(const ShaderSourceList& shaderSources, bool separate);
+
 /*
 
 Shader Exceptions
@@ -829,6 +1856,17 @@ public:
     EXCEPTION_CONSTRUCTOR(MakeShaderException)
 };
 
+class ShaderPreprocessException : public Exception
+{
+public:
+    virtual const char* what() const noexcept override
+    {
+        return "Shader Preprocessing Failed!";
+    }
+
+    EXCEPTION_CONSTRUCTOR(ShaderPreprocessException)
+};
+
 class MakeProgramException : public Exception
 {
 public:
@@ -862,6 +1900,149 @@ public:
     EXCEPTION_CONSTRUCTOR(NoActiveProgramUniformException)
 };
 
+/*
+ProgramBinaryCacheStats
+
+    Data Members:
+        'mHits': programs loaded from a cached binary instead of being compiled
+        'mMisses': programs that had no usable cache entry and were compiled from source
+        'mRejected': cached binaries the driver refused to load (these are deleted and recompiled)
+        'mStored': binaries written to the cache
+
+*/
+struct ProgramBinaryCacheStats
+{
+    unsigned long long mHits = 0;
+    unsigned long long mMisses = 0;
+    unsigned long long mRejected = 0;
+    unsigned long long mStored = 0;
+};
+
+/*
+ProgramVariantStats
+
+    Data Members:
+        'mRequests': calls to 'CreateProgramVariant*' and 'SubmitProgramVariant'
+        'mCompiled': requests whose preprocessed sources had not been seen before, and were compiled
+        'mCached': variants currently held by the cache
+
+*/
+struct ProgramVariantStats
+{
+    unsigned long long mRequests = 0;
+    unsigned long long mCompiled = 0;
+    unsigned long long mCached = 0;
+};
+
+/*
+ShaderObjectStats
+
+    Data Members:
+        'mHits': shaders handed out from an existing shader object with the same type and source
+        'mCompiled': shaders that had no live match, and were compiled
+        'mTracked': entries in the cache, including ones whose shader has since been freed
+
+*/
+struct ShaderObjectStats
+{
+    unsigned long long mHits = 0;
+    unsigned long long mCompiled = 0;
+    unsigned long long mTracked = 0;
+};
+
+/*
+UniformShadowStats
+
+    Data Members:
+        'mUniformsSkipped': 'GLUniform*' and 'GLProgramUniform*' calls that were not sent to OpenGL, because the
+            program already had that value
+        'mBindsSkipped': 'UseProgram' calls that were not sent to OpenGL, because the program was already bound
+
+*/
+struct UniformShadowStats
+{
+    unsigned long long mUniformsSkipped = 0;
+    unsigned long long mBindsSkipped = 0;
+};
+
+/*
+UniformHandle
+
+    -A uniform resolved once per program, so setting it each frame does not look anything up.  Get these
+        with 'ShaderManager::GetUniformHandle', preferably with a name hash computed at compile time:
+
+        constexpr uint64_t MVP = HashStringFNV1a("_MVP");
+        UniformHandle mvp = SHADERMANAGER.GetUniformHandle(program, MVP);
+        ...
+        SHADERMANAGER.GLUniformMatrix4f(mvp, matrix);
+
+    Data Members:
+        'mLocation': location of the uniform in the program it was resolved from; -1 if the program does not
+            have it, which makes the setters do nothing (like OpenGL does)
+        'mNameHash': 'HashStringFNV1a' of the uniform's name
+
+    Note:
+        A handle is only valid for the program it was resolved from
+
+*/
+struct UniformHandle
+{
+    GLint mLocation = -1;
+    uint64_t mNameHash = 0;
+
+    bool IsValid() const noexcept { return mLocation != -1; }
+};
+
+/*
+ShaderVariableInfo
+
+    -Everything reflected about one active attribute or uniform when its program was built
+
+    Data Members:
+        'mType': the variable's OpenGL type, i.e. GL_FLOAT_VEC3
+        'mArraySize': number of array elements; 1 if it is not an array
+        'mLocation': same as 'GetShaderVariableLocation'; -1 for uniform block members
+        'mBlockIndex': index of the uniform block the uniform is in; -1 if it is not in one, and always -1 for
+            attributes
+        'mOffset': byte offset of the uniform in its block; -1 if it is not in one
+        'mArrayStride': bytes between array elements in its block; -1 if it is not in one, 0 if not an array
+        'mMatrixStride': bytes between matrix columns in its block; -1 if it is not in one, 0 if not a matrix
+
+    Note:
+        An array is reflected once, under "name[0]" like OpenGL names it; element 'i' is at 'mLocation' + 'i'
+
+*/
+struct ShaderVariableInfo
+{
+    GLenum mType = GL_NONE;
+    GLint mArraySize = 0;
+    GLint mLocation = -1;
+    GLint mBlockIndex = -1;
+    GLint mOffset = -1;
+    GLint mArrayStride = -1;
+    GLint mMatrixStride = -1;
+};
+
+using ShaderVariableInfoMap = std::map<std::string, ShaderVariableInfo>;
+
+/*
+UniformBlockInfo
+
+    Data Members:
+        'mIndex': the block's index in its program
+        'mBinding': the uniform buffer binding point the block reads from
+        'mDataSize': bytes of buffer the block reads
+
+*/
+struct UniformBlockInfo
+{
+    GLuint mIndex = 0;
+    GLuint mBinding = 0;
+    GLint mDataSize = 0;
+};
+
+using UniformBlockMap = std::map<std::string, UniformBlockInfo>;
+
 /*
 ShaderManager
 
@@ -872,8 +2053,12 @@ ShaderManager
             'GetShader*Location(s)'
             'Get*Log'
             'FlushLogs'
-            'GL*'
+            'GL*' (from the thread the OpenGL context is current on)
             'GetUniformIdFromName'
+            '*ProgramBinaryCache*'
+            '*ShaderInclude*', 'PreprocessShader'
+            '*ProgramVariant*'
+            'GetShaderObjectStats'
 
 
     Data Members:
@@ -881,6 +2066,23 @@ ShaderManager
         'mLinkLogs': a map of logs for each linked program
         'mCompLogMutex': mutual exclution protection for compile logs
         'mLinkLogMutex': mutual exclusion protection for link logs
+        'mBinaryCacheDir': directory program binaries are cached in; empty if the cache is disabled
+        'mBinaryCacheStats': running totals of cache hits, misses, and rejections
+        'mBinaryCacheMutex': mutual exclusion protection for the binary cache settings and stats
+        'mBoundProgram': the program last bound with 'UseProgram'; nullptr if none, or a PPO is bound
+        'mBoundProgramId': id of 'mBoundProgram' when it was bound, in case it was rebuilt since
+        'mUniformShadowStats': running totals of uploads and binds skipped because nothing changed
+        'mShaderObjects': every shader compiled from source with the type and text it came from, by 'HashBytesFNV1a'
+            of those; weak, so shaders are still freed when nothing uses them
+        'mShaderObjectStats': running totals of shaders shared and compiled
+        'mShaderObjectSweep': size 'mShaderObjects' may grow to before expired entries are removed
+        'mShaderObjectMutex': mutual exclusion protection for the shader object cache and stats
+        'mIncludeDirs': directories searched for '#include' files, in order
+        'mIncludeArchive': archive searched for '#include' files after 'mIncludeDirs'; nullptr if none
+        'mIncludeMutex': mutual exclusion protection for the include search paths
+        'mProgramVariants': programs built by '*ProgramVariant*', by 'HashProgramSources' of the preprocessed sources
+        'mVariantStats': running totals of variant requests and compiles
+        'mVariantMutex': mutual exclusion protection for the variant cache and stats
 
     Note:
         Much of this is pass-by-reference in order to still have valid data members even
@@ -898,6 +2100,35 @@ class OBJGLUF_API ShaderManager
     mutable std::mutex mCompLogMutex;
     mutable std::mutex mLinkLogMutex;
 
+    std::string mBinaryCacheDir;
+    ProgramBinaryCacheStats mBinaryCacheStats;
+    mutable std::mutex mBinaryCacheMutex;
+
+    mutable ProgramPtr mBoundProgram;
+    mutable GLuint mBoundProgramId = 0;
+    mutable UniformShadowStats mUniformShadowStats;
+
+    //the source is kept to be compared on a hit, so a hash collision cannot return the wrong shader
+    struct ShaderObjectEntry
+    {
+        ShaderType mType;
+        std::string mText;
+        ShaderPtrWeak mShader;
+    };
+
+    std::unordered_map<uint64_t, ShaderObjectEntry> mShaderObjects;
+    ShaderObjectStats mShaderObjectStats;
+    std::size_t mShaderObjectSweep = 64;
+    mutable std::mutex mShaderObjectMutex;
+
+    std::vector<std::string> mIncludeDirs;
+    AssetArchivePtr mIncludeArchive;
+    mutable std::mutex mIncludeMutex;
+
+    std::unordered_map<uint64_t, PendingProgramPtr> mProgramVariants;
+    ProgramVariantStats mVariantStats;
+    mutable std::mutex mVariantMutex;
+
     /*
     AddCompileLog
 
@@ -932,57 +2163,330 @@ class OBJGLUF_API ShaderManager
             'name': the name of the uniform
 
         Returns:
-            the id of the uniform
+            the id of the uniform; -1 for uniforms which have no location, i.e. uniform block members
+
+        Throws:
+            'std::invalid_argument': in debug mode, if the program has no uniform called 'name'
     
     */
     GLuint GetUniformIdFromName(const SepProgramPtr& ppo, const std::string& name) const;
     GLuint GetUniformIdFromName(const ProgramPtr& prog, const std::string& name) const;
 
-public:
-
     /*
-    CreateShader*
-         
+    UniformChanged
+
+        -Compares a value about to be uploaded with the program's shadow copy, and updates the copy.  In
+            debug builds, also reports setters that do not match the uniform's reflected type
+
         Parameters:
-            'filePath': path to file containing shader
-            'text': text to compile
-            'memory': raw memory of text file loaded
-            'type': self-explanitory
-            'outShader': your brand spankin' new shader
+            'program': the program the value goes to; nullptr if unknown
+            'loc': the location of the uniform
+            'setterType': the type the setter uploads, i.e. GL_FLOAT_VEC3 for 'GLUniform3f'
+            'value': the value about to be uploaded; 'count' consecutive elements for array uploads
+            'size': size of one element of 'value' in bytes
+            'count': number of array elements uploaded, starting at 'loc'
 
-        Throws:
-            -CreateShaderFromFile: 'std::ios_base::failure': if file had issues reading
-            'MakeShaderException' if compilation, loading, or anything else failed
-    
+        Returns:
+            false if the program already has this value and the upload can be skipped
+
+        Note:
+            Anything that is not shadowed (unknown program, location, or a setter that does not match
+                the uniform's type) is always uploaded.  An array upload is skipped only if every element
+                is unchanged
     */
+    bool UniformChanged(Program* program, GLuint loc, GLenum setterType, const void* value, std::size_t size, GLsizei count = 1) const noexcept;
 
-    void CreateShaderFromFile(ShaderPtr& outShader, const std::string& filePath, ShaderType type);
-    void CreateShaderFromText(ShaderPtr& outShader, const std::string& text, ShaderType type);
-    void CreateShaderFromMemory(ShaderPtr& outShader, const std::vector<char>& memory, ShaderType type);
+    /*
+    BoundUniformChanged
 
+        -'UniformChanged' for the 'GLUniform*' setters, which upload to whatever program is current.  The shadow of
+            'mBoundProgram' is only used if that program is still current in 'GLSTATE'; if it was changed behind the
+            manager's back, the value is always uploaded and no shadow is touched.  Debug builds report that case
+
+        Returns:
+            false if the upload can be skipped
+    */
+    bool BoundUniformChanged(GLuint loc, GLenum setterType, const void* value, std::size_t size, GLsizei count = 1) const noexcept;
 
     /*
-    CreateProgram
-        
+    LinkProgram
+
         Parameters:
-            'shaders': simply a list of precompiled shaders to link
-            'shaderSources': a list of shader files in strings to be compiled
-            'shaderPaths': a list of shader file paths to be loaded into strings and compiled
-            'separate': WIP Don't Use
-            'outProgram': your brank spankin' new program
+            'outProgram': the program to create
+            'shaders': compiled shaders to link
+            'separate': whether the program is separable
+            'retrievable': hint to the driver that the binary will be read back for the cache
 
         Throws:
-            'std::ios_base::failure': if file loading has issues
-            'MakeProgramException' if linking failed
-            'MakeShaderException' if shaders need to be compiled and fail
-    
+            see 'CreateProgram'
     */
+    void LinkProgram(ProgramPtr& outProgram, const ShaderPtrList& shaders, bool separate, bool retrievable);
 
-    void CreateProgram(ProgramPtr& outProgram, ShaderPtrList shaders, bool separate = false);
+    /*
+    Submit*, Finish*
+
+        -The two halves of 'CreateShaderFromText' and 'LinkProgram'.  'Submit*' hands the work to the driver,
+            'Finish*' waits for the result, then logs and throws exactly as the synchronous versions do
+
+        Parameters:
+            'outShader', 'outProgram': the object to create
+            'shader', 'program': the submitted object to check
+            see 'CreateShaderFromText' and 'LinkProgram' for the rest
+
+        Throws:
+            see 'CreateShaderFromText' and 'LinkProgram'
+    */
+    void SubmitShader(ShaderPtr& outShader, const std::string& text, ShaderType type);
+    void FinishShader(const ShaderPtr& shader);
+    void SubmitLink(ProgramPtr& outProgram, const ShaderPtrList& shaders, bool separate, bool retrievable);
+    void FinishLink(const ProgramPtr& program);
+
+    /*
+    *CachedProgram
+
+        Parameters:
+            'outProgram': the program to create from the cache
+            'program': the linked program to store in the cache
+            'directory': the cache directory
+            'key': hash of the sources, stages, driver, and 'separate' flag; see 'HashProgramSources'
+            'separate': whether the program is separable
+
+        Returns:
+            LoadCachedProgram: true if 'outProgram' was created from the cache
+
+        Throws:
+            no-throw guarantee; cache failures are logged and fall back to compiling from source
+    */
+    bool LoadCachedProgram(ProgramPtr& outProgram, const std::string& directory, uint64_t key, bool separate) noexcept;
+    void StoreCachedProgram(const ProgramPtr& program, const std::string& directory, uint64_t key) noexcept;
+
+public:
+
+    /*
+    CreateShader*
+         
+        Parameters:
+            'filePath': path to file containing shader
+            'text': text to compile
+            'memory': raw memory of text file loaded (a 'std::vector<char>' or a 'MappedFile' view)
+            'type': self-explanitory
+            'outShader': your brand spankin' new shader
+
+        Throws:
+            -CreateShaderFromFile: 'std::ios_base::failure': if file had issues reading
+            'MakeShaderException' if compilation, loading, or anything else failed
+
+        Note:
+            Shaders are shared: while a shader with the same type and text is alive, it is handed out again
+                instead of being compiled, and this includes the stages 'CreateProgram' compiles.  Do not
+                'DeleteShader' one that something else may still link with
+    
+    */
+
+    void CreateShaderFromFile(ShaderPtr& outShader, const std::string& filePath, ShaderType type);
+    void CreateShaderFromText(ShaderPtr& outShader, const std::string& text, ShaderType type);
+    void CreateShaderFromMemory(ShaderPtr& outShader, const MemorySpan& memory, ShaderType type);
+
+    /*
+    GetShaderObjectStats
+
+        Returns:
+            totals of shaders shared and compiled; see the note on 'CreateShader*'
+    */
+    ShaderObjectStats GetShaderObjectStats() const;
+
+
+    /*
+    CreateProgram
+        
+        Parameters:
+            'shaders': simply a list of precompiled shaders to link
+            'shaderSources': a list of shader files in strings to be compiled
+            'shaderPaths': a list of shader file paths to be loaded into strings and compiled
+            'separate': WIP Don't Use
+            'outProgram': your brank spankin' new program
+
+        Throws:
+            'std::ios_base::failure': if file loading has issues
+            'MakeProgramException' if linking failed
+            'MakeShaderException' if shaders need to be compiled and fail
+    
+    */
+
+    void CreateProgram(ProgramPtr& outProgram, ShaderPtrList shaders, bool separate = false);
     void CreateProgram(ProgramPtr& outProgram, ShaderSourceList shaderSources, bool separate = false);
     void CreateProgramFromFiles(ProgramPtr& outProgram, ShaderPathList shaderPaths, bool separate = false);
 
 
+    /*
+    *ProgramBinaryCache
+
+        Parameters:
+            'directory': existing directory to keep linked program binaries in; an empty string disables the cache
+
+        Returns:
+            GetProgramBinaryCache: the current cache directory
+            GetProgramBinaryCacheStats: totals since the cache was last set
+
+        Note:
+            Only programs created from source ('CreateProgram(ShaderSourceList)' and 'CreateProgramFromFiles') are
+                cached, keyed by 'HashProgramSources'.  The cached file also holds the attribute and uniform locations,
+                so a hit skips compiling, linking, and reflection entirely.  If the driver rejects a binary (i.e. after
+                a driver update), the file is deleted and the program is compiled from source as usual
+            This requires OpenGL 4.1 or GL_ARB_get_program_binary; otherwise the cache is silently unused
+    */
+    void SetProgramBinaryCache(const std::string& directory);
+    std::string GetProgramBinaryCache() const;
+    ProgramBinaryCacheStats GetProgramBinaryCacheStats() const;
+
+
+    /*
+    SubmitProgram
+
+        -Starts compiling and linking a program without waiting for the driver.  Submit a whole batch of programs
+            first, then poll them with 'IsProgramReady' and collect them with 'ResolveProgram', so the driver
+            compiles them in parallel while the application does other work
+
+        Parameters:
+            'outPending': handle to the program being built
+            'shaderSources': a list of shader files in strings to be compiled
+            'separate': see 'CreateProgram'
+
+        Throws:
+            nothing from compiling or linking; those errors are logged and thrown by 'ResolveProgram'
+
+        Note:
+            This uses the program binary cache like 'CreateProgram'; a cached program is ready immediately
+    */
+    void SubmitProgram(PendingProgramPtr& outPending, ShaderSourceList shaderSources, bool separate = false);
+
+    /*
+    IsProgramReady
+
+        Parameters:
+            'pending': a program from 'SubmitProgram'
+
+        Returns:
+            true if 'ResolveProgram' will not block.  Without GL_KHR/ARB_parallel_shader_compile, this is always
+                true, and resolving blocks like 'CreateProgram' does
+
+        Throws:
+            'std::invalid_argument': if 'pending' == nullptr
+    */
+    bool IsProgramReady(const PendingProgramPtr& pending) const;
+
+    /*
+    ResolveProgram
+
+        Parameters:
+            'outProgram': the finished program
+            'pending': a program from 'SubmitProgram'
+
+        Throws:
+            'std::invalid_argument': if 'pending' == nullptr
+            whatever 'CreateProgram' would have thrown for these sources, with the same logging; resolving the
+                same program again rethrows the same error
+
+        Note:
+            As with 'CreateProgram', a link failure is logged but not thrown; 'GetProgramLog' has the details
+    */
+    void ResolveProgram(ProgramPtr& outProgram, const PendingProgramPtr& pending);
+
+    /*
+    SetMaxShaderCompilerThreads
+
+        Parameters:
+            'count': how many threads the driver may compile on; 0 compiles on the calling thread, 0xFFFFFFFF
+                leaves it up to the driver
+
+        Note:
+            does nothing unless GL_ARB_parallel_shader_compile is supported
+    */
+    void SetMaxShaderCompilerThreads(GLuint count) const;
+
+
+    /*
+    *ShaderInclude*
+
+        Parameters:
+            'directory': a directory to search for '#include' files
+            'archive': an archive to search for '#include' files, after every directory; nullptr to stop using one
+
+        Note:
+            '#include "file"' is looked up relative to the file containing it first, then like '#include <file>':
+                in each directory, in the order they were added, then in the archive
+    */
+    void AddShaderIncludeDirectory(const std::string& directory);
+    void SetShaderIncludeArchive(const AssetArchivePtr& archive);
+    void ClearShaderIncludePaths();
+
+    /*
+    PreprocessShader
+
+        Parameters:
+            'text': the shader source
+            'defines': macros to define, by name; an empty value defines the name alone
+            'filePath': the file 'text' was loaded from, for relative includes; empty if none
+            'outFiles': if not nullptr, receives the file behind each source string number in the '#line'
+                directives ('text' itself is 0), for reading compile logs
+
+        Returns:
+            'text' with every '#include' replaced by the file's contents, and 'defines' inserted after '#version'
+
+        Throws:
+            'ShaderPreprocessException': if an include can not be found, includes itself, or includes nest deeper
+                than GLUF_SHADER_INCLUDE_DEPTH
+
+        Note:
+            Only '#include', '#pragma once' and '#version' are handled; everything else, including '#if', is left
+                for the driver, so an include inside a disabled '#if' block must still exist.
+            '#version' lines in included files are dropped, and '#line' directives are inserted around each include,
+                so line numbers in compile logs still match the original files
+    */
+    std::string PreprocessShader(const std::string& text, const ShaderDefineList& defines, const std::string& filePath = "",
+        ShaderNameList* outFiles = nullptr) const;
+
+
+    /*
+    *ProgramVariant*
+
+        -'CreateProgram' and 'SubmitProgram' for shaders that go through 'PreprocessShader'.  Variants are cached by
+            the hash of their preprocessed sources, so every material that asks for the same permutation shares one
+            program, which is only compiled the first time
+
+        Parameters:
+            'outProgram': the variant
+            'outPending': handle to the variant, for 'IsProgramReady' and 'ResolveProgram'; already resolved ones
+                are ready immediately
+            'shaderSources': the source of each stage
+            'shaderPaths': the file of each stage, which are loaded and preprocessed
+            'sourcePaths': the file each of 'shaderSources' came from, for relative includes; stages without one
+                only search the include paths
+            'defines': macros defined in every stage; see 'PreprocessShader'
+            'separate': see 'CreateProgram'
+
+        Returns:
+            GetProgramVariantStats: totals since the cache was last flushed
+
+        Throws:
+            'ShaderPreprocessException': see 'PreprocessShader'
+            CreateProgramVariantFromFiles: 'std::ios_base::failure': if a stage could not be loaded
+            see 'CreateProgram' and 'ResolveProgram'; a variant which failed to build fails the same way every
+                time it is requested, without being compiled again
+
+        Note:
+            Cached programs are shared, so do not 'DeleteProgram' them; 'FlushProgramVariants' releases the cache's
+                references, and the programs are deleted once nothing else holds them
+    */
+    void CreateProgramVariant(ProgramPtr& outProgram, const ShaderSourceList& shaderSources, const ShaderDefineList& defines, bool separate = false);
+    void CreateProgramVariantFromFiles(ProgramPtr& outProgram, const ShaderPathList& shaderPaths, const ShaderDefineList& defines, bool separate = false);
+    void SubmitProgramVariant(PendingProgramPtr& outPending, const ShaderSourceList& shaderSources, const ShaderDefineList& defines,
+        bool separate = false, const ShaderPathList& sourcePaths = ShaderPathList());
+
+    ProgramVariantStats GetProgramVariantStats() const;
+    void FlushProgramVariants();
+
+
     /*
     GetShader*Location
     
@@ -1008,6 +2512,79 @@ public:
     const VariableLocMap GetShaderAttribLocations(const SepProgramPtr& program) const;
     const VariableLocMap GetShaderUniformLocations(const SepProgramPtr& program) const;
 
+    /*
+    GetShaderVariableInfo
+
+        Parameters:
+            'program': the program to access
+            'locType': which variable type? (attribute or uniform)
+            'varName': name of the variable, as it is in 'GetShader*Locations'
+
+        Returns:
+            'ShaderVariableInfo': the variable's reflection record
+            'ShaderVariableInfoMap': every attribute's or uniform's record, by name
+
+        Throws:
+            'std::invalid_argument': if 'program' == nullptr
+            'std::invalid_argument': if 'varName' does not exist
+    */
+    const ShaderVariableInfo& GetShaderVariableInfo(const ProgramPtr& program, LocationType locType, const std::string& varName) const;
+    const ShaderVariableInfoMap& GetShaderVariableInfo(const ProgramPtr& program, LocationType locType) const;
+
+    const ShaderVariableInfoMap GetShaderVariableInfo(const SepProgramPtr& program, LocationType locType) const;
+
+
+    /*
+    GetUniformBlocks
+
+        Parameters:
+            'program': the program to access
+
+        Returns:
+            the program's active uniform blocks, by block name (not instance name); empty without OpenGL 3.1
+                or GL_ARB_uniform_buffer_object
+
+        Throws:
+            'std::invalid_argument': if 'program' == nullptr
+    */
+    const UniformBlockMap& GetUniformBlocks(const ProgramPtr& program) const;
+
+    /*
+    SetUniformBlockBinding
+
+        Parameters:
+            'program': the program to access
+            'blockName': name of the block (not the instance name)
+            'binding': the uniform buffer binding point the block should read from
+
+        Throws:
+            'std::invalid_argument': if 'program' == nullptr
+            'std::invalid_argument': if 'blockName' is not an active block of 'program'
+    */
+    void SetUniformBlockBinding(const ProgramPtr& program, const std::string& blockName, GLuint binding) const;
+
+
+    /*
+    GetUniformHandle
+
+        Parameters:
+            'program': the program to resolve the uniform in
+            'ppo': the pipeline whose active program the uniform is resolved in
+            'nameHash': 'HashStringFNV1a' of the uniform's name (arrays are named "name[0]")
+            'name': the uniform's name
+
+        Returns:
+            handle for the 'GLUniform*' and 'GLProgramUniform*' overloads; invalid (location -1) if the program
+                does not have the uniform, i.e. because the driver optimized it out
+
+        Throws:
+            'std::invalid_argument': if 'program' or 'ppo' == nullptr
+            'NoActiveProgramUniformException': if 'ppo' has no active program
+    */
+    UniformHandle GetUniformHandle(const ProgramPtr& program, uint64_t nameHash) const;
+    UniformHandle GetUniformHandle(const ProgramPtr& program, const std::string& name) const;
+    UniformHandle GetUniformHandle(const SepProgramPtr& ppo, uint64_t nameHash) const;
+
 
     /*
     Delete*
@@ -1065,6 +2642,10 @@ public:
         Throws:
             'std::invalid_argument': if program == nullptr
             'UseProgramException': if program id == 0 (For binding the null program, use UseProgramNull() instead)
+
+        Note:
+            Binding the program that is already bound does nothing.  This relies on every program being
+                bound through 'ShaderManager'; after binding one any other way, call 'UseProgramNull'
     
     */
 
@@ -1075,6 +2656,21 @@ public:
     void UseProgramNull() const noexcept;
 
 
+    /*
+    *UniformShadowStats
+
+        Returns:
+            GetUniformShadowStats: totals since the stats were last reset
+
+        Note:
+            Every program keeps a copy of the last value uploaded to each of its uniforms, and the 'GLUniform*' and
+                'GLProgramUniform*' setters skip the OpenGL call when the value has not changed.  Uniforms set
+                directly with OpenGL are not seen by this, so always set them through 'ShaderManager'
+    */
+    UniformShadowStats GetUniformShadowStats() const noexcept;
+    void ResetUniformShadowStats() noexcept;
+
+
     /*
     AttachPrograms
 
@@ -1136,6 +2732,8 @@ public:
         'value': the data to set as the uniform
         'loc': the location of the uniform
         'name': the name of the uniform
+        'handle': the uniform, resolved ahead of time with 'GetUniformHandle'; the fastest option for per-frame
+            uniforms, since nothing is looked up
 
     Throws:
         'std::invalid_argument': 'name' does not exist
@@ -1190,6 +2788,95 @@ public:
     void GLUniformMatrix3x4f(const ProgramPtr& prog, const std::string& name, const glm::mat3x4& value) const;
     void GLUniformMatrix4x3f(const ProgramPtr& prog, const std::string& name, const glm::mat4x3& value) const;
 
+    void GLUniform1f(UniformHandle handle, const GLfloat& value) const noexcept;
+    void GLUniform2f(UniformHandle handle, const glm::vec2& value) const noexcept;
+    void GLUniform3f(UniformHandle handle, const glm::vec3& value) const noexcept;
+    void GLUniform4f(UniformHandle handle, const glm::vec4& value) const noexcept;
+    void GLUniform1i(UniformHandle handle, const GLint& value) const noexcept;
+    void GLUniform2i(UniformHandle handle, const glm::i32vec2& value) const noexcept;
+    void GLUniform3i(UniformHandle handle, const glm::i32vec3& value) const noexcept;
+    void GLUniform4i(UniformHandle handle, const glm::i32vec4& value) const noexcept;
+    void GLUniform1ui(UniformHandle handle, const GLuint& value) const noexcept;
+    void GLUniform2ui(UniformHandle handle, const glm::u32vec2& value) const noexcept;
+    void GLUniform3ui(UniformHandle handle, const glm::u32vec3& value) const noexcept;
+    void GLUniform4ui(UniformHandle handle, const glm::u32vec4& value) const noexcept;
+    void GLUniformMatrix2f(UniformHandle handle, const glm::mat2& value) const noexcept;
+    void GLUniformMatrix3f(UniformHandle handle, const glm::mat3& value) const noexcept;
+    void GLUniformMatrix4f(UniformHandle handle, const glm::mat4& value) const noexcept;
+    void GLUniformMatrix2x3f(UniformHandle handle, const glm::mat2x3& value) const noexcept;
+    void GLUniformMatrix3x2f(UniformHandle handle, const glm::mat3x2& value) const noexcept;
+    void GLUniformMatrix2x4f(UniformHandle handle, const glm::mat2x4& value) const noexcept;
+    void GLUniformMatrix4x2f(UniformHandle handle, const glm::mat4x2& value) const noexcept;
+    void GLUniformMatrix3x4f(UniformHandle handle, const glm::mat3x4& value) const noexcept;
+    void GLUniformMatrix4x3f(UniformHandle handle, const glm::mat4x3& value) const noexcept;
+
+    /*
+    GLUniform*v
+
+        -Uploads 'count' elements of a uniform array in one call, starting at 'loc', 'name', or 'handle'.  Pass
+            the array's first element ("lights[0]") to upload the whole array at once
+
+    Note:
+        like 'GLUniform*', the program must already be bound with 'UseProgram'
+
+    Parameters:
+        'values': 'count' tightly packed elements
+        'count': number of elements to upload; must not run past the end of the array
+        'loc', 'name', 'handle': the first element to upload, like 'GLUniform*'
+
+    Throws:
+        'std::invalid_argument': 'name' does not exist
+
+    */
+
+    void GLUniform1fv(GLuint loc, const GLfloat* values, GLsizei count) const noexcept;
+    void GLUniform2fv(GLuint loc, const glm::vec2* values, GLsizei count) const noexcept;
+    void GLUniform3fv(GLuint loc, const glm::vec3* values, GLsizei count) const noexcept;
+    void GLUniform4fv(GLuint loc, const glm::vec4* values, GLsizei count) const noexcept;
+    void GLUniform1iv(GLuint loc, const GLint* values, GLsizei count) const noexcept;
+    void GLUniform2iv(GLuint loc, const glm::i32vec2* values, GLsizei count) const noexcept;
+    void GLUniform3iv(GLuint loc, const glm::i32vec3* values, GLsizei count) const noexcept;
+    void GLUniform4iv(GLuint loc, const glm::i32vec4* values, GLsizei count) const noexcept;
+    void GLUniform1uiv(GLuint loc, const GLuint* values, GLsizei count) const noexcept;
+    void GLUniform2uiv(GLuint loc, const glm::u32vec2* values, GLsizei count) const noexcept;
+    void GLUniform3uiv(GLuint loc, const glm::u32vec3* values, GLsizei count) const noexcept;
+    void GLUniform4uiv(GLuint loc, const glm::u32vec4* values, GLsizei count) const noexcept;
+    void GLUniformMatrix2fv(GLuint loc, const glm::mat2* values, GLsizei count) const noexcept;
+    void GLUniformMatrix3fv(GLuint loc, const glm::mat3* values, GLsizei count) const noexcept;
+    void GLUniformMatrix4fv(GLuint loc, const glm::mat4* values, GLsizei count) const noexcept;
+
+    void GLUniform1fv(const ProgramPtr& prog, const std::string& name, const GLfloat* values, GLsizei count) const;
+    void GLUniform2fv(const ProgramPtr& prog, const std::string& name, const glm::vec2* values, GLsizei count) const;
+    void GLUniform3fv(const ProgramPtr& prog, const std::string& name, const glm::vec3* values, GLsizei count) const;
+    void GLUniform4fv(const ProgramPtr& prog, const std::string& name, const glm::vec4* values, GLsizei count) const;
+    void GLUniform1iv(const ProgramPtr& prog, const std::string& name, const GLint* values, GLsizei count) const;
+    void GLUniform2iv(const ProgramPtr& prog, const std::string& name, const glm::i32vec2* values, GLsizei count) const;
+    void GLUniform3iv(const ProgramPtr& prog, const std::string& name, const glm::i32vec3* values, GLsizei count) const;
+    void GLUniform4iv(const ProgramPtr& prog, const std::string& name, const glm::i32vec4* values, GLsizei count) const;
+    void GLUniform1uiv(const ProgramPtr& prog, const std::string& name, const GLuint* values, GLsizei count) const;
+    void GLUniform2uiv(const ProgramPtr& prog, const std::string& name, const glm::u32vec2* values, GLsizei count) const;
+    void GLUniform3uiv(const ProgramPtr& prog, const std::string& name, const glm::u32vec3* values, GLsizei count) const;
+    void GLUniform4uiv(const ProgramPtr& prog, const std::string& name, const glm::u32vec4* values, GLsizei count) const;
+    void GLUniformMatrix2fv(const ProgramPtr& prog, const std::string& name, const glm::mat2* values, GLsizei count) const;
+    void GLUniformMatrix3fv(const ProgramPtr& prog, const std::string& name, const glm::mat3* values, GLsizei count) const;
+    void GLUniformMatrix4fv(const ProgramPtr& prog, const std::string& name, const glm::mat4* values, GLsizei count) const;
+
+    void GLUniform1fv(UniformHandle handle, const GLfloat* values, GLsizei count) const noexcept;
+    void GLUniform2fv(UniformHandle handle, const glm::vec2* values, GLsizei count) const noexcept;
+    void GLUniform3fv(UniformHandle handle, const glm::vec3* values, GLsizei count) const noexcept;
+    void GLUniform4fv(UniformHandle handle, const glm::vec4* values, GLsizei count) const noexcept;
+    void GLUniform1iv(UniformHandle handle, const GLint* values, GLsizei count) const noexcept;
+    void GLUniform2iv(UniformHandle handle, const glm::i32vec2* values, GLsizei count) const noexcept;
+    void GLUniform3iv(UniformHandle handle, const glm::i32vec3* values, GLsizei count) const noexcept;
+    void GLUniform4iv(UniformHandle handle, const glm::i32vec4* values, GLsizei count) const noexcept;
+    void GLUniform1uiv(UniformHandle handle, const GLuint* values, GLsizei count) const noexcept;
+    void GLUniform2uiv(UniformHandle handle, const glm::u32vec2* values, GLsizei count) const noexcept;
+    void GLUniform3uiv(UniformHandle handle, const glm::u32vec3* values, GLsizei count) const noexcept;
+    void GLUniform4uiv(UniformHandle handle, const glm::u32vec4* values, GLsizei count) const noexcept;
+    void GLUniformMatrix2fv(UniformHandle handle, const glm::mat2* values, GLsizei count) const noexcept;
+    void GLUniformMatrix3fv(UniformHandle handle, const glm::mat3* values, GLsizei count) const noexcept;
+    void GLUniformMatrix4fv(UniformHandle handle, const glm::mat4* values, GLsizei count) const noexcept;
+
     /*
     GLProgramUniform*
     
@@ -1202,6 +2889,7 @@ public:
             'value': the data to set as the uniform
             'loc': the location of the uniform
             'name': the name of the uniform
+            'handle': the uniform, resolved from the active program with 'GetUniformHandle'
 
         Throws:
             'std::invalid_argument': if 'ppo' == nullptr
@@ -1258,6 +2946,28 @@ public:
     void GLProgramUniformMatrix3x4f(const SepProgramPtr& ppo, const std::string& name, const glm::mat3x4& value) const;
     void GLProgramUniformMatrix4x3f(const SepProgramPtr& ppo, const std::string& name, const glm::mat4x3& value) const;
 
+    void GLProgramUniform1f(const SepProgramPtr& ppo, UniformHandle handle, const GLfloat& value) const;
+    void GLProgramUniform2f(const SepProgramPtr& ppo, UniformHandle handle, const glm::vec2& value) const;
+    void GLProgramUniform3f(const SepProgramPtr& ppo, UniformHandle handle, const glm::vec3& value) const;
+    void GLProgramUniform4f(const SepProgramPtr& ppo, UniformHandle handle, const glm::vec4& value) const;
+    void GLProgramUniform1i(const SepProgramPtr& ppo, UniformHandle handle, const GLint& value) const;
+    void GLProgramUniform2i(const SepProgramPtr& ppo, UniformHandle handle, const glm::i32vec2& value) const;
+    void GLProgramUniform3i(const SepProgramPtr& ppo, UniformHandle handle, const glm::i32vec3& value) const;
+    void GLProgramUniform4i(const SepProgramPtr& ppo, UniformHandle handle, const glm::i32vec4& value) const;
+    void GLProgramUniform1ui(const SepProgramPtr& ppo, UniformHandle handle, const GLuint& value) const;
+    void GLProgramUniform2ui(const SepProgramPtr& ppo, UniformHandle handle, const glm::u32vec2& value) const;
+    void GLProgramUniform3ui(const SepProgramPtr& ppo, UniformHandle handle, const glm::u32vec3& value) const;
+    void GLProgramUniform4ui(const SepProgramPtr& ppo, UniformHandle handle, const glm::u32vec4& value) const;
+    void GLProgramUniformMatrix2f(const SepProgramPtr& ppo, UniformHandle handle, const glm::mat2& value) const;
+    void GLProgramUniformMatrix3f(const SepProgramPtr& ppo, UniformHandle handle, const glm::mat3& value) const;
+    void GLProgramUniformMatrix4f(const SepProgramPtr& ppo, UniformHandle handle, const glm::mat4& value) const;
+    void GLProgramUniformMatrix2x3f(const SepProgramPtr& ppo, UniformHandle handle, const glm::mat2x3& value) const;
+    void GLProgramUniformMatrix3x2f(const SepProgramPtr& ppo, UniformHandle handle, const glm::mat3x2& value) const;
+    void GLProgramUniformMatrix2x4f(const SepProgramPtr& ppo, UniformHandle handle, const glm::mat2x4& value) const;
+    void GLProgramUniformMatrix4x2f(const SepProgramPtr& ppo, UniformHandle handle, const glm::mat4x2& value) const;
+    void GLProgramUniformMatrix3x4f(const SepProgramPtr& ppo, UniformHandle handle, const glm::mat3x4& value) const;
+    void GLProgramUniformMatrix4x3f(const SepProgramPtr& ppo, UniformHandle handle, const glm::mat4x3& value) const;
+
 
     /*
     GLActiveShaderProgram
@@ -1344,7 +3054,8 @@ LoadTextureFrom*
     Parameters:
         'filePath': path to file to open
         'format': texture file format to be loaded
-        'data': raw data to load texture from
+        'data': raw data to load texture from; a 'std::vector<char>' or a 'MappedFile' view both work
+        'target': if not null, set to what the texture binds to; for 'TFF_DDS' this comes from the file's header
 
     Returns:
         OpenGL texture ID of the created texture
@@ -1354,72 +3065,217 @@ LoadTextureFrom*
         'TextureCreationException': if texture creation failed
 
     Note:
-        All textures currently must be in ABGR format
+        See 'ParseDDS' for the supported DDS formats; 'TFF_DDS' loads whatever the file describes, including arrays and cubemaps
         When using loaded textures, flip the UV coords of your meshes (the included mesh loaders do that for you) due to the DDS files loading upside-down
-        If formats other than ABGR are supported, ABGR will likely be faster at loading
+        Block compressed formats (BC1-BC7) upload without any conversion, and use a quarter of the memory of RGBA or less; 
+            formats the context does not support are decoded on the CPU instead (see 'DecompressDDS')
+        'LoadTextureFromFile' maps the file rather than reading it, so the data is never copied before reaching OpenGL
 
 */
-GLuint OBJGLUF_API LoadTextureFromFile(const std::string& filePath, TextureFileFormat format);
-GLuint OBJGLUF_API LoadTextureFromMemory(const std::vector<char>& data, TextureFileFormat format);//this is broken, WHY
-
-
-
+GLuint OBJGLUF_API LoadTextureFromFile(const std::string& filePath, TextureFileFormat format, GLenum* target = nullptr);
+GLuint OBJGLUF_API LoadTextureFromMemory(const MemorySpan& data, TextureFileFormat format, GLenum* target = nullptr);//this is broken, WHY
 
 /*
+DDSMipLevel
 
-Buffer Utilities
+    Data Members:
+        'mWidth', 'mHeight': dimensions of this mip level
+        'mLevel': mip level, 0 being the largest
+        'mLayer': array element this level belongs to; 0 for textures which are not arrays
+        'mFace': cubemap face, in GL_TEXTURE_CUBE_MAP_POSITIVE_X + 'mFace' order; 0 for textures which are not cubemaps
+        'mOffset': byte offset of the level within the file
+        'mSize': size of the level in bytes
 
 */
-
-
-struct MeshBarebones
+struct DDSMipLevel
 {
-    Vec3Array mVertices;
-    IndexArray mIndices;
+    unsigned int mWidth;
+    unsigned int mHeight;
+    unsigned int mLevel = 0;
+    unsigned int mLayer = 0;
+    unsigned int mFace = 0;
+    std::size_t mOffset;
+    std::size_t mSize;
 };
 
+/*
+DDSImage
 
+    The result of walking a DDS header; everything needed to upload the file, without touching OpenGL
 
-/*
-VertexAttribInfo
+    Data Members:
+        'mTarget': GL_TEXTURE_2D, GL_TEXTURE_2D_ARRAY, GL_TEXTURE_CUBE_MAP, or GL_TEXTURE_CUBE_MAP_ARRAY
+        'mCompressedFormat': OpenGL compressed internal format, or 0 if the data is uncompressed
+        'mInternalFormat': internal format to create the texture with; the same as 'mCompressedFormat' if it is compressed
+        'mFormat', 'mType': layout of uncompressed data, as passed to glTexImage*
+        'mSwizzle': GL_TEXTURE_SWIZZLE_RGBA to use; luminance and alpha only formats are loaded as red (and green)
+        'mWidth', 'mHeight': dimensions of the largest mip level
+        'mLayers': number of array elements; 1 for textures which are not arrays
+        'mFaces': 6 for cubemaps, 1 otherwise
+        'mMipCount': mip levels per face
+        'mMipLevels': location and size of each mip level; the levels of each face are together, largest first, and 
+            faces are in file order, so index ('mLayer' * 'mFaces' + 'mFace') * 'mMipCount' + 'mLevel'
 
-    Member Data:
-        'mBytesPerElement': the number of bytes per element of the vertex
-        'mElementsPerValue': the number of elements per vector value
-        'mVertexAttribLocation': the location of the vertex attribute
-        'mType': primitive type of the data
 */
-
-struct OBJGLUF_API VertexAttribInfo
+struct DDSImage
 {
-    unsigned short mBytesPerElement;//int would be 4
-    unsigned short mElementsPerValue;//vec4 would be 4
-    AttribLoc  mVertexAttribLocation;
-    GLenum         mType;//float would be GL_FLOAT
-    GLuint         mOffset;//will be 0 in SoA
+    GLenum mTarget = GL_TEXTURE_2D;
+    GLenum mCompressedFormat = 0;
+    GLenum mInternalFormat = GL_RGBA8;
+    GLenum mFormat = GL_RGBA;
+    GLenum mType = GL_UNSIGNED_BYTE;
+    GLint mSwizzle[4] = { GL_RED, GL_GREEN, GL_BLUE, GL_ALPHA };
+
+    unsigned int mWidth = 0;
+    unsigned int mHeight = 0;
+    unsigned int mLayers = 1;
+    unsigned int mFaces = 1;
+    unsigned int mMipCount = 1;
+    std::vector<DDSMipLevel> mMipLevels;
 };
 
 /*
+ParseDDS
 
-Vertex Array Exceptions
+    Parameters:
+        'rawData': raw data loaded from file
+
+    Returns:
+        the layout of the texture within 'rawData'
+
+    Throws:
+        'std::invalid_argument': if data is too small, is not the correct file format, has a pixel format or dimension 
+            which is not supported (volume textures, partial cubemaps, cubemaps with faces which are not square, and 
+            cubemap arrays on contexts without GL 4.0 or ARB_texture_cube_map_array), or if any mip level or array
+            element runs past the end of the data
 
+    Note:
+        This does not call OpenGL, so it is safe to call from any thread
+        Both the legacy header and the DX10 extended header are read.  Supported formats are BC1-BC7 (including the 
+            sRGB and signed variants), and the common uncompressed 8, 16, and 32 bit per channel, packed, and float formats
 
 */
+DDSImage OBJGLUF_API ParseDDS(const MemorySpan& rawData);
 
-class MakeVOAException : public Exception
-{
-public:
-    virtual const char* what() const noexcept override
-    {
-        return "VAO Creation Failed!";
-    }
+/*
+IsCompressedFormatSupported
 
-    EXCEPTION_CONSTRUCTOR(MakeVOAException)
-};
+    Parameters:
+        'compressedFormat': a block compressed internal format, i.e. 'DDSImage::mCompressedFormat'
 
-class InvalidSoABufferLenException : public Exception
-{
-public:
+    Returns:
+        true if the current context can create textures with that format; false for formats which are not block compressed
+
+    Note:
+        Decided once by 'InitOpenGLExtensions' (or 'InstallRecordingBackend') from the version and the S3TC, sRGB, RGTC, 
+            and BPTC extensions, so this is safe to call from any thread
+
+*/
+bool OBJGLUF_API IsCompressedFormatSupported(GLenum compressedFormat);
+
+/*
+DecompressDDS
+
+    Parameters:
+        'image': the parsed layout of 'rawData'; must be block compressed
+        'rawData': raw data 'image' was parsed from
+        'decoded': filled with the decoded levels
+
+    Returns:
+        the layout of 'decoded', with the same levels as 'image': BC1-BC3 and BC7 become RGBA8 (or SRGB8_ALPHA8), BC4 and 
+            BC5 become R8 and RG8 (SNORM if signed), and BC6H becomes RGB16F
+
+    Throws:
+        'std::invalid_argument': if 'image' is not block compressed, or a level runs past the end of 'rawData'
+
+    Note:
+        This does not call OpenGL, so it is safe to call from any thread, including 'ASYNCLOADER' workers.  Rows of
+            blocks are split between the calling thread and idle 'ASYNCLOADER' workers if the pool is already running;
+            otherwise (e.g. a synchronous 'LoadTextureFromFile' in a program which never uses 'ASYNCLOADER') all of
+            them are decoded on the calling thread.  No threads are created for a call, and the caller never waits
+            on a busy pool
+        On x86 the endpoint interpolation of every format is SSE2 (BC1-BC3's color lookup also has an AVX2 version,
+            picked at runtime); the index and endpoint fields are unpacked with scalar shifts.  Other targets use the
+            scalar version of everything
+        Textures loaded through 'LoadTextureFromFile', 'AsyncLoader', and 'TextureStreamer' are decoded automatically 
+            when 'IsCompressedFormatSupported' is false, so the same assets load on every context
+
+*/
+DDSImage OBJGLUF_API DecompressDDS(const DDSImage& image, const MemorySpan& rawData, std::vector<char>& decoded);
+
+/*
+GetTextureMemorySize
+
+    Parameters:
+        'texture': OpenGL texture id
+        'target': what the texture is bound to (GL_TEXTURE_2D, GL_TEXTURE_CUBE_MAP, etc.)
+
+    Returns:
+        number of bytes used by the texture's whole mip chain (all faces for cubemaps)
+
+    Note:
+        This queries OpenGL for every level, so it is meant to be called once at load time, not per frame
+*/
+std::size_t OBJGLUF_API GetTextureMemorySize(GLuint texture, GLenum target = GL_TEXTURE_2D);
+
+
+
+
+/*
+
+Buffer Utilities
+
+*/
+
+
+struct MeshBarebones
+{
+    Vec3Array mVertices;
+    IndexArray mIndices;
+};
+
+
+
+/*
+VertexAttribInfo
+
+    Member Data:
+        'mBytesPerElement': the number of bytes per element of the vertex
+        'mElementsPerValue': the number of elements per vector value
+        'mVertexAttribLocation': the location of the vertex attribute
+        'mType': primitive type of the data
+*/
+
+struct OBJGLUF_API VertexAttribInfo
+{
+    unsigned short mBytesPerElement;//int would be 4
+    unsigned short mElementsPerValue;//vec4 would be 4
+    AttribLoc  mVertexAttribLocation;
+    GLenum         mType;//float would be GL_FLOAT
+    GLuint         mOffset;//will be 0 in SoA
+};
+
+/*
+
+Vertex Array Exceptions
+
+
+*/
+
+class MakeVOAException : public Exception
+{
+public:
+    virtual const char* what() const noexcept override
+    {
+        return "VAO Creation Failed!";
+    }
+
+    EXCEPTION_CONSTRUCTOR(MakeVOAException)
+};
+
+class InvalidSoABufferLenException : public Exception
+{
+public:
     virtual const char* what() const noexcept override
     {
         return "Buffer Passed Has Length Inconsistent With the Vertex Attributes!";
@@ -1591,7 +3447,8 @@ public:
     Draw*
 
         -These functions wrap the whole drawing process into one function call;
-        -BindVertexArray is automatically called
+        -BindVertexArray is automatically called, and the vertex array is left bound afterwards, so drawing
+            the same vertex array again does not rebind it
 
         Parameters:
             'start': starting index of ranged draw
@@ -1636,6 +3493,20 @@ public:
     void BufferIndices(const std::vector<glm::u32vec4>& indices) noexcept;
     //void BufferFaces(GLuint* indices, GLuint FaceCount);
 
+    /*
+    GetBufferMemorySize
+
+        Returns:
+            number of bytes held in this vertex array's OpenGL buffers (vertex data plus indices)
+
+        Throws:
+            no-throw guarantee
+
+        Note:
+            This is calculated from the vertex count and attribute sizes, so it does not query OpenGL
+    */
+    virtual std::size_t GetBufferMemorySize() const noexcept;
+
     /*
     Enable/DisableVertexAttributes
 
@@ -1860,6 +3731,9 @@ public:
     */
     GLuint GetVertexSize() const noexcept;
 
+    //see parent docs
+    virtual std::size_t GetBufferMemorySize() const noexcept override;
+
 
 
     /*
@@ -1894,6 +3768,20 @@ public:
     template<typename T>
     void BufferData(const GLVector<T>& data);
 
+    /*
+    BufferData
+
+        -To add whole vertex arrays to the VAO from already interleaved vertices. Truncates old data
+
+        Parameters:
+            'data': the raw vertices, laid out as described by the vertex attributes
+
+        Throws:
+            'std::invalid_argument' if the size of 'data' is not a multiple of 'GetVertexSize()'
+
+    */
+    void BufferData(const MemorySpan& data);
+
     
     /*
     ResizeBuffer
@@ -1936,6 +3824,25 @@ public:
     template<typename T>
     void BufferSubData(GLVector<T> data, std::vector<GLuint> vertexLocations, bool isSorted = false);
 
+    /*
+    ChunkSubData
+
+        -The part of 'BufferSubData' that does not touch OpenGL; sorts the vertices by location and splits them into
+            contiguous chunks
+
+        Parameters:
+            'data': vertices to split up; reordered along with 'vertexLocations'
+            'vertexLocations': location of each vertex in 'data'; sorted in place unless 'isSorted'
+            'isSorted': set this to 'true' if the vertex locations are in order
+            'chunkedData': receives each contiguous chunk of vertices
+            'chunkOffsets': receives the vertex location of the start of each chunk
+
+        Throws:
+            'std::invalid_argument' if 'vertexLocations' contains any duplicates
+    */
+    template<typename T>
+    static void ChunkSubData(GLVector<T>& data, std::vector<GLuint>& vertexLocations, bool isSorted, std::vector<GLVector<T>>& chunkedData, std::vector<GLuint>& chunkOffsets);
+
     /*
     Enable/DisableVertexAttrib
 
@@ -2010,6 +3917,9 @@ public:
     VertexArraySoA(VertexArraySoA&& other);
     VertexArraySoA& operator=(VertexArraySoA&& other);
 
+    //see parent docs
+    virtual std::size_t GetBufferMemorySize() const noexcept override;
+
 
     /*
     GetBarebonesMesh
@@ -2098,81 +4008,1219 @@ using VertexArrayPtr    = std::shared_ptr<VertexArray>;
 
 /*
 =======================================================================================================================================================================================================
-Utility Functions if Assimp is being used
+Uniform Buffers
+
+*/
+
+/*
+Std140 Layout
+
+    A C++ struct streamed into a uniform block has to have the same memory layout as the GLSL block does under
+        std140.  Declare scalars, vectors, and mat4's with 'GLUF_STD140', which gives them their std140 alignment
+        (a scalar after a vec3 still packs into the vec3's last four bytes, like it does in GLSL).  std140 pads
+        every array element and every mat2/mat3 column out to 16 bytes, so use 'Std140Array', 'Std140Mat2', and
+        'Std140Mat3' for those; they are aligned on their own:
+
+        layout(std140) uniform Transforms          struct Transforms
+        {                                          {
+            mat4 MVP;                                  GLUF_STD140(glm::mat4, mMVP);
+            mat3 NormalMatrix;                         Std140Mat3 mNormalMatrix;
+            vec3 LightPosition;                        GLUF_STD140(glm::vec3, mLightPosition);
+            float LightPower;                          GLUF_STD140(GLfloat, mLightPower);
+            float Weights[4];                          Std140Array<GLfloat, 4> mWeights;
+        };                                         };
 
     Note:
-        this part of the library does use nakid pointers to match up with Assimp usage examples
+        bool members are 4 bytes in GLSL; use GLuint for them
 
 */
+template<typename T>
+struct Std140Alignment
+{
+    static const std::size_t value = 16;//vec3, vec4, and matrices
+};
 
-#ifdef USING_ASSIMP
+template<> struct Std140Alignment<GLfloat>      { static const std::size_t value = 4; };
+template<> struct Std140Alignment<GLint>        { static const std::size_t value = 4; };
+template<> struct Std140Alignment<GLuint>       { static const std::size_t value = 4; };
+template<> struct Std140Alignment<glm::vec2>    { static const std::size_t value = 8; };
+template<> struct Std140Alignment<glm::i32vec2> { static const std::size_t value = 8; };
+template<> struct Std140Alignment<glm::u32vec2> { static const std::size_t value = 8; };
 
-/*
+#define GLUF_STD140(type, name) alignas(::GLUF::Std140Alignment<type>::value) type name
 
-Data Members for Assimp Loading
+template<typename T, std::size_t N>
+struct alignas(16) Std140Array
+{
+    struct alignas(16) Element
+    {
+        T mValue;
+    };
 
-VertexAttribMap:
-Data structure of all of the vertex attributes to load from the assimp scene
+    Element mElements[N];
 
-VertexAttribPair:
-Pair of a vertex attribute, and the attribute info to go with it
+    T& operator[](std::size_t i) noexcept { return mElements[i].mValue; }
+    const T& operator[](std::size_t i) const noexcept { return mElements[i].mValue; }
+    static std::size_t size() noexcept { return N; }
+};
 
-*/
-using VertexAttribMap = std::map<unsigned char, VertexAttribInfo>;
-using VertexAttribPair = std::pair<unsigned char, VertexAttribInfo>;
+struct alignas(16) Std140Mat2
+{
+    glm::vec4 mColumns[2];
+
+    Std140Mat2() noexcept = default;
+    Std140Mat2(const glm::mat2& mat) noexcept { *this = mat; }
+    Std140Mat2& operator=(const glm::mat2& mat) noexcept
+    {
+        mColumns[0] = glm::vec4(mat[0], 0.0f, 0.0f);
+        mColumns[1] = glm::vec4(mat[1], 0.0f, 0.0f);
+        return *this;
+    }
+};
+
+struct alignas(16) Std140Mat3
+{
+    glm::vec4 mColumns[3];
+
+    Std140Mat3() noexcept = default;
+    Std140Mat3(const glm::mat3& mat) noexcept { *this = mat; }
+    Std140Mat3& operator=(const glm::mat3& mat) noexcept
+    {
+        mColumns[0] = glm::vec4(mat[0], 0.0f);
+        mColumns[1] = glm::vec4(mat[1], 0.0f);
+        mColumns[2] = glm::vec4(mat[2], 0.0f);
+        return *this;
+    }
+};
 
+static_assert(sizeof(Std140Array<GLfloat, 4>) == 64, "Std140Array must match the std140 layout");
+static_assert(sizeof(Std140Mat3) == 48, "Std140Mat3 must match the std140 layout");
+
+//how many frames a persistent-mapped 'UniformStreamBuffer' keeps in flight
+#define GLUF_UNIFORM_STREAM_FRAMES 3
 
 /*
+UniformStreamAllocation
 
-Assimp Loading Exceptions
+    Data Members:
+        'mData': where to write the block; only valid until the stream's next 'EndFrame'
+        'mOffset': the allocation's offset in the stream's buffer
+        'mSize': bytes allocated
 
 */
-
+struct UniformStreamAllocation
+{
+    void* mData = nullptr;
+    GLintptr mOffset = 0;
+    GLsizeiptr mSize = 0;
+};
 
 /*
-LoadVertexArrayFromScene
+UniformStreamStats
 
-    Parameters:
-        'scene': assimp 'aiScene': to load from
-        'meshNum': which mesh number to load from the scene
-        'inputs': which vertex attributes to load
+    Data Members:
+        'mAllocations': lifetime allocation count
+        'mAllocatedBytes': lifetime bytes allocated, including alignment padding
+        'mUploads': glBufferSubData calls made to upload allocations; always 0 if persistent-mapped
+        'mFenceWaits': frames that had to wait for the GPU to finish with their part of the buffer
 
-    Returns:
-        shared pointer to the loaded vertex array
+*/
+struct UniformStreamStats
+{
+    unsigned long long mAllocations = 0;
+    unsigned long long mAllocatedBytes = 0;
+    unsigned long long mUploads = 0;
+    unsigned long long mFenceWaits = 0;
+};
 
-    Throws:
-        'std::invalid_argument': if 'meshNum' is higher than the number of meshes in 'scene'
+/*
+UniformStreamBuffer
 
-        TOOD: SEE ASSIMP DOCUMENTATION TO SEE WHAT IT THROWS PLUS WHAT THIS MIGHT THROW
+    -One large uniform buffer that per-draw uniform block data is sub-allocated from, so the whole frame's
+        blocks cost one buffer instead of one each.  If GL_ARB_buffer_storage is available (core in 4.4), the
+        buffer is mapped persistently and split into 'GLUF_UNIFORM_STREAM_FRAMES' regions, so the CPU writes
+        one frame while the GPU reads the previous ones.  Otherwise allocations are staged in client memory and
+        uploaded with one glBufferSubData per 'Flush', and the buffer is orphaned every frame
+
+    Data Members:
+        'mBufferId': the OpenGL buffer
+        'mPersistent': true if the buffer is persistent-mapped
+        'mFrameSize': bytes each frame may allocate
+        'mAlignment': GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT; every allocation starts on a multiple of this
+        'mFrame': the region this frame allocates from; always 0 if not persistent-mapped
+        'mHead': next free byte of this frame's region
+        'mFlushed': bytes of this frame's region already uploaded; only used if not persistent-mapped
+        'mMapped': the persistent mapping of the whole buffer
+        'mStaging': this frame's allocations until they are uploaded; only used if not persistent-mapped
+        'mFences': signaled when the GPU is done with each region
+        'mStats': lifetime counters
+
+    Note:
+        All methods must be called on the context thread
 
 */
-std::shared_ptr<VertexArray>                OBJGLUF_API LoadVertexArrayFromScene(const aiScene* scene, GLuint meshNum = 0);
-std::shared_ptr<VertexArray>                OBJGLUF_API LoadVertexArrayFromScene(const aiScene* scene, const VertexAttribMap& inputs, GLuint meshNum = 0);
+class OBJGLUF_API UniformStreamBuffer
+{
+    GLuint mBufferId = 0;
+    bool mPersistent = false;
+    GLsizeiptr mFrameSize = 0;
+    GLsizeiptr mAlignment = 256;
+    GLuint mFrame = 0;
+    GLsizeiptr mHead = 0;
+    GLsizeiptr mFlushed = 0;
+    char* mMapped = nullptr;
+    std::vector<char> mStaging;
+    GLsync mFences[GLUF_UNIFORM_STREAM_FRAMES] = {};
+    UniformStreamStats mStats;
+
+    UniformStreamBuffer(const UniformStreamBuffer& other) = delete;
+    UniformStreamBuffer& operator=(const UniformStreamBuffer& other) = delete;
+
+public:
+
+    UniformStreamBuffer() noexcept;
+    ~UniformStreamBuffer() noexcept;
+
+    /*
+    Init
+
+        Parameters:
+            'frameSize': bytes of block data one frame may allocate
+            'allowPersistent': false to always use the orphaning path, even if persistent mapping is supported
+
+        Throws:
+            'MakeBufferException': if the buffer could not be created, or uniform buffers are not supported
+                (they need OpenGL 3.1 or GL_ARB_uniform_buffer_object)
+    */
+    void Init(GLsizeiptr frameSize, bool allowPersistent = true);
+
+    /*
+    Destroy
 
+        -Deletes the buffer; 'Init' may be called again afterward
 
+        Throws:
+            no-throw guarantee
+    */
+    void Destroy() noexcept;
+
+    /*
+    Allocate
+
+        Parameters:
+            'size': bytes needed
+
+        Returns:
+            space for one block this frame; write the data to 'mData' before binding it
+
+        Throws:
+            'std::length_error': if this frame has already allocated all 'frameSize' bytes
+    */
+    UniformStreamAllocation Allocate(GLsizeiptr size);
+
+    /*
+    Flush
+
+        -Uploads everything allocated since the last flush in one call.  'Bind' does this when it needs to, so
+            the most efficient order is to allocate and write every block of a frame first, then bind and draw;
+            this way the frame is uploaded all at once.  Does nothing if persistent-mapped
+    */
+    void Flush();
+
+    /*
+    Bind
+
+        Parameters:
+            'allocation': an allocation made this frame
+            'binding': the uniform buffer binding point to bind it to
+
+        Note:
+            the allocation is bound with glBindBufferRange, which also binds the buffer to GL_UNIFORM_BUFFER
+    */
+    void Bind(const UniformStreamAllocation& allocation, GLuint binding);
+
+    /*
+    EndFrame
+
+        -Call once per frame, after the frame's last draw using this buffer.  Every allocation made before
+            this is invalid afterward
+
+        Note:
+            if persistent-mapped, this waits if the GPU is still reading the region the next frame will write
+    */
+    void EndFrame();
+
+    bool IsPersistent() const noexcept { return mPersistent; }
+    GLuint GetId() const noexcept { return mBufferId; }
+    GLsizeiptr GetFrameSize() const noexcept { return mFrameSize; }
+    GLsizeiptr GetFrameUsage() const noexcept { return mHead; }
+    const UniformStreamStats& GetStats() const noexcept { return mStats; }
+};
+
+using UniformStreamBufferPtr = std::shared_ptr<UniformStreamBuffer>;
 
 /*
-LoadVertexArraysFromScene
-    
-    Parameters:
-        'scene': assimp 'aiScene': to load from
-        'meshOffset': how many meshes in to start
-        'numMeshes': how many meshes to load, starting at 'meshOffset'
-        'inputs': which vertex attributes to load from each mesh; if inputs.size() == 1, 
-            then that set of attributes is used for each mesh
+UniformBlock
 
-    Returns:
-        array of shared pointers to the loaded vertex arrays
+    -A uniform block shared by one or more programs at a fixed binding point, whose per-draw data is pushed
+        through a 'UniformStreamBuffer':
+
+        UniformBlock transforms("Transforms", 0);
+        transforms.Attach(program);
+        ...
+        Transforms data;
+        data.mMVP = projection * view * model;
+        transforms.Push(stream, data);
+        vertexArray->Draw();
+
+    Data Members:
+        'mName': the GLSL block name (not the instance name)
+        'mBinding': the uniform buffer binding point
+        'mDataSize': block size reflected from the first attached program; 0 until then
 
-    Throws:
-        TOOD: SEE ASSIMP DOCUMENTATION TO SEE WHAT IT THROWS PLUS WHAT THIS MIGHT THROW
 */
-std::vector<std::shared_ptr<VertexArray>>    OBJGLUF_API LoadVertexArraysFromScene(const aiScene* scene, GLuint meshOffset = 0, GLuint numMeshes = 1);
-std::vector<std::shared_ptr<VertexArray>>    OBJGLUF_API LoadVertexArraysFromScene(const aiScene* scene, const std::vector<const VertexAttribMap&>& inputs, GLuint meshOffset = 0, GLuint numMeshes = 1);
+class OBJGLUF_API UniformBlock
+{
+    std::string mName;
+    GLuint mBinding = 0;
+    GLint mDataSize = 0;
 
+public:
+
+    UniformBlock(const std::string& name, GLuint binding) : mName(name), mBinding(binding) {}
+
+    /*
+    Attach
+
+        -Points the program's block at this binding point
+
+        Parameters:
+            'program': a program with an active block named 'mName'
+
+        Throws:
+            'std::invalid_argument': if 'program' == nullptr, it does not have the block, or its block is
+                a different size than the one in the programs attached before it
+    */
+    void Attach(const ProgramPtr& program);
+
+    /*
+    Write, Bind, and Push
+
+        -'Write' allocates the block from 'stream' and copies 'data' in, 'Bind' binds an allocation to this
+            block's binding point, and 'Push' does both.  Without persistent mapping, writing every draw's
+            block before binding the first one uploads the whole frame at once; pushing them one at a time
+            uploads once per draw
+
+        Parameters:
+            'stream': the stream to allocate from
+            'data': the block's contents; a 'T' must be laid out for std140 (see 'Std140 Layout'), and the
+                untyped versions take 'size' bytes from 'data'
+            'allocation': an allocation from 'Write' or 'Push' this frame
+
+        Returns:
+            the allocation, in case it should be bound again later this frame
+
+        Throws:
+            'std::length_error': if 'stream' has no room left this frame
+            'std::invalid_argument': if the data is larger than the reflected block
+    */
+    template<typename T>
+    UniformStreamAllocation Write(UniformStreamBuffer& stream, const T& data) const;
+    UniformStreamAllocation Write(UniformStreamBuffer& stream, const void* data, std::size_t size) const;
+
+    void Bind(UniformStreamBuffer& stream, const UniformStreamAllocation& allocation) const;
+
+    template<typename T>
+    UniformStreamAllocation Push(UniformStreamBuffer& stream, const T& data) const;
+    UniformStreamAllocation Push(UniformStreamBuffer& stream, const void* data, std::size_t size) const;
+
+    const std::string& GetName() const noexcept { return mName; }
+    GLuint GetBinding() const noexcept { return mBinding; }
+    GLint GetDataSize() const noexcept { return mDataSize; }
+};
+
+
+/*
+=======================================================================================================================================================================================================
+GPU Resource Cache
+
+*/
+
+enum ResourceType
+{
+    RT_TEXTURE = 0,
+    RT_BUFFER = 1
+};
+
+/*
+TextureResource
+
+    Owns an OpenGL texture; the texture is deleted when this is destroyed
+
+    Data Members:
+        'mTextureId': the OpenGL texture
+        'mTarget': what the texture binds to (GL_TEXTURE_2D, GL_TEXTURE_CUBE_MAP, etc.)
+        'mMemorySize': bytes used by the texture's mip chain
+
+    Note:
+        Must be destroyed on the context thread while the context is alive
+
+*/
+class OBJGLUF_API TextureResource
+{
+    GLuint mTextureId = 0;
+    GLenum mTarget = GL_TEXTURE_2D;
+    std::size_t mMemorySize = 0;
+
+public:
+
+    TextureResource(GLuint textureId, GLenum target, std::size_t memorySize) noexcept :
+        mTextureId(textureId), mTarget(target), mMemorySize(memorySize) {}
+    ~TextureResource();
+
+    TextureResource(const TextureResource&) = delete;
+    TextureResource& operator=(const TextureResource&) = delete;
+
+    GLuint GetId() const noexcept { return mTextureId; }
+    GLenum GetTarget() const noexcept { return mTarget; }
+    std::size_t GetMemorySize() const noexcept { return mMemorySize; }
+};
+
+using TextureResourcePtr = std::shared_ptr<TextureResource>;
+
+/*
+ResourceCache
+
+    Dedupes texture and vertex array loads by key, keeps track of how much OpenGL memory they use, and releases
+        the least recently used ones nobody else is holding once the memory budget is exceeded
+
+    Multithreading:
+        -Thread-Safe Functions:
+            all; loaders are run outside of the lock, on the calling thread (which must be the context thread)
+
+    Data Members:
+        'mEntries': every cached resource, by key
+        'mLRUList': keys ordered from most to least recently used
+        'mBudget': memory in bytes to trim down to
+        'mTextureMemory', 'mBufferMemory': bytes held by cached textures and vertex arrays
+        'mHits', 'mMisses', 'mEvictions': lifetime counters
+        'mCacheMutex': mutual exclusion protection for everything above
+
+    Note:
+        An entry is only evicted if the cache holds the last reference to it, so the cache can go over budget
+            if enough of it is in use.
+        Vertex array sizes are measured when they are added; changes made to them afterward are not tracked.
+        Call 'Clear' before the OpenGL context is destroyed ('Terminate' does this)
+
+*/
+class OBJGLUF_API ResourceCache
+{
+    struct CacheEntry
+    {
+        std::shared_ptr<void> mResource;
+        ResourceType mType;
+        std::size_t mMemorySize;
+        std::list<std::string>::iterator mLRUPosition;
+    };
+
+    std::unordered_map<std::string, CacheEntry> mEntries;
+    std::list<std::string> mLRUList;
+
+    std::size_t mBudget = 256 * 1024 * 1024;
+    std::size_t mTextureMemory = 0;
+    std::size_t mBufferMemory = 0;
+
+    unsigned long long mHits = 0;
+    unsigned long long mMisses = 0;
+    unsigned long long mEvictions = 0;
+
+    mutable std::mutex mCacheMutex;
+
+    //NOTE: these expect 'mCacheMutex' to be locked
+    std::shared_ptr<void> FindEntry(const std::string& key, ResourceType type);
+    std::shared_ptr<void> InsertEntry(const std::string& key, std::shared_ptr<void> resource, ResourceType type, std::size_t memorySize);
+    void EraseEntry(std::unordered_map<std::string, CacheEntry>::iterator it, std::vector<std::shared_ptr<void>>& released);
+    void TrimTo(std::size_t budget, std::vector<std::shared_ptr<void>>& released);
+
+    //'loader' sets the target of the texture it loads
+    TextureResourcePtr LoadTexture(const std::string& key, const std::function<GLuint(GLenum& target)>& loader);
+
+public:
+
+    ResourceCache() = default;
+    ResourceCache(const ResourceCache&) = delete;
+    ResourceCache& operator=(const ResourceCache&) = delete;
+
+    /*
+    GetTexture
+
+        Parameters:
+            'filePath': texture file to load; this is also the key
+            'format': texture file format to be loaded
+            'key': unique name of the texture
+            'loader': loads the texture if it is not cached, and returns its OpenGL id
+            'target': what the texture loaded by 'loader' binds to
+
+        Returns:
+            the cached texture, loading it first if needed; for 'filePath' its target is the one the file
+                describes, so a 'TFF_DDS' file may give a cubemap or an array texture
+
+        Throws:
+            whatever 'LoadTextureFromFile' or 'loader' throw
+    */
+    TextureResourcePtr GetTexture(const std::string& filePath, TextureFileFormat format);
+    TextureResourcePtr GetTexture(const std::string& key, const std::function<GLuint()>& loader, GLenum target = GL_TEXTURE_2D);
+
+    /*
+    GetVertexArray
+
+        Parameters:
+            'key': unique name of the vertex array (i.e. the model path and mesh number)
+            'loader': loads the vertex array if it is not cached
+
+        Returns:
+            the cached vertex array, loading it first if needed
+
+        Throws:
+            whatever 'loader' throws
+    */
+    VertexArrayPtr GetVertexArray(const std::string& key, const std::function<VertexArrayPtr()>& loader);
+
+    /*
+    Contains/Remove
+
+        Parameters:
+            'key': key of the entry
+
+        Note:
+            'Remove' only drops the cache's reference; anyone else holding the resource keeps it alive
+    */
+    bool Contains(const std::string& key) const;
+    void Remove(const std::string& key);
+
+    /*
+    SetBudget
+
+        Parameters:
+            'bytes': memory budget; unreferenced entries are evicted past this
+
+        Note:
+            Trims immediately if the cache is over the new budget
+    */
+    void SetBudget(std::size_t bytes);
+    std::size_t GetBudget() const;
+
+    /*
+    Trim/Purge/Clear
+
+        Trim: evicts least recently used unreferenced entries until under budget
+        Purge: evicts every unreferenced entry
+        Clear: drops every entry, referenced or not
+    */
+    void Trim();
+    void Purge();
+    void Clear();
+
+    std::size_t GetTextureMemory() const;
+    std::size_t GetBufferMemory() const;
+    std::size_t GetTotalMemory() const;
+    std::size_t GetEntryCount() const;
+    unsigned long long GetHitCount() const;
+    unsigned long long GetMissCount() const;
+    unsigned long long GetEvictionCount() const;
+};
+
+extern ResourceCache OBJGLUF_API g_ResourceCache;
+
+#define RESOURCECACHE GLUF::g_ResourceCache
+
+
+/*
+=======================================================================================================================================================================================================
+Utility Functions if Assimp is being used
+
+    Note:
+        this part of the library does use nakid pointers to match up with Assimp usage examples
+
+*/
+
+#ifdef USING_ASSIMP
+
+/*
+
+Data Members for Assimp Loading
+
+VertexAttribMap:
+Data structure of all of the vertex attributes to load from the assimp scene
+
+VertexAttribPair:
+Pair of a vertex attribute, and the attribute info to go with it
+
+*/
+using VertexAttribMap = std::map<unsigned char, VertexAttribInfo>;
+using VertexAttribPair = std::pair<unsigned char, VertexAttribInfo>;
+
+
+/*
+
+Assimp Loading Exceptions
+
+*/
+
+
+/*
+LoadVertexArrayFromScene
+
+    Parameters:
+        'scene': assimp 'aiScene': to load from
+        'meshNum': which mesh number to load from the scene
+        'inputs': which vertex attributes to load
+
+    Returns:
+        shared pointer to the loaded vertex array
+
+    Throws:
+        'std::invalid_argument': if 'meshNum' is higher than the number of meshes in 'scene'
+
+        TOOD: SEE ASSIMP DOCUMENTATION TO SEE WHAT IT THROWS PLUS WHAT THIS MIGHT THROW
+
+*/
+std::shared_ptr<VertexArray>                OBJGLUF_API LoadVertexArrayFromScene(const aiScene* scene, GLuint meshNum = 0);
+std::shared_ptr<VertexArray>                OBJGLUF_API LoadVertexArrayFromScene(const aiScene* scene, const VertexAttribMap& inputs, GLuint meshNum = 0);
+
+
+/*
+MeshData
+
+    A mesh converted from assimp, ready to go into a vertex array; building one does not touch OpenGL
+
+    Data Members:
+        'mIndexed': whether the mesh has faces
+        'mAttributes': each vertex attribute, with its offset within a vertex in 'mOffset'
+        'mVertexCount': the number of vertices
+        'mVertexData': the interleaved vertices
+        'mIndices': triangle indices
+
+*/
+struct MeshData
+{
+    bool mIndexed = true;
+    std::vector<VertexAttribInfo> mAttributes;
+    GLuint mVertexCount = 0;
+    std::vector<char> mVertexData;
+    std::vector<glm::u32vec3> mIndices;
+};
+
+/*
+ConvertMeshFromScene
+
+    Parameters:
+        'scene': assimp 'aiScene': to load from
+        'inputs': which vertex attributes to load
+        'meshNum': which mesh number to load from the scene
+
+    Returns:
+        the converted mesh
+
+    Throws:
+        'std::invalid_argument': if 'meshNum' is not a mesh in 'scene'
+
+    Note:
+        This is the part of 'LoadVertexArrayFromScene' which does not call OpenGL, so it is safe to call from any thread
+
+*/
+MeshData                                    OBJGLUF_API ConvertMeshFromScene(const aiScene* scene, const VertexAttribMap& inputs, GLuint meshNum = 0);
+
+/*
+LoadVertexArrayFromMeshData
+
+    Parameters:
+        'meshData': the converted mesh
+
+    Returns:
+        shared pointer to the loaded vertex array
+
+*/
+std::shared_ptr<VertexArray>                OBJGLUF_API LoadVertexArrayFromMeshData(const MeshData& meshData);
+
+
+
+/*
+LoadVertexArraysFromScene
+    
+    Parameters:
+        'scene': assimp 'aiScene': to load from
+        'meshOffset': how many meshes in to start
+        'numMeshes': how many meshes to load, starting at 'meshOffset'
+        'inputs': which vertex attributes to load from each mesh; if inputs.size() == 1, 
+            then that set of attributes is used for each mesh
+
+    Returns:
+        array of shared pointers to the loaded vertex arrays
+
+    Throws:
+        TOOD: SEE ASSIMP DOCUMENTATION TO SEE WHAT IT THROWS PLUS WHAT THIS MIGHT THROW
+*/
+std::vector<std::shared_ptr<VertexArray>>    OBJGLUF_API LoadVertexArraysFromScene(const aiScene* scene, GLuint meshOffset = 0, GLuint numMeshes = 1);
+std::vector<std::shared_ptr<VertexArray>>    OBJGLUF_API LoadVertexArraysFromScene(const aiScene* scene, const std::vector<const VertexAttribMap&>& inputs, GLuint meshOffset = 0, GLuint numMeshes = 1);
+
+
+/*
+LoadSceneFrom*
+
+    Parameters:
+        'importer': the assimp importer which will own the returned scene
+        'path': path of the model file to map
+        'data': raw model file data
+        'postProcessFlags': assimp 'aiProcess_*' flags
+        'formatHint': file extension of the data (i.e. "obj"), helps assimp pick an importer
+
+    Returns:
+        the imported scene, owned by 'importer'; nullptr if assimp failed to import it
+
+    Throws:
+        'std::ios_base::failure': if 'path' could not be opened or mapped
+        'std::invalid_argument': if 'data' is empty
+
+    Note:
+        The file is mapped and handed to assimp directly instead of being read into a buffer first.
+        Because the data comes from memory, assimp cannot follow references to other files (i.e. '.mtl' for '.obj')
+
+*/
+const aiScene*                                OBJGLUF_API LoadSceneFromFile(Assimp::Importer& importer, const std::string& path, unsigned int postProcessFlags);
+const aiScene*                                OBJGLUF_API LoadSceneFromMemory(Assimp::Importer& importer, const MemorySpan& data, unsigned int postProcessFlags, const std::string& formatHint = "");
+
+
+//the unsigned char represents the below #defines (_VERTEX_ATTRIB_*)
+#endif
+
+
+/*
+=======================================================================================================================================================================================================
+Asynchronous Asset Loading
+
+*/
+
+/*
+AsyncLoader
+
+    Reads and parses assets on a pool of worker threads, then finishes them with OpenGL on the context thread.
+        Each load is split in two: a parse step (file mapping, DDS header walk, shader text, Assimp import, etc.)
+        which runs on a worker, and an upload step (all of the GL calls) which is queued for 'ProcessUploads'
+
+    Multithreading:
+        -Thread-Safe Functions:
+            'LoadAsync'
+            '*Async'
+            'QueueWork'
+            'TryQueueWork'
+            'QueueUpload'
+            'QueuePoll'
+            'GetPending*Count'
+        -Context Thread Only:
+            'ProcessUploads'
+
+    Data Members:
+        'mWorkers': the worker threads; started the first time work is queued
+        'mWorkQueue': parse tasks waiting for a worker
+        'mUploadQueue': upload tasks waiting for the context thread
+        'mPollTasks': context thread tasks waiting on the driver (i.e. shader compiles), checked every 'ProcessUploads'
+        'mWorkMutex': mutual exclusion protection for 'mWorkQueue' and 'mWorkers'
+        'mUploadMutex': mutual exclusion protection for 'mUploadQueue' and 'mPollTasks'
+        'mWorkCondition': wakes the workers when work is queued or on shutdown
+        'mShutdown': true once 'Shutdown' has been called
+        'mActiveWorkCount': parse tasks currently executing on a worker
+
+    Note:
+        The returned futures only become ready after 'ProcessUploads' has run their upload step, so call it
+            once per frame, and do not block on a future from the context thread (use 'FutureReady' instead)
+
+*/
+class OBJGLUF_API AsyncLoader
+{
+public:
+    using Task = std::function<void()>;
+    using PollTask = std::function<bool()>;
+
+private:
+    std::vector<std::thread> mWorkers;
+    std::deque<Task> mWorkQueue;
+    std::deque<Task> mUploadQueue;
+    std::vector<PollTask> mPollTasks;
+
+    mutable std::mutex mWorkMutex;
+    mutable std::mutex mUploadMutex;
+    std::condition_variable mWorkCondition;
+
+    bool mShutdown = false;
+    std::atomic<unsigned int> mActiveWorkCount{ 0 };
+
+    void WorkerMain();
+    void StartWorkers(unsigned int numThreads);
+
+public:
+
+    AsyncLoader() = default;
+    ~AsyncLoader();
+
+    AsyncLoader(const AsyncLoader&) = delete;
+    AsyncLoader& operator=(const AsyncLoader&) = delete;
+
+    /*
+    Init
+
+        Parameters:
+            'numThreads': how many worker threads to start; 0 picks one less than the hardware thread count (minimum 1)
+
+        Note:
+            This is optional; the workers are started with the default count the first time work is queued
+    */
+    void Init(unsigned int numThreads = 0);
+
+    /*
+    Shutdown
+
+        Note:
+            Finishes the parse tasks already queued, then joins the workers.  Uploads still queued are dropped,
+                so their futures will report 'std::future_error' (broken promise)
+    */
+    void Shutdown() noexcept;
+
+    /*
+    QueueWork
+
+        Parameters:
+            'task': function to run on a worker thread; must not call OpenGL
+    */
+    void QueueWork(Task task);
+
+    /*
+    TryQueueWork
+
+        Parameters:
+            'task': function to run on a worker thread; must not call OpenGL
+
+        Returns:
+            false, without queueing 'task', if the workers have not been started (or were shut down)
+
+        Note:
+            For work the calling thread can do itself, which should not start the pool as a side effect
+    */
+    bool TryQueueWork(Task task);
+
+    /*
+    QueueUpload
+
+        Parameters:
+            'task': function to run on the context thread during 'ProcessUploads'
+    */
+    void QueueUpload(Task task);
+
+    /*
+    QueuePoll
+
+        Parameters:
+            'task': function to run on the context thread once per 'ProcessUploads' until it returns true; use this
+                to wait on the driver without blocking, and keep each call cheap
+    */
+    void QueuePoll(PollTask task);
+
+    /*
+    ProcessUploads
+
+        Parameters:
+            'budget': time in seconds this call may spend running upload tasks
+
+        Returns:
+            the number of upload tasks run, plus the number of poll tasks which finished
+
+        Note:
+            At least one task is run per call (if any are queued) so loading always makes progress; a single
+                large upload may still go over budget.  Every poll task is checked once per call, before the uploads
+            A task which throws is reported through the error method and dropped, like on the workers, and the
+                rest of the queue is still processed
+    */
+    unsigned int ProcessUploads(double budget);
+
+    /*
+    GetPending*Count
+
+        Returns:
+            the number of parse tasks queued or running, and the number of upload and poll tasks queued, respectively
+    */
+    std::size_t GetPendingWorkCount() const;
+    std::size_t GetPendingUploadCount() const;
+
+    /*
+    LoadAsync
+
+        Parameters:
+            'parse': callable run on a worker thread, which returns a 'std::function<T()>' that will be
+                run on the context thread to produce the result
+
+        Returns:
+            a future for the result of the upload step; exceptions from either step are stored in it
+
+    */
+    template<typename T, typename ParseFunc>
+    std::future<T> LoadAsync(ParseFunc parse);
+
+    /*
+    *Async
+
+        Parameters:
+            see their synchronous versions
+
+        Returns:
+            a future for the loaded asset
+
+        Throws:
+            through the future: whatever the synchronous version throws
+    */
+    std::future<GLuint> LoadTextureFromFileAsync(const std::string& filePath, TextureFileFormat format);
+    std::future<ProgramPtr> CreateProgramFromFilesAsync(const ShaderPathList& shaderPaths, bool separate = false);
+
+#ifdef USING_ASSIMP
+    std::future<VertexArrayPtr> LoadVertexArrayFromFileAsync(const std::string& filePath, const VertexAttribMap& inputs, unsigned int postProcessFlags, GLuint meshNum = 0);
+#endif
+};
+
+/*
+FutureReady
+
+    Parameters:
+        'future': the future to check
+
+    Returns:
+        true if the result (or exception) is available, without blocking
+*/
+template<typename T>
+bool FutureReady(const std::future<T>& future);
+
+
+extern AsyncLoader OBJGLUF_API g_AsyncLoader;
+
+#define ASYNCLOADER GLUF::g_AsyncLoader
+
+
+/*
+=======================================================================================================================================================================================================
+Texture Streaming
+
+*/
+
+//default staging buffer count and size of a 'TextureStreamer'
+#define GLUF_TEXTURE_STREAM_BUFFERS 8
+#define GLUF_TEXTURE_STREAM_BUFFER_SIZE (4 * 1024 * 1024)
+#define GLUF_TEXTURE_STREAM_FRAME_BUDGET (8 * 1024 * 1024)
+
+/*
+TextureStreamStats
+
+    Data Members:
+        'mQueuedBytes': level data waiting for a staging buffer
+        'mInFlightBytes': level data being copied into staging buffers, or waiting for the GPU to finish reading them
+        'mQueuedTextures': textures with levels still queued or being copied
+        'mFrameBytes': bytes started by the last 'Update'
+        'mStreamedBytes': lifetime bytes uploaded through staging buffers
+        'mDirectBytes': lifetime bytes uploaded straight from client memory, because a level was larger than a staging buffer
+        'mTexturesCompleted': lifetime textures whose every level has been uploaded
+
+*/
+struct TextureStreamStats
+{
+    std::size_t mQueuedBytes = 0;
+    std::size_t mInFlightBytes = 0;
+    std::size_t mQueuedTextures = 0;
+    std::size_t mFrameBytes = 0;
+    unsigned long long mStreamedBytes = 0;
+    unsigned long long mDirectBytes = 0;
+    unsigned long long mTexturesCompleted = 0;
+};
+
+/*
+StreamedTexture
+
+    -A texture streamed in progressively by 'TextureStreamer': its smallest levels are uploaded first, and
+        GL_TEXTURE_BASE_LEVEL is clamped to the finest level which has arrived (along with every level coarser than
+        it), so it can be drawn as soon as the smallest level is in, and sharpens over the following frames
+
+    Data Members:
+        'mTextureId': the OpenGL texture; 0 until the streamer has created it
+        'mTarget': what the texture binds to
+        'mMipCount': mip levels in the full texture
+        'mBaseLevel': the finest level which is drawable; 'mMipCount' until the first level arrives
+        'mPriority': how urgently the rest of the levels are needed; larger is sooner, i.e. the texture's size on
+            screen, or its negative distance from the camera
+        'mFailed': true if the file could not be loaded
+
+    Note:
+        Owns the texture; it is deleted when this is destroyed, and releasing this cancels the levels not yet
+            uploaded.  Everything but 'SetPriority' must be called on the context thread, and this must be
+            destroyed on the context thread while the context is alive
+
+*/
+class OBJGLUF_API StreamedTexture
+{
+    friend class TextureStreamer;
+
+    GLuint mTextureId = 0;
+    GLenum mTarget = GL_TEXTURE_2D;
+    unsigned int mMipCount = 0;
+    unsigned int mBaseLevel = 0;
+    std::atomic<float> mPriority{ 0.0f };
+    bool mFailed = false;
+
+public:
+
+    StreamedTexture() noexcept {}
+    ~StreamedTexture();
+
+    StreamedTexture(const StreamedTexture&) = delete;
+    StreamedTexture& operator=(const StreamedTexture&) = delete;
+
+    /*
+    SetPriority
+
+        Parameters:
+            'priority': see 'mPriority'; update it as the camera moves
+
+        Note:
+            this is thread-safe
+    */
+    void SetPriority(float priority) noexcept { mPriority.store(priority, std::memory_order_relaxed); }
+    float GetPriority() const noexcept { return mPriority.load(std::memory_order_relaxed); }
+
+    GLuint GetId() const noexcept { return mTextureId; }
+    GLenum GetTarget() const noexcept { return mTarget; }
+    unsigned int GetMipCount() const noexcept { return mMipCount; }
+    unsigned int GetBaseLevel() const noexcept { return mBaseLevel; }
+    bool IsDrawable() const noexcept { return mBaseLevel < mMipCount; }
+    bool IsComplete() const noexcept { return mMipCount > 0 && mBaseLevel == 0; }
+    bool IsFailed() const noexcept { return mFailed; }
+};
+
+using StreamedTexturePtr = std::shared_ptr<StreamedTexture>;
+
+/*
+TextureStreamer
+
+    -Streams DDS textures to OpenGL through a pool of pixel buffer objects, a few levels per frame, so a large texture
+        does not stall the frame it loads on.  Each level is copied into a free staging buffer by an 'AsyncLoader'
+        worker, then uploaded from it with glCompressedTexSubImage* or glTexSubImage* on the context thread, and the
+        buffer is reused once a fence says the GPU is done with it.  If GL_ARB_buffer_storage is available (core in 4.4),
+        the staging buffers are mapped persistently; otherwise each one is mapped for the copy and unmapped before use
+
+    -Work is started once per 'ASYNCLOADER.ProcessUploads' (the streamer queues itself as a poll task while it is
+        busy), and each call starts at most 'mFrameBudget' bytes of levels.  Whole textures are streamed in the order
+        they were queued, largest level first.  Progressive textures (see 'StreamedTexture') each get their smallest
+        level as soon as possible, and after that the one with the highest priority is refined first
+
+    Data Members:
+        'mBuffers': the staging buffers
+        'mJobs': textures with levels left to stage, in the order they were queued
+        'mBufferSize': bytes each staging buffer holds; larger levels are uploaded straight from client memory
+        'mFrameBudget': bytes of levels to start per 'Update'
+        'mPersistent': true if the staging buffers are persistent-mapped
+        'mFences': true if sync objects are available; without them buffers are reused right away, and are orphaned
+            when they are mapped
+        'mPollQueued': true while 'Update' is queued on 'ASYNCLOADER'
+        'mPollGeneration': bumped by 'Destroy', so a poll queued before it finishes without calling 'Update'
+        'mStats': current and lifetime counters
+
+    Note:
+        'StreamTextureFromFileAsync' is thread-safe; everything else must be called on the context thread.
+        A texture must not be used until its future is ready, since its levels are undefined until then
+
+*/
+class OBJGLUF_API TextureStreamer
+{
+    struct StreamJob
+    {
+        GLuint mTextureId = 0;
+        std::shared_ptr<const DDSImage> mImage;
+        MemorySpan mData;
+        std::shared_ptr<const void> mOwner;//keeps 'mData' alive
+        std::shared_ptr<std::promise<GLuint>> mPromise;//whole textures only
+        std::weak_ptr<StreamedTexture> mHandle;//progressive textures only
+        bool mProgressive = false;
+        bool mCancelled = false;//the handle was released before every level was uploaded
+        std::vector<std::size_t> mOrder;//indices into 'mImage->mMipLevels', in upload order
+        std::vector<unsigned int> mFacesLeft;//per mip level, faces not uploaded yet; progressive textures only
+        std::size_t mNextLevel = 0;//index into 'mOrder' of the next level to stage
+        std::size_t mPendingLevels = 0;//levels started but not uploaded yet
+    };
+
+    struct StagingBuffer
+    {
+        GLuint mBufferId = 0;
+        char* mMapped = nullptr;//the persistent mapping, or the mapping for the copy in progress
+        GLsync mFence = nullptr;
+        std::shared_ptr<StreamJob> mJob;
+        std::size_t mLevel = 0;
+        std::atomic<unsigned int> mState{ 0 };//free, being copied into, copied, or waiting on 'mFence'
+    };
+
+    std::vector<std::unique_ptr<StagingBuffer>> mBuffers;
+    std::deque<std::shared_ptr<StreamJob>> mJobs;
+
+    std::size_t mBufferSize = 0;
+    std::size_t mFrameBudget = GLUF_TEXTURE_STREAM_FRAME_BUDGET;
+    bool mPersistent = false;
+    bool mFences = false;
+    bool mPollQueued = false;
+    unsigned int mPollGeneration = 0;
+    TextureStreamStats mStats;
+
+    //NOTE: these are all context thread only
+    void Enqueue(const std::shared_ptr<StreamJob>& job);
+    std::deque<std::shared_ptr<StreamJob>>::iterator PickJob();
+    void Cancel(StreamJob& job);
+    bool Stage(StagingBuffer& buffer, const std::shared_ptr<StreamJob>& job, std::size_t level);
+    void Submit(StagingBuffer& buffer);
+    void Retire(StagingBuffer& buffer);
+    void UploadDirect(const std::shared_ptr<StreamJob>& job, std::size_t level);
+    void FinishLevel(const std::shared_ptr<StreamJob>& job, std::size_t level);
+
+    TextureStreamer(const TextureStreamer& other) = delete;
+    TextureStreamer& operator=(const TextureStreamer& other) = delete;
+
+public:
+
+    TextureStreamer() noexcept {}
+    ~TextureStreamer() noexcept;
+
+    /*
+    Init
+
+        Parameters:
+            'bufferCount': how many staging buffers to create; this is how many levels can be in flight at once
+            'bufferSize': bytes per staging buffer
+            'frameBudget': bytes of levels to start per frame (see 'SetFrameBudget')
+            'allowPersistent': false to always map the buffers for each copy, even if persistent mapping is supported
+
+        Throws:
+            'MakeBufferException': if the staging buffers could not be created, or pixel buffer objects can not be
+                mapped (they need OpenGL 3.0 or GL_ARB_map_buffer_range)
+
+        Note:
+            If the streamer is already initialized, it is destroyed first
+    */
+    void Init(GLuint bufferCount = GLUF_TEXTURE_STREAM_BUFFERS, std::size_t bufferSize = GLUF_TEXTURE_STREAM_BUFFER_SIZE,
+        std::size_t frameBudget = GLUF_TEXTURE_STREAM_FRAME_BUDGET, bool allowPersistent = true);
+
+    /*
+    Destroy
+
+        -Waits for the copies in progress, then deletes the staging buffers along with every whole texture which has
+            not finished streaming; their futures will report 'std::future_error' (broken promise).  Progressive
+            textures keep the levels they already have
+
+        Throws:
+            no-throw guarantee
+    */
+    void Destroy() noexcept;
+
+    /*
+    StreamTextureFromFileAsync
+
+        Parameters:
+            'filePath': the DDS file to stream
+
+        Returns:
+            a future for the OpenGL id of the texture, which becomes ready once every level has been uploaded
+
+        Throws:
+            through the future: whatever 'MapFile' and 'ParseDDS' throw, and 'TextureCreationException'
+    */
+    std::future<GLuint> StreamTextureFromFileAsync(const std::string& filePath);
+
+    /*
+    StreamDDS
+
+        Parameters:
+            'image': the parsed layout of 'rawData'
+            'rawData': the DDS file
+            'owner': keeps 'rawData' alive until the texture is finished (i.e. the 'MappedFilePtr' it came from)
+
+        Returns:
+            see 'StreamTextureFromFileAsync'
+
+        Throws:
+            'TextureCreationException': if OpenGL failed to create the texture
+            'std::logic_error': if the streamer is not initialized
+
+        Note:
+            Formats the context does not support are decoded here, on the context thread (see 'DecompressDDS'); the file 
+                loaders decode on a worker instead
+    */
+    std::future<GLuint> StreamDDS(std::shared_ptr<const DDSImage> image, const MemorySpan& rawData, std::shared_ptr<const void> owner);
+
+    /*
+    StreamTextureFromFileProgressive
+
+        Parameters:
+            'filePath': the DDS file to stream
+            'priority': the texture's starting priority (see 'StreamedTexture::mPriority')
+
+        Returns:
+            the texture, which becomes drawable once its smallest level has been uploaded
+
+        Note:
+            This is thread-safe.  If the file can not be loaded, the error is logged and the texture reports 'IsFailed'
+    */
+    StreamedTexturePtr StreamTextureFromFileProgressive(const std::string& filePath, float priority = 0.0f);
+
+    /*
+    StreamDDSProgressive
+
+        Parameters:
+            'image', 'rawData', 'owner': see 'StreamDDS'
+            'priority': the texture's starting priority (see 'StreamedTexture::mPriority')
+
+        Returns:
+            the texture; it has an id already, but is not drawable until its smallest level has been uploaded
+
+        Throws:
+            see 'StreamDDS'
+    */
+    StreamedTexturePtr StreamDDSProgressive(std::shared_ptr<const DDSImage> image, const MemorySpan& rawData, std::shared_ptr<const void> owner, float priority = 0.0f);
+
+    /*
+    Update
+
+        -Uploads the levels which workers have finished copying, recycles the staging buffers the GPU is done with,
+            and starts copying queued levels into free ones until 'mFrameBudget' bytes have been started (at least
+            one level is always started, so streaming makes progress with any budget)
+
+        Returns:
+            true if there is nothing left to stream
+
+        Note:
+            this is run by 'ASYNCLOADER.ProcessUploads', so it rarely needs to be called directly
+    */
+    bool Update();
+
+    /*
+    SetFrameBudget
+
+        Parameters:
+            'bytes': bytes of levels to start per 'Update'
+    */
+    void SetFrameBudget(std::size_t bytes) noexcept { mFrameBudget = bytes; }
+    std::size_t GetFrameBudget() const noexcept { return mFrameBudget; }
+
+    bool IsInitialized() const noexcept { return !mBuffers.empty(); }
+    bool IsPersistent() const noexcept { return mPersistent; }
+    bool IsIdle() const noexcept { return mStats.mQueuedTextures == 0 && mStats.mInFlightBytes == 0; }
+    std::size_t GetBufferSize() const noexcept { return mBufferSize; }
+    const TextureStreamStats& GetStats() const noexcept { return mStats; }
+};
+
+extern TextureStreamer OBJGLUF_API g_TextureStreamer;
+
+#define TEXTURESTREAMER GLUF::g_TextureStreamer
 
-//the unsigned char represents the below #defines (_VERTEX_ATTRIB_*)
-#endif
 
 
 /*
@@ -186,7 +186,7 @@ namespace GLUF
             throw std::invalid_argument("(VertexArrayAoS::BufferData): data vertex size is not compatible");
 
         BindVertexArray();
-        glBindBuffer(GL_ARRAY_BUFFER, mDataBuffer);
+        GLSTATE.BindBuffer(GL_ARRAY_BUFFER, mDataBuffer);
 
         //pass OpenGL the raw pointers
         glBufferData(GL_ARRAY_BUFFER, data.size() * vertexSize, data.gl_data(), mUsageType);
@@ -230,46 +230,68 @@ namespace GLUF
         if (vertexLocations.size() == 1)
         {
             BindVertexArray();
-            glBindBuffer(GL_ARRAY_BUFFER, mDataBuffer);
+            GLSTATE.BindBuffer(GL_ARRAY_BUFFER, mDataBuffer);
             glBufferSubData(GL_ARRAY_BUFFER, vertexLocations[0] * vertexSize, data.size() * vertexSize, data.gl_data());
         }
         else//otherwise, split the data into contiguous chunks for best efficiency
         {
 
-            /*
+            //the chunks and offset for each chunk
+            std::vector<GLVector<T>> chunkedData;
+            std::vector<GLuint> chunkOffsets;
+            ChunkSubData(data, vertexLocations, isSorted, chunkedData, chunkOffsets);
 
-            Overview:
+            //once it is all split into chunks, buffer the data chunk by chunk
+            for (GLuint i = 0; i < chunkedData.size(); ++i)
+            {
+                //for OpenGL safe-ness, bind the buffers at the last minute before buffering
+                BindVertexArray();
+                GLSTATE.BindBuffer(GL_ARRAY_BUFFER, mDataBuffer);
+                glBufferSubData(GL_ARRAY_BUFFER, chunkOffsets[i] * vertexSize, chunkedData[i].size() * vertexSize, (chunkedData[i]).gl_data());
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------------------
+    template<typename T>
+    void VertexArrayAoS::ChunkSubData(GLVector<T>& data, std::vector<GLuint>& vertexLocations, bool isSorted, std::vector<GLVector<T>>& chunkedData, std::vector<GLuint>& chunkOffsets)
+    {
+        if (vertexLocations.empty())
+            return;
 
-            Sort Vertex Locations
-            Check for Duplicates
-            Split Into Contiguous Chunks
-            Buffer Each Chunk
+        /*
 
-            */
+        Overview:
 
-            //Next, sort the possibly unordered vertex locations with Bubble Sort
-            if (!isSorted)
+        Sort Vertex Locations
+        Check for Duplicates
+        Split Into Contiguous Chunks
+
+        */
+
+        //Next, sort the possibly unordered vertex locations with Bubble Sort
+        if (!isSorted)
+        {
+            GLuint swap = 0;
+            for (GLuint c = 0; c < (vertexLocations.size() - 1); c++)
             {
-                GLuint swap = 0;
-                for (GLuint c = 0; c < (vertexLocations.size() - 1); c++)
+                for (GLuint d = 0; d < vertexLocations.size() - c - 1; d++)
                 {
-                    for (GLuint d = 0; d < vertexLocations.size() - c - 1; d++)
+                    if (vertexLocations[d] > vertexLocations[d + 1]) /* For decreasing order use < */
                     {
-                        if (vertexLocations[d] > vertexLocations[d + 1]) /* For decreasing order use < */
-                        {
-                            //note: std::swap increases efficiency of swapping
+                        //note: std::swap increases efficiency of swapping
 
-                            //swap the vertices
-                            std::swap(vertexLocations[d], vertexLocations[d + 1]);
+                        //swap the vertices
+                        std::swap(vertexLocations[d], vertexLocations[d + 1]);
 
-                            //also remember to swap the data elements
-                            std::swap(data[d], data[d + 1]);
-                        }
+                        //also remember to swap the data elements
+                        std::swap(data[d], data[d + 1]);
                     }
                 }
             }
+        }
 
-            //run through them all to make sure there are no duplicates, if there are, throw an exception
+        //run through them all to make sure there are no duplicates, if there are, throw an exception
         {
             GLuint prev = 0;
             GLuint curr = 0;
@@ -293,10 +315,6 @@ namespace GLUF
             }
         }
 
-        //the chunks and offset for each chunk
-        std::vector<GLVector<T>> chunkedData;
-        std::vector<GLuint> chunkOffsets;
-
         //the working chunk
         GLVector<T> chunk;
 
@@ -319,12 +337,7 @@ namespace GLUF
                 continue;
             }
 
-            if (itLocation == vertexLocations.back())
-            {
-                //we have reached the end of the data
-                chunkedData.push_back(chunk);
-            }
-            else if (itLocation == prevLocation + 1)
+            if (itLocation == prevLocation + 1)
             {
                 chunk.push_back(itData);
 
@@ -343,19 +356,10 @@ namespace GLUF
                 //finally, reset the counter
                 prevLocation = itLocation;
             }
-
         }
 
-        //once it is all split into chunks, buffer the data chunk by chunk
-        for (GLuint i = 0; i < chunkedData.size(); ++i)
-        {
-            //for OpenGL safe-ness, bind the buffers at the last minute before buffering
-            BindVertexArray();
-            glBindBuffer(GL_ARRAY_BUFFER, mDataBuffer);
-            glBufferSubData(GL_ARRAY_BUFFER, chunkOffsets[i] * vertexSize, chunkedData[i].size() * vertexSize, (chunkedData[i]).gl_data());
-        }
-
-        }
+        //we have reached the end of the data
+        chunkedData.push_back(chunk);
     }
 
 
@@ -371,7 +375,7 @@ namespace GLUF
         auto buffId = GetBufferIdFromAttribLoc(loc);
 
         BindVertexArray();
-        glBindBuffer(GL_ARRAY_BUFFER, buffId);
+        GLSTATE.BindBuffer(GL_ARRAY_BUFFER, buffId);
 
         if (mVertexCount != 0)
         {
@@ -397,7 +401,7 @@ namespace GLUF
         auto buffId = GetBufferIdFromAttribLoc(loc);
 
         BindVertexArray();
-        glBindBuffer(GL_ARRAY_BUFFER, buffId);
+        GLSTATE.BindBuffer(GL_ARRAY_BUFFER, buffId);
 
 
         VertexAttribInfo info = GetAttribInfoFromLoc(loc);
@@ -407,4 +411,80 @@ namespace GLUF
     }
 
 
+    /*
+    ===================================================================================================
+    UniformBlock Template Functions
+
+    */
+
+    //--------------------------------------------------------------------------------------
+    template<typename T>
+    UniformStreamAllocation UniformBlock::Write(UniformStreamBuffer& stream, const T& data) const
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Uniform block data is copied straight into the buffer");
+
+        return Write(stream, &data, sizeof(T));
+    }
+
+    //--------------------------------------------------------------------------------------
+    template<typename T>
+    UniformStreamAllocation UniformBlock::Push(UniformStreamBuffer& stream, const T& data) const
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Uniform block data is copied straight into the buffer");
+
+        return Push(stream, &data, sizeof(T));
+    }
+
+
+    /*
+    ===================================================================================================
+    AsyncLoader Template Implementation
+
+    */
+
+    //--------------------------------------------------------------------------------------
+    template<typename T, typename ParseFunc>
+    std::future<T> AsyncLoader::LoadAsync(ParseFunc parse)
+    {
+        //shared, because both tasks need to be copyable to be stored in a 'std::function'
+        auto promise = std::make_shared<std::promise<T>>();
+        std::future<T> ret = promise->get_future();
+
+        QueueWork([this, promise, parse]()
+        {
+            std::function<T()> upload;
+            try
+            {
+                upload = parse();
+            }
+            catch (...)
+            {
+                promise->set_exception(std::current_exception());
+                return;
+            }
+
+            QueueUpload([promise, upload]()
+            {
+                try
+                {
+                    promise->set_value(upload());
+                }
+                catch (...)
+                {
+                    promise->set_exception(std::current_exception());
+                }
+            });
+        });
+
+        return ret;
+    }
+
+    //--------------------------------------------------------------------------------------
+    template<typename T>
+    inline bool FutureReady(const std::future<T>& future)
+    {
+        return future.valid() && future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+
 }
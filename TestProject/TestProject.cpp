@@ -356,16 +356,13 @@ int main(void)
     unsigned long len = 0;
 
     std::string text;
-    std::vector<char> rawMem;
-    LoadFileIntoMemory("Shaders/BasicLighting120.vert.glsl", rawMem);
-    LoadBinaryArrayIntoString(rawMem, text);
+    LoadFileIntoMemory("Shaders/BasicLighting120.vert.glsl", text);
 
     text += '\n';
     Sources.insert(std::pair<ShaderType, const char*>(SH_VERTEX_SHADER, text.c_str()));
 
     std::string text1;
-    LoadFileIntoMemory("Shaders/BasicLighting120.frag.glsl", rawMem);
-    LoadBinaryArrayIntoString(rawMem, text1);
+    LoadFileIntoMemory("Shaders/BasicLighting120.frag.glsl", text1);
     text1 += '\n';
     Sources.insert(std::pair<ShaderType, const char*>(SH_FRAGMENT_SHADER, text1.c_str()));
 
@@ -399,7 +396,7 @@ int main(void)
     
     //load from assimp
     Assimp::Importer importer;
-    const aiScene* scene = importer.ReadFile(path,
+    const aiScene* scene = LoadSceneFromFile(importer, path,
         aiProcess_CalcTangentSpace |
         aiProcess_Triangulate |
         aiProcess_JoinIdenticalVertices |
@@ -516,7 +513,7 @@ int main(void)
         int width, height;
         glfwGetFramebufferSize(window, &width, &height);
         ratio = width / (float) height;
-        glViewport(0, 0, width, height);
+        GLSTATE.Viewport(0, 0, width, height);
         static const GLfloat black[] = {0.0f, 0.0f, 0.0f, 1.0f};
         static const GLfloat one = 1.0f;
 
@@ -526,12 +523,12 @@ int main(void)
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         // Enable depth test
-        glEnable(GL_DEPTH_TEST);
+        GLSTATE.Enable(GL_DEPTH_TEST);
         // Accept fragment if it closer to the camera than the former one
-        glDepthFunc(GL_LESS);
+        GLSTATE.DepthFunc(GL_LESS);
 
         // Cull triangles which normal is not towards the camera
-        glEnable(GL_CULL_FACE);
+        GLSTATE.Enable(GL_CULL_FACE);
 
         currTime = (float) glfwGetTime();
         ellapsedTime = currTime - prevTime;
@@ -551,8 +548,8 @@ int main(void)
         SHADERMANAGER.GLUniform3f(LightID, lightPos);
 
         // Bind our texture in Texture Unit 0
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, texture);
+        GLSTATE.ActiveTexture(GL_TEXTURE0);
+        GLSTATE.BindTexture(GL_TEXTURE_2D, texture);
         // Set our "myTextureSampler" sampler to user Texture Unit 0
         SHADERMANAGER.GLUniform1i(TextureID, 0);
 
@@ -575,8 +572,8 @@ int main(void)
         SHADERMANAGER.GLActiveShaderProgram(Prog, SH_FRAGMENT_SHADER);
 
         // Bind our texture in Texture Unit 0
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, texture);
+        GLSTATE.ActiveTexture(GL_TEXTURE0);
+        GLSTATE.BindTexture(GL_TEXTURE_2D, texture);
         // Set our "myTextureSampler" sampler to user Texture Unit 0
         SHADERMANAGER.GLProgramUniform1i(Prog, TextureID, 0);
 